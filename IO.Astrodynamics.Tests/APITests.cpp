@@ -9,6 +9,16 @@
 #include "Spacecraft.h"
 #include <Converters.cpp>
 #include <TLE.h>
+#include <EphemerisKernel.h>
+#include <PorkchopGrid.h>
+#include <NumericalPropagator.h>
+#include <PointMassGravity.h>
+#include <ZonalHarmonicsGravity.h>
+#include <ThirdBodyGravity.h>
+#include <GeopotentialGravity.h>
+#include <EnsemblePropagator.h>
+#include <filesystem>
+#include <fstream>
 
 TEST(API, TDBToString)
 {
@@ -512,3 +522,387 @@ TEST(API, ConvertHyperbolicStateToConic)
     EXPECT_NEAR(stateVector.velocity.z, stateVector2.velocity.z, 1e-6);
     EXPECT_NEAR(stateVector.epoch, stateVector2.epoch, 1e-6);
 }
+
+TEST(API, GetHorizontalCoordinatesBatchProxy)
+{
+    IO::Astrodynamics::API::DTO::SiteDTO site{};
+    site.id = 399013;
+    site.name = "FAKE_DSS-13";
+    site.bodyId = 399;
+    site.coordinates.longitude = -116.7944627147624 * IO::Astrodynamics::Constants::DEG_RAD;
+    site.coordinates.latitude = 35.2471635434595 * IO::Astrodynamics::Constants::DEG_RAD;
+    site.coordinates.altitude = 107.0;
+    site.directoryPath = SitePath.data();
+
+    int targets[2]{10, 4};
+    double epochs[1]{IO::Astrodynamics::Time::TDB("2021-05-20 19:43:00 UTC").GetSecondsFromJ2000().count()};
+    double azimuth[2], elevation[2], range[2], azimuthRate[2], elevationRate[2], rangeRate[2];
+    ASSERT_TRUE(GetHorizontalCoordinatesBatchProxy(site, targets, 2, epochs, 1, "NONE", false, azimuth, elevation, range, azimuthRate, elevationRate,
+                                                   rangeRate));
+    ASSERT_NEAR(179.29648368392296, azimuth[0] * IO::Astrodynamics::Constants::RAD_DEG, 1e-6);
+    ASSERT_NEAR(74.902071908623157, elevation[0] * IO::Astrodynamics::Constants::RAD_DEG, 1e-6);
+    ASSERT_NEAR(325144554599.82544, range[1], 1e-3);
+}
+
+TEST(API, WriteTwoLineElementsEphemerisProxy)
+{
+    std::filesystem::create_directories(SpacecraftPath);
+    const std::string tlePath = std::string(SpacecraftPath) + "/APICatalog.tle";
+    const std::string spkPath = std::string(SpacecraftPath) + "/APICatalog.spk";
+    {
+        std::ofstream file(tlePath);
+        file << "ISS\n"
+                "1 25544U 98067A   21020.53488036  .00016717  00000-0  10270-3 0  9054\n"
+                "2 25544  51.6423 353.0312 0000493 320.8755  39.2360 15.49309423 25703\n"
+                "VANGUARD 1\n"
+                "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753\n"
+                "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667\n";
+    }
+
+    IO::Astrodynamics::API::DTO::WindowDTO window{};
+    window.start = 664419000.0;
+    window.end = 664419000.0 + 86400.0;
+    int segmentCount{};
+    ASSERT_TRUE(WriteTwoLineElementsEphemerisProxy(spkPath.c_str(), tlePath.c_str(), window, &segmentCount));
+    ASSERT_EQ(2, segmentCount);
+
+    //Proxy output is the same as the kernel output
+    IO::Astrodynamics::Kernels::EphemerisKernel kernel(spkPath, IO::Astrodynamics::Kernels::EphemerisKernel::TwoLineElementsObjectId(25544));
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    IO::Astrodynamics::API::DTO::WindowDTO searchWindow{};
+    searchWindow.start = window.start;
+    searchWindow.end = window.start + 3600.0;
+    IO::Astrodynamics::API::DTO::StateVectorDTO sv[3];
+    ASSERT_TRUE(ReadEphemerisProxy(searchWindow, 399, IO::Astrodynamics::Kernels::EphemerisKernel::TwoLineElementsObjectId(25544), "J2000", "NONE", 1800.0, sv));
+    for (int i = 0; i < 3; ++i)
+    {
+        auto expected = kernel.ReadStateVector(*earth, IO::Astrodynamics::Frames::InertialFrames::ICRF(), IO::Astrodynamics::AberrationsEnum::None,
+                                               IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(sv[i].epoch)));
+        ASSERT_DOUBLE_EQ(searchWindow.start + 1800.0 * i, sv[i].epoch);
+        ASSERT_NEAR(expected.GetPosition().GetX(), sv[i].position.x, 1E-06);
+        ASSERT_NEAR(expected.GetPosition().GetY(), sv[i].position.y, 1E-06);
+        ASSERT_NEAR(expected.GetPosition().GetZ(), sv[i].position.z, 1E-06);
+        ASSERT_NEAR(expected.GetVelocity().GetX(), sv[i].velocity.x, 1E-09);
+        ASSERT_NEAR(expected.GetVelocity().GetY(), sv[i].velocity.y, 1E-09);
+        ASSERT_NEAR(expected.GetVelocity().GetZ(), sv[i].velocity.z, 1E-09);
+    }
+
+    ASSERT_FALSE(WriteTwoLineElementsEphemerisProxy(spkPath.c_str(), "NotExisting.tle", window, &segmentCount));
+    ASSERT_STRNE("", GetLastErrorProxy());
+    window.end = window.start;
+    ASSERT_FALSE(WriteTwoLineElementsEphemerisProxy(spkPath.c_str(), tlePath.c_str(), window, &segmentCount));
+}
+
+TEST(API, Propagate2BodiesBatchProxy)
+{
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    IO::Astrodynamics::API::DTO::StateVectorDTO stateVector{};
+    stateVector.epoch = 664419000.0;
+    stateVector.position = {6800000.0, 1000000.0, -500000.0};
+    stateVector.velocity = {-1000.0, 7500.0, 2000.0};
+    stateVector.centerOfMotionId = 399;
+    stateVector.SetFrame("J2000");
+
+    //Same states as prop2b_c
+    const double epochs[4]{stateVector.epoch - 3600.0, stateVector.epoch, stateVector.epoch + 60.0, stateVector.epoch + 86400.0};
+    double positions[12], velocities[12];
+    ASSERT_TRUE(Propagate2BodiesBatchProxy(stateVector, earth->GetMu(), epochs, 4, positions, velocities));
+    for (int i = 0; i < 4; ++i)
+    {
+        auto expected = Propagate2BodiesProxy(stateVector, earth->GetMu(), epochs[i] - stateVector.epoch);
+        ASSERT_NEAR(expected.position.x, positions[3 * i], 1E-03);
+        ASSERT_NEAR(expected.position.y, positions[3 * i + 1], 1E-03);
+        ASSERT_NEAR(expected.position.z, positions[3 * i + 2], 1E-03);
+        ASSERT_NEAR(expected.velocity.x, velocities[3 * i], 1E-06);
+        ASSERT_NEAR(expected.velocity.y, velocities[3 * i + 1], 1E-06);
+        ASSERT_NEAR(expected.velocity.z, velocities[3 * i + 2], 1E-06);
+    }
+
+    ASSERT_FALSE(Propagate2BodiesBatchProxy(stateVector, earth->GetMu(), epochs, -1, positions, velocities));
+    ASSERT_STRNE("", GetLastErrorProxy());
+    ASSERT_FALSE(Propagate2BodiesBatchProxy(stateVector, -1.0, epochs, 4, positions, velocities));
+}
+
+TEST(API, Propagate2BodiesStatesProxy)
+{
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+
+    //Elliptic and hyperbolic states
+    const double states[12]{6800000.0, 0.0, 0.0, 0.0, 7000.0, 3000.0,
+                            -7000000.0, 2000000.0, 0.0, -1000.0, -11000.0, 500.0};
+    double propagated[12];
+    for (double dt: {-7200.0, 1800.0, 40000.0})
+    {
+        ASSERT_TRUE(Propagate2BodiesStatesProxy(earth->GetMu(), states, 2, dt, propagated));
+        for (int i = 0; i < 2; ++i)
+        {
+            IO::Astrodynamics::API::DTO::StateVectorDTO stateVector{};
+            stateVector.position = {states[6 * i], states[6 * i + 1], states[6 * i + 2]};
+            stateVector.velocity = {states[6 * i + 3], states[6 * i + 4], states[6 * i + 5]};
+            auto expected = Propagate2BodiesProxy(stateVector, earth->GetMu(), dt);
+            const double *state = propagated + 6 * i;
+            ASSERT_NEAR(expected.position.x, state[0], 1E-03);
+            ASSERT_NEAR(expected.position.y, state[1], 1E-03);
+            ASSERT_NEAR(expected.position.z, state[2], 1E-03);
+            ASSERT_NEAR(expected.velocity.x, state[3], 1E-06);
+            ASSERT_NEAR(expected.velocity.y, state[4], 1E-06);
+            ASSERT_NEAR(expected.velocity.z, state[5], 1E-06);
+        }
+    }
+
+    ASSERT_FALSE(Propagate2BodiesStatesProxy(earth->GetMu(), states, -1, 60.0, propagated));
+    ASSERT_STRNE("", GetLastErrorProxy());
+    const double invalid[6]{};
+    ASSERT_FALSE(Propagate2BodiesStatesProxy(earth->GetMu(), invalid, 1, 60.0, propagated));
+}
+
+TEST(API, PorkchopGridProxy)
+{
+    const double start = IO::Astrodynamics::Time::TDB("2020-07-01 00:00:00 TDB").GetSecondsFromJ2000().count();
+    double departureEpochs[3], arrivalEpochs[4];
+    std::vector<IO::Astrodynamics::Time::TDB> departures, arrivals;
+    for (int i = 0; i < 3; ++i)
+    {
+        departureEpochs[i] = start + i * 10.0 * 86400.0;
+        departures.emplace_back(std::chrono::duration<double>(departureEpochs[i]));
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+        arrivalEpochs[i] = start + (200.0 + i * 15.0) * 86400.0;
+        arrivals.emplace_back(std::chrono::duration<double>(arrivalEpochs[i]));
+    }
+
+    double c3[12], vInfinity[12], declination[12], tof[12];
+    ASSERT_TRUE(PorkchopGridProxy(399, 4, 10, departureEpochs, 3, arrivalEpochs, 4, c3, vInfinity, declination, tof));
+
+    //Same cells as the grid computed from the bodies
+    IO::Astrodynamics::Maneuvers::PorkchopGrid grid(std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399),
+                                                    std::make_shared<IO::Astrodynamics::Body::CelestialBody>(4),
+                                                    std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10));
+    auto expected = grid.Compute(departures, arrivals);
+    for (int i = 0; i < 12; ++i)
+    {
+        ASSERT_DOUBLE_EQ(expected.DepartureC3[i], c3[i]);
+        ASSERT_DOUBLE_EQ(expected.ArrivalVInfinity[i], vInfinity[i]);
+        ASSERT_DOUBLE_EQ(expected.DepartureDeclination[i], declination[i]);
+        ASSERT_DOUBLE_EQ(expected.TimeOfFlight[i], tof[i]);
+    }
+    ASSERT_DOUBLE_EQ(arrivalEpochs[3] - departureEpochs[2], tof[2 * 4 + 3]);
+
+    ASSERT_FALSE(PorkchopGridProxy(399, 4, 10, departureEpochs, -1, arrivalEpochs, 4, c3, vInfinity, declination, tof));
+    ASSERT_STRNE("", GetLastErrorProxy());
+    ASSERT_FALSE(PorkchopGridProxy(399, 123456789, 10, departureEpochs, 3, arrivalEpochs, 4, c3, vInfinity, declination, tof));
+}
+
+TEST(API, PropagateNumericallyProxy)
+{
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    const IO::Astrodynamics::Time::TDB epoch("2021-01-01 00:00:00 TDB");
+    IO::Astrodynamics::API::DTO::StateVectorDTO stateVector{};
+    stateVector.epoch = epoch.GetSecondsFromJ2000().count();
+    stateVector.position = {6800000.0, 0.0, 0.0};
+    stateVector.velocity = {0.0, 5000.0, 5800.0};
+    stateVector.centerOfMotionId = 399;
+    stateVector.SetFrame("J2000");
+
+    //Backward and forward epochs, unsorted
+    const double epochs[4]{stateVector.epoch + 3600.0, stateVector.epoch - 1800.0, stateVector.epoch, stateVector.epoch + 86400.0};
+    const int thirdBodies[2]{301, 10};
+    double states[24];
+    ASSERT_TRUE(PropagateNumericallyProxy(stateVector, thirdBodies, 2, true, nullptr, 0, 1E-12, epochs, 4, states));
+
+    //Same states as the propagator built from the same force models
+    const IO::Astrodynamics::Frames::Frames frame("J2000");
+    IO::Astrodynamics::Propagators::NumericalPropagator propagator({std::make_shared<IO::Astrodynamics::Propagators::PointMassGravity>(earth->GetMu()),
+                                    std::make_shared<IO::Astrodynamics::Propagators::ZonalHarmonicsGravity>(*earth, frame, epoch),
+                                    std::make_shared<IO::Astrodynamics::Propagators::ThirdBodyGravity>(
+                                            std::make_shared<IO::Astrodynamics::Body::CelestialBody>(301), earth, frame),
+                                    std::make_shared<IO::Astrodynamics::Propagators::ThirdBodyGravity>(
+                                            std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10), earth, frame)});
+    const double initial[6]{6800000.0, 0.0, 0.0, 0.0, 5000.0, 5800.0};
+    propagator.Propagate(stateVector.epoch, initial, stateVector.epoch - 1800.0, stateVector.epoch + 86400.0);
+    double expected[24];
+    propagator.GetStates(4, epochs, expected);
+    for (int i = 0; i < 24; ++i)
+    {
+        ASSERT_DOUBLE_EQ(expected[i], states[i]);
+    }
+    for (int i = 0; i < 6; ++i)
+    {
+        ASSERT_DOUBLE_EQ(initial[i], states[12 + i]);
+    }
+
+    //Perturbations are applied, the proxy doesn't match the point mass propagation
+    double pointMass[24];
+    ASSERT_TRUE(PropagateNumericallyProxy(stateVector, nullptr, 0, false, nullptr, 0, 1E-12, epochs, 4, pointMass));
+    ASSERT_GT(std::abs(pointMass[18] - states[18]) + std::abs(pointMass[19] - states[19]) + std::abs(pointMass[20] - states[20]), 1000.0);
+
+    ASSERT_FALSE(PropagateNumericallyProxy(stateVector, thirdBodies, 2, true, nullptr, 0, 1E-12, epochs, 0, states));
+    ASSERT_STRNE("", GetLastErrorProxy());
+    ASSERT_FALSE(PropagateNumericallyProxy(stateVector, thirdBodies, -1, true, nullptr, 0, 1E-12, epochs, 4, states));
+    ASSERT_STRNE("", GetLastErrorProxy());
+    //Zonal harmonics are already part of a geopotential model
+    ASSERT_FALSE(PropagateNumericallyProxy(stateVector, thirdBodies, 2, true, "Data/Models/EGM2008_to70_TideFree", 4, 1E-12, epochs, 4, states));
+    ASSERT_STRNE("", GetLastErrorProxy());
+}
+
+TEST(API, PropagateNumericallyProxyGeopotential)
+{
+    std::filesystem::create_directories(SpacecraftPath);
+    const std::string modelPath = std::string(SpacecraftPath) + "/APIGeopotential.txt";
+    {
+        std::ofstream file(modelPath);
+        file << "    2    0   -0.484165143790815D-03    0.000000000000000D+00    0.7481239490D-11    0.0000000000D+00\n"
+                "    2    1   -0.206615509074176D-09    0.138441389137979D-08    0.7063781502D-11    0.7348347201D-11\n"
+                "    2    2    0.243938357328313D-05   -0.140027370385934D-05    0.7230231722D-11    0.7425816951D-11\n"
+                "    3    0    0.957161207093473D-06    0.000000000000000D+00    0.5731430751D-11    0.0000000000D+00\n"
+                "    3    1    0.203046201047864D-05    0.248200415856872D-06    0.5726633183D-11    0.5976692146D-11\n"
+                "    3    2    0.904787894809528D-06   -0.619005475177618D-06    0.5858311115D-11    0.5918049932D-11\n"
+                "    3    3    0.721321757121568D-06    0.141434926192941D-05    0.5781617856D-11    0.5801055478D-11\n";
+    }
+
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    IO::Astrodynamics::API::DTO::StateVectorDTO stateVector{};
+    stateVector.epoch = IO::Astrodynamics::Time::TDB("2021-01-01 00:00:00 TDB").GetSecondsFromJ2000().count();
+    stateVector.position = {6800000.0, 0.0, 0.0};
+    stateVector.velocity = {0.0, 5000.0, 5800.0};
+    stateVector.centerOfMotionId = 399;
+    stateVector.SetFrame("J2000");
+    const double epochs[3]{stateVector.epoch, stateVector.epoch + 3600.0, stateVector.epoch + 21600.0};
+    const int thirdBodies[1]{301};
+    double states[18];
+    ASSERT_TRUE(PropagateNumericallyProxy(stateVector, thirdBodies, 1, false, modelPath.c_str(), 3, 1E-12, epochs, 3, states));
+
+    //Same states as the propagator built from the same model, the central term is part of the geopotential
+    const IO::Astrodynamics::Frames::Frames frame("J2000");
+    auto model = std::make_shared<IO::Astrodynamics::Propagators::GeopotentialModel>(
+            IO::Astrodynamics::Propagators::GeopotentialModel::ReadFile(modelPath, 3, 3, earth->GetMu(), earth->GetRadius().GetX()));
+    IO::Astrodynamics::Propagators::NumericalPropagator propagator({std::make_shared<IO::Astrodynamics::Propagators::GeopotentialGravity>(model, earth, frame),
+                                                                    std::make_shared<IO::Astrodynamics::Propagators::ThirdBodyGravity>(
+                                                                            std::make_shared<IO::Astrodynamics::Body::CelestialBody>(301), earth, frame)});
+    const double initial[6]{6800000.0, 0.0, 0.0, 0.0, 5000.0, 5800.0};
+    propagator.Propagate(stateVector.epoch, initial, epochs[0], epochs[2]);
+    double expected[18];
+    propagator.GetStates(3, epochs, expected);
+    for (int i = 0; i < 18; ++i)
+    {
+        ASSERT_DOUBLE_EQ(expected[i], states[i]);
+    }
+
+    //Truncated to the central term, the geopotential is a point mass
+    double truncated[18], pointMass[18];
+    ASSERT_TRUE(PropagateNumericallyProxy(stateVector, nullptr, 0, false, modelPath.c_str(), 0, 1E-12, epochs, 3, truncated));
+    ASSERT_TRUE(PropagateNumericallyProxy(stateVector, nullptr, 0, false, nullptr, 0, 1E-12, epochs, 3, pointMass));
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_NEAR(pointMass[12 + i], truncated[12 + i], 1E-03);
+    }
+    //J2 moves the satellite by kilometers in a few hours
+    ASSERT_GT(std::abs(pointMass[12] - states[12]) + std::abs(pointMass[13] - states[13]) + std::abs(pointMass[14] - states[14]), 1000.0);
+
+    ASSERT_FALSE(PropagateNumericallyProxy(stateVector, nullptr, 0, false, (std::string(SpacecraftPath) + "/Unknown.txt").c_str(), 3, 1E-12, epochs, 3,
+                                           states));
+    ASSERT_STRNE("", GetLastErrorProxy());
+    ASSERT_FALSE(PropagateNumericallyProxy(stateVector, nullptr, 0, false, modelPath.c_str(), -1, 1E-12, epochs, 3, states));
+    ASSERT_STRNE("", GetLastErrorProxy());
+}
+
+TEST(API, PropagateEnsembleProxy)
+{
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    const IO::Astrodynamics::Time::TDB epoch("2021-01-01 00:00:00 TDB");
+    IO::Astrodynamics::API::DTO::StateVectorDTO meanState{};
+    meanState.epoch = epoch.GetSecondsFromJ2000().count();
+    meanState.position = {6800000.0, 0.0, 0.0};
+    meanState.velocity = {0.0, 5000.0, 5800.0};
+    meanState.centerOfMotionId = 399;
+    meanState.SetFrame("J2000");
+    double covariance[36]{};
+    const double variances[6]{100.0, 400.0, 900.0, 1E-04, 4E-04, 9E-04};
+    for (int i = 0; i < 6; ++i)
+    {
+        covariance[7 * i] = variances[i];
+    }
+
+    const int thirdBodies[1]{301};
+    const double percentiles[3]{0.0, 50.0, 100.0};
+    double means[18], covariances[108], percentileStates[54];
+    ASSERT_TRUE(PropagateEnsembleProxy(meanState, covariance, 200, 17, thirdBodies, 1, true, nullptr, 0, 30.0, 1800.0, 3, percentiles, 3, means, covariances,
+                                       percentileStates));
+
+    //Same statistics as the propagator built from the same samples and force models
+    const IO::Astrodynamics::Frames::Frames frame("J2000");
+    const double mean[6]{6800000.0, 0.0, 0.0, 0.0, 5000.0, 5800.0};
+    const auto members = IO::Astrodynamics::Propagators::EnsemblePropagator::Sample(mean, covariance, 200, 17);
+    IO::Astrodynamics::Propagators::EnsemblePropagator propagator({std::make_shared<IO::Astrodynamics::Propagators::PointMassGravity>(earth->GetMu()),
+                                                                   std::make_shared<IO::Astrodynamics::Propagators::ZonalHarmonicsGravity>(*earth, frame, epoch),
+                                                                   std::make_shared<IO::Astrodynamics::Propagators::ThirdBodyGravity>(
+                                                                           std::make_shared<IO::Astrodynamics::Body::CelestialBody>(301), earth, frame)}, 30.0);
+    auto statistics = propagator.PropagateStatistics(meanState.epoch, 200, members.data(), 1800.0, 3, {0.0, 50.0, 100.0});
+    for (int i = 0; i < 18; ++i)
+    {
+        ASSERT_DOUBLE_EQ(statistics.Mean[i], means[i]);
+    }
+    for (int i = 0; i < 108; ++i)
+    {
+        ASSERT_DOUBLE_EQ(statistics.Covariance[i], covariances[i]);
+    }
+    for (int i = 0; i < 54; ++i)
+    {
+        ASSERT_DOUBLE_EQ(statistics.Percentiles[i], percentileStates[i]);
+    }
+    //Initial dispersion is the sampled one
+    ASSERT_NEAR(variances[1], covariances[7], 0.2 * variances[1]);
+
+    ASSERT_FALSE(PropagateEnsembleProxy(meanState, covariance, 1, 17, thirdBodies, 1, true, nullptr, 0, 30.0, 1800.0, 3, percentiles, 3, means, covariances,
+                                        percentileStates));
+    ASSERT_STRNE("", GetLastErrorProxy());
+    const double invalidPercentiles[1]{120.0};
+    ASSERT_FALSE(PropagateEnsembleProxy(meanState, covariance, 200, 17, thirdBodies, 1, true, nullptr, 0, 30.0, 1800.0, 3, invalidPercentiles, 1, means,
+                                        covariances, percentileStates));
+    ASSERT_STRNE("", GetLastErrorProxy());
+}
+
+TEST(API, PropagateEnsembleTrajectoriesProxy)
+{
+    IO::Astrodynamics::API::DTO::StateVectorDTO states[3]{};
+    for (int j = 0; j < 3; ++j)
+    {
+        states[j].epoch = IO::Astrodynamics::Time::TDB("2021-01-01 00:00:00 TDB").GetSecondsFromJ2000().count();
+        states[j].position = {6800000.0 + 1000.0 * j, 0.0, 0.0};
+        states[j].velocity = {0.0, 5000.0, 5800.0 - 10.0 * j};
+        states[j].centerOfMotionId = 399;
+        states[j].SetFrame("J2000");
+    }
+    const int thirdBodies[2]{301, 10};
+    double trajectories[3 * 4 * 6];
+    ASSERT_TRUE(PropagateEnsembleTrajectoriesProxy(states, 3, thirdBodies, 2, true, nullptr, 0, 20.0, 600.0, 4, trajectories));
+
+    //Each member trajectory matches a single member propagation
+    for (int j = 0; j < 3; ++j)
+    {
+        double single[4 * 6];
+        ASSERT_TRUE(PropagateEnsembleTrajectoriesProxy(states + j, 1, thirdBodies, 2, true, nullptr, 0, 20.0, 600.0, 4, single));
+        for (int k = 0; k < 24; ++k)
+        {
+            ASSERT_DOUBLE_EQ(single[k], trajectories[24 * j + k]);
+        }
+        ASSERT_DOUBLE_EQ(states[j].position.x, trajectories[24 * j]);
+        ASSERT_DOUBLE_EQ(states[j].velocity.z, trajectories[24 * j + 5]);
+    }
+
+    //Fixed step Runge-Kutta 4 close to the adaptive propagation
+    const double epochs[1]{states[1].epoch + 1800.0};
+    double expected[6];
+    ASSERT_TRUE(PropagateNumericallyProxy(states[1], thirdBodies, 2, true, nullptr, 0, 1E-12, epochs, 1, expected));
+    for (int k = 0; k < 3; ++k)
+    {
+        ASSERT_NEAR(expected[k], trajectories[24 + 18 + k], 1E-02);
+    }
+
+    ASSERT_FALSE(PropagateEnsembleTrajectoriesProxy(states, 0, thirdBodies, 2, true, nullptr, 0, 20.0, 600.0, 4, trajectories));
+    ASSERT_STRNE("", GetLastErrorProxy());
+    states[2].centerOfMotionId = 301;
+    ASSERT_FALSE(PropagateEnsembleTrajectoriesProxy(states, 3, thirdBodies, 2, true, nullptr, 0, 20.0, 600.0, 4, trajectories));
+    ASSERT_STRNE("", GetLastErrorProxy());
+}
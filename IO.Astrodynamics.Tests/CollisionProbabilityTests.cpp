@@ -0,0 +1,145 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <CollisionProbability.h>
+#include <InvalidArgumentException.h>
+
+using namespace IO::Astrodynamics::Conjunctions;
+
+TEST(CollisionProbability, CircularCovarianceHeadOn)
+{
+    //Exact value for a null miss distance and a circular covariance
+    EncounterPlane encounter{0.0, 0.0, 100.0, 100.0};
+    const double expected = 1.0 - std::exp(-20.0 * 20.0 / (2.0 * 100.0 * 100.0));
+    ASSERT_NEAR(expected, CollisionProbability::Foster(encounter, 20.0), 1E-12);
+    ASSERT_NEAR(expected, CollisionProbability::Chan(encounter, 20.0), 1E-12);
+    ASSERT_DOUBLE_EQ(1.0, CollisionProbability::Maximum(encounter, 20.0));
+}
+
+TEST(CollisionProbability, Methods)
+{
+    //Reference values from a brute force grid integration over the hard body disk
+    struct Case
+    {
+        EncounterPlane Encounter;
+        double Radius;
+        double Expected;
+    };
+    const Case cases[]{{{150.0, -40.0, 100.0, 100.0}, 20.0, 6.0058696E-03},
+                       {{200.0, 50.0, 300.0, 60.0}, 20.0, 6.2582384E-03},
+                       {{-30.0, 800.0, 500.0, 120.0}, 15.0, 4.5439745E-13}};
+
+    for (const auto &c: cases)
+    {
+        const double foster = CollisionProbability::Foster(c.Encounter, c.Radius);
+        ASSERT_NEAR(c.Expected, foster, c.Expected * 1E-05);
+        ASSERT_GE(CollisionProbability::Maximum(c.Encounter, c.Radius), foster);
+    }
+
+    //Chan series is exact for circular covariances, an approximation otherwise
+    ASSERT_NEAR(cases[0].Expected, CollisionProbability::Chan(cases[0].Encounter, cases[0].Radius), cases[0].Expected * 1E-05);
+    ASSERT_NEAR(cases[1].Expected, CollisionProbability::Chan(cases[1].Encounter, cases[1].Radius), cases[1].Expected * 1E-02);
+
+    //Disk far in the tail
+    EncounterPlane far{1000.0, 0.0, 80.0, 80.0};
+    ASSERT_NEAR(1.0213164E-35, CollisionProbability::Chan(far, 20.0), 1E-40);
+    ASSERT_LT(CollisionProbability::Foster(far, 20.0), 1E-30);
+    ASSERT_NEAR(20.0 * 20.0 / (80.0 * 80.0) / (1000.0 * 1000.0 / (80.0 * 80.0) * std::exp(1.0)), CollisionProbability::Maximum(far, 20.0), 1E-09);
+
+    //Hard body much larger than the covariance
+    EncounterPlane inside{10.0, 5.0, 2.0, 3.0};
+    ASSERT_NEAR(1.0, CollisionProbability::Foster(inside, 50.0), 1E-10);
+    ASSERT_NEAR(1.0, CollisionProbability::Chan(inside, 50.0), 1E-10);
+}
+
+TEST(CollisionProbability, RegressionCases)
+{
+    std::ifstream file("Data/CollisionProbability/RegressionCases.txt");
+    ASSERT_TRUE(file.good());
+
+    std::size_t count{};
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        std::istringstream values(line);
+        EncounterPlane encounter;
+        double radius, foster, chan, maximum;
+        ASSERT_TRUE(values >> encounter.MissX >> encounter.MissY >> encounter.SigmaX >> encounter.SigmaY >> radius >> foster >> chan >> maximum) << line;
+
+        //Foster integration is truncated beyond 8.5 sigmas
+        ASSERT_NEAR(foster, CollisionProbability::Foster(encounter, radius), 1E-06 * foster + 1E-20) << line;
+        ASSERT_NEAR(chan, CollisionProbability::Chan(encounter, radius), 1E-08 * chan) << line;
+        ASSERT_NEAR(maximum, CollisionProbability::Maximum(encounter, radius), 1E-06 * maximum) << line;
+        ++count;
+    }
+    ASSERT_EQ(15, count);
+}
+
+TEST(CollisionProbability, Project)
+{
+    //Relative velocity along z, encounter plane is xy
+    const double position[3]{30.0, 40.0, 500.0};
+    const double velocity[3]{0.0, 0.0, -7000.0};
+    const double covariance[6]{400.0, 0.0, 10.0, 900.0, 20.0, 1E+06};
+    auto encounter = CollisionProbability::Project(position, velocity, covariance);
+    ASSERT_NEAR(30.0, encounter.SigmaX, 1E-09);
+    ASSERT_NEAR(20.0, encounter.SigmaY, 1E-09);
+    ASSERT_NEAR(50.0, std::hypot(encounter.MissX, encounter.MissY), 1E-09);
+    ASSERT_NEAR(40.0, std::abs(encounter.MissX), 1E-09);
+
+    //Null miss distance
+    const double origin[3]{0.0, 0.0, 0.0};
+    auto centered = CollisionProbability::Project(origin, velocity, covariance);
+    ASSERT_NEAR(30.0, centered.SigmaX, 1E-09);
+    ASSERT_NEAR(20.0, centered.SigmaY, 1E-09);
+    ASSERT_DOUBLE_EQ(0.0, centered.MissX);
+    ASSERT_DOUBLE_EQ(0.0, centered.MissY);
+}
+
+TEST(CollisionProbability, Batch)
+{
+    const double positions[9]{30.0, 40.0, 0.0, 0.0, 0.0, 0.0, 30.0, 40.0, 0.0};
+    const double velocities[9]{0.0, 0.0, 7000.0, 0.0, 0.0, 7000.0, 0.0, 0.0, 0.0};
+    const double covariances[18]{400.0, 0.0, 0.0, 900.0, 0.0, 100.0,
+                                 400.0, 0.0, 0.0, -900.0, 0.0, 100.0,
+                                 400.0, 0.0, 0.0, 900.0, 0.0, 100.0};
+    const double radii[3]{10.0, 10.0, 10.0};
+    double probabilities[3];
+    CollisionProbability::Compute(3, positions, velocities, covariances, radii, CollisionProbabilityMethod::Foster, probabilities);
+    ASSERT_NEAR(CollisionProbability::Foster(EncounterPlane{40.0, 30.0, 30.0, 20.0}, 10.0), probabilities[0], 1E-15);
+
+    //Covariance not positive definite and null relative velocity
+    ASSERT_TRUE(std::isnan(probabilities[1]));
+    ASSERT_TRUE(std::isnan(probabilities[2]));
+}
+
+TEST(CollisionProbability, Conjunctions)
+{
+    std::vector<Conjunction> conjunctions(2);
+    conjunctions[0].Radial = 50.0;
+    conjunctions[0].InTrackVelocity = 10000.0;
+    conjunctions[1].CrossTrack = 200.0;
+    conjunctions[1].InTrackVelocity = -5000.0;
+    conjunctions[1].RadialVelocity = 100.0;
+    const std::vector<double> covariances{2500.0, 0.0, 0.0, 1E+06, 0.0, 2500.0,
+                                          2500.0, 0.0, 0.0, 1E+06, 0.0, 2500.0};
+
+    auto probabilities = CollisionProbability::Compute(conjunctions, covariances, 10.0, CollisionProbabilityMethod::Chan);
+    ASSERT_EQ(2, probabilities.size());
+    const double expected = CollisionProbability::Chan(EncounterPlane{50.0, 0.0, 50.0, 50.0}, 10.0);
+    ASSERT_NEAR(expected, probabilities[0], 1E-15);
+    ASSERT_GT(probabilities[0], probabilities[1]);
+
+    ASSERT_THROW(CollisionProbability::Compute(conjunctions, std::vector<double>(6), 10.0), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(CollisionProbability::Compute(conjunctions, covariances, 0.0), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
@@ -0,0 +1,84 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <CelestialBody.h>
+#include <ConicOrbitalElements.h>
+#include <InertialFrames.h>
+#include <StateVector.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    IO::Astrodynamics::OrbitalParameters::ConicOrbitalElements CreateOrbit()
+    {
+        auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+        return {earth, 6800000.0, 0.1, 0.9, 1.2, 0.5, 0.3, IO::Astrodynamics::Time::TDB(100000000.0s), IO::Astrodynamics::Frames::InertialFrames::ICRF()};
+    }
+}
+
+TEST(ConicOrbitalElements, CachedRepresentationsAtEpoch)
+{
+    auto conic = CreateOrbit();
+
+    //State is computed once and shared by getters
+    const auto &sv = conic.GetStateVectorAtEpoch();
+    ASSERT_EQ(&sv, &conic.GetStateVectorAtEpoch());
+    ASSERT_EQ(conic.ToStateVector(conic.GetEpoch()), sv);
+    ASSERT_EQ(sv, conic.ToStateVector());
+    ASSERT_EQ(sv.GetSpecificAngularMomentum(), conic.GetSpecificAngularMomentum());
+
+    const auto &osculating = conic.GetConicOrbitalElementsAtEpoch();
+    ASSERT_EQ(&osculating, &conic.GetConicOrbitalElementsAtEpoch());
+    ASSERT_NEAR(conic.GetEccentricity(), osculating.GetEccentricity(), 1E-12);
+    ASSERT_NEAR(conic.GetSemiMajorAxis(), osculating.GetSemiMajorAxis(), 1E-04);
+
+    //Ascending node vector is computed once and matches the state vector one
+    const auto node = conic.GetAscendingNodeVector();
+    ASSERT_EQ(node, conic.GetAscendingNodeVector());
+    const auto expectedNode = IO::Astrodynamics::OrbitalParameters::StateVector(sv).GetAscendingNodeVector();
+    ASSERT_NEAR(expectedNode.GetX(), node.GetX(), 1E-12);
+    ASSERT_NEAR(expectedNode.GetY(), node.GetY(), 1E-12);
+    ASSERT_NEAR(expectedNode.GetZ(), node.GetZ(), 1E-12);
+
+    //A copy builds its own cache
+    IO::Astrodynamics::OrbitalParameters::ConicOrbitalElements copy(conic);
+    ASSERT_NE(&sv, &copy.GetStateVectorAtEpoch());
+    ASSERT_EQ(sv, copy.GetStateVectorAtEpoch());
+    ASSERT_EQ(node, copy.GetAscendingNodeVector());
+}
+
+TEST(ConicOrbitalElements, CachedRepresentationsConcurrentAccess)
+{
+    //First use from many threads builds each representation once
+    auto conic = CreateOrbit();
+    constexpr std::size_t threadCount = 8;
+    std::vector<const IO::Astrodynamics::OrbitalParameters::StateVector *> states(threadCount);
+    std::vector<const IO::Astrodynamics::OrbitalParameters::ConicOrbitalElements *> elements(threadCount);
+    std::vector<IO::Astrodynamics::Math::Vector3D> nodes(threadCount);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back([&, i]
+                             {
+                                 elements[i] = &conic.GetConicOrbitalElementsAtEpoch();
+                                 states[i] = &conic.GetStateVectorAtEpoch();
+                                 nodes[i] = conic.GetAscendingNodeVector();
+                             });
+    }
+    for (auto &thread: threads)
+    {
+        thread.join();
+    }
+    for (std::size_t i = 0; i < threadCount; ++i)
+    {
+        ASSERT_EQ(&conic.GetStateVectorAtEpoch(), states[i]);
+        ASSERT_EQ(&conic.GetConicOrbitalElementsAtEpoch(), elements[i]);
+        ASSERT_EQ(conic.GetAscendingNodeVector(), nodes[i]);
+    }
+}
@@ -0,0 +1,378 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <ConjunctionScreening.h>
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    IO::Astrodynamics::Propagators::SGP4Elements CircularElements(int satelliteNumber, double semiMajorAxis, double inclination, double node, double meanAnomaly)
+    {
+        IO::Astrodynamics::Propagators::SGP4Elements elements;
+        elements.SatelliteNumber = satelliteNumber;
+        elements.Epoch = IO::Astrodynamics::Time::UTC(700000000.0s);
+        elements.BStar = 1E-05;
+        elements.Inclination = inclination;
+        elements.RightAscendingNode = node;
+        elements.Eccentricity = 1E-04;
+        elements.PeriapsisArgument = 0.0;
+        elements.MeanAnomaly = meanAnomaly;
+        elements.MeanMotion = std::sqrt(398600.8 / (semiMajorAxis * semiMajorAxis * semiMajorAxis)) * 60.0;
+        return elements;
+    }
+
+    //Uniform value from the raw generator output, same sequence with any standard library
+    double Uniform(std::mt19937_64 &generator, double minimum, double maximum)
+    {
+        return minimum + (maximum - minimum) * static_cast<double>(generator() >> 11) * 0x1.0p-53;
+    }
+
+    double Dot(const double *a, const double *b)
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    void Cross(const double *a, const double *b, double *result)
+    {
+        result[0] = a[1] * b[2] - a[2] * b[1];
+        result[1] = a[2] * b[0] - a[0] * b[2];
+        result[2] = a[0] * b[1] - a[1] * b[0];
+        const double norm = std::sqrt(Dot(result, result));
+        for (int i = 0; i < 3; ++i)
+        {
+            result[i] /= norm;
+        }
+    }
+
+    //Near circular orbit going through the target position at epoch, in a plane tilted around this position
+    IO::Astrodynamics::Propagators::SGP4Elements CrossingElements(int satelliteNumber, const IO::Astrodynamics::Propagators::SGP4 &target, double epoch, double tilt)
+    {
+        const IO::Astrodynamics::Time::TDB tdb{std::chrono::duration<double>(epoch)};
+        double r[3], v[3], h[3], normal[3], inPlane[3];
+        target.Propagate(tdb, r, v);
+        Cross(r, v, h);
+        const double speed = std::sqrt(Dot(v, v));
+        double direction[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            direction[i] = v[i] / speed * std::cos(tilt) + h[i] * std::sin(tilt);
+        }
+        Cross(r, direction, normal);
+        const double node = std::atan2(normal[0], -normal[1]);
+        const double nodeVector[3]{std::cos(node), std::sin(node), 0.0};
+        Cross(normal, nodeVector, inPlane);
+        const double radius = std::sqrt(Dot(r, r));
+        const double u = std::atan2(Dot(r, inPlane), Dot(r, nodeVector));
+
+        //Mean elements are corrected until the osculating position is on the target
+        double semiMajorAxis = radius / 1000.0;
+        auto elements = CircularElements(satelliteNumber, semiMajorAxis, std::acos(normal[2]), node, u);
+        elements.BStar = 0.0;
+        elements.Epoch = tdb.ToUTC();
+        for (int iteration = 0; iteration < 5; ++iteration)
+        {
+            double position[3], velocity[3];
+            IO::Astrodynamics::Propagators::SGP4(elements).Propagate(tdb, position, velocity);
+            semiMajorAxis += (radius - std::sqrt(Dot(position, position))) / 1000.0;
+            elements.MeanMotion = std::sqrt(398600.8 / (semiMajorAxis * semiMajorAxis * semiMajorAxis)) * 60.0;
+            elements.MeanAnomaly += u - std::atan2(Dot(position, inPlane), Dot(position, nodeVector));
+        }
+        return elements;
+    }
+
+    double SquaredDistance(const IO::Astrodynamics::Propagators::SGP4 &primary, const IO::Astrodynamics::Propagators::SGP4 &secondary, double epoch)
+    {
+        double r1[3], v1[3], r2[3], v2[3];
+        const IO::Astrodynamics::Time::TDB tdb{std::chrono::duration<double>(epoch)};
+        if (primary.Propagate(tdb, r1, v1) != IO::Astrodynamics::Propagators::SGP4::Status::Success ||
+            secondary.Propagate(tdb, r2, v2) != IO::Astrodynamics::Propagators::SGP4::Status::Success)
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+        return (r2[0] - r1[0]) * (r2[0] - r1[0]) + (r2[1] - r1[1]) * (r2[1] - r1[1]) + (r2[2] - r1[2]) * (r2[2] - r1[2]);
+    }
+}
+
+TEST(ConjunctionScreening, Volume)
+{
+    auto sphere = IO::Astrodynamics::Conjunctions::ScreeningVolume::Sphere(1000.0);
+    ASSERT_DOUBLE_EQ(1000.0, sphere.GetMaximumExtent());
+    ASSERT_TRUE(sphere.Contains(500.0, 500.0, 500.0));
+    ASSERT_FALSE(sphere.Contains(600.0, 600.0, 600.0));
+
+    IO::Astrodynamics::Conjunctions::ScreeningVolume box{200.0, 5000.0, 2000.0};
+    ASSERT_DOUBLE_EQ(5000.0, box.GetMaximumExtent());
+    ASSERT_TRUE(box.Contains(100.0, 4000.0, 0.0));
+    ASSERT_FALSE(box.Contains(300.0, 0.0, 0.0));
+}
+
+TEST(ConjunctionScreening, CrossingOrbits)
+{
+    //Both objects cross the ascending node at epoch, third one is geostationary
+    std::vector<IO::Astrodynamics::Propagators::SGP4Elements> catalog{CircularElements(1, 7000.0, 50.0 * IO::Astrodynamics::Constants::DEG_RAD, 1.0, 0.0),
+                                                                      CircularElements(2, 7000.0, 60.0 * IO::Astrodynamics::Constants::DEG_RAD, 1.0, 0.0),
+                                                                      CircularElements(3, 42164.0, 0.001, 0.0, 0.0)};
+    IO::Astrodynamics::Conjunctions::ConjunctionScreening screening(catalog);
+    ASSERT_EQ(3, screening.GetSize());
+
+    IO::Astrodynamics::Time::TDB epoch = IO::Astrodynamics::Time::UTC(700000000.0s).ToTDB();
+    IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> window(epoch - IO::Astrodynamics::Time::TimeSpan(600.0s),
+                                                                         epoch + IO::Astrodynamics::Time::TimeSpan(600.0s));
+    IO::Astrodynamics::Conjunctions::ScreeningStatistics statistics;
+    auto conjunctions = screening.Screen({0}, window, IO::Astrodynamics::Conjunctions::ScreeningVolume::Sphere(20000.0),
+                                         IO::Astrodynamics::Time::TimeSpan(30.0s), 2, &statistics);
+
+    ASSERT_EQ(2, statistics.Pairs);
+    ASSERT_EQ(1, statistics.ApsisFilterPairs);
+    ASSERT_EQ(1, statistics.PathFilterPairs);
+    ASSERT_EQ(1, conjunctions.size());
+
+    const auto &conjunction = conjunctions.front();
+    ASSERT_EQ(0, conjunction.PrimaryIndex);
+    ASSERT_EQ(1, conjunction.SecondaryIndex);
+    ASSERT_LT(std::abs((conjunction.TCA - epoch).GetSeconds().count()), 60.0);
+    ASSERT_LT(conjunction.MissDistance, 10000.0);
+    ASSERT_NEAR(conjunction.MissDistance, std::sqrt(conjunction.Radial * conjunction.Radial + conjunction.InTrack * conjunction.InTrack +
+                                                    conjunction.CrossTrack * conjunction.CrossTrack), 1E-06);
+
+    //Relative speed of two circular orbits crossing with 10° relative inclination
+    ASSERT_NEAR(2.0 * std::sqrt(398600.8E+09 / 7000000.0) * std::sin(5.0 * IO::Astrodynamics::Constants::DEG_RAD), conjunction.RelativeSpeed, 50.0);
+
+    //Time of closest approach is a range rate root
+    double r1[3], v1[3], r2[3], v2[3];
+    IO::Astrodynamics::Propagators::SGP4 p1(catalog[0]), p2(catalog[1]);
+    p1.Propagate(conjunction.TCA, r1, v1);
+    p2.Propagate(conjunction.TCA, r2, v2);
+    double rangeRate{};
+    for (int i = 0; i < 3; ++i)
+    {
+        rangeRate += (r2[i] - r1[i]) * (v2[i] - v1[i]);
+    }
+    ASSERT_LT(std::abs(rangeRate / conjunction.MissDistance), 1.0);
+}
+
+TEST(ConjunctionScreening, StepDoesNotChangeResults)
+{
+    std::vector<IO::Astrodynamics::Propagators::SGP4Elements> catalog;
+    for (int i = 0; i < 40; ++i)
+    {
+        catalog.push_back(CircularElements(i + 1, 7000.0 + 2.0 * i, (40.0 + 3.0 * i) * IO::Astrodynamics::Constants::DEG_RAD, 0.3 * i, 0.15 * i));
+    }
+    IO::Astrodynamics::Conjunctions::ConjunctionScreening screening(catalog);
+    IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> window(IO::Astrodynamics::Time::TDB(700000000.0s), IO::Astrodynamics::Time::TDB(700021600.0s));
+    auto volume = IO::Astrodynamics::Conjunctions::ScreeningVolume::Sphere(50000.0);
+
+    auto fine = screening.Screen({0, 1, 2}, window, volume, IO::Astrodynamics::Time::TimeSpan(10.0s), 1);
+    auto coarse = screening.Screen({0, 1, 2}, window, volume, IO::Astrodynamics::Time::TimeSpan(120.0s), 3);
+    ASSERT_FALSE(fine.empty());
+    ASSERT_EQ(fine.size(), coarse.size());
+    for (std::size_t i = 0; i < fine.size(); ++i)
+    {
+        ASSERT_EQ(fine[i].PrimaryIndex, coarse[i].PrimaryIndex);
+        ASSERT_EQ(fine[i].SecondaryIndex, coarse[i].SecondaryIndex);
+        ASSERT_NEAR(fine[i].TCA.GetSecondsFromJ2000().count(), coarse[i].TCA.GetSecondsFromJ2000().count(), 1E-02);
+        ASSERT_NEAR(fine[i].MissDistance, coarse[i].MissDistance, 1E-01);
+    }
+}
+
+TEST(ConjunctionScreening, InvalidArguments)
+{
+    std::vector<IO::Astrodynamics::Propagators::SGP4Elements> catalog{CircularElements(1, 7000.0, 1.0, 0.0, 0.0), CircularElements(2, 7000.0, 1.2, 0.0, 0.0)};
+    IO::Astrodynamics::Conjunctions::ConjunctionScreening screening(catalog);
+    IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> window(IO::Astrodynamics::Time::TDB(700000000.0s), IO::Astrodynamics::Time::TDB(700003600.0s));
+
+    ASSERT_THROW(screening.Screen({5}, window, IO::Astrodynamics::Conjunctions::ScreeningVolume::Sphere(1000.0)), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(screening.Screen({0}, window, IO::Astrodynamics::Conjunctions::ScreeningVolume{0.0, 1000.0, 1000.0}),
+                 IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(screening.Screen({0}, window, IO::Astrodynamics::Conjunctions::ScreeningVolume::Sphere(1000.0), IO::Astrodynamics::Time::TimeSpan(0.0s)),
+                 IO::Astrodynamics::Exception::InvalidArgumentException);
+}
+
+TEST(ConjunctionScreening, BruteForceCatalog)
+{
+    const double begin = 700000000.0;
+    const double end = begin + 3.0 * 86400.0;
+    const double radius = 30000.0;
+    const IO::Astrodynamics::Time::UTC epoch(std::chrono::duration<double>(begin + 3600.0));
+
+    //Shell crossing objects: near circular with drag, eccentric and transfer orbits
+    std::mt19937_64 generator(2024);
+    std::vector<IO::Astrodynamics::Propagators::SGP4Elements> catalog;
+    for (int i = 0; i < 60; ++i)
+    {
+        double semiMajorAxis, eccentricity;
+        if (i % 3 == 0)
+        {
+            eccentricity = Uniform(generator, 0.05, 0.7);
+            semiMajorAxis = Uniform(generator, 6900.0, 7100.0) / (1.0 - eccentricity);
+        }
+        else
+        {
+            eccentricity = Uniform(generator, 1E-04, 5E-03);
+            semiMajorAxis = Uniform(generator, 6850.0, 7050.0);
+        }
+        auto elements = CircularElements(i + 1, semiMajorAxis, Uniform(generator, 0.0, IO::Astrodynamics::Constants::PI), Uniform(generator, 0.0, 6.2),
+                                         Uniform(generator, 0.0, 6.2));
+        elements.Eccentricity = eccentricity;
+        elements.PeriapsisArgument = Uniform(generator, 0.0, 6.2);
+        elements.BStar = Uniform(generator, 1E-05, 1E-03);
+        elements.Epoch = IO::Astrodynamics::Time::UTC(std::chrono::duration<double>(begin - Uniform(generator, 0.0, 3.0 * 86400.0)));
+        catalog.push_back(elements);
+    }
+
+    //Pairs crossing their common node at the same time with mean radii differences around the screening radius, they check the mean elements pad
+    for (int i = 0; i < 20; ++i)
+    {
+        const double node = Uniform(generator, 0.0, 6.2);
+        const double inclination = Uniform(generator, 0.3, 1.5);
+        const double semiMajorAxis = Uniform(generator, 6850.0, 7050.0);
+        auto first = CircularElements(1000 + 2 * i, semiMajorAxis, inclination, node, 0.0);
+        auto second = CircularElements(1001 + 2 * i, semiMajorAxis + (0.5 + 1.5 * i / 20.0) * radius / 1000.0, inclination + Uniform(generator, 0.1, 0.5), node, 0.0);
+        first.Epoch = second.Epoch = epoch;
+        catalog.push_back(first);
+        catalog.push_back(second);
+    }
+
+    //Eccentric objects meeting circular ones at their common node, radius at the mutual node moves with the periapsis argument drift, they check the path filter
+    for (int i = 0; i < 40; ++i)
+    {
+        const double node = Uniform(generator, 0.0, 6.2);
+        const double inclination = Uniform(generator, 0.3, 1.2);
+        const double nodeRadius = Uniform(generator, 6850.0, 7050.0);
+        const double eccentricity = Uniform(generator, 0.05, 0.3);
+        const double periapsisArgument = Uniform(generator, 0.0, 6.2);
+        const double semiMajorAxis = nodeRadius * (1.0 + eccentricity * std::cos(periapsisArgument)) / (1.0 - eccentricity * eccentricity);
+        const double tilt = Uniform(generator, 0.3, 0.8);
+        if (semiMajorAxis * (1.0 - eccentricity) < 6600.0)
+        {
+            continue;
+        }
+        const double eccentricAnomaly = 2.0 * std::atan(std::sqrt((1.0 - eccentricity) / (1.0 + eccentricity)) * std::tan(-periapsisArgument * 0.5));
+        auto first = CircularElements(2000 + 2 * i, nodeRadius, inclination, node, 0.0);
+        auto second = CircularElements(2001 + 2 * i, semiMajorAxis, inclination + tilt, node, eccentricAnomaly - eccentricity * std::sin(eccentricAnomaly));
+        second.Eccentricity = eccentricity;
+        second.PeriapsisArgument = periapsisArgument;
+        first.Epoch = second.Epoch = epoch;
+        catalog.push_back(first);
+        catalog.push_back(second);
+    }
+
+    //Decaying object from old elements met by an object on its decayed orbit, they check the drag pad
+    auto decaying = CircularElements(3000, 6620.0, 1.5, 0.4, 0.0);
+    decaying.BStar = 1E-03;
+    decaying.Epoch = IO::Astrodynamics::Time::UTC(std::chrono::duration<double>(begin - 8.0 * 86400.0));
+    catalog.push_back(decaying);
+    catalog.push_back(CrossingElements(3001, IO::Astrodynamics::Propagators::SGP4(decaying), begin + 7200.0, 0.5));
+
+    std::vector<std::size_t> primaries(catalog.size());
+    for (std::size_t i = 0; i < primaries.size(); ++i)
+    {
+        primaries[i] = i;
+    }
+    IO::Astrodynamics::Conjunctions::ConjunctionScreening screening(catalog);
+    IO::Astrodynamics::Conjunctions::ScreeningStatistics statistics;
+    auto conjunctions = screening.Screen(primaries, IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>(IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(begin)),
+                                                                                                                  IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(end))),
+                                         IO::Astrodynamics::Conjunctions::ScreeningVolume::Sphere(radius), IO::Astrodynamics::Time::TimeSpan(60.0s), 4, &statistics);
+
+    //Filters must be effective for this test to be meaningful
+    ASSERT_EQ(catalog.size() * (catalog.size() - 1) / 2, statistics.Pairs);
+    ASSERT_LT(statistics.ApsisFilterPairs, statistics.Pairs);
+    ASSERT_LT(statistics.PathFilterPairs, statistics.ApsisFilterPairs);
+
+    //Every pair is sampled, each local minimum which may be closer than the radius is refined by golden section search
+    const double step = 20.0;
+    const double maximumRelativeSpeed = 20000.0;
+    const std::size_t sampleCount = static_cast<std::size_t>((end - begin) / step) + 1;
+    std::vector<IO::Astrodynamics::Propagators::SGP4> propagators;
+    std::vector<std::vector<double>> positions(catalog.size());
+    std::vector<std::vector<char>> valid(catalog.size());
+    for (std::size_t i = 0; i < catalog.size(); ++i)
+    {
+        propagators.emplace_back(catalog[i]);
+        positions[i].resize(sampleCount * 3);
+        valid[i].resize(sampleCount);
+        for (std::size_t k = 0; k < sampleCount; ++k)
+        {
+            double velocity[3];
+            valid[i][k] = propagators[i].Propagate(IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(begin + k * step)), &positions[i][k * 3], velocity) ==
+                          IO::Astrodynamics::Propagators::SGP4::Status::Success;
+        }
+    }
+
+    std::size_t found{};
+    std::vector<double> distances(sampleCount);
+    for (std::size_t p = 0; p < catalog.size(); ++p)
+    {
+        for (std::size_t s = p + 1; s < catalog.size(); ++s)
+        {
+            for (std::size_t k = 0; k < sampleCount; ++k)
+            {
+                double d2{};
+                for (int i = 0; i < 3; ++i)
+                {
+                    d2 += (positions[s][k * 3 + i] - positions[p][k * 3 + i]) * (positions[s][k * 3 + i] - positions[p][k * 3 + i]);
+                }
+                distances[k] = valid[p][k] && valid[s][k] ? std::sqrt(d2) : std::numeric_limits<double>::infinity();
+            }
+
+            for (std::size_t k = 0; k < sampleCount; ++k)
+            {
+                if ((k > 0 && distances[k] > distances[k - 1]) || (k + 1 < sampleCount && distances[k] > distances[k + 1]) ||
+                    distances[k] > radius + maximumRelativeSpeed * step)
+                {
+                    continue;
+                }
+
+                double low = begin + static_cast<double>(k > 0 ? k - 1 : k) * step;
+                double high = begin + static_cast<double>(k + 1 < sampleCount ? k + 1 : k) * step;
+                const double ratio = 0.5 * (std::sqrt(5.0) - 1.0);
+                while (high - low > 1E-03)
+                {
+                    const double a = high - ratio * (high - low);
+                    const double b = low + ratio * (high - low);
+                    if (SquaredDistance(propagators[p], propagators[s], a) < SquaredDistance(propagators[p], propagators[s], b))
+                    {
+                        high = b;
+                    }
+                    else
+                    {
+                        low = a;
+                    }
+                }
+                const double tca = 0.5 * (low + high);
+                const double missDistance = std::sqrt(SquaredDistance(propagators[p], propagators[s], tca));
+                if (missDistance > radius * 0.999)
+                {
+                    continue;
+                }
+
+                ++found;
+                auto it = std::find_if(conjunctions.begin(), conjunctions.end(), [&](const IO::Astrodynamics::Conjunctions::Conjunction &c)
+                {
+                    return c.PrimaryIndex == p && c.SecondaryIndex == s && std::abs(c.TCA.GetSecondsFromJ2000().count() - tca) < 1.0;
+                });
+                ASSERT_NE(conjunctions.end(), it) << "Missed conjunction between " << p << " and " << s << " at " << tca << " with " << missDistance << " m";
+                ASSERT_NEAR(missDistance, it->MissDistance, 1.0);
+            }
+        }
+    }
+
+    //Nothing is reported beyond the screening radius
+    ASSERT_GT(found, 0);
+    ASSERT_LE(found, conjunctions.size());
+    for (const auto &conjunction: conjunctions)
+    {
+        ASSERT_LE(conjunction.MissDistance, radius);
+    }
+}
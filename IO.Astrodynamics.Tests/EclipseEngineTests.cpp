@@ -0,0 +1,160 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <EclipseEngine.h>
+#include <Spacecraft.h>
+#include <InertialFrames.h>
+#include <OccultationType.h>
+#include <InvalidArgumentException.h>
+#include "TestParameters.h"
+
+namespace
+{
+    //Equatorial low earth orbit with a two body ephemeris written over the whole window
+    std::unique_ptr<IO::Astrodynamics::Body::Spacecraft::Spacecraft> CreateSpacecraft(int id, const IO::Astrodynamics::Time::TDB &epoch, double duration)
+    {
+        auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+        auto orbit = std::make_unique<IO::Astrodynamics::OrbitalParameters::StateVector>(earth, IO::Astrodynamics::Math::Vector3D(6800000.0, 0.0, 0.0),
+                                                                                          IO::Astrodynamics::Math::Vector3D(0.0, 7656.2, 0.0), epoch,
+                                                                                          IO::Astrodynamics::Frames::InertialFrames::ICRF());
+        std::vector<IO::Astrodynamics::OrbitalParameters::StateVector> states;
+        for (double t = 0.0; t <= duration; t += 30.0)
+        {
+            states.push_back(orbit->ToStateVector(epoch + IO::Astrodynamics::Time::TimeSpan(std::chrono::duration<double>(t))));
+        }
+        auto spacecraft = std::make_unique<IO::Astrodynamics::Body::Spacecraft::Spacecraft>(id, "EclipseSpacecraft" + std::to_string(-id), 1000.0, 3000.0,
+                                                                                             std::string(SpacecraftPath), std::move(orbit));
+        spacecraft->WriteEphemeris(states);
+        return spacecraft;
+    }
+}
+
+TEST(EclipseEngine, ShadowFractionUmbra)
+{
+    double toSun[3]{1.496E+08, 0.0, 0.0};
+    double toEarth[3]{7000.0, 0.0, 0.0};
+    ASSERT_DOUBLE_EQ(1.0, IO::Astrodynamics::Illumination::EclipseEngine::ShadowFraction(toSun, 696000.0, toEarth, 6378.0));
+}
+
+TEST(EclipseEngine, ShadowFractionLit)
+{
+    double toSun[3]{1.496E+08, 0.0, 0.0};
+    double toEarth[3]{0.0, 7000.0, 0.0};
+    ASSERT_DOUBLE_EQ(0.0, IO::Astrodynamics::Illumination::EclipseEngine::ShadowFraction(toSun, 696000.0, toEarth, 6378.0));
+
+    //Occulting body behind the source
+    double behind[3]{3.0E+08, 0.0, 0.0};
+    ASSERT_DOUBLE_EQ(0.0, IO::Astrodynamics::Illumination::EclipseEngine::ShadowFraction(toSun, 696000.0, behind, 6378.0));
+}
+
+TEST(EclipseEngine, ShadowFractionPenumbra)
+{
+    //Same apparent radii, separation equal to apparent radius
+    double sunDistance = 1.496E+08;
+    double sunRadius = 696000.0;
+    double a = std::asin(sunRadius / sunDistance);
+    double toSun[3]{sunDistance, 0.0, 0.0};
+    double distance = sunDistance * 0.5;
+    double toBody[3]{distance * std::cos(a), distance * std::sin(a), 0.0};
+    double fraction = IO::Astrodynamics::Illumination::EclipseEngine::ShadowFraction(toSun, sunRadius, toBody, distance * sunRadius / sunDistance);
+    ASSERT_NEAR((2.0 * std::acos(0.5) - 0.5 * std::sqrt(3.0)) / M_PI, fraction, 1E-06);
+}
+
+TEST(EclipseEngine, ShadowFractionAntumbra)
+{
+    double sunDistance = 1.496E+08;
+    double sunRadius = 696000.0;
+    double toSun[3]{sunDistance, 0.0, 0.0};
+    double distance = sunDistance * 0.5;
+    double toBody[3]{distance, 0.0, 0.0};
+    double fraction = IO::Astrodynamics::Illumination::EclipseEngine::ShadowFraction(toSun, sunRadius, toBody, 0.5 * distance * sunRadius / sunDistance);
+    ASSERT_NEAR(0.25, fraction, 1E-05);
+}
+
+TEST(EclipseEngine, InvalidArguments)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    ASSERT_THROW(IO::Astrodynamics::Illumination::EclipseEngine(nullptr, {sun}, {-1}), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(IO::Astrodynamics::Illumination::EclipseEngine(sun, {}, {-1}), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
+
+TEST(EclipseEngine, FindEclipseWindows)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    IO::Astrodynamics::Time::TDB epoch("2021-01-01 00:00:00.0000 TDB");
+    auto spacecraft = CreateSpacecraft(-271, epoch, 3.0 * 3600.0);
+
+    IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> searchWindow(epoch + IO::Astrodynamics::Time::TimeSpan(60s),
+                                                                               epoch + IO::Astrodynamics::Time::TimeSpan(10740s));
+    IO::Astrodynamics::Illumination::EclipseEngine engine(sun, {earth}, {spacecraft->GetId()});
+    auto eclipses = engine.FindEclipseWindows(searchWindow, IO::Astrodynamics::Time::TimeSpan(60s), IO::Astrodynamics::Time::TimeSpan(0.01s));
+    ASSERT_EQ(1, eclipses.size());
+    ASSERT_EQ(spacecraft->GetId(), eclipses[0].SpacecraftId);
+
+    //Same geometry solved by spice occultation finder, the ellipsoid earth shifts boundaries by a few seconds
+    auto umbra = spacecraft->FindWindowsOnOccultationConstraint(searchWindow, *sun, *earth, IO::Astrodynamics::OccultationType::Full(),
+                                                                IO::Astrodynamics::AberrationsEnum::None, IO::Astrodynamics::Time::TimeSpan(60s));
+    auto penumbra = spacecraft->FindWindowsOnOccultationConstraint(searchWindow, *sun, *earth, IO::Astrodynamics::OccultationType::Any(),
+                                                                   IO::Astrodynamics::AberrationsEnum::None, IO::Astrodynamics::Time::TimeSpan(60s));
+    ASSERT_EQ(2, umbra.size());
+    ASSERT_EQ(umbra.size(), eclipses[0].Umbra.size());
+    ASSERT_EQ(penumbra.size(), eclipses[0].Penumbra.size());
+    for (size_t i = 0; i < umbra.size(); ++i)
+    {
+        ASSERT_NEAR(umbra[i].GetStartDate().GetSecondsFromJ2000().count(), eclipses[0].Umbra[i].GetStartDate().GetSecondsFromJ2000().count(), 5.0);
+        ASSERT_NEAR(umbra[i].GetEndDate().GetSecondsFromJ2000().count(), eclipses[0].Umbra[i].GetEndDate().GetSecondsFromJ2000().count(), 5.0);
+    }
+    for (size_t i = 0; i < penumbra.size(); ++i)
+    {
+        ASSERT_NEAR(penumbra[i].GetStartDate().GetSecondsFromJ2000().count(), eclipses[0].Penumbra[i].GetStartDate().GetSecondsFromJ2000().count(), 5.0);
+        ASSERT_NEAR(penumbra[i].GetEndDate().GetSecondsFromJ2000().count(), eclipses[0].Penumbra[i].GetEndDate().GetSecondsFromJ2000().count(), 5.0);
+        ASSERT_GT(eclipses[0].Penumbra[i].GetLength().GetSeconds().count(), eclipses[0].Umbra[i].GetLength().GetSeconds().count());
+    }
+}
+
+TEST(EclipseEngine, ComputeShadowFractions)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    auto moon = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(301);
+    IO::Astrodynamics::Time::TDB epoch("2021-01-01 00:00:00.0000 TDB");
+    auto spacecraft = CreateSpacecraft(-272, epoch, 3.0 * 3600.0);
+
+    IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> searchWindow(epoch + IO::Astrodynamics::Time::TimeSpan(60s),
+                                                                               epoch + IO::Astrodynamics::Time::TimeSpan(10740s));
+    IO::Astrodynamics::Illumination::EclipseEngine engine(sun, {earth, moon}, {spacecraft->GetId(), spacecraft->GetId()});
+    auto eclipses = engine.FindEclipseWindows(searchWindow, IO::Astrodynamics::Time::TimeSpan(60s), IO::Astrodynamics::Time::TimeSpan(0.01s));
+    ASSERT_EQ(2, eclipses.size());
+    ASSERT_FALSE(eclipses[0].Umbra.empty());
+
+    //Total eclipse in the middle of umbra, partial between penumbra and umbra entries, lit before penumbra entry
+    const auto &umbra = eclipses[0].Umbra[0];
+    const auto &penumbra = eclipses[0].Penumbra[0];
+    std::vector<IO::Astrodynamics::Time::TDB> epochs{
+            umbra.GetStartDate() + IO::Astrodynamics::Time::TimeSpan(umbra.GetLength().GetSeconds() * 0.5),
+            penumbra.GetStartDate() + IO::Astrodynamics::Time::TimeSpan((umbra.GetStartDate() - penumbra.GetStartDate()).GetSeconds() * 0.5),
+            penumbra.GetStartDate() - IO::Astrodynamics::Time::TimeSpan(60s)};
+    auto fractions = engine.ComputeShadowFractions(epochs);
+    ASSERT_EQ(6, fractions.size());
+    ASSERT_DOUBLE_EQ(1.0, fractions[0]);
+    ASSERT_GT(fractions[2], 0.0);
+    ASSERT_LT(fractions[2], 1.0);
+    ASSERT_DOUBLE_EQ(0.0, fractions[4]);
+
+    //Fractions are the same for each copy of the spacecraft
+    for (size_t i = 0; i < epochs.size(); ++i)
+    {
+        ASSERT_DOUBLE_EQ(fractions[2 * i], fractions[2 * i + 1]);
+    }
+
+    //Spice visibility agrees outside boundaries
+    auto full = spacecraft->FindWindowsOnOccultationConstraint(IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>(epochs[0] - IO::Astrodynamics::Time::TimeSpan(1s),
+                                                                                                                               epochs[0] + IO::Astrodynamics::Time::TimeSpan(1s)),
+                                                               *sun, *earth, IO::Astrodynamics::OccultationType::Full(), IO::Astrodynamics::AberrationsEnum::None,
+                                                               IO::Astrodynamics::Time::TimeSpan(1s));
+    ASSERT_EQ(1, full.size());
+}
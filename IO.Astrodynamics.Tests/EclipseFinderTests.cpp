@@ -0,0 +1,89 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <EclipseFinder.h>
+#include <InvalidArgumentException.h>
+
+TEST(EclipseFinder, FindSyzygies)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    auto moon = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(301, earth);
+    IO::Astrodynamics::Illumination::EclipseFinder finder(sun, earth, moon);
+
+    auto syzygies = finder.FindSyzygies(IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>(IO::Astrodynamics::Time::TDB("2021-05-01 00:00:00 UTC"),
+                                                                                                      IO::Astrodynamics::Time::TDB("2021-06-01 00:00:00 UTC")));
+    ASSERT_EQ(2, syzygies.size());
+    ASSERT_TRUE(syzygies[0].IsNewMoon);
+    ASSERT_NEAR(IO::Astrodynamics::Time::TDB("2021-05-11 19:00:00 UTC").GetSecondsFromJ2000().count(), syzygies[0].Epoch.GetSecondsFromJ2000().count(), 120.0);
+    ASSERT_FALSE(syzygies[1].IsNewMoon);
+    ASSERT_NEAR(IO::Astrodynamics::Time::TDB("2021-05-26 11:14:00 UTC").GetSecondsFromJ2000().count(), syzygies[1].Epoch.GetSecondsFromJ2000().count(), 120.0);
+}
+
+TEST(EclipseFinder, FindEclipses)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    auto moon = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(301, earth);
+    IO::Astrodynamics::Illumination::EclipseFinder finder(sun, earth, moon);
+
+    auto eclipses = finder.FindEclipses(IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>(IO::Astrodynamics::Time::TDB("2021-01-01 00:00:00 UTC"),
+                                                                                                      IO::Astrodynamics::Time::TDB("2022-01-01 00:00:00 UTC")));
+    ASSERT_EQ(4, eclipses.size());
+
+    //Total lunar eclipse
+    ASSERT_EQ(IO::Astrodynamics::Illumination::EclipseKindEnum::Lunar, eclipses[0].Kind);
+    ASSERT_EQ(IO::Astrodynamics::Illumination::EclipseTypeEnum::Total, eclipses[0].Type);
+    ASSERT_NEAR(IO::Astrodynamics::Time::TDB("2021-05-26 11:18:43 UTC").GetSecondsFromJ2000().count(), eclipses[0].Maximum.GetSecondsFromJ2000().count(), 120.0);
+    ASSERT_NEAR(1.0095, eclipses[0].Magnitude, 0.01);
+    ASSERT_TRUE(eclipses[0].PenumbralPhase.has_value());
+    ASSERT_TRUE(eclipses[0].UmbralPhase.has_value());
+    ASSERT_TRUE(eclipses[0].TotalPhase.has_value());
+    ASSERT_NEAR(14.5 * 60.0, eclipses[0].TotalPhase->GetLength().GetSeconds().count(), 120.0);
+
+    //Annular solar eclipse
+    ASSERT_EQ(IO::Astrodynamics::Illumination::EclipseKindEnum::Solar, eclipses[1].Kind);
+    ASSERT_EQ(IO::Astrodynamics::Illumination::EclipseTypeEnum::Annular, eclipses[1].Type);
+    ASSERT_NEAR(IO::Astrodynamics::Time::TDB("2021-06-10 10:41:54 UTC").GetSecondsFromJ2000().count(), eclipses[1].Maximum.GetSecondsFromJ2000().count(), 600.0);
+    ASSERT_TRUE(eclipses[1].UmbralPhase.has_value());
+
+    //Partial lunar eclipse
+    ASSERT_EQ(IO::Astrodynamics::Illumination::EclipseKindEnum::Lunar, eclipses[2].Kind);
+    ASSERT_EQ(IO::Astrodynamics::Illumination::EclipseTypeEnum::Partial, eclipses[2].Type);
+    ASSERT_NEAR(IO::Astrodynamics::Time::TDB("2021-11-19 09:02:55 UTC").GetSecondsFromJ2000().count(), eclipses[2].Maximum.GetSecondsFromJ2000().count(), 120.0);
+    ASSERT_NEAR(0.974, eclipses[2].Magnitude, 0.01);
+    ASSERT_FALSE(eclipses[2].TotalPhase.has_value());
+
+    //Total solar eclipse
+    ASSERT_EQ(IO::Astrodynamics::Illumination::EclipseKindEnum::Solar, eclipses[3].Kind);
+    ASSERT_EQ(IO::Astrodynamics::Illumination::EclipseTypeEnum::Total, eclipses[3].Type);
+    ASSERT_NEAR(IO::Astrodynamics::Time::TDB("2021-12-04 07:33:26 UTC").GetSecondsFromJ2000().count(), eclipses[3].Maximum.GetSecondsFromJ2000().count(), 600.0);
+}
+
+TEST(EclipseFinder, NonCentralSolarEclipse)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    auto moon = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(301, earth);
+    IO::Astrodynamics::Illumination::EclipseFinder finder(sun, earth, moon);
+
+    //Non-central total solar eclipse of 2043-04-09, the umbra axis misses the earth
+    auto eclipses = finder.FindEclipses(IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>(IO::Astrodynamics::Time::TDB("2043-04-05 00:00:00 UTC"),
+                                                                                                      IO::Astrodynamics::Time::TDB("2043-04-15 00:00:00 UTC")));
+    ASSERT_EQ(1, eclipses.size());
+    ASSERT_EQ(IO::Astrodynamics::Illumination::EclipseKindEnum::Solar, eclipses[0].Kind);
+    ASSERT_EQ(IO::Astrodynamics::Illumination::EclipseTypeEnum::Total, eclipses[0].Type);
+    ASSERT_NEAR(IO::Astrodynamics::Time::TDB("2043-04-09 18:57:49 UTC").GetSecondsFromJ2000().count(), eclipses[0].Maximum.GetSecondsFromJ2000().count(), 600.0);
+    ASSERT_GT(eclipses[0].Gamma, 1.0);
+    ASSERT_GT(eclipses[0].Magnitude, 1.0);
+    ASSERT_TRUE(eclipses[0].PenumbralPhase.has_value());
+    ASSERT_FALSE(eclipses[0].UmbralPhase.has_value());
+}
+
+TEST(EclipseFinder, InvalidArguments)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    ASSERT_THROW(IO::Astrodynamics::Illumination::EclipseFinder(sun, nullptr, nullptr), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
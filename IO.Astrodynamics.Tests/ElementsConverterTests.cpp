@@ -0,0 +1,268 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <ElementsConverter.h>
+#include <CelestialBody.h>
+#include <ConicOrbitalElements.h>
+#include <Constants.h>
+#include <EquinoctialElements.h>
+#include <InertialFrames.h>
+#include <InvalidArgumentException.h>
+
+using IO::Astrodynamics::OrbitalParameters::ElementsConverter;
+using IO::Astrodynamics::OrbitalParameters::ElementsType;
+
+namespace
+{
+    constexpr double MU = 3.986004418E+14;
+
+    //Keplerian elements in structure of arrays layout
+    std::vector<double> ToSoA(const std::vector<std::vector<double>> &objects)
+    {
+        std::vector<double> result(6 * objects.size());
+        for (std::size_t i = 0; i < objects.size(); ++i)
+        {
+            for (std::size_t j = 0; j < 6; ++j)
+            {
+                result[j * objects.size() + i] = objects[i][j];
+            }
+        }
+        return result;
+    }
+
+    //Elliptic orbits, including circular and equatorial ones
+    const std::vector<std::vector<double>> ELLIPTIC_ORBITS{
+            {7000000.0,  0.1,   0.9,   1.2, 2.5, 0.3},
+            {6800000.0,  0.0,   0.9,   1.2, 0.0, 0.3},
+            {26000000.0, 0.7,   0.0,   0.0, 2.5, 4.0},
+            {42164000.0, 0.0,   0.0,   0.0, 0.0, 5.1},
+            {8000000.0,  0.3,   2.5,   4.0, 1.0, 6.0},
+            {20000000.0, 0.95,  1.57,  3.0, 5.0, 0.01},
+            {7200000.0,  1E-04, 1E-05, 2.0, 3.0, 1.0}
+    };
+
+    inline void AssertAngle(double expected, double actual, double tolerance)
+    {
+        ASSERT_NEAR(0.0, std::remainder(expected - actual, IO::Astrodynamics::Constants::_2PI), tolerance);
+    }
+}
+
+TEST(ElementsConverter, KeplerianToState)
+{
+    const double a = 7000000.0, e = 0.1;
+    const std::vector<double> keplerian{a, e, 0.0, 0.0, 0.0, 0.0};
+    double state[6];
+    ElementsConverter::Convert(ElementsType::Keplerian, ElementsType::StateVector, 1, MU, keplerian.data(), state);
+    ASSERT_NEAR(a * (1.0 - e), state[0], 1E-06);
+    ASSERT_NEAR(0.0, state[1], 1E-06);
+    ASSERT_NEAR(0.0, state[2], 1E-06);
+    ASSERT_NEAR(0.0, state[3], 1E-09);
+    ASSERT_NEAR(std::sqrt(MU / a * (1.0 + e) / (1.0 - e)), state[4], 1E-09);
+    ASSERT_NEAR(0.0, state[5], 1E-09);
+
+    //Inclined orbit crossing the ascending node at true anomaly PI/2
+    const double i = 0.5, node = 1.0;
+    const double eccentricAnomaly = 2.0 * std::atan(std::sqrt((1.0 - e) / (1.0 + e)));
+    const std::vector<double> inclined{a, e, i, node, 1.5 * IO::Astrodynamics::Constants::PI, eccentricAnomaly - e * std::sin(eccentricAnomaly)};
+    ElementsConverter::Convert(ElementsType::Keplerian, ElementsType::StateVector, 1, MU, inclined.data(), state);
+    const double r = a * (1.0 - e * e);
+    ASSERT_NEAR(r * std::cos(node), state[0], 1E-05);
+    ASSERT_NEAR(r * std::sin(node), state[1], 1E-05);
+    ASSERT_NEAR(0.0, state[2], 1E-05);
+    ASSERT_GT(state[5], 0.0);
+}
+
+TEST(ElementsConverter, RoundTrips)
+{
+    const std::size_t count = ELLIPTIC_ORBITS.size();
+    const std::vector<double> keplerian = ToSoA(ELLIPTIC_ORBITS);
+    std::vector<double> states(6 * count);
+    ElementsConverter::Convert(ElementsType::Keplerian, ElementsType::StateVector, count, MU, keplerian.data(), states.data());
+
+    const ElementsType types[]{ElementsType::StateVector, ElementsType::Keplerian, ElementsType::Equinoctial, ElementsType::ModifiedEquinoctial};
+    std::vector<double> first(6 * count), second(6 * count), result(6 * count);
+    for (auto input: types)
+    {
+        for (auto output: types)
+        {
+            ElementsConverter::Convert(ElementsType::StateVector, input, count, MU, states.data(), first.data());
+            ElementsConverter::Convert(input, output, count, MU, first.data(), second.data());
+            ElementsConverter::Convert(output, ElementsType::StateVector, count, MU, second.data(), result.data());
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const double radius = std::sqrt(states[i] * states[i] + states[count + i] * states[count + i] + states[2 * count + i] * states[2 * count + i]);
+                const double speed = std::sqrt(states[3 * count + i] * states[3 * count + i] + states[4 * count + i] * states[4 * count + i] +
+                                               states[5 * count + i] * states[5 * count + i]);
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    ASSERT_NEAR(states[j * count + i], result[j * count + i], radius * 1E-10);
+                    ASSERT_NEAR(states[(j + 3) * count + i], result[(j + 3) * count + i], speed * 1E-10);
+                }
+            }
+        }
+    }
+}
+
+TEST(ElementsConverter, SingularOrbits)
+{
+    //Circular equatorial orbit, position is held by the mean anomaly
+    const double radius = 42164000.0;
+    const double speed = std::sqrt(MU / radius);
+    const double longitude = 2.0;
+    const std::vector<double> state{radius * std::cos(longitude), radius * std::sin(longitude), 0.0, -speed * std::sin(longitude), speed * std::cos(longitude), 0.0};
+    double keplerian[6];
+    ElementsConverter::Convert(ElementsType::StateVector, ElementsType::Keplerian, 1, MU, state.data(), keplerian);
+    ASSERT_NEAR(radius, keplerian[0], 1E-03);
+    ASSERT_NEAR(0.0, keplerian[1], 1E-12);
+    ASSERT_NEAR(0.0, keplerian[2], 1E-12);
+    ASSERT_DOUBLE_EQ(0.0, keplerian[3]);
+    ASSERT_DOUBLE_EQ(0.0, keplerian[4]);
+    ASSERT_NEAR(longitude, keplerian[5], 1E-12);
+
+    double equinoctial[6];
+    ElementsConverter::Convert(ElementsType::StateVector, ElementsType::Equinoctial, 1, MU, state.data(), equinoctial);
+    ASSERT_NEAR(radius, equinoctial[0], 1E-03);
+    for (std::size_t i = 1; i < 5; ++i)
+    {
+        ASSERT_NEAR(0.0, equinoctial[i], 1E-12);
+    }
+    ASSERT_NEAR(longitude, equinoctial[5], 1E-12);
+
+    double modified[6];
+    ElementsConverter::Convert(ElementsType::StateVector, ElementsType::ModifiedEquinoctial, 1, MU, state.data(), modified);
+    ASSERT_NEAR(radius, modified[0], 1E-03);
+    ASSERT_NEAR(longitude, modified[5], 1E-12);
+
+    //Polar circular orbit, periapsis argument is 0 and position is held by the mean anomaly
+    const std::vector<double> polarState{0.0, radius * std::cos(1.0), radius * std::sin(1.0), 0.0, -speed * std::sin(1.0), speed * std::cos(1.0)};
+    ElementsConverter::Convert(ElementsType::StateVector, ElementsType::Keplerian, 1, MU, polarState.data(), keplerian);
+    ASSERT_NEAR(IO::Astrodynamics::Constants::PI / 2.0, keplerian[2], 1E-12);
+    ASSERT_NEAR(IO::Astrodynamics::Constants::PI / 2.0, keplerian[3], 1E-12);
+    ASSERT_DOUBLE_EQ(0.0, keplerian[4]);
+    ASSERT_NEAR(1.0, keplerian[5], 1E-12);
+}
+
+TEST(ElementsConverter, HyperbolicOrbits)
+{
+    const double perigee = 7000000.0, e = 1.5;
+    const double a = perigee / (1.0 - e);
+    const std::vector<double> keplerian{a, e, 0.4, 1.0, 2.0, 1.5};
+    double state[6], back[6];
+    ElementsConverter::Convert(ElementsType::Keplerian, ElementsType::StateVector, 1, MU, keplerian.data(), state);
+    ElementsConverter::Convert(ElementsType::StateVector, ElementsType::Keplerian, 1, MU, state, back);
+    ASSERT_NEAR(a, back[0], 1E-03);
+    for (std::size_t i = 1; i < 6; ++i)
+    {
+        ASSERT_NEAR(keplerian[i], back[i], 1E-10);
+    }
+
+    //Modified equinoctial elements are defined
+    double modified[6];
+    ElementsConverter::Convert(ElementsType::Keplerian, ElementsType::ModifiedEquinoctial, 1, MU, keplerian.data(), modified);
+    ASSERT_NEAR(a * (1.0 - e * e), modified[0], 1E-03);
+    ElementsConverter::Convert(ElementsType::ModifiedEquinoctial, ElementsType::StateVector, 1, MU, modified, back);
+    for (std::size_t i = 0; i < 6; ++i)
+    {
+        ASSERT_NEAR(state[i], back[i], std::abs(state[i]) * 1E-10 + 1E-06);
+    }
+
+    //Equinoctial elements are not
+    double equinoctial[6];
+    ElementsConverter::Convert(ElementsType::StateVector, ElementsType::Equinoctial, 1, MU, state, equinoctial);
+    for (double component: equinoctial)
+    {
+        ASSERT_TRUE(std::isnan(component));
+    }
+    ElementsConverter::Convert(ElementsType::ModifiedEquinoctial, ElementsType::Equinoctial, 1, MU, modified, equinoctial);
+    ASSERT_TRUE(std::isnan(equinoctial[0]));
+}
+
+TEST(ElementsConverter, ConicOrbitalElements)
+{
+    //Same conversions solved by conics_c and oscltx_c
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    const double mu = earth->GetMu();
+    const IO::Astrodynamics::Time::TDB epoch(std::chrono::duration<double>(700000000.0));
+    auto orbits = ELLIPTIC_ORBITS;
+    orbits.push_back({7000000.0 / (1.0 - 1.5), 1.5, 0.4, 1.0, 2.0, 1.5});
+
+    for (const auto &keplerian: orbits)
+    {
+        double state[6];
+        ElementsConverter::Convert(ElementsType::Keplerian, ElementsType::StateVector, 1, mu, keplerian.data(), state);
+        IO::Astrodynamics::OrbitalParameters::ConicOrbitalElements conic(earth, keplerian[0] * (1.0 - keplerian[1]), keplerian[1], keplerian[2], keplerian[3],
+                                                                         keplerian[4], keplerian[5], epoch, IO::Astrodynamics::Frames::InertialFrames::ICRF());
+        auto expected = conic.ToStateVector(epoch);
+        const double radius = expected.GetPosition().Magnitude();
+        const double speed = expected.GetVelocity().Magnitude();
+        ASSERT_NEAR(expected.GetPosition().GetX(), state[0], radius * 1E-10);
+        ASSERT_NEAR(expected.GetPosition().GetY(), state[1], radius * 1E-10);
+        ASSERT_NEAR(expected.GetPosition().GetZ(), state[2], radius * 1E-10);
+        ASSERT_NEAR(expected.GetVelocity().GetX(), state[3], speed * 1E-10);
+        ASSERT_NEAR(expected.GetVelocity().GetY(), state[4], speed * 1E-10);
+        ASSERT_NEAR(expected.GetVelocity().GetZ(), state[5], speed * 1E-10);
+
+        //Angles are compared on orbits where they are defined
+        if (keplerian[1] < 1E-03 || keplerian[2] < 1E-03)
+        {
+            continue;
+        }
+        double back[6];
+        ElementsConverter::Convert(ElementsType::StateVector, ElementsType::Keplerian, 1, mu, state, back);
+        IO::Astrodynamics::OrbitalParameters::ConicOrbitalElements osculating(expected);
+        ASSERT_NEAR(osculating.GetPerifocalDistance(), back[0] * (1.0 - back[1]), radius * 1E-10);
+        ASSERT_NEAR(osculating.GetEccentricity(), back[1], 1E-10);
+        AssertAngle(osculating.GetInclination(), back[2], 1E-10);
+        AssertAngle(osculating.GetRightAscendingNodeLongitude(), back[3], 1E-10);
+        AssertAngle(osculating.GetPeriapsisArgument(), back[4], 1E-10);
+        AssertAngle(osculating.GetMeanAnomaly(), back[5], 1E-09);
+    }
+}
+
+TEST(ElementsConverter, EquinoctialElements)
+{
+    //Elements of the equinoctial class and states solved by eqncpv_c, the pole at declination PI/2 and right ascension -PI/2 keeps the inertial frame
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    const double mu = earth->GetMu();
+    const IO::Astrodynamics::Time::TDB epoch(std::chrono::duration<double>(700000000.0));
+    for (const auto &keplerian: ELLIPTIC_ORBITS)
+    {
+        double equinoctial[6];
+        ElementsConverter::Convert(ElementsType::Keplerian, ElementsType::Equinoctial, 1, mu, keplerian.data(), equinoctial);
+        IO::Astrodynamics::OrbitalParameters::EquinoctialElements expected(earth, keplerian[0], keplerian[1], keplerian[2], keplerian[4], keplerian[3], keplerian[5],
+                                                                           0.0, 0.0, -IO::Astrodynamics::Constants::PI2, IO::Astrodynamics::Constants::PI2, epoch,
+                                                                           IO::Astrodynamics::Frames::InertialFrames::ICRF());
+        ASSERT_DOUBLE_EQ(expected.GetSemiMajorAxis(), equinoctial[0]);
+        ASSERT_NEAR(expected.GetH(), equinoctial[1], 1E-14);
+        ASSERT_NEAR(expected.GetK(), equinoctial[2], 1E-14);
+        ASSERT_NEAR(expected.GetP(), equinoctial[3], 1E-14);
+        ASSERT_NEAR(expected.GetQ(), equinoctial[4], 1E-14);
+        AssertAngle(expected.GetL(), equinoctial[5], 1E-13);
+
+        double state[6];
+        ElementsConverter::Convert(ElementsType::Equinoctial, ElementsType::StateVector, 1, mu, equinoctial, state);
+        auto expectedState = expected.ToStateVector(epoch);
+        const double radius = expectedState.GetPosition().Magnitude();
+        const double speed = expectedState.GetVelocity().Magnitude();
+        ASSERT_NEAR(expectedState.GetPosition().GetX(), state[0], radius * 1E-10);
+        ASSERT_NEAR(expectedState.GetPosition().GetY(), state[1], radius * 1E-10);
+        ASSERT_NEAR(expectedState.GetPosition().GetZ(), state[2], radius * 1E-10);
+        ASSERT_NEAR(expectedState.GetVelocity().GetX(), state[3], speed * 1E-10);
+        ASSERT_NEAR(expectedState.GetVelocity().GetY(), state[4], speed * 1E-10);
+        ASSERT_NEAR(expectedState.GetVelocity().GetZ(), state[5], speed * 1E-10);
+    }
+}
+
+TEST(ElementsConverter, InvalidArguments)
+{
+    double elements[6]{};
+    ASSERT_THROW(ElementsConverter::Convert(ElementsType::StateVector, ElementsType::Keplerian, 1, 0.0, elements, elements),
+                 IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(ElementsConverter::Convert(ElementsType::StateVector, ElementsType::Keplerian, 1, MU, nullptr, elements),
+                 IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_NO_THROW(ElementsConverter::Convert(ElementsType::StateVector, ElementsType::Keplerian, 0, MU, nullptr, nullptr));
+}
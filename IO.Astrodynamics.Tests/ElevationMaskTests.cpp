@@ -0,0 +1,40 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <ElevationMask.h>
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+
+TEST(ElevationMask, Constant)
+{
+    IO::Astrodynamics::Sites::ElevationMask mask(0.1);
+    ASSERT_TRUE(mask.IsConstant());
+    ASSERT_DOUBLE_EQ(0.1, mask.GetElevation(0.0));
+    ASSERT_DOUBLE_EQ(0.1, mask.GetElevation(4.0));
+    ASSERT_DOUBLE_EQ(0.1, mask.GetMinimum());
+    ASSERT_DOUBLE_EQ(0.1, mask.GetMaximum());
+}
+
+TEST(ElevationMask, TerrainProfile)
+{
+    IO::Astrodynamics::Sites::ElevationMask mask({IO::Astrodynamics::Constants::PI, 0.0, IO::Astrodynamics::Constants::PI2},
+                                                 {0.3, 0.1, 0.2});
+    ASSERT_FALSE(mask.IsConstant());
+    ASSERT_DOUBLE_EQ(0.1, mask.GetMinimum());
+    ASSERT_DOUBLE_EQ(0.3, mask.GetMaximum());
+    ASSERT_DOUBLE_EQ(0.1, mask.GetElevation(0.0));
+    ASSERT_DOUBLE_EQ(0.15, mask.GetElevation(IO::Astrodynamics::Constants::PI2 * 0.5));
+    ASSERT_DOUBLE_EQ(0.25, mask.GetElevation(IO::Astrodynamics::Constants::PI * 0.75));
+
+    //Wrap around north
+    ASSERT_NEAR(0.2, mask.GetElevation(IO::Astrodynamics::Constants::PI * 1.5), 1E-12);
+    ASSERT_NEAR(0.2, mask.GetElevation(-IO::Astrodynamics::Constants::PI * 0.5), 1E-12);
+}
+
+TEST(ElevationMask, InvalidArguments)
+{
+    ASSERT_THROW(IO::Astrodynamics::Sites::ElevationMask({0.0, 1.0}, {0.1}), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(IO::Astrodynamics::Sites::ElevationMask({7.0}, {0.1}), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
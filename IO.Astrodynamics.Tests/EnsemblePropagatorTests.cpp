@@ -0,0 +1,293 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <EnsemblePropagator.h>
+#include <NumericalPropagator.h>
+#include <PointMassGravity.h>
+#include <ZonalHarmonicsGravity.h>
+#include <TwoBodyPropagator.h>
+#include <InvalidArgumentException.h>
+#include <SDKException.h>
+
+using IO::Astrodynamics::Propagators::EnsemblePropagator;
+using IO::Astrodynamics::Propagators::ForceModel;
+using IO::Astrodynamics::Propagators::PointMassGravity;
+using IO::Astrodynamics::Propagators::ZonalHarmonicsGravity;
+
+namespace
+{
+    constexpr double MU = 3.986004418E+14;
+    constexpr double RADIUS = 6378137.0;
+    constexpr double J2 = 1.08262668E-03;
+    constexpr double J3 = -2.5323E-06;
+    constexpr double J4 = -1.6204E-06;
+
+    const double MEAN[6]{6800000.0, 0.0, 0.0, 0.0, 5000.0, 5800.0};
+
+    //Diagonal covariance with a position/velocity correlation
+    std::vector<double> Covariance()
+    {
+        std::vector<double> covariance(36, 0.0);
+        const double variances[6]{100.0, 400.0, 900.0, 1E-04, 4E-04, 9E-04};
+        for (int i = 0; i < 6; ++i)
+        {
+            covariance[6 * i + i] = variances[i];
+        }
+        covariance[6 * 0 + 3] = covariance[6 * 3 + 0] = 0.5 * std::sqrt(variances[0] * variances[3]);
+        return covariance;
+    }
+
+    std::vector<std::shared_ptr<ForceModel>> Forces()
+    {
+        const double pole[3]{0.0, 0.0, 1.0};
+        return {std::make_shared<PointMassGravity>(MU), std::make_shared<ZonalHarmonicsGravity>(MU, RADIUS, J2, J3, J4, pole)};
+    }
+
+    //Fails after a given epoch
+    class FailingForce final : public ForceModel
+    {
+    private:
+        const double m_epoch;
+
+    public:
+        explicit FailingForce(double epoch) : m_epoch{epoch}
+        {
+        }
+
+        void AddAcceleration(double epoch, [[maybe_unused]] const double state[6], [[maybe_unused]] double acceleration[3]) const override
+        {
+            if (epoch > m_epoch)
+            {
+                throw IO::Astrodynamics::Exception::SDKException("Force model failure");
+            }
+        }
+    };
+}
+
+TEST(EnsemblePropagator, Sample)
+{
+    const auto covariance = Covariance();
+    const std::size_t count = 20000;
+    const auto samples = EnsemblePropagator::Sample(MEAN, covariance.data(), count, 42);
+    ASSERT_EQ(6 * count, samples.size());
+
+    for (int i = 0; i < 6; ++i)
+    {
+        double mean = 0.0;
+        for (std::size_t s = 0; s < count; ++s)
+        {
+            mean += samples[6 * s + i];
+        }
+        mean /= count;
+        ASSERT_NEAR(MEAN[i], mean, 4.0 * std::sqrt(covariance[6 * i + i] / count));
+
+        for (int j = 0; j <= i; ++j)
+        {
+            double meanJ = 0.0;
+            for (std::size_t s = 0; s < count; ++s)
+            {
+                meanJ += samples[6 * s + j];
+            }
+            meanJ /= count;
+            double value = 0.0;
+            for (std::size_t s = 0; s < count; ++s)
+            {
+                value += (samples[6 * s + i] - mean) * (samples[6 * s + j] - meanJ);
+            }
+            value /= count - 1;
+            const double scale = std::sqrt(covariance[6 * i + i] * covariance[6 * j + j]);
+            ASSERT_NEAR(covariance[6 * i + j], value, 0.05 * scale);
+        }
+    }
+
+    //Same seed gives same samples
+    ASSERT_EQ(samples, EnsemblePropagator::Sample(MEAN, covariance.data(), count, 42));
+    ASSERT_NE(samples, EnsemblePropagator::Sample(MEAN, covariance.data(), count, 43));
+}
+
+TEST(EnsemblePropagator, SampleDegenerated)
+{
+    //Null variance keeps the mean value
+    std::vector<double> covariance(36, 0.0);
+    covariance[0] = 25.0;
+    const auto samples = EnsemblePropagator::Sample(MEAN, covariance.data(), 100, 1);
+    for (std::size_t s = 0; s < 100; ++s)
+    {
+        for (int i = 1; i < 6; ++i)
+        {
+            ASSERT_DOUBLE_EQ(MEAN[i], samples[6 * s + i]);
+        }
+    }
+
+    covariance[6] = covariance[1] = 10.0;
+    ASSERT_THROW((void) EnsemblePropagator::Sample(MEAN, covariance.data(), 10, 1), IO::Astrodynamics::Exception::InvalidArgumentException);
+    covariance[6] = covariance[1] = 0.0;
+    covariance[0] = -1.0;
+    ASSERT_THROW((void) EnsemblePropagator::Sample(MEAN, covariance.data(), 10, 1), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
+
+TEST(EnsemblePropagator, TrajectoriesTwoBody)
+{
+    const auto covariance = Covariance();
+    const std::size_t count = 150;
+    const auto states = EnsemblePropagator::Sample(MEAN, covariance.data(), count, 7);
+    EnsemblePropagator propagator({std::make_shared<PointMassGravity>(MU)}, 10.0);
+    const double outputStep = 600.0;
+    const std::size_t outputCount = 10;
+    const auto trajectories = propagator.PropagateTrajectories(100.0, count, states.data(), outputStep, outputCount, 3);
+    ASSERT_EQ(6 * count * outputCount, trajectories.size());
+
+    for (std::size_t j = 0; j < count; ++j)
+    {
+        const IO::Astrodynamics::Propagators::TwoBodyPropagator twoBody(MU, states.data() + 6 * j, states.data() + 6 * j + 3);
+        for (std::size_t i = 0; i < outputCount; ++i)
+        {
+            double position[3], velocity[3];
+            twoBody.Propagate(static_cast<double>(i) * outputStep, position, velocity);
+            const double *state = trajectories.data() + (i * count + j) * 6;
+            for (int k = 0; k < 3; ++k)
+            {
+                ASSERT_NEAR(position[k], state[k], 0.2);
+                ASSERT_NEAR(velocity[k], state[k + 3], 2E-04);
+            }
+        }
+    }
+}
+
+TEST(EnsemblePropagator, MatchNumericalPropagator)
+{
+    //Same Runge-Kutta 4 grid, forward and backward
+    const std::size_t count = 3;
+    const auto states = EnsemblePropagator::Sample(MEAN, Covariance().data(), count, 3);
+    for (double outputStep: {300.0, -300.0})
+    {
+        EnsemblePropagator ensemble(Forces(), 20.0);
+        const auto trajectories = ensemble.PropagateTrajectories(0.0, count, states.data(), outputStep, 5, 1);
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            IO::Astrodynamics::Propagators::NumericalPropagator propagator(Forces(), IO::Astrodynamics::Propagators::IntegrationScheme::RungeKutta4, 20.0);
+            propagator.Propagate(0.0, states.data() + 6 * j, std::min(0.0, 4.0 * outputStep), std::max(0.0, 4.0 * outputStep));
+            double state[6];
+            propagator.GetState(4.0 * outputStep, state);
+            for (int k = 0; k < 6; ++k)
+            {
+                ASSERT_NEAR(state[k], trajectories[(4 * count + j) * 6 + k], 1E-06 * (k < 3 ? 1.0 : 1E-03));
+            }
+        }
+    }
+}
+
+TEST(EnsemblePropagator, Statistics)
+{
+    const std::size_t count = 301;
+    const auto states = EnsemblePropagator::Sample(MEAN, Covariance().data(), count, 11);
+    EnsemblePropagator propagator(Forces(), 30.0);
+    const auto trajectories = propagator.PropagateTrajectories(0.0, count, states.data(), 900.0, 4, 2);
+    const auto statistics = propagator.PropagateStatistics(0.0, count, states.data(), 900.0, 4, {0.0, 50.0, 100.0, 25.0}, 2);
+    ASSERT_EQ(4, statistics.EpochCount);
+    ASSERT_EQ(4, statistics.PercentileCount);
+
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        ASSERT_DOUBLE_EQ(900.0 * i, statistics.Epochs[i]);
+        for (std::size_t c = 0; c < 6; ++c)
+        {
+            std::vector<double> values(count);
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                values[j] = trajectories[(i * count + j) * 6 + c];
+            }
+            double mean = 0.0;
+            for (double value: values)
+            {
+                mean += value;
+            }
+            mean /= count;
+            double variance = 0.0;
+            for (double value: values)
+            {
+                variance += (value - mean) * (value - mean);
+            }
+            variance /= count - 1;
+            ASSERT_NEAR(mean, statistics.Mean[6 * i + c], 1E-09 * std::abs(mean) + 1E-12);
+            ASSERT_NEAR(variance, statistics.Covariance[36 * i + 7 * c], 1E-09 * variance);
+            for (std::size_t k = 0; k < 6; ++k)
+            {
+                ASSERT_DOUBLE_EQ(statistics.Covariance[36 * i + 6 * c + k], statistics.Covariance[36 * i + 6 * k + c]);
+            }
+
+            std::sort(values.begin(), values.end());
+            const double *percentiles = statistics.Percentiles.data() + i * 4 * 6;
+            ASSERT_DOUBLE_EQ(values.front(), percentiles[c]);
+            ASSERT_DOUBLE_EQ(values[150], percentiles[6 + c]);
+            ASSERT_DOUBLE_EQ(values.back(), percentiles[12 + c]);
+            ASSERT_DOUBLE_EQ(values[75], percentiles[18 + c]);
+        }
+    }
+
+    //Dispersion grows along track
+    ASSERT_GT(statistics.Covariance[36 * 3 + 7], statistics.Covariance[7]);
+}
+
+TEST(EnsemblePropagator, ThreadsIndependent)
+{
+    const std::size_t count = 1000;
+    const auto states = EnsemblePropagator::Sample(MEAN, Covariance().data(), count, 5);
+    EnsemblePropagator propagator(Forces(), 60.0);
+    const auto single = propagator.PropagateTrajectories(0.0, count, states.data(), 1800.0, 3, 1);
+    const auto multiple = propagator.PropagateTrajectories(0.0, count, states.data(), 1800.0, 3, 4);
+    ASSERT_EQ(single, multiple);
+}
+
+TEST(EnsemblePropagator, StatisticsThreadsIndependent)
+{
+    const std::size_t count = 1000;
+    const auto states = EnsemblePropagator::Sample(MEAN, Covariance().data(), count, 9);
+    EnsemblePropagator propagator(Forces(), 60.0);
+    const auto single = propagator.PropagateStatistics(0.0, count, states.data(), 1800.0, 4, {5.0, 95.0}, 1);
+    const auto multiple = propagator.PropagateStatistics(0.0, count, states.data(), 1800.0, 4, {5.0, 95.0}, 5);
+    ASSERT_EQ(single.Mean, multiple.Mean);
+    ASSERT_EQ(single.Covariance, multiple.Covariance);
+    ASSERT_EQ(single.Percentiles, multiple.Percentiles);
+}
+
+TEST(EnsemblePropagator, ForceModelFailure)
+{
+    //Failures are reported whatever the threads count, workers waiting for the others are released
+    const std::size_t count = 500;
+    const auto states = EnsemblePropagator::Sample(MEAN, Covariance().data(), count, 13);
+    EnsemblePropagator propagator({std::make_shared<PointMassGravity>(MU), std::make_shared<FailingForce>(1000.0)}, 60.0);
+    for (unsigned int threadCount: {1u, 3u})
+    {
+        ASSERT_THROW((void) propagator.PropagateTrajectories(0.0, count, states.data(), 600.0, 4, threadCount), IO::Astrodynamics::Exception::SDKException);
+        ASSERT_THROW((void) propagator.PropagateStatistics(0.0, count, states.data(), 600.0, 4, {}, threadCount), IO::Astrodynamics::Exception::SDKException);
+    }
+    ASSERT_NO_THROW((void) propagator.PropagateStatistics(0.0, count, states.data(), 600.0, 2, {}, 3));
+}
+
+TEST(EnsemblePropagator, InvalidArguments)
+{
+    ASSERT_THROW(EnsemblePropagator({}), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(EnsemblePropagator({nullptr}), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(EnsemblePropagator(Forces(), 0.0), IO::Astrodynamics::Exception::InvalidArgumentException);
+
+    EnsemblePropagator propagator(Forces());
+    const auto states = EnsemblePropagator::Sample(MEAN, Covariance().data(), 2, 5);
+    ASSERT_THROW((void) propagator.PropagateTrajectories(0.0, 0, states.data(), 60.0, 2), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW((void) propagator.PropagateTrajectories(0.0, 2, states.data(), 60.0, 0), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW((void) propagator.PropagateTrajectories(0.0, 2, states.data(), 0.0, 2), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW((void) propagator.PropagateStatistics(0.0, 1, states.data(), 60.0, 2), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW((void) propagator.PropagateStatistics(0.0, 2, states.data(), 60.0, 2, {101.0}), IO::Astrodynamics::Exception::InvalidArgumentException);
+
+    auto invalid = states;
+    invalid[4] = std::nan("");
+    ASSERT_THROW((void) propagator.PropagateTrajectories(0.0, 2, invalid.data(), 60.0, 2), IO::Astrodynamics::Exception::InvalidArgumentException);
+
+    //Single output is the initial states
+    ASSERT_EQ(states, propagator.PropagateTrajectories(0.0, 2, states.data(), 0.0, 1));
+}
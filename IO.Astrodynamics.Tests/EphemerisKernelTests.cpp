@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <EphemerisKernel.h>
+#include <cmath>
 #include <filesystem>
 #include <vector>
 #include <StateVector.h>
@@ -11,8 +12,50 @@
 #include <InertialFrames.h>
 #include <CelestialBody.h>
 #include <memory>
+#include <TLE.h>
+#include <TLECatalog.h>
+#include <InvalidArgumentException.h>
+#include <sofa.h>
 
 using namespace std::chrono_literals;
+
+namespace
+{
+	//evsgp4_c state rotated from TEME to J2000 like SPK type 10 evaluation: IAU 1976 precession, IAU 1980 nutation and equation of the equinoxes dpsi cos(eps)
+	void TwoLineElementsToJ2000(const IO::Astrodynamics::OrbitalParameters::TLE &tle, const IO::Astrodynamics::Time::TDB &epoch, double position[3], double velocity[3])
+	{
+		auto teme = tle.ToStateVector(epoch);
+		const double date = epoch.GetSecondsFromJ2000().count() / 86400.0;
+		double dpsi{}, deps{};
+		iauNut80(2451545.0, date, &dpsi, &deps);
+		double equinox[3][3];
+		iauIr(equinox);
+		iauRz(-dpsi * std::cos(iauObl80(2451545.0, date)), equinox);
+		double precessionNutation[3][3];
+		iauPnm80(2451545.0, date, precessionNutation);
+
+		double temePosition[3]{teme.GetPosition().GetX(), teme.GetPosition().GetY(), teme.GetPosition().GetZ()};
+		double temeVelocity[3]{teme.GetVelocity().GetX(), teme.GetVelocity().GetY(), teme.GetVelocity().GetZ()};
+		double trueOfDate[3];
+		iauRxp(equinox, temePosition, trueOfDate);
+		iauTrxp(precessionNutation, trueOfDate, position);
+		iauRxp(equinox, temeVelocity, trueOfDate);
+		iauTrxp(precessionNutation, trueOfDate, velocity);
+	}
+
+	void AssertTwoLineElementsState(const IO::Astrodynamics::OrbitalParameters::TLE &tle, const IO::Astrodynamics::OrbitalParameters::StateVector &actual)
+	{
+		double position[3], velocity[3];
+		TwoLineElementsToJ2000(tle, actual.GetEpoch(), position, velocity);
+		ASSERT_NEAR(position[0], actual.GetPosition().GetX(), 1.0);
+		ASSERT_NEAR(position[1], actual.GetPosition().GetY(), 1.0);
+		ASSERT_NEAR(position[2], actual.GetPosition().GetZ(), 1.0);
+		ASSERT_NEAR(velocity[0], actual.GetVelocity().GetX(), 1E-03);
+		ASSERT_NEAR(velocity[1], actual.GetVelocity().GetY(), 1E-03);
+		ASSERT_NEAR(velocity[2], actual.GetVelocity().GetZ(), 1E-03);
+	}
+}
+
 TEST(EphemerisKernel, WriteEvenlySpacedData)
 {
 
@@ -213,3 +256,66 @@ TEST(EphemerisKernel, AddTooLongComment)
 
 	ASSERT_THROW(iss.WriteEphemerisKernelComment("This is a big message which exceed the maximum chars allowed-This is a big message which exceed the maximum chars allowed"), IO::Astrodynamics::Exception::SDKException);
 }
+
+TEST(EphemerisKernel, WriteTwoLineElements)
+{
+	auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+	std::string lines[3]{"ISS", "1 25544U 98067A   21020.53488036  .00016717  00000-0  10270-3 0  9054", "2 25544  51.6423 353.0312 0000493 320.8755  39.2360 15.49309423 25703"};
+	IO::Astrodynamics::OrbitalParameters::TLE tle(earth, lines);
+	auto catalog = IO::Astrodynamics::OrbitalParameters::TLECatalog::Parse(lines[1] + "\n" + lines[2]);
+
+	std::filesystem::create_directories(SpacecraftPath);
+	IO::Astrodynamics::Kernels::EphemerisKernel kernel(std::string(SpacecraftPath) + "/TLE25544.spk", -125544);
+	IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> window(IO::Astrodynamics::Time::TDB(664419000.0s), IO::Astrodynamics::Time::TDB(664419000.0s + 86400.0s));
+	kernel.WriteTwoLineElements({catalog.GetRecord(0)}, window);
+
+	ASSERT_TRUE(kernel.IsLoaded());
+	ASSERT_LT(std::filesystem::file_size(kernel.GetPath()), 10000);
+	ASSERT_DOUBLE_EQ(window.GetStartDate().GetSecondsFromJ2000().count(), kernel.GetCoverageWindow().GetStartDate().GetSecondsFromJ2000().count());
+	ASSERT_DOUBLE_EQ(window.GetEndDate().GetSecondsFromJ2000().count(), kernel.GetCoverageWindow().GetEndDate().GetSecondsFromJ2000().count());
+
+	for (double t = 0.0; t <= 86400.0; t += 10800.0)
+	{
+		IO::Astrodynamics::Time::TDB epoch(std::chrono::duration<double>(664419000.0 + t));
+		AssertTwoLineElementsState(tle, kernel.ReadStateVector(*earth, IO::Astrodynamics::Frames::InertialFrames::ICRF(), IO::Astrodynamics::AberrationsEnum::None, epoch));
+	}
+
+	ASSERT_THROW(kernel.WriteTwoLineElements({}, window), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
+
+TEST(EphemerisKernel, WriteTwoLineElementsCatalog)
+{
+	const std::string buffer = "ISS\n"
+							   "1 25544U 98067A   21020.53488036  .00016717  00000-0  10270-3 0  9054\n"
+							   "2 25544  51.6423 353.0312 0000493 320.8755  39.2360 15.49309423 25703\n"
+							   "ISS\n"
+							   "1 25544U 98067A   21020.53488036  .00016717  00000-0  10270-3 0  9054\n"
+							   "2 25544  51.6423 353.0312 0000493 320.8755  39.2360 15.49309423 25703\n"
+							   "VANGUARD 1\n"
+							   "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753\n"
+							   "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667\n";
+	auto catalog = IO::Astrodynamics::OrbitalParameters::TLECatalog::Parse(buffer);
+	std::filesystem::create_directories(SpacecraftPath);
+	const std::string path = std::string(SpacecraftPath) + "/TLECatalog.spk";
+	IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> window(IO::Astrodynamics::Time::TDB(664419000.0s), IO::Astrodynamics::Time::TDB(664419000.0s + 86400.0s));
+
+	ASSERT_EQ(2, IO::Astrodynamics::Kernels::EphemerisKernel::WriteTwoLineElementsCatalog(path, catalog, window));
+	ASSERT_EQ(-100005, IO::Astrodynamics::Kernels::EphemerisKernel::TwoLineElementsObjectId(5));
+
+	IO::Astrodynamics::Kernels::EphemerisKernel vanguard(path, IO::Astrodynamics::Kernels::EphemerisKernel::TwoLineElementsObjectId(5));
+	ASSERT_TRUE(vanguard.IsLoaded());
+	ASSERT_DOUBLE_EQ(window.GetStartDate().GetSecondsFromJ2000().count(), vanguard.GetCoverageWindow().GetStartDate().GetSecondsFromJ2000().count());
+
+	auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+	std::string issLines[3]{"ISS", "1 25544U 98067A   21020.53488036  .00016717  00000-0  10270-3 0  9054", "2 25544  51.6423 353.0312 0000493 320.8755  39.2360 15.49309423 25703"};
+	std::string vanguardLines[3]{"VANGUARD 1", "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753", "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667"};
+	IO::Astrodynamics::OrbitalParameters::TLE issTLE(earth, issLines);
+	IO::Astrodynamics::OrbitalParameters::TLE vanguardTLE(earth, vanguardLines);
+	IO::Astrodynamics::Kernels::EphemerisKernel iss(path, IO::Astrodynamics::Kernels::EphemerisKernel::TwoLineElementsObjectId(25544));
+	for (double t = 0.0; t <= 86400.0; t += 10800.0)
+	{
+		IO::Astrodynamics::Time::TDB epoch(std::chrono::duration<double>(664419000.0 + t));
+		AssertTwoLineElementsState(issTLE, iss.ReadStateVector(*earth, IO::Astrodynamics::Frames::InertialFrames::ICRF(), IO::Astrodynamics::AberrationsEnum::None, epoch));
+		AssertTwoLineElementsState(vanguardTLE, vanguard.ReadStateVector(*earth, IO::Astrodynamics::Frames::InertialFrames::ICRF(), IO::Astrodynamics::AberrationsEnum::None, epoch));
+	}
+}
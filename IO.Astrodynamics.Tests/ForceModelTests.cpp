@@ -0,0 +1,262 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <PointMassGravity.h>
+#include <ZonalHarmonicsGravity.h>
+#include <ThirdBodyGravity.h>
+#include <GeopotentialGravity.h>
+#include <CelestialBody.h>
+#include <InertialFrames.h>
+#include <InvalidArgumentException.h>
+
+using IO::Astrodynamics::Propagators::PointMassGravity;
+using IO::Astrodynamics::Propagators::ZonalHarmonicsGravity;
+using IO::Astrodynamics::Propagators::ThirdBodyGravity;
+using IO::Astrodynamics::Propagators::GeopotentialGravity;
+using IO::Astrodynamics::Propagators::GeopotentialModel;
+
+namespace
+{
+    constexpr double MU = 3.986004418E+14;
+    constexpr double RADIUS = 6378137.0;
+    constexpr double J2 = 1.08262668E-03;
+    constexpr double J3 = -2.5323E-06;
+    constexpr double J4 = -1.6204E-06;
+
+    //Zonal part of the potential
+    double ZonalPotential(const double *position, const double *pole)
+    {
+        const double r = std::sqrt(position[0] * position[0] + position[1] * position[1] + position[2] * position[2]);
+        const double x = (position[0] * pole[0] + position[1] * pole[1] + position[2] * pole[2]) / r;
+        const double p2 = 0.5 * (3.0 * x * x - 1.0);
+        const double p3 = 0.5 * (5.0 * x * x * x - 3.0 * x);
+        const double p4 = (35.0 * x * x * x * x - 30.0 * x * x + 3.0) / 8.0;
+        const double ratio = RADIUS / r;
+        return -MU / r * (J2 * ratio * ratio * p2 + J3 * ratio * ratio * ratio * p3 + J4 * ratio * ratio * ratio * ratio * p4);
+    }
+
+    //Moon like circular motion in the XY plane
+    constexpr double MOON_MU = 4.9028E+12;
+    constexpr double MOON_DISTANCE = 384400000.0;
+    constexpr double MOON_RATE = 2.6617E-06;
+
+    std::vector<double> CircularStates(double begin, double step, int count)
+    {
+        std::vector<double> states;
+        for (int i = 0; i < count; ++i)
+        {
+            const double angle = MOON_RATE * (begin + step * i);
+            states.insert(states.end(), {MOON_DISTANCE * std::cos(angle), MOON_DISTANCE * std::sin(angle), 0.0,
+                                         -MOON_DISTANCE * MOON_RATE * std::sin(angle), MOON_DISTANCE * MOON_RATE * std::cos(angle), 0.0});
+        }
+        return states;
+    }
+}
+
+TEST(ForceModel, PointMassGravity)
+{
+    PointMassGravity gravity(MU);
+    ASSERT_DOUBLE_EQ(MU, gravity.GetMu());
+
+    const double state[6]{7000000.0, -2000000.0, 1000000.0, 0.0, 0.0, 0.0};
+    double acceleration[3]{1.0, 2.0, 3.0};
+    gravity.AddAcceleration(0.0, state, acceleration);
+    const double r = std::sqrt(state[0] * state[0] + state[1] * state[1] + state[2] * state[2]);
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_NEAR(1.0 + i - MU * state[i] / (r * r * r), acceleration[i], 1E-12);
+    }
+
+    ASSERT_THROW(PointMassGravity(0.0), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
+
+TEST(ForceModel, ZonalHarmonicsGradient)
+{
+    //Tilted pole, accelerations are compared with the potential gradient
+    const double pole[3]{0.1, -0.2, 0.97};
+    const double norm = std::sqrt(pole[0] * pole[0] + pole[1] * pole[1] + pole[2] * pole[2]);
+    const double unitPole[3]{pole[0] / norm, pole[1] / norm, pole[2] / norm};
+    ZonalHarmonicsGravity gravity(MU, RADIUS, J2, J3, J4, pole);
+
+    const std::vector<std::vector<double>> positions{{7000000.0,  -2000000.0, 1000000.0},
+                                                     {1000000.0,  500000.0,   6900000.0},
+                                                     {-4000000.0, 3000000.0,  -5000000.0},
+                                                     {4.2E+07,    1.0E+06,    -2.0E+05}};
+    for (const auto &position: positions)
+    {
+        const double state[6]{position[0], position[1], position[2], 0.0, 0.0, 0.0};
+        double acceleration[3]{};
+        gravity.AddAcceleration(0.0, state, acceleration);
+
+        const double delta = 1.0;
+        double magnitude = 0.0;
+        for (int i = 0; i < 3; ++i)
+        {
+            double plus[3]{position[0], position[1], position[2]};
+            double minus[3]{position[0], position[1], position[2]};
+            plus[i] += delta;
+            minus[i] -= delta;
+            const double expected = (ZonalPotential(plus, unitPole) - ZonalPotential(minus, unitPole)) / (2.0 * delta);
+            ASSERT_NEAR(expected, acceleration[i], 1E-09 + 1E-06 * std::abs(expected));
+            magnitude += acceleration[i] * acceleration[i];
+        }
+        ASSERT_GT(magnitude, 0.0);
+    }
+}
+
+TEST(ForceModel, ZonalHarmonicsInvalidArguments)
+{
+    const double pole[3]{0.0, 0.0, 1.0};
+    const double nullPole[3]{0.0, 0.0, 0.0};
+    ASSERT_THROW(ZonalHarmonicsGravity(0.0, RADIUS, J2, J3, J4, pole), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(ZonalHarmonicsGravity(MU, -1.0, J2, J3, J4, pole), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(ZonalHarmonicsGravity(MU, RADIUS, J2, J3, J4, nullPole), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
+
+TEST(ForceModel, ThirdBodyInterpolation)
+{
+    ThirdBodyGravity gravity(MOON_MU, -3600.0, 3600.0, CircularStates(-3600.0, 3600.0, 30));
+    gravity.Prepare(0.0, 86400.0);
+
+    for (double epoch = -3600.0; epoch <= 100000.0; epoch += 777.0)
+    {
+        double position[3];
+        gravity.GetPosition(epoch, position);
+        ASSERT_NEAR(MOON_DISTANCE * std::cos(MOON_RATE * epoch), position[0], 0.05);
+        ASSERT_NEAR(MOON_DISTANCE * std::sin(MOON_RATE * epoch), position[1], 0.05);
+        ASSERT_DOUBLE_EQ(0.0, position[2]);
+    }
+}
+
+TEST(ForceModel, ThirdBodyAcceleration)
+{
+    ThirdBodyGravity gravity(MOON_MU, 0.0, 3600.0, CircularStates(0.0, 3600.0, 2));
+    const double state[6]{7000000.0, 1000000.0, -500000.0, 0.0, 0.0, 0.0};
+    double acceleration[3]{};
+    gravity.AddAcceleration(0.0, state, acceleration);
+
+    const double moon[3]{MOON_DISTANCE, 0.0, 0.0};
+    const double relative[3]{moon[0] - state[0], moon[1] - state[1], moon[2] - state[2]};
+    const double d = std::sqrt(relative[0] * relative[0] + relative[1] * relative[1] + relative[2] * relative[2]);
+    for (int i = 0; i < 3; ++i)
+    {
+        const double expected = MOON_MU * (relative[i] / (d * d * d) - moon[i] / (MOON_DISTANCE * MOON_DISTANCE * MOON_DISTANCE));
+        ASSERT_NEAR(expected, acceleration[i], 1E-15);
+    }
+
+    //Tidal acceleration is much smaller than the direct one
+    ASSERT_LT(std::abs(acceleration[0]), MOON_MU / (d * d) * 0.1);
+}
+
+TEST(ForceModel, ThirdBodyEphemeris)
+{
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    auto moon = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(301, earth);
+    const auto &frame = IO::Astrodynamics::Frames::InertialFrames::ICRF();
+    const double begin = IO::Astrodynamics::Time::TDB("2021-01-01 00:00:00 TDB").GetSecondsFromJ2000().count();
+    ThirdBodyGravity gravity(moon, earth, frame);
+    gravity.Prepare(begin, begin + 86400.0);
+
+    //Off grid epochs, interpolated positions against kernel positions
+    for (double epoch = begin; epoch <= begin + 86400.0; epoch += 1234.5)
+    {
+        double position[3];
+        gravity.GetPosition(epoch, position);
+        auto expected = moon->ReadEphemeris(frame, IO::Astrodynamics::AberrationsEnum::None,
+                                            IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(epoch)), *earth).GetPosition();
+        ASSERT_NEAR(expected.GetX(), position[0], 1.0);
+        ASSERT_NEAR(expected.GetY(), position[1], 1.0);
+        ASSERT_NEAR(expected.GetZ(), position[2], 1.0);
+    }
+}
+
+TEST(ForceModel, ZonalHarmonicsFromBody)
+{
+    IO::Astrodynamics::Body::CelestialBody earth(399);
+    const auto &frame = IO::Astrodynamics::Frames::InertialFrames::ICRF();
+    const IO::Astrodynamics::Time::TDB epoch("2021-01-01 00:00:00 TDB");
+    ZonalHarmonicsGravity gravity(earth, frame, epoch);
+
+    //Same accelerations as explicit constants, pole read from the body fixed frame
+    auto pole = earth.GetBodyFixedFrame().TransformVector(frame, IO::Astrodynamics::Math::Vector3D::VectorZ, epoch).Normalize();
+    ASSERT_NEAR(1.0, pole.GetZ(), 1E-04);
+    const double poleData[3]{pole.GetX(), pole.GetY(), pole.GetZ()};
+    ZonalHarmonicsGravity expected(earth.GetMu(), earth.GetRadius().GetX(), earth.GetJ2(), earth.GetJ3(), earth.GetJ4(), poleData);
+
+    const double state[6]{4000000.0, -3000000.0, 4500000.0, 0.0, 0.0, 0.0};
+    double acceleration[3]{}, expectedAcceleration[3]{};
+    gravity.AddAcceleration(epoch.GetSecondsFromJ2000().count(), state, acceleration);
+    expected.AddAcceleration(epoch.GetSecondsFromJ2000().count(), state, expectedAcceleration);
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_DOUBLE_EQ(expectedAcceleration[i], acceleration[i]);
+    }
+
+    //J2 dominates, relative to the point mass
+    const double r = std::sqrt(state[0] * state[0] + state[1] * state[1] + state[2] * state[2]);
+    const double norm = std::sqrt(acceleration[0] * acceleration[0] + acceleration[1] * acceleration[1] + acceleration[2] * acceleration[2]);
+    ASSERT_GT(norm / (earth.GetMu() / (r * r)), 1E-04);
+    ASSERT_LT(norm / (earth.GetMu() / (r * r)), 1E-02);
+}
+
+TEST(ForceModel, ThirdBodyInvalidArguments)
+{
+    ASSERT_THROW(ThirdBodyGravity(MOON_MU, 0.0, 3600.0, CircularStates(0.0, 3600.0, 1)), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(ThirdBodyGravity(MOON_MU, 0.0, 0.0, CircularStates(0.0, 3600.0, 2)), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(ThirdBodyGravity(-1.0, 0.0, 3600.0, CircularStates(0.0, 3600.0, 2)), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(ThirdBodyGravity(nullptr, nullptr, IO::Astrodynamics::Frames::Frames("J2000")), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
+
+TEST(ForceModel, BatchAccelerations)
+{
+    const double pole[3]{0.1, -0.2, 0.97};
+    const double angle = 0.3;
+    std::vector<double> rotations{std::cos(angle), std::sin(angle), 0.0, -std::sin(angle), std::cos(angle), 0.0, 0.0, 0.0, 1.0,
+                                  0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    rotations.insert(rotations.end(), rotations.begin(), rotations.end());
+    auto model = std::make_shared<GeopotentialModel>(MU, RADIUS, 2, 2, std::vector<double>{1.0, 0.0, 0.0, -4.84E-04, 0.0, 2.44E-06},
+                                                     std::vector<double>{0.0, 0.0, 0.0, 0.0, 0.0, -1.40E-06});
+    const std::vector<std::shared_ptr<IO::Astrodynamics::Propagators::ForceModel>> forces{
+            std::make_shared<PointMassGravity>(MU), std::make_shared<ZonalHarmonicsGravity>(MU, RADIUS, J2, J3, J4, pole),
+            std::make_shared<ThirdBodyGravity>(MOON_MU, 0.0, 3600.0, CircularStates(0.0, 3600.0, 3)),
+            std::make_shared<GeopotentialGravity>(model, 0.0, 3600.0, rotations)};
+
+    //Members stored by component, batch results must match single evaluations
+    const std::size_t count = 7;
+    std::vector<double> components(6 * count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        components[i] = 7000000.0 - 300000.0 * i;
+        components[count + i] = -2000000.0 + 900000.0 * i;
+        components[2 * count + i] = 1000000.0 * std::cos(static_cast<double>(i));
+        components[3 * count + i] = 100.0 * i;
+        components[4 * count + i] = 7500.0;
+        components[5 * count + i] = -10.0 * i;
+    }
+    const double *states[6];
+    for (std::size_t c = 0; c < 6; ++c)
+    {
+        states[c] = components.data() + c * count;
+    }
+
+    for (const auto &force: forces)
+    {
+        std::vector<double> batch(3 * count, 1.0);
+        double *accelerations[3]{batch.data(), batch.data() + count, batch.data() + 2 * count};
+        force->AddAccelerations(1800.0, count, states, accelerations);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const double state[6]{states[0][i], states[1][i], states[2][i], states[3][i], states[4][i], states[5][i]};
+            double acceleration[3]{1.0, 1.0, 1.0};
+            force->AddAcceleration(1800.0, state, acceleration);
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                ASSERT_NEAR(acceleration[j], accelerations[j][i], 1E-15 * std::abs(acceleration[j]) + 1E-18);
+            }
+        }
+    }
+}
@@ -0,0 +1,212 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <GeometryFinderCache.h>
+#include <KernelsLoader.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <SpiceUsr.h>
+
+using namespace std::chrono_literals;
+
+//Fake constraint : true during the first hour of each 4 hours period
+static std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+FakeSearch(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window, int &calls, double &searchedLength)
+{
+    calls++;
+    double start = window.GetStartDate().GetSecondsFromJ2000().count();
+    double end = window.GetEndDate().GetSecondsFromJ2000().count();
+    searchedLength += end - start;
+    std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> res;
+    for (double t = std::floor(start / 14400.0) * 14400.0; t < end; t += 14400.0)
+    {
+        double s = std::max(t, start);
+        double e = std::min(t + 3600.0, end);
+        if (s <= e)
+        {
+            res.emplace_back(IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(s)), IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(e)));
+        }
+    }
+    return res;
+}
+
+static IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> MakeWindow(double start, double end)
+{
+    return IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>(IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(start)),
+                                                                          IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(end)));
+}
+
+TEST(GeometryFinderCache, HitAndMiss)
+{
+    auto &cache = IO::Astrodynamics::Constraints::GeometryFinderCache::GetInstance();
+    cache.Clear();
+    cache.ResetStatistics();
+    int calls{};
+    double searched{};
+    auto search = [&](const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &w) { return FakeSearch(w, calls, searched); };
+
+    auto res = cache.Find("TEST|HitAndMiss", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    ASSERT_EQ(6, res.size());
+    ASSERT_EQ(1, calls);
+
+    auto res2 = cache.Find("TEST|HitAndMiss", MakeWindow(3000.0, 50000.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    ASSERT_EQ(1, calls);
+    ASSERT_EQ(4, res2.size());
+    ASSERT_DOUBLE_EQ(3000.0, res2[0].GetStartDate().GetSecondsFromJ2000().count());
+    ASSERT_DOUBLE_EQ(3600.0, res2[0].GetEndDate().GetSecondsFromJ2000().count());
+    ASSERT_DOUBLE_EQ(43200.0, res2[3].GetStartDate().GetSecondsFromJ2000().count());
+
+    auto stats = cache.GetStatistics();
+    ASSERT_EQ(1, stats.Hits);
+    ASSERT_EQ(1, stats.Misses);
+    ASSERT_EQ(0, stats.PartialHits);
+}
+
+TEST(GeometryFinderCache, SlidingWindow)
+{
+    auto &cache = IO::Astrodynamics::Constraints::GeometryFinderCache::GetInstance();
+    cache.Clear();
+    cache.ResetStatistics();
+    int calls{};
+    double searched{};
+    auto search = [&](const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &w) { return FakeSearch(w, calls, searched); };
+
+    cache.Find("TEST|Sliding", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    searched = 0.0;
+
+    //Window slides forward by 2 hours, the boundary falls inside a valid interval
+    auto res = cache.Find("TEST|Sliding", MakeWindow(7200.0, 86400.0 + 7200.0 + 1800.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    ASSERT_EQ(2, calls);
+    ASSERT_DOUBLE_EQ(7200.0 + 1800.0 + 60.0, searched);
+
+    auto expected = FakeSearch(MakeWindow(7200.0, 86400.0 + 7200.0 + 1800.0), calls, searched);
+    ASSERT_EQ(expected.size(), res.size());
+    for (size_t i = 0; i < res.size(); ++i)
+    {
+        ASSERT_EQ(expected[i], res[i]);
+    }
+
+    //Interval crossing the previous coverage end must be merged
+    ASSERT_DOUBLE_EQ(86400.0, res.back().GetStartDate().GetSecondsFromJ2000().count());
+    ASSERT_DOUBLE_EQ(86400.0 + 3600.0, res.back().GetEndDate().GetSecondsFromJ2000().count());
+
+    auto stats = cache.GetStatistics();
+    ASSERT_EQ(1, stats.PartialHits);
+    ASSERT_EQ(1, stats.Misses);
+}
+
+TEST(GeometryFinderCache, DisjointWindow)
+{
+    auto &cache = IO::Astrodynamics::Constraints::GeometryFinderCache::GetInstance();
+    cache.Clear();
+    cache.ResetStatistics();
+    int calls{};
+    double searched{};
+    auto search = [&](const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &w) { return FakeSearch(w, calls, searched); };
+
+    cache.Find("TEST|Disjoint", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    cache.Find("TEST|Disjoint", MakeWindow(864000.0, 950400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    ASSERT_EQ(2, calls);
+    ASSERT_EQ(2, cache.GetStatistics().Misses);
+    ASSERT_EQ(1, cache.GetSize());
+}
+
+TEST(GeometryFinderCache, NotIncremental)
+{
+    auto &cache = IO::Astrodynamics::Constraints::GeometryFinderCache::GetInstance();
+    cache.Clear();
+    cache.ResetStatistics();
+    int calls{};
+    double searched{};
+    auto search = [&](const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &w) { return FakeSearch(w, calls, searched); };
+
+    cache.Find("TEST|Absolute", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search, false);
+    cache.Find("TEST|Absolute", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search, false);
+    ASSERT_EQ(1, calls);
+    cache.Find("TEST|Absolute", MakeWindow(0.0, 43200.0), IO::Astrodynamics::Time::TimeSpan(60s), search, false);
+    ASSERT_EQ(2, calls);
+}
+
+TEST(GeometryFinderCache, InvalidateOnKernelChange)
+{
+    auto &cache = IO::Astrodynamics::Constraints::GeometryFinderCache::GetInstance();
+    cache.Clear();
+    cache.ResetStatistics();
+    int calls{};
+    double searched{};
+    auto search = [&](const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &w) { return FakeSearch(w, calls, searched); };
+
+    cache.Find("TEST|Kernels", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+
+    std::filesystem::create_directories("Data/User");
+    std::string kernelPath{"Data/User/GeometryFinderCacheTest.tk"};
+    {
+        std::ofstream kernel(kernelPath);
+        kernel << "\\begindata" << std::endl << "IO_GEOMETRY_FINDER_CACHE_TEST = 1" << std::endl << "\\begintext" << std::endl;
+    }
+    IO::Astrodynamics::Kernels::KernelsLoader::Load(kernelPath);
+
+    cache.Find("TEST|Kernels", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    ASSERT_EQ(2, calls);
+    ASSERT_EQ(1, cache.GetStatistics().Invalidations);
+
+    IO::Astrodynamics::Kernels::KernelsLoader::Unload(kernelPath);
+    cache.Find("TEST|Kernels", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    ASSERT_EQ(3, calls);
+    ASSERT_EQ(2, cache.GetStatistics().Invalidations);
+}
+
+TEST(GeometryFinderCache, InvalidateOnPoolChange)
+{
+    auto &cache = IO::Astrodynamics::Constraints::GeometryFinderCache::GetInstance();
+    cache.Clear();
+    cache.ResetStatistics();
+    int calls{};
+    double searched{};
+    auto search = [&](const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &w) { return FakeSearch(w, calls, searched); };
+
+    SpiceDouble value{1.0};
+    pdpool_c("IO_GEOMETRY_FINDER_CACHE_POOL_TEST", 1, &value);
+    cache.Find("TEST|Pool", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    cache.Find("TEST|Pool", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    ASSERT_EQ(1, calls);
+
+    //Same variable, new value, no kernel loaded
+    value = 2.0;
+    pdpool_c("IO_GEOMETRY_FINDER_CACHE_POOL_TEST", 1, &value);
+    cache.Find("TEST|Pool", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    ASSERT_EQ(2, calls);
+    ASSERT_EQ(2, cache.GetStatistics().Misses);
+    ASSERT_EQ(1, cache.GetStatistics().Invalidations);
+
+    dvpool_c("IO_GEOMETRY_FINDER_CACHE_POOL_TEST");
+    cache.Find("TEST|Pool", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    ASSERT_EQ(3, calls);
+    ASSERT_EQ(2, cache.GetStatistics().Invalidations);
+}
+
+TEST(GeometryFinderCache, LeastRecentlyUsedEviction)
+{
+    auto &cache = IO::Astrodynamics::Constraints::GeometryFinderCache::GetInstance();
+    cache.Clear();
+    cache.SetMaximumEntries(2);
+    int calls{};
+    double searched{};
+    auto search = [&](const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &w) { return FakeSearch(w, calls, searched); };
+
+    cache.Find("TEST|A", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    cache.Find("TEST|B", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    cache.Find("TEST|A", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    cache.Find("TEST|C", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    ASSERT_EQ(3, calls);
+    cache.Find("TEST|A", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    ASSERT_EQ(3, calls);
+    cache.Find("TEST|B", MakeWindow(0.0, 86400.0), IO::Astrodynamics::Time::TimeSpan(60s), search);
+    ASSERT_EQ(4, calls);
+    ASSERT_EQ(2, cache.GetSize());
+    cache.SetMaximumEntries(1024);
+    cache.Clear();
+}
@@ -0,0 +1,411 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+#include <GeopotentialModel.h>
+#include <GeopotentialGravity.h>
+#include <ZonalHarmonicsGravity.h>
+#include <InvalidArgumentException.h>
+#include <SDKException.h>
+
+using IO::Astrodynamics::Propagators::GeopotentialModel;
+using IO::Astrodynamics::Propagators::GeopotentialGravity;
+
+namespace
+{
+    constexpr double MU = 3.986004415E+14;
+    constexpr double RADIUS = 6378136.3;
+
+    std::size_t Index(int n, int m)
+    {
+        return static_cast<std::size_t>(n * (n + 1) / 2 + m);
+    }
+
+    //Deterministic field with every coefficient defined, decreasing like a real field
+    GeopotentialModel Field(int degree, int order)
+    {
+        std::vector<double> c(Index(degree + 1, 0)), s(Index(degree + 1, 0));
+        c[0] = 1.0;
+        for (int n = 2; n <= degree; ++n)
+        {
+            for (int m = 0; m <= n; ++m)
+            {
+                c[Index(n, m)] = std::sin(1.3 * n + 0.7 * m) * 1E-04 / (n * n);
+                s[Index(n, m)] = m == 0 ? 0.0 : std::cos(0.9 * n - 1.1 * m) * 1E-04 / (n * n);
+            }
+        }
+        c[Index(2, 0)] = -0.484165143790815E-03;
+        return {MU, RADIUS, degree, order, c, s};
+    }
+
+    const std::vector<std::vector<double>> POSITIONS{{6800000.0,  0.0,        0.0},
+                                                     {4808326.0,  0.0,        4808326.0},
+                                                     {-3000000.0, 4000000.0,  -5000000.0},
+                                                     {1000.0,     -2000.0,    7000000.0},
+                                                     {2.0E+07,    -3.0E+07,   1.0E+06}};
+
+    double Factorial(int n)
+    {
+        double value = 1.0;
+        for (int i = 2; i <= n; ++i)
+        {
+            value *= i;
+        }
+        return value;
+    }
+
+    //Unnormalized associated Legendre function without Condon-Shortley phase, from the explicit Legendre polynomial derivatives
+    double Legendre(int n, int m, double x)
+    {
+        double derivative = 0.0;
+        for (int k = 0; 2 * k <= n - m; ++k)
+        {
+            const int power = n - 2 * k;
+            const double binomial = Factorial(n) / (Factorial(k) * Factorial(n - k));
+            const double central = Factorial(2 * n - 2 * k) / (Factorial(n) * Factorial(n - 2 * k));
+            derivative += (k % 2 == 0 ? 1.0 : -1.0) * binomial * central * Factorial(power) / Factorial(power - m) * std::pow(x, power - m);
+        }
+        return std::pow(1.0 - x * x, 0.5 * m) * derivative / std::pow(2.0, n);
+    }
+
+    //Brute force potential, term by term from unnormalized functions
+    double ReferencePotential(const GeopotentialModel &model, const std::vector<double> &c, const std::vector<double> &s, const double position[3])
+    {
+        const double r = std::sqrt(position[0] * position[0] + position[1] * position[1] + position[2] * position[2]);
+        const double latitude = std::asin(position[2] / r);
+        const double longitude = std::atan2(position[1], position[0]);
+        double sum = 0.0;
+        for (int n = 0; n <= model.GetMaxDegree(); ++n)
+        {
+            for (int m = 0; m <= std::min(n, model.GetMaxOrder()); ++m)
+            {
+                const double normalization = std::sqrt((m == 0 ? 1.0 : 2.0) * (2.0 * n + 1.0) * Factorial(n - m) / Factorial(n + m));
+                sum += std::pow(RADIUS / r, n) * normalization * Legendre(n, m, std::sin(latitude)) *
+                       (c[Index(n, m)] * std::cos(m * longitude) + s[Index(n, m)] * std::sin(m * longitude));
+            }
+        }
+        return MU / r * sum;
+    }
+
+    constexpr const char *EGM = "    2    0   -0.484165143790815D-03    0.000000000000000D+00    0.7481239490D-11    0.0000000000D+00\n"
+                                "    2    1   -0.206615509074176D-09    0.138441389137979D-08    0.7063781502D-11    0.7348347201D-11\n"
+                                "    2    2    0.243938357328313D-05   -0.140027370385934D-05    0.7230231722D-11    0.7425816951D-11\n"
+                                "    3    0    0.957161207093473D-06    0.000000000000000D+00    0.5731430751D-11    0.0000000000D+00\n"
+                                "    3    1    0.203046201047864D-05    0.248200415856872D-06    0.5726633183D-11    0.5976692146D-11\n"
+                                "\n";
+}
+
+TEST(GeopotentialModel, CentralTerm)
+{
+    GeopotentialModel model(MU, RADIUS, 0, 0, {1.0}, {0.0});
+    for (const auto &position: POSITIONS)
+    {
+        const double r = std::sqrt(position[0] * position[0] + position[1] * position[1] + position[2] * position[2]);
+        double acceleration[3], gradient[9];
+        model.GetAcceleration(position.data(), acceleration, gradient);
+        ASSERT_NEAR(MU / r, model.GetPotential(position.data()), 1E-06);
+        for (int i = 0; i < 3; ++i)
+        {
+            ASSERT_NEAR(-MU * position[i] / (r * r * r), acceleration[i], 1E-12);
+            for (int j = 0; j < 3; ++j)
+            {
+                const double expected = MU / (r * r * r) * (3.0 * position[i] * position[j] / (r * r) - (i == j ? 1.0 : 0.0));
+                ASSERT_NEAR(expected, gradient[3 * i + j], 1E-18);
+            }
+        }
+    }
+}
+
+TEST(GeopotentialModel, ZonalTerms)
+{
+    //Normalized zonal coefficients are -Jn / sqrt(2n + 1)
+    const double j[5]{0.0, 0.0, 1.08262668E-03, -2.5323E-06, -1.6204E-06};
+    std::vector<double> c(Index(5, 0)), s(Index(5, 0));
+    c[0] = 1.0;
+    for (int n = 2; n <= 4; ++n)
+    {
+        c[Index(n, 0)] = -j[n] / std::sqrt(2.0 * n + 1.0);
+    }
+    GeopotentialModel model(MU, RADIUS, 4, 4, c, s);
+    const double pole[3]{0.0, 0.0, 1.0};
+    IO::Astrodynamics::Propagators::ZonalHarmonicsGravity zonal(MU, RADIUS, j[2], j[3], j[4], pole);
+
+    for (const auto &position: POSITIONS)
+    {
+        const double r = std::sqrt(position[0] * position[0] + position[1] * position[1] + position[2] * position[2]);
+        const double state[6]{position[0], position[1], position[2], 0.0, 0.0, 0.0};
+        double expected[3]{};
+        zonal.AddAcceleration(0.0, state, expected);
+        double acceleration[3];
+        model.GetAcceleration(position.data(), acceleration);
+        for (int i = 0; i < 3; ++i)
+        {
+            ASSERT_NEAR(expected[i] - MU * position[i] / (r * r * r), acceleration[i], 1E-12);
+        }
+    }
+}
+
+TEST(GeopotentialModel, TesseralAndSectoralTerms)
+{
+    //Tesseral only then sectoral only fields, central term kept
+    for (bool sectoral: {false, true})
+    {
+        const int degree = 8;
+        std::vector<double> c(Index(degree + 1, 0)), s(Index(degree + 1, 0));
+        c[0] = 1.0;
+        for (int n = 2; n <= degree; ++n)
+        {
+            for (int m = 1; m <= n; ++m)
+            {
+                if ((m == n) == sectoral)
+                {
+                    c[Index(n, m)] = std::sin(1.3 * n + 0.7 * m) * 1E-04 / (n * n);
+                    s[Index(n, m)] = std::cos(0.9 * n - 1.1 * m) * 1E-04 / (n * n);
+                }
+            }
+        }
+        GeopotentialModel model(MU, RADIUS, degree, degree, c, s);
+
+        for (const auto &position: POSITIONS)
+        {
+            const double r = std::sqrt(position[0] * position[0] + position[1] * position[1] + position[2] * position[2]);
+            ASSERT_NEAR(ReferencePotential(model, c, s, position.data()), model.GetPotential(position.data()), 1E-12 * MU / r);
+
+            double acceleration[3];
+            model.GetAcceleration(position.data(), acceleration);
+            for (int i = 0; i < 3; ++i)
+            {
+                const double delta = 1.0;
+                auto plus = position, minus = position;
+                plus[i] += delta;
+                minus[i] -= delta;
+                const double gradient = (ReferencePotential(model, c, s, plus.data()) - ReferencePotential(model, c, s, minus.data())) / (2.0 * delta);
+                ASSERT_NEAR(gradient, acceleration[i], 1E-07);
+            }
+        }
+    }
+}
+
+TEST(GeopotentialModel, AccelerationIsPotentialGradient)
+{
+    auto model = Field(12, 12);
+    for (const auto &position: POSITIONS)
+    {
+        double acceleration[3];
+        model.GetAcceleration(position.data(), acceleration);
+        for (int i = 0; i < 3; ++i)
+        {
+            const double delta = 1.0;
+            auto plus = position, minus = position;
+            plus[i] += delta;
+            minus[i] -= delta;
+            const double expected = (model.GetPotential(plus.data()) - model.GetPotential(minus.data())) / (2.0 * delta);
+            ASSERT_NEAR(expected, acceleration[i], 1E-07);
+        }
+    }
+}
+
+TEST(GeopotentialModel, GradientIsAccelerationJacobian)
+{
+    auto model = Field(12, 12);
+    for (const auto &position: POSITIONS)
+    {
+        double acceleration[3], gradient[9];
+        model.GetAcceleration(position.data(), acceleration, gradient);
+        for (int j = 0; j < 3; ++j)
+        {
+            const double delta = 10.0;
+            auto plus = position, minus = position;
+            plus[j] += delta;
+            minus[j] -= delta;
+            double accelerationPlus[3], accelerationMinus[3];
+            model.GetAcceleration(plus.data(), accelerationPlus);
+            model.GetAcceleration(minus.data(), accelerationMinus);
+            for (int i = 0; i < 3; ++i)
+            {
+                const double expected = (accelerationPlus[i] - accelerationMinus[i]) / (2.0 * delta);
+                ASSERT_NEAR(expected, gradient[3 * i + j], 1E-11 + 1E-06 * std::abs(expected));
+            }
+        }
+        ASSERT_DOUBLE_EQ(gradient[1], gradient[3]);
+        ASSERT_DOUBLE_EQ(gradient[2], gradient[6]);
+        ASSERT_DOUBLE_EQ(gradient[5], gradient[7]);
+        //Laplace equation outside the body
+        ASSERT_NEAR(0.0, gradient[0] + gradient[4] + gradient[8], 1E-15);
+    }
+}
+
+TEST(GeopotentialModel, HighDegreeStability)
+{
+    auto model = Field(180, 180);
+    const double position[3]{100000.0, 200000.0, 6500000.0};
+    double acceleration[3], gradient[9];
+    model.GetAcceleration(position, acceleration, gradient);
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(std::isfinite(acceleration[i]));
+    }
+    const double norm = std::sqrt(acceleration[0] * acceleration[0] + acceleration[1] * acceleration[1] + acceleration[2] * acceleration[2]);
+    ASSERT_NEAR(MU / (6503845.0 * 6503845.0), norm, 0.05);
+}
+
+TEST(GeopotentialModel, Truncation)
+{
+    auto full = Field(12, 12);
+    auto truncated = Field(12, 4);
+    auto low = Field(4, 4);
+    const double *position = POSITIONS[2].data();
+    double a[3], b[3], c[3];
+    full.GetAcceleration(position, a);
+    truncated.GetAcceleration(position, b);
+    low.GetAcceleration(position, c);
+    ASSERT_NE(a[0], b[0]);
+    ASSERT_NE(b[0], c[0]);
+    ASSERT_EQ(4, truncated.GetMaxOrder());
+}
+
+TEST(GeopotentialModel, BatchEvaluation)
+{
+    auto model = Field(20, 20);
+    std::vector<double> positions;
+    for (int i = 0; i < 500; ++i)
+    {
+        const double angle = 0.01 * i;
+        positions.insert(positions.end(), {7000000.0 * std::cos(angle), 7000000.0 * std::sin(angle) * 0.6, 7000000.0 * std::sin(angle) * 0.8});
+    }
+    std::vector<double> accelerations(positions.size()), gradients(3 * positions.size());
+    model.GetAccelerations(500, positions.data(), accelerations.data(), gradients.data(), 4);
+    for (std::size_t i = 0; i < 500; ++i)
+    {
+        double acceleration[3], gradient[9];
+        model.GetAcceleration(positions.data() + 3 * i, acceleration, gradient);
+        for (int j = 0; j < 3; ++j)
+        {
+            ASSERT_DOUBLE_EQ(acceleration[j], accelerations[3 * i + j]);
+        }
+        for (int j = 0; j < 9; ++j)
+        {
+            ASSERT_DOUBLE_EQ(gradient[j], gradients[9 * i + j]);
+        }
+    }
+
+    positions[4] = std::nan("");
+    ASSERT_THROW(model.GetAccelerations(500, positions.data(), accelerations.data()), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
+
+TEST(GeopotentialModel, ReadEGM)
+{
+    std::istringstream stream(EGM);
+    auto model = GeopotentialModel::ReadEGM(stream, 10, 10, MU, RADIUS);
+    ASSERT_EQ(3, model.GetMaxDegree());
+    ASSERT_EQ(3, model.GetMaxOrder());
+    ASSERT_DOUBLE_EQ(1.0, model.GetC(0, 0));
+    ASSERT_DOUBLE_EQ(-0.484165143790815E-03, model.GetC(2, 0));
+    ASSERT_DOUBLE_EQ(-0.140027370385934E-05, model.GetS(2, 2));
+    ASSERT_DOUBLE_EQ(0.248200415856872E-06, model.GetS(3, 1));
+    ASSERT_DOUBLE_EQ(0.0, model.GetC(3, 3));
+
+    std::istringstream truncatedStream(EGM);
+    auto truncated = GeopotentialModel::ReadEGM(truncatedStream, 2, 1, MU, RADIUS);
+    ASSERT_EQ(2, truncated.GetMaxDegree());
+    ASSERT_EQ(1, truncated.GetMaxOrder());
+    ASSERT_DOUBLE_EQ(0.0, truncated.GetC(2, 2));
+    ASSERT_THROW((void) truncated.GetC(3, 0), IO::Astrodynamics::Exception::InvalidArgumentException);
+
+    std::istringstream invalid("    2    0   -0.484165143790815D-03\n");
+    ASSERT_THROW(GeopotentialModel::ReadEGM(invalid, 10, 10, MU, RADIUS), IO::Astrodynamics::Exception::SDKException);
+}
+
+TEST(GeopotentialModel, ReadICGEM)
+{
+    std::istringstream stream("product_type            gravity_field\n"
+                              "modelname               test\n"
+                              "earth_gravity_constant  0.3986004415E+15\n"
+                              "radius                  0.63781363E+07\n"
+                              "max_degree              3\n"
+                              "errors                  formal\n"
+                              "norm                    fully_normalized\n"
+                              "\n"
+                              "key    L    M         C                  S                sigma C         sigma S\n"
+                              "end_of_head ==================================================================\n"
+                              "gfc    0    0  1.000000000000E+00  0.000000000000E+00  0.0000E+00  0.0000E+00\n"
+                              "gfc    2    0 -4.841651437908E-04  0.000000000000E+00  7.4812E-12  0.0000E+00\n"
+                              "gfct   2    2  2.439383573283E-06 -1.400273703859E-06  7.2302E-12  7.4258E-12 20050101.0000\n"
+                              "trnd   2    2  1.0E-11  1.0E-11  0.0E+00  0.0E+00\n"
+                              "gfc    3    1  2.030462010479E-06  2.482004158569E-07  5.7266E-12  5.9767E-12\n");
+    auto model = GeopotentialModel::ReadICGEM(stream, 10, 10);
+    ASSERT_DOUBLE_EQ(MU, model.GetMu());
+    ASSERT_DOUBLE_EQ(RADIUS, model.GetRadius());
+    ASSERT_EQ(3, model.GetMaxDegree());
+    ASSERT_DOUBLE_EQ(-4.841651437908E-04, model.GetC(2, 0));
+    ASSERT_DOUBLE_EQ(2.439383573283E-06, model.GetC(2, 2));
+    ASSERT_DOUBLE_EQ(2.482004158569E-07, model.GetS(3, 1));
+
+    //Unnormalized C20 is -J2
+    std::istringstream unnormalized("earth_gravity_constant 3.986004415E+14\nradius 6378136.3\nnorm unnormalized\nend_of_head\n"
+                                    "gfc 2 0 -1.0826266835531513E-03 0.0\ngfc 2 2 1.5745360427672858E-06 -9.0387280685270530E-07\n");
+    auto converted = GeopotentialModel::ReadICGEM(unnormalized, 2, 2);
+    ASSERT_NEAR(-1.0826266835531513E-03 / std::sqrt(5.0), converted.GetC(2, 0), 1E-15);
+    ASSERT_NEAR(1.5745360427672858E-06 * std::sqrt(24.0 / 10.0), converted.GetC(2, 2), 1E-15);
+
+    std::istringstream missingHeader("gfc 2 0 -4.841651437908E-04 0.0\n");
+    ASSERT_THROW(GeopotentialModel::ReadICGEM(missingHeader, 10, 10), IO::Astrodynamics::Exception::SDKException);
+}
+
+TEST(GeopotentialModel, InvalidArguments)
+{
+    ASSERT_THROW(GeopotentialModel(0.0, RADIUS, 0, 0, {1.0}, {0.0}), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(GeopotentialModel(MU, RADIUS, 2, 3, std::vector<double>(6), std::vector<double>(6)), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(GeopotentialModel(MU, RADIUS, 2, 2, std::vector<double>(5), std::vector<double>(6)), IO::Astrodynamics::Exception::InvalidArgumentException);
+    std::istringstream stream(EGM);
+    ASSERT_THROW(GeopotentialModel::ReadEGM(stream, 2, 3, MU, RADIUS), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(GeopotentialModel::ReadFile("not_existing_file", 2, 2, MU, RADIUS), IO::Astrodynamics::Exception::SDKException);
+
+    auto model = Field(4, 4);
+    const double origin[3]{0.0, 0.0, 0.0};
+    double acceleration[3];
+    ASSERT_THROW(model.GetAcceleration(origin, acceleration), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
+
+TEST(GeopotentialGravity, RotatingBody)
+{
+    //Body rotating around z, rotation from inertial to body fixed frame is Rz(w t)
+    auto model = std::make_shared<GeopotentialModel>(Field(8, 8));
+    const double rate = 7.292115E-05;
+    std::vector<double> rotations;
+    for (int i = 0; i < 100; ++i)
+    {
+        const double angle = rate * 60.0 * i;
+        const double c = std::cos(angle), s = std::sin(angle);
+        rotations.insert(rotations.end(), {c, s, 0.0, -s, c, 0.0, 0.0, 0.0, 1.0,
+                                           -s * rate, c * rate, 0.0, -c * rate, -s * rate, 0.0, 0.0, 0.0, 0.0});
+    }
+    GeopotentialGravity gravity(model, 0.0, 60.0, rotations);
+    gravity.Prepare(0.0, 5000.0);
+
+    const double state[6]{-3000000.0, 4000000.0, -5000000.0, 0.0, 0.0, 0.0};
+    for (double epoch: {0.0, 1234.5, 4321.0})
+    {
+        const double angle = rate * epoch;
+        const double c = std::cos(angle), s = std::sin(angle);
+        const double bodyFixed[3]{c * state[0] + s * state[1], -s * state[0] + c * state[1], state[2]};
+        double expectedBodyFixed[3];
+        model->GetAcceleration(bodyFixed, expectedBodyFixed);
+        const double expected[3]{c * expectedBodyFixed[0] - s * expectedBodyFixed[1], s * expectedBodyFixed[0] + c * expectedBodyFixed[1], expectedBodyFixed[2]};
+
+        double acceleration[3]{};
+        gravity.AddAcceleration(epoch, state, acceleration);
+        for (int i = 0; i < 3; ++i)
+        {
+            ASSERT_NEAR(expected[i], acceleration[i], 1E-09);
+        }
+    }
+
+    ASSERT_THROW(GeopotentialGravity(model, 0.0, 60.0, std::vector<double>(18)), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(GeopotentialGravity(nullptr, 0.0, 60.0, rotations), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
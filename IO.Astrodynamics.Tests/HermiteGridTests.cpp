@@ -0,0 +1,72 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <HermiteGrid.h>
+#include <InvalidArgumentException.h>
+
+using IO::Astrodynamics::Math::HermiteGrid;
+
+namespace
+{
+    //Cubic values, interpolated exactly
+    void Cubic(double t, double *node)
+    {
+        node[0] = 2.0 + 0.5 * t - 0.01 * t * t + 1E-04 * t * t * t;
+        node[1] = -t;
+        node[2] = 0.5 - 0.02 * t + 3E-04 * t * t;
+        node[3] = -1.0;
+    }
+}
+
+TEST(HermiteGrid, Sample)
+{
+    HermiteGrid grid(2, 10.0);
+    ASSERT_EQ(0, grid.GetNodeCount());
+    grid.Sample(0.0, 95.0, Cubic);
+    //One more node on each side of the window
+    ASSERT_EQ(13, grid.GetNodeCount());
+
+    for (double t = -10.0; t <= 110.0; t += 3.7)
+    {
+        double expected[4], values[2];
+        Cubic(t, expected);
+        grid.Interpolate(t, values);
+        ASSERT_NEAR(expected[0], values[0], 1E-12);
+        ASSERT_NEAR(expected[1], values[1], 1E-12);
+    }
+}
+
+TEST(HermiteGrid, Nodes)
+{
+    std::vector<double> nodes;
+    for (int i = 0; i < 3; ++i)
+    {
+        double node[4];
+        Cubic(-5.0 + 20.0 * i, node);
+        nodes.insert(nodes.end(), node, node + 4);
+    }
+    const HermiteGrid grid(2, -5.0, 20.0, nodes);
+    ASSERT_EQ(3, grid.GetNodeCount());
+
+    //Nodes are returned unchanged
+    double values[2];
+    grid.Interpolate(15.0, values);
+    ASSERT_DOUBLE_EQ(nodes[4], values[0]);
+    ASSERT_DOUBLE_EQ(nodes[5], values[1]);
+}
+
+TEST(HermiteGrid, InvalidArguments)
+{
+    ASSERT_THROW(HermiteGrid(0, 10.0), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(HermiteGrid(2, 0.0), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(HermiteGrid(2, 0.0, 10.0, std::vector<double>(4)), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(HermiteGrid(2, 0.0, 10.0, std::vector<double>(10)), IO::Astrodynamics::Exception::InvalidArgumentException);
+
+    const HermiteGrid grid(1, 10.0);
+    double value;
+    ASSERT_THROW(grid.Interpolate(0.0, &value), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
@@ -0,0 +1,180 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <KeplerSolver.h>
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+
+using IO::Astrodynamics::Math::KeplerSolver;
+
+namespace
+{
+    constexpr double MU = 3.986004418E+14;
+}
+
+TEST(KeplerSolver, EllipticGrid)
+{
+    //Full (M, e) grid, including eccentricities close to 1 and several revolutions
+    std::vector<double> meanAnomalies, eccentricities;
+    for (int i = 0; i <= 400; ++i)
+    {
+        for (int j = 0; j <= 200; ++j)
+        {
+            meanAnomalies.push_back(-3.0 * IO::Astrodynamics::Constants::_2PI + 6.0 * IO::Astrodynamics::Constants::_2PI * i / 400.0);
+            eccentricities.push_back(j < 200 ? j / 200.0 : 1.0 - 1E-09);
+        }
+    }
+    std::vector<double> eccentricAnomalies(meanAnomalies.size());
+    KeplerSolver::SolveElliptic(meanAnomalies.size(), meanAnomalies.data(), eccentricities.data(), eccentricAnomalies.data());
+
+    for (std::size_t i = 0; i < meanAnomalies.size(); ++i)
+    {
+        const double e = eccentricities[i];
+        const double E = eccentricAnomalies[i];
+        //Anomaly error estimated from the residual
+        const double residual = E - e * std::sin(E) - meanAnomalies[i];
+        ASSERT_LE(std::abs(residual), 1E-14 * std::max(1.0, std::abs(meanAnomalies[i])));
+        ASSERT_LT(std::abs(E - meanAnomalies[i]), IO::Astrodynamics::Constants::PI);
+        ASSERT_DOUBLE_EQ(E, KeplerSolver::SolveElliptic(meanAnomalies[i], e));
+    }
+
+    ASSERT_DOUBLE_EQ(1.0, KeplerSolver::SolveElliptic(1.0, 0.0));
+    ASSERT_DOUBLE_EQ(IO::Astrodynamics::Constants::PI, KeplerSolver::SolveElliptic(IO::Astrodynamics::Constants::PI, 0.9));
+}
+
+TEST(KeplerSolver, HyperbolicGrid)
+{
+    std::vector<double> meanAnomalies, eccentricities;
+    for (int i = -200; i <= 200; ++i)
+    {
+        for (double e: {1.0 + 1E-09, 1.0 + 1E-06, 1.001, 1.01, 1.1, 1.5, 2.0, 5.0, 20.0, 100.0})
+        {
+            meanAnomalies.push_back(std::copysign(std::pow(10.0, std::abs(i) / 40.0 - 2.0), i));
+            eccentricities.push_back(e);
+        }
+    }
+    std::vector<double> hyperbolicAnomalies(meanAnomalies.size());
+    KeplerSolver::SolveHyperbolic(meanAnomalies.size(), meanAnomalies.data(), eccentricities.data(), hyperbolicAnomalies.data());
+
+    for (std::size_t i = 0; i < meanAnomalies.size(); ++i)
+    {
+        const double e = eccentricities[i];
+        const double H = hyperbolicAnomalies[i];
+        const double residual = e * std::sinh(H) - H - meanAnomalies[i];
+        ASSERT_LE(std::abs(residual / (e * std::cosh(H) - 1.0)), 1E-14 * std::max(1.0, std::abs(H)));
+        ASSERT_DOUBLE_EQ(H, KeplerSolver::SolveHyperbolic(meanAnomalies[i], e));
+    }
+    ASSERT_DOUBLE_EQ(0.0, KeplerSolver::SolveHyperbolic(0.0, 1.5));
+}
+
+TEST(KeplerSolver, Parabolic)
+{
+    for (double M: {-1000.0, -3.0, -1E-08, 0.0, 1E-08, 0.5, 1.0, 10.0, 1E+06})
+    {
+        const double D = KeplerSolver::SolveParabolic(M);
+        ASSERT_NEAR(M, D + D * D * D / 3.0, 1E-14 * std::max(1.0, std::abs(M)));
+    }
+}
+
+TEST(KeplerSolver, StumpffFunctions)
+{
+    ASSERT_DOUBLE_EQ(0.5, KeplerSolver::GetStumpffC(0.0));
+    ASSERT_DOUBLE_EQ(1.0 / 6.0, KeplerSolver::GetStumpffS(0.0));
+    ASSERT_NEAR((1.0 - std::cos(2.0)) / 4.0, KeplerSolver::GetStumpffC(4.0), 1E-15);
+    ASSERT_NEAR((2.0 - std::sin(2.0)) / 8.0, KeplerSolver::GetStumpffS(4.0), 1E-15);
+    ASSERT_NEAR((std::cosh(2.0) - 1.0) / 4.0, KeplerSolver::GetStumpffC(-4.0), 1E-15);
+    ASSERT_NEAR((std::sinh(2.0) - 2.0) / 8.0, KeplerSolver::GetStumpffS(-4.0), 1E-15);
+
+    //Continuity between series and closed forms
+    for (double z: {-0.1, 0.1})
+    {
+        ASSERT_NEAR(KeplerSolver::GetStumpffC(z * (1.0 - 1E-12)), KeplerSolver::GetStumpffC(z * (1.0 + 1E-12)), 1E-13);
+        ASSERT_NEAR(KeplerSolver::GetStumpffS(z * (1.0 - 1E-12)), KeplerSolver::GetStumpffS(z * (1.0 + 1E-12)), 1E-13);
+    }
+}
+
+TEST(KeplerSolver, TrueAnomaly)
+{
+    const double q = 7000000.0;
+
+    //Elliptic and hyperbolic orbits compared with conic solvers
+    for (double e: {0.0, 0.3, 0.9, 0.999, 1.001, 1.5, 3.0})
+    {
+        const double a = q / (1.0 - e);
+        const double n = std::sqrt(MU / std::abs(a * a * a));
+        for (double t: {-20000.0, -3000.0, -1.0, 0.0, 0.5, 700.0, 5000.0, 50000.0})
+        {
+            double expected;
+            if (e < 1.0)
+            {
+                const double E = KeplerSolver::SolveElliptic(n * t, e);
+                expected = 2.0 * std::atan2(std::sqrt(1.0 + e) * std::sin(0.5 * E), std::sqrt(1.0 - e) * std::cos(0.5 * E));
+            }
+            else
+            {
+                const double H = KeplerSolver::SolveHyperbolic(n * t, e);
+                expected = 2.0 * std::atan(std::sqrt((e + 1.0) / (e - 1.0)) * std::tanh(0.5 * H));
+            }
+            const double v = KeplerSolver::GetTrueAnomaly(t, MU, q, e);
+            ASSERT_NEAR(0.0, std::remainder(expected - v, IO::Astrodynamics::Constants::_2PI), 1E-10);
+        }
+    }
+
+    //Parabolic orbit compared with Barker's equation and near parabolic orbits continuity
+    for (double t: {-100000.0, -10.0, 100.0, 3000.0, 200000.0})
+    {
+        const double v = KeplerSolver::GetTrueAnomaly(t, MU, q, 1.0);
+        ASSERT_NEAR(2.0 * std::atan(KeplerSolver::SolveParabolic(std::sqrt(MU / (2.0 * q * q * q)) * t)), v, 1E-13);
+        ASSERT_NEAR(v, KeplerSolver::GetTrueAnomaly(t, MU, q, 1.0 - 1E-10), 1E-08);
+        ASSERT_NEAR(v, KeplerSolver::GetTrueAnomaly(t, MU, q, 1.0 + 1E-10), 1E-08);
+    }
+
+    //Batch
+    const std::vector<double> times{100.0, 1000.0, 10000.0};
+    const std::vector<double> radii{q, 2.0 * q, 3.0 * q};
+    const std::vector<double> eccentricities{0.1, 1.0, 2.0};
+    std::vector<double> trueAnomalies(3);
+    KeplerSolver::GetTrueAnomaly(3, times.data(), MU, radii.data(), eccentricities.data(), trueAnomalies.data());
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        ASSERT_DOUBLE_EQ(KeplerSolver::GetTrueAnomaly(times[i], MU, radii[i], eccentricities[i]), trueAnomalies[i]);
+    }
+}
+
+TEST(KeplerSolver, UniversalFromState)
+{
+    //States away from periapsis, elliptic, near parabolic and hyperbolic
+    const double r = 8000000.0;
+    for (double alpha: {1.0 / 9000000.0, 1E-14, -1.0 / 20000000.0})
+    {
+        for (double sigma: {-500.0, 0.0, 800.0})
+        {
+            for (double t: {-30000.0, -60.0, 1E-03, 900.0, 40000.0})
+            {
+                const double chi = KeplerSolver::SolveUniversal(t, MU, r, sigma, alpha, std::nan(""));
+                const double z = alpha * chi * chi;
+                const double f = sigma * chi * chi * KeplerSolver::GetStumpffC(z) + (1.0 - alpha * r) * chi * chi * chi * KeplerSolver::GetStumpffS(z) + r * chi;
+                ASSERT_NEAR(std::sqrt(MU) * t, f, 1E-13 * std::sqrt(MU) * std::abs(t));
+
+                //Same root from close, far or wrong guesses
+                ASSERT_NEAR(chi, KeplerSolver::SolveUniversal(t, MU, r, sigma, alpha, chi * 1.01), 1E-12 * std::abs(chi));
+                ASSERT_NEAR(chi, KeplerSolver::SolveUniversal(t, MU, r, sigma, alpha, chi * 1E-06), 1E-12 * std::abs(chi));
+                ASSERT_NEAR(chi, KeplerSolver::SolveUniversal(t, MU, r, sigma, alpha, -chi), 1E-12 * std::abs(chi));
+            }
+        }
+    }
+    ASSERT_DOUBLE_EQ(0.0, KeplerSolver::SolveUniversal(0.0, MU, r, 100.0, 1E-07, 1.0));
+}
+
+TEST(KeplerSolver, InvalidArguments)
+{
+    ASSERT_THROW(KeplerSolver::SolveElliptic(1.0, 1.0), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(KeplerSolver::SolveElliptic(1.0, -0.1), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(KeplerSolver::SolveHyperbolic(1.0, 1.0), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(KeplerSolver::SolveUniversal(1.0, MU, 0.0, 0.5), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(KeplerSolver::SolveUniversal(1.0, -MU, 7000000.0, 0.5), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
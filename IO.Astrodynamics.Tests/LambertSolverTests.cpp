@@ -0,0 +1,143 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <LambertSolver.h>
+#include <TwoBodyPropagator.h>
+#include "Orbits.h"
+#include <InvalidArgumentException.h>
+
+using IO::Astrodynamics::Maneuvers::LambertSolver;
+using IO::Astrodynamics::Tests::Norm;
+using IO::Astrodynamics::Tests::ToState;
+
+namespace
+{
+    constexpr double MU = 3.986004418E+14;
+
+    //Lambert solution must bring the departure position to the arrival position
+    void CheckTransfer(const double *r1, const double *r2, const IO::Astrodynamics::Maneuvers::LambertSolution &solution, double timeOfFlight)
+    {
+        const IO::Astrodynamics::Propagators::TwoBodyPropagator propagator(MU, r1, solution.DepartureVelocity);
+        double position[3], velocity[3];
+        propagator.Propagate(timeOfFlight, position, velocity);
+        for (int i = 0; i < 3; ++i)
+        {
+            ASSERT_NEAR(r2[i], position[i], Norm(r2) * 1E-09);
+            ASSERT_NEAR(solution.ArrivalVelocity[i], velocity[i], Norm(velocity) * 1E-09);
+        }
+    }
+}
+
+TEST(LambertSolver, DirectTransfers)
+{
+    //Elliptic, near parabolic and hyperbolic orbits with transfer angles lower and greater than PI
+    const std::vector<std::vector<double>> orbits{
+            {7000000.0,   0.0,   0.9, 1.2, 0.0, 0.3},
+            {26000000.0,  0.7,   1.1, 0.5, 2.5, 4.0},
+            {1.0E+09,     0.993, 0.3, 2.0, 1.0, -0.001},
+            {-20000000.0, 1.35,  0.4, 1.0, 2.0, -1.5}
+    };
+    for (const auto &orbit: orbits)
+    {
+        const auto initial = ToState(orbit, MU);
+        const IO::Astrodynamics::Propagators::TwoBodyPropagator propagator(MU, initial.data(), initial.data() + 3);
+        const double duration = propagator.GetPeriod() > 0.0 ? propagator.GetPeriod() : 86400.0;
+        for (double fraction: {0.01, 0.2, 0.45, 0.7, 0.95})
+        {
+            const double tof = fraction * duration;
+            double arrival[3], arrivalVelocity[3];
+            propagator.Propagate(tof, arrival, arrivalVelocity);
+
+            const auto solutions = LambertSolver::Solve(initial.data(), arrival, tof, MU);
+            ASSERT_EQ(1, solutions.size());
+            ASSERT_EQ(0, solutions[0].Revolutions);
+            ASSERT_LT(solutions[0].Iterations, LambertSolver::MAXIMUM_ITERATIONS);
+            for (int i = 0; i < 3; ++i)
+            {
+                ASSERT_NEAR(initial[i + 3], solutions[0].DepartureVelocity[i], Norm(initial.data() + 3) * 1E-09);
+                ASSERT_NEAR(arrivalVelocity[i], solutions[0].ArrivalVelocity[i], Norm(arrivalVelocity) * 1E-09);
+            }
+
+            double v1[3], v2[3];
+            ASSERT_TRUE(LambertSolver::SolveDirect(initial.data(), arrival, tof, MU, false, v1, v2));
+            for (int i = 0; i < 3; ++i)
+            {
+                ASSERT_DOUBLE_EQ(solutions[0].DepartureVelocity[i], v1[i]);
+                ASSERT_DOUBLE_EQ(solutions[0].ArrivalVelocity[i], v2[i]);
+            }
+        }
+    }
+}
+
+TEST(LambertSolver, Retrograde)
+{
+    const auto initial = ToState({9000000.0, 0.2, 2.6, 1.0, 0.5, 0.2}, MU);
+    const IO::Astrodynamics::Propagators::TwoBodyPropagator propagator(MU, initial.data(), initial.data() + 3);
+    double arrival[3], arrivalVelocity[3];
+    propagator.Propagate(3000.0, arrival, arrivalVelocity);
+
+    double v1[3], v2[3];
+    ASSERT_TRUE(LambertSolver::SolveDirect(initial.data(), arrival, 3000.0, MU, true, v1, v2));
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_NEAR(initial[i + 3], v1[i], 1E-05);
+        ASSERT_NEAR(arrivalVelocity[i], v2[i], 1E-05);
+    }
+}
+
+TEST(LambertSolver, MultiRevolutions)
+{
+    const auto initial = ToState({12000000.0, 0.3, 0.5, 0.4, 1.0, 0.6}, MU);
+    const IO::Astrodynamics::Propagators::TwoBodyPropagator propagator(MU, initial.data(), initial.data() + 3);
+    const double tof = 2.3 * propagator.GetPeriod();
+    double arrival[3], arrivalVelocity[3];
+    propagator.Propagate(tof, arrival, arrivalVelocity);
+
+    const auto solutions = LambertSolver::Solve(initial.data(), arrival, tof, MU, false, 5);
+    ASSERT_GE(solutions.size(), 5);
+    ASSERT_EQ(1, solutions.size() % 2);
+
+    //Every solution is a valid transfer and the propagated orbit is one of them
+    bool found = false;
+    for (std::size_t i = 0; i < solutions.size(); ++i)
+    {
+        const auto &solution = solutions[i];
+        ASSERT_EQ((i + 1) / 2, solution.Revolutions);
+        ASSERT_LT(solution.Iterations, LambertSolver::MAXIMUM_ITERATIONS);
+        CheckTransfer(initial.data(), arrival, solution, tof);
+        const double error = std::hypot(solution.DepartureVelocity[0] - initial[3], solution.DepartureVelocity[1] - initial[4],
+                                        solution.DepartureVelocity[2] - initial[5]);
+        if (solution.Revolutions == 2 && error < 1E-06)
+        {
+            found = true;
+        }
+    }
+    ASSERT_TRUE(found);
+
+    //Revolutions are limited by the maximum
+    ASSERT_EQ(3, LambertSolver::Solve(initial.data(), arrival, tof, MU, false, 1).size());
+}
+
+TEST(LambertSolver, CollinearPositions)
+{
+    const double r1[3]{7000000.0, 0.0, 0.0};
+    const double r2[3]{14000000.0, 0.0, 0.0};
+    ASSERT_TRUE(LambertSolver::Solve(r1, r2, 3600.0, MU).empty());
+    double v1[3], v2[3];
+    ASSERT_FALSE(LambertSolver::SolveDirect(r1, r2, 3600.0, MU, false, v1, v2));
+}
+
+TEST(LambertSolver, InvalidArguments)
+{
+    const double r1[3]{7000000.0, 0.0, 0.0};
+    const double r2[3]{0.0, 7000000.0, 0.0};
+    const double origin[3]{0.0, 0.0, 0.0};
+    ASSERT_THROW(LambertSolver::Solve(r1, r2, 0.0, MU), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(LambertSolver::Solve(r1, r2, 3600.0, 0.0), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(LambertSolver::Solve(r1, origin, 3600.0, MU), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(LambertSolver::Solve(r1, r2, 3600.0, MU, false, -1), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
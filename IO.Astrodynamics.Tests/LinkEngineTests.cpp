@@ -0,0 +1,244 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <LinkEngine.h>
+#include <Constants.h>
+#include <GeometryFinder.h>
+#include <InertialFrames.h>
+#include <InvalidArgumentException.h>
+#include <OccultationType.h>
+#include <Spacecraft.h>
+#include "TestParameters.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    constexpr double EQUATORIAL_RADIUS = 6378137.0;
+    constexpr double POLAR_RADIUS = 6356752.314245;
+
+    //Walker delta constellation
+    std::vector<IO::Astrodynamics::Propagators::SGP4Elements> CreateConstellation(int planes, int satellitesPerPlane, double semiMajorAxis, double inclination)
+    {
+        std::vector<IO::Astrodynamics::Propagators::SGP4Elements> constellation;
+        for (int plane = 0; plane < planes; ++plane)
+        {
+            for (int satellite = 0; satellite < satellitesPerPlane; ++satellite)
+            {
+                IO::Astrodynamics::Propagators::SGP4Elements elements;
+                elements.SatelliteNumber = plane * satellitesPerPlane + satellite + 1;
+                elements.Epoch = IO::Astrodynamics::Time::UTC(700000000.0s);
+                elements.Inclination = inclination;
+                elements.RightAscendingNode = IO::Astrodynamics::Constants::_2PI * plane / planes;
+                elements.Eccentricity = 1E-04;
+                elements.MeanAnomaly = IO::Astrodynamics::Constants::_2PI * (satellite + 0.5 * plane / planes) / satellitesPerPlane;
+                elements.MeanMotion = std::sqrt(398600.8 / (semiMajorAxis * semiMajorAxis * semiMajorAxis)) * 60.0;
+                constellation.push_back(elements);
+            }
+        }
+        return constellation;
+    }
+
+    //Circular orbit with a two body ephemeris written over the whole window
+    std::unique_ptr<IO::Astrodynamics::Body::Spacecraft::Spacecraft> CreateSpacecraft(int id, double radius, double inclination, const IO::Astrodynamics::Time::TDB &epoch,
+                                                                                       double duration)
+    {
+        auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+        const double speed = std::sqrt(earth->GetMu() / radius);
+        auto orbit = std::make_unique<IO::Astrodynamics::OrbitalParameters::StateVector>(earth, IO::Astrodynamics::Math::Vector3D(radius, 0.0, 0.0),
+                                                                                          IO::Astrodynamics::Math::Vector3D(0.0, speed * std::cos(inclination),
+                                                                                                                            speed * std::sin(inclination)), epoch,
+                                                                                          IO::Astrodynamics::Frames::InertialFrames::ICRF());
+        std::vector<IO::Astrodynamics::OrbitalParameters::StateVector> states;
+        for (double t = 0.0; t <= duration; t += 30.0)
+        {
+            states.push_back(orbit->ToStateVector(epoch + IO::Astrodynamics::Time::TimeSpan(std::chrono::duration<double>(t))));
+        }
+        auto spacecraft = std::make_unique<IO::Astrodynamics::Body::Spacecraft::Spacecraft>(id, "LinkSpacecraft" + std::to_string(-id), 1000.0, 3000.0,
+                                                                                             std::string(SpacecraftPath), std::move(orbit));
+        spacecraft->WriteEphemeris(states);
+        return spacecraft;
+    }
+}
+
+TEST(LinkEngine, LineOfSight)
+{
+    const double first[3]{7000000.0, 0.0, 0.0};
+    const double opposite[3]{-7000000.0, 0.0, 0.0};
+    const double near[3]{6000000.0, 3000000.0, 0.0};
+    ASSERT_FALSE(IO::Astrodynamics::Links::LinkEngine::HasLineOfSight(first, opposite, EQUATORIAL_RADIUS, POLAR_RADIUS));
+    ASSERT_TRUE(IO::Astrodynamics::Links::LinkEngine::HasLineOfSight(first, near, EQUATORIAL_RADIUS, POLAR_RADIUS));
+
+    //Line of sight grazing the pole at 6370 km, above the polar radius but below the equatorial radius
+    const double a[3]{7000000.0, 0.0, 6370000.0};
+    const double b[3]{-7000000.0, 0.0, 6370000.0};
+    ASSERT_TRUE(IO::Astrodynamics::Links::LinkEngine::HasLineOfSight(a, b, EQUATORIAL_RADIUS, POLAR_RADIUS));
+    ASSERT_FALSE(IO::Astrodynamics::Links::LinkEngine::HasLineOfSight(a, b, EQUATORIAL_RADIUS, EQUATORIAL_RADIUS));
+
+    //Atmosphere margin
+    IO::Astrodynamics::Links::LinkConstraints constraints;
+    ASSERT_TRUE(IO::Astrodynamics::Links::LinkEngine::IsAvailable(a, b, constraints, EQUATORIAL_RADIUS, POLAR_RADIUS));
+    constraints.GrazingHeight = 50000.0;
+    ASSERT_FALSE(IO::Astrodynamics::Links::LinkEngine::IsAvailable(a, b, constraints, EQUATORIAL_RADIUS, POLAR_RADIUS));
+
+    //Range and nadir angle limits
+    constraints = IO::Astrodynamics::Links::LinkConstraints{};
+    constraints.MaximumRange = 3000000.0;
+    ASSERT_FALSE(IO::Astrodynamics::Links::LinkEngine::IsAvailable(first, near, constraints, EQUATORIAL_RADIUS, POLAR_RADIUS));
+    constraints.MaximumRange = 4000000.0;
+    ASSERT_TRUE(IO::Astrodynamics::Links::LinkEngine::IsAvailable(first, near, constraints, EQUATORIAL_RADIUS, POLAR_RADIUS));
+    constraints.MinimumNadirAngle = 75.0 * IO::Astrodynamics::Constants::DEG_RAD;
+    ASSERT_FALSE(IO::Astrodynamics::Links::LinkEngine::IsAvailable(first, near, constraints, EQUATORIAL_RADIUS, POLAR_RADIUS));
+    constraints.MinimumNadirAngle = 70.0 * IO::Astrodynamics::Constants::DEG_RAD;
+    ASSERT_TRUE(IO::Astrodynamics::Links::LinkEngine::IsAvailable(first, near, constraints, EQUATORIAL_RADIUS, POLAR_RADIUS));
+}
+
+TEST(LinkEngine, FindLinkWindows)
+{
+    auto constellation = CreateConstellation(4, 6, 7578.0, 53.0 * IO::Astrodynamics::Constants::DEG_RAD);
+    IO::Astrodynamics::Links::LinkEngine engine(constellation);
+    ASSERT_EQ(24, engine.GetSatelliteCount());
+
+    IO::Astrodynamics::Links::LinkConstraints constraints;
+    constraints.GrazingHeight = 100000.0;
+    constraints.MaximumRange = 5000000.0;
+
+    const double start = IO::Astrodynamics::Time::UTC(700000000.0s).ToTDB().GetSecondsFromJ2000().count();
+    const double end = start + 10800.0;
+    IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> window{IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(start)),
+                                                                         IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(end))};
+    IO::Astrodynamics::Links::LinkStatistics statistics;
+    auto links = engine.FindLinkWindows(window, IO::Astrodynamics::Time::TimeSpan(60.0s), IO::Astrodynamics::Time::TimeSpan(0.001s), constraints, {}, &statistics);
+    ASSERT_FALSE(links.empty());
+    ASSERT_GT(statistics.Skipped, statistics.Evaluations / 2);
+    ASSERT_GT(statistics.Transitions, 0);
+
+    //Brute force sampling of every pair
+    std::vector<IO::Astrodynamics::Propagators::SGP4> propagators;
+    for (const auto &elements: constellation)
+    {
+        propagators.emplace_back(elements);
+    }
+    const std::size_t count = constellation.size();
+    std::vector<double> expected(count * count);
+    std::vector<double> states(count * 6);
+    const double step = 2.0;
+    for (double epoch = start + 0.5 * step; epoch < end; epoch += step)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            propagators[i].Propagate(IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(epoch)), states.data() + i * 6, states.data() + i * 6 + 3);
+        }
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (std::size_t j = i + 1; j < count; ++j)
+            {
+                if (IO::Astrodynamics::Links::LinkEngine::IsAvailable(states.data() + i * 6, states.data() + j * 6, constraints, EQUATORIAL_RADIUS, POLAR_RADIUS))
+                {
+                    expected[i * count + j] += step;
+                }
+            }
+        }
+    }
+
+    std::vector<double> durations(count * count);
+    std::vector<std::size_t> windowCounts(count * count);
+    for (const auto &link: links)
+    {
+        ASSERT_LT(link.FirstIndex, link.SecondIndex);
+        windowCounts[link.FirstIndex * count + link.SecondIndex] = link.Windows.size();
+        for (const auto &linkWindow: link.Windows)
+        {
+            durations[link.FirstIndex * count + link.SecondIndex] += linkWindow.GetLength().GetSeconds().count();
+        }
+    }
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        for (std::size_t j = i + 1; j < count; ++j)
+        {
+            //Each sampled window boundary is known within half a step
+            ASSERT_NEAR(expected[i * count + j], durations[i * count + j], step * static_cast<double>(windowCounts[i * count + j] + 1));
+        }
+    }
+
+    //Subset of pairs
+    auto subset = engine.FindLinkWindows(window, IO::Astrodynamics::Time::TimeSpan(60.0s), IO::Astrodynamics::Time::TimeSpan(0.001s), constraints,
+                                         {{links.front().FirstIndex, links.front().SecondIndex}});
+    ASSERT_EQ(1, subset.size());
+    ASSERT_EQ(links.front().FirstIndex, subset.front().FirstIndex);
+    ASSERT_EQ(links.front().SecondIndex, subset.front().SecondIndex);
+    ASSERT_EQ(links.front().Windows.size(), subset.front().Windows.size());
+    for (std::size_t i = 0; i < subset.front().Windows.size(); ++i)
+    {
+        ASSERT_NEAR(links.front().Windows[i].GetStartDate().GetSecondsFromJ2000().count(), subset.front().Windows[i].GetStartDate().GetSecondsFromJ2000().count(), 1E-02);
+        ASSERT_NEAR(links.front().Windows[i].GetEndDate().GetSecondsFromJ2000().count(), subset.front().Windows[i].GetEndDate().GetSecondsFromJ2000().count(), 1E-02);
+    }
+}
+
+TEST(LinkEngine, FindLinkWindowsFromKernels)
+{
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    IO::Astrodynamics::Time::TDB epoch("2021-01-01 00:00:00.0000 TDB");
+    auto equatorial = CreateSpacecraft(-281, 6800000.0, 0.0, epoch, 6.0 * 3600.0);
+    auto polar = CreateSpacecraft(-282, 8000000.0, 90.0 * IO::Astrodynamics::Constants::DEG_RAD, epoch, 6.0 * 3600.0);
+
+    IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> searchWindow(epoch + IO::Astrodynamics::Time::TimeSpan(60s),
+                                                                               epoch + IO::Astrodynamics::Time::TimeSpan(21540s));
+    IO::Astrodynamics::Links::LinkEngine engine(earth, {equatorial->GetId(), polar->GetId()});
+    ASSERT_EQ(2, engine.GetSatelliteCount());
+    auto links = engine.FindLinkWindows(searchWindow, IO::Astrodynamics::Time::TimeSpan(60s), IO::Astrodynamics::Time::TimeSpan(0.01s),
+                                        IO::Astrodynamics::Links::LinkConstraints{});
+    ASSERT_EQ(1, links.size());
+    ASSERT_EQ(0, links[0].FirstIndex);
+    ASSERT_EQ(1, links[0].SecondIndex);
+
+    //Link is available out of the occultation windows solved by spice
+    auto occultations = IO::Astrodynamics::Constraints::GeometryFinder::FindWindowsOnOccultationConstraint(searchWindow, equatorial->GetId(), polar->GetId(), "", "POINT",
+                                                                                                          earth->GetId(), earth->GetBodyFixedFrame().GetName(), "ELLIPSOID",
+                                                                                                          IO::Astrodynamics::OccultationType::Any(),
+                                                                                                          IO::Astrodynamics::AberrationsEnum::None,
+                                                                                                          IO::Astrodynamics::Time::TimeSpan(60s));
+    ASSERT_FALSE(occultations.empty());
+    std::vector<std::pair<double, double>> expected;
+    double begin = searchWindow.GetStartDate().GetSecondsFromJ2000().count();
+    for (const auto &occultation: occultations)
+    {
+        if (occultation.GetStartDate().GetSecondsFromJ2000().count() > begin)
+        {
+            expected.emplace_back(begin, occultation.GetStartDate().GetSecondsFromJ2000().count());
+        }
+        begin = occultation.GetEndDate().GetSecondsFromJ2000().count();
+    }
+    if (begin < searchWindow.GetEndDate().GetSecondsFromJ2000().count())
+    {
+        expected.emplace_back(begin, searchWindow.GetEndDate().GetSecondsFromJ2000().count());
+    }
+
+    ASSERT_EQ(expected.size(), links[0].Windows.size());
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        ASSERT_NEAR(expected[i].first, links[0].Windows[i].GetStartDate().GetSecondsFromJ2000().count(), 0.1);
+        ASSERT_NEAR(expected[i].second, links[0].Windows[i].GetEndDate().GetSecondsFromJ2000().count(), 0.1);
+    }
+}
+
+TEST(LinkEngine, InvalidArguments)
+{
+    IO::Astrodynamics::Links::LinkEngine engine(CreateConstellation(1, 3, 7000.0, 1.0));
+    IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> window(IO::Astrodynamics::Time::TDB(700000000.0s), IO::Astrodynamics::Time::TDB(700003600.0s));
+    IO::Astrodynamics::Links::LinkConstraints constraints;
+
+    ASSERT_THROW((void) engine.FindLinkWindows(window, IO::Astrodynamics::Time::TimeSpan(0.0s), IO::Astrodynamics::Time::TimeSpan(1.0s), constraints),
+                 IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW((void) engine.FindLinkWindows(window, IO::Astrodynamics::Time::TimeSpan(60.0s), IO::Astrodynamics::Time::TimeSpan(1.0s), constraints, {{0, 3}}),
+                 IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW((void) engine.FindLinkWindows(window, IO::Astrodynamics::Time::TimeSpan(60.0s), IO::Astrodynamics::Time::TimeSpan(1.0s), constraints, {{1, 1}}),
+                 IO::Astrodynamics::Exception::InvalidArgumentException);
+    constraints.MaximumRange = -1.0;
+    ASSERT_THROW((void) engine.FindLinkWindows(window, IO::Astrodynamics::Time::TimeSpan(60.0s), IO::Astrodynamics::Time::TimeSpan(1.0s), constraints),
+                 IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(IO::Astrodynamics::Links::LinkEngine(nullptr, {-1}), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
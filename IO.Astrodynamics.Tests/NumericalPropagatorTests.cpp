@@ -0,0 +1,225 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <NumericalPropagator.h>
+#include <PointMassGravity.h>
+#include <ZonalHarmonicsGravity.h>
+#include <ThirdBodyGravity.h>
+#include <CelestialBody.h>
+#include <InertialFrames.h>
+#include <TwoBodyPropagator.h>
+#include "Orbits.h"
+#include <InvalidArgumentException.h>
+
+using IO::Astrodynamics::Propagators::NumericalPropagator;
+using IO::Astrodynamics::Propagators::IntegrationScheme;
+using IO::Astrodynamics::Propagators::ForceModel;
+using IO::Astrodynamics::Propagators::PointMassGravity;
+using IO::Astrodynamics::Propagators::ZonalHarmonicsGravity;
+using IO::Astrodynamics::Propagators::ThirdBodyGravity;
+using IO::Astrodynamics::Tests::ToState;
+
+namespace
+{
+    constexpr double MU = 3.986004418E+14;
+    constexpr double RADIUS = 6378137.0;
+    constexpr double J2 = 1.08262668E-03;
+    constexpr double J3 = -2.5323E-06;
+    constexpr double J4 = -1.6204E-06;
+
+    std::vector<std::shared_ptr<ForceModel>> PointMass()
+    {
+        return {std::make_shared<PointMassGravity>(MU)};
+    }
+
+    //Largest position and velocity errors against the two body solution
+    void CompareWithTwoBody(const NumericalPropagator &propagator, const std::vector<double> &initial, double epoch, const std::vector<double> &epochs,
+                            double positionTolerance, double velocityTolerance)
+    {
+        const IO::Astrodynamics::Propagators::TwoBodyPropagator twoBody(MU, initial.data(), initial.data() + 3);
+        std::vector<double> states(6 * epochs.size());
+        propagator.GetStates(epochs.size(), epochs.data(), states.data());
+        for (std::size_t i = 0; i < epochs.size(); ++i)
+        {
+            double position[3], velocity[3];
+            twoBody.Propagate(epochs[i] - epoch, position, velocity);
+            for (int j = 0; j < 3; ++j)
+            {
+                ASSERT_NEAR(position[j], states[6 * i + j], positionTolerance);
+                ASSERT_NEAR(velocity[j], states[6 * i + 3 + j], velocityTolerance);
+            }
+        }
+    }
+
+    std::vector<double> Epochs(double begin, double end, std::size_t count)
+    {
+        std::vector<double> epochs(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            epochs[i] = begin + (end - begin) * static_cast<double>(i) / static_cast<double>(count - 1);
+        }
+        return epochs;
+    }
+}
+
+TEST(NumericalPropagator, DormandPrinceTwoBody)
+{
+    const auto initial = ToState({7000000.0, 0.05, 0.9, 1.2, 0.3, 0.5}, MU);
+    NumericalPropagator propagator(PointMass());
+    propagator.Propagate(1000.0, initial.data(), -86400.0, 172800.0);
+
+    //Dense output everywhere, forward and backward from the initial epoch
+    CompareWithTwoBody(propagator, initial, 1000.0, Epochs(-86400.0, 172800.0, 5001), 0.2, 2E-04);
+    ASSERT_GT(propagator.GetStepCount(), 0);
+    ASSERT_GE(propagator.GetEvaluationCount(), 6 * propagator.GetStepCount());
+}
+
+TEST(NumericalPropagator, DormandPrinceEccentric)
+{
+    const auto initial = ToState({26000000.0, 0.7, 1.1, 0.5, 2.5, 4.0}, MU);
+    NumericalPropagator propagator(PointMass());
+    propagator.Propagate(0.0, initial.data(), 0.0, 10.0 * 86400.0);
+
+    CompareWithTwoBody(propagator, initial, 0.0, Epochs(0.0, 10.0 * 86400.0, 2001), 1.0, 1E-03);
+}
+
+TEST(NumericalPropagator, RungeKutta4TwoBody)
+{
+    const auto initial = ToState({7000000.0, 0.05, 0.9, 1.2, 0.3, 0.5}, MU);
+    NumericalPropagator propagator(PointMass(), IntegrationScheme::RungeKutta4, 10.0);
+    propagator.Propagate(0.0, initial.data(), -21600.0, 21600.0);
+
+    CompareWithTwoBody(propagator, initial, 0.0, Epochs(-21600.0, 21600.0, 1001), 0.2, 2E-04);
+    ASSERT_EQ(4320, propagator.GetStepCount());
+}
+
+TEST(NumericalPropagator, WindowWithoutInitialEpoch)
+{
+    const auto initial = ToState({7000000.0, 0.01, 0.5, 0.0, 0.0, 0.0}, MU);
+    NumericalPropagator propagator(PointMass());
+    propagator.Propagate(0.0, initial.data(), 36000.0, 43200.0);
+
+    CompareWithTwoBody(propagator, initial, 0.0, Epochs(0.0, 43200.0, 101), 0.01, 1E-05);
+}
+
+TEST(NumericalPropagator, EmptyWindow)
+{
+    const auto initial = ToState({7000000.0, 0.01, 0.5, 0.0, 0.0, 0.0}, MU);
+    NumericalPropagator propagator(PointMass());
+    propagator.Propagate(100.0, initial.data(), 100.0, 100.0);
+
+    double state[6];
+    propagator.GetState(100.0, state);
+    for (int i = 0; i < 6; ++i)
+    {
+        ASSERT_DOUBLE_EQ(initial[i], state[i]);
+    }
+    ASSERT_THROW(propagator.GetState(101.0, state), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
+
+TEST(NumericalPropagator, ZonalHarmonicsConservation)
+{
+    //Axisymmetric field, energy and angular momentum along the pole are constant
+    const double pole[3]{0.0, 0.0, 1.0};
+    const auto zonal = std::make_shared<ZonalHarmonicsGravity>(MU, RADIUS, J2, J3, J4, pole);
+    NumericalPropagator propagator({std::make_shared<PointMassGravity>(MU), zonal});
+    const auto initial = ToState({6800000.0, 0.02, 0.9, 1.2, 0.3, 0.5}, MU);
+    propagator.Propagate(0.0, initial.data(), 0.0, 86400.0);
+
+    auto energy = [&](const double *state)
+    {
+        const double r = std::sqrt(state[0] * state[0] + state[1] * state[1] + state[2] * state[2]);
+        const double x = state[2] / r;
+        const double p2 = 0.5 * (3.0 * x * x - 1.0);
+        const double p3 = 0.5 * (5.0 * x * x * x - 3.0 * x);
+        const double p4 = (35.0 * x * x * x * x - 30.0 * x * x + 3.0) / 8.0;
+        const double ratio = RADIUS / r;
+        const double potential = MU / r * (1.0 - J2 * ratio * ratio * p2 - J3 * ratio * ratio * ratio * p3 - J4 * ratio * ratio * ratio * ratio * p4);
+        return 0.5 * (state[3] * state[3] + state[4] * state[4] + state[5] * state[5]) - potential;
+    };
+    auto momentum = [](const double *state) { return state[0] * state[4] - state[1] * state[3]; };
+
+    double final[6];
+    propagator.GetState(86400.0, final);
+    ASSERT_NEAR(energy(initial.data()), energy(final), 1E-02);
+    ASSERT_NEAR(momentum(initial.data()), momentum(final), 10.0);
+
+    //Perturbation is significant, the orbit must not match the two body one
+    const IO::Astrodynamics::Propagators::TwoBodyPropagator twoBody(MU, initial.data(), initial.data() + 3);
+    double position[3], velocity[3];
+    twoBody.Propagate(86400.0, position, velocity);
+    ASSERT_GT(std::abs(position[0] - final[0]) + std::abs(position[1] - final[1]) + std::abs(position[2] - final[2]), 1000.0);
+}
+
+TEST(NumericalPropagator, MoonAgainstEphemeris)
+{
+    //Moon relative to the earth with kernel based perturbations, the reference is the planetary ephemeris
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    auto moon = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(301, earth);
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    const auto &frame = IO::Astrodynamics::Frames::InertialFrames::ICRF();
+    const IO::Astrodynamics::Time::TDB epoch("2021-01-01 00:00:00 TDB");
+    const double begin = epoch.GetSecondsFromJ2000().count();
+    const double end = begin + 86400.0;
+
+    auto moonState = [&](double t)
+    {
+        auto sv = moon->ReadEphemeris(frame, IO::Astrodynamics::AberrationsEnum::None, IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(t)), *earth);
+        return std::vector<double>{sv.GetPosition().GetX(), sv.GetPosition().GetY(), sv.GetPosition().GetZ(),
+                                   sv.GetVelocity().GetX(), sv.GetVelocity().GetY(), sv.GetVelocity().GetZ()};
+    };
+    const auto initial = moonState(begin);
+
+    //Largest position error against the ephemeris
+    auto error = [&](bool withSun)
+    {
+        std::vector<std::shared_ptr<ForceModel>> forces{std::make_shared<PointMassGravity>(earth->GetMu() + moon->GetMu()),
+                                                        std::make_shared<ZonalHarmonicsGravity>(*earth, frame, epoch)};
+        if (withSun)
+        {
+            forces.push_back(std::make_shared<ThirdBodyGravity>(sun, earth, frame));
+        }
+        NumericalPropagator propagator(forces, IntegrationScheme::DormandPrince54, 600.0);
+        propagator.Propagate(begin, initial.data(), begin, end);
+        double largest = 0.0;
+        for (double t: Epochs(begin, end, 9))
+        {
+            double state[6];
+            propagator.GetState(t, state);
+            const auto expected = moonState(t);
+            largest = std::max(largest, std::sqrt((state[0] - expected[0]) * (state[0] - expected[0]) + (state[1] - expected[1]) * (state[1] - expected[1]) +
+                                                  (state[2] - expected[2]) * (state[2] - expected[2])));
+        }
+        return largest;
+    };
+
+    //Remaining error comes from the planets and the relativistic terms of the ephemeris
+    ASSERT_LT(error(true), 1000.0);
+    //Solar perturbation is about a hundred kilometers per day
+    ASSERT_GT(error(false), 20000.0);
+}
+
+TEST(NumericalPropagator, InvalidArguments)
+{
+    ASSERT_THROW(NumericalPropagator({}), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(NumericalPropagator({nullptr}), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(NumericalPropagator(PointMass(), IntegrationScheme::RungeKutta4, 0.0), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(NumericalPropagator(PointMass(), IntegrationScheme::DormandPrince54, 60.0, 0.0), IO::Astrodynamics::Exception::InvalidArgumentException);
+
+    const auto initial = ToState({7000000.0, 0.01, 0.5, 0.0, 0.0, 0.0}, MU);
+    NumericalPropagator propagator(PointMass());
+    ASSERT_THROW(propagator.Propagate(0.0, initial.data(), 10.0, 0.0), IO::Astrodynamics::Exception::InvalidArgumentException);
+    const double invalid[6]{std::numeric_limits<double>::quiet_NaN(), 0.0, 0.0, 0.0, 0.0, 0.0};
+    ASSERT_THROW(propagator.Propagate(0.0, invalid, 0.0, 10.0), IO::Astrodynamics::Exception::InvalidArgumentException);
+
+    propagator.Propagate(0.0, initial.data(), 0.0, 600.0);
+    double state[6];
+    ASSERT_THROW(propagator.GetState(-1.0, state), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(propagator.GetState(601.0, state), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
@@ -0,0 +1,30 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef TEST_ORBITS_H
+#define TEST_ORBITS_H
+
+#include <cmath>
+#include <vector>
+
+#include <ElementsConverter.h>
+
+namespace IO::Astrodynamics::Tests
+{
+    //State from keplerian elements (a, e, i, O, w, M)
+    inline std::vector<double> ToState(const std::vector<double> &keplerian, double mu)
+    {
+        std::vector<double> state(6);
+        IO::Astrodynamics::OrbitalParameters::ElementsConverter::Convert(IO::Astrodynamics::OrbitalParameters::ElementsType::Keplerian,
+                                                                         IO::Astrodynamics::OrbitalParameters::ElementsType::StateVector, 1, mu, keplerian.data(),
+                                                                         state.data());
+        return state;
+    }
+
+    inline double Norm(const double *vector)
+    {
+        return std::sqrt(vector[0] * vector[0] + vector[1] * vector[1] + vector[2] * vector[2]);
+    }
+}
+#endif //TEST_ORBITS_H
@@ -0,0 +1,109 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <PassTable.h>
+#include <SDKException.h>
+
+static IO::Astrodynamics::Sites::Pass CreatePass(int targetId, double aos)
+{
+    IO::Astrodynamics::Sites::Pass pass;
+    pass.SiteIndex = 2;
+    pass.TargetId = targetId;
+    pass.AOS = IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(aos));
+    pass.LOS = IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(aos + 600.0));
+    pass.TCA = IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(aos + 301.0));
+    pass.MaxElevationEpoch = IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(aos + 300.0));
+    pass.MaxElevation = 0.8;
+    pass.MinRange = 750000.0;
+    pass.AOSAzimuth = 0.3;
+    pass.LOSAzimuth = 3.5;
+    return pass;
+}
+
+TEST(PassTable, SortAndFilter)
+{
+    IO::Astrodynamics::Sites::PassTable table({CreatePass(-101, 2000.0), CreatePass(-102, 1000.0), CreatePass(-101, 500.0)});
+    ASSERT_EQ(3, table.GetPasses().size());
+    ASSERT_DOUBLE_EQ(500.0, table.GetPasses()[0].AOS.GetSecondsFromJ2000().count());
+    ASSERT_DOUBLE_EQ(1000.0, table.GetPasses()[1].AOS.GetSecondsFromJ2000().count());
+    ASSERT_DOUBLE_EQ(2000.0, table.GetPasses()[2].AOS.GetSecondsFromJ2000().count());
+
+    auto passes = table.GetPasses(-101);
+    ASSERT_EQ(2, passes.size());
+    ASSERT_EQ(-101, passes[1].TargetId);
+}
+
+TEST(PassTable, Binary)
+{
+    IO::Astrodynamics::Sites::PassTable table({CreatePass(-101, 2000.0), CreatePass(-102, 1000.0)});
+    std::string filePath = "passes.bin";
+    table.WriteBinary(filePath);
+
+    auto res = IO::Astrodynamics::Sites::PassTable::ReadBinary(filePath);
+    ASSERT_EQ(2, res.GetPasses().size());
+    auto &pass = res.GetPasses()[1];
+    ASSERT_EQ(2, pass.SiteIndex);
+    ASSERT_EQ(-101, pass.TargetId);
+    ASSERT_DOUBLE_EQ(2000.0, pass.AOS.GetSecondsFromJ2000().count());
+    ASSERT_DOUBLE_EQ(2600.0, pass.LOS.GetSecondsFromJ2000().count());
+    ASSERT_DOUBLE_EQ(2301.0, pass.TCA.GetSecondsFromJ2000().count());
+    ASSERT_DOUBLE_EQ(2300.0, pass.MaxElevationEpoch.GetSecondsFromJ2000().count());
+    ASSERT_DOUBLE_EQ(0.8, pass.MaxElevation);
+    ASSERT_DOUBLE_EQ(750000.0, pass.MinRange);
+    ASSERT_DOUBLE_EQ(0.3, pass.AOSAzimuth);
+    ASSERT_DOUBLE_EQ(3.5, pass.LOSAzimuth);
+    std::filesystem::remove(filePath);
+
+    ASSERT_THROW(IO::Astrodynamics::Sites::PassTable::ReadBinary("missing.bin"), IO::Astrodynamics::Exception::SDKException);
+}
+
+TEST(PassTable, BinaryInvalidCount)
+{
+    IO::Astrodynamics::Sites::PassTable table({CreatePass(-101, 2000.0), CreatePass(-102, 1000.0)});
+    std::string filePath = "passes_corrupted.bin";
+    table.WriteBinary(filePath);
+
+    //Count larger than the stored records, up to a count that can't be allocated
+    for (std::uint64_t count: {std::uint64_t{3}, std::uint64_t{1} << 40, std::numeric_limits<std::uint64_t>::max()})
+    {
+        {
+            std::fstream file(filePath, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(8);
+            file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        }
+        ASSERT_THROW(IO::Astrodynamics::Sites::PassTable::ReadBinary(filePath), IO::Astrodynamics::Exception::SDKException);
+    }
+
+    //Truncated records
+    std::filesystem::resize_file(filePath, std::filesystem::file_size(filePath) - 1);
+    const std::uint64_t count{2};
+    {
+        std::fstream file(filePath, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(8);
+        file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    }
+    ASSERT_THROW(IO::Astrodynamics::Sites::PassTable::ReadBinary(filePath), IO::Astrodynamics::Exception::SDKException);
+    std::filesystem::remove(filePath);
+}
+
+TEST(PassTable, Csv)
+{
+    IO::Astrodynamics::Sites::PassTable table({CreatePass(-101, 2000.0)});
+    std::string filePath = "passes.csv";
+    table.WriteCsv(filePath);
+
+    std::ifstream file(filePath);
+    std::string header, line, extra;
+    std::getline(file, header);
+    std::getline(file, line);
+    ASSERT_EQ("SiteIndex,TargetId,AOS,LOS,TCA,MaxElevationEpoch,MaxElevation,MinRange,AOSAzimuth,LOSAzimuth", header);
+    ASSERT_EQ(0, line.rfind("2,-101,", 0));
+    ASSERT_FALSE(std::getline(file, extra));
+    file.close();
+    std::filesystem::remove(filePath);
+}
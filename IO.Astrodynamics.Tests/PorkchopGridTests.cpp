@@ -0,0 +1,163 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <PorkchopGrid.h>
+#include <LambertSolver.h>
+#include <Constants.h>
+#include <InertialFrames.h>
+#include <InvalidArgumentException.h>
+
+using IO::Astrodynamics::Maneuvers::PorkchopGrid;
+
+namespace
+{
+    constexpr double MU_SUN = 1.32712440018E+20;
+
+    //Circular and coplanar orbit state
+    void CircularState(double radius, double phase, double epoch, double *state)
+    {
+        const double n = std::sqrt(MU_SUN / (radius * radius * radius));
+        const double angle = phase + n * epoch;
+        const double speed = n * radius;
+        state[0] = radius * std::cos(angle);
+        state[1] = radius * std::sin(angle);
+        state[2] = 0.0;
+        state[3] = -speed * std::sin(angle);
+        state[4] = speed * std::cos(angle);
+        state[5] = 0.0;
+    }
+}
+
+TEST(PorkchopGrid, Compute)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    auto marsBarycenter = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(4, sun);
+    PorkchopGrid grid(earth, marsBarycenter, sun);
+
+    std::vector<IO::Astrodynamics::Time::TDB> departures, arrivals;
+    for (int i = 0; i < 30; ++i)
+    {
+        departures.emplace_back(IO::Astrodynamics::Time::TDB("2020-07-01 00:00:00 TDB").Add(IO::Astrodynamics::Time::TimeSpan(std::chrono::duration<double>(i * 86400.0))));
+    }
+    for (int i = 0; i < 40; ++i)
+    {
+        arrivals.emplace_back(IO::Astrodynamics::Time::TDB("2021-01-20 00:00:00 TDB").Add(IO::Astrodynamics::Time::TimeSpan(std::chrono::duration<double>(i * 86400.0))));
+    }
+    auto res = grid.Compute(departures, arrivals);
+    ASSERT_EQ(30, res.DepartureCount);
+    ASSERT_EQ(40, res.ArrivalCount);
+    ASSERT_EQ(1200, res.DepartureC3.size());
+
+    //Cell equals a Lambert problem solved from ephemeris
+    auto departure = earth->ReadEphemeris(IO::Astrodynamics::Frames::InertialFrames::ICRF(), IO::Astrodynamics::AberrationsEnum::None, departures[10], *sun);
+    auto arrival = marsBarycenter->ReadEphemeris(IO::Astrodynamics::Frames::InertialFrames::ICRF(), IO::Astrodynamics::AberrationsEnum::None, arrivals[20], *sun);
+    const double r1[3]{departure.GetPosition().GetX(), departure.GetPosition().GetY(), departure.GetPosition().GetZ()};
+    const double r2[3]{arrival.GetPosition().GetX(), arrival.GetPosition().GetY(), arrival.GetPosition().GetZ()};
+    const double tof = (arrivals[20] - departures[10]).GetSeconds().count();
+    double v1[3], v2[3];
+    ASSERT_TRUE(IO::Astrodynamics::Maneuvers::LambertSolver::SolveDirect(r1, r2, tof, sun->GetMu(), false, v1, v2));
+    const auto vInfinity = IO::Astrodynamics::Math::Vector3D(v1[0], v1[1], v1[2]) - departure.GetVelocity();
+    ASSERT_DOUBLE_EQ(tof, res.TimeOfFlight[10 * 40 + 20]);
+    ASSERT_NEAR(vInfinity.Magnitude() * vInfinity.Magnitude(), res.DepartureC3[10 * 40 + 20], 1E-03);
+    ASSERT_NEAR(std::asin(vInfinity.GetZ() / vInfinity.Magnitude()), res.DepartureDeclination[10 * 40 + 20], 1E-12);
+    ASSERT_NEAR((IO::Astrodynamics::Math::Vector3D(v2[0], v2[1], v2[2]) - arrival.GetVelocity()).Magnitude(), res.ArrivalVInfinity[10 * 40 + 20], 1E-06);
+
+    //2020 Mars opportunity minimum energy is about 13 km^2/s^2
+    const double minimum = *std::min_element(res.DepartureC3.begin(), res.DepartureC3.end());
+    ASSERT_GT(minimum, 8.0E+06);
+    ASSERT_LT(minimum, 20.0E+06);
+}
+
+TEST(PorkchopGrid, Hohmann)
+{
+    const double r1 = 1.496E+11;
+    const double r2 = 2.279E+11;
+    const double hohmannTime = IO::Astrodynamics::Constants::PI * std::sqrt(std::pow(0.5 * (r1 + r2), 3) / MU_SUN);
+    const double n2 = std::sqrt(MU_SUN / (r2 * r2 * r2));
+
+    //Arrival body is slightly before opposition at the end of the Hohmann transfer to keep the transfer plane defined
+    std::vector<double> departureEpochs{0.0, 86400.0};
+    std::vector<double> arrivalEpochs{-86400.0, hohmannTime};
+    std::vector<double> departureStates(12), arrivalStates(12);
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        CircularState(r1, 0.0, departureEpochs[i], departureStates.data() + 6 * i);
+        CircularState(r2, IO::Astrodynamics::Constants::PI - 1E-04 - n2 * hohmannTime, arrivalEpochs[i], arrivalStates.data() + 6 * i);
+    }
+
+    std::vector<double> c3(4), vInfinity(4), declination(4), tof(4);
+    PorkchopGrid::Compute(MU_SUN, 2, departureEpochs.data(), departureStates.data(), 2, arrivalEpochs.data(), arrivalStates.data(), false, 1, c3.data(),
+                          vInfinity.data(), declination.data(), tof.data());
+
+    const double departureExcess = std::sqrt(MU_SUN / r1) * (std::sqrt(2.0 * r2 / (r1 + r2)) - 1.0);
+    const double arrivalExcess = std::sqrt(MU_SUN / r2) * (1.0 - std::sqrt(2.0 * r1 / (r1 + r2)));
+    ASSERT_NEAR(departureExcess * departureExcess, c3[1], departureExcess * departureExcess * 1E-03);
+    ASSERT_NEAR(arrivalExcess, vInfinity[1], arrivalExcess * 1E-03);
+    ASSERT_NEAR(0.0, declination[1], 1E-09);
+    ASSERT_DOUBLE_EQ(hohmannTime, tof[1]);
+
+    //Arrival before departure
+    ASSERT_TRUE(std::isnan(c3[0]));
+    ASSERT_TRUE(std::isnan(vInfinity[0]));
+    ASSERT_TRUE(std::isnan(declination[0]));
+    ASSERT_DOUBLE_EQ(-86400.0, tof[0]);
+    ASSERT_TRUE(std::isnan(c3[2]));
+    ASSERT_FALSE(std::isnan(c3[3]));
+}
+
+TEST(PorkchopGrid, Threads)
+{
+    const double r1 = 1.496E+11;
+    const double r2 = 2.279E+11;
+    std::vector<double> departureEpochs, arrivalEpochs, departureStates, arrivalStates;
+    for (int i = 0; i < 100; ++i)
+    {
+        departureEpochs.push_back(i * 86400.0);
+        departureStates.resize(departureStates.size() + 6);
+        CircularState(r1, 0.0, departureEpochs.back(), &departureStates[departureStates.size() - 6]);
+    }
+    for (int i = 0; i < 120; ++i)
+    {
+        arrivalEpochs.push_back(1.0E+07 + i * 86400.0);
+        arrivalStates.resize(arrivalStates.size() + 6);
+        CircularState(r2, 0.8, arrivalEpochs.back(), &arrivalStates[arrivalStates.size() - 6]);
+        arrivalStates[arrivalStates.size() - 4] = 1.0E+09;
+    }
+
+    const std::size_t count = departureEpochs.size() * arrivalEpochs.size();
+    std::vector<double> c3(count), vInfinity(count), declination(count), tof(count);
+    std::vector<double> c3Threads(count), vInfinityThreads(count), declinationThreads(count), tofThreads(count);
+    PorkchopGrid::Compute(MU_SUN, departureEpochs.size(), departureEpochs.data(), departureStates.data(), arrivalEpochs.size(), arrivalEpochs.data(),
+                          arrivalStates.data(), false, 1, c3.data(), vInfinity.data(), declination.data(), tof.data());
+    PorkchopGrid::Compute(MU_SUN, departureEpochs.size(), departureEpochs.data(), departureStates.data(), arrivalEpochs.size(), arrivalEpochs.data(),
+                          arrivalStates.data(), false, 4, c3Threads.data(), vInfinityThreads.data(), declinationThreads.data(), tofThreads.data());
+    ASSERT_EQ(c3, c3Threads);
+    ASSERT_EQ(vInfinity, vInfinityThreads);
+    ASSERT_EQ(declination, declinationThreads);
+    ASSERT_EQ(tof, tofThreads);
+
+    //Arrival body is out of the departure plane
+    ASSERT_GT(std::abs(declination[0]), 0.0);
+}
+
+TEST(PorkchopGrid, InvalidArguments)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    ASSERT_THROW(PorkchopGrid(sun, nullptr, sun), IO::Astrodynamics::Exception::InvalidArgumentException);
+
+    const double epochs[1]{0.0};
+    const double states[6]{1.0E+11, 0.0, 0.0, 0.0, 30000.0, 0.0};
+    const double origin[6]{};
+    double c3[1], vInfinity[1], declination[1], tof[1];
+    ASSERT_THROW(PorkchopGrid::Compute(0.0, 1, epochs, states, 1, epochs, states, false, 1, c3, vInfinity, declination, tof),
+                 IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(PorkchopGrid::Compute(MU_SUN, 1, epochs, origin, 1, epochs, states, false, 1, c3, vInfinity, declination, tof),
+                 IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(PorkchopGrid::Compute(MU_SUN, 1, epochs, states, 1, epochs, states, false, 1, nullptr, vInfinity, declination, tof),
+                 IO::Astrodynamics::Exception::InvalidArgumentException);
+}
@@ -0,0 +1,116 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <SGP4CatalogPropagator.h>
+#include <TLE.h>
+#include <CelestialBody.h>
+
+namespace
+{
+    const char *catalogLines[][2]{
+            {"1 25544U 98067A   21020.53488036  .00016717  00000-0  10270-3 0  9054", "2 25544  51.6423 353.0312 0000493 320.8755  39.2360 15.49309423 25703"},
+            {"1 39348U 10057N   24238.91466777  .00000306  00000-0  19116-2 0  9995", "2 39348  20.0230 212.2863 7218258 312.9449   5.6833  2.25781763 89468"},
+            {"1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753", "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667"},
+            {"1 06251U 62025E   06176.82412014  .00008885  00000-0  12808-3 0  3985", "2 06251  58.0579  54.0425 0030035 139.1568 221.1854 15.56387291  6774"},
+            {"1 08195U 75081A   06176.33215444  .00000099  00000-0  11873-3 0   813", "2 08195  64.1586 279.0717 6877146 264.7651  20.2257  2.00491383225656"}};
+
+    std::vector<IO::Astrodynamics::Propagators::SGP4Elements> BuildCatalog(std::size_t size)
+    {
+        std::vector<IO::Astrodynamics::Propagators::SGP4Elements> elements;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            auto element = IO::Astrodynamics::Propagators::SGP4Elements::Parse(catalogLines[i % 5][0], catalogLines[i % 5][1]);
+            element.MeanAnomaly = std::fmod(element.MeanAnomaly + 0.1 * static_cast<double>(i), IO::Astrodynamics::Constants::_2PI);
+            element.RightAscendingNode = std::fmod(element.RightAscendingNode + 0.01 * static_cast<double>(i), IO::Astrodynamics::Constants::_2PI);
+            elements.push_back(element);
+        }
+        return elements;
+    }
+}
+
+TEST(SGP4CatalogPropagator, PropagateTEME)
+{
+    IO::Astrodynamics::Propagators::SGP4CatalogPropagator catalog(BuildCatalog(2000));
+    ASSERT_EQ(2000, catalog.GetSize());
+
+    IO::Astrodynamics::Time::TDB epoch("2021-01-21T12:00:00 TDB");
+    std::vector<double> positions(catalog.GetSize() * 3), velocities(catalog.GetSize() * 3);
+    std::vector<IO::Astrodynamics::Propagators::SGP4::Status> statuses(catalog.GetSize());
+    auto failed = catalog.Propagate(epoch, IO::Astrodynamics::Frames::BodyFixedFrames::TEME(), positions.data(), velocities.data(), 4, statuses.data());
+
+    std::size_t expectedFailed{};
+    for (std::size_t i = 0; i < catalog.GetSize(); ++i)
+    {
+        double position[3], velocity[3];
+        auto status = catalog.GetPropagator(i).Propagate(epoch, position, velocity);
+        ASSERT_EQ(status, statuses[i]);
+        if (status != IO::Astrodynamics::Propagators::SGP4::Status::Success)
+        {
+            expectedFailed++;
+            ASSERT_TRUE(std::isnan(positions[i * 3]));
+            continue;
+        }
+        for (int k = 0; k < 3; ++k)
+        {
+            ASSERT_NEAR(position[k], positions[i * 3 + k], 1E-06);
+            ASSERT_NEAR(velocity[k], velocities[i * 3 + k], 1E-09);
+        }
+    }
+    ASSERT_EQ(expectedFailed, failed);
+
+    //Same results whatever the threads count
+    std::vector<double> positions1(catalog.GetSize() * 3), velocities1(catalog.GetSize() * 3);
+    ASSERT_EQ(failed, catalog.Propagate(epoch, IO::Astrodynamics::Frames::BodyFixedFrames::TEME(), positions1.data(), velocities1.data(), 1));
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        ASSERT_TRUE(positions[i] == positions1[i] || (std::isnan(positions[i]) && std::isnan(positions1[i])));
+        ASSERT_TRUE(velocities[i] == velocities1[i] || (std::isnan(velocities[i]) && std::isnan(velocities1[i])));
+    }
+}
+
+TEST(SGP4CatalogPropagator, PropagateITRF)
+{
+    const auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    std::string lines[][3]{
+            {"ISS",       catalogLines[0][0], catalogLines[0][1]},
+            {"CZ-3C DEB", catalogLines[1][0], catalogLines[1][1]}};
+    std::vector<IO::Astrodynamics::Propagators::SGP4Elements> elements{
+            IO::Astrodynamics::Propagators::SGP4Elements::Parse(lines[0][1], lines[0][2]),
+            IO::Astrodynamics::Propagators::SGP4Elements::Parse(lines[1][1], lines[1][2])};
+    IO::Astrodynamics::Propagators::SGP4CatalogPropagator catalog(elements);
+
+    IO::Astrodynamics::Time::UTC utc("2024-8-26T22:34:20.00000Z");
+    double positions[6], velocities[6];
+    ASSERT_EQ(0, catalog.Propagate(utc.ToTDB(), earth->GetBodyFixedFrame(), positions, velocities));
+
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        IO::Astrodynamics::OrbitalParameters::TLE tle(earth, lines[i]);
+        auto expected = tle.ToStateVector(utc.ToTDB()).ToFrame(earth->GetBodyFixedFrame());
+        ASSERT_NEAR(expected.GetPosition().GetX(), positions[i * 3], 1E-03);
+        ASSERT_NEAR(expected.GetPosition().GetY(), positions[i * 3 + 1], 1E-03);
+        ASSERT_NEAR(expected.GetPosition().GetZ(), positions[i * 3 + 2], 1E-03);
+        ASSERT_NEAR(expected.GetVelocity().GetX(), velocities[i * 3], 1E-06);
+        ASSERT_NEAR(expected.GetVelocity().GetY(), velocities[i * 3 + 1], 1E-06);
+        ASSERT_NEAR(expected.GetVelocity().GetZ(), velocities[i * 3 + 2], 1E-06);
+    }
+}
+
+TEST(SGP4CatalogPropagator, Decayed)
+{
+    auto element = IO::Astrodynamics::Propagators::SGP4Elements::Parse(catalogLines[0][0], catalogLines[0][1]);
+    element.BStar = 0.05;
+    IO::Astrodynamics::Propagators::SGP4CatalogPropagator catalog({element});
+
+    double position[3], velocity[3];
+    IO::Astrodynamics::Propagators::SGP4::Status status;
+    auto epoch = catalog.GetPropagator(0).GetEpoch() + IO::Astrodynamics::Time::TimeSpan(std::chrono::duration<double>(10.0 * 86400.0));
+    ASSERT_EQ(1, catalog.Propagate(epoch, IO::Astrodynamics::Frames::BodyFixedFrames::TEME(), position, velocity, 0, &status));
+    ASSERT_EQ(IO::Astrodynamics::Propagators::SGP4::Status::Decayed, status);
+    ASSERT_TRUE(std::isnan(position[0]));
+    ASSERT_TRUE(std::isnan(velocity[2]));
+}
@@ -0,0 +1,216 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <SGP4.h>
+#include <TLE.h>
+#include <CelestialBody.h>
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+
+TEST(SGP4, Parse)
+{
+    auto elements = IO::Astrodynamics::Propagators::SGP4Elements::Parse("1 25544U 98067A   21020.53488036  .00016717  00000-0  10270-3 0  9054",
+                                                                        "2 25544  51.6423 353.0312 0000493 320.8755  39.2360 15.49309423 25703");
+    ASSERT_EQ(25544, elements.SatelliteNumber);
+    ASSERT_NEAR(664419082.84759140, elements.Epoch.ToTDB().GetSecondsFromJ2000().count(), 1E-05);
+    ASSERT_DOUBLE_EQ(0.1027e-3, elements.BStar);
+    ASSERT_DOUBLE_EQ(51.6423 * IO::Astrodynamics::Constants::DEG_RAD, elements.Inclination);
+    ASSERT_DOUBLE_EQ(353.0312 * IO::Astrodynamics::Constants::DEG_RAD, elements.RightAscendingNode);
+    ASSERT_DOUBLE_EQ(0.0000493, elements.Eccentricity);
+    ASSERT_DOUBLE_EQ(320.8755 * IO::Astrodynamics::Constants::DEG_RAD, elements.PeriapsisArgument);
+    ASSERT_DOUBLE_EQ(39.2360 * IO::Astrodynamics::Constants::DEG_RAD, elements.MeanAnomaly);
+    ASSERT_DOUBLE_EQ(15.49309423 * IO::Astrodynamics::Constants::_2PI / 1440.0, elements.MeanMotion);
+
+    ASSERT_THROW(IO::Astrodynamics::Propagators::SGP4Elements::Parse("1 25544U 98067A", "2 25544  51.6423"), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(IO::Astrodynamics::Propagators::SGP4Elements::Parse("2 25544U 98067A   21020.53488036  .00016717  00000-0  10270-3 0  9054",
+                                                                     "2 25544  51.6423 353.0312 0000493 320.8755  39.2360 15.49309423 25703"),
+                 IO::Astrodynamics::Exception::InvalidArgumentException);
+}
+
+TEST(SGP4, VerificationCases)
+{
+    //Reference values from Vallado's verification set (WGS72), km and km/s
+    struct Case
+    {
+        const char *Line1;
+        const char *Line2;
+        double Minutes;
+        double State[6];
+    };
+    const Case cases[]{
+            {"1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753", "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667",
+                    0.0,   {7022.46529266,  -1400.08296755,  0.03995155,     1.893841015, 6.405893759,  4.534807250}},
+            {"1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753", "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667",
+                    360.0, {-7154.03120202, -3783.17682504,  -3536.19412294, 4.741887409, -4.151817765, -2.093935425}},
+            {"1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753", "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667",
+                    720.0, {-7134.59340119, 6531.68641334,   3260.27186483,  -4.113793027, -2.911922039, -2.557327851}},
+            {"1 06251U 62025E   06176.82412014  .00008885  00000-0  12808-3 0  3985", "2 06251  58.0579  54.0425 0030035 139.1568 221.1854 15.56387291  6774",
+                    0.0,   {3988.31022699,  5498.96657235,   0.90055879,     -3.290032738, 2.357652820,  6.496623475}},
+            {"1 08195U 75081A   06176.33215444  .00000099  00000-0  11873-3 0   813", "2 08195  64.1586 279.0717 6877146 264.7651  20.2257  2.00491383225656",
+                    0.0,   {2349.89483350,  -14785.93811562, 0.02119378,     2.721488096, -3.256811655, 4.498416672}}};
+
+    for (const auto &c: cases)
+    {
+        IO::Astrodynamics::Propagators::SGP4 sgp4(IO::Astrodynamics::Propagators::SGP4Elements::Parse(c.Line1, c.Line2));
+        ASSERT_EQ(IO::Astrodynamics::Propagators::SGP4::Status::Success, sgp4.GetStatus());
+        double position[3], velocity[3];
+        ASSERT_EQ(IO::Astrodynamics::Propagators::SGP4::Status::Success, sgp4.Propagate(c.Minutes, position, velocity));
+
+        //Elements are propagated with KE of evsgp4_c, it differs from reference set constants at the 1e-9 level
+        for (int i = 0; i < 3; ++i)
+        {
+            ASSERT_NEAR(c.State[i], position[i], 1E-04);
+            ASSERT_NEAR(c.State[i + 3], velocity[i], 1E-07);
+        }
+    }
+}
+
+TEST(SGP4, CompareWithSpice)
+{
+    const auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    std::string lines[][3]{
+            {"ISS",       "1 25544U 98067A   21020.53488036  .00016717  00000-0  10270-3 0  9054", "2 25544  51.6423 353.0312 0000493 320.8755  39.2360 15.49309423 25703"},
+            {"CZ-3C DEB", "1 39348U 10057N   24238.91466777  .00000306  00000-0  19116-2 0  9995", "2 39348  20.0230 212.2863 7218258 312.9449   5.6833  2.25781763 89468"},
+            {"00005",     "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753", "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667"},
+            {"06251",     "1 06251U 62025E   06176.82412014  .00008885  00000-0  12808-3 0  3985", "2 06251  58.0579  54.0425 0030035 139.1568 221.1854 15.56387291  6774"}};
+
+    for (auto &line: lines)
+    {
+        IO::Astrodynamics::OrbitalParameters::TLE tle(earth, line);
+        IO::Astrodynamics::Propagators::SGP4 sgp4(IO::Astrodynamics::Propagators::SGP4Elements::Parse(line[1], line[2]));
+        ASSERT_NEAR(tle.GetEpoch().GetSecondsFromJ2000().count(), sgp4.GetEpoch().GetSecondsFromJ2000().count(), 1E-05);
+        ASSERT_EQ(line[0] == "CZ-3C DEB", sgp4.IsDeepSpace());
+
+        for (double hours: {0.0, 6.0, 24.0, 72.0})
+        {
+            auto epoch = tle.GetEpoch() + IO::Astrodynamics::Time::TimeSpan(std::chrono::duration<double>(hours * 3600.0));
+            auto expected = tle.ToStateVector(epoch);
+            double position[3], velocity[3];
+            ASSERT_EQ(IO::Astrodynamics::Propagators::SGP4::Status::Success, sgp4.Propagate(epoch, position, velocity));
+            ASSERT_NEAR(expected.GetPosition().GetX(), position[0], 1E-03);
+            ASSERT_NEAR(expected.GetPosition().GetY(), position[1], 1E-03);
+            ASSERT_NEAR(expected.GetPosition().GetZ(), position[2], 1E-03);
+            ASSERT_NEAR(expected.GetVelocity().GetX(), velocity[0], 1E-06);
+            ASSERT_NEAR(expected.GetVelocity().GetY(), velocity[1], 1E-06);
+            ASSERT_NEAR(expected.GetVelocity().GetZ(), velocity[2], 1E-06);
+        }
+    }
+}
+
+TEST(SGP4, VerificationSetCompareWithSpice)
+{
+    //Objects of Vallado's verification set (SGP4-VER.TLE), they cover near earth, deep space 12 h and 24 h resonances,
+    //Lyddane modification of low inclination orbits, inclination sign change at zero inclination and high eccentricity.
+    //evsgp4_c is the reference over several days, states are in m and m/s.
+    struct Case
+    {
+        const char *Name;
+        const char *Line1;
+        const char *Line2;
+        double StartMinutes;
+        double StopMinutes;
+        double StepMinutes;
+    };
+    const Case cases[]{
+            {"00005", "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753",
+                       "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667", 0.0, 1440.0, 120.0},
+            {"04632", "1 04632U 70093B   04031.91070959 -.00000084  00000-0  10000-3 0  9955",
+                       "2 04632  11.4628 273.1101 1450506 207.6000 143.9350  1.20231981 44145", -1440.0, 7200.0, 360.0},
+            {"06251", "1 06251U 62025E   06176.82412014  .00008885  00000-0  12808-3 0  3985",
+                       "2 06251  58.0579  54.0425 0030035 139.1568 221.1854 15.56387291  6774", 0.0, 1440.0, 120.0},
+            {"08195", "1 08195U 75081A   06176.33215444  .00000099  00000-0  11873-3 0   813",
+                       "2 08195  64.1586 279.0717 6877146 264.7651  20.2257  2.00491383225656", -1440.0, 7200.0, 360.0},
+            {"09880", "1 09880U 77021A   06176.56157475  .00000421  00000-0  10000-3 0  9814",
+                       "2 09880  64.5968 349.3786 7069051 270.0229  16.3320  2.00813614112380", -1440.0, 7200.0, 360.0},
+            {"09998", "1 09998U 74033F   05148.79417928 -.00000112  00000-0  00000+0 0  4480",
+                       "2 09998   9.4958 313.1750 0270971 327.5225  30.8097  1.16186785 45878", -1440.0, 7200.0, 360.0},
+            {"11801", "1 11801U          80230.29629788  .01431103  00000-0  14311-1 0    13",
+                       "2 11801  46.7916 230.4354 7318036  47.4722  10.4117  2.28537848    13", -1440.0, 7200.0, 360.0},
+            {"14128", "1 14128U 83058A   06176.02844893 -.00000158  00000-0  10000-3 0  9627",
+                       "2 14128  11.4384  35.2134 0011562  26.4582 333.5652  0.98870114 46093", -1440.0, 7200.0, 360.0},
+            {"16925", "1 16925U 86065D   06151.67415771  .02550794 -30915-6  18784-3 0  4486",
+                       "2 16925  62.0906 295.0239 5596327 245.1593  47.9690  4.88511875148616", -1440.0, 7200.0, 360.0},
+            {"20413", "1 20413U 83020D   05363.79166667  .00000000  00000-0  00000+0 0  7041",
+                       "2 20413  12.3514 187.4253 7864447 196.3027 356.5478  0.24690082  7978", -1440.0, 7200.0, 360.0},
+            {"21897", "1 21897U 92011A   06176.02341244 -.00001273  00000-0 -13525-3 0  3044",
+                       "2 21897  62.1749 198.0096 7421690 253.0462  20.1561  2.01269994104880", -1440.0, 7200.0, 360.0},
+            {"22312", "1 22312U 93002D   06094.46235912  .99999999  81888-5  49949-3 0  3953",
+                       "2 22312  62.1486  77.4698 0308723 267.9229  88.7392 15.95744531 98783", 0.0, 420.0, 60.0},
+            {"22674", "1 22674U 93035D   06176.55909107  .00002121  00000-0  29868-3 0  6569",
+                       "2 22674  63.5035 354.4452 7541712 253.3264  18.7754  1.96679808 93877", -1440.0, 7200.0, 360.0},
+            {"23177", "1 23177U 94040C   06175.45752052  .00000386  00000-0  76590-3 0    95",
+                       "2 23177   7.0496 179.8238 7258491 296.0482   8.3061  2.25906668 97438", -1440.0, 7200.0, 360.0},
+            {"23333", "1 23333U 94071A   94305.49999999 -.00172956  26967-3  10000-3 0    15",
+                       "2 23333  28.7490   2.3720 9728298  30.4360   1.3500  0.07309491    70", 0.0, 7200.0, 360.0},
+            {"23599", "1 23599U 95029B   06171.76535463  .00085586  12891-6  12956-2 0  2905",
+                       "2 23599   6.9327   0.2849 5782022 274.4436  25.2425  4.47796565123555", -1440.0, 7200.0, 360.0},
+            {"24208", "1 24208U 96044A   06177.04061740 -.00000094  00000-0  10000-3 0  1600",
+                       "2 24208   3.8536  80.0121 0026640 311.0977  48.3000  1.00778054 36119", -1440.0, 7200.0, 360.0},
+            {"25954", "1 25954U 99060A   04039.68057285 -.00000108  00000-0  00000-0 0  6847",
+                       "2 25954   0.0004 243.8136 0001765  15.5294  22.7134  1.00271289 15615", -1440.0, 7200.0, 360.0},
+            {"26900", "1 26900U 01039A   06106.74503247  .00000045  00000-0  10000-3 0  8290",
+                       "2 26900   0.0164 266.5378 0003319  86.1794 182.2590  1.00273847 16981", -1440.0, 7200.0, 360.0},
+            {"26975", "1 26975U 78066F   06174.85818871  .00000620  00000-0  10000-3 0  6809",
+                       "2 26975  68.4714 236.1303 5602877 123.7484 302.5767  2.05657553 67521", -1440.0, 7200.0, 360.0},
+            {"28057", "1 28057U 03049A   06177.78615833  .00000060  00000-0  35940-4 0  1836",
+                       "2 28057  98.4283 247.6961 0000884  88.1964 271.9322 14.35478080140550", 0.0, 1440.0, 120.0},
+            {"28129", "1 28129U 03058A   06175.57071136 -.00000104  00000-0  10000-3 0   459",
+                       "2 28129  54.7298 324.8098 0048506 266.2640  93.1663  2.00562768 18443", -1440.0, 7200.0, 360.0},
+            {"28623", "1 28623U 05006B   06177.81079184  .00637644  69054-6  96390-3 0  6000",
+                       "2 28623  28.5200 114.9834 6249053 170.2550 212.8965  3.79477162 12753", -1440.0, 7200.0, 360.0},
+            {"28626", "1 28626U 05008A   06176.46683397 -.00000205  00000-0  10000-3 0  2190",
+                       "2 28626   0.0019 286.9433 0000335  13.7918  55.6504  1.00270176  4891", -1440.0, 7200.0, 360.0},
+            {"29141", "1 29141U 85108AA  06170.26783845  .99999999  00000-0  13519-0 0   718",
+                       "2 29141  82.4288 273.4882 0015848 277.2124  83.9133 15.93343074  6828", 0.0, 420.0, 60.0},
+            {"29238", "1 29238U 06022G   06177.28732010  .00766286  10823-4  13334-2 0   101",
+                       "2 29238  51.5595 213.7903 0202579  95.2503 267.9010 15.73823839  1061", 0.0, 1440.0, 120.0},
+            {"88888", "1 88888U          80275.98708465  .00073094  13844-3  66816-4 0    87",
+                       "2 88888  72.8435 115.9689 0086731  52.6988 110.5714 16.05824518  1058", 0.0, 1440.0, 120.0}};
+
+    const auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    std::size_t deepSpaceCount{};
+    for (const auto &c: cases)
+    {
+        std::string lines[3]{c.Name, c.Line1, c.Line2};
+        IO::Astrodynamics::OrbitalParameters::TLE tle(earth, lines);
+        IO::Astrodynamics::Propagators::SGP4 sgp4(IO::Astrodynamics::Propagators::SGP4Elements::Parse(c.Line1, c.Line2));
+        ASSERT_EQ(IO::Astrodynamics::Propagators::SGP4::Status::Success, sgp4.GetStatus()) << c.Name;
+        deepSpaceCount += sgp4.IsDeepSpace() ? 1 : 0;
+
+        for (double minutes = c.StartMinutes; minutes <= c.StopMinutes; minutes += c.StepMinutes)
+        {
+            auto epoch = tle.GetEpoch() + IO::Astrodynamics::Time::TimeSpan(std::chrono::duration<double>(minutes * 60.0));
+            auto expected = tle.ToStateVector(epoch);
+            double position[3], velocity[3];
+            ASSERT_EQ(IO::Astrodynamics::Propagators::SGP4::Status::Success, sgp4.Propagate(epoch, position, velocity)) << c.Name << " " << minutes;
+
+            //Millimeter level up to the 175000 km apogee of 20413
+            const double tolerance = 1E-03 + 1E-13 * expected.GetPosition().Magnitude();
+            ASSERT_NEAR(expected.GetPosition().GetX(), position[0], tolerance) << c.Name << " " << minutes;
+            ASSERT_NEAR(expected.GetPosition().GetY(), position[1], tolerance) << c.Name << " " << minutes;
+            ASSERT_NEAR(expected.GetPosition().GetZ(), position[2], tolerance) << c.Name << " " << minutes;
+            ASSERT_NEAR(expected.GetVelocity().GetX(), velocity[0], 1E-06) << c.Name << " " << minutes;
+            ASSERT_NEAR(expected.GetVelocity().GetY(), velocity[1], 1E-06) << c.Name << " " << minutes;
+            ASSERT_NEAR(expected.GetVelocity().GetZ(), velocity[2], 1E-06) << c.Name << " " << minutes;
+        }
+    }
+    ASSERT_EQ(20, deepSpaceCount);
+}
+
+TEST(SGP4, VerificationSetDecay)
+{
+    //Objects of the verification set reentering during propagation
+    IO::Astrodynamics::Propagators::SGP4 first(IO::Astrodynamics::Propagators::SGP4Elements::Parse(
+            "1 22312U 93002D   06094.46235912  .99999999  81888-5  49949-3 0  3953", "2 22312  62.1486  77.4698 0308723 267.9229  88.7392 15.95744531 98783"));
+    IO::Astrodynamics::Propagators::SGP4 second(IO::Astrodynamics::Propagators::SGP4Elements::Parse(
+            "1 29141U 85108AA  06170.26783845  .99999999  00000-0  13519-0 0   718", "2 29141  82.4288 273.4882 0015848 277.2124  83.9133 15.93343074  6828"));
+    double position[3], velocity[3];
+    ASSERT_EQ(IO::Astrodynamics::Propagators::SGP4::Status::Success, first.Propagate(420.0, position, velocity));
+    ASSERT_NE(IO::Astrodynamics::Propagators::SGP4::Status::Success, first.Propagate(1440.0, position, velocity));
+    ASSERT_EQ(IO::Astrodynamics::Propagators::SGP4::Status::Success, second.Propagate(420.0, position, velocity));
+    ASSERT_NE(IO::Astrodynamics::Propagators::SGP4::Status::Success, second.Propagate(1440.0, position, velocity));
+}
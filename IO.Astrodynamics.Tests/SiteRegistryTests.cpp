@@ -0,0 +1,137 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <SiteRegistry.h>
+#include <Site.h>
+#include <Constants.h>
+#include <DataPoolMonitoring.h>
+#include <InertialFrames.h>
+#include <InvalidArgumentException.h>
+#include <SpiceUsr.h>
+#include "TestParameters.h"
+
+TEST(SiteRegistry, Register)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    IO::Astrodynamics::Sites::SiteRegistry registry(earth);
+
+    std::vector<IO::Astrodynamics::Sites::SiteDefinition> sites;
+    for (int i = 0; i < 50; ++i)
+    {
+        sites.push_back({399500 + i, "REG" + std::to_string(i),
+                         IO::Astrodynamics::Coordinates::Planetodetic((-170.0 + i * 7.0) * IO::Astrodynamics::Constants::DEG_RAD,
+                                                                      (-60.0 + i * 2.5) * IO::Astrodynamics::Constants::DEG_RAD, i * 10.0)});
+    }
+    registry.Register(sites);
+    ASSERT_EQ(50, registry.GetSize());
+    ASSERT_TRUE(registry.Contains(399517));
+    ASSERT_STREQ("REG17", registry.GetSite(399517).Name.c_str());
+
+    for (const auto &site: sites)
+    {
+        SpiceInt code{};
+        SpiceBoolean found{};
+        bods2c_c(site.Name.c_str(), &code, &found);
+        ASSERT_TRUE(found);
+        ASSERT_EQ(site.Id, code);
+    }
+
+    auto id = IO::Astrodynamics::DataPoolMonitoring::Instance().GetIntegerProperty("FRAME_REG3_TOPO", 1);
+    ASSERT_EQ(1399503, id[0]);
+    auto relative = IO::Astrodynamics::DataPoolMonitoring::Instance().GetStringProperty("TKFRAME_1399503_RELATIVE", 1);
+    ASSERT_STREQ("ITRF93", relative[0].c_str());
+
+    //Up vector is the Z axis of the topocentric frame
+    IO::Astrodynamics::Time::TDB epoch("2021-05-18 12:00:00 TDB");
+    const auto &up = registry.GetTopocentricFrame(399520).GetUp();
+    auto z = earth->GetBodyFixedFrame().TransformVector(IO::Astrodynamics::Frames::Frames(IO::Astrodynamics::Sites::SiteRegistry::GetFrameName("REG20")),
+                                                        IO::Astrodynamics::Math::Vector3D(up[0], up[1], up[2]), epoch);
+    ASSERT_NEAR(0.0, z.GetX(), 1E-09);
+    ASSERT_NEAR(0.0, z.GetY(), 1E-09);
+    ASSERT_NEAR(1.0, z.GetZ(), 1E-09);
+}
+
+TEST(SiteRegistry, GetStateVector)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    IO::Astrodynamics::Coordinates::Planetodetic coordinates(2.2 * IO::Astrodynamics::Constants::DEG_RAD, 48.0 * IO::Astrodynamics::Constants::DEG_RAD, 120.0);
+    IO::Astrodynamics::Sites::SiteRegistry registry(earth);
+    registry.Register({{399601, "REGSV", coordinates}});
+
+    IO::Astrodynamics::Sites::Site site{399602, "REGSVREF", coordinates, earth, std::string(SitePath)};
+    IO::Astrodynamics::Time::TDB epoch("2021-05-18 12:00:00 TDB");
+    auto expected = site.GetStateVector(IO::Astrodynamics::Frames::InertialFrames::ICRF(), epoch);
+    auto sv = registry.GetStateVector(399601, IO::Astrodynamics::Frames::InertialFrames::ICRF(), epoch);
+
+    ASSERT_NEAR(expected.GetPosition().GetX(), sv.GetPosition().GetX(), 1E-06);
+    ASSERT_NEAR(expected.GetPosition().GetY(), sv.GetPosition().GetY(), 1E-06);
+    ASSERT_NEAR(expected.GetPosition().GetZ(), sv.GetPosition().GetZ(), 1E-06);
+    ASSERT_NEAR(expected.GetVelocity().GetX(), sv.GetVelocity().GetX(), 1E-09);
+    ASSERT_NEAR(expected.GetVelocity().GetY(), sv.GetVelocity().GetY(), 1E-09);
+    ASSERT_NEAR(expected.GetVelocity().GetZ(), sv.GetVelocity().GetZ(), 1E-09);
+}
+
+TEST(SiteRegistry, Unregister)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    IO::Astrodynamics::Coordinates::Planetodetic coordinates(2.2 * IO::Astrodynamics::Constants::DEG_RAD, 48.0 * IO::Astrodynamics::Constants::DEG_RAD, 0.0);
+    SpiceInt code{};
+    SpiceBoolean found{};
+    {
+        IO::Astrodynamics::Sites::SiteRegistry registry(earth);
+        registry.Register({{399701, "REGU1", coordinates}, {399702, "REGU2", coordinates}, {399703, "REGU3", coordinates}});
+
+        registry.Unregister({399702});
+        ASSERT_EQ(2, registry.GetSize());
+        ASSERT_FALSE(registry.Contains(399702));
+        ASSERT_THROW((void) registry.GetSite(399702), IO::Astrodynamics::Exception::InvalidArgumentException);
+        bods2c_c("REGU2", &code, &found);
+        ASSERT_FALSE(found);
+        SpiceInt n{};
+        SpiceChar type{};
+        dtpool_c("FRAME_REGU2_TOPO", &found, &n, &type);
+        ASSERT_FALSE(found);
+        bods2c_c("REGU3", &code, &found);
+        ASSERT_TRUE(found);
+        ASSERT_EQ(399703, code);
+        ASSERT_STREQ("REGU3", registry.GetSite(399703).Name.c_str());
+
+        registry.Clear();
+        ASSERT_EQ(0, registry.GetSize());
+        bods2c_c("REGU1", &code, &found);
+        ASSERT_FALSE(found);
+
+        registry.Register({{399704, "REGU4", coordinates}});
+    }
+
+    //Pool is cleaned when the registry is destroyed
+    bods2c_c("REGU4", &code, &found);
+    ASSERT_FALSE(found);
+
+    //Sites defined by kernels are preserved
+    bods2c_c("DSS-13", &code, &found);
+    ASSERT_TRUE(found);
+    ASSERT_EQ(399013, code);
+}
+
+TEST(SiteRegistry, InvalidArguments)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    IO::Astrodynamics::Coordinates::Planetodetic coordinates(0.0, 0.0, 0.0);
+    ASSERT_THROW(IO::Astrodynamics::Sites::SiteRegistry(nullptr), IO::Astrodynamics::Exception::InvalidArgumentException);
+
+    IO::Astrodynamics::Sites::SiteRegistry registry(earth);
+    ASSERT_THROW(registry.Register({{399, "REGI", coordinates}}), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(registry.Register({{399801, "", coordinates}}), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(registry.Register({{399801, "AVERYLONGSITENAMEOVERFLOW", coordinates}}), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(registry.Register({{399801, "REGI1", coordinates}, {399801, "REGI2", coordinates}}), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_EQ(0, registry.GetSize());
+    ASSERT_THROW((void) registry.GetTopocentricFrame(399801), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
@@ -3,6 +3,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <filesystem>
 #include <Site.h>
 #include <Constants.h>
 #include <SDKException.h>
@@ -217,6 +218,52 @@ TEST(Site, GetHorizontalCoordinates)
     ASSERT_NEAR(44.983020083563815, hor.GetElevation() * IO::Astrodynamics::Constants::RAD_DEG, 1e-6);
 }
 
+TEST(Site, GetHorizontalCoordinatesBatch)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+
+    //Position virtual station on same location as DSS-13 at local noon
+    IO::Astrodynamics::Sites::Site s{
+        399013, "FAKE_DSS-13",
+        IO::Astrodynamics::Coordinates::Planetodetic(-116.7944627147624 * IO::Astrodynamics::Constants::DEG_RAD,
+                                                     35.2471635434595 * IO::Astrodynamics::Constants::DEG_RAD, 107.0),
+        earth,
+        std::string(SitePath)
+    };
+    std::vector<IO::Astrodynamics::Time::TDB> epochs{IO::Astrodynamics::Time::TDB("2021-05-20 19:43:00 UTC"),
+                                                     IO::Astrodynamics::Time::TDB("2021-05-20 12:38:00 UTC"),
+                                                     IO::Astrodynamics::Time::TDB("2021-05-21 02:48:00 UTC")};
+    auto res = s.GetHorizontalCoordinates({10, 4}, epochs, IO::Astrodynamics::AberrationsEnum::None);
+    ASSERT_EQ(3, res.EpochCount);
+    ASSERT_EQ(2, res.TargetCount);
+    ASSERT_EQ(6, res.Azimuth.size());
+
+    //Same values as single point computation
+    ASSERT_NEAR(151392145840.51746, res.Range[0], 1e-3);
+    ASSERT_NEAR(179.29648368392296, res.Azimuth[0] * IO::Astrodynamics::Constants::RAD_DEG, 1e-6);
+    ASSERT_NEAR(74.902071908623157, res.Elevation[0] * IO::Astrodynamics::Constants::RAD_DEG, 1e-6);
+    ASSERT_NEAR(325144554599.82544, res.Range[1], 1e-3);
+    ASSERT_NEAR(90.462537951785677, res.Azimuth[1] * IO::Astrodynamics::Constants::RAD_DEG, 1e-6);
+    ASSERT_NEAR(44.983020083563815, res.Elevation[1] * IO::Astrodynamics::Constants::RAD_DEG, 1e-6);
+    ASSERT_NEAR(64.278334038627449, res.Azimuth[2] * IO::Astrodynamics::Constants::RAD_DEG, 1e-6);
+    ASSERT_NEAR(-1.0814907937079876, res.Elevation[2] * IO::Astrodynamics::Constants::RAD_DEG, 1e-6);
+    ASSERT_NEAR(295.58861851368368, res.Azimuth[4] * IO::Astrodynamics::Constants::RAD_DEG, 1e-6);
+    ASSERT_NEAR(-0.71930879481469068, res.Elevation[4] * IO::Astrodynamics::Constants::RAD_DEG, 1e-6);
+
+    //Sun rises in the morning and sets in the evening
+    ASSERT_GT(res.ElevationRate[2], 0.0);
+    ASSERT_LT(res.ElevationRate[4], 0.0);
+    ASSERT_NEAR(0.0, res.ElevationRate[0], 1e-5);
+
+    //Refraction
+    auto refracted = s.GetHorizontalCoordinates({10}, epochs, IO::Astrodynamics::AberrationsEnum::None, true);
+    ASSERT_NEAR(0.2748 / 60.0, (refracted.Elevation[0] - res.Elevation[0]) * IO::Astrodynamics::Constants::RAD_DEG, 1e-5);
+    ASSERT_DOUBLE_EQ(res.Elevation[2], refracted.Elevation[1]);
+    ASSERT_GT(refracted.Elevation[2], res.Elevation[4] + 0.4 * IO::Astrodynamics::Constants::DEG_RAD);
+    ASSERT_DOUBLE_EQ(res.Azimuth[0], refracted.Azimuth[0]);
+}
+
 TEST(Site, FindWindowsOnIlluminationConstraint)
 {
     auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
@@ -282,12 +329,55 @@ TEST(Site, ReadEphemeris)
     auto startEphemeris = s.ReadEphemeris(IO::Astrodynamics::Frames::InertialFrames::ICRF(),
                                           IO::Astrodynamics::AberrationsEnum::None, startDate, *earth);
 
-    ASSERT_DOUBLE_EQ(2335472.0052160625, startEphemeris.GetPosition().GetX());
-    ASSERT_DOUBLE_EQ(3587825.509043192, startEphemeris.GetPosition().GetY());
-    ASSERT_DOUBLE_EQ(4712086.4262395874, startEphemeris.GetPosition().GetZ());
-    ASSERT_DOUBLE_EQ(-261.62502565816891, startEphemeris.GetVelocity().GetX());
-    ASSERT_DOUBLE_EQ(169.60274543226581, startEphemeris.GetVelocity().GetY());
-    ASSERT_DOUBLE_EQ(0.53328114037818619, startEphemeris.GetVelocity().GetZ());
+    //Rotation to ICRF is now composed by SPICE at read time
+    ASSERT_NEAR(2335472.0052160625, startEphemeris.GetPosition().GetX(), 1e-6);
+    ASSERT_NEAR(3587825.509043192, startEphemeris.GetPosition().GetY(), 1e-6);
+    ASSERT_NEAR(4712086.4262395874, startEphemeris.GetPosition().GetZ(), 1e-6);
+    ASSERT_NEAR(-261.62502565816891, startEphemeris.GetVelocity().GetX(), 1e-9);
+    ASSERT_NEAR(169.60274543226581, startEphemeris.GetVelocity().GetY(), 1e-9);
+    ASSERT_NEAR(0.53328114037818619, startEphemeris.GetVelocity().GetZ(), 1e-9);
+
+    //Site is fixed in body fixed frame between samples
+    IO::Astrodynamics::Time::TDB epoch("2021-05-17 12:05:17 TDB");
+    auto expected = s.GetStateVector(IO::Astrodynamics::Frames::InertialFrames::ICRF(), epoch);
+    auto ephemeris = s.ReadEphemeris(IO::Astrodynamics::Frames::InertialFrames::ICRF(), IO::Astrodynamics::AberrationsEnum::None, epoch, *earth);
+    ASSERT_NEAR(expected.GetPosition().GetX(), ephemeris.GetPosition().GetX(), 1e-6);
+    ASSERT_NEAR(expected.GetPosition().GetY(), ephemeris.GetPosition().GetY(), 1e-6);
+    ASSERT_NEAR(expected.GetPosition().GetZ(), ephemeris.GetPosition().GetZ(), 1e-6);
+    ASSERT_NEAR(expected.GetVelocity().GetX(), ephemeris.GetVelocity().GetX(), 1e-9);
+    ASSERT_NEAR(expected.GetVelocity().GetY(), ephemeris.GetVelocity().GetY(), 1e-9);
+    ASSERT_NEAR(expected.GetVelocity().GetZ(), ephemeris.GetVelocity().GetZ(), 1e-9);
+}
+
+TEST(Site, WriteLongEphemeris)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    IO::Astrodynamics::Sites::Site s{
+        399104, "S104",
+        IO::Astrodynamics::Coordinates::Planetodetic(2.2 * IO::Astrodynamics::Constants::DEG_RAD,
+                                                     48.0 * IO::Astrodynamics::Constants::DEG_RAD, 0.0),
+        earth,
+        std::string(SitePath)
+    };
+
+    IO::Astrodynamics::Time::TDB startDate("2021-01-01 00:00:00 TDB");
+    IO::Astrodynamics::Time::TDB endDate("2022-01-01 00:00:00 TDB");
+    s.BuildAndWriteEphemeris(IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>(startDate, endDate));
+
+    auto window = s.GetEphemerisCoverageWindow();
+    ASSERT_EQ(startDate, window.GetStartDate());
+    ASSERT_EQ(endDate, window.GetEndDate());
+
+    //File size doesn't depend on window length
+    ASSERT_LT(std::filesystem::file_size(s.GetFilesPath() + "/Ephemeris/S104.spk"), 100000);
+
+    IO::Astrodynamics::Time::TDB epoch("2021-08-13 07:41:23 TDB");
+    auto expected = s.GetStateVector(IO::Astrodynamics::Frames::InertialFrames::ICRF(), epoch);
+    auto ephemeris = s.ReadEphemeris(IO::Astrodynamics::Frames::InertialFrames::ICRF(), IO::Astrodynamics::AberrationsEnum::None, epoch, *earth);
+    ASSERT_NEAR(expected.GetPosition().GetX(), ephemeris.GetPosition().GetX(), 1e-6);
+    ASSERT_NEAR(expected.GetPosition().GetY(), ephemeris.GetPosition().GetY(), 1e-6);
+    ASSERT_NEAR(expected.GetPosition().GetZ(), ephemeris.GetPosition().GetZ(), 1e-6);
 }
 
 TEST(Site, FindBodyVisibilityWindows)
@@ -319,3 +409,41 @@ TEST(Site, FindBodyVisibilityWindows)
     ASSERT_STREQ("2023-02-19 14:33:08.921173 (TDB)", windows[0].GetStartDate().ToTDB().ToString().c_str());
     ASSERT_STREQ("2023-02-19 23:58:50.814787 (UTC)", windows[0].GetEndDate().ToString().c_str());
 }
+
+TEST(Site, PredictPasses)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    auto moon = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(301, earth);
+
+    IO::Astrodynamics::Sites::Site s{
+        399113, "FK_DSS-13",
+        IO::Astrodynamics::Coordinates::Planetodetic(-116.7944627147624 * IO::Astrodynamics::Constants::DEG_RAD,
+                                                     35.2471635434595 * IO::Astrodynamics::Constants::DEG_RAD, 1070.0),
+        earth,
+        std::string(SitePath)
+    };
+
+    auto table = s.PredictPasses({301}, IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>(IO::Astrodynamics::Time::TDB("2023-02-19 00:00:00 TDB"),
+                                                                                                      IO::Astrodynamics::Time::TDB("2023-02-20 00:00:00 TDB")));
+    ASSERT_EQ(1, table.GetPasses().size());
+    auto &pass = table.GetPasses()[0];
+    ASSERT_EQ(301, pass.TargetId);
+
+    //Same window as FindBodyVisibilityWindows
+    ASSERT_NEAR(IO::Astrodynamics::Time::TDB("2023-02-19 14:33:08.921173 TDB").GetSecondsFromJ2000().count(), pass.AOS.GetSecondsFromJ2000().count(), 1.0);
+    ASSERT_EQ(IO::Astrodynamics::Time::TDB("2023-02-20 00:00:00 TDB"), pass.LOS);
+
+    //Consistent with single point computation
+    auto aos = s.GetHorizontalCoordinates(*moon, IO::Astrodynamics::AberrationsEnum::None, pass.AOS);
+    ASSERT_NEAR(aos.GetAzimuth(), pass.AOSAzimuth, 1e-6);
+    auto culmination = s.GetHorizontalCoordinates(*moon, IO::Astrodynamics::AberrationsEnum::None, pass.MaxElevationEpoch);
+    ASSERT_NEAR(culmination.GetElevation(), pass.MaxElevation, 1e-6);
+    ASSERT_GT(pass.MaxElevationEpoch, pass.AOS);
+    ASSERT_LT(pass.MaxElevationEpoch, pass.LOS);
+    ASSERT_GT(pass.MaxElevation, s.GetHorizontalCoordinates(*moon, IO::Astrodynamics::AberrationsEnum::None,
+                                                            pass.MaxElevationEpoch + IO::Astrodynamics::Time::TimeSpan(60s)).GetElevation());
+    ASSERT_GT(pass.MaxElevation, s.GetHorizontalCoordinates(*moon, IO::Astrodynamics::AberrationsEnum::None,
+                                                            pass.MaxElevationEpoch - IO::Astrodynamics::Time::TimeSpan(60s)).GetElevation());
+    ASSERT_NEAR(s.GetHorizontalCoordinates(*moon, IO::Astrodynamics::AberrationsEnum::None, pass.TCA).GetAltitude(), pass.MinRange, 1.0);
+}
@@ -232,6 +232,30 @@ TEST(StateVector, IsParabolic)
     ASSERT_TRUE(sv.IsParabolic());
 }
 
+TEST(StateVector, ParabolicTrueAnomaly)
+{
+    //FICTIVE
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    const double periapsis = 6800000.0;
+    double escapeVelocity = std::sqrt((earth->GetMu() * 2.0) / periapsis);
+    IO::Astrodynamics::Time::TDB epoch(663724800.0s);
+    IO::Astrodynamics::OrbitalParameters::StateVector sv(earth, IO::Astrodynamics::Math::Vector3D(periapsis, 0.0, 0.0),
+                                                         IO::Astrodynamics::Math::Vector3D(0.0, escapeVelocity, 0.0), epoch,
+                                                         IO::Astrodynamics::Frames::InertialFrames::ICRF());
+    ASSERT_TRUE(sv.IsParabolic());
+    ASSERT_NEAR(std::sqrt(earth->GetMu() / (2.0 * periapsis * periapsis * periapsis)), sv.GetMeanMotion(), 1E-12);
+    ASSERT_NEAR(0.0, std::remainder(sv.GetTrueAnomaly(), IO::Astrodynamics::Constants::_2PI), 1E-09);
+
+    //Barker's equation tan(v/2) + tan(v/2)^3 / 3 = n t
+    const IO::Astrodynamics::OrbitalParameters::OrbitalParameters &orbit = sv;
+    for (double t: {600.0, 3600.0, 86400.0})
+    {
+        const double v = orbit.GetTrueAnomaly(epoch + IO::Astrodynamics::Time::TimeSpan(std::chrono::duration<double>(t)));
+        const double d = std::tan(0.5 * v);
+        ASSERT_NEAR(sv.GetMeanMotion() * t, d + d * d * d / 3.0, 1E-09 * (1.0 + sv.GetMeanMotion() * t));
+    }
+}
+
 TEST(StateVector, Assignement)
 {
     //FICTIVE
@@ -260,6 +284,24 @@ TEST(StateVector, Assignement)
     ASSERT_EQ(sv.GetEpoch(), sv2.GetEpoch());
 }
 
+TEST(StateVector, AssignementResetsCache)
+{
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    IO::Astrodynamics::OrbitalParameters::StateVector sv(earth, IO::Astrodynamics::Math::Vector3D(6800000.0, 0.0, 0.0),
+                                                         IO::Astrodynamics::Math::Vector3D(0.0, 8000.0, 100.0), IO::Astrodynamics::Time::TDB(100.0s),
+                                                         IO::Astrodynamics::Frames::InertialFrames::ICRF());
+    const IO::Astrodynamics::OrbitalParameters::StateVector other(earth, IO::Astrodynamics::Math::Vector3D(0.0, 7000000.0, 0.0),
+                                                                  IO::Astrodynamics::Math::Vector3D(-7000.0, 0.0, 3000.0), IO::Astrodynamics::Time::TDB(100.0s),
+                                                                  IO::Astrodynamics::Frames::InertialFrames::ICRF());
+    ASSERT_NEAR(std::atan(100.0 / 8000.0), sv.GetConicOrbitalElementsAtEpoch().GetInclination(), 1E-12);
+    ASSERT_NEAR(1.0, sv.GetAscendingNodeVector().GetX(), 1E-06);
+
+    //Cached representations follow the assigned state
+    sv = other;
+    ASSERT_NEAR(std::atan(3000.0 / 7000.0), sv.GetConicOrbitalElementsAtEpoch().GetInclination(), 1E-12);
+    ASSERT_NEAR(1.0, sv.GetAscendingNodeVector().GetY(), 1E-06);
+}
+
 TEST(StateVector, Frame)
 {
     auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399); //GEOPHYSICAL PROPERTIES provided by JPL
@@ -0,0 +1,64 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <SurfaceIlluminationGrid.h>
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+
+TEST(SurfaceIlluminationGrid, Evaluate)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    std::vector<IO::Astrodynamics::Coordinates::Planetodetic> points{
+            IO::Astrodynamics::Coordinates::Planetodetic(0.0, 45.0 * IO::Astrodynamics::Constants::DEG_RAD, 0.0),
+            IO::Astrodynamics::Coordinates::Planetodetic(180.0 * IO::Astrodynamics::Constants::DEG_RAD, 0.0, 0.0)};
+    IO::Astrodynamics::Illumination::SurfaceIlluminationGrid grid(earth, points);
+    ASSERT_EQ(2, grid.GetPointCount());
+
+    std::vector<IO::Astrodynamics::Time::TDB> epochs{IO::Astrodynamics::Time::TDB("2021-05-17 12:00:00 UTC"),
+                                                      IO::Astrodynamics::Time::TDB("2021-05-17 00:00:00 UTC")};
+    auto res = grid.Evaluate(10, 10, epochs, IO::Astrodynamics::AberrationsEnum::None, true);
+
+    ASSERT_EQ(2, res.PointCount);
+    ASSERT_EQ(2, res.EpochCount);
+    ASSERT_EQ(4, res.Incidence.size());
+    ASSERT_NEAR(25.56897625291661, res.Incidence[0] * IO::Astrodynamics::Constants::RAD_DEG, 1e-6);
+    ASSERT_NEAR(25.56897625291661, res.Emission[0] * IO::Astrodynamics::Constants::RAD_DEG, 1e-6);
+    ASSERT_NEAR(0.0, res.Phase[0] * IO::Astrodynamics::Constants::RAD_DEG, 1e-6);
+
+    //Same results as site illumination
+    ASSERT_EQ(1, res.IsDay[0]);
+    ASSERT_EQ(0, res.IsDay[1]);
+    ASSERT_EQ(0, res.IsDay[2]);
+    ASSERT_EQ(1, res.IsDay[3]);
+}
+
+TEST(SurfaceIlluminationGrid, EvaluateBuffers)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    double re = earth->GetRadius().GetX();
+    std::vector<IO::Astrodynamics::Math::Vector3D> points{IO::Astrodynamics::Math::Vector3D(re, 0.0, 0.0), IO::Astrodynamics::Math::Vector3D(0.0, re, 0.0)};
+    IO::Astrodynamics::Illumination::SurfaceIlluminationGrid grid(earth, points);
+
+    double source[3]{1.5E+11, 0.0, 0.0};
+    double observer[3]{0.0, 1.5E+11, 0.0};
+    double incidence[2];
+    double emission[2];
+    double phase[2];
+    grid.Evaluate(source, observer, incidence, emission, phase);
+
+    ASSERT_NEAR(0.0, incidence[0], 1e-9);
+    ASSERT_NEAR(IO::Astrodynamics::Constants::PI2, emission[0], 1e-4);
+    ASSERT_NEAR(IO::Astrodynamics::Constants::PI2, incidence[1], 1e-4);
+    ASSERT_NEAR(0.0, emission[1], 1e-9);
+    ASSERT_NEAR(IO::Astrodynamics::Constants::PI2, phase[0], 1e-4);
+}
+
+TEST(SurfaceIlluminationGrid, InvalidArguments)
+{
+    std::vector<IO::Astrodynamics::Math::Vector3D> points{IO::Astrodynamics::Math::Vector3D(1.0, 0.0, 0.0)};
+    ASSERT_THROW(IO::Astrodynamics::Illumination::SurfaceIlluminationGrid(nullptr, points), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
@@ -0,0 +1,166 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <TLECatalog.h>
+#include <TLE.h>
+#include <SGP4CatalogPropagator.h>
+#include <CelestialBody.h>
+#include <InvalidArgumentException.h>
+#include <SDKException.h>
+
+namespace
+{
+    const std::string ISS_LINE1{"1 25544U 98067A   21020.53488036  .00016717  00000-0  10270-3 0  9054"};
+    const std::string ISS_LINE2{"2 25544  51.6423 353.0312 0000493 320.8755  39.2360 15.49309423 25703"};
+    const std::string VANGUARD_LINE1{"1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753"};
+    const std::string VANGUARD_LINE2{"2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667"};
+}
+
+TEST(TLECatalog, Checksum)
+{
+    ASSERT_TRUE(IO::Astrodynamics::OrbitalParameters::TLECatalog::IsChecksumValid(ISS_LINE1));
+    ASSERT_TRUE(IO::Astrodynamics::OrbitalParameters::TLECatalog::IsChecksumValid(ISS_LINE2));
+    ASSERT_TRUE(IO::Astrodynamics::OrbitalParameters::TLECatalog::IsChecksumValid(VANGUARD_LINE1));
+    ASSERT_TRUE(IO::Astrodynamics::OrbitalParameters::TLECatalog::IsChecksumValid(VANGUARD_LINE2));
+
+    std::string corrupted = ISS_LINE2;
+    corrupted[10] = '7';
+    ASSERT_FALSE(IO::Astrodynamics::OrbitalParameters::TLECatalog::IsChecksumValid(corrupted));
+    ASSERT_FALSE(IO::Astrodynamics::OrbitalParameters::TLECatalog::IsChecksumValid(ISS_LINE2.substr(0, 60)));
+}
+
+TEST(TLECatalog, Parse2LE)
+{
+    auto catalog = IO::Astrodynamics::OrbitalParameters::TLECatalog::Parse(ISS_LINE1 + "\n" + ISS_LINE2 + "\n" + VANGUARD_LINE1 + "\n" + VANGUARD_LINE2);
+    ASSERT_EQ(2, catalog.GetSize());
+    ASSERT_EQ(0, catalog.GetRejectedCount());
+    ASSERT_TRUE(catalog.GetName(0).empty());
+
+    const auto &record = catalog.GetRecord(0);
+    ASSERT_EQ(25544, record.SatelliteNumber);
+    ASSERT_EQ('U', record.Classification);
+    ASSERT_STREQ("98067A", record.InternationalDesignator);
+    ASSERT_EQ(905, record.ElementSetNumber);
+    ASSERT_EQ(2570, record.RevolutionNumber);
+
+    const auto &vanguard = catalog.GetRecord(1);
+    ASSERT_EQ(5, vanguard.SatelliteNumber);
+    ASSERT_EQ(475, vanguard.ElementSetNumber);
+    ASSERT_EQ(41366, vanguard.RevolutionNumber);
+    ASSERT_DOUBLE_EQ(0.1859667, vanguard.Eccentricity);
+    ASSERT_DOUBLE_EQ(0.28098e-4, vanguard.BStar);
+}
+
+TEST(TLECatalog, Parse3LE)
+{
+    auto catalog = IO::Astrodynamics::OrbitalParameters::TLECatalog::Parse(
+            "0 ISS (ZARYA)\r\n" + ISS_LINE1 + "\r\n" + ISS_LINE2 + "\r\n\r\nVANGUARD 1   \r\n" + VANGUARD_LINE1 + "\r\n" + VANGUARD_LINE2 + "\r\n");
+    ASSERT_EQ(2, catalog.GetSize());
+    ASSERT_EQ("ISS (ZARYA)", catalog.GetName(0));
+    ASSERT_EQ("VANGUARD 1", catalog.GetName(1));
+    ASSERT_EQ(0, catalog.Find(25544).value());
+    ASSERT_EQ(1, catalog.Find(5).value());
+    ASSERT_FALSE(catalog.Find(12345).has_value());
+}
+
+TEST(TLECatalog, FieldsMatchTLE)
+{
+    auto catalog = IO::Astrodynamics::OrbitalParameters::TLECatalog::Parse(ISS_LINE1 + "\n" + ISS_LINE2);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    std::string lines[3]{"ISS", ISS_LINE1, ISS_LINE2};
+    IO::Astrodynamics::OrbitalParameters::TLE tle(earth, lines);
+
+    const auto &record = catalog.GetRecord(0);
+    ASSERT_DOUBLE_EQ(tle.GetBalisticCoefficient(), record.FirstDerivativeOfMeanMotion);
+    ASSERT_DOUBLE_EQ(tle.GetSecondDerivativeOfMeanMotion(), record.SecondDerivativeOfMeanMotion);
+    ASSERT_DOUBLE_EQ(tle.GetDragTerm(), record.BStar);
+    ASSERT_DOUBLE_EQ(tle.GetInclination(), record.Inclination);
+    ASSERT_DOUBLE_EQ(tle.GetRightAscendingNodeLongitude(), record.RightAscendingNode);
+    ASSERT_DOUBLE_EQ(tle.GetEccentricity(), record.Eccentricity);
+    ASSERT_DOUBLE_EQ(tle.GetPeriapsisArgument(), record.PeriapsisArgument);
+    ASSERT_DOUBLE_EQ(tle.GetMeanAnomaly(), record.MeanAnomaly);
+    ASSERT_NEAR(tle.GetEpoch().GetSecondsFromJ2000().count(), IO::Astrodynamics::Propagators::SGP4Elements::FromRecord(catalog.GetRecord(0)).Epoch.ToTDB().GetSecondsFromJ2000().count(), 1E-05);
+}
+
+TEST(TLECatalog, ElementsMatchSGP4Parser)
+{
+    auto catalog = IO::Astrodynamics::OrbitalParameters::TLECatalog::Parse(VANGUARD_LINE1 + "\n" + VANGUARD_LINE2);
+    auto expected = IO::Astrodynamics::Propagators::SGP4Elements::Parse(VANGUARD_LINE1, VANGUARD_LINE2);
+    auto elements = IO::Astrodynamics::Propagators::SGP4Elements::FromRecord(catalog.GetRecord(0));
+
+    ASSERT_EQ(expected.SatelliteNumber, elements.SatelliteNumber);
+    ASSERT_DOUBLE_EQ(expected.Epoch.GetSecondsFromJ2000().count(), elements.Epoch.GetSecondsFromJ2000().count());
+    ASSERT_DOUBLE_EQ(expected.BStar, elements.BStar);
+    ASSERT_DOUBLE_EQ(expected.Inclination, elements.Inclination);
+    ASSERT_DOUBLE_EQ(expected.RightAscendingNode, elements.RightAscendingNode);
+    ASSERT_DOUBLE_EQ(expected.Eccentricity, elements.Eccentricity);
+    ASSERT_DOUBLE_EQ(expected.PeriapsisArgument, elements.PeriapsisArgument);
+    ASSERT_DOUBLE_EQ(expected.MeanAnomaly, elements.MeanAnomaly);
+    ASSERT_DOUBLE_EQ(expected.MeanMotion, elements.MeanMotion);
+}
+
+TEST(TLECatalog, InvalidRecords)
+{
+    std::string corrupted = ISS_LINE2;
+    corrupted[10] = '7';
+    const std::string buffer = ISS_LINE1 + "\n" + corrupted + "\n" + VANGUARD_LINE1 + "\n" + VANGUARD_LINE2 + "\n" + ISS_LINE1 + "\n";
+
+    ASSERT_THROW(IO::Astrodynamics::OrbitalParameters::TLECatalog::Parse(buffer), IO::Astrodynamics::Exception::InvalidArgumentException);
+
+    auto catalog = IO::Astrodynamics::OrbitalParameters::TLECatalog::Parse(buffer, false);
+    ASSERT_EQ(1, catalog.GetSize());
+    ASSERT_EQ(2, catalog.GetRejectedCount());
+    ASSERT_EQ(5, catalog.GetRecord(0).SatelliteNumber);
+
+    //Line 2 without line 1
+    ASSERT_THROW(IO::Astrodynamics::OrbitalParameters::TLECatalog::Parse(ISS_LINE2), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
+
+TEST(TLECatalog, ReadStreamAndFile)
+{
+    const std::string content = "ISS\n" + ISS_LINE1 + "\n" + ISS_LINE2 + "\nVANGUARD 1\n" + VANGUARD_LINE1 + "\n" + VANGUARD_LINE2 + "\n";
+
+    std::istringstream stream(content);
+    auto fromStream = IO::Astrodynamics::OrbitalParameters::TLECatalog::Read(stream);
+    ASSERT_EQ(2, fromStream.GetSize());
+    ASSERT_EQ("VANGUARD 1", fromStream.GetName(1));
+
+    const std::string path = "TLECatalogTests.3le";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+    auto fromFile = IO::Astrodynamics::OrbitalParameters::TLECatalog::ReadFile(path);
+    std::remove(path.c_str());
+    ASSERT_EQ(2, fromFile.GetSize());
+    ASSERT_EQ("ISS", fromFile.GetName(0));
+    ASSERT_DOUBLE_EQ(fromStream.GetRecord(1).MeanMotion, fromFile.GetRecord(1).MeanMotion);
+
+    ASSERT_THROW(IO::Astrodynamics::OrbitalParameters::TLECatalog::ReadFile("missing.3le"), IO::Astrodynamics::Exception::SDKException);
+}
+
+TEST(TLECatalog, Propagators)
+{
+    auto catalog = IO::Astrodynamics::OrbitalParameters::TLECatalog::Parse(ISS_LINE1 + "\n" + ISS_LINE2 + "\n" + VANGUARD_LINE1 + "\n" + VANGUARD_LINE2);
+    IO::Astrodynamics::Propagators::SGP4 propagator(IO::Astrodynamics::Propagators::SGP4Elements::FromRecord(catalog.GetRecord(1)));
+    ASSERT_EQ(5, propagator.GetSatelliteNumber());
+    ASSERT_FALSE(propagator.IsDeepSpace());
+
+    IO::Astrodynamics::Propagators::SGP4CatalogPropagator catalogPropagator(catalog);
+    ASSERT_EQ(2, catalogPropagator.GetSize());
+
+    double expected[3], expectedVelocity[3], position[3], velocity[3];
+    ASSERT_EQ(IO::Astrodynamics::Propagators::SGP4::Status::Success, propagator.Propagate(360.0, expected, expectedVelocity));
+    ASSERT_EQ(IO::Astrodynamics::Propagators::SGP4::Status::Success, catalogPropagator.GetPropagator(1).Propagate(360.0, position, velocity));
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_DOUBLE_EQ(expected[i], position[i]);
+        ASSERT_DOUBLE_EQ(expectedVelocity[i], velocity[i]);
+    }
+}
@@ -191,7 +191,7 @@ TEST(TLE, GetTrueAnomaly)
 
 	double res = tle.GetTrueAnomaly();
 
-	ASSERT_DOUBLE_EQ(0.68485975437583080, res);
+	ASSERT_DOUBLE_EQ(0.68485975437587632, res);
 }
 
 TEST(TLE, GetTrueAnomalyAtEpoch)
@@ -242,4 +242,24 @@ TEST(TLE, GetStateVectorAtEpoch)
 	ASSERT_DOUBLE_EQ(2575.7226437161635, stateVector.GetVelocity().GetY());
 	ASSERT_DOUBLE_EQ(4271.5974622410786, stateVector.GetVelocity().GetZ());
 	ASSERT_EQ(epoch, stateVector.GetEpoch());
-}
\ No newline at end of file
+}
+
+TEST(TLE, CachedRepresentationsAtEpoch)
+{
+	const auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+	std::string lines[3]{"ISS", "1 25544U 98067A   21020.53488036  .00016717  00000-0  10270-3 0  9054", "2 25544  51.6423 353.0312 0000493 320.8755  39.2360 15.49309423 25703"};
+	IO::Astrodynamics::OrbitalParameters::TLE tle(earth, lines);
+
+	//State is propagated once and shared by getters
+	const auto &sv = tle.GetStateVectorAtEpoch();
+	ASSERT_EQ(&sv, &tle.GetStateVectorAtEpoch());
+	ASSERT_EQ(tle.ToStateVector(tle.GetEpoch()), sv);
+
+	const auto &conic = tle.GetConicOrbitalElementsAtEpoch();
+	ASSERT_EQ(&conic, &tle.GetConicOrbitalElementsAtEpoch());
+	ASSERT_DOUBLE_EQ(conic.GetEccentricity(), sv.GetEccentricity());
+
+	const auto node = tle.GetAscendingNodeVector();
+	ASSERT_EQ(node, tle.GetAscendingNodeVector());
+	ASSERT_EQ(node, sv.GetAscendingNodeVector());
+}
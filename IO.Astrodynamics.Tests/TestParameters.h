@@ -22,7 +22,6 @@ inline constexpr double NodeDetectionAccuraccy = 0.0017453;//0.1°
 inline constexpr double IntersectDetectionAccuraccy = 0.017453;//1.0°
 inline constexpr double CircularEccentricityAccuraccy = 1E-03;
 inline constexpr double ClockAccuracy = 16.0; //2^n
-inline const static IO::Astrodynamics::Time::TimeSpan SitePropagationStep(60s);
 inline const static IO::Astrodynamics::Time::TimeSpan SpacecraftPropagationStep(1s);
 
 #endif //IOSDKTESTS_PARAMETERS_H
@@ -0,0 +1,99 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <TopocentricFrame.h>
+#include <Constants.h>
+#include <cmath>
+
+TEST(TopocentricFrame, HorizontalCoordinates)
+{
+    IO::Astrodynamics::Sites::TopocentricFrame frame(IO::Astrodynamics::Coordinates::Planetodetic(0.0, 0.0, 0.0), 6378137.0, 0.0);
+    ASSERT_DOUBLE_EQ(6378137.0, frame.GetPosition()[0]);
+
+    double azimuth, elevation, range;
+
+    //Zenith
+    double zenith[3]{6378137.0 + 1000.0, 0.0, 0.0};
+    frame.GetHorizontalCoordinates(zenith, azimuth, elevation, range);
+    ASSERT_NEAR(IO::Astrodynamics::Constants::PI2, elevation, 1e-12);
+    ASSERT_NEAR(1000.0, range, 1e-9);
+
+    //North on the horizon
+    double north[3]{6378137.0, 0.0, 1000.0};
+    frame.GetHorizontalCoordinates(north, azimuth, elevation, range);
+    ASSERT_NEAR(0.0, azimuth, 1e-12);
+    ASSERT_NEAR(0.0, elevation, 1e-12);
+
+    //East on the horizon
+    double east[3]{6378137.0, 1000.0, 0.0};
+    frame.GetHorizontalCoordinates(east, azimuth, elevation, range);
+    ASSERT_NEAR(IO::Astrodynamics::Constants::PI2, azimuth, 1e-12);
+
+    //West, 45° above horizon
+    double west[3]{6378137.0 + 1000.0, -1000.0, 0.0};
+    frame.GetHorizontalCoordinates(west, azimuth, elevation, range);
+    ASSERT_NEAR(3.0 * IO::Astrodynamics::Constants::PI2, azimuth, 1e-12);
+    ASSERT_NEAR(IO::Astrodynamics::Constants::PI2 * 0.5, elevation, 1e-12);
+    ASSERT_NEAR(std::sqrt(2.0) * 0.5, frame.GetSinElevation(west), 1e-12);
+}
+
+TEST(TopocentricFrame, Axes)
+{
+    IO::Astrodynamics::Sites::TopocentricFrame frame(
+            IO::Astrodynamics::Coordinates::Planetodetic(30.0 * IO::Astrodynamics::Constants::DEG_RAD, 45.0 * IO::Astrodynamics::Constants::DEG_RAD, 0.0),
+            6378137.0, 1.0 / 298.257223563);
+    auto &e = frame.GetEast();
+    auto &n = frame.GetNorth();
+    auto &u = frame.GetUp();
+    ASSERT_NEAR(0.0, e[0] * n[0] + e[1] * n[1] + e[2] * n[2], 1e-15);
+    ASSERT_NEAR(0.0, e[0] * u[0] + e[1] * u[1] + e[2] * u[2], 1e-15);
+    ASSERT_NEAR(0.0, n[0] * u[0] + n[1] * u[1] + n[2] * u[2], 1e-15);
+
+    //East x North = Up
+    ASSERT_NEAR(u[0], e[1] * n[2] - e[2] * n[1], 1e-15);
+    ASSERT_NEAR(u[1], e[2] * n[0] - e[0] * n[2], 1e-15);
+    ASSERT_NEAR(u[2], e[0] * n[1] - e[1] * n[0], 1e-15);
+}
+
+TEST(TopocentricFrame, GetHorizontalStates)
+{
+    IO::Astrodynamics::Sites::TopocentricFrame frame(
+            IO::Astrodynamics::Coordinates::Planetodetic(0.3, 0.8, 0.0), 6378137.0, 0.0);
+
+    //Target with constant acceleration relative to the site
+    auto state = [](double t, double s[6])
+    {
+        const double p[3]{1E+06, -2E+06, 5E+05}, v[3]{3000.0, 4000.0, -1000.0}, a[3]{-2.0, 1.0, 3.0};
+        for (int k = 0; k < 3; ++k)
+        {
+            s[k] = p[k] + v[k] * t + 0.5 * a[k] * t * t;
+            s[k + 3] = v[k] + a[k] * t;
+        }
+    };
+
+    double s[6], before[6], after[6];
+    state(10.0, s);
+    state(10.0 - 1E-03, before);
+    state(10.0 + 1E-03, after);
+
+    double azimuth, elevation, range, azimuthRate, elevationRate, rangeRate;
+    double az0, el0, r0, az1, el1, r1, unused;
+    frame.GetHorizontalStates(s, azimuth, elevation, range, azimuthRate, elevationRate, rangeRate);
+    frame.GetHorizontalStates(before, az0, el0, r0, unused, unused, unused);
+    frame.GetHorizontalStates(after, az1, el1, r1, unused, unused, unused);
+
+    ASSERT_NEAR((az1 - az0) / 2E-03, azimuthRate, 1E-10);
+    ASSERT_NEAR((el1 - el0) / 2E-03, elevationRate, 1E-10);
+    ASSERT_NEAR((r1 - r0) / 2E-03, rangeRate, 1E-06);
+
+    //Same coordinates as absolute position overload
+    const auto &location = frame.GetPosition();
+    double position[3]{s[0] + location[0], s[1] + location[1], s[2] + location[2]};
+    double expectedAzimuth, expectedElevation, expectedRange;
+    frame.GetHorizontalCoordinates(position, expectedAzimuth, expectedElevation, expectedRange);
+    ASSERT_NEAR(expectedAzimuth, azimuth, 1E-12);
+    ASSERT_NEAR(expectedElevation, elevation, 1E-12);
+    ASSERT_NEAR(expectedRange, range, 1E-06);
+}
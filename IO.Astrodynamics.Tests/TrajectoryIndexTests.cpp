@@ -0,0 +1,318 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <map>
+#include <TrajectoryIndex.h>
+#include <Constants.h>
+#include <CelestialBody.h>
+#include <InertialFrames.h>
+#include <InvalidArgumentException.h>
+#include <TLECatalog.h>
+#include "TestParameters.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    constexpr double MU = 3.986004418E+14;
+    constexpr double EPOCH = 700000000.0;
+
+    //Circular orbit in the index frame
+    IO::Astrodynamics::Spatial::TrajectoryFunction CircularOrbit(double radius, double inclination, double node, double phase)
+    {
+        return [=](double epoch, double state[6])
+        {
+            const double n = std::sqrt(MU / (radius * radius * radius));
+            const double u = phase + n * (epoch - EPOCH);
+            const double p[3]{std::cos(node), std::sin(node), 0.0};
+            const double q[3]{-std::sin(node) * std::cos(inclination), std::cos(node) * std::cos(inclination), std::sin(inclination)};
+            for (int i = 0; i < 3; ++i)
+            {
+                state[i] = radius * (std::cos(u) * p[i] + std::sin(u) * q[i]);
+                state[i + 3] = radius * n * (-std::sin(u) * p[i] + std::cos(u) * q[i]);
+            }
+        };
+    }
+
+    std::vector<IO::Astrodynamics::Spatial::TrajectoryFunction> CreateConstellation(std::size_t count)
+    {
+        std::vector<IO::Astrodynamics::Spatial::TrajectoryFunction> trajectories;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            trajectories.push_back(CircularOrbit(6778000.0 + 5000.0 * static_cast<double>(i % 40), (30.0 + 0.7 * static_cast<double>(i)) * IO::Astrodynamics::Constants::DEG_RAD,
+                                                 0.37 * static_cast<double>(i), 0.91 * static_cast<double>(i)));
+        }
+        return trajectories;
+    }
+
+    IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> CreateWindow(double begin, double end)
+    {
+        return IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>(IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(begin)),
+                                                                            IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(end)));
+    }
+}
+
+TEST(TrajectoryIndex, FindInRange)
+{
+    auto trajectories = CreateConstellation(200);
+    IO::Astrodynamics::Spatial::TrajectoryIndex index;
+    for (std::size_t i = 0; i < trajectories.size(); ++i)
+    {
+        index.Add(static_cast<int>(i), CreateWindow(EPOCH, EPOCH + 10800.0), trajectories[i]);
+    }
+    ASSERT_EQ(200, index.GetObjectCount());
+    ASSERT_EQ(19, index.GetSlabCount());
+
+    const double point[3]{4000000.0, 3000000.0, 4500000.0};
+    const double radius = 500000.0;
+    auto results = index.FindInRange(point, radius, CreateWindow(EPOCH + 1000.0, EPOCH + 8000.0));
+    ASSERT_FALSE(results.empty());
+    ASSERT_TRUE(std::is_sorted(results.begin(), results.end(), [](const auto &a, const auto &b) { return a.Distance < b.Distance; }));
+
+    //Brute force closest approaches
+    std::map<int, double> expected;
+    double state[6];
+    for (std::size_t i = 0; i < trajectories.size(); ++i)
+    {
+        double minimum = std::numeric_limits<double>::max();
+        for (double t = EPOCH + 1000.0; t <= EPOCH + 8000.0; t += 0.5)
+        {
+            trajectories[i](t, state);
+            minimum = std::min(minimum, std::sqrt((state[0] - point[0]) * (state[0] - point[0]) + (state[1] - point[1]) * (state[1] - point[1]) +
+                                                  (state[2] - point[2]) * (state[2] - point[2])));
+        }
+        if (minimum <= radius - 1000.0)
+        {
+            expected[static_cast<int>(i)] = minimum;
+        }
+    }
+
+    std::size_t matched{};
+    for (const auto &result: results)
+    {
+        ASSERT_LE(result.Distance, radius);
+        ASSERT_GE(result.Epoch.GetSecondsFromJ2000().count(), EPOCH + 1000.0);
+        ASSERT_LE(result.Epoch.GetSecondsFromJ2000().count(), EPOCH + 8000.0);
+        trajectories[result.ObjectId](result.Epoch.GetSecondsFromJ2000().count(), state);
+        ASSERT_NEAR(result.Distance, std::sqrt((state[0] - point[0]) * (state[0] - point[0]) + (state[1] - point[1]) * (state[1] - point[1]) +
+                                               (state[2] - point[2]) * (state[2] - point[2])), 1E-06);
+        auto found = expected.find(result.ObjectId);
+        if (found != expected.end())
+        {
+            ASSERT_LE(result.Distance, found->second + 1E-03);
+            ASSERT_NEAR(found->second, result.Distance, 50.0);
+            ++matched;
+        }
+    }
+    ASSERT_EQ(expected.size(), matched);
+}
+
+TEST(TrajectoryIndex, FindNearest)
+{
+    auto trajectories = CreateConstellation(200);
+    IO::Astrodynamics::Spatial::TrajectoryIndex index(IO::Astrodynamics::Time::TimeSpan(900.0s));
+    for (std::size_t i = 0; i < trajectories.size(); ++i)
+    {
+        index.Add(static_cast<int>(i) + 1000, CreateWindow(EPOCH, EPOCH + 7200.0), trajectories[i]);
+    }
+
+    const double point[3]{-2000000.0, 6000000.0, 1000000.0};
+    const double epoch = EPOCH + 3333.0;
+    auto results = index.FindNearest(point, IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(epoch)), 5);
+    ASSERT_EQ(5, results.size());
+
+    std::vector<std::pair<double, int>> expected;
+    double state[6];
+    for (std::size_t i = 0; i < trajectories.size(); ++i)
+    {
+        trajectories[i](epoch, state);
+        expected.emplace_back(std::sqrt((state[0] - point[0]) * (state[0] - point[0]) + (state[1] - point[1]) * (state[1] - point[1]) +
+                                        (state[2] - point[2]) * (state[2] - point[2])), static_cast<int>(i) + 1000);
+    }
+    std::sort(expected.begin(), expected.end());
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        ASSERT_EQ(expected[i].second, results[i].ObjectId);
+        ASSERT_NEAR(expected[i].first, results[i].Distance, 1E-06);
+    }
+
+    //Outside coverage
+    ASSERT_TRUE(index.FindNearest(point, IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(EPOCH + 10000.0)), 5).empty());
+}
+
+TEST(TrajectoryIndex, FindOverflights)
+{
+    auto trajectories = CreateConstellation(100);
+    IO::Astrodynamics::Spatial::TrajectoryIndex index;
+    for (std::size_t i = 0; i < trajectories.size(); ++i)
+    {
+        index.Add(static_cast<int>(i), CreateWindow(EPOCH, EPOCH + 7200.0), trajectories[i]);
+    }
+
+    const double direction[3]{1.0, 1.0, 1.0};
+    const double halfAngle = 10.0 * IO::Astrodynamics::Constants::DEG_RAD;
+    auto results = index.FindOverflights(direction, halfAngle, CreateWindow(EPOCH, EPOCH + 7200.0));
+    ASSERT_FALSE(results.empty());
+
+    //Time spent in the region by object, compared with a brute force sampling
+    std::map<int, double> durations;
+    for (const auto &result: results)
+    {
+        ASSERT_LT(result.Begin, result.End);
+        durations[result.ObjectId] += (result.End - result.Begin).GetSeconds().count();
+    }
+    const double cosHalfAngle = std::cos(halfAngle);
+    double state[6];
+    for (std::size_t i = 0; i < trajectories.size(); ++i)
+    {
+        double inside{};
+        for (double t = EPOCH + 0.5; t < EPOCH + 7200.0; t += 1.0)
+        {
+            trajectories[i](t, state);
+            const double norm = std::sqrt(state[0] * state[0] + state[1] * state[1] + state[2] * state[2]);
+            if ((state[0] + state[1] + state[2]) / (norm * std::sqrt(3.0)) >= cosHalfAngle)
+            {
+                inside += 1.0;
+            }
+        }
+        ASSERT_NEAR(inside, durations[static_cast<int>(i)], 2.0);
+    }
+}
+
+TEST(TrajectoryIndex, IncrementalUpdate)
+{
+    IO::Astrodynamics::Spatial::TrajectoryIndex index;
+    auto trajectory = CircularOrbit(7000000.0, 0.5, 0.0, 0.0);
+    index.Add(-10, CreateWindow(EPOCH, EPOCH + 3000.0), trajectory);
+    ASSERT_EQ(6, index.GetSlabCount());
+
+    double state[6];
+    trajectory(EPOCH + 5000.0, state);
+    const double point[3]{state[0], state[1], state[2]};
+    auto window = CreateWindow(EPOCH + 4000.0, EPOCH + 6000.0);
+    ASSERT_TRUE(index.FindInRange(point, 1000.0, window).empty());
+
+    //New segment
+    index.Add(-10, CreateWindow(EPOCH + 3000.0, EPOCH + 7200.0), trajectory);
+    ASSERT_EQ(1, index.GetObjectCount());
+    ASSERT_EQ(13, index.GetSlabCount());
+    auto results = index.FindInRange(point, 1000.0, window);
+    ASSERT_EQ(1, results.size());
+    ASSERT_EQ(-10, results.front().ObjectId);
+    ASSERT_NEAR(EPOCH + 5000.0, results.front().Epoch.GetSecondsFromJ2000().count(), 1E-02);
+    ASSERT_NEAR(0.0, results.front().Distance, 1.0);
+
+    ASSERT_TRUE(index.Remove(-10));
+    ASSERT_FALSE(index.Remove(-10));
+    ASSERT_EQ(0, index.GetObjectCount());
+    ASSERT_EQ(0, index.GetSlabCount());
+    ASSERT_TRUE(index.FindInRange(point, 1000.0, window).empty());
+}
+
+TEST(TrajectoryIndex, IncrementalSampling)
+{
+    //Slabs already bounded aren't sampled again when the coverage is extended
+    std::size_t evaluations{};
+    auto orbit = CircularOrbit(7000000.0, 0.5, 0.0, 0.0);
+    auto trajectory = [&](double epoch, double state[6])
+    {
+        ++evaluations;
+        orbit(epoch, state);
+    };
+    IO::Astrodynamics::Spatial::TrajectoryIndex index;
+    index.Add(3, CreateWindow(EPOCH, EPOCH + 3000.0), trajectory);
+    ASSERT_EQ(6 * 9, evaluations);
+
+    evaluations = 0;
+    index.Add(3, CreateWindow(EPOCH, EPOCH + 3000.0), trajectory);
+    ASSERT_EQ(0, evaluations);
+
+    //Slab holding the previous coverage end is bounded again with both parts
+    evaluations = 0;
+    index.Add(3, CreateWindow(EPOCH, EPOCH + 6000.0), trajectory);
+    ASSERT_EQ(6 * 9, evaluations);
+    ASSERT_EQ(11, index.GetSlabCount());
+
+    //Only the gap between two intervals is sampled
+    index.Add(3, CreateWindow(EPOCH + 9000.0, EPOCH + 9600.0), trajectory);
+    evaluations = 0;
+    index.Add(3, CreateWindow(EPOCH, EPOCH + 9600.0), trajectory);
+    ASSERT_EQ(6 * 9, evaluations);
+    ASSERT_EQ(17, index.GetSlabCount());
+
+    double state[6];
+    orbit(EPOCH + 7500.0, state);
+    const double point[3]{state[0], state[1], state[2]};
+    auto results = index.FindInRange(point, 1000.0, CreateWindow(EPOCH + 7000.0, EPOCH + 8000.0));
+    ASSERT_EQ(1, results.size());
+    ASSERT_NEAR(EPOCH + 7500.0, results.front().Epoch.GetSecondsFromJ2000().count(), 1E-02);
+}
+
+TEST(TrajectoryIndex, EphemerisKernel)
+{
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399);
+    auto catalog = IO::Astrodynamics::OrbitalParameters::TLECatalog::Parse("1 25544U 98067A   21020.53488036  .00016717  00000-0  10270-3 0  9054\n"
+                                                                           "2 25544  51.6423 353.0312 0000493 320.8755  39.2360 15.49309423 25703");
+    std::filesystem::create_directories(SpacecraftPath);
+    IO::Astrodynamics::Kernels::EphemerisKernel kernel(std::string(SpacecraftPath) + "/TrajectoryIndexTLE.spk", -225544);
+    const double begin = 664419000.0;
+    kernel.WriteTwoLineElements({catalog.GetRecord(0)}, CreateWindow(begin, begin + 21600.0));
+
+    auto windows = kernel.GetCoverageWindows();
+    ASSERT_EQ(1, windows.size());
+    ASSERT_DOUBLE_EQ(begin, windows.front().GetStartDate().GetSecondsFromJ2000().count());
+    ASSERT_DOUBLE_EQ(begin + 21600.0, windows.front().GetEndDate().GetSecondsFromJ2000().count());
+
+    IO::Astrodynamics::Spatial::TrajectoryIndex index;
+    index.Add(kernel, 399, IO::Astrodynamics::Frames::InertialFrames::ICRF());
+    ASSERT_EQ(1, index.GetObjectCount());
+    ASSERT_EQ(36, index.GetSlabCount());
+
+    //Index positions match the kernel
+    auto AssertFound = [&](double epoch)
+    {
+        auto state = kernel.ReadStateVector(*earth, IO::Astrodynamics::Frames::InertialFrames::ICRF(), IO::Astrodynamics::AberrationsEnum::None,
+                                            IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(epoch)));
+        const double point[3]{state.GetPosition().GetX(), state.GetPosition().GetY(), state.GetPosition().GetZ()};
+        auto nearest = index.FindNearest(point, IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(epoch)), 1);
+        ASSERT_EQ(1, nearest.size());
+        ASSERT_EQ(-225544, nearest.front().ObjectId);
+        ASSERT_NEAR(0.0, nearest.front().Distance, 1E-06);
+
+        auto results = index.FindInRange(point, 1000.0, CreateWindow(epoch - 600.0, epoch + 600.0));
+        ASSERT_EQ(1, results.size());
+        ASSERT_NEAR(epoch, results.front().Epoch.GetSecondsFromJ2000().count(), 1E-02);
+        ASSERT_NEAR(0.0, results.front().Distance, 1.0);
+    };
+    AssertFound(begin + 10000.0);
+
+    //Longer coverage written again extends the index
+    kernel.WriteTwoLineElements({catalog.GetRecord(0)}, CreateWindow(begin, begin + 43200.0));
+    index.Add(kernel, 399, IO::Astrodynamics::Frames::InertialFrames::ICRF());
+    ASSERT_EQ(1, index.GetObjectCount());
+    ASSERT_EQ(72, index.GetSlabCount());
+    AssertFound(begin + 10000.0);
+    AssertFound(begin + 30000.0);
+
+    const double point[3]{0.0, 0.0, 0.0};
+    ASSERT_TRUE(index.FindNearest(point, IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(begin + 50000.0)), 1).empty());
+}
+
+TEST(TrajectoryIndex, InvalidArguments)
+{
+    ASSERT_THROW(IO::Astrodynamics::Spatial::TrajectoryIndex(IO::Astrodynamics::Time::TimeSpan(0.0s)), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(IO::Astrodynamics::Spatial::TrajectoryIndex(IO::Astrodynamics::Time::TimeSpan(60.0s), 1), IO::Astrodynamics::Exception::InvalidArgumentException);
+
+    IO::Astrodynamics::Spatial::TrajectoryIndex index;
+    ASSERT_THROW(index.Add(1, CreateWindow(EPOCH, EPOCH), CircularOrbit(7000000.0, 0.0, 0.0, 0.0)), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(index.Add(1, CreateWindow(EPOCH, EPOCH + 10.0), nullptr), IO::Astrodynamics::Exception::InvalidArgumentException);
+
+    const double point[3]{0.0, 0.0, 0.0};
+    ASSERT_THROW((void) index.FindInRange(point, 0.0, CreateWindow(EPOCH, EPOCH + 10.0)), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW((void) index.FindOverflights(point, 0.1, CreateWindow(EPOCH, EPOCH + 10.0)), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
@@ -0,0 +1,75 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <TwilightTableGenerator.h>
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+
+TEST(TwilightTableGenerator, Generate)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    std::vector<IO::Astrodynamics::Coordinates::Planetodetic> sites{
+            IO::Astrodynamics::Coordinates::Planetodetic(2.2 * IO::Astrodynamics::Constants::DEG_RAD, 48.0 * IO::Astrodynamics::Constants::DEG_RAD, 0.0)};
+    IO::Astrodynamics::Sites::TwilightTableGenerator generator(earth, sites);
+
+    auto table = generator.Generate(IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>(IO::Astrodynamics::Time::TDB("2021-05-17 12:00:00 TDB"),
+                                                                                                 IO::Astrodynamics::Time::TDB("2021-05-18 12:00:00 TDB")),
+                                    {IO::Astrodynamics::Constants::OfficialTwilight, IO::Astrodynamics::Constants::CivilTwilight,
+                                     IO::Astrodynamics::Constants::NauticalTwilight, IO::Astrodynamics::Constants::AstronomicalTwilight});
+
+    ASSERT_EQ(1, table.SiteCount);
+    ASSERT_EQ(4, table.ThresholdCount);
+
+    //Same events as Site::FindDayWindows
+    auto &windows = table.GetWindows(0, 0);
+    ASSERT_EQ(2, windows.size());
+    ASSERT_EQ(IO::Astrodynamics::Time::TDB("2021-05-17 12:00:00 TDB"), windows[0].GetStartDate());
+    ASSERT_NEAR(IO::Astrodynamics::Time::TDB("2021-05-17 19:34:15.723623 UTC").GetSecondsFromJ2000().count(),
+                windows[0].GetEndDate().GetSecondsFromJ2000().count(), 1.0);
+    ASSERT_NEAR(IO::Astrodynamics::Time::TDB("2021-05-18 04:17:23.258548 UTC").GetSecondsFromJ2000().count(),
+                windows[1].GetStartDate().GetSecondsFromJ2000().count(), 1.0);
+    ASSERT_EQ(IO::Astrodynamics::Time::TDB("2021-05-18 12:00:00 TDB"), windows[1].GetEndDate());
+
+    //Deeper twilights end later and begin earlier
+    for (std::size_t k = 1; k < 3; ++k)
+    {
+        ASSERT_EQ(2, table.GetWindows(0, k).size());
+        ASSERT_GT(table.GetWindows(0, k)[0].GetEndDate(), table.GetWindows(0, k - 1)[0].GetEndDate());
+        ASSERT_LT(table.GetWindows(0, k)[1].GetStartDate(), table.GetWindows(0, k - 1)[1].GetStartDate());
+    }
+
+    //No astronomical night at 48° north in may
+    ASSERT_EQ(1, table.GetWindows(0, 3).size());
+}
+
+TEST(TwilightTableGenerator, PolarDayAndNight)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    std::vector<IO::Astrodynamics::Coordinates::Planetodetic> sites{
+            IO::Astrodynamics::Coordinates::Planetodetic(0.0, 80.0 * IO::Astrodynamics::Constants::DEG_RAD, 0.0),
+            IO::Astrodynamics::Coordinates::Planetodetic(0.0, -80.0 * IO::Astrodynamics::Constants::DEG_RAD, 0.0)};
+    IO::Astrodynamics::Sites::TwilightTableGenerator generator(earth, sites);
+
+    IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> window(IO::Astrodynamics::Time::TDB("2021-06-20 00:00:00 TDB"),
+                                                                          IO::Astrodynamics::Time::TDB("2021-06-23 00:00:00 TDB"));
+    auto table = generator.Generate(window, {IO::Astrodynamics::Constants::OfficialTwilight});
+
+    ASSERT_EQ(1, table.GetWindows(0, 0).size());
+    ASSERT_EQ(window, table.GetWindows(0, 0)[0]);
+    ASSERT_EQ(0, table.GetWindows(1, 0).size());
+}
+
+TEST(TwilightTableGenerator, InvalidArguments)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    IO::Astrodynamics::Sites::TwilightTableGenerator generator(earth, {IO::Astrodynamics::Coordinates::Planetodetic(0.0, 0.0, 0.0)});
+    IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> window(IO::Astrodynamics::Time::TDB("2021-06-20 00:00:00 TDB"),
+                                                                          IO::Astrodynamics::Time::TDB("2021-06-23 00:00:00 TDB"));
+    ASSERT_THROW(auto table = generator.Generate(window, {}), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(IO::Astrodynamics::Sites::TwilightTableGenerator(nullptr, {}), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
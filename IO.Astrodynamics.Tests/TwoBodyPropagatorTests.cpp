@@ -0,0 +1,180 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <TwoBodyPropagator.h>
+#include "Orbits.h"
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+#include <SpiceUsr.h>
+
+using IO::Astrodynamics::Propagators::TwoBodyPropagator;
+using IO::Astrodynamics::Tests::Norm;
+using IO::Astrodynamics::Tests::ToState;
+
+namespace
+{
+    constexpr double MU = 3.986004418E+14;
+}
+
+TEST(TwoBodyPropagator, CompareWithKeplerianElements)
+{
+    //Elliptic, near parabolic and hyperbolic orbits
+    const std::vector<std::vector<double>> orbits{
+            {7000000.0,   0.0,      0.9, 1.2, 0.0, 0.3},
+            {26000000.0,  0.7,      1.1, 0.5, 2.5, 4.0},
+            {1.0E+09,     0.993,    0.3, 2.0, 1.0, 0.0},
+            {-7.0E+09,    1.001,    2.0, 1.0, 3.0, 0.0},
+            {-20000000.0, 1.35,     0.4, 1.0, 2.0, -1.5}
+    };
+    for (const auto &orbit: orbits)
+    {
+        const auto initial = ToState(orbit, MU);
+        const TwoBodyPropagator propagator(MU, initial.data(), initial.data() + 3);
+        const double n = std::sqrt(MU / std::abs(orbit[0] * orbit[0] * orbit[0]));
+        for (double t: {-50000.0, -3600.0, -1.0, 0.0, 10.0, 2000.0, 86400.0, 864000.0})
+        {
+            auto propagated = orbit;
+            propagated[5] += n * t;
+            const auto expected = ToState(propagated, MU);
+
+            double position[3], velocity[3];
+            propagator.Propagate(t, position, velocity);
+            const double radius = Norm(expected.data());
+            const double speed = Norm(expected.data() + 3);
+            for (int i = 0; i < 3; ++i)
+            {
+                ASSERT_NEAR(expected[i], position[i], radius * 1E-09);
+                ASSERT_NEAR(expected[i + 3], velocity[i], speed * 1E-09);
+            }
+        }
+    }
+}
+
+TEST(TwoBodyPropagator, Invariants)
+{
+    const double position[3]{-6045000.0, -3490000.0, 2500000.0};
+    const double velocity[3]{-3457.0, 6618.0, 2533.0};
+    const TwoBodyPropagator propagator(MU, position, velocity);
+    ASSERT_GT(propagator.GetPeriod(), 0.0);
+
+    const double energy = 0.5 * Norm(velocity) * Norm(velocity) - MU / Norm(position);
+    ASSERT_NEAR(-MU / (2.0 * energy), propagator.GetSemiMajorAxis(), 1E-06);
+
+    //One period brings the state back
+    double p[3], v[3];
+    propagator.Propagate(propagator.GetPeriod() * 3.0, p, v);
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_NEAR(position[i], p[i], 1E-05);
+        ASSERT_NEAR(velocity[i], v[i], 1E-08);
+    }
+
+    //Energy and angular momentum
+    propagator.Propagate(12345.0, p, v);
+    ASSERT_NEAR(energy, 0.5 * Norm(v) * Norm(v) - MU / Norm(p), std::abs(energy) * 1E-12);
+    const double h0[3]{position[1] * velocity[2] - position[2] * velocity[1], position[2] * velocity[0] - position[0] * velocity[2],
+                       position[0] * velocity[1] - position[1] * velocity[0]};
+    const double h[3]{p[1] * v[2] - p[2] * v[1], p[2] * v[0] - p[0] * v[2], p[0] * v[1] - p[1] * v[0]};
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_NEAR(h0[i], h[i], Norm(h0) * 1E-12);
+    }
+}
+
+TEST(TwoBodyPropagator, ManyEpochs)
+{
+    const double position[3]{7000000.0, 0.0, 0.0};
+    const double velocity[3]{0.0, 8500.0, 1200.0};
+    const TwoBodyPropagator propagator(MU, position, velocity);
+
+    std::vector<double> times;
+    for (int i = 0; i < 2000; ++i)
+    {
+        times.push_back(-3000.0 + 17.3 * i);
+    }
+    //Unsorted epochs
+    times.push_back(5.0);
+    times.push_back(100000.0);
+    std::vector<double> positions(3 * times.size()), velocities(3 * times.size());
+    propagator.Propagate(times.size(), times.data(), positions.data(), velocities.data());
+
+    for (std::size_t i = 0; i < times.size(); ++i)
+    {
+        double p[3], v[3];
+        propagator.Propagate(times[i], p, v);
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            ASSERT_NEAR(p[j], positions[3 * i + j], 1E-06);
+            ASSERT_NEAR(v[j], velocities[3 * i + j], 1E-09);
+        }
+    }
+}
+
+TEST(TwoBodyPropagator, ManyStates)
+{
+    std::vector<double> states;
+    for (int i = 0; i < 50; ++i)
+    {
+        const auto state = ToState({7000000.0 + 100000.0 * i, 0.01 * i, 0.05 * i, 0.1 * i, 0.2 * i, 0.3 * i}, MU);
+        states.insert(states.end(), state.begin(), state.end());
+    }
+    std::vector<double> propagated(states.size());
+    TwoBodyPropagator::Propagate(50, MU, states.data(), 3600.0, propagated.data());
+
+    for (int i = 0; i < 50; ++i)
+    {
+        const TwoBodyPropagator propagator(MU, states.data() + 6 * i, states.data() + 6 * i + 3);
+        double p[3], v[3];
+        propagator.Propagate(3600.0, p, v);
+        for (int j = 0; j < 3; ++j)
+        {
+            ASSERT_DOUBLE_EQ(p[j], propagated[6 * i + j]);
+            ASSERT_DOUBLE_EQ(v[j], propagated[6 * i + j + 3]);
+        }
+    }
+
+    //In place
+    TwoBodyPropagator::Propagate(50, MU, states.data(), 3600.0, states.data());
+    ASSERT_EQ(propagated, states);
+}
+
+TEST(TwoBodyPropagator, CompareWithProp2b)
+{
+    //Elliptic, near parabolic and hyperbolic states away from periapsis
+    const std::vector<std::vector<double>> orbits{
+            {7000000.0,   0.01,     0.9, 1.2, 0.5, 2.3},
+            {26000000.0,  0.7,      1.1, 0.5, 2.5, 4.0},
+            {7.0E+11,     0.99999,  0.3, 0.2, 0.1, 1E-06},
+            {-20000000.0, 1.4,      2.0, 4.0, 1.0, -0.5}
+    };
+    for (const auto &orbit: orbits)
+    {
+        const auto state = ToState(orbit, MU);
+        const TwoBodyPropagator propagator(MU, state.data(), state.data() + 3);
+        for (double t: {-86400.0, -600.0, 1.0, 3000.0, 200000.0})
+        {
+            double expected[6];
+            prop2b_c(MU, state.data(), t, expected);
+            double position[3], velocity[3];
+            propagator.Propagate(t, position, velocity);
+            for (int i = 0; i < 3; ++i)
+            {
+                ASSERT_NEAR(expected[i], position[i], 1E-09 * Norm(expected));
+                ASSERT_NEAR(expected[i + 3], velocity[i], 1E-09 * Norm(expected + 3));
+            }
+        }
+    }
+}
+
+TEST(TwoBodyPropagator, InvalidArguments)
+{
+    const double position[3]{7000000.0, 0.0, 0.0};
+    const double velocity[3]{0.0, 7500.0, 0.0};
+    const double origin[3]{0.0, 0.0, 0.0};
+    ASSERT_THROW(TwoBodyPropagator(0.0, position, velocity), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(TwoBodyPropagator(MU, origin, velocity), IO::Astrodynamics::Exception::InvalidArgumentException);
+}
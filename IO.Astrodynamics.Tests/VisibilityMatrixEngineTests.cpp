@@ -0,0 +1,76 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <gtest/gtest.h>
+#include <VisibilityMatrixEngine.h>
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+
+TEST(VisibilityMatrixEngine, Compute)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+
+    //Same location as DSS-13 and its antipode
+    std::vector<IO::Astrodynamics::Coordinates::Planetodetic> sites{
+        IO::Astrodynamics::Coordinates::Planetodetic(-116.7944627147624 * IO::Astrodynamics::Constants::DEG_RAD, 35.2471635434595 * IO::Astrodynamics::Constants::DEG_RAD,
+                                                     1070.0),
+        IO::Astrodynamics::Coordinates::Planetodetic(63.2055372852376 * IO::Astrodynamics::Constants::DEG_RAD, -35.2471635434595 * IO::Astrodynamics::Constants::DEG_RAD,
+                                                     0.0)};
+
+    IO::Astrodynamics::Sites::VisibilityMatrixEngine engine(earth, sites);
+    ASSERT_EQ(2, engine.GetSiteCount());
+
+    auto matrix = engine.Compute(IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>(IO::Astrodynamics::Time::TDB("2023-02-19 00:00:00 TDB"),
+                                                                                               IO::Astrodynamics::Time::TDB("2023-02-20 00:00:00 TDB")), {301});
+    ASSERT_EQ(2, matrix.SiteCount);
+    ASSERT_EQ(1, matrix.TargetCount);
+    ASSERT_EQ(2, matrix.Entries.size());
+
+    //Same result as Site::FindBodyVisibilityWindows
+    auto windows = matrix.GetWindows(0, 0);
+    ASSERT_EQ(1, windows.size());
+    ASSERT_NEAR(IO::Astrodynamics::Time::TDB("2023-02-19 14:33:08.921173 TDB").GetSecondsFromJ2000().count(), windows[0].GetStartDate().GetSecondsFromJ2000().count(), 1.0);
+    ASSERT_EQ(IO::Astrodynamics::Time::TDB("2023-02-20 00:00:00 TDB"), windows[0].GetEndDate());
+
+    //Antipode sees the moon when DSS-13 doesn't
+    auto antipodeWindows = matrix.GetWindows(1, 0);
+    ASSERT_FALSE(antipodeWindows.empty());
+    ASSERT_EQ(IO::Astrodynamics::Time::TDB("2023-02-19 00:00:00 TDB"), antipodeWindows[0].GetStartDate());
+    ASSERT_GT(windows[0].GetStartDate(), antipodeWindows[0].GetEndDate());
+}
+
+TEST(VisibilityMatrixEngine, ElevationMask)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    std::vector<IO::Astrodynamics::Coordinates::Planetodetic> sites{
+        IO::Astrodynamics::Coordinates::Planetodetic(-116.7944627147624 * IO::Astrodynamics::Constants::DEG_RAD, 35.2471635434595 * IO::Astrodynamics::Constants::DEG_RAD,
+                                                     1070.0)};
+    IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> searchWindow(IO::Astrodynamics::Time::TDB("2023-02-19 00:00:00 TDB"),
+                                                                               IO::Astrodynamics::Time::TDB("2023-02-20 00:00:00 TDB"));
+
+    auto horizon = IO::Astrodynamics::Sites::VisibilityMatrixEngine(earth, sites).Compute(searchWindow, {301});
+    auto masked = IO::Astrodynamics::Sites::VisibilityMatrixEngine(earth, sites, {IO::Astrodynamics::Sites::ElevationMask(10.0 * IO::Astrodynamics::Constants::DEG_RAD)})
+            .Compute(searchWindow, {301});
+
+    ASSERT_EQ(1, masked.GetWindows(0, 0).size());
+    ASSERT_GT(masked.GetWindows(0, 0)[0].GetStartDate(), horizon.GetWindows(0, 0)[0].GetStartDate());
+
+    //Mask higher than the moon culmination
+    auto hidden = IO::Astrodynamics::Sites::VisibilityMatrixEngine(earth, sites, {IO::Astrodynamics::Sites::ElevationMask(89.0 * IO::Astrodynamics::Constants::DEG_RAD)})
+            .Compute(searchWindow, {301});
+    ASSERT_TRUE(hidden.Entries.empty());
+    ASSERT_TRUE(hidden.GetWindows(0, 0).empty());
+}
+
+TEST(VisibilityMatrixEngine, InvalidArguments)
+{
+    auto sun = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(10);
+    auto earth = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(399, sun);
+    std::vector<IO::Astrodynamics::Coordinates::Planetodetic> sites{IO::Astrodynamics::Coordinates::Planetodetic(0.0, 0.0, 0.0)};
+    ASSERT_THROW(IO::Astrodynamics::Sites::VisibilityMatrixEngine(nullptr, sites), IO::Astrodynamics::Exception::InvalidArgumentException);
+    ASSERT_THROW(IO::Astrodynamics::Sites::VisibilityMatrixEngine(earth, sites, {IO::Astrodynamics::Sites::ElevationMask(), IO::Astrodynamics::Sites::ElevationMask()}),
+                 IO::Astrodynamics::Exception::InvalidArgumentException);
+}
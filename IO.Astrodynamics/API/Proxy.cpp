@@ -13,6 +13,15 @@
 #include <KernelsLoader.h>
 #include <TLE.h>
 #include <EquinoctialElements.h>
+#include <ElementsConverter.h>
+#include <TwoBodyPropagator.h>
+#include <PorkchopGrid.h>
+#include <NumericalPropagator.h>
+#include <EnsemblePropagator.h>
+#include <PointMassGravity.h>
+#include <ZonalHarmonicsGravity.h>
+#include <ThirdBodyGravity.h>
+#include <GeopotentialGravity.h>
 #include <SDKException.h>
 #include "InvalidArgumentException.h"
 #include "OrientationKernel.h"
@@ -781,6 +790,358 @@ IO::Astrodynamics::API::DTO::TLEElementsDTO GetTLEElementsProxy(const char *L1,
     return tleElementsDto;
 }
 
+bool GetHorizontalCoordinatesBatchProxy(IO::Astrodynamics::API::DTO::SiteDTO site, const int *targetIds, int targetCount,
+                                        const double *epochs, int epochCount, const char *aberration, bool refraction,
+                                        double *azimuth, double *elevation, double *range, double *azimuthRate,
+                                        double *elevationRate, double *rangeRate)
+{
+    try
+    {
+        ActivateErrorManagement();
+        if (targetCount < 0 || epochCount < 0)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Target count and epoch count must be positive");
+        }
+        //Site frame and ephemeris kernels are not needed, the location is used directly
+        IO::Astrodynamics::Body::CelestialBody body(site.bodyId);
+        IO::Astrodynamics::Sites::TopocentricFrame topocentricFrame(ToPlanetodetic(site.coordinates), body.GetRadius().GetX(), body.GetFlattening());
+        IO::Astrodynamics::Sites::Site::GetHorizontalCoordinates(body, topocentricFrame, targetIds, static_cast<std::size_t>(targetCount), epochs,
+                                                                 static_cast<std::size_t>(epochCount), IO::Astrodynamics::Aberrations::ToEnum(aberration),
+                                                                 refraction, azimuth, elevation, range, azimuthRate, elevationRate, rangeRate);
+        if (failed_c())
+        {
+            std::strncpy(lastError, HandleError(), sizeof(lastError) - 1);
+            lastError[sizeof(lastError) - 1] = '\0';
+            return false;
+        }
+        return true;
+    }
+    catch (const std::exception &e)
+    {
+        std::strncpy(lastError, e.what(), sizeof(lastError) - 1);
+        lastError[sizeof(lastError) - 1] = '\0';
+        return false;
+    }
+}
+
+bool WriteTwoLineElementsEphemerisProxy(const char *filePath, const char *tleFilePath, IO::Astrodynamics::API::DTO::WindowDTO window,
+                                        int *segmentCount)
+{
+    try
+    {
+        ActivateErrorManagement();
+        auto catalog = IO::Astrodynamics::OrbitalParameters::TLECatalog::ReadFile(tleFilePath);
+        *segmentCount = static_cast<int>(IO::Astrodynamics::Kernels::EphemerisKernel::WriteTwoLineElementsCatalog(filePath, catalog, ToTDBWindow(window)));
+        if (failed_c())
+        {
+            std::strncpy(lastError, HandleError(), sizeof(lastError) - 1);
+            lastError[sizeof(lastError) - 1] = '\0';
+            return false;
+        }
+        return true;
+    }
+    catch (const std::exception &e)
+    {
+        std::strncpy(lastError, e.what(), sizeof(lastError) - 1);
+        lastError[sizeof(lastError) - 1] = '\0';
+        return false;
+    }
+}
+
+bool ConvertOrbitalElementsProxy(int inputType, int outputType, double mu, int count, const double *input, double *output)
+{
+    try
+    {
+        if (inputType < 0 || inputType > 3 || outputType < 0 || outputType > 3)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Unknown orbital elements type");
+        }
+        if (count < 0)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Objects count can't be negative");
+        }
+        IO::Astrodynamics::OrbitalParameters::ElementsConverter::Convert(static_cast<IO::Astrodynamics::OrbitalParameters::ElementsType>(inputType),
+                                                                         static_cast<IO::Astrodynamics::OrbitalParameters::ElementsType>(outputType),
+                                                                         static_cast<std::size_t>(count), mu, input, output);
+        return true;
+    }
+    catch (const std::exception &e)
+    {
+        std::strncpy(lastError, e.what(), sizeof(lastError) - 1);
+        lastError[sizeof(lastError) - 1] = '\0';
+        return false;
+    }
+}
+
+bool Propagate2BodiesBatchProxy(IO::Astrodynamics::API::DTO::StateVectorDTO stateVector, double mu, const double *epochs, int epochCount,
+                                double *positions, double *velocities)
+{
+    try
+    {
+        if (epochCount < 0)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Epochs count can't be negative");
+        }
+        const double position[3]{stateVector.position.x, stateVector.position.y, stateVector.position.z};
+        const double velocity[3]{stateVector.velocity.x, stateVector.velocity.y, stateVector.velocity.z};
+        IO::Astrodynamics::Propagators::TwoBodyPropagator propagator(mu, position, velocity);
+        std::vector<double> elapsedTimes(epochCount);
+        for (int i = 0; i < epochCount; ++i)
+        {
+            elapsedTimes[i] = epochs[i] - stateVector.epoch;
+        }
+        propagator.Propagate(elapsedTimes.size(), elapsedTimes.data(), positions, velocities);
+        return true;
+    }
+    catch (const std::exception &e)
+    {
+        std::strncpy(lastError, e.what(), sizeof(lastError) - 1);
+        lastError[sizeof(lastError) - 1] = '\0';
+        return false;
+    }
+}
+
+bool Propagate2BodiesStatesProxy(double mu, const double *states, int count, double dt, double *propagatedStates)
+{
+    try
+    {
+        if (count < 0)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("States count can't be negative");
+        }
+        IO::Astrodynamics::Propagators::TwoBodyPropagator::Propagate(static_cast<std::size_t>(count), mu, states, dt, propagatedStates);
+        return true;
+    }
+    catch (const std::exception &e)
+    {
+        std::strncpy(lastError, e.what(), sizeof(lastError) - 1);
+        lastError[sizeof(lastError) - 1] = '\0';
+        return false;
+    }
+}
+
+bool PorkchopGridProxy(int departureBodyId, int arrivalBodyId, int centerBodyId, const double *departureEpochs, int departureCount,
+                       const double *arrivalEpochs, int arrivalCount, double *c3, double *arrivalVInfinity, double *departureDeclination,
+                       double *timeOfFlight)
+{
+    try
+    {
+        ActivateErrorManagement();
+        if (departureCount < 0 || arrivalCount < 0)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Departure count and arrival count must be positive");
+        }
+        std::vector<IO::Astrodynamics::Time::TDB> departures, arrivals;
+        departures.reserve(departureCount);
+        arrivals.reserve(arrivalCount);
+        for (int i = 0; i < departureCount; ++i)
+        {
+            departures.emplace_back(std::chrono::duration<double>(departureEpochs[i]));
+        }
+        for (int i = 0; i < arrivalCount; ++i)
+        {
+            arrivals.emplace_back(std::chrono::duration<double>(arrivalEpochs[i]));
+        }
+        IO::Astrodynamics::Maneuvers::PorkchopGrid grid(std::make_shared<IO::Astrodynamics::Body::CelestialBody>(departureBodyId),
+                                                        std::make_shared<IO::Astrodynamics::Body::CelestialBody>(arrivalBodyId),
+                                                        std::make_shared<IO::Astrodynamics::Body::CelestialBody>(centerBodyId));
+        auto result = grid.Compute(departures, arrivals);
+        if (failed_c())
+        {
+            std::strncpy(lastError, HandleError(), sizeof(lastError) - 1);
+            lastError[sizeof(lastError) - 1] = '\0';
+            return false;
+        }
+        std::copy(result.DepartureC3.begin(), result.DepartureC3.end(), c3);
+        std::copy(result.ArrivalVInfinity.begin(), result.ArrivalVInfinity.end(), arrivalVInfinity);
+        std::copy(result.DepartureDeclination.begin(), result.DepartureDeclination.end(), departureDeclination);
+        std::copy(result.TimeOfFlight.begin(), result.TimeOfFlight.end(), timeOfFlight);
+        return true;
+    }
+    catch (const std::exception &e)
+    {
+        std::strncpy(lastError, e.what(), sizeof(lastError) - 1);
+        lastError[sizeof(lastError) - 1] = '\0';
+        return false;
+    }
+}
+
+//Central body gravity, optional zonal harmonics or geopotential, then third bodies gravity
+static std::vector<std::shared_ptr<IO::Astrodynamics::Propagators::ForceModel>>
+CreateForceModels(const IO::Astrodynamics::API::DTO::StateVectorDTO &stateVector, const int *thirdBodyIds, int thirdBodyCount, bool useZonalHarmonics,
+                  const char *geopotentialModelPath, int geopotentialDegree)
+{
+    if (thirdBodyCount < 0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Third bodies count can't be negative");
+    }
+    const bool useGeopotential = geopotentialModelPath && geopotentialModelPath[0] != '\0';
+    if (useGeopotential && useZonalHarmonics)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Zonal harmonics are already part of the geopotential model");
+    }
+    IO::Astrodynamics::Frames::Frames frame(stateVector.inertialFrame);
+    auto center = std::make_shared<IO::Astrodynamics::Body::CelestialBody>(stateVector.centerOfMotionId);
+    std::vector<std::shared_ptr<IO::Astrodynamics::Propagators::ForceModel>> forces;
+    if (useGeopotential)
+    {
+        auto model = std::make_shared<IO::Astrodynamics::Propagators::GeopotentialModel>(
+                IO::Astrodynamics::Propagators::GeopotentialModel::ReadFile(geopotentialModelPath, geopotentialDegree, geopotentialDegree, center->GetMu(),
+                                                                            center->GetRadius().GetX()));
+        forces.push_back(std::make_shared<IO::Astrodynamics::Propagators::GeopotentialGravity>(model, center, frame));
+    }
+    else
+    {
+        forces.push_back(std::make_shared<IO::Astrodynamics::Propagators::PointMassGravity>(center->GetMu()));
+    }
+    if (useZonalHarmonics)
+    {
+        forces.push_back(std::make_shared<IO::Astrodynamics::Propagators::ZonalHarmonicsGravity>(*center, frame, IO::Astrodynamics::Time::TDB(
+                std::chrono::duration<double>(stateVector.epoch))));
+    }
+    for (int i = 0; i < thirdBodyCount; ++i)
+    {
+        forces.push_back(std::make_shared<IO::Astrodynamics::Propagators::ThirdBodyGravity>(
+                std::make_shared<IO::Astrodynamics::Body::CelestialBody>(thirdBodyIds[i]), center, frame));
+    }
+    return forces;
+}
+
+bool PropagateNumericallyProxy(IO::Astrodynamics::API::DTO::StateVectorDTO stateVector, const int *thirdBodyIds, int thirdBodyCount, bool useZonalHarmonics,
+                               const char *geopotentialModelPath, int geopotentialDegree, double relativeTolerance, const double *epochs, int epochCount,
+                               double *states)
+{
+    try
+    {
+        ActivateErrorManagement();
+        if (epochCount < 1)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("At least one epoch is required");
+        }
+        auto forces = CreateForceModels(stateVector, thirdBodyIds, thirdBodyCount, useZonalHarmonics, geopotentialModelPath, geopotentialDegree);
+
+        IO::Astrodynamics::Propagators::NumericalPropagator propagator(forces, IO::Astrodynamics::Propagators::IntegrationScheme::DormandPrince54, 60.0,
+                                                                       relativeTolerance);
+        const double state[6]{stateVector.position.x, stateVector.position.y, stateVector.position.z,
+                              stateVector.velocity.x, stateVector.velocity.y, stateVector.velocity.z};
+        auto [begin, end] = std::minmax_element(epochs, epochs + epochCount);
+        propagator.Propagate(stateVector.epoch, state, *begin, *end);
+        if (failed_c())
+        {
+            std::strncpy(lastError, HandleError(), sizeof(lastError) - 1);
+            lastError[sizeof(lastError) - 1] = '\0';
+            return false;
+        }
+        propagator.GetStates(static_cast<std::size_t>(epochCount), epochs, states);
+        return true;
+    }
+    catch (const std::exception &e)
+    {
+        std::strncpy(lastError, e.what(), sizeof(lastError) - 1);
+        lastError[sizeof(lastError) - 1] = '\0';
+        return false;
+    }
+}
+
+bool PropagateEnsembleProxy(IO::Astrodynamics::API::DTO::StateVectorDTO meanState, const double *covariance, int memberCount, unsigned long long seed,
+                            const int *thirdBodyIds, int thirdBodyCount, bool useZonalHarmonics, const char *geopotentialModelPath, int geopotentialDegree,
+                            double step, double outputStep, int outputCount, const double *percentiles, int percentileCount, double *means,
+                            double *covariances, double *percentileStates)
+{
+    try
+    {
+        ActivateErrorManagement();
+        if (memberCount < 2 || outputCount < 1 || percentileCount < 0)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("At least two members and one output are required, percentiles count can't be negative");
+        }
+        auto forces = CreateForceModels(meanState, thirdBodyIds, thirdBodyCount, useZonalHarmonics, geopotentialModelPath, geopotentialDegree);
+
+        const double mean[6]{meanState.position.x, meanState.position.y, meanState.position.z,
+                             meanState.velocity.x, meanState.velocity.y, meanState.velocity.z};
+        const auto members = IO::Astrodynamics::Propagators::EnsemblePropagator::Sample(mean, covariance, static_cast<std::size_t>(memberCount), seed);
+        IO::Astrodynamics::Propagators::EnsemblePropagator propagator(forces, step);
+        auto statistics = propagator.PropagateStatistics(meanState.epoch, members.size() / 6, members.data(), outputStep, static_cast<std::size_t>(outputCount),
+                                                         std::vector<double>(percentiles, percentiles + percentileCount));
+        if (failed_c())
+        {
+            std::strncpy(lastError, HandleError(), sizeof(lastError) - 1);
+            lastError[sizeof(lastError) - 1] = '\0';
+            return false;
+        }
+        std::copy(statistics.Mean.begin(), statistics.Mean.end(), means);
+        std::copy(statistics.Covariance.begin(), statistics.Covariance.end(), covariances);
+        std::copy(statistics.Percentiles.begin(), statistics.Percentiles.end(), percentileStates);
+        return true;
+    }
+    catch (const std::exception &e)
+    {
+        std::strncpy(lastError, e.what(), sizeof(lastError) - 1);
+        lastError[sizeof(lastError) - 1] = '\0';
+        return false;
+    }
+}
+
+bool PropagateEnsembleTrajectoriesProxy(const IO::Astrodynamics::API::DTO::StateVectorDTO *states, int memberCount, const int *thirdBodyIds, int thirdBodyCount,
+                                        bool useZonalHarmonics, const char *geopotentialModelPath, int geopotentialDegree, double step, double outputStep,
+                                        int outputCount, double *trajectories)
+{
+    try
+    {
+        ActivateErrorManagement();
+        if (memberCount < 1 || outputCount < 1)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("At least one member and one output are required");
+        }
+        for (int j = 1; j < memberCount; ++j)
+        {
+            if (states[j].epoch != states[0].epoch || states[j].centerOfMotionId != states[0].centerOfMotionId ||
+                std::strncmp(states[j].inertialFrame, states[0].inertialFrame, sizeof(states[0].inertialFrame)) != 0)
+            {
+                throw IO::Astrodynamics::Exception::InvalidArgumentException("Members must share the same epoch, central body and frame");
+            }
+        }
+        auto forces = CreateForceModels(states[0], thirdBodyIds, thirdBodyCount, useZonalHarmonics, geopotentialModelPath, geopotentialDegree);
+
+        const auto count = static_cast<std::size_t>(memberCount);
+        std::vector<double> members(6 * count);
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            double *member = members.data() + 6 * j;
+            member[0] = states[j].position.x;
+            member[1] = states[j].position.y;
+            member[2] = states[j].position.z;
+            member[3] = states[j].velocity.x;
+            member[4] = states[j].velocity.y;
+            member[5] = states[j].velocity.z;
+        }
+        IO::Astrodynamics::Propagators::EnsemblePropagator propagator(forces, step);
+        auto propagated = propagator.PropagateTrajectories(states[0].epoch, count, members.data(), outputStep, static_cast<std::size_t>(outputCount));
+        if (failed_c())
+        {
+            std::strncpy(lastError, HandleError(), sizeof(lastError) - 1);
+            lastError[sizeof(lastError) - 1] = '\0';
+            return false;
+        }
+
+        //Output major states to member major trajectories
+        for (std::size_t i = 0; i < static_cast<std::size_t>(outputCount); ++i)
+        {
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                std::copy_n(propagated.data() + 6 * (i * count + j), 6, trajectories + 6 * (j * outputCount + i));
+            }
+        }
+        return true;
+    }
+    catch (const std::exception &e)
+    {
+        std::strncpy(lastError, e.what(), sizeof(lastError) - 1);
+        lastError[sizeof(lastError) - 1] = '\0';
+        return false;
+    }
+}
+
 void KClearProxy()
 {
     kclear_c();
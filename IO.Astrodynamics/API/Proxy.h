@@ -356,6 +356,160 @@ MODULE_API IO::Astrodynamics::API::DTO::StateVectorDTO Propagate2BodiesProxy(
 MODULE_API IO::Astrodynamics::API::DTO::TLEElementsDTO GetTLEElementsProxy(
         const char *L1, const char *L2, const char *L3);
 
+/**
+ * Get horizontal coordinates and rates of many targets from a site at many epochs
+ * Values of target j at epoch i are written at i * targetCount + j
+ * @param site Site
+ * @param targetIds Array of target IDs
+ * @param targetCount Number of targets
+ * @param epochs Array of epochs (TDB seconds from J2000)
+ * @param epochCount Number of epochs
+ * @param aberration Aberration correction
+ * @param refraction Apply atmospheric refraction on elevation
+ * @param azimuth Array to store azimuths (rad)
+ * @param elevation Array to store elevations (rad)
+ * @param range Array to store ranges (m)
+ * @param azimuthRate Array to store azimuth rates (rad/s)
+ * @param elevationRate Array to store elevation rates (rad/s)
+ * @param rangeRate Array to store range rates (m/s)
+ * @return true if successful, false otherwise
+ */
+MODULE_API bool GetHorizontalCoordinatesBatchProxy(IO::Astrodynamics::API::DTO::SiteDTO site, const int *targetIds, int targetCount,
+                                                   const double *epochs, int epochCount, const char *aberration, bool refraction,
+                                                   double *azimuth, double *elevation, double *range, double *azimuthRate,
+                                                   double *elevationRate, double *rangeRate);
+
+/**
+ * Write a two lines elements file (2LE or 3LE) into a binary file (spk) with one type 10 segment per satellite
+ * Object ID of each satellite is -100000 - satellite number
+ * @param filePath Path to the binary file
+ * @param tleFilePath Path to the two lines elements file
+ * @param window Coverage of every segment (TDB)
+ * @param segmentCount Number of written segments
+ * @return true if successful, false otherwise
+ */
+MODULE_API bool WriteTwoLineElementsEphemerisProxy(const char *filePath, const char *tleFilePath, IO::Astrodynamics::API::DTO::WindowDTO window,
+                                                   int *segmentCount);
+
+/**
+ * Convert orbital elements of many objects without any kernel
+ * Arrays are in structure of arrays layout : component j of object i is stored at j * count + i
+ * @param inputType Input elements type : 0 state vector, 1 keplerian, 2 equinoctial, 3 modified equinoctial
+ * @param outputType Output elements type
+ * @param mu Gravitational parameter of the center of motion
+ * @param count Objects count
+ * @param input 6 * count input elements
+ * @param output 6 * count output elements allocated by the caller
+ * @return true if successful, false otherwise
+ */
+MODULE_API bool ConvertOrbitalElementsProxy(int inputType, int outputType, double mu, int count, const double *input, double *output);
+
+/**
+ * Propagate a two-body state vector to many epochs without any kernel
+ * @param stateVector Initial state vector
+ * @param mu Gravitational parameter of the center of motion
+ * @param epochs Target epochs (TDB)
+ * @param epochCount Epochs count
+ * @param positions Propagated positions allocated by the caller, 3 values per epoch
+ * @param velocities Propagated velocities allocated by the caller, 3 values per epoch
+ * @return true if successful, false otherwise
+ */
+MODULE_API bool Propagate2BodiesBatchProxy(IO::Astrodynamics::API::DTO::StateVectorDTO stateVector, double mu, const double *epochs, int epochCount,
+                                           double *positions, double *velocities);
+
+/**
+ * Propagate many two-body states orbiting the same body by the same duration without any kernel
+ * @param mu Gravitational parameter of the center of motion
+ * @param states Initial states, 6 values per state
+ * @param count States count
+ * @param dt Propagation duration
+ * @param propagatedStates Propagated states allocated by the caller, 6 values per state
+ * @return true if successful, false otherwise
+ */
+MODULE_API bool Propagate2BodiesStatesProxy(double mu, const double *states, int count, double dt, double *propagatedStates);
+
+/**
+ * Compute porkchop plot data of direct transfers between two bodies orbiting the same center
+ * @param departureBodyId Departure body
+ * @param arrivalBodyId Arrival body
+ * @param centerBodyId Center of motion of the transfer orbit
+ * @param departureEpochs Departure epochs (TDB)
+ * @param departureCount Departure epochs count
+ * @param arrivalEpochs Arrival epochs (TDB)
+ * @param arrivalCount Arrival epochs count
+ * @param c3 Departure characteristic energy allocated by the caller, departureCount * arrivalCount values
+ * @param arrivalVInfinity Arrival hyperbolic excess velocity allocated by the caller, departureCount * arrivalCount values
+ * @param departureDeclination Declination of the departure asymptote in ICRF allocated by the caller, departureCount * arrivalCount values
+ * @param timeOfFlight Time of flight allocated by the caller, departureCount * arrivalCount values
+ * @return true if successful, false otherwise
+ */
+MODULE_API bool PorkchopGridProxy(int departureBodyId, int arrivalBodyId, int centerBodyId, const double *departureEpochs, int departureCount,
+                                  const double *arrivalEpochs, int arrivalCount, double *c3, double *arrivalVInfinity, double *departureDeclination,
+                                  double *timeOfFlight);
+
+/**
+ * Propagate a state numerically and evaluate it at many epochs, forces are central body gravity, optional zonal harmonics or geopotential and third bodies gravity
+ * @param stateVector Initial state, relative to the central body in an inertial frame
+ * @param thirdBodyIds Perturbing bodies
+ * @param thirdBodyCount Perturbing bodies count
+ * @param useZonalHarmonics Use J2, J3 and J4 of the central body
+ * @param geopotentialModelPath Optional ICGEM or EGM model of the central body, replaces the point mass and zonal harmonics when defined
+ * @param geopotentialDegree Highest degree and order read from the geopotential model
+ * @param relativeTolerance Local error relative tolerance of the integrator
+ * @param epochs Output epochs (TDB)
+ * @param epochCount Output epochs count
+ * @param states Output states allocated by the caller, 6 values per epoch
+ * @return true if successful, false otherwise
+ */
+MODULE_API bool PropagateNumericallyProxy(IO::Astrodynamics::API::DTO::StateVectorDTO stateVector, const int *thirdBodyIds, int thirdBodyCount, bool useZonalHarmonics,
+                                          const char *geopotentialModelPath, int geopotentialDegree, double relativeTolerance, const double *epochs,
+                                          int epochCount, double *states);
+
+/**
+ * Propagate states drawn from a normal distribution in lockstep and return the ensemble statistics at each output epoch, forces are the same as PropagateNumericallyProxy
+ * @param meanState Mean initial state, relative to the central body in an inertial frame
+ * @param covariance Row major 6x6 initial covariance
+ * @param memberCount Members count, at least two
+ * @param seed Random generator seed
+ * @param thirdBodyIds Perturbing bodies
+ * @param thirdBodyCount Perturbing bodies count
+ * @param useZonalHarmonics Use J2, J3 and J4 of the central body
+ * @param geopotentialModelPath Optional ICGEM or EGM model of the central body, replaces the point mass and zonal harmonics when defined
+ * @param geopotentialDegree Highest degree and order read from the geopotential model
+ * @param step Largest integration step (s)
+ * @param outputStep Time between outputs, the first output is the initial epoch (s)
+ * @param outputCount Outputs count
+ * @param percentiles Percentiles computed, between 0 and 100
+ * @param percentileCount Percentiles count
+ * @param means Mean states allocated by the caller, 6 values per output
+ * @param covariances Row major covariances allocated by the caller, 36 values per output
+ * @param percentileStates Percentile states allocated by the caller, 6 values per percentile per output
+ * @return true if successful, false otherwise
+ */
+MODULE_API bool PropagateEnsembleProxy(IO::Astrodynamics::API::DTO::StateVectorDTO meanState, const double *covariance, int memberCount, unsigned long long seed,
+                                       const int *thirdBodyIds, int thirdBodyCount, bool useZonalHarmonics, const char *geopotentialModelPath,
+                                       int geopotentialDegree, double step, double outputStep, int outputCount, const double *percentiles, int percentileCount,
+                                       double *means, double *covariances, double *percentileStates);
+
+/**
+ * Propagate caller supplied states in lockstep and return each member trajectory, forces are the same as PropagateNumericallyProxy
+ * @param states Initial states sharing the same epoch, central body and inertial frame
+ * @param memberCount Members count
+ * @param thirdBodyIds Perturbing bodies
+ * @param thirdBodyCount Perturbing bodies count
+ * @param useZonalHarmonics Use J2, J3 and J4 of the central body
+ * @param geopotentialModelPath Optional ICGEM or EGM model of the central body, replaces the point mass and zonal harmonics when defined
+ * @param geopotentialDegree Highest degree and order read from the geopotential model
+ * @param step Largest integration step (s)
+ * @param outputStep Time between outputs, the first output is the initial epoch (s)
+ * @param outputCount Outputs count
+ * @param trajectories States allocated by the caller, state of member j at output i from (j * outputCount + i) * 6
+ * @return true if successful, false otherwise
+ */
+MODULE_API bool PropagateEnsembleTrajectoriesProxy(const IO::Astrodynamics::API::DTO::StateVectorDTO *states, int memberCount, const int *thirdBodyIds,
+                                                   int thirdBodyCount, bool useZonalHarmonics, const char *geopotentialModelPath, int geopotentialDegree,
+                                                   double step, double outputStep, int outputCount, double *trajectories);
+
 /**
  * Clear kernel pool
  */
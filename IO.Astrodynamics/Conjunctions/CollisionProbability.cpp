@@ -0,0 +1,365 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <CollisionProbability.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+
+namespace
+{
+    constexpr std::size_t QUADRATURE_ORDER = 16;
+    constexpr int MAXIMUM_PANELS = 256;
+
+    //Gaussian is negligible beyond this number of sigmas, relative to its largest value over the disk
+    constexpr double GAUSSIAN_EXTENT = 8.5;
+
+    constexpr int MAXIMUM_SEARCH_ITERATIONS = 40;
+    //Relative error of the small disk approximation is of the order of this ratio
+    constexpr double SMALL_DISK_RATIO = 1E-06;
+
+    struct GaussLegendre
+    {
+        std::array<double, QUADRATURE_ORDER> Nodes{};
+        std::array<double, QUADRATURE_ORDER> Weights{};
+
+        GaussLegendre()
+        {
+            //Legendre polynomial roots by Newton iterations
+            for (std::size_t i = 0; i < QUADRATURE_ORDER; ++i)
+            {
+                double x = std::cos(IO::Astrodynamics::Constants::PI * (static_cast<double>(i) + 0.75) / (static_cast<double>(QUADRATURE_ORDER) + 0.5));
+                double derivative{};
+                for (int iteration = 0; iteration < 100; ++iteration)
+                {
+                    double p0 = 1.0, p1 = x;
+                    for (std::size_t n = 2; n <= QUADRATURE_ORDER; ++n)
+                    {
+                        const double p2 = ((2.0 * n - 1.0) * x * p1 - (n - 1.0) * p0) / static_cast<double>(n);
+                        p0 = p1;
+                        p1 = p2;
+                    }
+                    derivative = static_cast<double>(QUADRATURE_ORDER) * (x * p1 - p0) / (x * x - 1.0);
+                    const double dx = p1 / derivative;
+                    x -= dx;
+                    if (std::abs(dx) < 1E-16)
+                    {
+                        break;
+                    }
+                }
+                Nodes[i] = x;
+                Weights[i] = 2.0 / ((1.0 - x * x) * derivative * derivative);
+            }
+        }
+    };
+
+    const GaussLegendre &GetQuadrature()
+    {
+        static const GaussLegendre quadrature;
+        return quadrature;
+    }
+
+    //Method dispatched once for the batch, the per encounter quadrature is the inner loop
+    template<typename Method>
+    inline void EvaluateBatch(std::size_t count, const double *missX, const double *missY, const double *sigmaX, const double *sigmaY, const double *hardBodyRadii,
+                              double *probabilities, Method method)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            probabilities[i] = method(IO::Astrodynamics::Conjunctions::EncounterPlane{missX[i], missY[i], sigmaX[i], sigmaY[i]}, hardBodyRadii[i]);
+        }
+    }
+
+    inline bool IsValid(const IO::Astrodynamics::Conjunctions::EncounterPlane &encounter)
+    {
+        return encounter.SigmaX > 0.0 && encounter.SigmaY > 0.0 && std::isfinite(encounter.MissX) && std::isfinite(encounter.MissY);
+    }
+}
+
+IO::Astrodynamics::Conjunctions::EncounterPlane
+IO::Astrodynamics::Conjunctions::CollisionProbability::Project(const double relativePosition[3], const double relativeVelocity[3], const double covariance[6])
+{
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    const double speed = std::sqrt(relativeVelocity[0] * relativeVelocity[0] + relativeVelocity[1] * relativeVelocity[1] + relativeVelocity[2] * relativeVelocity[2]);
+    if (!(speed > 0.0))
+    {
+        return EncounterPlane{nan, nan, nan, nan};
+    }
+
+    //Encounter plane basis, x axis along the miss vector
+    const double z[3]{relativeVelocity[0] / speed, relativeVelocity[1] / speed, relativeVelocity[2] / speed};
+    const double along = relativePosition[0] * z[0] + relativePosition[1] * z[1] + relativePosition[2] * z[2];
+    double x[3]{relativePosition[0] - along * z[0], relativePosition[1] - along * z[1], relativePosition[2] - along * z[2]};
+    double norm = std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+    if (norm <= 0.0)
+    {
+        //Null miss distance, any direction of the plane
+        const int axis = std::abs(z[0]) < std::abs(z[1]) ? (std::abs(z[0]) < std::abs(z[2]) ? 0 : 2) : (std::abs(z[1]) < std::abs(z[2]) ? 1 : 2);
+        double e[3]{};
+        e[axis] = 1.0;
+        x[0] = e[1] * z[2] - e[2] * z[1];
+        x[1] = e[2] * z[0] - e[0] * z[2];
+        x[2] = e[0] * z[1] - e[1] * z[0];
+        norm = std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+    }
+    for (double &value: x)
+    {
+        value /= norm;
+    }
+    const double y[3]{z[1] * x[2] - z[2] * x[1], z[2] * x[0] - z[0] * x[2], z[0] * x[1] - z[1] * x[0]};
+
+    const double c[3][3]{{covariance[0], covariance[1], covariance[2]},
+                         {covariance[1], covariance[3], covariance[4]},
+                         {covariance[2], covariance[4], covariance[5]}};
+    double cx[3], cy[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        cx[i] = c[i][0] * x[0] + c[i][1] * x[1] + c[i][2] * x[2];
+        cy[i] = c[i][0] * y[0] + c[i][1] * y[1] + c[i][2] * y[2];
+    }
+    const double a = x[0] * cx[0] + x[1] * cx[1] + x[2] * cx[2];
+    const double b = x[0] * cy[0] + x[1] * cy[1] + x[2] * cy[2];
+    const double d = y[0] * cy[0] + y[1] * cy[1] + y[2] * cy[2];
+
+    //Principal axes of the projected covariance
+    const double angle = 0.5 * std::atan2(2.0 * b, a - d);
+    const double mean = 0.5 * (a + d);
+    const double radius = std::sqrt(0.25 * (a - d) * (a - d) + b * b);
+    const double missX = relativePosition[0] * x[0] + relativePosition[1] * x[1] + relativePosition[2] * x[2];
+    const double missY = relativePosition[0] * y[0] + relativePosition[1] * y[1] + relativePosition[2] * y[2];
+    const double cosAngle = std::cos(angle);
+    const double sinAngle = std::sin(angle);
+
+    EncounterPlane encounter;
+    encounter.MissX = cosAngle * missX + sinAngle * missY;
+    encounter.MissY = -sinAngle * missX + cosAngle * missY;
+    encounter.SigmaX = mean + radius > 0.0 ? std::sqrt(mean + radius) : nan;
+    encounter.SigmaY = mean - radius > 0.0 ? std::sqrt(mean - radius) : nan;
+    return encounter;
+}
+
+double IO::Astrodynamics::Conjunctions::CollisionProbability::Foster(const EncounterPlane &encounter, double hardBodyRadius)
+{
+    if (!IsValid(encounter))
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (hardBodyRadius <= 0.0)
+    {
+        return 0.0;
+    }
+
+    const double r = hardBodyRadius;
+    const double sx = encounter.SigmaX;
+    const double sy = encounter.SigmaY;
+    const double mx = encounter.MissX;
+    const double my = encounter.MissY;
+
+    //Integration along x over the part of the disk where the gaussian isn't negligible, y integral is analytical.
+    //Extent is measured from the disk point closest to the mean so that disks far in the tail keep their relative accuracy
+    const double nearest = std::clamp(mx, -r, r);
+    const double low = std::max(-r, nearest - GAUSSIAN_EXTENT * sx);
+    const double high = std::min(r, nearest + GAUSSIAN_EXTENT * sx);
+    if (low >= high || std::abs(my) - r > GAUSSIAN_EXTENT * sy)
+    {
+        return 0.0;
+    }
+
+    //x = r sin(phi) removes the square root singularity at the disk edges
+    const double phiLow = std::asin(std::clamp(low / r, -1.0, 1.0));
+    const double phiHigh = std::asin(std::clamp(high / r, -1.0, 1.0));
+    const int panels = static_cast<int>(std::clamp(std::ceil(2.0 * (phiHigh - phiLow) * r / std::min(sx, sy)), 1.0, static_cast<double>(MAXIMUM_PANELS)));
+    const double width = (phiHigh - phiLow) / panels;
+
+    const auto &quadrature = GetQuadrature();
+    const double xFactor = 1.0 / (sx * std::sqrt(2.0));
+    const double yFactor = 1.0 / (sy * std::sqrt(2.0));
+    double sum{};
+    for (int panel = 0; panel < panels; ++panel)
+    {
+        const double center = phiLow + (panel + 0.5) * width;
+        double panelSum{};
+        for (std::size_t i = 0; i < QUADRATURE_ORDER; ++i)
+        {
+            const double phi = center + 0.5 * width * quadrature.Nodes[i];
+            const double x = r * std::sin(phi);
+            const double h = r * std::cos(phi);
+            const double dx = (x - mx) * xFactor;
+            panelSum += quadrature.Weights[i] * h * std::exp(-dx * dx) * (std::erf((h - my) * yFactor) + std::erf((h + my) * yFactor));
+        }
+        sum += panelSum;
+    }
+
+    //Gaussian normalisation, 1/2 of the erf difference and 1/2 of the panel width
+    return std::min(1.0, sum * 0.25 * width / (sx * std::sqrt(IO::Astrodynamics::Constants::_2PI)));
+}
+
+double IO::Astrodynamics::Conjunctions::CollisionProbability::Chan(const EncounterPlane &encounter, double hardBodyRadius)
+{
+    if (!IsValid(encounter))
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (hardBodyRadius <= 0.0)
+    {
+        return 0.0;
+    }
+
+    //Pc = sum over m of Poisson(m, v/2) * P(m + 1, u/2) with P the regularized lower incomplete gamma function
+    const double u = 0.5 * hardBodyRadius * hardBodyRadius / (encounter.SigmaX * encounter.SigmaY);
+    const double v = 0.5 * (encounter.MissX * encounter.MissX / (encounter.SigmaX * encounter.SigmaX) +
+                            encounter.MissY * encounter.MissY / (encounter.SigmaY * encounter.SigmaY));
+    const int terms = static_cast<int>(std::min(20000.0, std::ceil(v + 10.0 * std::sqrt(v) + 20.0)));
+
+    //Highest order by series, lower orders by the stable downward recurrence P(a, u) = P(a + 1, u) + u^a exp(-u) / a!
+    double series{1.0}, term{1.0};
+    for (int n = 1; n < 1000 && term > 1E-17 * series; ++n)
+    {
+        term *= u / (terms + 1 + n);
+        series += term;
+    }
+    const double logU = std::log(u);
+    double p = std::exp(-u + (terms + 1) * logU - std::lgamma(terms + 2.0)) * series;
+
+    const double logV = v > 0.0 ? std::log(v) : 0.0;
+    double probability{};
+    for (int m = terms; m >= 0; --m)
+    {
+        if (m < terms)
+        {
+            p += std::exp(-u + (m + 1) * logU - std::lgamma(m + 2.0));
+        }
+        if (v > 0.0)
+        {
+            probability += std::exp(-v + m * logV - std::lgamma(m + 1.0)) * p;
+        }
+        else if (m == 0)
+        {
+            probability = p;
+        }
+    }
+    return std::min(1.0, probability);
+}
+
+double IO::Astrodynamics::Conjunctions::CollisionProbability::Maximum(const EncounterPlane &encounter, double hardBodyRadius)
+{
+    if (!IsValid(encounter))
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (hardBodyRadius <= 0.0)
+    {
+        return 0.0;
+    }
+    if (std::hypot(encounter.MissX, encounter.MissY) <= hardBodyRadius)
+    {
+        return 1.0;
+    }
+
+    //Small disk approximation Pc(k) = u / (2k) exp(-v / 2k) for a covariance scaled by k is maximal at k = v / 2
+    const double u = hardBodyRadius * hardBodyRadius / (encounter.SigmaX * encounter.SigmaY);
+    const double v = encounter.MissX * encounter.MissX / (encounter.SigmaX * encounter.SigmaX) +
+                     encounter.MissY * encounter.MissY / (encounter.SigmaY * encounter.SigmaY);
+    const double scale = 0.5 * v;
+    if (u / scale < SMALL_DISK_RATIO)
+    {
+        return u / (v * std::exp(1.0));
+    }
+
+    //Golden section search on the logarithm of the scale factor
+    auto evaluate = [&](double logScale)
+    {
+        const double factor = std::exp(0.5 * logScale);
+        return Foster(EncounterPlane{encounter.MissX, encounter.MissY, encounter.SigmaX * factor, encounter.SigmaY * factor}, hardBodyRadius);
+    };
+    const double ratio = 0.5 * (std::sqrt(5.0) - 1.0);
+    double a = std::log(scale) - 4.0;
+    double b = std::log(scale) + 4.0;
+    double c = b - ratio * (b - a);
+    double d = a + ratio * (b - a);
+    double fc = evaluate(c);
+    double fd = evaluate(d);
+    for (int iteration = 0; iteration < MAXIMUM_SEARCH_ITERATIONS; ++iteration)
+    {
+        if (fc > fd)
+        {
+            b = d;
+            d = c;
+            fd = fc;
+            c = b - ratio * (b - a);
+            fc = evaluate(c);
+        }
+        else
+        {
+            a = c;
+            c = d;
+            fc = fd;
+            d = a + ratio * (b - a);
+            fd = evaluate(d);
+        }
+    }
+    return std::max(fc, fd);
+}
+
+void IO::Astrodynamics::Conjunctions::CollisionProbability::Compute(std::size_t count, const double *relativePositions, const double *relativeVelocities,
+                                                                   const double *covariances, const double *hardBodyRadii, CollisionProbabilityMethod method,
+                                                                   double *probabilities)
+{
+    //Projection of every encounter first into one array per field, then the same method over the whole batch
+    std::vector<double> missX(count), missY(count), sigmaX(count), sigmaY(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto encounter = Project(relativePositions + i * 3, relativeVelocities + i * 3, covariances + i * 6);
+        missX[i] = encounter.MissX;
+        missY[i] = encounter.MissY;
+        sigmaX[i] = encounter.SigmaX;
+        sigmaY[i] = encounter.SigmaY;
+    }
+
+    switch (method)
+    {
+        case CollisionProbabilityMethod::Foster:
+            EvaluateBatch(count, missX.data(), missY.data(), sigmaX.data(), sigmaY.data(), hardBodyRadii, probabilities, &Foster);
+            break;
+        case CollisionProbabilityMethod::Chan:
+            EvaluateBatch(count, missX.data(), missY.data(), sigmaX.data(), sigmaY.data(), hardBodyRadii, probabilities, &Chan);
+            break;
+        case CollisionProbabilityMethod::Maximum:
+            EvaluateBatch(count, missX.data(), missY.data(), sigmaX.data(), sigmaY.data(), hardBodyRadii, probabilities, &Maximum);
+            break;
+    }
+}
+
+std::vector<double> IO::Astrodynamics::Conjunctions::CollisionProbability::Compute(const std::vector<Conjunction> &conjunctions, const std::vector<double> &covariances,
+                                                                                   double hardBodyRadius, CollisionProbabilityMethod method)
+{
+    if (covariances.size() != conjunctions.size() * 6)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Covariances must have 6 values per conjunction");
+    }
+    if (hardBodyRadius <= 0.0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Hard body radius must be a positive number");
+    }
+
+    const std::size_t count = conjunctions.size();
+    std::vector<double> positions(count * 3), velocities(count * 3), radii(count, hardBodyRadius), probabilities(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto &conjunction = conjunctions[i];
+        positions[i * 3] = conjunction.Radial;
+        positions[i * 3 + 1] = conjunction.InTrack;
+        positions[i * 3 + 2] = conjunction.CrossTrack;
+        velocities[i * 3] = conjunction.RadialVelocity;
+        velocities[i * 3 + 1] = conjunction.InTrackVelocity;
+        velocities[i * 3 + 2] = conjunction.CrossTrackVelocity;
+    }
+    Compute(count, positions.data(), velocities.data(), covariances.data(), radii.data(), method, probabilities.data());
+    return probabilities;
+}
@@ -0,0 +1,113 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_COLLISIONPROBABILITY_H
+#define IO_COLLISIONPROBABILITY_H
+
+#include <vector>
+
+#include <ConjunctionScreening.h>
+
+namespace IO::Astrodynamics::Conjunctions
+{
+    /**
+     * @brief Two dimensional probability of collision methods
+     */
+    enum class CollisionProbabilityMethod
+    {
+        //Numerical integration of the gaussian over the hard body disk
+        Foster,
+        //Series expansion with an equivalent area circular covariance
+        Chan,
+        //Maximum probability over covariance scaling, with the same aspect ratio
+        Maximum
+    };
+
+    /**
+     * @brief Encounter in the plane orthogonal to the relative velocity, along covariance principal axes.
+     * Miss components are the secondary position relative to the primary (m), sigmas are combined position uncertainties (m).
+     */
+    struct EncounterPlane
+    {
+        double MissX{};
+        double MissY{};
+        double SigmaX{};
+        double SigmaY{};
+    };
+
+    /**
+     * @brief Short term encounter probability of collision.
+     * Relative motion is assumed linear during the encounter and combined position covariance constant, so the probability is the integral
+     * of a two dimensional gaussian over the hard body disk in the encounter plane.
+     * Batch functions take contiguous arrays, each encounter being independent.
+     */
+    class CollisionProbability final
+    {
+    public:
+        /**
+         * @brief Project an encounter in the encounter plane
+         *
+         * @param relativePosition Secondary position relative to primary (m)
+         * @param relativeVelocity Secondary velocity relative to primary (m/s)
+         * @param covariance Combined position covariance in the same frame, upper triangle xx, xy, xz, yy, yz, zz (m^2)
+         * @return EncounterPlane
+         */
+        static EncounterPlane Project(const double relativePosition[3], const double relativeVelocity[3], const double covariance[6]);
+
+        /**
+         * @brief Numerical integration of the gaussian over the hard body disk
+         *
+         * @param encounter
+         * @param hardBodyRadius Sum of both objects radii (m)
+         * @return double
+         */
+        static double Foster(const EncounterPlane &encounter, double hardBodyRadius);
+
+        /**
+         * @brief Chan series, exact for circular covariances
+         *
+         * @param encounter
+         * @param hardBodyRadius Sum of both objects radii (m)
+         * @return double
+         */
+        static double Chan(const EncounterPlane &encounter, double hardBodyRadius);
+
+        /**
+         * @brief Maximum probability when the covariance is scaled, aspect ratio and orientation being kept
+         *
+         * @param encounter
+         * @param hardBodyRadius Sum of both objects radii (m)
+         * @return double
+         */
+        static double Maximum(const EncounterPlane &encounter, double hardBodyRadius);
+
+        /**
+         * @brief Compute probabilities of many encounters
+         *
+         * @param count Encounters count
+         * @param relativePositions 3 values per encounter (m)
+         * @param relativeVelocities 3 values per encounter (m/s)
+         * @param covariances 6 values per encounter, upper triangle of the combined position covariance (m^2)
+         * @param hardBodyRadii 1 value per encounter (m)
+         * @param method
+         * @param probabilities Output, NaN when the covariance isn't positive definite or relative velocity is null
+         */
+        static void Compute(std::size_t count, const double *relativePositions, const double *relativeVelocities, const double *covariances,
+                            const double *hardBodyRadii, CollisionProbabilityMethod method, double *probabilities);
+
+        /**
+         * @brief Compute probabilities of screening results
+         *
+         * @param conjunctions
+         * @param covariances 6 values per conjunction, combined position covariance in primary radial, in-track, cross-track frame (m^2)
+         * @param hardBodyRadius Same radius for every conjunction (m)
+         * @param method
+         * @return std::vector<double>
+         */
+        static std::vector<double> Compute(const std::vector<Conjunction> &conjunctions, const std::vector<double> &covariances, double hardBodyRadius,
+                                           CollisionProbabilityMethod method = CollisionProbabilityMethod::Foster);
+    };
+}
+
+#endif //IO_COLLISIONPROBABILITY_H
@@ -0,0 +1,615 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <ConjunctionScreening.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <BodyFixedFrames.h>
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+#include <Parallel.h>
+
+namespace
+{
+    //Margin between mean elements radii and osculating radii. SGP4 short periodic terms in radius are about 1.5 J2 Re^2 / p, below 11 km for any orbit
+    //above earth surface, deep space lunar and solar periodic terms are a few km. Drag decay is added per object from the window bounds
+    constexpr double MEAN_ELEMENTS_PAD = 30000.0;
+
+    //Bound of the relative acceleration between two objects above earth surface (m/s^2)
+    constexpr double MAXIMUM_RELATIVE_ACCELERATION = 2.0 * 9.82;
+
+    //Path filter is not used when orbit planes are almost the same, the mutual node is undefined
+    constexpr double PATH_FILTER_MINIMUM_SINE = 0.1;
+
+    //Path filter is not used when secular drift would make the mutual node window too large
+    constexpr double PATH_FILTER_MAXIMUM_DRIFT = 0.5;
+
+    constexpr double TCA_ACCURACY = 1E-04;
+    constexpr double DUPLICATE_TCA_TOLERANCE = 1.0;
+    constexpr std::int64_t GRID_OFFSET = 1 << 20;
+
+    struct Candidate
+    {
+        std::size_t Primary;
+        std::size_t Secondary;
+        double Epoch;
+    };
+
+    inline double Dot(const double *a, const double *b)
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    inline void Cross(const double *a, const double *b, double *result)
+    {
+        result[0] = a[1] * b[2] - a[2] * b[1];
+        result[1] = a[2] * b[0] - a[0] * b[2];
+        result[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    inline std::uint64_t GridKey(std::int64_t x, std::int64_t y, std::int64_t z)
+    {
+        return (static_cast<std::uint64_t>(x + GRID_OFFSET) << 42) | (static_cast<std::uint64_t>(y + GRID_OFFSET) << 21) | static_cast<std::uint64_t>(z + GRID_OFFSET);
+    }
+
+    inline std::int64_t GridCoordinate(double value, double cellSize)
+    {
+        return std::clamp<std::int64_t>(static_cast<std::int64_t>(std::floor(value / cellSize)), 1 - GRID_OFFSET, GRID_OFFSET - 2);
+    }
+
+    //Radius range of a conic over true anomalies [center - halfWidth, center + halfWidth]
+    void RadiusRange(double semiMajorAxis, double eccentricity, double center, double halfWidth, double &minimum, double &maximum)
+    {
+        const double p = semiMajorAxis * (1.0 - eccentricity * eccentricity);
+        const double periapsis = semiMajorAxis * (1.0 - eccentricity);
+        const double apoapsis = semiMajorAxis * (1.0 + eccentricity);
+        if (halfWidth >= IO::Astrodynamics::Constants::PI)
+        {
+            minimum = periapsis;
+            maximum = apoapsis;
+            return;
+        }
+
+        const double r1 = p / (1.0 + eccentricity * std::cos(center - halfWidth));
+        const double r2 = p / (1.0 + eccentricity * std::cos(center + halfWidth));
+        minimum = std::min(r1, r2);
+        maximum = std::max(r1, r2);
+
+        //Distance from center to periapsis and apoapsis anomalies
+        const double toPeriapsis = std::abs(std::remainder(center, IO::Astrodynamics::Constants::_2PI));
+        const double toApoapsis = std::abs(std::remainder(center - IO::Astrodynamics::Constants::PI, IO::Astrodynamics::Constants::_2PI));
+        if (toPeriapsis <= halfWidth)
+        {
+            minimum = periapsis;
+        }
+        if (toApoapsis <= halfWidth)
+        {
+            maximum = apoapsis;
+        }
+    }
+}
+
+IO::Astrodynamics::Conjunctions::ScreeningVolume IO::Astrodynamics::Conjunctions::ScreeningVolume::Sphere(double radius)
+{
+    return ScreeningVolume{radius, radius, radius};
+}
+
+double IO::Astrodynamics::Conjunctions::ScreeningVolume::GetMaximumExtent() const
+{
+    return std::max({Radial, InTrack, CrossTrack});
+}
+
+bool IO::Astrodynamics::Conjunctions::ScreeningVolume::Contains(double radial, double inTrack, double crossTrack) const
+{
+    const double r = radial / Radial;
+    const double i = inTrack / InTrack;
+    const double c = crossTrack / CrossTrack;
+    return r * r + i * i + c * c <= 1.0;
+}
+
+IO::Astrodynamics::Conjunctions::ConjunctionScreening::ConjunctionScreening(std::vector<IO::Astrodynamics::Propagators::SGP4Elements> catalog)
+        : m_elements{std::move(catalog)}, m_propagator{m_elements}
+{
+}
+
+bool IO::Astrodynamics::Conjunctions::ConjunctionScreening::IsApsisFilterPassed(std::size_t primary, std::size_t secondary, double margin) const
+{
+    const auto &p = m_propagator.GetPropagator(primary);
+    const auto &s = m_propagator.GetPropagator(secondary);
+    const double pa = p.GetSemiMajorAxis();
+    const double sa = s.GetSemiMajorAxis();
+    const double highestPerigee = std::max(pa * (1.0 - p.GetEccentricity()), sa * (1.0 - s.GetEccentricity()));
+    const double lowestApogee = std::min(pa * (1.0 + p.GetEccentricity()), sa * (1.0 + s.GetEccentricity()));
+    return highestPerigee - lowestApogee <= margin;
+}
+
+bool IO::Astrodynamics::Conjunctions::ConjunctionScreening::IsPathFilterPassed(std::size_t primary, std::size_t secondary, double margin, double epoch,
+                                                                              double duration) const
+{
+    const IO::Astrodynamics::Propagators::SGP4 *objects[2]{&m_propagator.GetPropagator(primary), &m_propagator.GetPropagator(secondary)};
+
+    //Mean elements at the middle of the window, half window secular drift is covered by the angular margin
+    double normals[2][3], nodes[2][3], arguments[2], drift{};
+    for (int k = 0; k < 2; ++k)
+    {
+        const auto &o = *objects[k];
+        const double dt = epoch - o.GetEpoch().GetSecondsFromJ2000().count();
+        const double node = o.GetRightAscendingNode() + o.GetRightAscendingNodeRate() * dt;
+        arguments[k] = o.GetPeriapsisArgument() + o.GetPeriapsisArgumentRate() * dt;
+        drift += (std::abs(o.GetRightAscendingNodeRate()) + std::abs(o.GetPeriapsisArgumentRate())) * duration * 0.5;
+
+        const double sinI = std::sin(o.GetInclination());
+        normals[k][0] = sinI * std::sin(node);
+        normals[k][1] = -sinI * std::cos(node);
+        normals[k][2] = std::cos(o.GetInclination());
+        nodes[k][0] = std::cos(node);
+        nodes[k][1] = std::sin(node);
+        nodes[k][2] = 0.0;
+    }
+
+    double mutualNode[3];
+    Cross(normals[0], normals[1], mutualNode);
+    const double sinRelativeInclination = std::sqrt(Dot(mutualNode, mutualNode));
+    if (sinRelativeInclination < PATH_FILTER_MINIMUM_SINE || drift / sinRelativeInclination > PATH_FILTER_MAXIMUM_DRIFT)
+    {
+        return true;
+    }
+    for (double &value: mutualNode)
+    {
+        value /= sinRelativeInclination;
+    }
+
+    for (double direction: {1.0, -1.0})
+    {
+        double minimum[2], maximum[2];
+        for (int k = 0; k < 2; ++k)
+        {
+            const auto &o = *objects[k];
+            const double a = o.GetSemiMajorAxis();
+            const double e = o.GetEccentricity();
+
+            //Argument of latitude of the mutual node in this orbit plane
+            double inPlane[3];
+            Cross(normals[k], nodes[k], inPlane);
+            const double u = std::atan2(direction * Dot(mutualNode, inPlane), direction * Dot(mutualNode, nodes[k]));
+
+            //Outside this angular window the object is farther than the margin from the other orbit plane
+            const double halfWidth = std::asin(std::min(1.0, margin / (a * (1.0 - e) * sinRelativeInclination))) + drift / sinRelativeInclination;
+            RadiusRange(a, e, u - arguments[k], halfWidth, minimum[k], maximum[k]);
+        }
+
+        if (minimum[0] - maximum[1] <= margin && minimum[1] - maximum[0] <= margin)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool IO::Astrodynamics::Conjunctions::ConjunctionScreening::Refine(std::size_t primary, std::size_t secondary, double begin, double end, double windowBegin,
+                                                                  double windowEnd, const ScreeningVolume &volume, Conjunction &conjunction) const
+{
+    const auto &p = m_propagator.GetPropagator(primary);
+    const auto &s = m_propagator.GetPropagator(secondary);
+    double primaryPosition[3], primaryVelocity[3], relativePosition[3], relativeVelocity[3];
+
+    auto evaluate = [&](double epoch, double &rangeRate)
+    {
+        double secondaryPosition[3], secondaryVelocity[3];
+        const IO::Astrodynamics::Time::TDB tdb{std::chrono::duration<double>(epoch)};
+        if (p.Propagate(tdb, primaryPosition, primaryVelocity) != IO::Astrodynamics::Propagators::SGP4::Status::Success ||
+            s.Propagate(tdb, secondaryPosition, secondaryVelocity) != IO::Astrodynamics::Propagators::SGP4::Status::Success)
+        {
+            return false;
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            relativePosition[i] = secondaryPosition[i] - primaryPosition[i];
+            relativeVelocity[i] = secondaryVelocity[i] - primaryVelocity[i];
+        }
+        rangeRate = Dot(relativePosition, relativeVelocity);
+        return true;
+    };
+
+    double low{begin}, high{end}, lowValue{}, highValue{};
+    if (!evaluate(low, lowValue) || !evaluate(high, highValue))
+    {
+        return false;
+    }
+
+    //Range rate is negative before closest approach, interval bounds are only kept at window bounds
+    double tca;
+    if (lowValue >= 0.0)
+    {
+        if (low > windowBegin)
+        {
+            return false;
+        }
+        tca = low;
+    }
+    else if (highValue <= 0.0)
+    {
+        if (high < windowEnd)
+        {
+            return false;
+        }
+        tca = high;
+    }
+    else
+    {
+        //Illinois regula falsi on range rate
+        int side{0};
+        tca = low;
+        for (int iteration = 0; iteration < 100; ++iteration)
+        {
+            const double previous = tca;
+            tca = (low * highValue - high * lowValue) / (highValue - lowValue);
+            double value{};
+            if (!evaluate(tca, value))
+            {
+                return false;
+            }
+            if (value == 0.0 || std::abs(tca - previous) < TCA_ACCURACY || high - low < TCA_ACCURACY)
+            {
+                break;
+            }
+            if (value < 0.0)
+            {
+                low = tca;
+                lowValue = value;
+                if (side == -1)
+                {
+                    highValue *= 0.5;
+                }
+                side = -1;
+            }
+            else
+            {
+                high = tca;
+                highValue = value;
+                if (side == 1)
+                {
+                    lowValue *= 0.5;
+                }
+                side = 1;
+            }
+        }
+    }
+
+    double rangeRate{};
+    if (!evaluate(tca, rangeRate))
+    {
+        return false;
+    }
+
+    //Primary radial, in-track, cross-track frame
+    double radial[3], crossTrack[3], inTrack[3];
+    const double r = std::sqrt(Dot(primaryPosition, primaryPosition));
+    Cross(primaryPosition, primaryVelocity, crossTrack);
+    const double h = std::sqrt(Dot(crossTrack, crossTrack));
+    for (int i = 0; i < 3; ++i)
+    {
+        radial[i] = primaryPosition[i] / r;
+        crossTrack[i] /= h;
+    }
+    Cross(crossTrack, radial, inTrack);
+
+    conjunction.PrimaryIndex = primary;
+    conjunction.SecondaryIndex = secondary;
+    conjunction.TCA = IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(tca));
+    conjunction.MissDistance = std::sqrt(Dot(relativePosition, relativePosition));
+    conjunction.RelativeSpeed = std::sqrt(Dot(relativeVelocity, relativeVelocity));
+    conjunction.Radial = Dot(relativePosition, radial);
+    conjunction.InTrack = Dot(relativePosition, inTrack);
+    conjunction.CrossTrack = Dot(relativePosition, crossTrack);
+    conjunction.RadialVelocity = Dot(relativeVelocity, radial);
+    conjunction.InTrackVelocity = Dot(relativeVelocity, inTrack);
+    conjunction.CrossTrackVelocity = Dot(relativeVelocity, crossTrack);
+
+    return volume.Contains(conjunction.Radial, conjunction.InTrack, conjunction.CrossTrack);
+}
+
+std::vector<IO::Astrodynamics::Conjunctions::Conjunction>
+IO::Astrodynamics::Conjunctions::ConjunctionScreening::Screen(const std::vector<std::size_t> &primaries, const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window,
+                                                              const ScreeningVolume &volume, const IO::Astrodynamics::Time::TimeSpan &step, unsigned int threadCount,
+                                                              ScreeningStatistics *statistics) const
+{
+    const double windowBegin = window.GetStartDate().GetSecondsFromJ2000().count();
+    const double windowEnd = window.GetEndDate().GetSecondsFromJ2000().count();
+    const double stepSize = step.GetSeconds().count();
+    if (windowEnd <= windowBegin || stepSize <= 0.0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Window and step must have a positive length");
+    }
+    if (volume.Radial <= 0.0 || volume.InTrack <= 0.0 || volume.CrossTrack <= 0.0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Screening volume must have positive semi axes");
+    }
+
+    const std::size_t catalogSize = m_elements.size();
+    std::vector<std::size_t> uniquePrimaries(primaries);
+    std::sort(uniquePrimaries.begin(), uniquePrimaries.end());
+    uniquePrimaries.erase(std::unique(uniquePrimaries.begin(), uniquePrimaries.end()), uniquePrimaries.end());
+    std::vector<char> isPrimary(catalogSize, 0);
+    for (auto index: uniquePrimaries)
+    {
+        if (index >= catalogSize)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Primary index is out of catalog");
+        }
+        isPrimary[index] = 1;
+    }
+
+    //Filters on mean elements, pairs of two primaries are kept once
+    ScreeningStatistics stats;
+    const double distance = volume.GetMaximumExtent();
+    const double middle = (windowBegin + windowEnd) * 0.5;
+    const double duration = windowEnd - windowBegin;
+
+    //Mean radii uncertainty of each object over the window
+    std::vector<double> pads(catalogSize);
+    for (std::size_t i = 0; i < catalogSize; ++i)
+    {
+        const auto &o = m_propagator.GetPropagator(i);
+        const double epoch = o.GetEpoch().GetSecondsFromJ2000().count();
+        pads[i] = MEAN_ELEMENTS_PAD + std::max(o.GetDragRadiusChange((windowBegin - epoch) / 60.0), o.GetDragRadiusChange((windowEnd - epoch) / 60.0));
+    }
+
+    std::vector<std::vector<std::size_t>> secondaries(uniquePrimaries.size());
+    std::vector<std::size_t> localIndexes(catalogSize, catalogSize);
+    std::vector<std::size_t> objects;
+    auto addObject = [&](std::size_t index)
+    {
+        if (localIndexes[index] == catalogSize)
+        {
+            localIndexes[index] = objects.size();
+            objects.push_back(index);
+        }
+    };
+
+    for (std::size_t k = 0; k < uniquePrimaries.size(); ++k)
+    {
+        const std::size_t primary = uniquePrimaries[k];
+        if (m_propagator.GetPropagator(primary).GetStatus() != IO::Astrodynamics::Propagators::SGP4::Status::Success)
+        {
+            continue;
+        }
+        for (std::size_t secondary = 0; secondary < catalogSize; ++secondary)
+        {
+            if (secondary == primary || (isPrimary[secondary] && secondary < primary) ||
+                m_propagator.GetPropagator(secondary).GetStatus() != IO::Astrodynamics::Propagators::SGP4::Status::Success)
+            {
+                continue;
+            }
+            ++stats.Pairs;
+            const double margin = distance + pads[primary] + pads[secondary];
+            if (!IsApsisFilterPassed(primary, secondary, margin))
+            {
+                continue;
+            }
+            ++stats.ApsisFilterPairs;
+            if (!IsPathFilterPassed(primary, secondary, margin, middle, duration))
+            {
+                continue;
+            }
+            ++stats.PathFilterPairs;
+            secondaries[k].push_back(secondary);
+        }
+        if (!secondaries[k].empty())
+        {
+            addObject(primary);
+            for (auto secondary: secondaries[k])
+            {
+                addObject(secondary);
+            }
+        }
+    }
+
+    std::vector<Conjunction> conjunctions;
+    if (objects.empty())
+    {
+        if (statistics)
+        {
+            *statistics = stats;
+        }
+        return conjunctions;
+    }
+
+    //Only remaining objects are propagated on the time grid
+    const std::size_t localCount = objects.size();
+    std::vector<IO::Astrodynamics::Propagators::SGP4Elements> localElements;
+    localElements.reserve(localCount);
+    for (auto index: objects)
+    {
+        localElements.push_back(m_elements[index]);
+    }
+    const IO::Astrodynamics::Propagators::SGP4CatalogPropagator localPropagator(localElements);
+
+    std::vector<std::size_t> localPrimaries;
+    std::vector<char> pairMask;
+    for (std::size_t k = 0; k < uniquePrimaries.size(); ++k)
+    {
+        if (!secondaries[k].empty())
+        {
+            localPrimaries.push_back(localIndexes[uniquePrimaries[k]]);
+        }
+    }
+    pairMask.assign(localPrimaries.size() * localCount, 0);
+    for (std::size_t k = 0, row = 0; k < uniquePrimaries.size(); ++k)
+    {
+        if (secondaries[k].empty())
+        {
+            continue;
+        }
+        for (auto secondary: secondaries[k])
+        {
+            pairMask[row * localCount + localIndexes[secondary]] = 1;
+        }
+        ++row;
+    }
+
+    std::vector<double> epochs;
+    for (double epoch = windowBegin; epoch < windowEnd; epoch = windowBegin + static_cast<double>(epochs.size()) * stepSize)
+    {
+        epochs.push_back(epoch);
+    }
+    epochs.push_back(windowEnd);
+
+    const double halfStep = stepSize * 0.5;
+    const double curvature = 0.5 * MAXIMUM_RELATIVE_ACCELERATION * halfStep * halfStep;
+
+    threadCount = IO::Astrodynamics::Helpers::ThreadCount(threadCount, epochs.size());
+    std::vector<std::vector<Conjunction>> threadConjunctions(threadCount);
+    std::vector<std::size_t> threadCandidates(threadCount, 0);
+
+    auto work = [&](unsigned int thread, std::size_t begin, std::size_t end)
+    {
+        std::vector<double> positions(localCount * 3), velocities(localCount * 3), speeds(localCount);
+        std::vector<IO::Astrodynamics::Propagators::SGP4::Status> statuses(localCount);
+        std::vector<std::pair<std::uint64_t, std::size_t>> cells;
+        cells.reserve(localCount);
+        std::vector<Candidate> candidates;
+
+        for (std::size_t e = begin; e < end; ++e)
+        {
+            const double epoch = epochs[e];
+            localPropagator.Propagate(IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(epoch)), IO::Astrodynamics::Frames::BodyFixedFrames::TEME(),
+                                      positions.data(), velocities.data(), 1, statuses.data());
+
+            double maximumSpeed{};
+            for (std::size_t i = 0; i < localCount; ++i)
+            {
+                speeds[i] = std::sqrt(Dot(&velocities[i * 3], &velocities[i * 3]));
+                if (statuses[i] == IO::Astrodynamics::Propagators::SGP4::Status::Success)
+                {
+                    maximumSpeed = std::max(maximumSpeed, speeds[i]);
+                }
+            }
+
+            //Any pair closer than the screening distance within half a step is in neighbour cells
+            const double cellSize = distance + 2.0 * maximumSpeed * halfStep + curvature;
+            cells.clear();
+            for (std::size_t i = 0; i < localCount; ++i)
+            {
+                if (statuses[i] == IO::Astrodynamics::Propagators::SGP4::Status::Success)
+                {
+                    cells.emplace_back(GridKey(GridCoordinate(positions[i * 3], cellSize), GridCoordinate(positions[i * 3 + 1], cellSize),
+                                               GridCoordinate(positions[i * 3 + 2], cellSize)), i);
+                }
+            }
+            std::sort(cells.begin(), cells.end());
+
+            for (std::size_t row = 0; row < localPrimaries.size(); ++row)
+            {
+                const std::size_t primary = localPrimaries[row];
+                if (statuses[primary] != IO::Astrodynamics::Propagators::SGP4::Status::Success)
+                {
+                    continue;
+                }
+                const double *rp = &positions[primary * 3];
+                const double *vp = &velocities[primary * 3];
+                const double reach = distance + (speeds[primary] + maximumSpeed) * halfStep + curvature;
+                const std::int64_t cx = GridCoordinate(rp[0], cellSize), cy = GridCoordinate(rp[1], cellSize), cz = GridCoordinate(rp[2], cellSize);
+                for (std::int64_t dx = -1; dx <= 1; ++dx)
+                {
+                    for (std::int64_t dy = -1; dy <= 1; ++dy)
+                    {
+                        for (std::int64_t dz = -1; dz <= 1; ++dz)
+                        {
+                            const std::uint64_t key = GridKey(cx + dx, cy + dy, cz + dz);
+                            auto it = std::lower_bound(cells.begin(), cells.end(), std::make_pair(key, std::size_t{0}));
+                            for (; it != cells.end() && it->first == key; ++it)
+                            {
+                                const std::size_t secondary = it->second;
+                                if (!pairMask[row * localCount + secondary])
+                                {
+                                    continue;
+                                }
+                                double dr[3], dv[3];
+                                for (int i = 0; i < 3; ++i)
+                                {
+                                    dr[i] = positions[secondary * 3 + i] - rp[i];
+                                    dv[i] = velocities[secondary * 3 + i] - vp[i];
+                                }
+                                if (Dot(dr, dr) > reach * reach)
+                                {
+                                    continue;
+                                }
+
+                                //Closest approach of the linear relative motion within half a step
+                                const double dv2 = Dot(dv, dv);
+                                const double tau = dv2 > 0.0 ? std::clamp(-Dot(dr, dv) / dv2, -halfStep, halfStep) : 0.0;
+                                double closest[3]{dr[0] + dv[0] * tau, dr[1] + dv[1] * tau, dr[2] + dv[2] * tau};
+                                const double threshold = distance + curvature;
+                                if (Dot(closest, closest) <= threshold * threshold)
+                                {
+                                    candidates.push_back(Candidate{objects[primary], objects[secondary], epoch});
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        threadCandidates[thread] = candidates.size();
+        for (const auto &candidate: candidates)
+        {
+            Conjunction conjunction;
+            if (Refine(candidate.Primary, candidate.Secondary, std::max(windowBegin, candidate.Epoch - halfStep), std::min(windowEnd, candidate.Epoch + halfStep),
+                       windowBegin, windowEnd, volume, conjunction))
+            {
+                threadConjunctions[thread].push_back(conjunction);
+            }
+        }
+    };
+
+    IO::Astrodynamics::Helpers::ParallelFor(threadCount, epochs.size(), work);
+
+    //Adjacent epochs and chunks may refine the same approach
+    for (unsigned int t = 0; t < threadCount; ++t)
+    {
+        stats.Candidates += threadCandidates[t];
+        conjunctions.insert(conjunctions.end(), threadConjunctions[t].begin(), threadConjunctions[t].end());
+    }
+    std::sort(conjunctions.begin(), conjunctions.end(), [](const Conjunction &a, const Conjunction &b)
+    {
+        if (a.PrimaryIndex != b.PrimaryIndex)
+        {
+            return a.PrimaryIndex < b.PrimaryIndex;
+        }
+        if (a.SecondaryIndex != b.SecondaryIndex)
+        {
+            return a.SecondaryIndex < b.SecondaryIndex;
+        }
+        return a.TCA < b.TCA;
+    });
+    std::vector<Conjunction> unique;
+    for (const auto &conjunction: conjunctions)
+    {
+        if (!unique.empty() && unique.back().PrimaryIndex == conjunction.PrimaryIndex && unique.back().SecondaryIndex == conjunction.SecondaryIndex &&
+            (conjunction.TCA - unique.back().TCA).GetSeconds().count() < DUPLICATE_TCA_TOLERANCE)
+        {
+            if (conjunction.MissDistance < unique.back().MissDistance)
+            {
+                unique.back() = conjunction;
+            }
+            continue;
+        }
+        unique.push_back(conjunction);
+    }
+    std::sort(unique.begin(), unique.end(), [](const Conjunction &a, const Conjunction &b)
+    { return a.TCA < b.TCA; });
+
+    stats.Conjunctions = unique.size();
+    if (statistics)
+    {
+        *statistics = stats;
+    }
+    return unique;
+}
@@ -0,0 +1,144 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_CONJUNCTIONSCREENING_H
+#define IO_CONJUNCTIONSCREENING_H
+
+#include <vector>
+
+#include <SGP4CatalogPropagator.h>
+#include <TimeSpan.h>
+#include <Window.h>
+
+namespace IO::Astrodynamics::Conjunctions
+{
+    /**
+     * @brief Ellipsoidal screening volume centered on the primary object, semi axes are given in its radial, in-track, cross-track frame (m)
+     */
+    struct ScreeningVolume
+    {
+        double Radial{};
+        double InTrack{};
+        double CrossTrack{};
+
+        /**
+         * @brief Spherical screening volume
+         *
+         * @param radius (m)
+         * @return ScreeningVolume
+         */
+        static ScreeningVolume Sphere(double radius);
+
+        /**
+         * @brief Get the largest semi axis
+         *
+         * @return double (m)
+         */
+        [[nodiscard]] double GetMaximumExtent() const;
+
+        /**
+         * @brief Check if a relative position is inside the volume
+         *
+         * @param radial (m)
+         * @param inTrack (m)
+         * @param crossTrack (m)
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool Contains(double radial, double inTrack, double crossTrack) const;
+    };
+
+    /**
+     * @brief Close approach between a primary and a secondary object.
+     * Relative state is the secondary state relative to the primary, expressed in the primary radial, in-track, cross-track frame.
+     */
+    struct Conjunction
+    {
+        std::size_t PrimaryIndex{};
+        std::size_t SecondaryIndex{};
+        IO::Astrodynamics::Time::TDB TCA{std::chrono::duration<double>(0.0)};
+
+        //(m)
+        double MissDistance{};
+
+        //(m/s)
+        double RelativeSpeed{};
+
+        //(m)
+        double Radial{};
+        double InTrack{};
+        double CrossTrack{};
+
+        //(m/s)
+        double RadialVelocity{};
+        double InTrackVelocity{};
+        double CrossTrackVelocity{};
+    };
+
+    /**
+     * @brief Pairs remaining after each screening stage
+     */
+    struct ScreeningStatistics
+    {
+        std::size_t Pairs{};
+        std::size_t ApsisFilterPairs{};
+        std::size_t PathFilterPairs{};
+        std::size_t Candidates{};
+        std::size_t Conjunctions{};
+    };
+
+    /**
+     * @brief Screen primary objects against a two lines elements catalog.
+     * Pairs are first rejected by apogee/perigee and orbit path filters on mean elements, padded by SGP4 short periodic terms and drag decay over the window. Remaining objects are propagated on a time grid,
+     * close pairs are found at each epoch with a spatial grid and a bound on the relative motion between epochs, then the time of closest approach
+     * is refined with the SGP4 propagator. Time grid is split in chunks propagated by different threads.
+     */
+    class ConjunctionScreening final
+    {
+    private:
+        std::vector<IO::Astrodynamics::Propagators::SGP4Elements> m_elements;
+        IO::Astrodynamics::Propagators::SGP4CatalogPropagator m_propagator;
+
+        [[nodiscard]] bool IsApsisFilterPassed(std::size_t primary, std::size_t secondary, double margin) const;
+
+        [[nodiscard]] bool IsPathFilterPassed(std::size_t primary, std::size_t secondary, double margin, double epoch, double duration) const;
+
+        [[nodiscard]] bool Refine(std::size_t primary, std::size_t secondary, double begin, double end, double windowBegin, double windowEnd,
+                                  const ScreeningVolume &volume, Conjunction &conjunction) const;
+
+    public:
+        /**
+         * @brief Construct a new Conjunction Screening
+         *
+         * @param catalog Catalog elements, indexes in results refer to this catalog
+         */
+        explicit ConjunctionScreening(std::vector<IO::Astrodynamics::Propagators::SGP4Elements> catalog);
+
+        /**
+         * @brief Find conjunctions of primary objects with every other object of the catalog
+         *
+         * @param primaries Catalog indexes of primary objects
+         * @param window Search window
+         * @param volume Screening volume
+         * @param step Time grid step, conjunctions are found whatever the step, a smaller step gives fewer candidates to refine
+         * @param threadCount 0 to use all available hardware threads
+         * @param statistics Optional pairs count after each stage
+         * @return std::vector<Conjunction> Conjunctions sorted by time of closest approach
+         */
+        [[nodiscard]] std::vector<Conjunction> Screen(const std::vector<std::size_t> &primaries, const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window,
+                                                      const ScreeningVolume &volume,
+                                                      const IO::Astrodynamics::Time::TimeSpan &step = IO::Astrodynamics::Time::TimeSpan(std::chrono::duration<double>(30.0)),
+                                                      unsigned int threadCount = 0, ScreeningStatistics *statistics = nullptr) const;
+
+        /**
+         * @brief Get the catalog size
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] inline std::size_t GetSize() const
+        { return m_elements.size(); }
+    };
+}
+
+#endif //IO_CONJUNCTIONSCREENING_H
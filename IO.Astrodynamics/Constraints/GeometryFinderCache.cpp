@@ -0,0 +1,366 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <GeometryFinderCache.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <sstream>
+
+#include <SpiceUsr.h>
+
+IO::Astrodynamics::Constraints::GeometryFinderCache &IO::Astrodynamics::Constraints::GeometryFinderCache::GetInstance()
+{
+    static GeometryFinderCache instance;
+    return instance;
+}
+
+std::string IO::Astrodynamics::Constraints::GeometryFinderCache::ComputeKernelsFingerprint()
+{
+    std::ostringstream fingerprint;
+    SpiceInt count{};
+    ktotal_c("ALL", &count);
+
+    SpiceChar file[256];
+    SpiceChar type[32];
+    SpiceChar source[256];
+    SpiceInt handle;
+    SpiceBoolean found;
+    for (SpiceInt i = 0; i < count; ++i)
+    {
+        kdata_c(i, "ALL", sizeof(file), sizeof(type), sizeof(source), file, type, source, &handle, &found);
+        if (!found)
+        {
+            continue;
+        }
+
+        fingerprint << file << '|';
+        std::error_code ec;
+        auto size = std::filesystem::file_size(file, ec);
+        if (!ec)
+        {
+            fingerprint << size;
+        }
+        auto lastWrite = std::filesystem::last_write_time(file, ec);
+        if (!ec)
+        {
+            fingerprint << '|' << lastWrite.time_since_epoch().count();
+        }
+        fingerprint << ';';
+    }
+
+    //Kernel pool variables can be written without loading any kernel (sites, frames), their content is part of the fingerprint
+    std::ostringstream pool;
+    pool << std::hexfloat;
+    constexpr SpiceInt ROOM = 64;
+    SpiceChar names[ROOM][33];
+    SpiceInt start{};
+    SpiceInt namesCount{};
+    do
+    {
+        gnpool_c("*", start, ROOM, sizeof(names[0]), &namesCount, names, &found);
+        for (SpiceInt i = 0; i < namesCount; ++i)
+        {
+            SpiceInt size{};
+            SpiceChar valueType{};
+            dtpool_c(names[i], &found, &size, &valueType);
+            pool << names[i] << '|' << valueType << '|' << size << '|';
+            if (valueType == 'C')
+            {
+                SpiceChar value[81];
+                SpiceInt valuesCount{};
+                for (SpiceInt v = 0; v < size; ++v)
+                {
+                    gcpool_c(names[i], v, 1, sizeof(value), &valuesCount, value, &found);
+                    pool << value << ',';
+                }
+            } else
+            {
+                std::vector<SpiceDouble> values(size);
+                SpiceInt valuesCount{};
+                gdpool_c(names[i], 0, size, &valuesCount, values.data(), &found);
+                for (SpiceInt v = 0; v < valuesCount; ++v)
+                {
+                    pool << values[v] << ',';
+                }
+            }
+            pool << ';';
+        }
+        start += namesCount;
+    } while (namesCount == ROOM);
+
+    fingerprint << "POOL|" << std::hash<std::string>{}(pool.str());
+    return fingerprint.str();
+}
+
+void IO::Astrodynamics::Constraints::GeometryFinderCache::InvalidateIfKernelsChanged()
+{
+    auto fingerprint = ComputeKernelsFingerprint();
+    if (fingerprint != m_kernelsFingerprint)
+    {
+        if (!m_entries.empty())
+        {
+            m_entries.clear();
+            m_statistics.Invalidations++;
+        }
+        m_kernelsFingerprint = fingerprint;
+    }
+}
+
+void IO::Astrodynamics::Constraints::GeometryFinderCache::Evict()
+{
+    while (m_entries.size() > m_maximumEntries)
+    {
+        auto oldest = std::min_element(m_entries.begin(), m_entries.end(), [](const auto &a, const auto &b) { return a.second.lastUse < b.second.lastUse; });
+        m_entries.erase(oldest);
+    }
+}
+
+std::vector<std::pair<double, double>> IO::Astrodynamics::Constraints::GeometryFinderCache::Search(const SearchFunction &search, double start, double end)
+{
+    std::vector<std::pair<double, double>> res;
+    if (end <= start)
+    {
+        return res;
+    }
+
+    auto windows = search(IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>(IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(start)),
+                                                                                         IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(end))));
+    res.reserve(windows.size());
+    for (const auto &window: windows)
+    {
+        res.emplace_back(window.GetStartDate().GetSecondsFromJ2000().count(), window.GetEndDate().GetSecondsFromJ2000().count());
+    }
+    return res;
+}
+
+std::vector<std::pair<double, double>> IO::Astrodynamics::Constraints::GeometryFinderCache::Union(std::vector<std::pair<double, double>> windows)
+{
+    std::sort(windows.begin(), windows.end());
+    std::vector<std::pair<double, double>> res;
+    res.reserve(windows.size());
+    for (const auto &window: windows)
+    {
+        if (!res.empty() && window.first <= res.back().second)
+        {
+            res.back().second = std::max(res.back().second, window.second);
+        } else
+        {
+            res.push_back(window);
+        }
+    }
+    return res;
+}
+
+bool IO::Astrodynamics::Constraints::GeometryFinderCache::IsIncremental(const IO::Astrodynamics::Constraints::RelationalOperator &relationalOperator)
+{
+    std::string name{relationalOperator.ToCharArray()};
+    return name != IO::Astrodynamics::Constraints::RelationalOperator::AbsMin().ToCharArray() &&
+           name != IO::Astrodynamics::Constraints::RelationalOperator::AbsMax().ToCharArray();
+}
+
+std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+IO::Astrodynamics::Constraints::GeometryFinderCache::Clip(const std::vector<std::pair<double, double>> &windows, double start, double end)
+{
+    std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> res;
+    auto first = std::lower_bound(windows.begin(), windows.end(), start, [](const auto &w, double value) { return w.second < value; });
+    for (auto it = first; it != windows.end() && it->first <= end; ++it)
+    {
+        res.emplace_back(IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(std::max(it->first, start))),
+                         IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(std::min(it->second, end))));
+    }
+    return res;
+}
+
+std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+IO::Astrodynamics::Constraints::GeometryFinderCache::Find(const std::string &queryDescriptor,
+                                                          const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                          const IO::Astrodynamics::Time::TimeSpan &stepSize, const SearchFunction &search, bool incremental)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    InvalidateIfKernelsChanged();
+
+    const double start = searchWindow.GetStartDate().GetSecondsFromJ2000().count();
+    const double end = searchWindow.GetEndDate().GetSecondsFromJ2000().count();
+    const double step = stepSize.GetSeconds().count();
+
+    auto it = m_entries.find(queryDescriptor);
+    if (it != m_entries.end())
+    {
+        auto &entry = it->second;
+        entry.lastUse = ++m_useCounter;
+
+        if (!entry.incremental)
+        {
+            if (entry.coverageStart == start && entry.coverageEnd == end)
+            {
+                m_statistics.Hits++;
+                return Clip(entry.windows, start, end);
+            }
+        } else if (start >= entry.coverageStart && end <= entry.coverageEnd)
+        {
+            m_statistics.Hits++;
+            return Clip(entry.windows, start, end);
+        } else if (start <= entry.coverageEnd && end >= entry.coverageStart)
+        {
+            //Search uncovered portions only, each one overlapping the covered window by one step to re-verify its boundary
+            auto windows = entry.windows;
+            if (start < entry.coverageStart)
+            {
+                auto before = Search(search, start, std::min(entry.coverageStart + step, entry.coverageEnd));
+                windows.insert(windows.end(), before.begin(), before.end());
+            }
+            if (end > entry.coverageEnd)
+            {
+                auto after = Search(search, std::max(entry.coverageEnd - step, entry.coverageStart), end);
+                windows.insert(windows.end(), after.begin(), after.end());
+            }
+
+            entry.windows = Union(std::move(windows));
+            entry.coverageStart = std::min(start, entry.coverageStart);
+            entry.coverageEnd = std::max(end, entry.coverageEnd);
+            m_statistics.PartialHits++;
+            return Clip(entry.windows, start, end);
+        }
+    }
+
+    m_statistics.Misses++;
+    auto &entry = m_entries[queryDescriptor];
+    entry.coverageStart = start;
+    entry.coverageEnd = end;
+    entry.windows = Union(Search(search, start, end));
+    entry.incremental = incremental;
+    entry.lastUse = ++m_useCounter;
+    auto res = Clip(entry.windows, start, end);
+    Evict();
+    return res;
+}
+
+std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+IO::Astrodynamics::Constraints::GeometryFinderCache::FindWindowsOnDistanceConstraint(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                                                     int observerId, int targetId,
+                                                                                     const Constraints::RelationalOperator &constraint, double value,
+                                                                                     IO::Astrodynamics::AberrationsEnum aberration, const Time::TimeSpan &stepSize)
+{
+    std::ostringstream descriptor;
+    descriptor << std::hexfloat << "DISTANCE|" << observerId << '|' << targetId << '|' << constraint.ToCharArray() << '|' << value << '|'
+               << IO::Astrodynamics::Aberrations::ToString(aberration) << '|' << stepSize.GetSeconds().count();
+
+    return Find(descriptor.str(), searchWindow, stepSize, [&](const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window)
+    {
+        return GeometryFinder::FindWindowsOnDistanceConstraint(window, observerId, targetId, constraint, value, aberration, stepSize);
+    }, IsIncremental(constraint));
+}
+
+std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+IO::Astrodynamics::Constraints::GeometryFinderCache::FindWindowsOnOccultationConstraint(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                                                        int observerId, int targetId, const std::string &targetFrame,
+                                                                                        const std::string &targetShape, int frontBodyId, const std::string &frontFrame,
+                                                                                        const std::string &frontShape,
+                                                                                        const IO::Astrodynamics::OccultationType &occultationType,
+                                                                                        IO::Astrodynamics::AberrationsEnum aberration,
+                                                                                        const IO::Astrodynamics::Time::TimeSpan &stepSize)
+{
+    std::ostringstream descriptor;
+    descriptor << std::hexfloat << "OCCULTATION|" << observerId << '|' << targetId << '|' << targetFrame << '|' << targetShape << '|' << frontBodyId << '|'
+               << frontFrame << '|' << frontShape << '|' << occultationType.ToCharArray() << '|' << IO::Astrodynamics::Aberrations::ToString(aberration) << '|'
+               << stepSize.GetSeconds().count();
+
+    return Find(descriptor.str(), searchWindow, stepSize, [&](const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window)
+    {
+        return GeometryFinder::FindWindowsOnOccultationConstraint(window, observerId, targetId, targetFrame, targetShape, frontBodyId, frontFrame, frontShape,
+                                                                  occultationType, aberration, stepSize);
+    });
+}
+
+std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+IO::Astrodynamics::Constraints::GeometryFinderCache::FindWindowsOnCoordinateConstraint(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                                                       int observerId, int targetId, const std::string &frame,
+                                                                                       const IO::Astrodynamics::CoordinateSystem &coordinateSystem,
+                                                                                       const IO::Astrodynamics::Coordinate &coordinate,
+                                                                                       const IO::Astrodynamics::Constraints::RelationalOperator &relationalOperator,
+                                                                                       double value, double adjustValue, IO::Astrodynamics::AberrationsEnum aberration,
+                                                                                       const IO::Astrodynamics::Time::TimeSpan &stepSize)
+{
+    std::ostringstream descriptor;
+    descriptor << std::hexfloat << "COORDINATE|" << observerId << '|' << targetId << '|' << frame << '|' << coordinateSystem.ToCharArray() << '|'
+               << coordinate.ToCharArray() << '|' << relationalOperator.ToCharArray() << '|' << value << '|' << adjustValue << '|'
+               << IO::Astrodynamics::Aberrations::ToString(aberration) << '|' << stepSize.GetSeconds().count();
+
+    return Find(descriptor.str(), searchWindow, stepSize, [&](const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window)
+    {
+        return GeometryFinder::FindWindowsOnCoordinateConstraint(window, observerId, targetId, frame, coordinateSystem, coordinate, relationalOperator, value,
+                                                                 adjustValue, aberration, stepSize);
+    }, IsIncremental(relationalOperator));
+}
+
+std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+IO::Astrodynamics::Constraints::GeometryFinderCache::FindWindowsOnIlluminationConstraint(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                                                         int observerId, const std::string &illuminationSource, int targetBody,
+                                                                                         const std::string &fixedFrame, const double coordinates[3],
+                                                                                         const IlluminationAngle &illuminationType,
+                                                                                         const IO::Astrodynamics::Constraints::RelationalOperator &relationalOperator,
+                                                                                         double value, double adjustValue, IO::Astrodynamics::AberrationsEnum aberration,
+                                                                                         const IO::Astrodynamics::Time::TimeSpan &stepSize, const std::string &method)
+{
+    std::ostringstream descriptor;
+    descriptor << std::hexfloat << "ILLUMINATION|" << observerId << '|' << illuminationSource << '|' << targetBody << '|' << fixedFrame << '|' << coordinates[0]
+               << '|' << coordinates[1] << '|' << coordinates[2] << '|' << illuminationType.ToCharArray() << '|' << relationalOperator.ToCharArray() << '|'
+               << value << '|' << adjustValue << '|' << IO::Astrodynamics::Aberrations::ToString(aberration) << '|' << stepSize.GetSeconds().count() << '|'
+               << method;
+
+    return Find(descriptor.str(), searchWindow, stepSize, [&](const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window)
+    {
+        return GeometryFinder::FindWindowsOnIlluminationConstraint(window, observerId, illuminationSource, targetBody, fixedFrame, coordinates, illuminationType,
+                                                                   relationalOperator, value, adjustValue, aberration, stepSize, method);
+    }, IsIncremental(relationalOperator));
+}
+
+std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+IO::Astrodynamics::Constraints::GeometryFinderCache::FindWindowsInFieldOfViewConstraint(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                                                        int observerId, int instrumentId, int targetId, const std::string &targetFrame,
+                                                                                        const std::string &targetShape, IO::Astrodynamics::AberrationsEnum aberration,
+                                                                                        const IO::Astrodynamics::Time::TimeSpan &stepSize)
+{
+    std::ostringstream descriptor;
+    descriptor << std::hexfloat << "FOV|" << observerId << '|' << instrumentId << '|' << targetId << '|' << targetFrame << '|' << targetShape << '|'
+               << IO::Astrodynamics::Aberrations::ToString(aberration) << '|' << stepSize.GetSeconds().count();
+
+    return Find(descriptor.str(), searchWindow, stepSize, [&](const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window)
+    {
+        return GeometryFinder::FindWindowsInFieldOfViewConstraint(window, observerId, instrumentId, targetId, targetFrame, targetShape, aberration, stepSize);
+    });
+}
+
+void IO::Astrodynamics::Constraints::GeometryFinderCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+}
+
+IO::Astrodynamics::Constraints::GeometryFinderCacheStatistics IO::Astrodynamics::Constraints::GeometryFinderCache::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statistics;
+}
+
+void IO::Astrodynamics::Constraints::GeometryFinderCache::ResetStatistics()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_statistics = GeometryFinderCacheStatistics{};
+}
+
+std::size_t IO::Astrodynamics::Constraints::GeometryFinderCache::GetSize() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+void IO::Astrodynamics::Constraints::GeometryFinderCache::SetMaximumEntries(std::size_t maximumEntries)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maximumEntries = std::max<std::size_t>(maximumEntries, 1);
+    Evict();
+}
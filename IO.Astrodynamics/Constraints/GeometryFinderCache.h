@@ -0,0 +1,187 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_GEOMETRYFINDERCACHE_H
+#define IO_GEOMETRYFINDERCACHE_H
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <GeometryFinder.h>
+
+namespace IO::Astrodynamics::Constraints
+{
+    /**
+     * @brief Geometry finder cache statistics
+     */
+    struct GeometryFinderCacheStatistics
+    {
+        std::size_t Hits{};
+        std::size_t PartialHits{};
+        std::size_t Misses{};
+        std::size_t Invalidations{};
+    };
+
+    /**
+     * @brief Memoize geometry finder results.
+     * Queries are keyed by a canonical descriptor (constraint, bodies, relational operator, value, aberration, step size).
+     * When a new search window overlaps a cached one only the uncovered portions are searched, each one being extended by one step
+     * inside the covered window to re-verify the boundary, and the results are merged.
+     * Every entry is dropped as soon as the set of loaded kernels or the content of the kernel pool changes.
+     */
+    class GeometryFinderCache final
+    {
+    public:
+        using SearchFunction = std::function<std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>(
+                const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &)>;
+
+    private:
+        struct Entry
+        {
+            double coverageStart{};
+            double coverageEnd{};
+            std::vector<std::pair<double, double>> windows{};
+            std::size_t lastUse{};
+            bool incremental{true};
+        };
+
+        std::map<std::string, Entry> m_entries{};
+        std::string m_kernelsFingerprint{};
+        GeometryFinderCacheStatistics m_statistics{};
+        std::size_t m_maximumEntries{1024};
+        std::size_t m_useCounter{};
+        mutable std::mutex m_mutex{};
+
+        GeometryFinderCache() = default;
+
+        void InvalidateIfKernelsChanged();
+
+        void Evict();
+
+        static std::vector<std::pair<double, double>> Search(const SearchFunction &search, double start, double end);
+
+        static std::vector<std::pair<double, double>> Union(std::vector<std::pair<double, double>> windows);
+
+        static bool IsIncremental(const IO::Astrodynamics::Constraints::RelationalOperator &relationalOperator);
+
+        static std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+        Clip(const std::vector<std::pair<double, double>> &windows, double start, double end);
+
+    public:
+        GeometryFinderCache(const GeometryFinderCache &) = delete;
+
+        GeometryFinderCache &operator=(const GeometryFinderCache &) = delete;
+
+        /**
+         * @brief Get the cache instance
+         *
+         * @return GeometryFinderCache&
+         */
+        static GeometryFinderCache &GetInstance();
+
+        /**
+         * @brief Compute a fingerprint of the loaded kernels (files, sizes and last write times) and of the kernel pool variables
+         *
+         * @return std::string
+         */
+        static std::string ComputeKernelsFingerprint();
+
+        /**
+         * @brief Find windows for a given query, searching only the portions of the window which are not already cached
+         *
+         * @param queryDescriptor Canonical descriptor of the query
+         * @param searchWindow
+         * @param stepSize Step size used by the search, also used as boundary re-verification margin
+         * @param search Search function evaluated on uncovered portions
+         * @param incremental False when results depend on the whole search window (absolute extremum), only identical windows are then reused
+         * @return std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+         */
+        std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+        Find(const std::string &queryDescriptor, const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+             const IO::Astrodynamics::Time::TimeSpan &stepSize, const SearchFunction &search, bool incremental = true);
+
+        /**
+         * @brief Cached version of GeometryFinder::FindWindowsOnDistanceConstraint
+         */
+        std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+        FindWindowsOnDistanceConstraint(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow, int observerId, int targetId,
+                                        const Constraints::RelationalOperator &constraint, double value, IO::Astrodynamics::AberrationsEnum aberration,
+                                        const Time::TimeSpan &stepSize);
+
+        /**
+         * @brief Cached version of GeometryFinder::FindWindowsOnOccultationConstraint
+         */
+        std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+        FindWindowsOnOccultationConstraint(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow, int observerId,
+                                           int targetId, const std::string &targetFrame, const std::string &targetShape,
+                                           int frontBodyId, const std::string &frontFrame, const std::string &frontShape,
+                                           const IO::Astrodynamics::OccultationType &occultationType,
+                                           IO::Astrodynamics::AberrationsEnum aberration, const IO::Astrodynamics::Time::TimeSpan &stepSize);
+
+        /**
+         * @brief Cached version of GeometryFinder::FindWindowsOnCoordinateConstraint
+         */
+        std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+        FindWindowsOnCoordinateConstraint(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow, int observerId,
+                                          int targetId, const std::string &frame, const IO::Astrodynamics::CoordinateSystem &coordinateSystem,
+                                          const IO::Astrodynamics::Coordinate &coordinate, const IO::Astrodynamics::Constraints::RelationalOperator &relationalOperator,
+                                          double value, double adjustValue, IO::Astrodynamics::AberrationsEnum aberration,
+                                          const IO::Astrodynamics::Time::TimeSpan &stepSize);
+
+        /**
+         * @brief Cached version of GeometryFinder::FindWindowsOnIlluminationConstraint
+         */
+        std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+        FindWindowsOnIlluminationConstraint(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow, int observerId,
+                                            const std::string &illuminationSource, int targetBody, const std::string &fixedFrame,
+                                            const double coordinates[3], const IlluminationAngle &illuminationType,
+                                            const IO::Astrodynamics::Constraints::RelationalOperator &relationalOperator, double value, double adjustValue,
+                                            IO::Astrodynamics::AberrationsEnum aberration, const IO::Astrodynamics::Time::TimeSpan &stepSize,
+                                            const std::string &method);
+
+        /**
+         * @brief Cached version of GeometryFinder::FindWindowsInFieldOfViewConstraint
+         */
+        std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+        FindWindowsInFieldOfViewConstraint(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow, int observerId, int instrumentId,
+                                           int targetId, const std::string &targetFrame, const std::string &targetShape,
+                                           IO::Astrodynamics::AberrationsEnum aberration, const IO::Astrodynamics::Time::TimeSpan &stepSize);
+
+        /**
+         * @brief Remove all cached results
+         */
+        void Clear();
+
+        /**
+         * @brief Get hit/miss statistics
+         *
+         * @return GeometryFinderCacheStatistics
+         */
+        [[nodiscard]] GeometryFinderCacheStatistics GetStatistics() const;
+
+        /**
+         * @brief Reset hit/miss statistics
+         */
+        void ResetStatistics();
+
+        /**
+         * @brief Get the number of cached queries
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] std::size_t GetSize() const;
+
+        /**
+         * @brief Set the maximum number of cached queries. Least recently used queries are evicted first.
+         *
+         * @param maximumEntries
+         */
+        void SetMaximumEntries(std::size_t maximumEntries);
+    };
+}
+
+#endif //IO_GEOMETRYFINDERCACHE_H
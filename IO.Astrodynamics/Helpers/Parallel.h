@@ -0,0 +1,95 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_PARALLEL_H
+#define IO_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace IO::Astrodynamics::Helpers
+{
+    /**
+     * @brief Get the threads count used for a work
+     *
+     * @param requested Requested threads count, hardware concurrency when 0
+     * @param maximum Largest useful threads count
+     * @return unsigned int Between 1 and maximum
+     */
+    inline unsigned int ThreadCount(unsigned int requested, std::size_t maximum)
+    {
+        if (requested == 0)
+        {
+            requested = std::max(1u, std::thread::hardware_concurrency());
+        }
+        return static_cast<unsigned int>(std::max<std::size_t>(1, std::min<std::size_t>(requested, maximum)));
+    }
+
+    /**
+     * @brief Run work(thread) once per thread, thread 0 runs on the calling thread.
+     * All threads are joined before the first exception thrown by a work is rethrown.
+     *
+     * @tparam Work Callable with an unsigned int thread index
+     * @param threadCount Threads count, at least one
+     * @param work
+     */
+    template<typename Work>
+    void RunThreads(unsigned int threadCount, const Work &work)
+    {
+        std::vector<std::exception_ptr> errors(threadCount);
+        auto run = [&](unsigned int thread)
+        {
+            try
+            {
+                work(thread);
+            }
+            catch (...)
+            {
+                errors[thread] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (unsigned int t = 1; t < threadCount; ++t)
+        {
+            threads.emplace_back(run, t);
+        }
+        run(0);
+        for (auto &thread: threads)
+        {
+            thread.join();
+        }
+        for (const auto &error: errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    /**
+     * @brief Split [0, count[ in contiguous chunks and run work(thread, begin, end) once per thread, chunks may be empty
+     *
+     * @tparam Work Callable with an unsigned int thread index and a std::size_t range
+     * @param threadCount Threads count, at least one
+     * @param count Items count
+     * @param work
+     */
+    template<typename Work>
+    void ParallelFor(unsigned int threadCount, std::size_t count, const Work &work)
+    {
+        const std::size_t chunk = (count + threadCount - 1) / threadCount;
+        RunThreads(threadCount, [&](unsigned int thread)
+        {
+            work(thread, std::min(count, thread * chunk), std::min(count, (thread + 1) * chunk));
+        });
+    }
+}
+
+#endif //IO_PARALLEL_H
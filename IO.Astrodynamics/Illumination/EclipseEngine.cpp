@@ -0,0 +1,264 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <EclipseEngine.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+#include <SpiceUsr.h>
+
+IO::Astrodynamics::Illumination::EclipseEngine::EclipseEngine(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> source,
+                                                              std::vector<std::shared_ptr<IO::Astrodynamics::Body::CelestialBody>> occultingBodies,
+                                                              std::vector<int> spacecraftIds) : m_source{std::move(source)},
+                                                                                                m_occultingBodies{std::move(occultingBodies)},
+                                                                                                m_spacecraftIds{std::move(spacecraftIds)}
+{
+    if (!m_source)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Source must be defined");
+    }
+
+    if (m_occultingBodies.empty())
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("At least one occulting body must be defined");
+    }
+
+    //Radii are converted to km to work with spice positions
+    m_sourceRadius = m_source->GetRadius().GetX() * 1E-03;
+    m_occultingRadii.reserve(m_occultingBodies.size());
+    for (const auto &body: m_occultingBodies)
+    {
+        m_occultingRadii.push_back(body->GetRadius().GetX() * 1E-03);
+    }
+}
+
+double IO::Astrodynamics::Illumination::EclipseEngine::ShadowFraction(const double observerToSource[3], double sourceRadius, const double observerToOccultingBody[3],
+                                                                      double occultingBodyRadius)
+{
+    const double sourceDistance = std::sqrt(observerToSource[0] * observerToSource[0] + observerToSource[1] * observerToSource[1] +
+                                            observerToSource[2] * observerToSource[2]);
+    const double occultingDistance = std::sqrt(observerToOccultingBody[0] * observerToOccultingBody[0] + observerToOccultingBody[1] * observerToOccultingBody[1] +
+                                               observerToOccultingBody[2] * observerToOccultingBody[2]);
+
+    //Observer inside occulting body
+    if (occultingDistance <= occultingBodyRadius)
+    {
+        return 1.0;
+    }
+
+    //Occulting body behind the source
+    if (occultingDistance - occultingBodyRadius >= sourceDistance)
+    {
+        return 0.0;
+    }
+
+    //Apparent radii and apparent separation
+    const double a = std::asin(std::min(1.0, sourceRadius / sourceDistance));
+    const double b = std::asin(std::min(1.0, occultingBodyRadius / occultingDistance));
+    const double cosC = (observerToSource[0] * observerToOccultingBody[0] + observerToSource[1] * observerToOccultingBody[1] +
+                         observerToSource[2] * observerToOccultingBody[2]) / (sourceDistance * occultingDistance);
+    const double c = std::acos(std::clamp(cosC, -1.0, 1.0));
+
+    if (c >= a + b)
+    {
+        return 0.0;
+    }
+
+    //Umbra
+    if (c <= b - a)
+    {
+        return 1.0;
+    }
+
+    //Antumbra, occulting disk inside source disk
+    if (c <= a - b)
+    {
+        return (b * b) / (a * a);
+    }
+
+    //Penumbra, area of disks intersection
+    const double x = std::acos(std::clamp((c * c + a * a - b * b) / (2.0 * c * a), -1.0, 1.0));
+    const double y = std::acos(std::clamp((c * c + b * b - a * a) / (2.0 * c * b), -1.0, 1.0));
+    const double area = a * a * x + b * b * y - 0.5 * std::sqrt(std::max(0.0, (-c + a + b) * (c + a - b) * (c - a + b) * (c + a + b)));
+
+    return std::clamp(area / (IO::Astrodynamics::Constants::PI * a * a), 0.0, 1.0);
+}
+
+void IO::Astrodynamics::Illumination::EclipseEngine::ReadPositions(double epoch, double *occultingPositions, double *spacecraftPositions) const
+{
+    SpiceDouble lt;
+    const std::string sourceId{std::to_string(m_source->GetId())};
+    for (size_t i = 0; i < m_occultingBodies.size(); ++i)
+    {
+        spkpos_c(std::to_string(m_occultingBodies[i]->GetId()).c_str(), epoch, "J2000", "NONE", sourceId.c_str(), occultingPositions + i * 3, &lt);
+    }
+
+    if (spacecraftPositions)
+    {
+        for (size_t i = 0; i < m_spacecraftIds.size(); ++i)
+        {
+            spkpos_c(std::to_string(m_spacecraftIds[i]).c_str(), epoch, "J2000", "NONE", sourceId.c_str(), spacecraftPositions + i * 3, &lt);
+        }
+    }
+}
+
+double IO::Astrodynamics::Illumination::EclipseEngine::ShadowFraction(const double *occultingPositions, const double *spacecraftPosition) const
+{
+    //Positions are relative to the source
+    const double toSource[3]{-spacecraftPosition[0], -spacecraftPosition[1], -spacecraftPosition[2]};
+    double lit{1.0};
+    for (size_t i = 0; i < m_occultingRadii.size(); ++i)
+    {
+        const double *occultingPosition = occultingPositions + i * 3;
+        const double toOccultingBody[3]{occultingPosition[0] - spacecraftPosition[0], occultingPosition[1] - spacecraftPosition[1],
+                                        occultingPosition[2] - spacecraftPosition[2]};
+        lit *= 1.0 - ShadowFraction(toSource, m_sourceRadius, toOccultingBody, m_occultingRadii[i]);
+    }
+    return 1.0 - lit;
+}
+
+std::vector<double> IO::Astrodynamics::Illumination::EclipseEngine::ComputeShadowFractions(const std::vector<IO::Astrodynamics::Time::TDB> &epochs) const
+{
+    const size_t spacecraftCount = m_spacecraftIds.size();
+    std::vector<double> fractions(epochs.size() * spacecraftCount);
+    std::vector<double> occultingPositions(m_occultingBodies.size() * 3);
+    std::vector<double> spacecraftPositions(spacecraftCount * 3);
+
+    for (size_t i = 0; i < epochs.size(); ++i)
+    {
+        ReadPositions(epochs[i].GetSecondsFromJ2000().count(), occultingPositions.data(), spacecraftPositions.data());
+        for (size_t j = 0; j < spacecraftCount; ++j)
+        {
+            fractions[i * spacecraftCount + j] = ShadowFraction(occultingPositions.data(), spacecraftPositions.data() + j * 3);
+        }
+    }
+
+    return fractions;
+}
+
+double IO::Astrodynamics::Illumination::EclipseEngine::Refine(int spacecraftIndex, double before, double after, bool umbra, double accuracy) const
+{
+    std::vector<double> occultingPositions(m_occultingBodies.size() * 3);
+    double spacecraftPosition[3];
+    SpiceDouble lt;
+    const std::string spacecraftId{std::to_string(m_spacecraftIds[spacecraftIndex])};
+    const std::string sourceId{std::to_string(m_source->GetId())};
+
+    auto isInShadow = [&](double epoch)
+    {
+        ReadPositions(epoch, occultingPositions.data(), nullptr);
+        spkpos_c(spacecraftId.c_str(), epoch, "J2000", "NONE", sourceId.c_str(), spacecraftPosition, &lt);
+        double fraction = ShadowFraction(occultingPositions.data(), spacecraftPosition);
+        return umbra ? fraction >= 1.0 - std::numeric_limits<double>::epsilon() : fraction > 0.0;
+    };
+
+    const bool initialState = isInShadow(before);
+    while (after - before > accuracy)
+    {
+        double middle = (before + after) * 0.5;
+        if (isInShadow(middle) == initialState)
+        {
+            before = middle;
+        } else
+        {
+            after = middle;
+        }
+    }
+
+    return (before + after) * 0.5;
+}
+
+std::vector<IO::Astrodynamics::Illumination::EclipseWindows>
+IO::Astrodynamics::Illumination::EclipseEngine::FindEclipseWindows(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                                   const IO::Astrodynamics::Time::TimeSpan &stepSize,
+                                                                   const IO::Astrodynamics::Time::TimeSpan &accuracy) const
+{
+    if (stepSize.GetSeconds().count() <= 0.0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Step size must be a positive number");
+    }
+
+    const size_t spacecraftCount = m_spacecraftIds.size();
+    const double start = searchWindow.GetStartDate().GetSecondsFromJ2000().count();
+    const double end = searchWindow.GetEndDate().GetSecondsFromJ2000().count();
+    const double step = stepSize.GetSeconds().count();
+    const double tolerance = accuracy.GetSeconds().count();
+
+    std::vector<EclipseWindows> res(spacecraftCount);
+    std::vector<double> penumbraStart(spacecraftCount, std::numeric_limits<double>::quiet_NaN());
+    std::vector<double> umbraStart(spacecraftCount, std::numeric_limits<double>::quiet_NaN());
+    std::vector<double> occultingPositions(m_occultingBodies.size() * 3);
+    std::vector<double> spacecraftPositions(spacecraftCount * 3);
+
+    auto addWindow = [](std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> &windows, double windowStart, double windowEnd)
+    {
+        windows.emplace_back(IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(windowStart)),
+                             IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(windowEnd)));
+    };
+
+    double previousEpoch{start};
+    for (size_t i = 0;; ++i)
+    {
+        const double epoch = std::min(start + static_cast<double>(i) * step, end);
+        ReadPositions(epoch, occultingPositions.data(), spacecraftPositions.data());
+
+        for (size_t j = 0; j < spacecraftCount; ++j)
+        {
+            const double fraction = ShadowFraction(occultingPositions.data(), spacecraftPositions.data() + j * 3);
+            const bool inPenumbra = fraction > 0.0;
+            const bool inUmbra = fraction >= 1.0 - std::numeric_limits<double>::epsilon();
+
+            if (inPenumbra != !std::isnan(penumbraStart[j]))
+            {
+                double transition = i == 0 ? start : Refine(static_cast<int>(j), previousEpoch, epoch, false, tolerance);
+                if (inPenumbra)
+                {
+                    penumbraStart[j] = transition;
+                } else
+                {
+                    addWindow(res[j].Penumbra, penumbraStart[j], transition);
+                    penumbraStart[j] = std::numeric_limits<double>::quiet_NaN();
+                }
+            }
+
+            if (inUmbra != !std::isnan(umbraStart[j]))
+            {
+                double transition = i == 0 ? start : Refine(static_cast<int>(j), previousEpoch, epoch, true, tolerance);
+                if (inUmbra)
+                {
+                    umbraStart[j] = transition;
+                } else
+                {
+                    addWindow(res[j].Umbra, umbraStart[j], transition);
+                    umbraStart[j] = std::numeric_limits<double>::quiet_NaN();
+                }
+            }
+        }
+
+        previousEpoch = epoch;
+        if (epoch >= end)
+        {
+            break;
+        }
+    }
+
+    for (size_t j = 0; j < spacecraftCount; ++j)
+    {
+        res[j].SpacecraftId = m_spacecraftIds[j];
+        if (!std::isnan(penumbraStart[j]))
+        {
+            addWindow(res[j].Penumbra, penumbraStart[j], end);
+        }
+        if (!std::isnan(umbraStart[j]))
+        {
+            addWindow(res[j].Umbra, umbraStart[j], end);
+        }
+    }
+
+    return res;
+}
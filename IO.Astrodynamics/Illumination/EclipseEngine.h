@@ -0,0 +1,100 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_ECLIPSEENGINE_H
+#define IO_ECLIPSEENGINE_H
+
+#include <memory>
+#include <vector>
+
+#include <CelestialBody.h>
+#include <TDB.h>
+#include <Window.h>
+
+namespace IO::Astrodynamics::Illumination
+{
+    /**
+     * @brief Eclipse windows of one spacecraft
+     */
+    struct EclipseWindows
+    {
+        int SpacecraftId{};
+        std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> Penumbra{};
+        std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> Umbra{};
+    };
+
+    /**
+     * @brief Evaluate eclipses of a fleet of spacecraft with a conical shadow model.
+     * Source and occulting bodies are considered as spheres, the shadow fraction is the part of the source disk hidden by occulting bodies disks.
+     * Source and occulting bodies positions are read once per epoch and shared by the whole fleet.
+     */
+    class EclipseEngine final
+    {
+    private:
+        const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_source;
+        const std::vector<std::shared_ptr<IO::Astrodynamics::Body::CelestialBody>> m_occultingBodies;
+        const std::vector<int> m_spacecraftIds;
+        double m_sourceRadius{};
+        std::vector<double> m_occultingRadii;
+
+        void ReadPositions(double epoch, double *occultingPositions, double *spacecraftPositions) const;
+
+        [[nodiscard]] double ShadowFraction(const double *occultingPositions, const double *spacecraftPosition) const;
+
+        [[nodiscard]] double Refine(int spacecraftIndex, double before, double after, bool umbra, double accuracy) const;
+
+    public:
+        /**
+         * @brief Construct a new Eclipse Engine
+         *
+         * @param source Light source, usually the sun
+         * @param occultingBodies Occulting bodies (Earth, Moon, ...)
+         * @param spacecraftIds Naif ids of the spacecraft, ephemeris must be available in loaded kernels
+         */
+        EclipseEngine(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> source,
+                      std::vector<std::shared_ptr<IO::Astrodynamics::Body::CelestialBody>> occultingBodies,
+                      std::vector<int> spacecraftIds);
+
+        /**
+         * @brief Compute fraction of source disk hidden by a spherical occulting body
+         *
+         * @param observerToSource Vector from observer to source
+         * @param sourceRadius
+         * @param observerToOccultingBody Vector from observer to occulting body
+         * @param occultingBodyRadius
+         * @return double 0.0 fully lit, 1.0 total eclipse
+         */
+        static double ShadowFraction(const double observerToSource[3], double sourceRadius, const double observerToOccultingBody[3], double occultingBodyRadius);
+
+        /**
+         * @brief Compute shadow fractions of each spacecraft at each epoch
+         *
+         * @param epochs
+         * @return std::vector<double> Shadow fractions, the fraction of spacecraft j at epoch i is stored at i * spacecraftCount + j
+         */
+        [[nodiscard]] std::vector<double> ComputeShadowFractions(const std::vector<IO::Astrodynamics::Time::TDB> &epochs) const;
+
+        /**
+         * @brief Find penumbra and umbra windows of each spacecraft. Entries and exits are refined by bisection.
+         *
+         * @param searchWindow
+         * @param stepSize Sampling step, eclipses shorter than the step may be missed
+         * @param accuracy Entry and exit accuracy
+         * @return std::vector<EclipseWindows> One item per spacecraft in the same order as spacecraft ids
+         */
+        [[nodiscard]] std::vector<EclipseWindows> FindEclipseWindows(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                                     const IO::Astrodynamics::Time::TimeSpan &stepSize,
+                                                                     const IO::Astrodynamics::Time::TimeSpan &accuracy) const;
+
+        /**
+         * @brief Get the spacecraft ids
+         *
+         * @return const std::vector<int>&
+         */
+        [[nodiscard]] inline const std::vector<int> &GetSpacecraftIds() const
+        { return m_spacecraftIds; }
+    };
+}
+
+#endif //IO_ECLIPSEENGINE_H
@@ -0,0 +1,377 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <EclipseFinder.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+#include <SpiceUsr.h>
+
+//Sampling step of the elongation, small enough to never miss a syzygy
+static constexpr double SYZYGY_STEP{86400.0};
+
+//Half width of the window evaluated around each syzygy
+static constexpr double ECLIPSE_HALF_WINDOW{6.0 * 3600.0};
+
+//Earth shadow enlargement due to atmosphere (Chauvenet)
+static constexpr double SHADOW_ENLARGEMENT{1.02};
+
+//Maximum moon orbit inclination on ecliptic with margin
+static constexpr double MAX_INCLINATION{5.5 * IO::Astrodynamics::Constants::DEG_RAD};
+
+IO::Astrodynamics::Illumination::EclipseFinder::EclipseFinder(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> sun,
+                                                              std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> earth,
+                                                              std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> moon,
+                                                              IO::Astrodynamics::AberrationsEnum aberration) : m_sun{std::move(sun)}, m_earth{std::move(earth)},
+                                                                                                               m_moon{std::move(moon)}, m_aberration{aberration}
+{
+    if (!m_sun || !m_earth || !m_moon)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Sun, earth and moon must be defined");
+    }
+
+    //Radii in km to work with spice positions
+    m_sunRadius = m_sun->GetRadius().GetX() * 1E-03;
+    m_earthRadius = m_earth->GetRadius().GetX() * 1E-03;
+    m_moonRadius = m_moon->GetRadius().GetX() * 1E-03;
+}
+
+void IO::Astrodynamics::Illumination::EclipseFinder::ReadPositions(double epoch, const char *frame, double sun[3], double moon[3]) const
+{
+    SpiceDouble lt;
+    const std::string earthId{std::to_string(m_earth->GetId())};
+    const std::string abcorr{IO::Astrodynamics::Aberrations::ToString(m_aberration)};
+    spkpos_c(std::to_string(m_sun->GetId()).c_str(), epoch, frame, abcorr.c_str(), earthId.c_str(), sun, &lt);
+    spkpos_c(std::to_string(m_moon->GetId()).c_str(), epoch, frame, abcorr.c_str(), earthId.c_str(), moon, &lt);
+}
+
+double IO::Astrodynamics::Illumination::EclipseFinder::Elongation(double epoch, double offset) const
+{
+    double sun[3], moon[3];
+    ReadPositions(epoch, "ECLIPJ2000", sun, moon);
+    double difference = std::atan2(moon[1], moon[0]) - std::atan2(sun[1], sun[0]) - offset;
+    return std::remainder(difference, IO::Astrodynamics::Constants::_2PI);
+}
+
+double IO::Astrodynamics::Illumination::EclipseFinder::LunarSeparation(double epoch, double &penumbraLimit, double &umbraLimit, double &moonRadius) const
+{
+    double sun[3], moon[3];
+    ReadPositions(epoch, "J2000", sun, moon);
+    const double sunDistance = std::sqrt(sun[0] * sun[0] + sun[1] * sun[1] + sun[2] * sun[2]);
+    const double moonDistance = std::sqrt(moon[0] * moon[0] + moon[1] * moon[1] + moon[2] * moon[2]);
+
+    const double moonParallax = std::asin(m_earthRadius / moonDistance);
+    const double sunParallax = std::asin(m_earthRadius / sunDistance);
+    const double sunRadius = std::asin(m_sunRadius / sunDistance);
+    moonRadius = std::asin(m_moonRadius / moonDistance);
+    penumbraLimit = SHADOW_ENLARGEMENT * (moonParallax + sunParallax + sunRadius);
+    umbraLimit = SHADOW_ENLARGEMENT * (moonParallax + sunParallax - sunRadius);
+
+    //Angle between the moon and the anti sun direction
+    const double cosSeparation = -(sun[0] * moon[0] + sun[1] * moon[1] + sun[2] * moon[2]) / (sunDistance * moonDistance);
+    return std::acos(std::clamp(cosSeparation, -1.0, 1.0));
+}
+
+double IO::Astrodynamics::Illumination::EclipseFinder::SolarAxisDistance(double epoch, double &penumbraRadius, double &umbraRadius, double &surfacePenumbraRadius,
+                                                                         double &surfaceUmbraRadius) const
+{
+    double sun[3], moon[3];
+    ReadPositions(epoch, "J2000", sun, moon);
+
+    //Shadow axis from sun through moon
+    double axis[3]{moon[0] - sun[0], moon[1] - sun[1], moon[2] - sun[2]};
+    const double sunMoonDistance = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    for (double &component: axis)
+    {
+        component /= sunMoonDistance;
+    }
+
+    //Distance from moon to the fundamental plane and distance from earth center to the axis
+    const double planeDistance = -(moon[0] * axis[0] + moon[1] * axis[1] + moon[2] * axis[2]);
+    const double closest[3]{moon[0] + planeDistance * axis[0], moon[1] + planeDistance * axis[1], moon[2] + planeDistance * axis[2]};
+    const double axisDistance = std::sqrt(closest[0] * closest[0] + closest[1] * closest[1] + closest[2] * closest[2]);
+
+    //Cones half angles, umbra radius is positive when the umbra cone vertex is beyond the considered plane
+    const double penumbraAngle = std::asin((m_sunRadius + m_moonRadius) / sunMoonDistance);
+    const double umbraAngle = std::asin((m_sunRadius - m_moonRadius) / sunMoonDistance);
+    penumbraRadius = planeDistance * std::tan(penumbraAngle) + m_moonRadius / std::cos(penumbraAngle);
+    umbraRadius = m_moonRadius / std::cos(umbraAngle) - planeDistance * std::tan(umbraAngle);
+
+    //Same radii where the axis crosses the earth surface
+    double surfaceDistance = planeDistance;
+    if (axisDistance < m_earthRadius)
+    {
+        surfaceDistance -= std::sqrt(m_earthRadius * m_earthRadius - axisDistance * axisDistance);
+    }
+    surfacePenumbraRadius = surfaceDistance * std::tan(penumbraAngle) + m_moonRadius / std::cos(penumbraAngle);
+    surfaceUmbraRadius = m_moonRadius / std::cos(umbraAngle) - surfaceDistance * std::tan(umbraAngle);
+
+    return axisDistance;
+}
+
+//Minimum of a unimodal function by golden section search
+template<typename F>
+static double GoldenSectionMinimum(const F &f, double a, double b, double accuracy)
+{
+    const double ratio = (std::sqrt(5.0) - 1.0) * 0.5;
+    double c = b - ratio * (b - a);
+    double d = a + ratio * (b - a);
+    double fc = f(c);
+    double fd = f(d);
+    while (b - a > accuracy)
+    {
+        if (fc < fd)
+        {
+            b = d;
+            d = c;
+            fd = fc;
+            c = b - ratio * (b - a);
+            fc = f(c);
+        } else
+        {
+            a = c;
+            c = d;
+            fc = fd;
+            d = a + ratio * (b - a);
+            fd = f(d);
+        }
+    }
+    return (a + b) * 0.5;
+}
+
+//Root of a function by bisection, the function sign differs at a and b
+template<typename F>
+static double Bisection(const F &f, double a, double b, double accuracy)
+{
+    const bool positiveAtA = f(a) > 0.0;
+    while (std::abs(b - a) > accuracy)
+    {
+        const double m = (a + b) * 0.5;
+        if ((f(m) > 0.0) == positiveAtA)
+        {
+            a = m;
+        } else
+        {
+            b = m;
+        }
+    }
+    return (a + b) * 0.5;
+}
+
+//Phase window where f is negative around the maximum
+template<typename F>
+static std::optional<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> FindPhase(const F &f, double start, double maximum, double end, double accuracy)
+{
+    if (f(maximum) >= 0.0)
+    {
+        return std::nullopt;
+    }
+
+    const double begin = f(start) > 0.0 ? Bisection(f, start, maximum, accuracy) : start;
+    const double finish = f(end) > 0.0 ? Bisection(f, maximum, end, accuracy) : end;
+    return IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>(IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(begin)),
+                                                                         IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(finish)));
+}
+
+std::vector<IO::Astrodynamics::Illumination::Syzygy>
+IO::Astrodynamics::Illumination::EclipseFinder::FindSyzygies(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                             const IO::Astrodynamics::Time::TimeSpan &accuracy) const
+{
+    std::vector<Syzygy> syzygies;
+    const double start = searchWindow.GetStartDate().GetSecondsFromJ2000().count();
+    const double end = searchWindow.GetEndDate().GetSecondsFromJ2000().count();
+    const double tolerance = accuracy.GetSeconds().count();
+
+    //Elongation increases by about 12° per day, new moon when it crosses 0 and full moon when it crosses 180°
+    double previousEpoch = start;
+    double previous = Elongation(start, 0.0);
+    while (previousEpoch < end)
+    {
+        const double epoch = std::min(previousEpoch + SYZYGY_STEP, end);
+        const double current = Elongation(epoch, 0.0);
+        for (const double offset: {0.0, IO::Astrodynamics::Constants::PI})
+        {
+            const double a = std::remainder(previous - offset, IO::Astrodynamics::Constants::_2PI);
+            const double b = std::remainder(current - offset, IO::Astrodynamics::Constants::_2PI);
+            if (a < 0.0 && b >= 0.0 && b - a < IO::Astrodynamics::Constants::PI)
+            {
+                const double root = Bisection([&](double t) { return Elongation(t, offset); }, previousEpoch, epoch, tolerance);
+                double sun[3], moon[3];
+                ReadPositions(root, "ECLIPJ2000", sun, moon);
+                const double latitude = std::asin(moon[2] / std::sqrt(moon[0] * moon[0] + moon[1] * moon[1] + moon[2] * moon[2]));
+                syzygies.push_back(Syzygy{IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(root)), offset == 0.0, latitude});
+            }
+        }
+        previous = current;
+        previousEpoch = epoch;
+    }
+
+    std::sort(syzygies.begin(), syzygies.end(), [](const Syzygy &a, const Syzygy &b) { return a.Epoch < b.Epoch; });
+    return syzygies;
+}
+
+std::optional<IO::Astrodynamics::Illumination::Eclipse>
+IO::Astrodynamics::Illumination::EclipseFinder::EvaluateLunar(const Syzygy &syzygy, double accuracy) const
+{
+    const double epoch = syzygy.Epoch.GetSecondsFromJ2000().count();
+    double penumbraLimit, umbraLimit, moonRadius;
+    (void) LunarSeparation(epoch, penumbraLimit, umbraLimit, moonRadius);
+
+    //Candidate screening, the minimum separation can't be lower than the latitude projected on the moon orbit
+    if (std::abs(syzygy.MoonLatitude) * std::cos(MAX_INCLINATION) > penumbraLimit + moonRadius)
+    {
+        return std::nullopt;
+    }
+
+    const double start = epoch - ECLIPSE_HALF_WINDOW;
+    const double end = epoch + ECLIPSE_HALF_WINDOW;
+    const double maximum = GoldenSectionMinimum([&](double t)
+                                                {
+                                                    double p, u, r;
+                                                    return LunarSeparation(t, p, u, r);
+                                                }, start, end, accuracy);
+
+    const double separation = LunarSeparation(maximum, penumbraLimit, umbraLimit, moonRadius);
+    if (separation >= penumbraLimit + moonRadius)
+    {
+        return std::nullopt;
+    }
+
+    double sun[3], moon[3];
+    ReadPositions(maximum, "J2000", sun, moon);
+    const double moonDistance = std::sqrt(moon[0] * moon[0] + moon[1] * moon[1] + moon[2] * moon[2]);
+
+    Eclipse eclipse;
+    eclipse.Kind = EclipseKindEnum::Lunar;
+    eclipse.Maximum = IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(maximum));
+    eclipse.Gamma = moonDistance * std::sin(separation) / m_earthRadius;
+
+    if (separation < umbraLimit - moonRadius)
+    {
+        eclipse.Type = EclipseTypeEnum::Total;
+    } else if (separation < umbraLimit + moonRadius)
+    {
+        eclipse.Type = EclipseTypeEnum::Partial;
+    } else
+    {
+        eclipse.Type = EclipseTypeEnum::Penumbral;
+    }
+
+    if (eclipse.Type == EclipseTypeEnum::Penumbral)
+    {
+        eclipse.Magnitude = (penumbraLimit + moonRadius - separation) / (2.0 * moonRadius);
+    } else
+    {
+        eclipse.Magnitude = (umbraLimit + moonRadius - separation) / (2.0 * moonRadius);
+    }
+
+    eclipse.PenumbralPhase = FindPhase([&](double t)
+                                       {
+                                           double p, u, r;
+                                           double s = LunarSeparation(t, p, u, r);
+                                           return s - (p + r);
+                                       }, start, maximum, end, accuracy);
+    eclipse.UmbralPhase = FindPhase([&](double t)
+                                    {
+                                        double p, u, r;
+                                        double s = LunarSeparation(t, p, u, r);
+                                        return s - (u + r);
+                                    }, start, maximum, end, accuracy);
+    eclipse.TotalPhase = FindPhase([&](double t)
+                                   {
+                                       double p, u, r;
+                                       double s = LunarSeparation(t, p, u, r);
+                                       return s - (u - r);
+                                   }, start, maximum, end, accuracy);
+
+    return eclipse;
+}
+
+std::optional<IO::Astrodynamics::Illumination::Eclipse>
+IO::Astrodynamics::Illumination::EclipseFinder::EvaluateSolar(const Syzygy &syzygy, double accuracy) const
+{
+    const double epoch = syzygy.Epoch.GetSecondsFromJ2000().count();
+    double sun[3], moon[3];
+    ReadPositions(epoch, "J2000", sun, moon);
+    const double sunDistance = std::sqrt(sun[0] * sun[0] + sun[1] * sun[1] + sun[2] * sun[2]);
+    const double moonDistance = std::sqrt(moon[0] * moon[0] + moon[1] * moon[1] + moon[2] * moon[2]);
+
+    //Candidate screening on geocentric separation limit
+    const double limit = std::asin(m_earthRadius / moonDistance) - std::asin(m_earthRadius / sunDistance) + std::asin(m_sunRadius / sunDistance) +
+                         std::asin(m_moonRadius / moonDistance);
+    if (std::abs(syzygy.MoonLatitude) * std::cos(MAX_INCLINATION) > limit)
+    {
+        return std::nullopt;
+    }
+
+    const double start = epoch - ECLIPSE_HALF_WINDOW;
+    const double end = epoch + ECLIPSE_HALF_WINDOW;
+    const double maximum = GoldenSectionMinimum([&](double t)
+                                                {
+                                                    double l1, l2, s1, s2;
+                                                    return SolarAxisDistance(t, l1, l2, s1, s2);
+                                                }, start, end, accuracy);
+
+    double penumbraRadius, umbraRadius, surfacePenumbraRadius, surfaceUmbraRadius;
+    const double axisDistance = SolarAxisDistance(maximum, penumbraRadius, umbraRadius, surfacePenumbraRadius, surfaceUmbraRadius);
+    if (axisDistance >= m_earthRadius + penumbraRadius)
+    {
+        return std::nullopt;
+    }
+
+    Eclipse eclipse;
+    eclipse.Kind = EclipseKindEnum::Solar;
+    eclipse.Maximum = IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(maximum));
+    eclipse.Gamma = axisDistance / m_earthRadius;
+
+    if (axisDistance < m_earthRadius)
+    {
+        eclipse.Type = surfaceUmbraRadius > 0.0 ? EclipseTypeEnum::Total : EclipseTypeEnum::Annular;
+        eclipse.Magnitude = (surfacePenumbraRadius + surfaceUmbraRadius) / (surfacePenumbraRadius - surfaceUmbraRadius);
+    } else if (axisDistance < m_earthRadius + std::abs(umbraRadius))
+    {
+        //Non-central eclipse, the axis misses the earth but the umbra or antumbra still grazes it
+        eclipse.Type = umbraRadius > 0.0 ? EclipseTypeEnum::Total : EclipseTypeEnum::Annular;
+        eclipse.Magnitude = (penumbraRadius - (axisDistance - m_earthRadius)) / (penumbraRadius - umbraRadius);
+    } else
+    {
+        eclipse.Type = EclipseTypeEnum::Partial;
+        eclipse.Magnitude = (penumbraRadius - (axisDistance - m_earthRadius)) / (penumbraRadius - umbraRadius);
+    }
+
+    eclipse.PenumbralPhase = FindPhase([&](double t)
+                                       {
+                                           double l1, l2, s1, s2;
+                                           double d = SolarAxisDistance(t, l1, l2, s1, s2);
+                                           return d - (m_earthRadius + l1);
+                                       }, start, maximum, end, accuracy);
+    eclipse.UmbralPhase = FindPhase([&](double t)
+                                    {
+                                        double l1, l2, s1, s2;
+                                        return SolarAxisDistance(t, l1, l2, s1, s2) - m_earthRadius;
+                                    }, start, maximum, end, accuracy);
+
+    return eclipse;
+}
+
+std::vector<IO::Astrodynamics::Illumination::Eclipse>
+IO::Astrodynamics::Illumination::EclipseFinder::FindEclipses(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                             const IO::Astrodynamics::Time::TimeSpan &accuracy) const
+{
+    std::vector<Eclipse> eclipses;
+    const double tolerance = accuracy.GetSeconds().count();
+    for (const auto &syzygy: FindSyzygies(searchWindow, accuracy))
+    {
+        auto eclipse = syzygy.IsNewMoon ? EvaluateSolar(syzygy, tolerance) : EvaluateLunar(syzygy, tolerance);
+        if (eclipse)
+        {
+            eclipses.push_back(*eclipse);
+        }
+    }
+
+    return eclipses;
+}
@@ -0,0 +1,128 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_ECLIPSEFINDER_H
+#define IO_ECLIPSEFINDER_H
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <Aberrations.h>
+#include <CelestialBody.h>
+#include <TDB.h>
+#include <Window.h>
+
+namespace IO::Astrodynamics::Illumination
+{
+    enum class EclipseKindEnum
+    {
+        Solar,
+        Lunar
+    };
+
+    enum class EclipseTypeEnum
+    {
+        Penumbral,
+        Partial,
+        Annular,
+        Total
+    };
+
+    /**
+     * @brief New moon or full moon
+     */
+    struct Syzygy
+    {
+        IO::Astrodynamics::Time::TDB Epoch{std::chrono::duration<double>(0.0)};
+        bool IsNewMoon{};
+
+        //Geocentric ecliptic latitude of the moon (rad)
+        double MoonLatitude{};
+    };
+
+    /**
+     * @brief Solar or lunar eclipse.
+     * Lunar eclipse : Penumbral phase P1-P4, umbral phase U1-U4 and total phase U2-U3.
+     * Solar eclipse : Penumbral phase P1-P4 when the penumbra touches the earth, umbral phase when the shadow axis crosses the earth (central eclipse).
+     */
+    struct Eclipse
+    {
+        EclipseKindEnum Kind{};
+        EclipseTypeEnum Type{};
+        IO::Astrodynamics::Time::TDB Maximum{std::chrono::duration<double>(0.0)};
+        double Magnitude{};
+
+        //Minimum distance of the shadow axis from earth center (solar) or of the moon center from the shadow axis (lunar) in earth radii
+        double Gamma{};
+        std::optional<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> PenumbralPhase;
+        std::optional<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> UmbralPhase;
+        std::optional<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> TotalPhase;
+    };
+
+    /**
+     * @brief Find solar and lunar eclipses over long periods.
+     * New and full moons are found on the sun-moon ecliptic longitude difference, candidates are screened with a latitude bound
+     * derived from apparent radii and parallaxes, then only survivors are precisely evaluated in a small window around the syzygy.
+     */
+    class EclipseFinder final
+    {
+    private:
+        const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_sun;
+        const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_earth;
+        const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_moon;
+        const IO::Astrodynamics::AberrationsEnum m_aberration;
+        double m_sunRadius{};
+        double m_earthRadius{};
+        double m_moonRadius{};
+
+        void ReadPositions(double epoch, const char *frame, double sun[3], double moon[3]) const;
+
+        [[nodiscard]] double Elongation(double epoch, double offset) const;
+
+        [[nodiscard]] double LunarSeparation(double epoch, double &penumbraLimit, double &umbraLimit, double &moonRadius) const;
+
+        [[nodiscard]] double SolarAxisDistance(double epoch, double &penumbraRadius, double &umbraRadius, double &surfacePenumbraRadius, double &surfaceUmbraRadius) const;
+
+        [[nodiscard]] std::optional<Eclipse> EvaluateLunar(const Syzygy &syzygy, double accuracy) const;
+
+        [[nodiscard]] std::optional<Eclipse> EvaluateSolar(const Syzygy &syzygy, double accuracy) const;
+
+    public:
+        /**
+         * @brief Construct a new Eclipse Finder
+         *
+         * @param sun
+         * @param earth
+         * @param moon
+         * @param aberration
+         */
+        EclipseFinder(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> sun, std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> earth,
+                      std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> moon, IO::Astrodynamics::AberrationsEnum aberration = IO::Astrodynamics::AberrationsEnum::LT);
+
+        /**
+         * @brief Find new and full moons
+         *
+         * @param searchWindow
+         * @param accuracy
+         * @return std::vector<Syzygy>
+         */
+        [[nodiscard]] std::vector<Syzygy> FindSyzygies(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                       const IO::Astrodynamics::Time::TimeSpan &accuracy = IO::Astrodynamics::Time::TimeSpan(
+                                                               std::chrono::duration<double>(1.0))) const;
+
+        /**
+         * @brief Find solar and lunar eclipses
+         *
+         * @param searchWindow
+         * @param accuracy Contact times accuracy
+         * @return std::vector<Eclipse> Eclipses sorted by maximum epoch
+         */
+        [[nodiscard]] std::vector<Eclipse> FindEclipses(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                        const IO::Astrodynamics::Time::TimeSpan &accuracy = IO::Astrodynamics::Time::TimeSpan(
+                                                                std::chrono::duration<double>(1.0))) const;
+    };
+}
+
+#endif //IO_ECLIPSEFINDER_H
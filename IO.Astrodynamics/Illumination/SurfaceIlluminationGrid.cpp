@@ -0,0 +1,178 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <SurfaceIlluminationGrid.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <InvalidArgumentException.h>
+#include <SpiceUsr.h>
+
+IO::Astrodynamics::Illumination::SurfaceIlluminationGrid::SurfaceIlluminationGrid(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> body,
+                                                                                  const std::vector<IO::Astrodynamics::Math::Vector3D> &points) : m_body{
+        std::move(body)}
+{
+    if (!m_body)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Body must be defined");
+    }
+
+    m_x.reserve(points.size());
+    m_y.reserve(points.size());
+    m_z.reserve(points.size());
+    for (const auto &point: points)
+    {
+        m_x.push_back(point.GetX());
+        m_y.push_back(point.GetY());
+        m_z.push_back(point.GetZ());
+    }
+
+    ComputeNormals();
+}
+
+IO::Astrodynamics::Illumination::SurfaceIlluminationGrid::SurfaceIlluminationGrid(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> body,
+                                                                                  const std::vector<IO::Astrodynamics::Coordinates::Planetodetic> &points) : m_body{
+        std::move(body)}
+{
+    if (!m_body)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Body must be defined");
+    }
+
+    auto radius = m_body->GetRadius();
+    const double equatorialRadius = radius.GetX() * 1E-03;
+    const double flattening = (radius.GetX() - radius.GetZ()) / radius.GetX();
+
+    m_x.reserve(points.size());
+    m_y.reserve(points.size());
+    m_z.reserve(points.size());
+    m_normalX.reserve(points.size());
+    m_normalY.reserve(points.size());
+    m_normalZ.reserve(points.size());
+
+    SpiceDouble position[3];
+    for (const auto &point: points)
+    {
+        georec_c(point.GetLongitude(), point.GetLatitude(), point.GetAltitude() * 1E-03, equatorialRadius, flattening, position);
+        m_x.push_back(position[0] * 1E+03);
+        m_y.push_back(position[1] * 1E+03);
+        m_z.push_back(position[2] * 1E+03);
+
+        //Geodetic normal
+        const double cosLat = std::cos(point.GetLatitude());
+        m_normalX.push_back(cosLat * std::cos(point.GetLongitude()));
+        m_normalY.push_back(cosLat * std::sin(point.GetLongitude()));
+        m_normalZ.push_back(std::sin(point.GetLatitude()));
+    }
+}
+
+void IO::Astrodynamics::Illumination::SurfaceIlluminationGrid::ComputeNormals()
+{
+    auto radius = m_body->GetRadius();
+    const double a2 = 1.0 / (radius.GetX() * radius.GetX());
+    const double b2 = 1.0 / (radius.GetY() * radius.GetY());
+    const double c2 = 1.0 / (radius.GetZ() * radius.GetZ());
+
+    const std::size_t count = m_x.size();
+    m_normalX.resize(count);
+    m_normalY.resize(count);
+    m_normalZ.resize(count);
+
+    //Ellipsoid gradient
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const double nx = m_x[i] * a2;
+        const double ny = m_y[i] * b2;
+        const double nz = m_z[i] * c2;
+        const double norm = std::sqrt(nx * nx + ny * ny + nz * nz);
+        if (norm <= 0.0)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Surface point can't be located at body center");
+        }
+        m_normalX[i] = nx / norm;
+        m_normalY[i] = ny / norm;
+        m_normalZ[i] = nz / norm;
+    }
+}
+
+void IO::Astrodynamics::Illumination::SurfaceIlluminationGrid::Evaluate(const double sourcePosition[3], const double observerPosition[3], double *incidence,
+                                                                        double *emission, double *phase) const
+{
+    const std::size_t count = m_x.size();
+    const double sx = sourcePosition[0], sy = sourcePosition[1], sz = sourcePosition[2];
+    const double ox = observerPosition[0], oy = observerPosition[1], oz = observerPosition[2];
+    const double *x = m_x.data(), *y = m_y.data(), *z = m_z.data();
+    const double *nx = m_normalX.data(), *ny = m_normalY.data(), *nz = m_normalZ.data();
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const double tsx = sx - x[i], tsy = sy - y[i], tsz = sz - z[i];
+        const double tox = ox - x[i], toy = oy - y[i], toz = oz - z[i];
+        const double invSource = 1.0 / std::sqrt(tsx * tsx + tsy * tsy + tsz * tsz);
+        const double invObserver = 1.0 / std::sqrt(tox * tox + toy * toy + toz * toz);
+
+        const double cosIncidence = (nx[i] * tsx + ny[i] * tsy + nz[i] * tsz) * invSource;
+        const double cosEmission = (nx[i] * tox + ny[i] * toy + nz[i] * toz) * invObserver;
+        const double cosPhase = (tsx * tox + tsy * toy + tsz * toz) * invSource * invObserver;
+
+        incidence[i] = std::acos(std::clamp(cosIncidence, -1.0, 1.0));
+        emission[i] = std::acos(std::clamp(cosEmission, -1.0, 1.0));
+        phase[i] = std::acos(std::clamp(cosPhase, -1.0, 1.0));
+    }
+}
+
+IO::Astrodynamics::Illumination::SurfaceIlluminationResult
+IO::Astrodynamics::Illumination::SurfaceIlluminationGrid::Evaluate(int sourceId, int observerId, const std::vector<IO::Astrodynamics::Time::TDB> &epochs,
+                                                                   IO::Astrodynamics::AberrationsEnum aberration, bool computeDayMask, double twilight) const
+{
+    const std::size_t count = m_x.size();
+    SurfaceIlluminationResult res;
+    res.PointCount = count;
+    res.EpochCount = epochs.size();
+    res.Incidence.resize(count * epochs.size());
+    res.Emission.resize(count * epochs.size());
+    res.Phase.resize(count * epochs.size());
+    if (computeDayMask)
+    {
+        res.IsDay.resize(count * epochs.size());
+    }
+
+    const std::string bodyId{std::to_string(m_body->GetId())};
+    const std::string frame{m_body->GetBodyFixedFrame().GetName()};
+    const std::string abcorr{IO::Astrodynamics::Aberrations::ToString(aberration)};
+    const std::string source{std::to_string(sourceId)};
+    const std::string observer{std::to_string(observerId)};
+    const double dayLimit = IO::Astrodynamics::Constants::PI2 - twilight;
+
+    SpiceDouble sourcePosition[3];
+    SpiceDouble observerPosition[3];
+    SpiceDouble lt;
+    for (std::size_t i = 0; i < epochs.size(); ++i)
+    {
+        const double et = epochs[i].GetSecondsFromJ2000().count();
+        spkpos_c(source.c_str(), et, frame.c_str(), abcorr.c_str(), bodyId.c_str(), sourcePosition, &lt);
+        spkpos_c(observer.c_str(), et, frame.c_str(), abcorr.c_str(), bodyId.c_str(), observerPosition, &lt);
+        for (int k = 0; k < 3; ++k)
+        {
+            sourcePosition[k] *= 1E+03;
+            observerPosition[k] *= 1E+03;
+        }
+
+        const std::size_t offset = i * count;
+        Evaluate(sourcePosition, observerPosition, res.Incidence.data() + offset, res.Emission.data() + offset, res.Phase.data() + offset);
+
+        if (computeDayMask)
+        {
+            const double *incidence = res.Incidence.data() + offset;
+            unsigned char *isDay = res.IsDay.data() + offset;
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                isDay[j] = incidence[j] < dayLimit;
+            }
+        }
+    }
+
+    return res;
+}
@@ -0,0 +1,101 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_SURFACEILLUMINATIONGRID_H
+#define IO_SURFACEILLUMINATIONGRID_H
+
+#include <memory>
+#include <vector>
+
+#include <Aberrations.h>
+#include <CelestialBody.h>
+#include <Constants.h>
+#include <Planetodetic.h>
+#include <TDB.h>
+#include <Vector3D.h>
+
+namespace IO::Astrodynamics::Illumination
+{
+    /**
+     * @brief Illumination angles of a set of surface points at a set of epochs.
+     * Values of point j at epoch i are stored at i * PointCount + j.
+     */
+    struct SurfaceIlluminationResult
+    {
+        std::size_t PointCount{};
+        std::size_t EpochCount{};
+        std::vector<double> Incidence{};
+        std::vector<double> Emission{};
+        std::vector<double> Phase{};
+        std::vector<unsigned char> IsDay{};
+    };
+
+    /**
+     * @brief Evaluate illumination angles over many surface points of an ellipsoidal body.
+     * Surface normals are computed once, source and observer positions are read once per epoch in the body fixed frame.
+     */
+    class SurfaceIlluminationGrid final
+    {
+    private:
+        const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_body;
+        std::vector<double> m_x, m_y, m_z;
+        std::vector<double> m_normalX, m_normalY, m_normalZ;
+
+        void ComputeNormals();
+
+    public:
+        /**
+         * @brief Construct a new grid from body fixed positions
+         *
+         * @param body
+         * @param points Surface points in body fixed frame (m)
+         */
+        SurfaceIlluminationGrid(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> body, const std::vector<IO::Astrodynamics::Math::Vector3D> &points);
+
+        /**
+         * @brief Construct a new grid from planetodetic coordinates
+         *
+         * @param body
+         * @param points
+         */
+        SurfaceIlluminationGrid(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> body,
+                                const std::vector<IO::Astrodynamics::Coordinates::Planetodetic> &points);
+
+        /**
+         * @brief Compute incidence, emission and phase angles of each point at each epoch
+         *
+         * @param sourceId Illumination source naif id
+         * @param observerId Observer naif id
+         * @param epochs
+         * @param aberration
+         * @param computeDayMask True to compute the day mask
+         * @param twilight Twilight used by the day mask
+         * @return SurfaceIlluminationResult
+         */
+        [[nodiscard]] SurfaceIlluminationResult
+        Evaluate(int sourceId, int observerId, const std::vector<IO::Astrodynamics::Time::TDB> &epochs, IO::Astrodynamics::AberrationsEnum aberration,
+                 bool computeDayMask = false, double twilight = IO::Astrodynamics::Constants::OfficialTwilight) const;
+
+        /**
+         * @brief Compute angles from source and observer positions into caller buffers
+         *
+         * @param sourcePosition Source position in body fixed frame (m)
+         * @param observerPosition Observer position in body fixed frame (m)
+         * @param incidence Buffer of point count size
+         * @param emission Buffer of point count size
+         * @param phase Buffer of point count size
+         */
+        void Evaluate(const double sourcePosition[3], const double observerPosition[3], double *incidence, double *emission, double *phase) const;
+
+        /**
+         * @brief Get the point count
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] inline std::size_t GetPointCount() const
+        { return m_x.size(); }
+    };
+}
+
+#endif //IO_SURFACEILLUMINATIONGRID_H
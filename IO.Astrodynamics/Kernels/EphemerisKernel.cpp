@@ -9,6 +9,50 @@
 #include <SpiceUsr.h>
 #include <Builder.h>
 #include <InvalidArgumentException.h>
+#include <algorithm>
+#include <map>
+#include <SGP4.h>
+
+namespace
+{
+    constexpr SpiceInt MAXIMUM_COVERAGE_INTERVALS{1000};
+
+    //J2 J3 J4 KE QO SO ER AE
+    constexpr SpiceDouble TWO_LINE_ELEMENTS_GEOPHYSICS[8]{IO::Astrodynamics::Propagators::SGP4::J2, IO::Astrodynamics::Propagators::SGP4::J3,
+                                                          IO::Astrodynamics::Propagators::SGP4::J4, IO::Astrodynamics::Propagators::SGP4::KE,
+                                                          IO::Astrodynamics::Propagators::SGP4::QO, IO::Astrodynamics::Propagators::SGP4::SO,
+                                                          IO::Astrodynamics::Propagators::SGP4::ER, 1.0};
+
+    //Type 10 elements are stored in getelm_c layout, with epochs in TDB strictly increasing
+    void WriteTwoLineElementsSegment(SpiceInt handle, int objectId, const std::vector<const IO::Astrodynamics::OrbitalParameters::TLERecord *> &records,
+                                     double start, double end, const std::string &segmentId)
+    {
+        std::vector<std::pair<double, const IO::Astrodynamics::OrbitalParameters::TLERecord *>> sorted;
+        sorted.reserve(records.size());
+        for (const auto *record: records) {
+            sorted.emplace_back(IO::Astrodynamics::Time::UTC(std::chrono::duration<double>(record->Epoch)).ToTDB().GetSecondsFromJ2000().count(), record);
+        }
+        std::stable_sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+        std::vector<SpiceDouble> elements;
+        std::vector<SpiceDouble> epochs;
+        elements.reserve(sorted.size() * 10);
+        epochs.reserve(sorted.size());
+        for (std::size_t i = 0; i < sorted.size(); ++i) {
+            if (i + 1 < sorted.size() && sorted[i + 1].first == sorted[i].first) {
+                continue;
+            }
+            const auto &record = *sorted[i].second;
+            elements.insert(elements.end(), {record.FirstDerivativeOfMeanMotion, record.SecondDerivativeOfMeanMotion, record.BStar, record.Inclination,
+                                             record.RightAscendingNode, record.Eccentricity, record.PeriapsisArgument, record.MeanAnomaly, record.MeanMotion,
+                                             sorted[i].first});
+            epochs.push_back(sorted[i].first);
+        }
+
+        spkw10_c(handle, objectId, 399, "J2000", start, end, segmentId.substr(0, 40).c_str(), TWO_LINE_ELEMENTS_GEOPHYSICS, static_cast<SpiceInt>(epochs.size()),
+                 elements.data(), epochs.data());
+    }
+}
 
 IO::Astrodynamics::Kernels::EphemerisKernel::EphemerisKernel(std::string filePath, int objectId) : Kernel(std::move(filePath)), m_objectId{objectId}
 {
@@ -53,6 +97,27 @@ IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> IO::Astrodynamics:
                                                                          IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(end))};
 }
 
+std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> IO::Astrodynamics::Kernels::EphemerisKernel::GetCoverageWindows() const
+{
+    const SpiceInt MAXWIN{2 * MAXIMUM_COVERAGE_INTERVALS};
+
+    std::vector<SpiceDouble> SPICE_CELL_DIST(SPICE_CELL_CTRLSZ + MAXWIN);
+    SpiceCell cnfine = IO::Astrodynamics::Spice::Builder::CreateDoubleCell(MAXWIN, SPICE_CELL_DIST.data());
+
+    spkcov_c(m_filePath.c_str(), m_objectId, &cnfine);
+
+    std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> windows;
+    const SpiceInt count = wncard_c(&cnfine);
+    windows.reserve(count);
+    for (SpiceInt i = 0; i < count; ++i) {
+        double start;
+        double end;
+        wnfetd_c(&cnfine, i, &start, &end);
+        windows.emplace_back(IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(start)), IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(end)));
+    }
+    return windows;
+}
+
 void IO::Astrodynamics::Kernels::EphemerisKernel::WriteData(const std::vector<OrbitalParameters::StateVector> &states)
 {
 
@@ -119,6 +184,111 @@ void IO::Astrodynamics::Kernels::EphemerisKernel::WriteData(const std::vector<Or
     delete[] statesArray;
 }
 
+void IO::Astrodynamics::Kernels::EphemerisKernel::WriteConstantPosition(int centerOfMotionId, const IO::Astrodynamics::Frames::Frames &frame,
+                                                                        const IO::Astrodynamics::Math::Vector3D &position,
+                                                                        const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window)
+{
+    const double start = window.GetStartDate().GetSecondsFromJ2000().count();
+    const double end = window.GetEndDate().GetSecondsFromJ2000().count();
+    if (end <= start) {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Window must have a positive length");
+    }
+
+    if (std::filesystem::exists(m_filePath)) {
+        unload_c(m_filePath.c_str());
+        m_isLoaded = false;
+        std::filesystem::remove(m_filePath);
+        m_fileExists = false;
+    }
+
+    //Two identical states at window bounds with a linear interpolation give a constant position
+    SpiceDouble states[2][6]{{position.GetX() * 1E-03, position.GetY() * 1E-03, position.GetZ() * 1E-03, 0.0, 0.0, 0.0},
+                             {position.GetX() * 1E-03, position.GetY() * 1E-03, position.GetZ() * 1E-03, 0.0, 0.0, 0.0}};
+
+    SpiceInt handle{};
+    spkopn_c(m_filePath.c_str(), m_filePath.c_str(), IO::Astrodynamics::Parameters::CommentAreaSize, &handle);
+    spkw08_c(handle, m_objectId, centerOfMotionId, frame.ToCharArray(), start, end, "Seg1", 1, 2, states, start, end - start);
+    spkcls_c(handle);
+    m_fileExists = true;
+    furnsh_c(m_filePath.c_str());
+    m_isLoaded = true;
+}
+
+void IO::Astrodynamics::Kernels::EphemerisKernel::WriteTwoLineElements(const std::vector<IO::Astrodynamics::OrbitalParameters::TLERecord> &records,
+                                                                       const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window)
+{
+    if (records.empty()) {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Two lines elements set must have one or more");
+    }
+
+    const double start = window.GetStartDate().GetSecondsFromJ2000().count();
+    const double end = window.GetEndDate().GetSecondsFromJ2000().count();
+    if (end <= start) {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Window must have a positive length");
+    }
+
+    if (std::filesystem::exists(m_filePath)) {
+        unload_c(m_filePath.c_str());
+        m_isLoaded = false;
+        std::filesystem::remove(m_filePath);
+        m_fileExists = false;
+    }
+
+    std::vector<const IO::Astrodynamics::OrbitalParameters::TLERecord *> history;
+    history.reserve(records.size());
+    for (const auto &record: records) {
+        history.push_back(&record);
+    }
+
+    SpiceInt handle{};
+    spkopn_c(m_filePath.c_str(), m_filePath.c_str(), IO::Astrodynamics::Parameters::CommentAreaSize, &handle);
+    WriteTwoLineElementsSegment(handle, m_objectId, history, start, end, "TLE " + std::to_string(records.front().SatelliteNumber));
+    spkcls_c(handle);
+    m_fileExists = true;
+    furnsh_c(m_filePath.c_str());
+    m_isLoaded = true;
+}
+
+std::size_t IO::Astrodynamics::Kernels::EphemerisKernel::WriteTwoLineElementsCatalog(const std::string &filePath,
+                                                                                     const IO::Astrodynamics::OrbitalParameters::TLECatalog &catalog,
+                                                                                     const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window)
+{
+    if (catalog.GetSize() == 0) {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Two lines elements catalog is empty");
+    }
+
+    const double start = window.GetStartDate().GetSecondsFromJ2000().count();
+    const double end = window.GetEndDate().GetSecondsFromJ2000().count();
+    if (end <= start) {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Window must have a positive length");
+    }
+
+    //Elements history of each satellite goes in the same segment
+    std::map<std::int32_t, std::vector<const IO::Astrodynamics::OrbitalParameters::TLERecord *>> histories;
+    std::map<std::int32_t, std::size_t> lastIndexes;
+    for (std::size_t i = 0; i < catalog.GetSize(); ++i) {
+        const auto &record = catalog.GetRecord(i);
+        histories[record.SatelliteNumber].push_back(&record);
+        lastIndexes[record.SatelliteNumber] = i;
+    }
+
+    if (std::filesystem::exists(filePath)) {
+        unload_c(filePath.c_str());
+        std::filesystem::remove(filePath);
+    }
+
+    SpiceInt handle{};
+    spkopn_c(filePath.c_str(), filePath.c_str(), IO::Astrodynamics::Parameters::CommentAreaSize, &handle);
+    for (const auto &[satelliteNumber, history]: histories) {
+        auto name = catalog.GetName(lastIndexes[satelliteNumber]);
+        WriteTwoLineElementsSegment(handle, TwoLineElementsObjectId(satelliteNumber), history, start, end,
+                                    name.empty() ? "TLE " + std::to_string(satelliteNumber) : std::string(name));
+    }
+    spkcls_c(handle);
+
+    return histories.size();
+}
+
 bool IO::Astrodynamics::Kernels::EphemerisKernel::IsEvenlySpacedData(const std::vector<OrbitalParameters::StateVector> &states)
 {
 
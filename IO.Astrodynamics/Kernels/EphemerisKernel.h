@@ -7,6 +7,7 @@
 #include <Kernel.h>
 #include <StateVector.h>
 #include <Spacecraft.h>
+#include <TLECatalog.h>
 
 
 namespace IO::Astrodynamics::Kernels {
@@ -50,12 +51,70 @@ namespace IO::Astrodynamics::Kernels {
          */
         [[nodiscard]] IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> GetCoverageWindow() const override;
 
+        /**
+         * @brief Get every interval covered by the object segments, gaps between segments are excluded
+         *
+         * @return std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> Sorted disjoint windows
+         */
+        [[nodiscard]] std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> GetCoverageWindows() const;
+
+        /**
+         * @brief Get the object id
+         *
+         * @return int
+         */
+        [[nodiscard]] inline int GetObjectId() const
+        { return m_objectId; }
+
         /**
          * @brief Write date to ephemeris file
          *
          * @param states
          */
         void WriteData(const std::vector<OrbitalParameters::StateVector> &states);
+
+        /**
+         * @brief Write a constant position segment, ex. a site fixed in its body fixed frame.
+         * Rotation to other frames is composed by SPICE at read time, so the file size doesn't depend on the window length.
+         *
+         * @param centerOfMotionId
+         * @param frame Frame where the position is constant
+         * @param position Position relative to the center of motion (m)
+         * @param window Segment coverage
+         */
+        void WriteConstantPosition(int centerOfMotionId, const IO::Astrodynamics::Frames::Frames &frame, const IO::Astrodynamics::Math::Vector3D &position,
+                                   const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window);
+
+        /**
+         * @brief Write two lines elements history as a SPK type 10 segment relative to the earth.
+         * SPICE evaluates SGP4 at read time, so the file stores only the elements and there is no interpolation error.
+         *
+         * @param records Elements sets, sorted by epoch when needed. When many sets have the same epoch the last one is used
+         * @param window Segment coverage
+         */
+        void WriteTwoLineElements(const std::vector<IO::Astrodynamics::OrbitalParameters::TLERecord> &records,
+                                  const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window);
+
+        /**
+         * @brief Write a whole two lines elements catalog in one SPK file, with one type 10 segment per satellite merging its elements history.
+         * The file is not loaded.
+         *
+         * @param filePath
+         * @param catalog
+         * @param window Coverage of every segment
+         * @return std::size_t Segments count
+         */
+        static std::size_t WriteTwoLineElementsCatalog(const std::string &filePath, const IO::Astrodynamics::OrbitalParameters::TLECatalog &catalog,
+                                                       const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window);
+
+        /**
+         * @brief Get the object id used for a satellite in two lines elements catalog files
+         *
+         * @param satelliteNumber
+         * @return int -100000 - satellite number
+         */
+        static inline int TwoLineElementsObjectId(int satelliteNumber)
+        { return -100000 - satelliteNumber; }
     };
 }
 #endif
@@ -0,0 +1,330 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <LinkEngine.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <InvalidArgumentException.h>
+#include <SGP4CatalogPropagator.h>
+#include <SpiceUsr.h>
+
+namespace
+{
+    //Sampled speeds are increased to bound speeds until the next test
+    constexpr double SPEED_MARGIN = 1.2;
+    constexpr double DURATION_MARGIN = 0.9;
+
+    //A pair is tested at least every this number of steps
+    constexpr double MAXIMUM_SKIPPED_STEPS = 10.0;
+
+    struct PairEvaluation
+    {
+        bool IsAvailable{};
+
+        //Duration when the state can't change (s)
+        double SafeDuration{};
+    };
+
+    //Line of sight margin is computed in a space where the ellipsoid is a sphere, distance to the origin of the segment changes less than the endpoints speed
+    PairEvaluation EvaluatePair(const double *first, const double *second, const IO::Astrodynamics::Links::LinkConstraints &constraints, double equatorialRadius,
+                                double polarRadius, double maximumSpeed)
+    {
+        const double a = equatorialRadius + constraints.GrazingHeight;
+        const double scale = a / (polarRadius + constraints.GrazingHeight);
+        const double q1[3]{first[0], first[1], first[2] * scale};
+        const double d[3]{second[0] - first[0], second[1] - first[1], (second[2] - first[2]) * scale};
+        const double dd = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+        const double t = dd > 0.0 ? std::clamp(-(q1[0] * d[0] + q1[1] * d[1] + q1[2] * d[2]) / dd, 0.0, 1.0) : 0.0;
+        const double closest[3]{q1[0] + t * d[0], q1[1] + t * d[1], q1[2] + t * d[2]};
+        const double lineOfSightMargin = std::sqrt(closest[0] * closest[0] + closest[1] * closest[1] + closest[2] * closest[2]) - a;
+
+        const double link[3]{second[0] - first[0], second[1] - first[1], second[2] - first[2]};
+        const double range = std::sqrt(link[0] * link[0] + link[1] * link[1] + link[2] * link[2]);
+        const double rangeMargin = std::min(range - constraints.MinimumRange, constraints.MaximumRange - range);
+
+        const bool hasAngleLimits = constraints.MinimumNadirAngle > 0.0 || constraints.MaximumNadirAngle < IO::Astrodynamics::Constants::PI;
+        double angleMargin{std::numeric_limits<double>::max()};
+        const double firstDistance = std::sqrt(first[0] * first[0] + first[1] * first[1] + first[2] * first[2]);
+        const double secondDistance = std::sqrt(second[0] * second[0] + second[1] * second[1] + second[2] * second[2]);
+        if (hasAngleLimits && range > 0.0)
+        {
+            const double firstAngle = std::acos(std::clamp(-(link[0] * first[0] + link[1] * first[1] + link[2] * first[2]) / (range * firstDistance), -1.0, 1.0));
+            const double secondAngle = std::acos(std::clamp((link[0] * second[0] + link[1] * second[1] + link[2] * second[2]) / (range * secondDistance), -1.0, 1.0));
+            angleMargin = std::min({firstAngle - constraints.MinimumNadirAngle, constraints.MaximumNadirAngle - firstAngle,
+                                    secondAngle - constraints.MinimumNadirAngle, constraints.MaximumNadirAngle - secondAngle});
+        }
+
+        //Failed states
+        if (!std::isfinite(lineOfSightMargin) || !std::isfinite(range))
+        {
+            return PairEvaluation{false, 0.0};
+        }
+
+        PairEvaluation evaluation;
+        evaluation.IsAvailable = lineOfSightMargin > 0.0 && rangeMargin >= 0.0 && angleMargin >= 0.0;
+        if (maximumSpeed <= 0.0)
+        {
+            evaluation.SafeDuration = std::numeric_limits<double>::max();
+            return evaluation;
+        }
+
+        evaluation.SafeDuration = std::min(std::abs(lineOfSightMargin) / (scale * maximumSpeed), std::abs(rangeMargin) / (2.0 * maximumSpeed));
+        if (hasAngleLimits)
+        {
+            //Link and nadir directions rates are bounded while range and distances stay above half their value
+            const double distance = std::min(firstDistance, secondDistance);
+            const double angularRate = 4.0 * maximumSpeed / range + 2.0 * maximumSpeed / distance;
+            evaluation.SafeDuration = std::min({evaluation.SafeDuration, range / (4.0 * maximumSpeed), distance / (2.0 * maximumSpeed),
+                                                std::abs(angleMargin) / angularRate});
+        }
+        return evaluation;
+    }
+}
+
+IO::Astrodynamics::Links::LinkEngine::LinkEngine(const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> &centralBody, std::vector<int> spacecraftIds)
+        : m_satelliteCount{spacecraftIds.size()}, m_equatorialRadius{centralBody ? centralBody->GetRadius().GetX() : 0.0},
+          m_polarRadius{centralBody ? centralBody->GetRadius().GetZ() : 0.0}
+{
+    if (!centralBody)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Central body must be defined");
+    }
+
+    //Integer ids avoid the name to id translation of each state read
+    const std::string frame{centralBody->GetBodyFixedFrame().ToCharArray()};
+    m_readState = [ids = std::move(spacecraftIds), frame, center = centralBody->GetId()](double epoch, std::size_t index, double *state)
+    {
+        SpiceDouble lt;
+        spkgeo_c(ids[index], epoch, frame.c_str(), center, state, &lt);
+        for (int i = 0; i < 6; ++i)
+        {
+            state[i] *= 1000.0;
+        }
+    };
+    m_readStates = [readState = m_readState, count = m_satelliteCount](double epoch, double *states)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            readState(epoch, i, states + i * 6);
+        }
+    };
+}
+
+IO::Astrodynamics::Links::LinkEngine::LinkEngine(const std::vector<IO::Astrodynamics::Propagators::SGP4Elements> &elements, double equatorialRadius,
+                                                 double polarRadius) : m_satelliteCount{elements.size()}, m_equatorialRadius{equatorialRadius},
+                                                                       m_polarRadius{polarRadius}
+{
+    if (m_equatorialRadius <= 0.0 || m_polarRadius <= 0.0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Radii must be positive numbers");
+    }
+
+    auto propagator = std::make_shared<IO::Astrodynamics::Propagators::SGP4CatalogPropagator>(elements);
+    m_readState = [propagator](double epoch, std::size_t index, double *state)
+    {
+        if (propagator->GetPropagator(index).Propagate(IO::Astrodynamics::Time::TDB{std::chrono::duration<double>(epoch)}, state, state + 3) !=
+            IO::Astrodynamics::Propagators::SGP4::Status::Success)
+        {
+            std::fill(state, state + 6, std::numeric_limits<double>::quiet_NaN());
+        }
+    };
+    m_readStates = [propagator](double epoch, double *states)
+    {
+        const std::size_t count = propagator->GetSize();
+        std::vector<double> positions(count * 3), velocities(count * 3);
+        propagator->Propagate(IO::Astrodynamics::Time::TDB{std::chrono::duration<double>(epoch)}, IO::Astrodynamics::Frames::BodyFixedFrames::TEME(), positions.data(),
+                              velocities.data());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::copy(positions.begin() + static_cast<std::ptrdiff_t>(i * 3), positions.begin() + static_cast<std::ptrdiff_t>(i * 3 + 3), states + i * 6);
+            std::copy(velocities.begin() + static_cast<std::ptrdiff_t>(i * 3), velocities.begin() + static_cast<std::ptrdiff_t>(i * 3 + 3), states + i * 6 + 3);
+        }
+    };
+}
+
+bool IO::Astrodynamics::Links::LinkEngine::HasLineOfSight(const double first[3], const double second[3], double equatorialRadius, double polarRadius)
+{
+    LinkConstraints constraints;
+    return EvaluatePair(first, second, constraints, equatorialRadius, polarRadius, 0.0).IsAvailable;
+}
+
+bool IO::Astrodynamics::Links::LinkEngine::IsAvailable(const double first[3], const double second[3], const LinkConstraints &constraints, double equatorialRadius,
+                                                       double polarRadius)
+{
+    return EvaluatePair(first, second, constraints, equatorialRadius, polarRadius, 0.0).IsAvailable;
+}
+
+double IO::Astrodynamics::Links::LinkEngine::Refine(std::size_t first, std::size_t second, double before, double after, const LinkConstraints &constraints,
+                                                    double accuracy) const
+{
+    double firstState[6], secondState[6];
+    auto isAvailable = [&](double epoch)
+    {
+        m_readState(epoch, first, firstState);
+        m_readState(epoch, second, secondState);
+        return IsAvailable(firstState, secondState, constraints, m_equatorialRadius, m_polarRadius);
+    };
+
+    const bool initialState = isAvailable(before);
+    while (after - before > accuracy)
+    {
+        double middle = (before + after) * 0.5;
+        if (isAvailable(middle) == initialState)
+        {
+            before = middle;
+        } else
+        {
+            after = middle;
+        }
+    }
+
+    return (before + after) * 0.5;
+}
+
+std::vector<IO::Astrodynamics::Links::LinkWindows>
+IO::Astrodynamics::Links::LinkEngine::FindLinkWindows(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                      const IO::Astrodynamics::Time::TimeSpan &stepSize, const IO::Astrodynamics::Time::TimeSpan &accuracy,
+                                                      const LinkConstraints &constraints, const std::vector<std::pair<std::size_t, std::size_t>> &pairs,
+                                                      LinkStatistics *statistics) const
+{
+    if (stepSize.GetSeconds().count() <= 0.0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Step size must be a positive number");
+    }
+    if (accuracy.GetSeconds().count() <= 0.0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Accuracy must be a positive number");
+    }
+    if (constraints.GrazingHeight < 0.0 || constraints.MinimumRange < 0.0 || constraints.MaximumRange <= constraints.MinimumRange)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Grazing height and ranges must be positive numbers and maximum range greater than minimum range");
+    }
+    if (constraints.MinimumNadirAngle < 0.0 || constraints.MaximumNadirAngle > IO::Astrodynamics::Constants::PI ||
+        constraints.MaximumNadirAngle <= constraints.MinimumNadirAngle)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Nadir angles must be in [0, PI] and maximum angle greater than minimum angle");
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> evaluatedPairs{pairs};
+    if (evaluatedPairs.empty())
+    {
+        evaluatedPairs.reserve(m_satelliteCount * (m_satelliteCount - std::min<std::size_t>(m_satelliteCount, 1)) / 2);
+        for (std::size_t i = 0; i < m_satelliteCount; ++i)
+        {
+            for (std::size_t j = i + 1; j < m_satelliteCount; ++j)
+            {
+                evaluatedPairs.emplace_back(i, j);
+            }
+        }
+    }
+    for (const auto &pair: evaluatedPairs)
+    {
+        if (pair.first >= m_satelliteCount || pair.second >= m_satelliteCount || pair.first == pair.second)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Pairs must refer to two different satellites");
+        }
+    }
+
+    const std::size_t pairCount = evaluatedPairs.size();
+    const double start = searchWindow.GetStartDate().GetSecondsFromJ2000().count();
+    const double end = searchWindow.GetEndDate().GetSecondsFromJ2000().count();
+    const double step = stepSize.GetSeconds().count();
+    const double tolerance = accuracy.GetSeconds().count();
+
+    LinkStatistics counters;
+    std::vector<char> isAvailable(pairCount);
+    std::vector<double> nextTest(pairCount);
+    std::vector<double> windowStart(pairCount);
+    std::vector<std::vector<std::pair<double, double>>> windows(pairCount);
+    std::vector<double> states(m_satelliteCount * 6);
+
+    double previousEpoch{start};
+    for (size_t i = 0;; ++i)
+    {
+        const double epoch = std::min(start + static_cast<double>(i) * step, end);
+        m_readStates(epoch, states.data());
+
+        double maximumSpeed{};
+        for (std::size_t j = 0; j < m_satelliteCount; ++j)
+        {
+            const double *velocity = states.data() + j * 6 + 3;
+            const double speed = std::sqrt(velocity[0] * velocity[0] + velocity[1] * velocity[1] + velocity[2] * velocity[2]);
+            if (std::isfinite(speed))
+            {
+                maximumSpeed = std::max(maximumSpeed, speed);
+            }
+        }
+        maximumSpeed *= SPEED_MARGIN;
+
+        for (std::size_t p = 0; p < pairCount; ++p)
+        {
+            //State is known not to change before the next test
+            if (i > 0 && epoch < nextTest[p])
+            {
+                ++counters.Skipped;
+                continue;
+            }
+
+            ++counters.Evaluations;
+            const auto &pair = evaluatedPairs[p];
+            const auto evaluation = EvaluatePair(states.data() + pair.first * 6, states.data() + pair.second * 6, constraints, m_equatorialRadius, m_polarRadius,
+                                                 maximumSpeed);
+            if (i == 0)
+            {
+                isAvailable[p] = evaluation.IsAvailable;
+                windowStart[p] = start;
+            } else if (evaluation.IsAvailable != static_cast<bool>(isAvailable[p]))
+            {
+                ++counters.Transitions;
+                const double transition = Refine(pair.first, pair.second, previousEpoch, epoch, constraints, tolerance);
+                if (evaluation.IsAvailable)
+                {
+                    windowStart[p] = transition;
+                } else
+                {
+                    windows[p].emplace_back(windowStart[p], transition);
+                }
+                isAvailable[p] = evaluation.IsAvailable;
+            }
+            nextTest[p] = epoch + std::min(DURATION_MARGIN * evaluation.SafeDuration, MAXIMUM_SKIPPED_STEPS * step);
+        }
+
+        previousEpoch = epoch;
+        if (epoch >= end)
+        {
+            break;
+        }
+    }
+
+    std::vector<LinkWindows> res;
+    for (std::size_t p = 0; p < pairCount; ++p)
+    {
+        if (isAvailable[p])
+        {
+            windows[p].emplace_back(windowStart[p], end);
+        }
+        if (windows[p].empty())
+        {
+            continue;
+        }
+
+        LinkWindows linkWindows;
+        linkWindows.FirstIndex = evaluatedPairs[p].first;
+        linkWindows.SecondIndex = evaluatedPairs[p].second;
+        for (const auto &window: windows[p])
+        {
+            linkWindows.Windows.emplace_back(IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(window.first)),
+                                             IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(window.second)));
+        }
+        res.push_back(std::move(linkWindows));
+    }
+
+    if (statistics)
+    {
+        *statistics = counters;
+    }
+    return res;
+}
@@ -0,0 +1,149 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_LINKENGINE_H
+#define IO_LINKENGINE_H
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <CelestialBody.h>
+#include <Constants.h>
+#include <SGP4.h>
+#include <TDB.h>
+#include <Window.h>
+
+namespace IO::Astrodynamics::Links
+{
+    /**
+     * @brief Conditions for a link between two satellites
+     */
+    struct LinkConstraints
+    {
+        //Minimum height of the line of sight above the central body ellipsoid, ex. an atmosphere margin (m)
+        double GrazingHeight{};
+
+        //(m)
+        double MinimumRange{};
+        double MaximumRange{std::numeric_limits<double>::max()};
+
+        //Angle between the link and the nadir direction at both ends (rad)
+        double MinimumNadirAngle{};
+        double MaximumNadirAngle{IO::Astrodynamics::Constants::PI};
+    };
+
+    /**
+     * @brief Availability windows of a link
+     */
+    struct LinkWindows
+    {
+        std::size_t FirstIndex{};
+        std::size_t SecondIndex{};
+        std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> Windows{};
+    };
+
+    /**
+     * @brief Pairs evaluated during a search
+     */
+    struct LinkStatistics
+    {
+        std::size_t Evaluations{};
+        std::size_t Skipped{};
+        std::size_t Transitions{};
+    };
+
+    /**
+     * @brief Find inter-satellite links availability of a constellation.
+     * Every satellite state is read once per epoch and each pair is tested against an oblate central body inflated by the grazing height, range and nadir angle limits.
+     * Margins to each limit bound the time a pair keeps its state, so pairs far from a visibility boundary are not tested again until this time is elapsed.
+     * Transitions are refined by bisection.
+     */
+    class LinkEngine final
+    {
+    private:
+        const std::size_t m_satelliteCount;
+        const double m_equatorialRadius;
+        const double m_polarRadius;
+
+        //Positions (m) and velocities (m/s) in a frame where the central body polar axis is z
+        std::function<void(double, double *)> m_readStates;
+        std::function<void(double, std::size_t, double *)> m_readState;
+
+        [[nodiscard]] double Refine(std::size_t first, std::size_t second, double before, double after, const LinkConstraints &constraints, double accuracy) const;
+
+    public:
+        /**
+         * @brief Construct a new Link Engine from ephemeris available in loaded kernels.
+         * States are read in the body fixed frame of the central body.
+         *
+         * @param centralBody Occulting body, its radii define the ellipsoid
+         * @param spacecraftIds Naif ids of the satellites
+         */
+        LinkEngine(const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> &centralBody, std::vector<int> spacecraftIds);
+
+        /**
+         * @brief Construct a new Link Engine from two lines elements, satellites are propagated by SGP4 in TEME frame
+         *
+         * @param elements
+         * @param equatorialRadius Earth equatorial radius (m)
+         * @param polarRadius Earth polar radius (m)
+         */
+        explicit LinkEngine(const std::vector<IO::Astrodynamics::Propagators::SGP4Elements> &elements, double equatorialRadius = 6378137.0,
+                            double polarRadius = 6356752.314245);
+
+        /**
+         * @brief Check if the segment between two points doesn't cross an ellipsoid of revolution centered at the origin
+         *
+         * @param first (m)
+         * @param second (m)
+         * @param equatorialRadius (m)
+         * @param polarRadius (m)
+         * @return true
+         * @return false
+         */
+        static bool HasLineOfSight(const double first[3], const double second[3], double equatorialRadius, double polarRadius);
+
+        /**
+         * @brief Check link constraints between two positions
+         *
+         * @param first (m)
+         * @param second (m)
+         * @param constraints
+         * @param equatorialRadius Central body equatorial radius (m)
+         * @param polarRadius Central body polar radius (m)
+         * @return true
+         * @return false
+         */
+        static bool IsAvailable(const double first[3], const double second[3], const LinkConstraints &constraints, double equatorialRadius, double polarRadius);
+
+        /**
+         * @brief Find link windows
+         *
+         * @param searchWindow
+         * @param stepSize Sampling step, links shorter than the step may be missed
+         * @param accuracy Window boundaries accuracy
+         * @param constraints
+         * @param pairs Pairs of satellite indexes to evaluate, every pair when empty
+         * @param statistics Optional evaluations count
+         * @return std::vector<LinkWindows> Pairs having at least one window, ordered by pair
+         */
+        [[nodiscard]] std::vector<LinkWindows> FindLinkWindows(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                               const IO::Astrodynamics::Time::TimeSpan &stepSize, const IO::Astrodynamics::Time::TimeSpan &accuracy,
+                                                               const LinkConstraints &constraints,
+                                                               const std::vector<std::pair<std::size_t, std::size_t>> &pairs = {},
+                                                               LinkStatistics *statistics = nullptr) const;
+
+        /**
+         * @brief Get the satellites count
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] inline std::size_t GetSatelliteCount() const
+        { return m_satelliteCount; }
+    };
+}
+
+#endif //IO_LINKENGINE_H
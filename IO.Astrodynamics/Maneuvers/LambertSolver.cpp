@@ -0,0 +1,349 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <LambertSolver.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+
+namespace
+{
+    constexpr double TOLERANCE = 1E-13;
+
+    //Distances to the parabola (x = 1) under which Battin series, then Lagrange expressions, are used
+    constexpr double BATTIN_THRESHOLD = 0.01;
+    constexpr double LAGRANGE_THRESHOLD = 0.2;
+
+    //Under this value positions are considered collinear
+    constexpr double COLLINEAR_THRESHOLD = 1E-12;
+
+    double Norm(const double *vector)
+    {
+        return std::sqrt(vector[0] * vector[0] + vector[1] * vector[1] + vector[2] * vector[2]);
+    }
+
+    void Cross(const double *a, const double *b, double *result)
+    {
+        result[0] = a[1] * b[2] - a[2] * b[1];
+        result[1] = a[2] * b[0] - a[0] * b[2];
+        result[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    void Validate(const double *departurePosition, const double *arrivalPosition, double timeOfFlight, double mu)
+    {
+        if (!departurePosition || !arrivalPosition)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Positions must be defined");
+        }
+        if (!(timeOfFlight > 0.0) || std::isinf(timeOfFlight))
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Time of flight must be positive and finite");
+        }
+        if (!(mu > 0.0))
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Gravitational parameter must be positive");
+        }
+        for (const double *position: {departurePosition, arrivalPosition})
+        {
+            const double norm = Norm(position);
+            if (!(norm > 0.0) || std::isinf(norm))
+            {
+                throw IO::Astrodynamics::Exception::InvalidArgumentException("Positions must be finite and not null");
+            }
+        }
+    }
+
+    //Non dimensional problem and transfer frame
+    struct Geometry
+    {
+        double Lambda{};
+        double T{};
+        double Gamma{};
+        double Rho{};
+        double Sigma{};
+        double R1{};
+        double R2{};
+        double Ir1[3]{};
+        double Ir2[3]{};
+        double It1[3]{};
+        double It2[3]{};
+
+        bool Initialize(const double *r1, const double *r2, double timeOfFlight, double mu, bool isRetrograde)
+        {
+            R1 = Norm(r1);
+            R2 = Norm(r2);
+            const double c[3]{r2[0] - r1[0], r2[1] - r1[1], r2[2] - r1[2]};
+            const double chord = Norm(c);
+            const double s = 0.5 * (R1 + R2 + chord);
+            for (int i = 0; i < 3; ++i)
+            {
+                Ir1[i] = r1[i] / R1;
+                Ir2[i] = r2[i] / R2;
+            }
+            double ih[3];
+            Cross(Ir1, Ir2, ih);
+            const double hNorm = Norm(ih);
+            if (!(hNorm > COLLINEAR_THRESHOLD))
+            {
+                return false;
+            }
+            for (double &component: ih)
+            {
+                component /= hNorm;
+            }
+
+            Lambda = std::sqrt(std::max(0.0, 1.0 - chord / s));
+            if (ih[2] < 0.0)
+            {
+                Lambda = -Lambda;
+                Cross(Ir1, ih, It1);
+                Cross(Ir2, ih, It2);
+            }
+            else
+            {
+                Cross(ih, Ir1, It1);
+                Cross(ih, Ir2, It2);
+            }
+            if (isRetrograde)
+            {
+                Lambda = -Lambda;
+                for (int i = 0; i < 3; ++i)
+                {
+                    It1[i] = -It1[i];
+                    It2[i] = -It2[i];
+                }
+            }
+
+            T = std::sqrt(2.0 * mu / (s * s * s)) * timeOfFlight;
+            Gamma = std::sqrt(0.5 * mu * s);
+            Rho = (R1 - R2) / chord;
+            Sigma = std::sqrt(std::max(0.0, 1.0 - Rho * Rho));
+            return true;
+        }
+
+        void Velocities(double x, double *v1, double *v2) const
+        {
+            const double y = std::sqrt(1.0 - Lambda * Lambda + Lambda * Lambda * x * x);
+            const double radial1 = Gamma * ((Lambda * y - x) - Rho * (Lambda * y + x)) / R1;
+            const double radial2 = -Gamma * ((Lambda * y - x) + Rho * (Lambda * y + x)) / R2;
+            const double tangential = Gamma * Sigma * (y + Lambda * x);
+            for (int i = 0; i < 3; ++i)
+            {
+                v1[i] = radial1 * Ir1[i] + tangential / R1 * It1[i];
+                v2[i] = radial2 * Ir2[i] + tangential / R2 * It2[i];
+            }
+        }
+    };
+
+    double Hypergeometric(double z)
+    {
+        double sum = 1.0;
+        double term = 1.0;
+        for (int j = 0; j < 100 && std::abs(term) > std::numeric_limits<double>::epsilon() * sum; ++j)
+        {
+            term *= (3.0 + j) * (1.0 + j) / (2.5 + j) * z / (j + 1.0);
+            sum += term;
+        }
+        return sum;
+    }
+
+    //Non dimensional time of flight
+    double TimeOfFlight(double x, int revolutions, double lambda)
+    {
+        const double distance = std::abs(x - 1.0);
+        const double lambda2 = lambda * lambda;
+        if (distance < LAGRANGE_THRESHOLD && distance > BATTIN_THRESHOLD)
+        {
+            const double a = 1.0 / (1.0 - x * x);
+            if (a > 0.0)
+            {
+                const double alpha = 2.0 * std::acos(x);
+                const double beta = std::copysign(2.0 * std::asin(std::sqrt(lambda2 / a)), lambda);
+                return a * std::sqrt(a) * ((alpha - std::sin(alpha)) - (beta - std::sin(beta)) + IO::Astrodynamics::Constants::_2PI * revolutions) * 0.5;
+            }
+            const double alpha = 2.0 * std::acosh(x);
+            const double beta = std::copysign(2.0 * std::asinh(std::sqrt(-lambda2 / a)), lambda);
+            return -a * std::sqrt(-a) * ((beta - std::sinh(beta)) - (alpha - std::sinh(alpha))) * 0.5;
+        }
+
+        const double e = x * x - 1.0;
+        const double rho = std::abs(e);
+        const double z = std::sqrt(1.0 + lambda2 * e);
+        if (distance <= BATTIN_THRESHOLD)
+        {
+            const double eta = z - lambda * x;
+            const double s1 = 0.5 * (1.0 - lambda - x * eta);
+            const double q = 4.0 / 3.0 * Hypergeometric(s1);
+            const double tof = (eta * eta * eta * q + 4.0 * lambda * eta) * 0.5;
+            return revolutions > 0 ? tof + revolutions * IO::Astrodynamics::Constants::PI / std::pow(rho, 1.5) : tof;
+        }
+        const double y = std::sqrt(rho);
+        const double g = x * z - lambda * e;
+        double d;
+        if (e < 0.0)
+        {
+            d = revolutions * IO::Astrodynamics::Constants::PI + std::acos(std::clamp(g, -1.0, 1.0));
+        }
+        else
+        {
+            d = std::log(y * (z - lambda * x) + g);
+        }
+        return (x - lambda * z - d / y) / e;
+    }
+
+    //Time of flight derivatives with respect to x
+    void Derivatives(double x, double t, double lambda, double &dT, double &ddT, double &dddT)
+    {
+        const double lambda2 = lambda * lambda;
+        const double lambda3 = lambda2 * lambda;
+        const double umx2 = 1.0 - x * x;
+        const double y = std::sqrt(1.0 - lambda2 * umx2);
+        const double y2 = y * y;
+        const double y3 = y2 * y;
+        dT = (3.0 * t * x - 2.0 + 2.0 * lambda3 * x / y) / umx2;
+        ddT = (3.0 * t + 5.0 * x * dT + 2.0 * (1.0 - lambda2) * lambda3 / y3) / umx2;
+        dddT = (7.0 * x * ddT + 8.0 * dT - 6.0 * (1.0 - lambda2) * lambda2 * lambda3 * x / (y3 * y2)) / umx2;
+    }
+
+    //Householder iterations on x, steps are kept inside the domain of the revolutions count
+    double Householder(double t, double x, int revolutions, double lambda, int &iterations)
+    {
+        const double upper = revolutions > 0 ? 1.0 : std::numeric_limits<double>::infinity();
+        for (iterations = 0; iterations < IO::Astrodynamics::Maneuvers::LambertSolver::MAXIMUM_ITERATIONS;)
+        {
+            const double tof = TimeOfFlight(x, revolutions, lambda);
+            double dT, ddT, dddT;
+            Derivatives(x, tof, lambda, dT, ddT, dddT);
+            const double delta = tof - t;
+            const double dT2 = dT * dT;
+            double next = x - delta * (dT2 - delta * ddT * 0.5) / (dT * (dT2 - delta * ddT) + dddT * delta * delta / 6.0);
+            if (!(next > -1.0))
+            {
+                next = 0.5 * (x - 1.0);
+            }
+            else if (!(next < upper))
+            {
+                next = 0.5 * (x + upper);
+            }
+            ++iterations;
+            const double step = std::abs(next - x);
+            x = next;
+            if (step <= TOLERANCE)
+            {
+                break;
+            }
+        }
+        return x;
+    }
+
+    double DirectGuess(double t, double lambda)
+    {
+        const double lambda2 = lambda * lambda;
+        const double t00 = std::acos(lambda) + lambda * std::sqrt(1.0 - lambda2);
+        const double t1 = 2.0 / 3.0 * (1.0 - lambda2 * lambda);
+        if (t >= t00)
+        {
+            return -(t - t00) / (t - t00 + 4.0);
+        }
+        if (t <= t1)
+        {
+            return t1 * (t1 - t) / (0.4 * (1.0 - lambda2 * lambda2 * lambda) * t) + 1.0;
+        }
+        return std::pow(t / t00, std::log(2.0) / std::log(t1 / t00)) - 1.0;
+    }
+}
+
+std::vector<IO::Astrodynamics::Maneuvers::LambertSolution>
+IO::Astrodynamics::Maneuvers::LambertSolver::Solve(const double departurePosition[3], const double arrivalPosition[3], double timeOfFlight, double mu,
+                                                   bool isRetrograde, int maximumRevolutions)
+{
+    Validate(departurePosition, arrivalPosition, timeOfFlight, mu);
+    if (maximumRevolutions < 0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Maximum revolutions can't be negative");
+    }
+
+    std::vector<LambertSolution> solutions;
+    Geometry geometry;
+    if (!geometry.Initialize(departurePosition, arrivalPosition, timeOfFlight, mu, isRetrograde))
+    {
+        return solutions;
+    }
+    const double lambda = geometry.Lambda;
+    const double t = geometry.T;
+
+    //Feasible revolutions count, the minimum time of flight of the highest one is found with Halley iterations
+    //When the maximum is lower than the time of flight bound, its minimum time of flight is necessarily reached
+    const double revolutionsBound = std::floor(t / IO::Astrodynamics::Constants::PI);
+    int revolutions = static_cast<int>(std::min<double>(revolutionsBound, maximumRevolutions));
+    if (revolutions > 0 && revolutionsBound <= maximumRevolutions)
+    {
+        const double t0 = std::acos(lambda) + lambda * std::sqrt(1.0 - lambda * lambda) + revolutions * IO::Astrodynamics::Constants::PI;
+        if (t < t0)
+        {
+            double x = 0.0;
+            double tMin = t0;
+            for (int i = 0; i < MAXIMUM_ITERATIONS; ++i)
+            {
+                double dT, ddT, dddT;
+                Derivatives(x, tMin, lambda, dT, ddT, dddT);
+                if (dT == 0.0)
+                {
+                    break;
+                }
+                const double next = x - dT * ddT / (ddT * ddT - dT * dddT * 0.5);
+                const bool converged = std::abs(next - x) < TOLERANCE;
+                x = next;
+                tMin = TimeOfFlight(x, revolutions, lambda);
+                if (converged)
+                {
+                    break;
+                }
+            }
+            if (tMin > t)
+            {
+                --revolutions;
+            }
+        }
+    }
+
+    solutions.reserve(1 + 2 * revolutions);
+    auto &direct = solutions.emplace_back();
+    const double x = Householder(t, DirectGuess(t, lambda), 0, lambda, direct.Iterations);
+    geometry.Velocities(x, direct.DepartureVelocity, direct.ArrivalVelocity);
+
+    for (int i = 1; i <= revolutions; ++i)
+    {
+        const double left = std::pow((i * IO::Astrodynamics::Constants::PI + IO::Astrodynamics::Constants::PI) / (8.0 * t), 2.0 / 3.0);
+        const double right = std::pow(8.0 * t / (i * IO::Astrodynamics::Constants::PI), 2.0 / 3.0);
+        for (const double tmp: {left, right})
+        {
+            auto &solution = solutions.emplace_back();
+            solution.Revolutions = i;
+            solution.IsLeftBranch = tmp == left;
+            const double xi = Householder(t, (tmp - 1.0) / (tmp + 1.0), i, lambda, solution.Iterations);
+            geometry.Velocities(xi, solution.DepartureVelocity, solution.ArrivalVelocity);
+        }
+    }
+    return solutions;
+}
+
+bool IO::Astrodynamics::Maneuvers::LambertSolver::SolveDirect(const double departurePosition[3], const double arrivalPosition[3], double timeOfFlight, double mu,
+                                                              bool isRetrograde, double departureVelocity[3], double arrivalVelocity[3])
+{
+    Validate(departurePosition, arrivalPosition, timeOfFlight, mu);
+    Geometry geometry;
+    if (!geometry.Initialize(departurePosition, arrivalPosition, timeOfFlight, mu, isRetrograde))
+    {
+        return false;
+    }
+    int iterations;
+    const double x = Householder(geometry.T, DirectGuess(geometry.T, geometry.Lambda), 0, geometry.Lambda, iterations);
+    geometry.Velocities(x, departureVelocity, arrivalVelocity);
+    return true;
+}
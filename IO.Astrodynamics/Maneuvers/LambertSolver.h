@@ -0,0 +1,69 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_LAMBERTSOLVER_H
+#define IO_LAMBERTSOLVER_H
+
+#include <vector>
+
+namespace IO::Astrodynamics::Maneuvers
+{
+    /**
+     * @brief Lambert problem solution.
+     * Multi revolutions problems have two solutions per revolutions count, on the left and right branches of the time of flight curve.
+     */
+    struct LambertSolution
+    {
+        int Revolutions{};
+        bool IsLeftBranch{};
+        double DepartureVelocity[3]{};
+        double ArrivalVelocity[3]{};
+        int Iterations{};
+    };
+
+    /**
+     * @brief Lambert problem solver based on Izzo's algorithm (Revisiting Lambert's problem, 2015).
+     * The time of flight equation is solved on a single variable with Householder iterations,
+     * using Battin series near the parabola and Lagrange expressions close to it to keep full accuracy.
+     * No CSPICE call is done.
+     */
+    class LambertSolver final
+    {
+    public:
+        static constexpr int MAXIMUM_ITERATIONS{35};
+
+        /**
+         * @brief Solve the Lambert problem for every revolutions count up to the maximum
+         *
+         * @param departurePosition Position at departure (m)
+         * @param arrivalPosition Position at arrival (m)
+         * @param timeOfFlight Transfer duration (s)
+         * @param mu Gravitational parameter (m^3/s^2)
+         * @param isRetrograde Transfer orbit goes clockwise around z axis
+         * @param maximumRevolutions Maximum complete revolutions
+         * @return std::vector<LambertSolution> Direct solution then left and right branches of each feasible revolutions count,
+         * empty when positions are collinear since the transfer plane is undefined
+         */
+        static std::vector<LambertSolution> Solve(const double departurePosition[3], const double arrivalPosition[3], double timeOfFlight, double mu,
+                                                  bool isRetrograde = false, int maximumRevolutions = 0);
+
+        /**
+         * @brief Solve the Lambert problem without complete revolution.
+         * Nothing is allocated, this is the entry point of grid computations.
+         *
+         * @param departurePosition Position at departure (m)
+         * @param arrivalPosition Position at arrival (m)
+         * @param timeOfFlight Transfer duration (s)
+         * @param mu Gravitational parameter (m^3/s^2)
+         * @param isRetrograde Transfer orbit goes clockwise around z axis
+         * @param departureVelocity Output velocity at departure (m/s)
+         * @param arrivalVelocity Output velocity at arrival (m/s)
+         * @return true if solved, false when positions are collinear
+         */
+        static bool SolveDirect(const double departurePosition[3], const double arrivalPosition[3], double timeOfFlight, double mu, bool isRetrograde,
+                                double departureVelocity[3], double arrivalVelocity[3]);
+    };
+}
+
+#endif //IO_LAMBERTSOLVER_H
@@ -0,0 +1,131 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <PorkchopGrid.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <InertialFrames.h>
+#include <InvalidArgumentException.h>
+#include <LambertSolver.h>
+#include <Parallel.h>
+
+namespace
+{
+    void ReadStates(const IO::Astrodynamics::Body::CelestialBody &body, const IO::Astrodynamics::Body::CelestialBody &center,
+                    const std::vector<IO::Astrodynamics::Time::TDB> &epochs, std::vector<double> &seconds, std::vector<double> &states)
+    {
+        seconds.reserve(epochs.size());
+        states.reserve(6 * epochs.size());
+        for (const auto &epoch: epochs)
+        {
+            auto sv = body.ReadEphemeris(IO::Astrodynamics::Frames::InertialFrames::ICRF(), IO::Astrodynamics::AberrationsEnum::None, epoch, center);
+            seconds.push_back(epoch.GetSecondsFromJ2000().count());
+            const auto &position = sv.GetPosition();
+            const auto &velocity = sv.GetVelocity();
+            states.insert(states.end(), {position.GetX(), position.GetY(), position.GetZ(), velocity.GetX(), velocity.GetY(), velocity.GetZ()});
+        }
+    }
+
+    void ValidateStates(std::size_t count, const double *epochs, const double *states)
+    {
+        if (count > 0 && (!epochs || !states))
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Epochs and states must be defined");
+        }
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const double *position = states + 6 * i;
+            const double radius = std::sqrt(position[0] * position[0] + position[1] * position[1] + position[2] * position[2]);
+            if (!(radius > 0.0) || std::isinf(radius))
+            {
+                throw IO::Astrodynamics::Exception::InvalidArgumentException("Positions must be finite and not null");
+            }
+        }
+    }
+}
+
+IO::Astrodynamics::Maneuvers::PorkchopGrid::PorkchopGrid(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> departureBody,
+                                                         std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> arrivalBody,
+                                                         std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> centerBody) : m_departureBody{std::move(departureBody)},
+                                                                                                                               m_arrivalBody{std::move(arrivalBody)},
+                                                                                                                               m_centerBody{std::move(centerBody)}
+{
+    if (!m_departureBody || !m_arrivalBody || !m_centerBody)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Bodies must be defined");
+    }
+}
+
+IO::Astrodynamics::Maneuvers::PorkchopGridResult
+IO::Astrodynamics::Maneuvers::PorkchopGrid::Compute(const std::vector<IO::Astrodynamics::Time::TDB> &departureEpochs,
+                                                    const std::vector<IO::Astrodynamics::Time::TDB> &arrivalEpochs, bool isRetrograde, unsigned int threadCount) const
+{
+    //Ephemeris are read once per axis
+    std::vector<double> departureSeconds, departureStates, arrivalSeconds, arrivalStates;
+    ReadStates(*m_departureBody, *m_centerBody, departureEpochs, departureSeconds, departureStates);
+    ReadStates(*m_arrivalBody, *m_centerBody, arrivalEpochs, arrivalSeconds, arrivalStates);
+
+    PorkchopGridResult result;
+    result.DepartureCount = departureEpochs.size();
+    result.ArrivalCount = arrivalEpochs.size();
+    const std::size_t count = result.DepartureCount * result.ArrivalCount;
+    result.DepartureC3.resize(count);
+    result.ArrivalVInfinity.resize(count);
+    result.DepartureDeclination.resize(count);
+    result.TimeOfFlight.resize(count);
+    Compute(m_centerBody->GetMu(), result.DepartureCount, departureSeconds.data(), departureStates.data(), result.ArrivalCount, arrivalSeconds.data(),
+            arrivalStates.data(), isRetrograde, threadCount, result.DepartureC3.data(), result.ArrivalVInfinity.data(), result.DepartureDeclination.data(),
+            result.TimeOfFlight.data());
+    return result;
+}
+
+void IO::Astrodynamics::Maneuvers::PorkchopGrid::Compute(double mu, std::size_t departureCount, const double *departureEpochs, const double *departureStates,
+                                                         std::size_t arrivalCount, const double *arrivalEpochs, const double *arrivalStates, bool isRetrograde,
+                                                         unsigned int threadCount, double *c3, double *arrivalVInfinity, double *departureDeclination,
+                                                         double *timeOfFlight)
+{
+    if (!(mu > 0.0))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Gravitational parameter must be positive");
+    }
+    ValidateStates(departureCount, departureEpochs, departureStates);
+    ValidateStates(arrivalCount, arrivalEpochs, arrivalStates);
+    const std::size_t count = departureCount * arrivalCount;
+    if (count > 0 && (!c3 || !arrivalVInfinity || !departureDeclination || !timeOfFlight))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Output arrays must be allocated");
+    }
+
+    //Cells are evaluated in row major order, so consecutive cells share the departure state
+    auto work = [&](unsigned int, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t cell = begin; cell < end; ++cell)
+        {
+            const double *departure = departureStates + 6 * (cell / arrivalCount);
+            const double *arrival = arrivalStates + 6 * (cell % arrivalCount);
+            const double tof = arrivalEpochs[cell % arrivalCount] - departureEpochs[cell / arrivalCount];
+            timeOfFlight[cell] = tof;
+
+            double v1[3], v2[3];
+            if (!(tof > 0.0) || std::isinf(tof) || !IO::Astrodynamics::Maneuvers::LambertSolver::SolveDirect(departure, arrival, tof, mu, isRetrograde, v1, v2))
+            {
+                c3[cell] = std::numeric_limits<double>::quiet_NaN();
+                arrivalVInfinity[cell] = std::numeric_limits<double>::quiet_NaN();
+                departureDeclination[cell] = std::numeric_limits<double>::quiet_NaN();
+                continue;
+            }
+
+            const double departureExcess[3]{v1[0] - departure[3], v1[1] - departure[4], v1[2] - departure[5]};
+            const double arrivalExcess[3]{v2[0] - arrival[3], v2[1] - arrival[4], v2[2] - arrival[5]};
+            c3[cell] = departureExcess[0] * departureExcess[0] + departureExcess[1] * departureExcess[1] + departureExcess[2] * departureExcess[2];
+            arrivalVInfinity[cell] = std::sqrt(arrivalExcess[0] * arrivalExcess[0] + arrivalExcess[1] * arrivalExcess[1] + arrivalExcess[2] * arrivalExcess[2]);
+            departureDeclination[cell] = c3[cell] > 0.0 ? std::asin(std::clamp(departureExcess[2] / std::sqrt(c3[cell]), -1.0, 1.0)) : 0.0;
+        }
+    };
+
+    IO::Astrodynamics::Helpers::ParallelFor(IO::Astrodynamics::Helpers::ThreadCount(threadCount, count / MIN_CELLS_PER_THREAD), count, work);
+}
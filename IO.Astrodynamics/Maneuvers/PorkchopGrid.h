@@ -0,0 +1,97 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_PORKCHOPGRID_H
+#define IO_PORKCHOPGRID_H
+
+#include <memory>
+#include <vector>
+
+#include <CelestialBody.h>
+#include <TDB.h>
+
+namespace IO::Astrodynamics::Maneuvers
+{
+    /**
+     * @brief Direct transfers characteristics over a departure and arrival epochs grid.
+     * Values of departure i and arrival j are stored at i * ArrivalCount + j.
+     * Cells with a non positive time of flight or collinear positions are NaN.
+     */
+    struct PorkchopGridResult
+    {
+        std::size_t DepartureCount{};
+        std::size_t ArrivalCount{};
+        //Departure characteristic energy (m^2/s^2)
+        std::vector<double> DepartureC3{};
+        //Arrival hyperbolic excess velocity (m/s)
+        std::vector<double> ArrivalVInfinity{};
+        //Declination of the departure asymptote in ICRF (rad)
+        std::vector<double> DepartureDeclination{};
+        //Time of flight (s)
+        std::vector<double> TimeOfFlight{};
+    };
+
+    /**
+     * @brief Generate porkchop plots data between two bodies orbiting the same center.
+     * Bodies states are read once per grid axis epoch, then each cell only costs a Lambert problem solve.
+     * Cells are shared between threads.
+     */
+    class PorkchopGrid final
+    {
+    private:
+        const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_departureBody;
+        const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_arrivalBody;
+        const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_centerBody;
+
+    public:
+        static constexpr std::size_t MIN_CELLS_PER_THREAD{1024};
+
+        /**
+         * @brief Construct a new Porkchop Grid
+         *
+         * @param departureBody
+         * @param arrivalBody
+         * @param centerBody Center of motion of the transfer orbit
+         */
+        PorkchopGrid(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> departureBody, std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> arrivalBody,
+                     std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> centerBody);
+
+        /**
+         * @brief Compute the grid
+         *
+         * @param departureEpochs
+         * @param arrivalEpochs
+         * @param isRetrograde Transfer orbit goes clockwise around ICRF z axis
+         * @param threadCount Threads count, 0 to use hardware concurrency
+         * @return PorkchopGridResult
+         */
+        [[nodiscard]] PorkchopGridResult Compute(const std::vector<IO::Astrodynamics::Time::TDB> &departureEpochs,
+                                                 const std::vector<IO::Astrodynamics::Time::TDB> &arrivalEpochs, bool isRetrograde = false,
+                                                 unsigned int threadCount = 0) const;
+
+        /**
+         * @brief Compute the grid from states already known.
+         * Output arrays are allocated by the caller with departureCount * arrivalCount values.
+         *
+         * @param mu Gravitational parameter of the center of motion (m^3/s^2)
+         * @param departureCount
+         * @param departureEpochs Departure epochs (s)
+         * @param departureStates Departure body states, 6 values per epoch (m, m/s)
+         * @param arrivalCount
+         * @param arrivalEpochs Arrival epochs (s)
+         * @param arrivalStates Arrival body states, 6 values per epoch (m, m/s)
+         * @param isRetrograde Transfer orbit goes clockwise around z axis
+         * @param threadCount Threads count, 0 to use hardware concurrency
+         * @param c3 Departure characteristic energy (m^2/s^2)
+         * @param arrivalVInfinity Arrival hyperbolic excess velocity (m/s)
+         * @param departureDeclination Declination of the departure asymptote (rad)
+         * @param timeOfFlight Time of flight (s)
+         */
+        static void Compute(double mu, std::size_t departureCount, const double *departureEpochs, const double *departureStates, std::size_t arrivalCount,
+                            const double *arrivalEpochs, const double *arrivalStates, bool isRetrograde, unsigned int threadCount, double *c3,
+                            double *arrivalVInfinity, double *departureDeclination, double *timeOfFlight);
+    };
+}
+
+#endif //IO_PORKCHOPGRID_H
@@ -0,0 +1,69 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <HermiteGrid.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <InvalidArgumentException.h>
+
+IO::Astrodynamics::Math::HermiteGrid::HermiteGrid(std::size_t dimension, double step) : m_dimension{dimension}, m_step{step}
+{
+    if (dimension == 0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Dimension must be positive");
+    }
+    if (!(step > 0.0))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Grid step must be positive");
+    }
+}
+
+IO::Astrodynamics::Math::HermiteGrid::HermiteGrid(std::size_t dimension, double begin, double step, std::vector<double> nodes) : HermiteGrid(dimension, step)
+{
+    if (nodes.size() < 4 * dimension || nodes.size() % (2 * dimension) != 0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("At least two complete nodes are required");
+    }
+    m_begin = begin;
+    m_nodes = std::move(nodes);
+}
+
+void IO::Astrodynamics::Math::HermiteGrid::Sample(double begin, double end, const std::function<void(double, double *)> &sampler)
+{
+    //One more node on each side, so the whole window stays inside the grid
+    m_begin = begin - m_step;
+    const auto count = static_cast<std::size_t>(std::ceil((end - begin) / m_step)) + 3;
+    m_nodes.assign(2 * m_dimension * count, 0.0);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        sampler(m_begin + static_cast<double>(i) * m_step, m_nodes.data() + 2 * m_dimension * i);
+    }
+}
+
+void IO::Astrodynamics::Math::HermiteGrid::Interpolate(double epoch, double *values) const
+{
+    const std::size_t count = GetNodeCount();
+    if (count < 2)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Grid is not sampled");
+    }
+
+    const double u = (epoch - m_begin) / m_step;
+    const auto index = static_cast<std::size_t>(std::clamp(std::floor(u), 0.0, static_cast<double>(count - 2)));
+    const double s = u - static_cast<double>(index);
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+    const double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+    const double h10 = (s3 - 2.0 * s2 + s) * m_step;
+    const double h01 = -2.0 * s3 + 3.0 * s2;
+    const double h11 = (s3 - s2) * m_step;
+    const double *start = m_nodes.data() + 2 * m_dimension * index;
+    const double *end = start + 2 * m_dimension;
+    for (std::size_t i = 0; i < m_dimension; ++i)
+    {
+        values[i] = h00 * start[i] + h10 * start[i + m_dimension] + h01 * end[i] + h11 * end[i + m_dimension];
+    }
+}
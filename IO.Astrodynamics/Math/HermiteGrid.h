@@ -0,0 +1,73 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_HERMITEGRID_H
+#define IO_HERMITEGRID_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace IO::Astrodynamics::Math
+{
+    /**
+     * @brief Values and their time derivatives sampled on a regular time grid, evaluated with a cubic Hermite interpolation of the two nodes around an epoch.
+     * Sampling is done once, so expensive sources like kernels are only read when the grid is built and interpolations can be shared between threads.
+     */
+    class HermiteGrid final
+    {
+    private:
+        const std::size_t m_dimension;
+        const double m_step;
+        double m_begin{};
+        //Values then their derivatives, 2 * dimension values per node
+        std::vector<double> m_nodes;
+
+    public:
+        /**
+         * @brief Construct an empty grid, nodes are added by Sample
+         *
+         * @param dimension Values count per node
+         * @param step Grid step (s)
+         */
+        HermiteGrid(std::size_t dimension, double step);
+
+        /**
+         * @brief Construct a grid from nodes already known
+         *
+         * @param dimension Values count per node
+         * @param begin First node epoch (s)
+         * @param step Grid step (s)
+         * @param nodes Values then their derivatives, 2 * dimension values per node, at least two nodes
+         */
+        HermiteGrid(std::size_t dimension, double begin, double step, std::vector<double> nodes);
+
+        /**
+         * @brief Replace nodes by samples covering the window, with one more node on each side
+         *
+         * @param begin Window begin (s)
+         * @param end Window end (s)
+         * @param sampler Writes values then their derivatives at the given epoch, 2 * dimension values
+         */
+        void Sample(double begin, double end, const std::function<void(double, double *)> &sampler);
+
+        /**
+         * @brief Interpolate values, epochs outside the grid are extrapolated from the nearest interval
+         *
+         * @param epoch (s)
+         * @param values Output values, dimension values
+         */
+        void Interpolate(double epoch, double *values) const;
+
+        /**
+         * @brief Get the nodes count
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] inline std::size_t GetNodeCount() const
+        { return m_nodes.size() / (2 * m_dimension); }
+    };
+}
+
+#endif //IO_HERMITEGRID_H
@@ -0,0 +1,401 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <KeplerSolver.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+
+namespace
+{
+    constexpr double TOLERANCE = 4.0 * std::numeric_limits<double>::epsilon();
+
+    //Below this distance to 1, eccentricity is near parabolic and the universal solver starts from Barker's solution
+    constexpr double NEAR_PARABOLIC = 1E-02;
+
+    //Below this value, Stumpff functions are evaluated from their series
+    constexpr double STUMPFF_SERIES_LIMIT = 0.1;
+
+    //Bracket expansions allowed before iterating, each one doubles the universal anomaly
+    constexpr int MAXIMUM_EXPANSIONS = 128;
+
+    //Lanes solved together by batch solvers
+    constexpr std::size_t BLOCK_SIZE = 8;
+
+    //Halley correction, falls back to bisection when the new value leaves the bracket
+    inline double HalleyUpdate(double x, double f, double f1, double f2, double lower, double upper)
+    {
+        const double next = x - 2.0 * f * f1 / (2.0 * f1 * f1 - f * f2);
+        return (next > lower && next < upper) ? next : 0.5 * (lower + upper);
+    }
+
+    //Solve E - e sin(E) = M with M in [0, PI]
+    struct EllipticIteration
+    {
+        double MeanAnomaly{};
+        double Eccentricity{};
+        double Lower{};
+        double Upper{};
+        double Anomaly{};
+
+        void Initialize(double meanAnomaly, double eccentricity)
+        {
+            MeanAnomaly = meanAnomaly;
+            Eccentricity = eccentricity;
+            //Root is bracketed by E in [M, M + e]
+            Lower = meanAnomaly;
+            Upper = std::min(IO::Astrodynamics::Constants::PI, meanAnomaly + eccentricity);
+            Anomaly = std::min(meanAnomaly + 0.85 * eccentricity, Upper);
+        }
+
+        //Return true once converged
+        bool Step()
+        {
+            const double s = Eccentricity * std::sin(Anomaly);
+            const double c = Eccentricity * std::cos(Anomaly);
+            const double f = Anomaly - s - MeanAnomaly;
+            if (f == 0.0)
+            {
+                return true;
+            }
+            (f < 0.0 ? Lower : Upper) = Anomaly;
+            const double next = HalleyUpdate(Anomaly, f, 1.0 - c, s, Lower, Upper);
+            const bool converged = std::abs(next - Anomaly) <= TOLERANCE * std::max(1.0, Anomaly) || Upper - Lower <= TOLERANCE;
+            Anomaly = next;
+            return converged;
+        }
+    };
+
+    //Solve e sinh(H) - H = M with M >= 0
+    struct HyperbolicIteration
+    {
+        double MeanAnomaly{};
+        double Eccentricity{};
+        double Lower{};
+        double Upper{};
+        double Anomaly{};
+
+        void Initialize(double meanAnomaly, double eccentricity)
+        {
+            MeanAnomaly = meanAnomaly;
+            Eccentricity = eccentricity;
+            //e sinh(H) >= M + H gives the lower bound, (e - 1) sinh(H) <= M the upper one
+            Lower = std::asinh(meanAnomaly / eccentricity);
+            Upper = std::asinh(meanAnomaly / (eccentricity - 1.0));
+            Anomaly = std::clamp(std::log(2.0 * meanAnomaly / eccentricity + 1.8), Lower, Upper);
+        }
+
+        bool Step()
+        {
+            const double s = Eccentricity * std::sinh(Anomaly);
+            const double f = s - Anomaly - MeanAnomaly;
+            if (f == 0.0)
+            {
+                return true;
+            }
+            (f < 0.0 ? Lower : Upper) = Anomaly;
+            const double next = HalleyUpdate(Anomaly, f, Eccentricity * std::cosh(Anomaly) - 1.0, s, Lower, Upper);
+            const bool converged = std::abs(next - Anomaly) <= TOLERANCE * std::max(1.0, Anomaly) || Upper - Lower <= TOLERANCE * std::max(1.0, Upper);
+            Anomaly = next;
+            return converged;
+        }
+    };
+
+    void CheckElliptic(double eccentricity)
+    {
+        if (!(eccentricity >= 0.0 && eccentricity < 1.0))
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Eccentricity must be in [0, 1[");
+        }
+    }
+
+    void CheckHyperbolic(double eccentricity)
+    {
+        if (!(eccentricity > 1.0) || std::isinf(eccentricity))
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Eccentricity must be greater than 1");
+        }
+    }
+
+    template<typename Iteration>
+    double Solve(Iteration &iteration)
+    {
+        for (int i = 0; i < IO::Astrodynamics::Math::KeplerSolver::MAXIMUM_ITERATIONS; ++i)
+        {
+            if (iteration.Step())
+            {
+                break;
+            }
+        }
+        return iteration.Anomaly;
+    }
+
+    //Converged lanes are frozen until the whole block converged
+    template<typename Iteration>
+    void SolveBlock(Iteration *iterations, std::size_t count)
+    {
+        bool converged[BLOCK_SIZE]{};
+        for (int i = 0; i < IO::Astrodynamics::Math::KeplerSolver::MAXIMUM_ITERATIONS; ++i)
+        {
+            bool active = false;
+            for (std::size_t k = 0; k < count; ++k)
+            {
+                if (!converged[k])
+                {
+                    converged[k] = iterations[k].Step();
+                    active = active || !converged[k];
+                }
+            }
+            if (!active)
+            {
+                break;
+            }
+        }
+    }
+}
+
+double IO::Astrodynamics::Math::KeplerSolver::SolveElliptic(double meanAnomaly, double eccentricity)
+{
+    CheckElliptic(eccentricity);
+    const double m = std::remainder(meanAnomaly, IO::Astrodynamics::Constants::_2PI);
+    EllipticIteration iteration;
+    iteration.Initialize(std::abs(m), eccentricity);
+    return meanAnomaly - m + std::copysign(Solve(iteration), m);
+}
+
+double IO::Astrodynamics::Math::KeplerSolver::SolveHyperbolic(double meanAnomaly, double eccentricity)
+{
+    CheckHyperbolic(eccentricity);
+    if (meanAnomaly == 0.0)
+    {
+        return 0.0;
+    }
+    HyperbolicIteration iteration;
+    iteration.Initialize(std::abs(meanAnomaly), eccentricity);
+    return std::copysign(Solve(iteration), meanAnomaly);
+}
+
+double IO::Astrodynamics::Math::KeplerSolver::SolveParabolic(double meanAnomaly)
+{
+    //Cardano's solution of D^3 + 3D - 3M = 0, evaluated for positive M to avoid cancellation
+    const double m = std::abs(meanAnomaly);
+    const double b = std::cbrt(1.5 * m + std::sqrt(1.0 + 2.25 * m * m));
+    return std::copysign(b - 1.0 / b, meanAnomaly);
+}
+
+double IO::Astrodynamics::Math::KeplerSolver::GetStumpffC(double z)
+{
+    if (std::abs(z) < STUMPFF_SERIES_LIMIT)
+    {
+        return 1.0 / 2.0 - z * (1.0 / 24.0 - z * (1.0 / 720.0 - z * (1.0 / 40320.0 - z * (1.0 / 3628800.0 - z / 479001600.0))));
+    }
+    if (z > 0.0)
+    {
+        const double s = std::sin(0.5 * std::sqrt(z));
+        return 2.0 * s * s / z;
+    }
+    const double s = std::sinh(0.5 * std::sqrt(-z));
+    return -2.0 * s * s / z;
+}
+
+double IO::Astrodynamics::Math::KeplerSolver::GetStumpffS(double z)
+{
+    if (std::abs(z) < STUMPFF_SERIES_LIMIT)
+    {
+        return 1.0 / 6.0 - z * (1.0 / 120.0 - z * (1.0 / 5040.0 - z * (1.0 / 362880.0 - z * (1.0 / 39916800.0 - z / 6227020800.0))));
+    }
+    if (z > 0.0)
+    {
+        const double sqrtZ = std::sqrt(z);
+        return (sqrtZ - std::sin(sqrtZ)) / (z * sqrtZ);
+    }
+    const double sqrtZ = std::sqrt(-z);
+    return (std::sinh(sqrtZ) - sqrtZ) / (-z * sqrtZ);
+}
+
+double IO::Astrodynamics::Math::KeplerSolver::SolveUniversal(double elapsedTime, double mu, double periapsisRadius, double eccentricity)
+{
+    if (mu <= 0.0 || periapsisRadius <= 0.0 || !(eccentricity >= 0.0))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Gravitational parameter and periapsis radius must be positive and eccentricity can't be negative");
+    }
+
+    //Elliptic orbits are reduced to one revolution around periapsis
+    const double alpha = (1.0 - eccentricity) / periapsisRadius;
+    if (alpha > 0.0)
+    {
+        elapsedTime = std::remainder(elapsedTime, IO::Astrodynamics::Constants::_2PI / std::sqrt(mu * alpha * alpha * alpha));
+    }
+    if (elapsedTime == 0.0)
+    {
+        return 0.0;
+    }
+
+    //Starter from the conic solution
+    double chi;
+    if (std::abs(1.0 - eccentricity) < NEAR_PARABOLIC)
+    {
+        chi = std::sqrt(periapsisRadius * (1.0 + eccentricity)) *
+              SolveParabolic(std::sqrt(mu / (2.0 * periapsisRadius * periapsisRadius * periapsisRadius)) * std::abs(elapsedTime));
+    }
+    else if (alpha > 0.0)
+    {
+        chi = SolveElliptic(std::sqrt(mu * alpha * alpha * alpha) * std::abs(elapsedTime), eccentricity) / std::sqrt(alpha);
+    }
+    else
+    {
+        chi = SolveHyperbolic(std::sqrt(-mu * alpha * alpha * alpha) * std::abs(elapsedTime), eccentricity) / std::sqrt(-alpha);
+    }
+
+    //Periapsis state has a null sigma
+    return SolveUniversal(elapsedTime, mu, periapsisRadius, 0.0, alpha, std::copysign(chi, elapsedTime));
+}
+
+double IO::Astrodynamics::Math::KeplerSolver::SolveUniversal(double elapsedTime, double mu, double radius, double sigma, double alpha, double guess)
+{
+    if (elapsedTime == 0.0)
+    {
+        return 0.0;
+    }
+    const double sqrtMu = std::sqrt(mu);
+    const double target = sqrtMu * elapsedTime;
+    const double beta = 1.0 - alpha * radius;
+
+    //Starters from Vallado when no guess with the right sign is given
+    if (!(guess * elapsedTime > 0.0) || std::isinf(guess))
+    {
+        guess = target / radius;
+        if (alpha * radius > 1E-06)
+        {
+            guess = target * alpha;
+        }
+        else if (alpha * radius < -1E-06)
+        {
+            const double a = 1.0 / alpha;
+            const double argument = -2.0 * mu * alpha * elapsedTime / (sigma * sqrtMu + std::copysign(std::sqrt(-mu * a), elapsedTime) * beta);
+            if (argument > 1.0)
+            {
+                guess = std::copysign(std::sqrt(-a) * std::log(argument), elapsedTime);
+            }
+        }
+    }
+
+    auto universal = [&](double chi)
+    {
+        const double z = alpha * chi * chi;
+        return sigma * chi * chi * GetStumpffC(z) + beta * chi * chi * chi * GetStumpffS(z) + radius * chi - target;
+    };
+
+    //Universal function grows with chi since its derivative is the radius, so the root is bracketed by expanding from the guess
+    double lower, upper;
+    if (elapsedTime > 0.0)
+    {
+        lower = 0.0;
+        upper = guess;
+        for (int i = 0; i < MAXIMUM_EXPANSIONS && universal(upper) < 0.0; ++i)
+        {
+            lower = upper;
+            upper *= 2.0;
+        }
+    }
+    else
+    {
+        upper = 0.0;
+        lower = guess;
+        for (int i = 0; i < MAXIMUM_EXPANSIONS && universal(lower) > 0.0; ++i)
+        {
+            upper = lower;
+            lower *= 2.0;
+        }
+    }
+
+    double chi = std::clamp(guess, lower, upper);
+    for (int i = 0; i < MAXIMUM_ITERATIONS; ++i)
+    {
+        const double chi2 = chi * chi;
+        const double z = alpha * chi2;
+        const double c = GetStumpffC(z);
+        const double s = GetStumpffS(z);
+        const double f = sigma * chi2 * c + beta * chi2 * chi * s + radius * chi - target;
+        if (f == 0.0)
+        {
+            break;
+        }
+        (f < 0.0 ? lower : upper) = chi;
+        const double next = HalleyUpdate(chi, f, sigma * chi * (1.0 - z * s) + beta * chi2 * c + radius, sigma * (1.0 - z * c) + beta * chi * (1.0 - z * s),
+                                         lower, upper);
+        const bool converged = std::abs(next - chi) <= TOLERANCE * std::abs(chi) || upper - lower <= TOLERANCE * std::max(std::abs(lower), std::abs(upper));
+        chi = next;
+        if (converged)
+        {
+            break;
+        }
+    }
+    return chi;
+}
+
+double IO::Astrodynamics::Math::KeplerSolver::GetTrueAnomaly(double elapsedTime, double mu, double periapsisRadius, double eccentricity)
+{
+    //Perifocal position from Lagrange coefficients at periapsis
+    const double chi = SolveUniversal(elapsedTime, mu, periapsisRadius, eccentricity);
+    const double z = (1.0 - eccentricity) / periapsisRadius * chi * chi;
+    const double x = periapsisRadius - chi * chi * GetStumpffC(z);
+    const double y = std::sqrt(periapsisRadius * (1.0 + eccentricity)) * chi * (1.0 - z * GetStumpffS(z));
+    return std::atan2(y, x);
+}
+
+void IO::Astrodynamics::Math::KeplerSolver::SolveElliptic(std::size_t count, const double *meanAnomalies, const double *eccentricities, double *eccentricAnomalies)
+{
+    EllipticIteration iterations[BLOCK_SIZE];
+    double remainders[BLOCK_SIZE];
+    for (std::size_t block = 0; block < count; block += BLOCK_SIZE)
+    {
+        const std::size_t n = std::min(BLOCK_SIZE, count - block);
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            CheckElliptic(eccentricities[block + k]);
+            remainders[k] = std::remainder(meanAnomalies[block + k], IO::Astrodynamics::Constants::_2PI);
+            iterations[k].Initialize(std::abs(remainders[k]), eccentricities[block + k]);
+        }
+        SolveBlock(iterations, n);
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            eccentricAnomalies[block + k] = meanAnomalies[block + k] - remainders[k] + std::copysign(iterations[k].Anomaly, remainders[k]);
+        }
+    }
+}
+
+void IO::Astrodynamics::Math::KeplerSolver::SolveHyperbolic(std::size_t count, const double *meanAnomalies, const double *eccentricities, double *hyperbolicAnomalies)
+{
+    HyperbolicIteration iterations[BLOCK_SIZE];
+    double signs[BLOCK_SIZE];
+    for (std::size_t block = 0; block < count; block += BLOCK_SIZE)
+    {
+        const std::size_t n = std::min(BLOCK_SIZE, count - block);
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            CheckHyperbolic(eccentricities[block + k]);
+            signs[k] = meanAnomalies[block + k];
+            iterations[k].Initialize(std::abs(meanAnomalies[block + k]), eccentricities[block + k]);
+        }
+        SolveBlock(iterations, n);
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            hyperbolicAnomalies[block + k] = signs[k] == 0.0 ? 0.0 : std::copysign(iterations[k].Anomaly, signs[k]);
+        }
+    }
+}
+
+void IO::Astrodynamics::Math::KeplerSolver::GetTrueAnomaly(std::size_t count, const double *elapsedTimes, double mu, const double *periapsisRadii,
+                                                           const double *eccentricities, double *trueAnomalies)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        trueAnomalies[i] = GetTrueAnomaly(elapsedTimes[i], mu, periapsisRadii[i], eccentricities[i]);
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_KEPLERSOLVER_H
+#define IO_KEPLERSOLVER_H
+
+#include <cstddef>
+
+namespace IO::Astrodynamics::Math
+{
+    /**
+     * @brief Kepler equation solvers for every conic type.
+     * Every solver starts from an analytic guess then runs safeguarded Halley iterations inside a bracket of the root,
+     * so it converges to machine accuracy in at most MAXIMUM_ITERATIONS iterations whatever the eccentricity.
+     */
+    class KeplerSolver final
+    {
+    public:
+        static constexpr int MAXIMUM_ITERATIONS{64};
+
+        /**
+         * @brief Solve M = E - e sin(E)
+         *
+         * @param meanAnomaly Mean anomaly (rad)
+         * @param eccentricity Eccentricity in [0, 1[
+         * @return Eccentric anomaly in the same revolution than the mean anomaly
+         */
+        static double SolveElliptic(double meanAnomaly, double eccentricity);
+
+        /**
+         * @brief Solve M = e sinh(H) - H
+         *
+         * @param meanAnomaly Mean anomaly (rad)
+         * @param eccentricity Eccentricity greater than 1
+         * @return Hyperbolic anomaly
+         */
+        static double SolveHyperbolic(double meanAnomaly, double eccentricity);
+
+        /**
+         * @brief Solve Barker's equation M = D + D^3 / 3 with M = sqrt(mu / (2 q^3)) t
+         *
+         * @param meanAnomaly Parabolic mean anomaly
+         * @return D = tan(v / 2)
+         */
+        static double SolveParabolic(double meanAnomaly);
+
+        /**
+         * @brief Solve the universal Kepler equation from periapsis, valid for every conic and robust for near parabolic orbits
+         *
+         * @param elapsedTime Time since periapsis (s)
+         * @param mu Gravitational parameter (m^3/s^2)
+         * @param periapsisRadius Periapsis radius (m)
+         * @param eccentricity Eccentricity
+         * @return Universal anomaly (m^0.5)
+         */
+        static double SolveUniversal(double elapsedTime, double mu, double periapsisRadius, double eccentricity);
+
+        /**
+         * @brief Solve the universal Kepler equation sqrt(mu) t = sigma chi^2 C(z) + (1 - alpha r) chi^3 S(z) + r chi from any state, with z = alpha chi^2.
+         * The root is bracketed by expanding from the guess, a guess of the wrong sign or not finite is replaced by Vallado's starter.
+         *
+         * @param elapsedTime Time from the state (s)
+         * @param mu Gravitational parameter (m^3/s^2)
+         * @param radius Radius of the state (m)
+         * @param sigma r.v / sqrt(mu) of the state (m^0.5)
+         * @param alpha Inverse of semi major axis, 2 / r - v^2 / mu (1/m)
+         * @param guess Initial universal anomaly (m^0.5)
+         * @return Universal anomaly (m^0.5)
+         */
+        static double SolveUniversal(double elapsedTime, double mu, double radius, double sigma, double alpha, double guess);
+
+        /**
+         * @brief Get the true anomaly after a given time since periapsis, for every conic
+         *
+         * @param elapsedTime Time since periapsis (s)
+         * @param mu Gravitational parameter (m^3/s^2)
+         * @param periapsisRadius Periapsis radius (m)
+         * @param eccentricity Eccentricity
+         * @return True anomaly in ]-PI, PI]
+         */
+        static double GetTrueAnomaly(double elapsedTime, double mu, double periapsisRadius, double eccentricity);
+
+        /**
+         * @brief Stumpff function C(z) = (1 - cos(sqrt(z))) / z
+         */
+        static double GetStumpffC(double z);
+
+        /**
+         * @brief Stumpff function S(z) = (sqrt(z) - sin(sqrt(z))) / sqrt(z)^3
+         */
+        static double GetStumpffS(double z);
+
+        /**
+         * @brief Solve elliptic Kepler equation of many objects
+         *
+         * @param count Objects count
+         * @param meanAnomalies Mean anomalies (rad)
+         * @param eccentricities Eccentricities in [0, 1[
+         * @param eccentricAnomalies Eccentric anomalies, may be the mean anomalies array
+         */
+        static void SolveElliptic(std::size_t count, const double *meanAnomalies, const double *eccentricities, double *eccentricAnomalies);
+
+        /**
+         * @brief Solve hyperbolic Kepler equation of many objects
+         *
+         * @param count Objects count
+         * @param meanAnomalies Mean anomalies (rad)
+         * @param eccentricities Eccentricities greater than 1
+         * @param hyperbolicAnomalies Hyperbolic anomalies, may be the mean anomalies array
+         */
+        static void SolveHyperbolic(std::size_t count, const double *meanAnomalies, const double *eccentricities, double *hyperbolicAnomalies);
+
+        /**
+         * @brief Get true anomalies of many objects orbiting the same body
+         *
+         * @param count Objects count
+         * @param elapsedTimes Times since periapsis (s)
+         * @param mu Gravitational parameter (m^3/s^2)
+         * @param periapsisRadii Periapsis radii (m)
+         * @param eccentricities Eccentricities
+         * @param trueAnomalies True anomalies in ]-PI, PI]
+         */
+        static void GetTrueAnomaly(std::size_t count, const double *elapsedTimes, double mu, const double *periapsisRadii, const double *eccentricities,
+                                   double *trueAnomalies);
+    };
+}
+
+#endif //IO_KEPLERSOLVER_H
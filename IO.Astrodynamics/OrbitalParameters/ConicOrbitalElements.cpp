@@ -42,12 +42,12 @@ IO::Astrodynamics::OrbitalParameters::StateVector IO::Astrodynamics::OrbitalPara
 
 IO::Astrodynamics::Math::Vector3D IO::Astrodynamics::OrbitalParameters::ConicOrbitalElements::GetSpecificAngularMomentum() const
 {
-	return ToStateVector(m_epoch).GetSpecificAngularMomentum();
+	return GetStateVectorAtEpoch().GetSpecificAngularMomentum();
 }
 
 double IO::Astrodynamics::OrbitalParameters::ConicOrbitalElements::GetSpecificOrbitalEnergy() const
 {
-	return ToStateVector(m_epoch).GetSpecificOrbitalEnergy();
+	return GetStateVectorAtEpoch().GetSpecificOrbitalEnergy();
 }
 
 double IO::Astrodynamics::OrbitalParameters::ConicOrbitalElements::GetPerifocalDistance() const
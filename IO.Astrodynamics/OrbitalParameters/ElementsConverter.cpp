@@ -0,0 +1,446 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <ElementsConverter.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+#include <KeplerSolver.h>
+
+namespace
+{
+    //Below this value eccentricity or node vector are considered null
+    constexpr double SINGULARITY_TOLERANCE = 1E-11;
+    constexpr int MAXIMUM_ITERATIONS = 50;
+    constexpr double ANOMALY_TOLERANCE = 1E-15;
+    constexpr double NOT_A_NUMBER = std::numeric_limits<double>::quiet_NaN();
+
+    using Conversion = void (*)(double mu, const double *input, double *output);
+    using BatchConversion = void (*)(std::size_t count, double mu, const double *input, double *output);
+
+    inline double Normalize(double angle)
+    {
+        const double result = std::fmod(angle, IO::Astrodynamics::Constants::_2PI);
+        return result < 0.0 ? result + IO::Astrodynamics::Constants::_2PI : result;
+    }
+
+    inline double Dot(const double a[3], const double b[3])
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    inline void Cross(const double a[3], const double b[3], double result[3])
+    {
+        result[0] = a[1] * b[2] - a[2] * b[1];
+        result[1] = a[2] * b[0] - a[0] * b[2];
+        result[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    void SetNaN(double output[6])
+    {
+        std::fill(output, output + 6, NOT_A_NUMBER);
+    }
+
+    double TrueFromMean(double meanAnomaly, double eccentricity)
+    {
+        if (eccentricity >= 0.0 && eccentricity < 1.0)
+        {
+            const double e = IO::Astrodynamics::Math::KeplerSolver::SolveElliptic(meanAnomaly, eccentricity);
+            return 2.0 * std::atan2(std::sqrt(1.0 + eccentricity) * std::sin(0.5 * e), std::sqrt(1.0 - eccentricity) * std::cos(0.5 * e));
+        }
+        if (eccentricity > 1.0)
+        {
+            const double h = IO::Astrodynamics::Math::KeplerSolver::SolveHyperbolic(meanAnomaly, eccentricity);
+            return 2.0 * std::atan2(std::sqrt(eccentricity + 1.0) * std::sinh(0.5 * h), std::sqrt(eccentricity - 1.0) * std::cosh(0.5 * h));
+        }
+        return NOT_A_NUMBER;
+    }
+
+    //Mean anomaly from true anomaly, normalized for elliptic orbits only since hyperbolic mean anomaly is unbounded
+    double MeanFromTrue(double trueAnomaly, double eccentricity)
+    {
+        if (eccentricity < 1.0)
+        {
+            const double e = 2.0 * std::atan2(std::sqrt(1.0 - eccentricity) * std::sin(0.5 * trueAnomaly), std::sqrt(1.0 + eccentricity) * std::cos(0.5 * trueAnomaly));
+            return Normalize(e - eccentricity * std::sin(e));
+        }
+        if (eccentricity > 1.0)
+        {
+            const double h = 2.0 * std::atanh(std::sqrt((eccentricity - 1.0) / (eccentricity + 1.0)) * std::tan(0.5 * std::remainder(trueAnomaly, IO::Astrodynamics::Constants::_2PI)));
+            return eccentricity * std::sinh(h) - h;
+        }
+        return NOT_A_NUMBER;
+    }
+
+    //Equinoctial frame unit vectors from chi = tan(i/2) sin(O) and psi = tan(i/2) cos(O)
+    void EquinoctialFrame(double chi, double psi, double f[3], double g[3])
+    {
+        const double s = 1.0 / (1.0 + chi * chi + psi * psi);
+        f[0] = (1.0 - chi * chi + psi * psi) * s;
+        f[1] = 2.0 * chi * psi * s;
+        f[2] = -2.0 * chi * s;
+        g[0] = 2.0 * chi * psi * s;
+        g[1] = (1.0 + chi * chi - psi * psi) * s;
+        g[2] = 2.0 * psi * s;
+    }
+
+    //Quantities shared by all conversions from a state vector
+    struct StateGeometry
+    {
+        double Radius;
+        double AngularMomentum[3];
+        double AngularMomentumNorm;
+        double Eccentricity[3];
+        double InverseSemiMajorAxis;
+        double Chi;
+        double Psi;
+    };
+
+    StateGeometry Analyze(double mu, const double state[6])
+    {
+        StateGeometry geometry{};
+        const double *r = state;
+        const double *v = state + 3;
+        geometry.Radius = std::sqrt(Dot(r, r));
+        const double v2 = Dot(v, v);
+        const double rv = Dot(r, v);
+        Cross(r, v, geometry.AngularMomentum);
+        geometry.AngularMomentumNorm = std::sqrt(Dot(geometry.AngularMomentum, geometry.AngularMomentum));
+        for (int i = 0; i < 3; ++i)
+        {
+            geometry.Eccentricity[i] = ((v2 - mu / geometry.Radius) * r[i] - rv * v[i]) / mu;
+        }
+        geometry.InverseSemiMajorAxis = 2.0 / geometry.Radius - v2 / mu;
+
+        //Retrograde equatorial orbits give infinite values
+        const double *h = geometry.AngularMomentum;
+        const double denominator = geometry.AngularMomentumNorm + h[2];
+        geometry.Chi = h[0] / denominator;
+        geometry.Psi = -h[1] / denominator;
+        return geometry;
+    }
+
+    void StateToKeplerian(double mu, const double *input, double *output)
+    {
+        const StateGeometry geometry = Analyze(mu, input);
+        const double *h = geometry.AngularMomentum;
+        const double w[3]{h[0] / geometry.AngularMomentumNorm, h[1] / geometry.AngularMomentumNorm, h[2] / geometry.AngularMomentumNorm};
+        const double e = std::sqrt(Dot(geometry.Eccentricity, geometry.Eccentricity));
+        const double nodeNorm = std::sqrt(h[0] * h[0] + h[1] * h[1]);
+
+        //Node direction, x axis for equatorial orbits
+        const bool isInclined = nodeNorm > SINGULARITY_TOLERANCE * geometry.AngularMomentumNorm;
+        const double node[3]{isInclined ? -h[1] / nodeNorm : 1.0, isInclined ? h[0] / nodeNorm : 0.0, 0.0};
+
+        //Periapsis direction, node direction for circular orbits
+        const bool isEccentric = e > SINGULARITY_TOLERANCE;
+        const double periapsis[3]{isEccentric ? geometry.Eccentricity[0] / e : node[0], isEccentric ? geometry.Eccentricity[1] / e : node[1],
+                                  isEccentric ? geometry.Eccentricity[2] / e : node[2]};
+
+        double wn[3], q[3];
+        Cross(w, node, wn);
+        Cross(w, periapsis, q);
+        const double trueAnomaly = std::atan2(Dot(input, q), Dot(input, periapsis));
+
+        output[0] = 1.0 / geometry.InverseSemiMajorAxis;
+        output[1] = e;
+        output[2] = std::atan2(nodeNorm, h[2]);
+        output[3] = isInclined ? Normalize(std::atan2(h[0], -h[1])) : 0.0;
+        output[4] = Normalize(std::atan2(Dot(periapsis, wn), Dot(periapsis, node)));
+        output[5] = MeanFromTrue(trueAnomaly, e);
+    }
+
+    void KeplerianToState(double mu, const double *input, double *output)
+    {
+        const double a = input[0];
+        const double e = input[1];
+        const double trueAnomaly = TrueFromMean(input[5], e);
+        const double p = a * (1.0 - e * e);
+
+        const double cosO = std::cos(input[3]), sinO = std::sin(input[3]);
+        const double cosI = std::cos(input[2]), sinI = std::sin(input[2]);
+        const double cosW = std::cos(input[4]), sinW = std::sin(input[4]);
+        const double periapsis[3]{cosO * cosW - sinO * sinW * cosI, sinO * cosW + cosO * sinW * cosI, sinW * sinI};
+        const double q[3]{-cosO * sinW - sinO * cosW * cosI, -sinO * sinW + cosO * cosW * cosI, cosW * sinI};
+
+        const double cosV = std::cos(trueAnomaly), sinV = std::sin(trueAnomaly);
+        const double r = p / (1.0 + e * cosV);
+        const double x = r * cosV, y = r * sinV;
+        const double speed = std::sqrt(mu / p);
+        const double vx = -speed * sinV, vy = speed * (e + cosV);
+        for (int i = 0; i < 3; ++i)
+        {
+            output[i] = x * periapsis[i] + y * q[i];
+            output[i + 3] = vx * periapsis[i] + vy * q[i];
+        }
+    }
+
+    void StateToEquinoctial(double mu, const double *input, double *output)
+    {
+        const StateGeometry geometry = Analyze(mu, input);
+        if (geometry.InverseSemiMajorAxis <= 0.0)
+        {
+            SetNaN(output);
+            return;
+        }
+        const double a = 1.0 / geometry.InverseSemiMajorAxis;
+        double f[3], g[3];
+        EquinoctialFrame(geometry.Chi, geometry.Psi, f, g);
+        const double af = Dot(geometry.Eccentricity, f);
+        const double ag = Dot(geometry.Eccentricity, g);
+        const double x1 = Dot(input, f);
+        const double y1 = Dot(input, g);
+        const double b = std::sqrt(1.0 - af * af - ag * ag);
+        const double beta = 1.0 / (1.0 + b);
+        const double cosF = af + ((1.0 - af * af * beta) * x1 - af * ag * beta * y1) / (a * b);
+        const double sinF = ag + ((1.0 - ag * ag * beta) * y1 - af * ag * beta * x1) / (a * b);
+        const double eccentricLongitude = std::atan2(sinF, cosF);
+
+        output[0] = a;
+        output[1] = ag;
+        output[2] = af;
+        output[3] = geometry.Chi;
+        output[4] = geometry.Psi;
+        output[5] = Normalize(eccentricLongitude + ag * cosF - af * sinF);
+    }
+
+    void EquinoctialToState(double mu, const double *input, double *output)
+    {
+        const double a = input[0];
+        const double ag = input[1];
+        const double af = input[2];
+        if (a <= 0.0 || af * af + ag * ag >= 1.0)
+        {
+            SetNaN(output);
+            return;
+        }
+
+        //Generalized Kepler equation in eccentric longitude
+        const double lambda = input[5];
+        double eccentricLongitude = lambda;
+        for (int i = 0; i < MAXIMUM_ITERATIONS; ++i)
+        {
+            const double delta = (eccentricLongitude + ag * std::cos(eccentricLongitude) - af * std::sin(eccentricLongitude) - lambda) /
+                                 (1.0 - ag * std::sin(eccentricLongitude) - af * std::cos(eccentricLongitude));
+            eccentricLongitude -= delta;
+            if (std::abs(delta) < ANOMALY_TOLERANCE * std::max(1.0, std::abs(eccentricLongitude)))
+            {
+                break;
+            }
+        }
+
+        const double cosF = std::cos(eccentricLongitude), sinF = std::sin(eccentricLongitude);
+        const double beta = 1.0 / (1.0 + std::sqrt(1.0 - af * af - ag * ag));
+        const double x1 = a * ((1.0 - ag * ag * beta) * cosF + af * ag * beta * sinF - af);
+        const double y1 = a * ((1.0 - af * af * beta) * sinF + af * ag * beta * cosF - ag);
+        const double r = a * (1.0 - af * cosF - ag * sinF);
+        const double factor = std::sqrt(mu / a) * a / r;
+        const double vx1 = factor * (af * ag * beta * cosF - (1.0 - ag * ag * beta) * sinF);
+        const double vy1 = factor * ((1.0 - af * af * beta) * cosF - af * ag * beta * sinF);
+
+        double f[3], g[3];
+        EquinoctialFrame(input[3], input[4], f, g);
+        for (int i = 0; i < 3; ++i)
+        {
+            output[i] = x1 * f[i] + y1 * g[i];
+            output[i + 3] = vx1 * f[i] + vy1 * g[i];
+        }
+    }
+
+    void StateToModifiedEquinoctial(double mu, const double *input, double *output)
+    {
+        const StateGeometry geometry = Analyze(mu, input);
+        double f[3], g[3];
+        EquinoctialFrame(geometry.Chi, geometry.Psi, f, g);
+
+        output[0] = geometry.AngularMomentumNorm * geometry.AngularMomentumNorm / mu;
+        output[1] = Dot(geometry.Eccentricity, f);
+        output[2] = Dot(geometry.Eccentricity, g);
+        output[3] = geometry.Psi;
+        output[4] = geometry.Chi;
+        output[5] = Normalize(std::atan2(Dot(input, g), Dot(input, f)));
+    }
+
+    void ModifiedEquinoctialToState(double mu, const double *input, double *output)
+    {
+        const double p = input[0];
+        const double f = input[1];
+        const double g = input[2];
+        const double h = input[3];
+        const double k = input[4];
+        const double cosL = std::cos(input[5]), sinL = std::sin(input[5]);
+
+        const double alpha2 = h * h - k * k;
+        const double s2 = 1.0 + h * h + k * k;
+        const double r = p / (1.0 + f * cosL + g * sinL);
+        const double positionFactor = r / s2;
+        const double velocityFactor = -std::sqrt(mu / p) / s2;
+
+        output[0] = positionFactor * (cosL + alpha2 * cosL + 2.0 * h * k * sinL);
+        output[1] = positionFactor * (sinL - alpha2 * sinL + 2.0 * h * k * cosL);
+        output[2] = positionFactor * 2.0 * (h * sinL - k * cosL);
+        output[3] = velocityFactor * (sinL + alpha2 * sinL - 2.0 * h * k * cosL + g - 2.0 * f * h * k + alpha2 * g);
+        output[4] = velocityFactor * (-cosL + alpha2 * cosL + 2.0 * h * k * sinL - f + 2.0 * g * h * k + alpha2 * f);
+        output[5] = velocityFactor * -2.0 * (h * cosL + k * sinL + f * h + g * k);
+    }
+
+    void KeplerianToEquinoctial(double, const double *input, double *output)
+    {
+        const double e = input[1];
+        if (input[0] <= 0.0 || e >= 1.0)
+        {
+            SetNaN(output);
+            return;
+        }
+        const double longitudeOfPeriapsis = input[3] + input[4];
+        const double t = std::tan(0.5 * input[2]);
+        output[0] = input[0];
+        output[1] = e * std::sin(longitudeOfPeriapsis);
+        output[2] = e * std::cos(longitudeOfPeriapsis);
+        output[3] = t * std::sin(input[3]);
+        output[4] = t * std::cos(input[3]);
+        output[5] = Normalize(input[5] + longitudeOfPeriapsis);
+    }
+
+    //Node longitude, periapsis argument and inclination from equinoctial components, 0 for undefined angles
+    void EquinoctialAngles(double e, double sinPeriapsis, double cosPeriapsis, double sinNode, double cosNode, double &inclination, double &node,
+                           double &longitudeOfPeriapsis)
+    {
+        const double t = std::sqrt(sinNode * sinNode + cosNode * cosNode);
+        inclination = 2.0 * std::atan(t);
+        node = t > SINGULARITY_TOLERANCE ? Normalize(std::atan2(sinNode, cosNode)) : 0.0;
+        longitudeOfPeriapsis = e > SINGULARITY_TOLERANCE ? std::atan2(sinPeriapsis, cosPeriapsis) : node;
+    }
+
+    void EquinoctialToKeplerian(double, const double *input, double *output)
+    {
+        const double e = std::sqrt(input[1] * input[1] + input[2] * input[2]);
+        double inclination, node, longitudeOfPeriapsis;
+        EquinoctialAngles(e, input[1], input[2], input[3], input[4], inclination, node, longitudeOfPeriapsis);
+        output[0] = input[0];
+        output[1] = e;
+        output[2] = inclination;
+        output[3] = node;
+        output[4] = Normalize(longitudeOfPeriapsis - node);
+        output[5] = Normalize(input[5] - longitudeOfPeriapsis);
+    }
+
+    void KeplerianToModifiedEquinoctial(double, const double *input, double *output)
+    {
+        const double e = input[1];
+        const double longitudeOfPeriapsis = input[3] + input[4];
+        const double t = std::tan(0.5 * input[2]);
+        output[0] = input[0] * (1.0 - e * e);
+        output[1] = e * std::cos(longitudeOfPeriapsis);
+        output[2] = e * std::sin(longitudeOfPeriapsis);
+        output[3] = t * std::cos(input[3]);
+        output[4] = t * std::sin(input[3]);
+        output[5] = Normalize(longitudeOfPeriapsis + TrueFromMean(input[5], e));
+    }
+
+    void ModifiedEquinoctialToKeplerian(double, const double *input, double *output)
+    {
+        const double e = std::sqrt(input[1] * input[1] + input[2] * input[2]);
+        double inclination, node, longitudeOfPeriapsis;
+        EquinoctialAngles(e, input[2], input[1], input[4], input[3], inclination, node, longitudeOfPeriapsis);
+        output[0] = input[0] / (1.0 - e * e);
+        output[1] = e;
+        output[2] = inclination;
+        output[3] = node;
+        output[4] = Normalize(longitudeOfPeriapsis - node);
+        output[5] = MeanFromTrue(input[5] - longitudeOfPeriapsis, e);
+    }
+
+    void EquinoctialToModifiedEquinoctial(double, const double *input, double *output)
+    {
+        const double e2 = input[1] * input[1] + input[2] * input[2];
+        if (input[0] <= 0.0 || e2 >= 1.0)
+        {
+            SetNaN(output);
+            return;
+        }
+        const double longitudeOfPeriapsis = std::atan2(input[1], input[2]);
+        output[0] = input[0] * (1.0 - e2);
+        output[1] = input[2];
+        output[2] = input[1];
+        output[3] = input[4];
+        output[4] = input[3];
+        output[5] = Normalize(longitudeOfPeriapsis + TrueFromMean(input[5] - longitudeOfPeriapsis, std::sqrt(e2)));
+    }
+
+    void ModifiedEquinoctialToEquinoctial(double, const double *input, double *output)
+    {
+        const double e2 = input[1] * input[1] + input[2] * input[2];
+        if (e2 >= 1.0)
+        {
+            SetNaN(output);
+            return;
+        }
+        const double longitudeOfPeriapsis = std::atan2(input[2], input[1]);
+        output[0] = input[0] / (1.0 - e2);
+        output[1] = input[2];
+        output[2] = input[1];
+        output[3] = input[4];
+        output[4] = input[3];
+        output[5] = Normalize(longitudeOfPeriapsis + MeanFromTrue(input[5] - longitudeOfPeriapsis, std::sqrt(e2)));
+    }
+
+    //Conversion known at compile time so that it is inlined in the loop over the whole batch
+    template<Conversion conversion>
+    void ConvertBatch(std::size_t count, double mu, const double *inputElements, double *outputElements)
+    {
+        double in[6], out[6];
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (std::size_t j = 0; j < 6; ++j)
+            {
+                in[j] = inputElements[j * count + i];
+            }
+            conversion(mu, in, out);
+            for (std::size_t j = 0; j < 6; ++j)
+            {
+                outputElements[j * count + i] = out[j];
+            }
+        }
+    }
+
+    void CopyBatch(std::size_t count, double, const double *inputElements, double *outputElements)
+    {
+        std::copy(inputElements, inputElements + 6 * count, outputElements);
+    }
+
+    //Indexed by input then output type
+    constexpr BatchConversion CONVERSIONS[4][4]{
+            {CopyBatch,                                ConvertBatch<StateToKeplerian>,               ConvertBatch<StateToEquinoctial>,               ConvertBatch<StateToModifiedEquinoctial>},
+            {ConvertBatch<KeplerianToState>,           CopyBatch,                                    ConvertBatch<KeplerianToEquinoctial>,           ConvertBatch<KeplerianToModifiedEquinoctial>},
+            {ConvertBatch<EquinoctialToState>,         ConvertBatch<EquinoctialToKeplerian>,         CopyBatch,                                      ConvertBatch<EquinoctialToModifiedEquinoctial>},
+            {ConvertBatch<ModifiedEquinoctialToState>, ConvertBatch<ModifiedEquinoctialToKeplerian>, ConvertBatch<ModifiedEquinoctialToEquinoctial>, CopyBatch}
+    };
+}
+
+void IO::Astrodynamics::OrbitalParameters::ElementsConverter::Convert(ElementsType input, ElementsType output, std::size_t count, double mu, const double *inputElements,
+                                                                       double *outputElements)
+{
+    const auto inputIndex = static_cast<std::size_t>(input);
+    const auto outputIndex = static_cast<std::size_t>(output);
+    if (inputIndex > 3 || outputIndex > 3)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Unknown orbital elements type");
+    }
+    if (mu <= 0.0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Gravitational parameter must be positive");
+    }
+    if (count > 0 && (inputElements == nullptr || outputElements == nullptr))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Elements buffers must be provided");
+    }
+
+    //Single dispatch for the whole batch
+    CONVERSIONS[inputIndex][outputIndex](count, mu, inputElements, outputElements);
+}
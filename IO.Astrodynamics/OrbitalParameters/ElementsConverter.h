@@ -0,0 +1,51 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_ELEMENTSCONVERTER_H
+#define IO_ELEMENTSCONVERTER_H
+
+#include <cstddef>
+
+namespace IO::Astrodynamics::OrbitalParameters
+{
+    /**
+     * @brief Orbital elements sets handled by the batch converter, with their components order
+     */
+    enum class ElementsType
+    {
+        //x, y, z (m), vx, vy, vz (m/s)
+        StateVector,
+        //Semi major axis (m, negative for hyperbolic orbits), eccentricity, inclination, ascending node longitude, periapsis argument, mean anomaly (rad)
+        Keplerian,
+        //Semi major axis (m), h = e sin(w + O), k = e cos(w + O), p = tan(i/2) sin(O), q = tan(i/2) cos(O), mean longitude (rad). Elliptic orbits only
+        Equinoctial,
+        //Semi latus rectum (m), f = e cos(w + O), g = e sin(w + O), h = tan(i/2) cos(O), k = tan(i/2) sin(O), true longitude (rad)
+        ModifiedEquinoctial
+    };
+
+    /**
+     * @brief Batch conversions between orbital elements sets without any CSPICE call.
+     * Arrays are in structure of arrays layout: component j of object i is stored at j * count + i.
+     * Angles are returned in [0, 2PI[. Undefined angles of circular or equatorial orbits are set to 0 and the remaining angle holds the position,
+     * as SPICE does. Equinoctial sets are singular for retrograde equatorial orbits only.
+     * Objects that can't be converted (ex. parabolic or hyperbolic orbit to equinoctial elements) get NaN components.
+     */
+    class ElementsConverter final
+    {
+    public:
+        /**
+         * @brief Convert orbital elements of many objects
+         *
+         * @param input Input elements type
+         * @param output Output elements type
+         * @param count Objects count
+         * @param mu Gravitational parameter of the center of motion (m^3/s^2)
+         * @param inputElements 6 * count values
+         * @param outputElements 6 * count values, may not overlap input
+         */
+        static void Convert(ElementsType input, ElementsType output, std::size_t count, double mu, const double *inputElements, double *outputElements);
+    };
+}
+
+#endif //IO_ELEMENTSCONVERTER_H
@@ -60,7 +60,7 @@ IO::Astrodynamics::Time::TimeSpan IO::Astrodynamics::OrbitalParameters::Equinoct
 }
 
 IO::Astrodynamics::Math::Vector3D IO::Astrodynamics::OrbitalParameters::EquinoctialElements::GetSpecificAngularMomentum() const {
-    return ToStateVector(m_epoch).GetSpecificAngularMomentum();
+    return GetStateVectorAtEpoch().GetSpecificAngularMomentum();
 }
 
 IO::Astrodynamics::OrbitalParameters::StateVector IO::Astrodynamics::OrbitalParameters::EquinoctialElements::ToStateVector(const IO::Astrodynamics::Time::TDB &epoch) const {
@@ -90,5 +90,5 @@ double IO::Astrodynamics::OrbitalParameters::EquinoctialElements::GetMeanAnomaly
 }
 
 double IO::Astrodynamics::OrbitalParameters::EquinoctialElements::GetSpecificOrbitalEnergy() const {
-    return ToStateVector(m_epoch).GetSpecificOrbitalEnergy();
+    return GetStateVectorAtEpoch().GetSpecificOrbitalEnergy();
 }
@@ -9,14 +9,59 @@
 #include <utility>
 #include "OrbitalParameters.h"
 #include "Plane.h"
+#include <KeplerSolver.h>
+#include <SDKException.h>
 #include <cmath>
+#include <mutex>
 #include <Constants.h>
 
 
+struct IO::Astrodynamics::OrbitalParameters::OrbitalParameters::Cache
+{
+    std::once_flag StateVectorFlag;
+    std::unique_ptr<StateVector> StateVectorAtEpoch;
+    std::once_flag ConicOrbitalElementsFlag;
+    std::unique_ptr<ConicOrbitalElements> ConicOrbitalElementsAtEpoch;
+    std::once_flag AscendingNodeVectorFlag;
+    IO::Astrodynamics::Math::Vector3D AscendingNodeVector;
+};
+
 IO::Astrodynamics::OrbitalParameters::OrbitalParameters::OrbitalParameters(const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> &centerOfMotion,
-                                                                           IO::Astrodynamics::Time::TDB epoch, IO::Astrodynamics::Frames::Frames frame) : m_centerOfMotion{
-        centerOfMotion}, m_epoch{std::move(epoch)}, m_frame{std::move(frame)}
+                                                                           IO::Astrodynamics::Time::TDB epoch, IO::Astrodynamics::Frames::Frames frame) : m_cache{
+        std::make_unique<Cache>()}, m_centerOfMotion{centerOfMotion}, m_epoch{std::move(epoch)}, m_frame{std::move(frame)}
+{
+}
+
+IO::Astrodynamics::OrbitalParameters::OrbitalParameters::OrbitalParameters(const OrbitalParameters &other) : m_cache{std::make_unique<Cache>()},
+                                                                                                            m_centerOfMotion{other.m_centerOfMotion},
+                                                                                                            m_epoch{other.m_epoch}, m_frame{other.m_frame}
+{
+}
+
+IO::Astrodynamics::OrbitalParameters::OrbitalParameters::~OrbitalParameters() = default;
+
+void IO::Astrodynamics::OrbitalParameters::OrbitalParameters::ResetCache()
 {
+    //Once flags can't be reset, a new cache is used
+    m_cache = std::make_unique<Cache>();
+}
+
+const IO::Astrodynamics::OrbitalParameters::StateVector &IO::Astrodynamics::OrbitalParameters::OrbitalParameters::GetStateVectorAtEpoch() const
+{
+    std::call_once(m_cache->StateVectorFlag, [this]
+    {
+        m_cache->StateVectorAtEpoch = std::make_unique<IO::Astrodynamics::OrbitalParameters::StateVector>(ToStateVector(m_epoch));
+    });
+    return *m_cache->StateVectorAtEpoch;
+}
+
+const IO::Astrodynamics::OrbitalParameters::ConicOrbitalElements &IO::Astrodynamics::OrbitalParameters::OrbitalParameters::GetConicOrbitalElementsAtEpoch() const
+{
+    std::call_once(m_cache->ConicOrbitalElementsFlag, [this]
+    {
+        m_cache->ConicOrbitalElementsAtEpoch = std::make_unique<IO::Astrodynamics::OrbitalParameters::ConicOrbitalElements>(GetStateVectorAtEpoch());
+    });
+    return *m_cache->ConicOrbitalElementsAtEpoch;
 }
 
 const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> &IO::Astrodynamics::OrbitalParameters::OrbitalParameters::GetCenterOfMotion() const
@@ -52,7 +97,8 @@ double IO::Astrodynamics::OrbitalParameters::OrbitalParameters::GetMeanMotion()
     }
     if (IsParabolic())
     {
-        return 2 * std::sqrt(IO::Astrodynamics::Constants::G * (m_centerOfMotion->GetMass()) / std::pow(PerigeeRadius(), 3));
+        //Barker's equation convention, mean anomaly is D + D^3/3 with D = tan(v/2) as returned by oscltx_c
+        return std::sqrt(IO::Astrodynamics::Constants::G * (m_centerOfMotion->GetMass()) / (2.0 * std::pow(PerigeeRadius(), 3)));
     }
     else
     {
@@ -98,37 +144,49 @@ double IO::Astrodynamics::OrbitalParameters::OrbitalParameters::ConvertTrueAnoma
 
 double IO::Astrodynamics::OrbitalParameters::OrbitalParameters::GetEccentricAnomaly(const IO::Astrodynamics::Time::TDB &epoch) const
 {
-    double M{this->GetMeanAnomaly(epoch)};
-    double tmpE{M};
-    double E{};
-
-    while (std::abs(tmpE - E) > IO::Astrodynamics::Constants::ECCENTRIC_ANOMALY_ACCURACY)
+    if (IsElliptical())
+    {
+        return IO::Astrodynamics::Math::KeplerSolver::SolveElliptic(this->GetMeanAnomaly(epoch), GetEccentricity());
+    }
+    if (IsHyperbolic())
     {
-        E = tmpE;
-        tmpE = M + GetEccentricity() * std::sin(E);
+        return IO::Astrodynamics::Math::KeplerSolver::SolveHyperbolic(this->GetMeanAnomaly(epoch), GetEccentricity());
     }
-    return E;
+    return IO::Astrodynamics::Math::KeplerSolver::SolveParabolic(this->GetMeanAnomaly(epoch));
 }
 
 double IO::Astrodynamics::OrbitalParameters::OrbitalParameters::GetMeanAnomaly(const IO::Astrodynamics::Time::TDB &epoch) const
 {
     double M{GetMeanAnomaly() + GetMeanMotion() * (epoch - m_epoch).GetSeconds().count()};
-    while (M < 0.0)
+    if (!IsElliptical())
     {
-        M += IO::Astrodynamics::Constants::_2PI;
+        return M;
     }
-    return std::fmod(M, IO::Astrodynamics::Constants::_2PI);
+    M = std::fmod(M, IO::Astrodynamics::Constants::_2PI);
+    return M < 0.0 ? M + IO::Astrodynamics::Constants::_2PI : M;
 }
 
 double IO::Astrodynamics::OrbitalParameters::OrbitalParameters::GetTrueAnomaly(const IO::Astrodynamics::Time::TDB &epoch) const
 {
-    double E{this->GetEccentricAnomaly(epoch)};
-    double v = fmod(atan2(sqrt(1 - pow(GetEccentricity(), 2)) * sin(E), cos(E) - GetEccentricity()), IO::Astrodynamics::Constants::_2PI);
-    while (v < 0.0)
+    double v{};
+    if (IsElliptical())
+    {
+        double E{this->GetEccentricAnomaly(epoch)};
+        v = std::atan2(std::sqrt(1 - std::pow(GetEccentricity(), 2)) * std::sin(E), std::cos(E) - GetEccentricity());
+    }
+    else
     {
-        v += IO::Astrodynamics::Constants::_2PI;
+        //Time since periapsis, mean motion vanishes or diverges for degenerated orbits
+        const double meanMotion = GetMeanMotion();
+        if (!(meanMotion > 0.0) || !std::isfinite(meanMotion))
+        {
+            throw IO::Astrodynamics::Exception::SDKException("Mean motion is undefined, true anomaly can't be computed");
+        }
+        double elapsedTime = GetMeanAnomaly(epoch) / meanMotion;
+        v = IO::Astrodynamics::Math::KeplerSolver::GetTrueAnomaly(elapsedTime, m_centerOfMotion->GetMu(), PerigeeRadius(), GetEccentricity());
     }
-    return std::fmod(v, IO::Astrodynamics::Constants::_2PI);
+    v = std::fmod(v, IO::Astrodynamics::Constants::_2PI);
+    return v < 0.0 ? v + IO::Astrodynamics::Constants::_2PI : v;
 }
 
 double IO::Astrodynamics::OrbitalParameters::OrbitalParameters::GetTrueAnomaly() const
@@ -138,7 +196,7 @@ double IO::Astrodynamics::OrbitalParameters::OrbitalParameters::GetTrueAnomaly()
 
 IO::Astrodynamics::OrbitalParameters::StateVector IO::Astrodynamics::OrbitalParameters::OrbitalParameters::ToStateVector() const
 {
-    return ToStateVector(m_epoch);
+    return GetStateVectorAtEpoch();
 }
 
 IO::Astrodynamics::Time::TDB IO::Astrodynamics::OrbitalParameters::OrbitalParameters::GetEpoch() const
@@ -153,8 +211,8 @@ const IO::Astrodynamics::Frames::Frames &IO::Astrodynamics::OrbitalParameters::O
 
 IO::Astrodynamics::Math::Vector3D IO::Astrodynamics::OrbitalParameters::OrbitalParameters::GetEccentricityVector() const
 {
-    auto sv = ToStateVector();
-    return (sv.GetVelocity().CrossProduct(GetSpecificAngularMomentum()) / m_centerOfMotion->GetMu()) - (sv.GetPosition() / sv.GetPosition().Magnitude());
+    const auto &sv = GetStateVectorAtEpoch();
+    return (sv.GetVelocity().CrossProduct(sv.GetSpecificAngularMomentum()) / m_centerOfMotion->GetMu()) - (sv.GetPosition() / sv.GetPosition().Magnitude());
 }
 
 IO::Astrodynamics::Math::Vector3D IO::Astrodynamics::OrbitalParameters::OrbitalParameters::GetPerigeeVector() const
@@ -174,11 +232,15 @@ IO::Astrodynamics::OrbitalParameters::StateVector IO::Astrodynamics::OrbitalPara
 
 IO::Astrodynamics::Math::Vector3D IO::Astrodynamics::OrbitalParameters::OrbitalParameters::GetAscendingNodeVector() const
 {
-    //Compute asending node vector relative to body fixed
-    auto v = IO::Astrodynamics::Math::Vector3D::VectorZ.CrossProduct(m_frame.TransformVector(m_centerOfMotion->GetBodyFixedFrame(), GetSpecificAngularMomentum(), m_epoch));
+    std::call_once(m_cache->AscendingNodeVectorFlag, [this]
+    {
+        //Compute asending node vector relative to body fixed
+        auto v = IO::Astrodynamics::Math::Vector3D::VectorZ.CrossProduct(m_frame.TransformVector(m_centerOfMotion->GetBodyFixedFrame(), GetSpecificAngularMomentum(), m_epoch));
 
-    //Transform ascending node vector to original orbital parameter frame
-    return m_centerOfMotion->GetBodyFixedFrame().TransformVector(m_frame, v, m_epoch).Normalize();
+        //Transform ascending node vector to original orbital parameter frame
+        m_cache->AscendingNodeVector = m_centerOfMotion->GetBodyFixedFrame().TransformVector(m_frame, v, m_epoch).Normalize();
+    });
+    return m_cache->AscendingNodeVector;
 }
 
 IO::Astrodynamics::Coordinates::Equatorial IO::Astrodynamics::OrbitalParameters::OrbitalParameters::ToEquatorialCoordinates() const
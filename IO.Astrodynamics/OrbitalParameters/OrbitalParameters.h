@@ -22,17 +22,27 @@ namespace IO::Astrodynamics::OrbitalParameters
     class ConicOrbitalElements;
 
     /**
-     * @brief Orbital parameters
-     *
+     * @brief Orbital parameters.
+     * Representations at epoch (state vector, osculating conic elements, ascending node vector) are built once on first use, even when first
+     * requested by several threads. Building them calls CSPICE, which isn't thread safe, so concurrent use still requires the caller's synchronization.
      */
     class OrbitalParameters
     {
+    private:
+        //Canonical representations at epoch, built on first use and shared by derived quantities getters
+        struct Cache;
+        std::unique_ptr<Cache> m_cache;
 
     protected:
         const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_centerOfMotion;
         const IO::Astrodynamics::Time::TDB m_epoch;
         const IO::Astrodynamics::Frames::Frames m_frame;
 
+        /**
+         * @brief Drop cached representations, must be called when parameters are modified
+         */
+        void ResetCache();
+
     public:
         /**
          * @brief Construct a new Orbital Parameters object
@@ -44,7 +54,14 @@ namespace IO::Astrodynamics::OrbitalParameters
         OrbitalParameters(const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> &centerOfMotion, IO::Astrodynamics::Time::TDB epoch,
                           IO::Astrodynamics::Frames::Frames frame);
 
-        virtual ~OrbitalParameters() = default;
+        /**
+         * @brief Copy orbital parameters, cached representations are built again on first use
+         *
+         * @param other
+         */
+        OrbitalParameters(const OrbitalParameters &other);
+
+        virtual ~OrbitalParameters();
 
         /**
          * @brief Get the Center Of Motion
@@ -112,6 +129,20 @@ namespace IO::Astrodynamics::OrbitalParameters
          */
         [[nodiscard]] virtual StateVector ToStateVector() const;
 
+        /**
+         * @brief Get the State Vector at epoch, computed once per instance
+         *
+         * @return const StateVector&
+         */
+        [[nodiscard]] virtual const StateVector &GetStateVectorAtEpoch() const;
+
+        /**
+         * @brief Get the osculating conic orbital elements at epoch, computed once per instance
+         *
+         * @return const ConicOrbitalElements&
+         */
+        [[nodiscard]] const ConicOrbitalElements &GetConicOrbitalElementsAtEpoch() const;
+
         /**
 		 * @brief Get the State Vector from true anomaly
 		 *
@@ -209,7 +240,7 @@ namespace IO::Astrodynamics::OrbitalParameters
         [[nodiscard]] virtual double GetSpecificOrbitalEnergy() const = 0;
 
         /**
-         * @brief Get the Eccentric Anomaly
+         * @brief Get the Eccentric Anomaly, hyperbolic anomaly for hyperbolic orbits and tan(v/2) for parabolic orbits
          *
          * @param epoch
          * @return double
@@ -54,6 +54,7 @@ IO::Astrodynamics::OrbitalParameters::StateVector& IO::Astrodynamics::OrbitalPar
     const_cast<IO::Astrodynamics::Time::TDB&>(m_epoch) = other.m_epoch;
     const_cast<IO::Astrodynamics::Frames::Frames&>(m_frame) = other.m_frame;
     m_osculatingElements = other.m_osculatingElements;
+    ResetCache();
 
     return *this;
 }
@@ -205,3 +206,8 @@ IO::Astrodynamics::OrbitalParameters::StateVector::ToStateVector() const
 {
     return *this;
 }
+
+const IO::Astrodynamics::OrbitalParameters::StateVector &IO::Astrodynamics::OrbitalParameters::StateVector::GetStateVectorAtEpoch() const
+{
+    return *this;
+}
@@ -186,6 +186,13 @@ namespace IO::Astrodynamics::OrbitalParameters
          */
         [[nodiscard]] StateVector ToStateVector() const override;
 
+        /**
+         * @brief Get state vector, no copy is cached since this is already the canonical representation
+         *
+         * @return const StateVector&
+         */
+        [[nodiscard]] const StateVector &GetStateVectorAtEpoch() const override;
+
         /**
          * @brief Get this state vector relative to another frame
          *
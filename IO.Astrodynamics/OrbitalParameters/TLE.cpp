@@ -27,12 +27,6 @@ IO::Astrodynamics::OrbitalParameters::TLE::TLE(const std::shared_ptr<IO::Astrody
 
     //Set period
     m_period = IO::Astrodynamics::Time::TimeSpan(std::chrono::duration<double>(IO::Astrodynamics::Constants::_2PI / (m_elements[8] / 60.0)));
-
-    //Set stateVector
-    m_stateVector = std::make_unique<IO::Astrodynamics::OrbitalParameters::StateVector>(ToStateVector(m_epoch));
-
-    // Set conical elements
-    m_conicOrbitalElements = std::make_unique<IO::Astrodynamics::OrbitalParameters::ConicOrbitalElements>(*m_stateVector);
 }
 
 std::string IO::Astrodynamics::OrbitalParameters::TLE::GetSatelliteName() const
@@ -62,7 +56,7 @@ IO::Astrodynamics::Time::TimeSpan IO::Astrodynamics::OrbitalParameters::TLE::Get
 
 IO::Astrodynamics::Math::Vector3D IO::Astrodynamics::OrbitalParameters::TLE::GetSpecificAngularMomentum() const
 {
-    return m_stateVector->GetSpecificAngularMomentum();
+    return GetStateVectorAtEpoch().GetSpecificAngularMomentum();
 }
 
 IO::Astrodynamics::OrbitalParameters::StateVector IO::Astrodynamics::OrbitalParameters::TLE::ToStateVector(const IO::Astrodynamics::Time::TDB &epoch) const
@@ -87,7 +81,7 @@ double IO::Astrodynamics::OrbitalParameters::TLE::GetEccentricity() const
 
 double IO::Astrodynamics::OrbitalParameters::TLE::GetSemiMajorAxis() const
 {
-    return m_conicOrbitalElements->GetSemiMajorAxis();
+    return GetConicOrbitalElementsAtEpoch().GetSemiMajorAxis();
 }
 
 double IO::Astrodynamics::OrbitalParameters::TLE::GetInclination() const
@@ -112,5 +106,5 @@ double IO::Astrodynamics::OrbitalParameters::TLE::GetMeanAnomaly() const
 
 double IO::Astrodynamics::OrbitalParameters::TLE::GetSpecificOrbitalEnergy() const
 {
-    return m_stateVector->GetSpecificOrbitalEnergy();
+    return GetStateVectorAtEpoch().GetSpecificOrbitalEnergy();
 }
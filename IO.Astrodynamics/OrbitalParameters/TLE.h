@@ -16,8 +16,6 @@ namespace IO::Astrodynamics::OrbitalParameters
 
 		SpiceDouble m_elements[10]{};
 		const std::string m_satelliteName{};
-		std::unique_ptr<ConicOrbitalElements> m_conicOrbitalElements{nullptr};
-		std::unique_ptr<StateVector> m_stateVector{nullptr};
 		IO::Astrodynamics::Time::TimeSpan m_period;
 
 		//J2 J3 J4 KE QO SO ER AE
@@ -0,0 +1,413 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <TLECatalog.h>
+
+#include <cmath>
+#include <fstream>
+
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+#include <SDKException.h>
+
+namespace
+{
+    constexpr double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16};
+
+    std::string_view Trim(std::string_view value)
+    {
+        while (!value.empty() && (value.front() == ' ' || value.front() == '\t'))
+        {
+            value.remove_prefix(1);
+        }
+        while (!value.empty() && (value.back() == ' ' || value.back() == '\t' || value.back() == '\r'))
+        {
+            value.remove_suffix(1);
+        }
+        return value;
+    }
+
+    //Signed decimal number with optional leading digits ex. "51.6416" or "-.00002182", digits are accumulated in an integer so the result is correctly rounded
+    bool ReadDecimal(std::string_view field, double &value)
+    {
+        field = Trim(field);
+        bool negative{false};
+        if (!field.empty() && (field.front() == '-' || field.front() == '+'))
+        {
+            negative = field.front() == '-';
+            field.remove_prefix(1);
+        }
+
+        std::int64_t mantissa{};
+        std::size_t digits{};
+        std::size_t decimals{};
+        bool fraction{false};
+        for (char c: field)
+        {
+            if (c >= '0' && c <= '9')
+            {
+                if (++digits > 16)
+                {
+                    return false;
+                }
+                mantissa = mantissa * 10 + (c - '0');
+                decimals += fraction;
+            }
+            else if (c == '.' && !fraction)
+            {
+                fraction = true;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        if (digits == 0)
+        {
+            return false;
+        }
+
+        value = static_cast<double>(mantissa) / POW10[decimals];
+        if (negative)
+        {
+            value = -value;
+        }
+        return true;
+    }
+
+    bool ReadInteger(std::string_view field, std::int32_t &value)
+    {
+        field = Trim(field);
+        if (field.empty())
+        {
+            value = 0;
+            return true;
+        }
+        std::int32_t result{};
+        for (char c: field)
+        {
+            if (c < '0' || c > '9')
+            {
+                return false;
+            }
+            result = result * 10 + (c - '0');
+        }
+        value = result;
+        return true;
+    }
+
+    //Satellite number with alpha 5 support, first letter encodes 10 to 33 without I and O
+    bool ReadSatelliteNumber(std::string_view field, std::int32_t &value)
+    {
+        field = Trim(field);
+        if (!field.empty() && field.front() >= 'A' && field.front() <= 'Z')
+        {
+            const char letter = field.front();
+            if (letter == 'I' || letter == 'O')
+            {
+                return false;
+            }
+            std::int32_t prefix = 10 + (letter - 'A') - (letter > 'I') - (letter > 'O');
+            std::int32_t remainder{};
+            if (field.size() != 5 || !ReadInteger(field.substr(1), remainder))
+            {
+                return false;
+            }
+            value = prefix * 10000 + remainder;
+            return true;
+        }
+        return ReadInteger(field, value) && !field.empty();
+    }
+
+    //Fields with an assumed leading decimal point and an exponent ex. " 28098-4"
+    bool ReadExponent(std::string_view field, double &value)
+    {
+        if (field.size() != 8)
+        {
+            return false;
+        }
+        std::int32_t mantissa{};
+        std::int32_t exponent{};
+        if (!ReadInteger(field.substr(1, 5), mantissa) || !ReadInteger(field.substr(7, 1), exponent))
+        {
+            return false;
+        }
+        if (field[6] == '-')
+        {
+            exponent = -exponent;
+        }
+        else if (field[6] != '+' && field[6] != ' ')
+        {
+            return false;
+        }
+        value = static_cast<double>(mantissa) / POW10[5] * std::pow(10.0, exponent);
+        if (field[0] == '-')
+        {
+            value = -value;
+        }
+        return true;
+    }
+
+    //UTC seconds from J2000 from two digits year and fractional day of year
+    bool ReadEpoch(std::string_view field, double &value)
+    {
+        std::int32_t year{};
+        double day{};
+        if (!ReadInteger(field.substr(0, 2), year) || !ReadDecimal(field.substr(2, 12), day))
+        {
+            return false;
+        }
+        year += year < 57 ? 2000 : 1900;
+        const double jdJanuaryFirst = 367.0 * year - std::floor(7.0 * (year + std::floor(10.0 / 12.0)) * 0.25) + std::floor(275.0 / 9.0) + 1.0 + 1721013.5;
+        value = ((jdJanuaryFirst - 2451545.0) + (day - 1.0)) * 86400.0;
+        return true;
+    }
+
+    bool IsRecordLine(std::string_view line, char number)
+    {
+        return line.size() >= 69 && line[0] == number && line[1] == ' ';
+    }
+
+    //Fields of a record, returns the error message or nullptr when fields are valid
+    const char *ReadRecord(std::string_view line1, std::string_view line2, IO::Astrodynamics::OrbitalParameters::TLERecord &record)
+    {
+        if (!IO::Astrodynamics::OrbitalParameters::TLECatalog::IsChecksumValid(line1) || !IO::Astrodynamics::OrbitalParameters::TLECatalog::IsChecksumValid(line2))
+        {
+            return "Invalid two lines elements checksum";
+        }
+
+        std::int32_t satelliteNumber2{};
+        std::int32_t eccentricityDigits{};
+        double ndot{}, nddot{}, inclination{}, node{}, argp{}, meanAnomaly{}, meanMotion{};
+        const bool isValid = ReadSatelliteNumber(line1.substr(2, 5), record.SatelliteNumber)
+                             && ReadSatelliteNumber(line2.substr(2, 5), satelliteNumber2)
+                             && ReadEpoch(line1.substr(18, 14), record.Epoch)
+                             && ReadDecimal(line1.substr(33, 10), ndot)
+                             && ReadExponent(line1.substr(44, 8), nddot)
+                             && ReadExponent(line1.substr(53, 8), record.BStar)
+                             && ReadInteger(line1.substr(64, 4), record.ElementSetNumber)
+                             && ReadDecimal(line2.substr(8, 8), inclination)
+                             && ReadDecimal(line2.substr(17, 8), node)
+                             && ReadInteger(line2.substr(26, 7), eccentricityDigits)
+                             && ReadDecimal(line2.substr(34, 8), argp)
+                             && ReadDecimal(line2.substr(43, 8), meanAnomaly)
+                             && ReadDecimal(line2.substr(52, 11), meanMotion)
+                             && ReadInteger(line2.substr(63, 5), record.RevolutionNumber);
+        if (!isValid || satelliteNumber2 != record.SatelliteNumber)
+        {
+            return "Invalid two lines elements";
+        }
+
+        //Eccentricity has an assumed leading decimal point
+        const double eccentricity = static_cast<double>(eccentricityDigits) / POW10[7];
+        if (meanMotion <= 0.0 || eccentricity >= 1.0)
+        {
+            return "Invalid two lines elements mean motion or eccentricity";
+        }
+
+        record.Classification = line1[7];
+        const std::string_view designator = Trim(line1.substr(9, 8));
+        designator.copy(record.InternationalDesignator, designator.size());
+        record.FirstDerivativeOfMeanMotion = ndot * IO::Astrodynamics::Constants::_2PI / (1440.0 * 1440.0);
+        record.SecondDerivativeOfMeanMotion = nddot * IO::Astrodynamics::Constants::_2PI / (1440.0 * 1440.0 * 1440.0);
+        record.Inclination = inclination * IO::Astrodynamics::Constants::DEG_RAD;
+        record.RightAscendingNode = node * IO::Astrodynamics::Constants::DEG_RAD;
+        record.Eccentricity = eccentricity;
+        record.PeriapsisArgument = argp * IO::Astrodynamics::Constants::DEG_RAD;
+        record.MeanAnomaly = meanAnomaly * IO::Astrodynamics::Constants::DEG_RAD;
+        record.MeanMotion = meanMotion * IO::Astrodynamics::Constants::_2PI / 1440.0;
+        return nullptr;
+    }
+}
+
+IO::Astrodynamics::OrbitalParameters::TLECatalog::TLECatalog(bool strict) : m_strict{strict}
+{
+}
+
+bool IO::Astrodynamics::OrbitalParameters::TLECatalog::IsChecksumValid(std::string_view line)
+{
+    if (line.size() < 69 || line[68] < '0' || line[68] > '9')
+    {
+        return false;
+    }
+    int sum{};
+    for (std::size_t i = 0; i < 68; ++i)
+    {
+        const char c = line[i];
+        if (c >= '0' && c <= '9')
+        {
+            sum += c - '0';
+        }
+        else if (c == '-')
+        {
+            sum += 1;
+        }
+    }
+    return sum % 10 == line[68] - '0';
+}
+
+void IO::Astrodynamics::OrbitalParameters::TLECatalog::Reject(const std::string &message)
+{
+    if (m_strict)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException(message + " at line " + std::to_string(m_lineNumber));
+    }
+    ++m_rejected;
+}
+
+void IO::Astrodynamics::OrbitalParameters::TLECatalog::Feed(std::string_view line)
+{
+    ++m_lineNumber;
+    while (!line.empty() && (line.back() == '\r' || line.back() == ' '))
+    {
+        line.remove_suffix(1);
+    }
+    if (line.empty())
+    {
+        return;
+    }
+
+    if (!m_pendingLine1.empty())
+    {
+        if (IsRecordLine(line, '2'))
+        {
+            Add(m_pendingLine1, line);
+            m_pendingLine1.clear();
+            m_pendingName.clear();
+            return;
+        }
+        m_pendingLine1.clear();
+        m_pendingName.clear();
+        Reject("Two lines elements line 2 is missing");
+    }
+
+    if (IsRecordLine(line, '1'))
+    {
+        m_pendingLine1.assign(line);
+    }
+    else if (IsRecordLine(line, '2'))
+    {
+        m_pendingName.clear();
+        Reject("Two lines elements line 1 is missing");
+    }
+    else
+    {
+        //Title line of 3LE, celestrak prefixes it with "0 "
+        if (line.size() > 2 && line[0] == '0' && line[1] == ' ')
+        {
+            line.remove_prefix(2);
+        }
+        m_pendingName.assign(Trim(line));
+    }
+}
+
+void IO::Astrodynamics::OrbitalParameters::TLECatalog::Add(std::string_view line1, std::string_view line2)
+{
+    TLERecord record;
+    if (const char *error = ReadRecord(line1, line2, record))
+    {
+        Reject(error);
+        return;
+    }
+
+    record.NameOffset = static_cast<std::uint32_t>(m_names.size());
+    record.NameLength = static_cast<std::uint32_t>(m_pendingName.size());
+    m_names.append(m_pendingName);
+
+    m_index[record.SatelliteNumber] = m_records.size();
+    m_records.push_back(record);
+}
+
+IO::Astrodynamics::OrbitalParameters::TLECatalog IO::Astrodynamics::OrbitalParameters::TLECatalog::Read(std::istream &stream, bool strict)
+{
+    TLECatalog catalog(strict);
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        catalog.Feed(line);
+    }
+    if (!catalog.m_pendingLine1.empty())
+    {
+        catalog.m_pendingLine1.clear();
+        catalog.Reject("Two lines elements line 2 is missing");
+    }
+    return catalog;
+}
+
+IO::Astrodynamics::OrbitalParameters::TLECatalog IO::Astrodynamics::OrbitalParameters::TLECatalog::Parse(std::string_view buffer, bool strict)
+{
+    TLECatalog catalog(strict);
+    //Roughly 140 characters per record
+    catalog.m_records.reserve(buffer.size() / 140 + 1);
+    while (!buffer.empty())
+    {
+        const std::size_t end = buffer.find('\n');
+        catalog.Feed(buffer.substr(0, end));
+        buffer.remove_prefix(end == std::string_view::npos ? buffer.size() : end + 1);
+    }
+    if (!catalog.m_pendingLine1.empty())
+    {
+        catalog.m_pendingLine1.clear();
+        catalog.Reject("Two lines elements line 2 is missing");
+    }
+    return catalog;
+}
+
+IO::Astrodynamics::OrbitalParameters::TLECatalog IO::Astrodynamics::OrbitalParameters::TLECatalog::ReadFile(const std::string &path, bool strict)
+{
+    std::ifstream inFile(path, std::ios::binary | std::ios::ate);
+    if (!inFile.is_open())
+    {
+        throw IO::Astrodynamics::Exception::SDKException("Unable to open two lines elements file " + path);
+    }
+
+    //Whole file is loaded at once, it's much faster than reading line by line
+    std::string buffer(static_cast<std::size_t>(inFile.tellg()), '\0');
+    inFile.seekg(0);
+    inFile.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!inFile)
+    {
+        throw IO::Astrodynamics::Exception::SDKException("Unable to read two lines elements file " + path);
+    }
+    return Parse(buffer, strict);
+}
+
+std::string_view IO::Astrodynamics::OrbitalParameters::TLECatalog::GetName(std::size_t index) const
+{
+    const auto &record = m_records.at(index);
+    return std::string_view(m_names).substr(record.NameOffset, record.NameLength);
+}
+
+std::optional<std::size_t> IO::Astrodynamics::OrbitalParameters::TLECatalog::Find(std::int32_t satelliteNumber) const
+{
+    auto it = m_index.find(satelliteNumber);
+    if (it == m_index.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+IO::Astrodynamics::OrbitalParameters::TLERecord IO::Astrodynamics::OrbitalParameters::TLECatalog::ParseRecord(std::string_view line1, std::string_view line2)
+{
+    while (!line1.empty() && (line1.back() == '\r' || line1.back() == ' '))
+    {
+        line1.remove_suffix(1);
+    }
+    while (!line2.empty() && (line2.back() == '\r' || line2.back() == ' '))
+    {
+        line2.remove_suffix(1);
+    }
+    if (!IsRecordLine(line1, '1') || !IsRecordLine(line2, '2'))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Invalid two lines elements");
+    }
+
+    TLERecord record;
+    if (const char *error = ReadRecord(line1, line2, record))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException(error);
+    }
+    return record;
+}
@@ -0,0 +1,170 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_TLECATALOG_H
+#define IO_TLECATALOG_H
+
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace IO::Astrodynamics::OrbitalParameters
+{
+    /**
+     * @brief Raw two lines elements fields.
+     * Angles are in radians, mean motion and its derivatives use the same units as getelm_c.
+     */
+    struct TLERecord
+    {
+        std::int32_t SatelliteNumber{};
+        std::int32_t ElementSetNumber{};
+        std::int32_t RevolutionNumber{};
+        std::uint32_t NameOffset{};
+        std::uint32_t NameLength{};
+        char Classification{'U'};
+        char InternationalDesignator[9]{};
+
+        //UTC seconds from J2000
+        double Epoch{};
+
+        //Published first derivative of mean motion divided by two (rad/min^2) and second derivative divided by six (rad/min^3)
+        double FirstDerivativeOfMeanMotion{};
+        double SecondDerivativeOfMeanMotion{};
+        double BStar{};
+        double Inclination{};
+        double RightAscendingNode{};
+        double Eccentricity{};
+        double PeriapsisArgument{};
+        double MeanAnomaly{};
+
+        //Kozai mean motion (rad/min)
+        double MeanMotion{};
+    };
+
+    /**
+     * @brief Two lines elements catalog read from 2LE or 3LE text.
+     * Fields are parsed natively and checksums are verified, nothing else is computed while loading.
+     * Propagators and orbital elements are built from records only when requested.
+     */
+    class TLECatalog final
+    {
+    private:
+        std::vector<TLERecord> m_records{};
+        std::string m_names{};
+        std::unordered_map<std::int32_t, std::size_t> m_index{};
+        std::size_t m_rejected{};
+        bool m_strict{true};
+
+        std::string m_pendingName{};
+        std::string m_pendingLine1{};
+        std::size_t m_lineNumber{};
+
+        void Feed(std::string_view line);
+
+        void Add(std::string_view line1, std::string_view line2);
+
+        void Reject(const std::string &message);
+
+    public:
+        /**
+         * @brief Construct an empty catalog
+         *
+         * @param strict Throw on invalid records when true, skip and count them otherwise
+         */
+        explicit TLECatalog(bool strict = true);
+
+        /**
+         * @brief Read a 2LE or 3LE file
+         *
+         * @param path
+         * @param strict Throw on invalid records when true, skip and count them otherwise
+         * @return TLECatalog
+         */
+        static TLECatalog ReadFile(const std::string &path, bool strict = true);
+
+        /**
+         * @brief Read 2LE or 3LE records from a stream
+         *
+         * @param stream
+         * @param strict Throw on invalid records when true, skip and count them otherwise
+         * @return TLECatalog
+         */
+        static TLECatalog Read(std::istream &stream, bool strict = true);
+
+        /**
+         * @brief Read 2LE or 3LE records from a memory buffer
+         *
+         * @param buffer
+         * @param strict Throw on invalid records when true, skip and count them otherwise
+         * @return TLECatalog
+         */
+        static TLECatalog Parse(std::string_view buffer, bool strict = true);
+
+        /**
+         * @brief Verify the checksum stored in column 69
+         *
+         * @param line
+         * @return true
+         * @return false
+         */
+        static bool IsChecksumValid(std::string_view line);
+
+        /**
+         * @brief Read a single record, trailing spaces are ignored
+         *
+         * @param line1
+         * @param line2
+         * @return TLERecord
+         * @throw InvalidArgumentException when lines are malformed or a checksum doesn't match
+         */
+        static TLERecord ParseRecord(std::string_view line1, std::string_view line2);
+
+        /**
+         * @brief Get the records count
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] inline std::size_t GetSize() const
+        { return m_records.size(); }
+
+        /**
+         * @brief Get the rejected records count
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] inline std::size_t GetRejectedCount() const
+        { return m_rejected; }
+
+        /**
+         * @brief Get the record at index
+         *
+         * @param index
+         * @return const TLERecord&
+         */
+        [[nodiscard]] inline const TLERecord &GetRecord(std::size_t index) const
+        { return m_records.at(index); }
+
+        /**
+         * @brief Get the satellite name, empty for 2LE records
+         *
+         * @param index
+         * @return std::string_view
+         */
+        [[nodiscard]] std::string_view GetName(std::size_t index) const;
+
+        /**
+         * @brief Find a record by satellite number. When a satellite appears many times the last record is used.
+         *
+         * @param satelliteNumber
+         * @return std::optional<std::size_t>
+         */
+        [[nodiscard]] std::optional<std::size_t> Find(std::int32_t satelliteNumber) const;
+    };
+}
+
+#endif //IO_TLECATALOG_H
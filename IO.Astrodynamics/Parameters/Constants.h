@@ -7,7 +7,6 @@
 namespace IO::Astrodynamics::Constants
 {
     inline constexpr double G{6.67430e-11};
-    inline constexpr double ECCENTRIC_ANOMALY_ACCURACY{1e-9};
     inline constexpr double PI{3.141592653589793116};
     inline constexpr double _2PI{2 * PI};
     inline constexpr double PI2{PI * 0.5};
@@ -19,7 +19,6 @@ namespace IO::Astrodynamics::Parameters
     inline constexpr double IntersectDetectionAccuraccy = 0.017453;//1.0°
     inline constexpr double CircularEccentricityAccuraccy = 1E-03;
     inline constexpr double ClockAccuracy = 16.0; //2^n
-    inline const static Time::TimeSpan SitePropagationStep(60s);
     inline const static Time::TimeSpan SpacecraftPropagationStep(1s);
     inline const static Time::TimeSpan ManeuverPointUpdateDelay(60s);
 
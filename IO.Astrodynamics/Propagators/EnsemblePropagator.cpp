@@ -0,0 +1,402 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <EnsemblePropagator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <random>
+
+#include <InvalidArgumentException.h>
+#include <Parallel.h>
+
+namespace
+{
+    //Reusable barrier, the completion runs on the last arriving thread before the others are released
+    class Barrier
+    {
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        const unsigned int m_count;
+        unsigned int m_waiting{};
+        std::size_t m_generation{};
+
+    public:
+        explicit Barrier(unsigned int count) : m_count{count}
+        {
+        }
+
+        template<typename Completion>
+        void ArriveAndWait(const Completion &completion)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            const std::size_t generation = m_generation;
+            if (++m_waiting == m_count)
+            {
+                completion();
+                m_waiting = 0;
+                ++m_generation;
+                m_condition.notify_all();
+                return;
+            }
+            m_condition.wait(lock, [&]() { return generation != m_generation; });
+        }
+    };
+}
+
+IO::Astrodynamics::Propagators::EnsemblePropagator::EnsemblePropagator(std::vector<std::shared_ptr<ForceModel>> forces, double step) : m_forces{std::move(forces)},
+                                                                                                                                       m_step{step}
+{
+    if (m_forces.empty() || std::any_of(m_forces.begin(), m_forces.end(), [](const auto &force) { return !force; }))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("At least one force model is required and force models must be defined");
+    }
+    if (!(step > 0.0) || std::isinf(step))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Step must be positive and finite");
+    }
+}
+
+std::vector<double> IO::Astrodynamics::Propagators::EnsemblePropagator::Sample(const double mean[6], const double covariance[36], std::size_t count, std::uint64_t seed)
+{
+    if (!std::all_of(mean, mean + 6, [](double value) { return std::isfinite(value); }) ||
+        !std::all_of(covariance, covariance + 36, [](double value) { return std::isfinite(value); }))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Mean and covariance must be finite");
+    }
+
+    //Cholesky factorization of the lower triangle, null pivots are allowed for degenerated distributions
+    double lower[36]{};
+    for (int j = 0; j < 6; ++j)
+    {
+        double pivot = covariance[6 * j + j];
+        for (int k = 0; k < j; ++k)
+        {
+            pivot -= lower[6 * j + k] * lower[6 * j + k];
+        }
+        if (pivot < -1E-12 * std::abs(covariance[6 * j + j]) || (covariance[6 * j + j] == 0.0 && pivot < 0.0))
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Covariance must be positive semi definite");
+        }
+        lower[6 * j + j] = std::sqrt(std::max(pivot, 0.0));
+        for (int i = j + 1; i < 6; ++i)
+        {
+            double value = covariance[6 * i + j];
+            for (int k = 0; k < j; ++k)
+            {
+                value -= lower[6 * i + k] * lower[6 * j + k];
+            }
+            lower[6 * i + j] = lower[6 * j + j] > 0.0 ? value / lower[6 * j + j] : 0.0;
+        }
+    }
+
+    std::mt19937_64 generator(seed);
+    std::normal_distribution<double> distribution;
+    std::vector<double> samples(6 * count);
+    for (std::size_t s = 0; s < count; ++s)
+    {
+        double normal[6];
+        for (double &value: normal)
+        {
+            value = distribution(generator);
+        }
+        for (int i = 0; i < 6; ++i)
+        {
+            double value = mean[i];
+            for (int k = 0; k <= i; ++k)
+            {
+                value += lower[6 * i + k] * normal[k];
+            }
+            samples[6 * s + i] = value;
+        }
+    }
+    return samples;
+}
+
+void IO::Astrodynamics::Propagators::EnsemblePropagator::Derivative(double epoch, std::size_t count, const double *const states[6], double *const derivatives[6]) const
+{
+    for (int c = 0; c < 3; ++c)
+    {
+        std::copy(states[c + 3], states[c + 3] + count, derivatives[c]);
+        std::fill(derivatives[c + 3], derivatives[c + 3] + count, 0.0);
+    }
+    for (const auto &force: m_forces)
+    {
+        force->AddAccelerations(epoch, count, states, derivatives + 3);
+    }
+}
+
+void IO::Astrodynamics::Propagators::EnsemblePropagator::Advance(double epoch, double step, std::size_t substeps, std::size_t count, double *const states[6],
+                                                                   double *memory) const
+{
+    double *stage[6], *k1[6], *k2[6], *k3[6], *k4[6];
+    for (std::size_t c = 0; c < 6; ++c)
+    {
+        stage[c] = memory + c * BATCH_SIZE;
+        k1[c] = memory + (6 + c) * BATCH_SIZE;
+        k2[c] = memory + (12 + c) * BATCH_SIZE;
+        k3[c] = memory + (18 + c) * BATCH_SIZE;
+        k4[c] = memory + (24 + c) * BATCH_SIZE;
+    }
+
+    for (std::size_t s = 0; s < substeps; ++s)
+    {
+        const double t = epoch + static_cast<double>(s) * step;
+        Derivative(t, count, states, k1);
+        for (std::size_t c = 0; c < 6; ++c)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                stage[c][i] = states[c][i] + 0.5 * step * k1[c][i];
+            }
+        }
+        Derivative(t + 0.5 * step, count, stage, k2);
+        for (std::size_t c = 0; c < 6; ++c)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                stage[c][i] = states[c][i] + 0.5 * step * k2[c][i];
+            }
+        }
+        Derivative(t + 0.5 * step, count, stage, k3);
+        for (std::size_t c = 0; c < 6; ++c)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                stage[c][i] = states[c][i] + step * k3[c][i];
+            }
+        }
+        Derivative(t + step, count, stage, k4);
+        for (std::size_t c = 0; c < 6; ++c)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                states[c][i] += step / 6.0 * (k1[c][i] + 2.0 * k2[c][i] + 2.0 * k3[c][i] + k4[c][i]);
+            }
+        }
+    }
+}
+
+void IO::Astrodynamics::Propagators::EnsemblePropagator::Propagate(double epoch, std::size_t count, const double *states, double outputStep, std::size_t outputCount,
+                                                                   unsigned int threadCount, const BatchOutput &batchOutput, const EnsembleOutput &ensembleOutput)
+{
+    if (count == 0 || !states)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("At least one state is required");
+    }
+    if (outputCount == 0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("At least one output is required");
+    }
+    if (!std::isfinite(epoch) || !std::isfinite(outputStep) || (outputCount > 1 && outputStep == 0.0))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Epoch must be finite and output step must be finite and not null");
+    }
+    if (!std::all_of(states, states + 6 * count, [](double value) { return std::isfinite(value); }))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("States must be finite");
+    }
+
+    //Force models are prepared once for the whole window and shared by all members
+    const double last = epoch + static_cast<double>(outputCount - 1) * outputStep;
+    for (const auto &force: m_forces)
+    {
+        force->Prepare(std::min(epoch, last), std::max(epoch, last));
+    }
+
+    //Members are stored component by component, so a batch is a contiguous slice of each component
+    std::vector<double> ensemble(6 * count);
+    for (std::size_t j = 0; j < count; ++j)
+    {
+        for (std::size_t c = 0; c < 6; ++c)
+        {
+            ensemble[c * count + j] = states[6 * j + c];
+        }
+    }
+
+    const std::size_t substeps = outputCount > 1 ? static_cast<std::size_t>(std::ceil(std::abs(outputStep) / m_step)) : 0;
+    const double h = outputCount > 1 ? outputStep / static_cast<double>(substeps) : 0.0;
+    const std::size_t batchCount = (count + BATCH_SIZE - 1) / BATCH_SIZE;
+    threadCount = IO::Astrodynamics::Helpers::ThreadCount(threadCount, batchCount);
+    auto batchStates = [&](std::size_t batch, double *y[6])
+    {
+        for (std::size_t c = 0; c < 6; ++c)
+        {
+            y[c] = ensemble.data() + c * count + batch * BATCH_SIZE;
+        }
+        return std::min(BATCH_SIZE, count - batch * BATCH_SIZE);
+    };
+
+    //Workers are started once and own a contiguous range of batches for the whole propagation
+    if (batchOutput)
+    {
+        //Batches don't depend on each other, each one runs through all outputs
+        IO::Astrodynamics::Helpers::ParallelFor(threadCount, batchCount, [&](unsigned int, std::size_t firstBatch, std::size_t lastBatch)
+        {
+            std::vector<double> memory(30 * BATCH_SIZE);
+            for (std::size_t b = firstBatch; b < lastBatch; ++b)
+            {
+                double *y[6];
+                const std::size_t n = batchStates(b, y);
+                batchOutput(0, b * BATCH_SIZE, n, y);
+                for (std::size_t o = 1; o < outputCount; ++o)
+                {
+                    Advance(epoch + static_cast<double>(o - 1) * outputStep, h, substeps, n, y, memory.data());
+                    batchOutput(o, b * BATCH_SIZE, n, y);
+                }
+            }
+        });
+        return;
+    }
+
+    //Whole ensemble is gathered at each output, workers wait for each other and the last one to arrive runs the output
+    Barrier barrier(threadCount);
+    std::atomic<bool> isFailed{false};
+    IO::Astrodynamics::Helpers::ParallelFor(threadCount, batchCount, [&](unsigned int, std::size_t firstBatch, std::size_t lastBatch)
+    {
+        std::vector<double> memory(30 * BATCH_SIZE);
+        std::exception_ptr error;
+        for (std::size_t o = 0; o < outputCount; ++o)
+        {
+            if (o > 0 && !isFailed)
+            {
+                try
+                {
+                    for (std::size_t b = firstBatch; b < lastBatch; ++b)
+                    {
+                        double *y[6];
+                        const std::size_t n = batchStates(b, y);
+                        Advance(epoch + static_cast<double>(o - 1) * outputStep, h, substeps, n, y, memory.data());
+                    }
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                    isFailed = true;
+                }
+            }
+
+            //Failed workers keep arriving at the barrier, so the others are never blocked
+            barrier.ArriveAndWait([&]()
+            {
+                if (isFailed)
+                {
+                    return;
+                }
+                try
+                {
+                    ensembleOutput(o, ensemble);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                    isFailed = true;
+                }
+            });
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    });
+}
+
+std::vector<double> IO::Astrodynamics::Propagators::EnsemblePropagator::PropagateTrajectories(double epoch, std::size_t count, const double *states, double outputStep,
+                                                                                              std::size_t outputCount, unsigned int threadCount)
+{
+    std::vector<double> trajectories(6 * count * outputCount);
+    Propagate(epoch, count, states, outputStep, outputCount, threadCount,
+              [&](std::size_t index, std::size_t offset, std::size_t batchCount, const double *const batch[6])
+              {
+                  double *destination = trajectories.data() + 6 * (count * index + offset);
+                  for (std::size_t j = 0; j < batchCount; ++j)
+                  {
+                      for (std::size_t c = 0; c < 6; ++c)
+                      {
+                          destination[6 * j + c] = batch[c][j];
+                      }
+                  }
+              }, {});
+    return trajectories;
+}
+
+IO::Astrodynamics::Propagators::EnsembleStatistics
+IO::Astrodynamics::Propagators::EnsemblePropagator::PropagateStatistics(double epoch, std::size_t count, const double *states, double outputStep, std::size_t outputCount,
+                                                                        const std::vector<double> &percentiles, unsigned int threadCount)
+{
+    if (count < 2)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("At least two states are required");
+    }
+    if (std::any_of(percentiles.begin(), percentiles.end(), [](double value) { return !(value >= 0.0 && value <= 100.0); }))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Percentiles must be between 0 and 100");
+    }
+
+    EnsembleStatistics statistics;
+    statistics.EpochCount = outputCount;
+    statistics.PercentileCount = percentiles.size();
+    std::vector<double> sorted(count);
+    Propagate(epoch, count, states, outputStep, outputCount, threadCount, {}, [&](std::size_t index, const std::vector<double> &ensemble)
+    {
+        if (statistics.Epochs.empty())
+        {
+            statistics.Epochs.resize(outputCount);
+            statistics.Mean.resize(6 * outputCount);
+            statistics.Covariance.resize(36 * outputCount);
+            statistics.Percentiles.resize(6 * percentiles.size() * outputCount);
+        }
+        statistics.Epochs[index] = epoch + static_cast<double>(index) * outputStep;
+
+        double *mean = statistics.Mean.data() + 6 * index;
+        for (std::size_t c = 0; c < 6; ++c)
+        {
+            double sum = 0.0;
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                sum += ensemble[c * count + j];
+            }
+            mean[c] = sum / static_cast<double>(count);
+        }
+
+        //Unbiased sample covariance
+        double *covariance = statistics.Covariance.data() + 36 * index;
+        for (std::size_t r = 0; r < 6; ++r)
+        {
+            for (std::size_t c = r; c < 6; ++c)
+            {
+                double sum = 0.0;
+                for (std::size_t j = 0; j < count; ++j)
+                {
+                    sum += (ensemble[r * count + j] - mean[r]) * (ensemble[c * count + j] - mean[c]);
+                }
+                covariance[6 * r + c] = covariance[6 * c + r] = sum / static_cast<double>(count - 1);
+            }
+        }
+
+        //Percentiles with a linear interpolation between closest ranks
+        if (percentiles.empty())
+        {
+            return;
+        }
+        for (std::size_t c = 0; c < 6; ++c)
+        {
+            std::copy(ensemble.begin() + static_cast<std::ptrdiff_t>(c * count), ensemble.begin() + static_cast<std::ptrdiff_t>((c + 1) * count), sorted.begin());
+            std::sort(sorted.begin(), sorted.end());
+            for (std::size_t p = 0; p < percentiles.size(); ++p)
+            {
+                const double rank = percentiles[p] / 100.0 * static_cast<double>(count - 1);
+                const auto lowerRank = std::min(static_cast<std::size_t>(rank), count - 2);
+                const double weight = rank - static_cast<double>(lowerRank);
+                statistics.Percentiles[(index * percentiles.size() + p) * 6 + c] = sorted[lowerRank] + weight * (sorted[lowerRank + 1] - sorted[lowerRank]);
+            }
+        }
+    });
+    return statistics;
+}
@@ -0,0 +1,114 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_ENSEMBLEPROPAGATOR_H
+#define IO_ENSEMBLEPROPAGATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <ForceModel.h>
+
+namespace IO::Astrodynamics::Propagators
+{
+    /**
+     * @brief Ensemble statistics on the output grid.
+     * Values of output i are stored from i * 6 for means, i * 36 for covariances and (i * PercentileCount + p) * 6 for percentiles.
+     */
+    struct EnsembleStatistics
+    {
+        std::size_t EpochCount{};
+        std::size_t PercentileCount{};
+        //Output epochs (s)
+        std::vector<double> Epochs{};
+        //Mean states (m, m/s)
+        std::vector<double> Mean{};
+        //Sample covariances, row major 6x6 matrices
+        std::vector<double> Covariance{};
+        //States percentiles, component by component (m, m/s)
+        std::vector<double> Percentiles{};
+    };
+
+    /**
+     * @brief Propagate many states in lockstep on the same time grid with a fixed step Runge-Kutta 4 scheme.
+     * Members are grouped in batches stored by component, force models are evaluated once per batch and stage,
+     * so epoch dependent values like third body positions or body orientation are shared by the batch members.
+     * Batches are shared between threads started once for the whole propagation, force models are prepared once for the whole ensemble.
+     * Epochs are TDB seconds from J2000, states are relative to the central body in an inertial frame.
+     */
+    class EnsemblePropagator final
+    {
+    private:
+        //Output index, first member, members count and batch states by component, called concurrently for distinct batches
+        using BatchOutput = std::function<void(std::size_t, std::size_t, std::size_t, const double *const[6])>;
+        //Output index and whole ensemble by component, called once per output when all batches reached it
+        using EnsembleOutput = std::function<void(std::size_t, const std::vector<double> &)>;
+
+        const std::vector<std::shared_ptr<ForceModel>> m_forces;
+        const double m_step;
+
+        void Propagate(double epoch, std::size_t count, const double *states, double outputStep, std::size_t outputCount, unsigned int threadCount,
+                       const BatchOutput &batchOutput, const EnsembleOutput &ensembleOutput);
+
+        void Advance(double epoch, double step, std::size_t substeps, std::size_t count, double *const states[6], double *memory) const;
+
+        void Derivative(double epoch, std::size_t count, const double *const states[6], double *const derivatives[6]) const;
+
+    public:
+        static constexpr std::size_t BATCH_SIZE{64};
+
+        /**
+         * @brief Construct a new Ensemble Propagator
+         *
+         * @param forces Force models, accelerations are summed
+         * @param step Largest integration step (s)
+         */
+        explicit EnsemblePropagator(std::vector<std::shared_ptr<ForceModel>> forces, double step = 60.0);
+
+        /**
+         * @brief Draw states from a normal distribution, samples are reproducible for a given seed and standard library
+         *
+         * @param mean Mean position and velocity (m, m/s)
+         * @param covariance Row major 6x6 covariance matrix, positive semi definite, only the lower triangle is read
+         * @param count Samples count
+         * @param seed Random generator seed
+         * @return std::vector<double> 6 values per sample
+         */
+        static std::vector<double> Sample(const double mean[6], const double covariance[36], std::size_t count, std::uint64_t seed);
+
+        /**
+         * @brief Propagate members and keep their states at each output epoch
+         *
+         * @param epoch Initial epoch (s)
+         * @param count Members count
+         * @param states Initial states, 6 values per member (m, m/s)
+         * @param outputStep Time between outputs, negative to propagate backward (s)
+         * @param outputCount Outputs count, the first output is the initial epoch
+         * @param threadCount Threads used, hardware concurrency when 0
+         * @return std::vector<double> States of output i and member j from (i * count + j) * 6 (m, m/s)
+         */
+        std::vector<double> PropagateTrajectories(double epoch, std::size_t count, const double *states, double outputStep, std::size_t outputCount,
+                                                  unsigned int threadCount = 0);
+
+        /**
+         * @brief Propagate members and only keep statistics at each output epoch, members states are never stored for more than one epoch
+         *
+         * @param epoch Initial epoch (s)
+         * @param count Members count
+         * @param states Initial states, 6 values per member (m, m/s)
+         * @param outputStep Time between outputs, negative to propagate backward (s)
+         * @param outputCount Outputs count, the first output is the initial epoch
+         * @param percentiles Percentiles computed, between 0 and 100
+         * @param threadCount Threads used, hardware concurrency when 0
+         * @return EnsembleStatistics
+         */
+        EnsembleStatistics PropagateStatistics(double epoch, std::size_t count, const double *states, double outputStep, std::size_t outputCount,
+                                               const std::vector<double> &percentiles = {}, unsigned int threadCount = 0);
+    };
+}
+
+#endif //IO_ENSEMBLEPROPAGATOR_H
@@ -0,0 +1,65 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_FORCEMODEL_H
+#define IO_FORCEMODEL_H
+
+#include <cstddef>
+
+namespace IO::Astrodynamics::Propagators
+{
+    /**
+     * @brief Force model used by numerical propagators.
+     * States are expressed relative to the central body in an inertial frame, epochs are TDB seconds from J2000.
+     * Kernel data needed by a model is read by Prepare, so accelerations are evaluated without any CSPICE call and can be shared between threads.
+     */
+    class ForceModel
+    {
+    public:
+        virtual ~ForceModel() = default;
+
+        /**
+         * @brief Prepare the model for a propagation window, called once before integration
+         *
+         * @param begin Window begin (s)
+         * @param end Window end (s)
+         */
+        virtual void Prepare([[maybe_unused]] double begin, [[maybe_unused]] double end)
+        {
+        }
+
+        /**
+         * @brief Add the acceleration of this model
+         *
+         * @param epoch Epoch (s)
+         * @param state Position and velocity (m, m/s)
+         * @param acceleration Acceleration to add to (m/s^2)
+         */
+        virtual void AddAcceleration(double epoch, const double state[6], double acceleration[3]) const = 0;
+
+        /**
+         * @brief Add the accelerations of this model for many states at the same epoch, values are stored by component.
+         * Models override it to evaluate epoch dependent values once for all states.
+         *
+         * @param epoch Epoch (s)
+         * @param count States count
+         * @param states Six arrays of count values, positions then velocities (m, m/s)
+         * @param accelerations Three arrays of count values to add to (m/s^2)
+         */
+        virtual void AddAccelerations(double epoch, std::size_t count, const double *const states[6], double *const accelerations[3]) const
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const double state[6]{states[0][i], states[1][i], states[2][i], states[3][i], states[4][i], states[5][i]};
+                double acceleration[3]{};
+                AddAcceleration(epoch, state, acceleration);
+                accelerations[0][i] += acceleration[0];
+                accelerations[1][i] += acceleration[1];
+                accelerations[2][i] += acceleration[2];
+            }
+        }
+    };
+}
+
+#endif //IO_FORCEMODEL_H
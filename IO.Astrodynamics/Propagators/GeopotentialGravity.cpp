@@ -0,0 +1,98 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <GeopotentialGravity.h>
+
+#include <InertialFrames.h>
+#include <InvalidArgumentException.h>
+
+IO::Astrodynamics::Propagators::GeopotentialGravity::GeopotentialGravity(std::shared_ptr<const GeopotentialModel> model,
+                                                                         std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> body,
+                                                                         const IO::Astrodynamics::Frames::Frames &frame, double step) : m_model{std::move(model)},
+                                                                                                                                        m_body{std::move(body)},
+                                                                                                                                        m_frame{frame}, m_rotations{9, step}
+{
+    if (!m_model || !m_body)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Model and body must be defined");
+    }
+}
+
+IO::Astrodynamics::Propagators::GeopotentialGravity::GeopotentialGravity(std::shared_ptr<const GeopotentialModel> model, double begin, double step,
+                                                                         std::vector<double> rotations) : m_model{std::move(model)},
+                                                                                                          m_frame{IO::Astrodynamics::Frames::InertialFrames::ICRF()},
+                                                                                                          m_rotations{9, begin, step, std::move(rotations)}
+{
+    if (!m_model)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Model must be defined");
+    }
+}
+
+void IO::Astrodynamics::Propagators::GeopotentialGravity::Prepare(double begin, double end)
+{
+    if (!m_body)
+    {
+        return;
+    }
+
+    m_rotations.Sample(begin, end, [this](double epoch, double *rotation)
+    {
+        auto transform = m_frame.ToFrame6x6(m_body->GetBodyFixedFrame(), IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(epoch)));
+        for (std::size_t row = 0; row < 6; row += 3)
+        {
+            for (std::size_t r = 0; r < 3; ++r)
+            {
+                for (std::size_t c = 0; c < 3; ++c)
+                {
+                    *rotation++ = transform.GetValue(row + r, c);
+                }
+            }
+        }
+    });
+}
+
+void IO::Astrodynamics::Propagators::GeopotentialGravity::GetRotation(double epoch, double rotation[9]) const
+{
+    m_rotations.Interpolate(epoch, rotation);
+}
+
+void IO::Astrodynamics::Propagators::GeopotentialGravity::AddAcceleration(double epoch, const double state[6], double acceleration[3]) const
+{
+    double rotation[9];
+    GetRotation(epoch, rotation);
+    double position[3], bodyFixed[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        position[i] = rotation[3 * i] * state[0] + rotation[3 * i + 1] * state[1] + rotation[3 * i + 2] * state[2];
+    }
+    m_model->GetAcceleration(position, bodyFixed);
+
+    //Back to the propagation frame with the transposed rotation
+    for (int i = 0; i < 3; ++i)
+    {
+        acceleration[i] += rotation[i] * bodyFixed[0] + rotation[3 + i] * bodyFixed[1] + rotation[6 + i] * bodyFixed[2];
+    }
+}
+
+void IO::Astrodynamics::Propagators::GeopotentialGravity::AddAccelerations(double epoch, std::size_t count, const double *const states[6],
+                                                                            double *const accelerations[3]) const
+{
+    //Body orientation is shared by all states
+    double rotation[9];
+    GetRotation(epoch, rotation);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        double position[3], bodyFixed[3];
+        for (int j = 0; j < 3; ++j)
+        {
+            position[j] = rotation[3 * j] * states[0][i] + rotation[3 * j + 1] * states[1][i] + rotation[3 * j + 2] * states[2][i];
+        }
+        m_model->GetAcceleration(position, bodyFixed);
+        for (int j = 0; j < 3; ++j)
+        {
+            accelerations[j][i] += rotation[j] * bodyFixed[0] + rotation[3 + j] * bodyFixed[1] + rotation[6 + j] * bodyFixed[2];
+        }
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_GEOPOTENTIALGRAVITY_H
+#define IO_GEOPOTENTIALGRAVITY_H
+
+#include <memory>
+#include <vector>
+
+#include <ForceModel.h>
+#include <GeopotentialModel.h>
+#include <HermiteGrid.h>
+#include <CelestialBody.h>
+
+namespace IO::Astrodynamics::Propagators
+{
+    /**
+     * @brief Central body spherical harmonics gravity, central term included so it replaces the point mass gravity.
+     * Rotation to the body fixed frame is read once on a regular grid covering the propagation window,
+     * then evaluated with a cubic Hermite interpolation of the grid rotations and their derivatives.
+     */
+    class GeopotentialGravity final : public ForceModel
+    {
+    private:
+        const std::shared_ptr<const GeopotentialModel> m_model;
+        const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_body;
+        const IO::Astrodynamics::Frames::Frames m_frame;
+        //Rotation matrix then its derivative, row major
+        IO::Astrodynamics::Math::HermiteGrid m_rotations;
+
+    public:
+        /**
+         * @brief Construct a new Geopotential Gravity oriented from the body fixed frame
+         *
+         * @param model Gravity field
+         * @param body Central body
+         * @param frame Propagation frame
+         * @param step Orientation grid step (s)
+         */
+        GeopotentialGravity(std::shared_ptr<const GeopotentialModel> model, std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> body,
+                            const IO::Astrodynamics::Frames::Frames &frame, double step = 60.0);
+
+        /**
+         * @brief Construct a new Geopotential Gravity from rotations already known
+         *
+         * @param model Gravity field
+         * @param begin First grid epoch (s)
+         * @param step Grid step (s)
+         * @param rotations Rotations from the propagation frame to the body fixed frame then their derivatives, row major, 18 values per grid epoch
+         */
+        GeopotentialGravity(std::shared_ptr<const GeopotentialModel> model, double begin, double step, std::vector<double> rotations);
+
+        /**
+         * @brief Read the body orientation over the window, nothing is read when rotations are given at construction
+         *
+         * @param begin
+         * @param end
+         */
+        void Prepare(double begin, double end) override;
+
+        void AddAcceleration(double epoch, const double state[6], double acceleration[3]) const override;
+
+        void AddAccelerations(double epoch, std::size_t count, const double *const states[6], double *const accelerations[3]) const override;
+
+        /**
+         * @brief Get the rotation from the propagation frame to the body fixed frame
+         *
+         * @param epoch Epoch inside the grid (s)
+         * @param rotation Output row major rotation matrix
+         */
+        void GetRotation(double epoch, double rotation[9]) const;
+    };
+}
+
+#endif //IO_GEOPOTENTIALGRAVITY_H
@@ -0,0 +1,496 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <GeopotentialModel.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include <InvalidArgumentException.h>
+#include <Parallel.h>
+#include <SDKException.h>
+
+namespace
+{
+    std::size_t Index(int n, int m)
+    {
+        return static_cast<std::size_t>(n) * static_cast<std::size_t>(n + 1) / 2 + static_cast<std::size_t>(m);
+    }
+
+    //Term Re((Re + i Im) * (V + i W)) of order Order
+    struct Term
+    {
+        int Order;
+        double Re;
+        double Im;
+    };
+
+    //Derivative along an axis of Re(K * Z_nm), given as terms of degree n + 1 divided by the reference radius
+    int Derive(int axis, int m, double raise, double lower, double vertical, double re, double im, Term terms[2])
+    {
+        switch (axis)
+        {
+            case 0:
+                if (m == 0)
+                {
+                    terms[0] = {1, -raise * re, 0.0};
+                    return 1;
+                }
+                terms[0] = {m + 1, -0.5 * raise * re, -0.5 * raise * im};
+                terms[1] = {m - 1, 0.5 * lower * re, 0.5 * lower * im};
+                return 2;
+            case 1:
+                if (m == 0)
+                {
+                    terms[0] = {1, 0.0, raise * re};
+                    return 1;
+                }
+                terms[0] = {m + 1, -0.5 * raise * im, 0.5 * raise * re};
+                terms[1] = {m - 1, -0.5 * lower * im, 0.5 * lower * re};
+                return 2;
+            default:
+                terms[0] = {m, -vertical * re, -vertical * im};
+                return 1;
+        }
+    }
+
+    //Each thread keeps its own recursion buffer, it only grows
+    double *Buffer(std::size_t size)
+    {
+        thread_local std::vector<double> buffer;
+        if (buffer.size() < size)
+        {
+            buffer.resize(size);
+        }
+        return buffer.data();
+    }
+
+    bool ReadNumber(std::istream &stream, double &value)
+    {
+        std::string token;
+        if (!(stream >> token))
+        {
+            return false;
+        }
+        std::replace_if(token.begin(), token.end(), [](char c) { return c == 'D' || c == 'd'; }, 'E');
+        char *end{};
+        value = std::strtod(token.c_str(), &end);
+        return end != token.c_str() && *end == '\0';
+    }
+
+    //Coefficients read from a file, truncated to the requested degree and order
+    struct Coefficients
+    {
+        int MaxDegree;
+        int MaxOrder;
+        int HighestDegree{};
+        std::vector<double> C;
+        std::vector<double> S;
+
+        Coefficients(int maxDegree, int maxOrder) : MaxDegree{maxDegree}, MaxOrder{maxOrder}, C(Index(maxDegree + 1, 0)), S(Index(maxDegree + 1, 0))
+        {
+            if (maxDegree < 0 || maxOrder < 0 || maxOrder > maxDegree)
+            {
+                throw IO::Astrodynamics::Exception::InvalidArgumentException("Degree must be positive and order must be between 0 and degree");
+            }
+            C[0] = 1.0;
+        }
+
+        bool Read(std::istream &stream)
+        {
+            double n, m, c, s;
+            if (!ReadNumber(stream, n) || !ReadNumber(stream, m) || !ReadNumber(stream, c) || !ReadNumber(stream, s) || n < 0.0 || m < 0.0 || m > n)
+            {
+                return false;
+            }
+            const int degree = static_cast<int>(n);
+            const int order = static_cast<int>(m);
+            if (degree <= MaxDegree && order <= MaxOrder)
+            {
+                C[Index(degree, order)] = c;
+                S[Index(degree, order)] = s;
+                HighestDegree = std::max(HighestDegree, degree);
+            }
+            return true;
+        }
+
+        IO::Astrodynamics::Propagators::GeopotentialModel Build(double mu, double radius)
+        {
+            const int degree = std::min(MaxDegree, HighestDegree);
+            C.resize(Index(degree + 1, 0));
+            S.resize(Index(degree + 1, 0));
+            return {mu, radius, degree, std::min(MaxOrder, degree), std::move(C), std::move(S)};
+        }
+    };
+}
+
+IO::Astrodynamics::Propagators::GeopotentialModel::GeopotentialModel(double mu, double radius, int maxDegree, int maxOrder, std::vector<double> c,
+                                                                     std::vector<double> s) : m_mu{mu}, m_radius{radius}, m_maxDegree{maxDegree},
+                                                                                              m_maxOrder{maxOrder}, m_c{std::move(c)}, m_s{std::move(s)}
+{
+    if (!(mu > 0.0) || !(radius > 0.0))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Gravitational parameter and radius must be positive");
+    }
+    if (maxDegree < 0 || maxOrder < 0 || maxOrder > maxDegree)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Degree must be positive and order must be between 0 and degree");
+    }
+    if (m_c.size() < Index(maxDegree + 1, 0) || m_s.size() < Index(maxDegree + 1, 0))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Coefficients must be given up to the highest degree");
+    }
+
+    //Solid harmonics are needed two degrees above the model for gradients
+    const int degree = maxDegree + 2;
+    const std::size_t size = Index(degree + 1, 0);
+    m_alpha.resize(size);
+    m_beta.resize(size);
+    m_sectoral.resize(static_cast<std::size_t>(degree + 1));
+    m_raise.resize(size);
+    m_lower.resize(size);
+    m_vertical.resize(size);
+    for (int n = 0; n <= degree; ++n)
+    {
+        const double dn = n;
+        for (int m = 0; m <= n; ++m)
+        {
+            const double dm = m;
+            const std::size_t i = Index(n, m);
+            if (n > m)
+            {
+                m_alpha[i] = std::sqrt((2.0 * dn + 1.0) * (2.0 * dn - 1.0) / ((dn - dm) * (dn + dm)));
+            }
+            if (n > m + 1)
+            {
+                m_beta[i] = std::sqrt((2.0 * dn + 1.0) * (dn + dm - 1.0) * (dn - dm - 1.0) / ((2.0 * dn - 3.0) * (dn + dm) * (dn - dm)));
+            }
+            m_raise[i] = std::sqrt((m == 0 ? 0.5 : 1.0) * (2.0 * dn + 1.0) * (dn + dm + 1.0) * (dn + dm + 2.0) / (2.0 * dn + 3.0));
+            if (m > 0)
+            {
+                m_lower[i] = std::sqrt((m == 1 ? 2.0 : 1.0) * (2.0 * dn + 1.0) * (dn - dm + 2.0) * (dn - dm + 1.0) / (2.0 * dn + 3.0));
+            }
+            m_vertical[i] = std::sqrt((2.0 * dn + 1.0) * (dn + dm + 1.0) * (dn - dm + 1.0) / (2.0 * dn + 3.0));
+        }
+        if (n > 0)
+        {
+            m_sectoral[n] = n == 1 ? std::sqrt(3.0) : std::sqrt((2.0 * dn + 1.0) / (2.0 * dn));
+        }
+    }
+}
+
+IO::Astrodynamics::Propagators::GeopotentialModel
+IO::Astrodynamics::Propagators::GeopotentialModel::ReadFile(const std::string &path, int maxDegree, int maxOrder, double mu, double radius)
+{
+    std::ifstream inFile(path);
+    if (!inFile.is_open())
+    {
+        throw IO::Astrodynamics::Exception::SDKException("Unable to open geopotential model file " + path);
+    }
+
+    //EGM tables start with a degree, ICGEM files start with a header
+    std::string first;
+    inFile >> first;
+    inFile.clear();
+    inFile.seekg(0);
+    if (first.empty() || std::isdigit(static_cast<unsigned char>(first[0])))
+    {
+        return ReadEGM(inFile, maxDegree, maxOrder, mu, radius);
+    }
+    return ReadICGEM(inFile, maxDegree, maxOrder);
+}
+
+IO::Astrodynamics::Propagators::GeopotentialModel IO::Astrodynamics::Propagators::GeopotentialModel::ReadICGEM(std::istream &stream, int maxDegree, int maxOrder)
+{
+    Coefficients coefficients(maxDegree, maxOrder);
+    double mu = std::numeric_limits<double>::quiet_NaN();
+    double radius = std::numeric_limits<double>::quiet_NaN();
+    bool isNormalized = true;
+    bool isHeaderRead = false;
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        std::istringstream record(line);
+        std::string key;
+        if (!(record >> key))
+        {
+            continue;
+        }
+        if (!isHeaderRead)
+        {
+            if (key == "end_of_head")
+            {
+                isHeaderRead = true;
+            }
+            else if (key == "earth_gravity_constant" || key == "gravity_constant")
+            {
+                ReadNumber(record, mu);
+            }
+            else if (key == "radius")
+            {
+                ReadNumber(record, radius);
+            }
+            else if (key == "norm")
+            {
+                std::string norm;
+                record >> norm;
+                isNormalized = norm != "unnormalized";
+            }
+            continue;
+        }
+        if (key != "gfc" && key != "gfct")
+        {
+            continue;
+        }
+        if (!coefficients.Read(record))
+        {
+            throw IO::Astrodynamics::Exception::SDKException("Invalid ICGEM record : " + line);
+        }
+    }
+    if (!isHeaderRead || !(mu > 0.0) || !(radius > 0.0))
+    {
+        throw IO::Astrodynamics::Exception::SDKException("ICGEM header must define gravity constant and radius");
+    }
+
+    if (!isNormalized)
+    {
+        for (int n = 0; n <= coefficients.HighestDegree; ++n)
+        {
+            for (int m = 0; m <= std::min(n, maxOrder); ++m)
+            {
+                //Normalization factor computed in logarithm, factorials overflow for high degrees
+                const double factor = std::exp(0.5 * (std::log((m == 0 ? 1.0 : 2.0) * (2.0 * n + 1.0)) + std::lgamma(n - m + 1.0) - std::lgamma(n + m + 1.0)));
+                coefficients.C[Index(n, m)] /= factor;
+                coefficients.S[Index(n, m)] /= factor;
+            }
+        }
+    }
+    return coefficients.Build(mu, radius);
+}
+
+IO::Astrodynamics::Propagators::GeopotentialModel
+IO::Astrodynamics::Propagators::GeopotentialModel::ReadEGM(std::istream &stream, int maxDegree, int maxOrder, double mu, double radius)
+{
+    Coefficients coefficients(maxDegree, maxOrder);
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+        {
+            continue;
+        }
+        std::istringstream record(line);
+        if (!coefficients.Read(record))
+        {
+            throw IO::Astrodynamics::Exception::SDKException("Invalid EGM record : " + line);
+        }
+    }
+    return coefficients.Build(mu, radius);
+}
+
+void IO::Astrodynamics::Propagators::GeopotentialModel::Evaluate(const double position[3], double *potential, double acceleration[3], double gradient[9]) const
+{
+    const double r2 = position[0] * position[0] + position[1] * position[1] + position[2] * position[2];
+    if (!(r2 > 0.0) || std::isinf(r2))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Position must be finite and not null");
+    }
+
+    //Each derivative raises degree by one
+    const int extra = gradient ? 2 : (acceleration ? 1 : 0);
+    const int degree = m_maxDegree + extra;
+    const int order = std::min(m_maxOrder + extra, degree);
+    const std::size_t size = Index(degree + 1, 0);
+    double *v = Buffer(2 * size);
+    double *w = v + size;
+
+    //Normalized solid harmonics V + iW, computed degree by degree so orders of a degree are independent
+    const double rho = m_radius / r2;
+    const double x = position[0] * rho;
+    const double y = position[1] * rho;
+    const double z = position[2] * rho;
+    const double rho2 = m_radius * rho;
+    v[0] = m_radius / std::sqrt(r2);
+    w[0] = 0.0;
+    for (int n = 1; n <= degree; ++n)
+    {
+        const std::size_t row = Index(n, 0);
+        const std::size_t previous = Index(n - 1, 0);
+        const int last = std::min(n - 2, order);
+        if (last >= 0)
+        {
+            const std::size_t before = Index(n - 2, 0);
+            for (int m = 0; m <= last; ++m)
+            {
+                v[row + m] = m_alpha[row + m] * z * v[previous + m] - m_beta[row + m] * rho2 * v[before + m];
+                w[row + m] = m_alpha[row + m] * z * w[previous + m] - m_beta[row + m] * rho2 * w[before + m];
+            }
+        }
+        if (n - 1 <= order)
+        {
+            v[row + n - 1] = m_alpha[row + n - 1] * z * v[previous + n - 1];
+            w[row + n - 1] = m_alpha[row + n - 1] * z * w[previous + n - 1];
+        }
+        if (n <= order)
+        {
+            v[row + n] = m_sectoral[n] * (x * v[previous + n - 1] - y * w[previous + n - 1]);
+            w[row + n] = m_sectoral[n] * (x * w[previous + n - 1] + y * v[previous + n - 1]);
+        }
+    }
+
+    //Potential is Re(K * Z) summed with K = C - iS, derivatives raise the degree and shift the order
+    double u{};
+    double a[3]{};
+    double h[3][3]{};
+    for (int n = 0; n <= m_maxDegree; ++n)
+    {
+        for (int m = 0; m <= std::min(n, m_maxOrder); ++m)
+        {
+            const std::size_t k = Index(n, m);
+            const double re = m_c[k];
+            const double im = -m_s[k];
+            if (re == 0.0 && im == 0.0)
+            {
+                continue;
+            }
+            u += re * v[k] - im * w[k];
+            if (gradient)
+            {
+                //Second derivatives apply the derivative rule to each first derivative term
+                for (int i = 0; i < 3; ++i)
+                {
+                    Term terms[2];
+                    const int count = Derive(i, m, m_raise[k], m_lower[k], m_vertical[k], re, im, terms);
+                    for (int t = 0; t < count; ++t)
+                    {
+                        const std::size_t j = Index(n + 1, terms[t].Order);
+                        a[i] += terms[t].Re * v[j] - terms[t].Im * w[j];
+                        for (int l = i; l < 3; ++l)
+                        {
+                            Term second[2];
+                            const int secondCount = Derive(l, terms[t].Order, m_raise[j], m_lower[j], m_vertical[j], terms[t].Re, terms[t].Im, second);
+                            for (int s = 0; s < secondCount; ++s)
+                            {
+                                const std::size_t q = Index(n + 2, second[s].Order);
+                                h[i][l] += second[s].Re * v[q] - second[s].Im * w[q];
+                            }
+                        }
+                    }
+                }
+            }
+            else if (acceleration)
+            {
+                //Same derivative rule written out, it's the hot path of propagations
+                const double c = m_c[k];
+                const double s = m_s[k];
+                const std::size_t j = Index(n + 1, m);
+                if (m == 0)
+                {
+                    a[0] -= m_raise[k] * c * v[j + 1];
+                    a[1] -= m_raise[k] * c * w[j + 1];
+                }
+                else
+                {
+                    const double raise = 0.5 * m_raise[k];
+                    const double lower = 0.5 * m_lower[k];
+                    a[0] += lower * (c * v[j - 1] + s * w[j - 1]) - raise * (c * v[j + 1] + s * w[j + 1]);
+                    a[1] += lower * (s * v[j - 1] - c * w[j - 1]) + raise * (s * v[j + 1] - c * w[j + 1]);
+                }
+                a[2] -= m_vertical[k] * (c * v[j] + s * w[j]);
+            }
+        }
+    }
+
+    if (potential)
+    {
+        *potential = m_mu / m_radius * u;
+    }
+    if (acceleration)
+    {
+        const double factor = m_mu / (m_radius * m_radius);
+        for (int i = 0; i < 3; ++i)
+        {
+            acceleration[i] = factor * a[i];
+        }
+    }
+    if (gradient)
+    {
+        const double factor = m_mu / (m_radius * m_radius * m_radius);
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int l = i; l < 3; ++l)
+            {
+                gradient[3 * i + l] = gradient[3 * l + i] = factor * h[i][l];
+            }
+        }
+    }
+}
+
+double IO::Astrodynamics::Propagators::GeopotentialModel::GetPotential(const double position[3]) const
+{
+    double potential{};
+    Evaluate(position, &potential, nullptr, nullptr);
+    return potential;
+}
+
+void IO::Astrodynamics::Propagators::GeopotentialModel::GetAcceleration(const double position[3], double acceleration[3], double gradient[9]) const
+{
+    Evaluate(position, nullptr, acceleration, gradient);
+}
+
+void IO::Astrodynamics::Propagators::GeopotentialModel::GetAccelerations(std::size_t count, const double *positions, double *accelerations, double *gradients,
+                                                                         unsigned int threadCount) const
+{
+    if (count > 0 && (!positions || !accelerations))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Positions and accelerations must be allocated");
+    }
+    //Positions are checked before threads start, evaluations can't fail afterward
+    for (std::size_t i = 0; i < 3 * count; ++i)
+    {
+        if (!std::isfinite(positions[i]))
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Positions must be finite");
+        }
+    }
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (positions[3 * i] == 0.0 && positions[3 * i + 1] == 0.0 && positions[3 * i + 2] == 0.0)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Positions must not be null");
+        }
+    }
+
+    IO::Astrodynamics::Helpers::ParallelFor(IO::Astrodynamics::Helpers::ThreadCount(threadCount, count / MIN_POSITIONS_PER_THREAD), count,
+                                            [&](unsigned int, std::size_t begin, std::size_t end)
+                                            {
+                                                for (std::size_t i = begin; i < end; ++i)
+                                                {
+                                                    Evaluate(positions + 3 * i, nullptr, accelerations + 3 * i, gradients ? gradients + 9 * i : nullptr);
+                                                }
+                                            });
+}
+
+double IO::Astrodynamics::Propagators::GeopotentialModel::GetC(int n, int m) const
+{
+    if (n < 0 || m < 0 || m > n || n > m_maxDegree)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Degree and order are outside the model");
+    }
+    return m_c[Index(n, m)];
+}
+
+double IO::Astrodynamics::Propagators::GeopotentialModel::GetS(int n, int m) const
+{
+    if (n < 0 || m < 0 || m > n || n > m_maxDegree)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Degree and order are outside the model");
+    }
+    return m_s[Index(n, m)];
+}
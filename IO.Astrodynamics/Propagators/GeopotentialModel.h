@@ -0,0 +1,152 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_GEOPOTENTIALMODEL_H
+#define IO_GEOPOTENTIALMODEL_H
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace IO::Astrodynamics::Propagators
+{
+    /**
+     * @brief Spherical harmonics gravity field from fully normalized coefficients.
+     * Solid harmonics are computed with the normalized Cunningham recursion, which stays stable for high degrees.
+     * Positions, accelerations and gradients are expressed in the body fixed frame, the central term is included.
+     * Evaluations are thread safe, each thread reuses its own recursion buffer so calls don't allocate once it's sized.
+     */
+    class GeopotentialModel final
+    {
+    private:
+        const double m_mu;
+        const double m_radius;
+        const int m_maxDegree;
+        const int m_maxOrder;
+        //Coefficients indexed by n * (n + 1) / 2 + m
+        std::vector<double> m_c;
+        std::vector<double> m_s;
+        //Recursion factors and derivatives factors toward order m + 1, order m - 1 and along z, up to degree maxDegree + 2
+        std::vector<double> m_alpha;
+        std::vector<double> m_beta;
+        std::vector<double> m_sectoral;
+        std::vector<double> m_raise;
+        std::vector<double> m_lower;
+        std::vector<double> m_vertical;
+
+        void Evaluate(const double position[3], double *potential, double acceleration[3], double gradient[9]) const;
+
+    public:
+        static constexpr std::size_t MIN_POSITIONS_PER_THREAD{64};
+
+        /**
+         * @brief Construct a new Geopotential Model
+         *
+         * @param mu Gravitational parameter (m^3/s^2)
+         * @param radius Reference radius (m)
+         * @param maxDegree Highest degree used
+         * @param maxOrder Highest order used, lower or equal to maxDegree
+         * @param c Fully normalized cosine coefficients indexed by n * (n + 1) / 2 + m, at least up to maxDegree
+         * @param s Fully normalized sine coefficients indexed by n * (n + 1) / 2 + m, at least up to maxDegree
+         */
+        GeopotentialModel(double mu, double radius, int maxDegree, int maxOrder, std::vector<double> c, std::vector<double> s);
+
+        /**
+         * @brief Read a model file, ICGEM files are recognized by their header, other files are read as EGM coefficients tables
+         *
+         * @param path
+         * @param maxDegree Highest degree read
+         * @param maxOrder Highest order read
+         * @param mu Gravitational parameter used when the file doesn't define it (m^3/s^2)
+         * @param radius Reference radius used when the file doesn't define it (m)
+         * @return GeopotentialModel
+         */
+        static GeopotentialModel ReadFile(const std::string &path, int maxDegree, int maxOrder, double mu, double radius);
+
+        /**
+         * @brief Read an ICGEM model, gravity constant, radius and normalization are taken from the header.
+         * Time variable terms are ignored, reference values of gfct records are used.
+         *
+         * @param stream
+         * @param maxDegree Highest degree read
+         * @param maxOrder Highest order read
+         * @return GeopotentialModel
+         */
+        static GeopotentialModel ReadICGEM(std::istream &stream, int maxDegree, int maxOrder);
+
+        /**
+         * @brief Read an EGM coefficients table, each line gives degree, order, normalized C and S then optional sigmas.
+         * Fortran D exponents are accepted.
+         *
+         * @param stream
+         * @param maxDegree Highest degree read
+         * @param maxOrder Highest order read
+         * @param mu Gravitational parameter (m^3/s^2)
+         * @param radius Reference radius (m)
+         * @return GeopotentialModel
+         */
+        static GeopotentialModel ReadEGM(std::istream &stream, int maxDegree, int maxOrder, double mu, double radius);
+
+        /**
+         * @brief Get the gravitational potential
+         *
+         * @param position Body fixed position (m)
+         * @return double (m^2/s^2)
+         */
+        [[nodiscard]] double GetPotential(const double position[3]) const;
+
+        /**
+         * @brief Get the gravitational acceleration and optionally its gradient
+         *
+         * @param position Body fixed position (m)
+         * @param acceleration Output body fixed acceleration (m/s^2)
+         * @param gradient Optional output acceleration gradient, row major 3x3 matrix (1/s^2)
+         */
+        void GetAcceleration(const double position[3], double acceleration[3], double gradient[9] = nullptr) const;
+
+        /**
+         * @brief Get accelerations at many positions, positions are shared between threads
+         *
+         * @param count Positions count
+         * @param positions Body fixed positions, 3 values per position (m)
+         * @param accelerations Output accelerations, 3 values per position (m/s^2)
+         * @param gradients Optional output gradients, 9 values per position (1/s^2)
+         * @param threadCount Threads used, hardware concurrency when 0
+         */
+        void GetAccelerations(std::size_t count, const double *positions, double *accelerations, double *gradients = nullptr, unsigned int threadCount = 0) const;
+
+        [[nodiscard]] inline double GetMu() const
+        { return m_mu; }
+
+        [[nodiscard]] inline double GetRadius() const
+        { return m_radius; }
+
+        [[nodiscard]] inline int GetMaxDegree() const
+        { return m_maxDegree; }
+
+        [[nodiscard]] inline int GetMaxOrder() const
+        { return m_maxOrder; }
+
+        /**
+         * @brief Get a fully normalized cosine coefficient
+         *
+         * @param n Degree
+         * @param m Order
+         * @return double
+         */
+        [[nodiscard]] double GetC(int n, int m) const;
+
+        /**
+         * @brief Get a fully normalized sine coefficient
+         *
+         * @param n Degree
+         * @param m Order
+         * @return double
+         */
+        [[nodiscard]] double GetS(int n, int m) const;
+    };
+}
+
+#endif //IO_GEOPOTENTIALMODEL_H
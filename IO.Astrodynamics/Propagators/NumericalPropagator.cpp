@@ -0,0 +1,295 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <NumericalPropagator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <InvalidArgumentException.h>
+#include <SDKException.h>
+
+namespace
+{
+    //Dormand-Prince 5(4) tableau
+    constexpr double C2 = 1.0 / 5.0, C3 = 3.0 / 10.0, C4 = 4.0 / 5.0, C5 = 8.0 / 9.0;
+    constexpr double A21 = 1.0 / 5.0;
+    constexpr double A31 = 3.0 / 40.0, A32 = 9.0 / 40.0;
+    constexpr double A41 = 44.0 / 45.0, A42 = -56.0 / 15.0, A43 = 32.0 / 9.0;
+    constexpr double A51 = 19372.0 / 6561.0, A52 = -25360.0 / 2187.0, A53 = 64448.0 / 6561.0, A54 = -212.0 / 729.0;
+    constexpr double A61 = 9017.0 / 3168.0, A62 = -355.0 / 33.0, A63 = 46732.0 / 5247.0, A64 = 49.0 / 176.0, A65 = -5103.0 / 18656.0;
+    constexpr double A71 = 35.0 / 384.0, A73 = 500.0 / 1113.0, A74 = 125.0 / 192.0, A75 = -2187.0 / 6784.0, A76 = 11.0 / 84.0;
+    //Difference between fifth and fourth order solutions
+    constexpr double E1 = 71.0 / 57600.0, E3 = -71.0 / 16695.0, E4 = 71.0 / 1920.0, E5 = -17253.0 / 339200.0, E6 = 22.0 / 525.0, E7 = -1.0 / 40.0;
+
+    //Step size controller bounds
+    constexpr double SAFETY = 0.9;
+    constexpr double MINIMUM_FACTOR = 0.2;
+    constexpr double MAXIMUM_FACTOR = 5.0;
+}
+
+IO::Astrodynamics::Propagators::NumericalPropagator::NumericalPropagator(std::vector<std::shared_ptr<ForceModel>> forces, IntegrationScheme scheme, double step,
+                                                                         double relativeTolerance, double absoluteTolerance) : m_forces{std::move(forces)},
+                                                                                                                               m_scheme{scheme}, m_step{step},
+                                                                                                                               m_relativeTolerance{relativeTolerance},
+                                                                                                                               m_absoluteTolerance{absoluteTolerance}
+{
+    if (m_forces.empty() || std::any_of(m_forces.begin(), m_forces.end(), [](const auto &force) { return !force; }))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("At least one force model is required and force models must be defined");
+    }
+    if (!(step > 0.0) || std::isinf(step))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Step must be positive and finite");
+    }
+    if (scheme == IntegrationScheme::DormandPrince54 && (!(relativeTolerance > 0.0) || !(absoluteTolerance > 0.0)))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Tolerances must be positive");
+    }
+}
+
+void IO::Astrodynamics::Propagators::NumericalPropagator::Derivative(double epoch, const double *state, double *derivative)
+{
+    double acceleration[3]{};
+    for (const auto &force: m_forces)
+    {
+        force->AddAcceleration(epoch, state, acceleration);
+    }
+    derivative[0] = state[3];
+    derivative[1] = state[4];
+    derivative[2] = state[5];
+    derivative[3] = acceleration[0];
+    derivative[4] = acceleration[1];
+    derivative[5] = acceleration[2];
+    ++m_evaluations;
+}
+
+void IO::Astrodynamics::Propagators::NumericalPropagator::Integrate(double epoch, const double *state, double target, std::vector<Step> &steps)
+{
+    steps.clear();
+    if (target == epoch)
+    {
+        return;
+    }
+    const double direction = target > epoch ? 1.0 : -1.0;
+
+    double t = epoch;
+    double y[6], f[6];
+    std::copy(state, state + 6, y);
+    Derivative(t, y, f);
+    double h = direction * std::min(m_step, std::abs(target - epoch));
+
+    double k2[6], k3[6], k4[6], k5[6], k6[6], next[6], fNext[6], stage[6];
+    while (direction * (target - t) > 0.0)
+    {
+        const bool isLast = direction * (t + h - target) >= 0.0;
+        if (isLast)
+        {
+            h = target - t;
+        }
+        if (std::abs(h) < 64.0 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::abs(t)))
+        {
+            throw IO::Astrodynamics::Exception::SDKException("Integration step size underflow");
+        }
+
+        double factor = 1.0;
+        if (m_scheme == IntegrationScheme::RungeKutta4)
+        {
+            for (int i = 0; i < 6; ++i)
+            {
+                stage[i] = y[i] + 0.5 * h * f[i];
+            }
+            Derivative(t + 0.5 * h, stage, k2);
+            for (int i = 0; i < 6; ++i)
+            {
+                stage[i] = y[i] + 0.5 * h * k2[i];
+            }
+            Derivative(t + 0.5 * h, stage, k3);
+            for (int i = 0; i < 6; ++i)
+            {
+                stage[i] = y[i] + h * k3[i];
+            }
+            Derivative(t + h, stage, k4);
+            for (int i = 0; i < 6; ++i)
+            {
+                next[i] = y[i] + h / 6.0 * (f[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]);
+            }
+            //Derivative at step end is the first stage of the next step
+            Derivative(t + h, next, fNext);
+        }
+        else
+        {
+            for (int i = 0; i < 6; ++i)
+            {
+                stage[i] = y[i] + h * A21 * f[i];
+            }
+            Derivative(t + C2 * h, stage, k2);
+            for (int i = 0; i < 6; ++i)
+            {
+                stage[i] = y[i] + h * (A31 * f[i] + A32 * k2[i]);
+            }
+            Derivative(t + C3 * h, stage, k3);
+            for (int i = 0; i < 6; ++i)
+            {
+                stage[i] = y[i] + h * (A41 * f[i] + A42 * k2[i] + A43 * k3[i]);
+            }
+            Derivative(t + C4 * h, stage, k4);
+            for (int i = 0; i < 6; ++i)
+            {
+                stage[i] = y[i] + h * (A51 * f[i] + A52 * k2[i] + A53 * k3[i] + A54 * k4[i]);
+            }
+            Derivative(t + C5 * h, stage, k5);
+            for (int i = 0; i < 6; ++i)
+            {
+                stage[i] = y[i] + h * (A61 * f[i] + A62 * k2[i] + A63 * k3[i] + A64 * k4[i] + A65 * k5[i]);
+            }
+            Derivative(t + h, stage, k6);
+            for (int i = 0; i < 6; ++i)
+            {
+                next[i] = y[i] + h * (A71 * f[i] + A73 * k3[i] + A74 * k4[i] + A75 * k5[i] + A76 * k6[i]);
+            }
+            //First same as last, the seventh stage is the derivative at step end
+            Derivative(t + h, next, fNext);
+
+            double error = 0.0;
+            for (int i = 0; i < 6; ++i)
+            {
+                const double e = h * (E1 * f[i] + E3 * k3[i] + E4 * k4[i] + E5 * k5[i] + E6 * k6[i] + E7 * fNext[i]);
+                const double scale = m_absoluteTolerance + m_relativeTolerance * std::max(std::abs(y[i]), std::abs(next[i]));
+                error += (e / scale) * (e / scale);
+            }
+            error = std::sqrt(error / 6.0);
+
+            //Rejected step, NaN errors are rejected too
+            if (!(error <= 1.0))
+            {
+                h *= std::isnan(error) ? MINIMUM_FACTOR : std::max(MINIMUM_FACTOR, SAFETY * std::pow(error, -0.2));
+                continue;
+            }
+            factor = error > 0.0 ? std::clamp(SAFETY * std::pow(error, -0.2), MINIMUM_FACTOR, MAXIMUM_FACTOR) : MAXIMUM_FACTOR;
+        }
+
+        auto &step = steps.emplace_back();
+        step.Epoch = t;
+        step.Duration = h;
+        std::copy(y, y + 6, step.Begin);
+        std::copy(f + 3, f + 6, step.Begin + 6);
+        std::copy(next, next + 6, step.End);
+        std::copy(fNext + 3, fNext + 6, step.End + 6);
+
+        t = isLast ? target : t + h;
+        std::copy(next, next + 6, y);
+        std::copy(fNext, fNext + 6, f);
+        h *= factor;
+    }
+}
+
+void IO::Astrodynamics::Propagators::NumericalPropagator::Propagate(double epoch, const double state[6], double begin, double end)
+{
+    if (!(begin <= end) || std::isinf(begin) || std::isinf(end) || !std::isfinite(epoch))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Window must be finite and ordered");
+    }
+    if (!std::all_of(state, state + 6, [](double value) { return std::isfinite(value); }))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("State must be finite");
+    }
+
+    //Force models are prepared once for the whole window, nothing is read during integration
+    const double lower = std::min(begin, epoch);
+    const double upper = std::max(end, epoch);
+    for (const auto &force: m_forces)
+    {
+        force->Prepare(lower, upper);
+    }
+
+    m_evaluations = 0;
+    m_epoch = epoch;
+    Integrate(epoch, state, upper, m_forwardSteps);
+    Integrate(epoch, state, lower, m_backwardSteps);
+
+    //Zero length window is described by a single degenerated step
+    if (m_forwardSteps.empty() && m_backwardSteps.empty())
+    {
+        double derivative[6];
+        Derivative(epoch, state, derivative);
+        auto &step = m_forwardSteps.emplace_back();
+        step.Epoch = epoch;
+        step.Duration = 0.0;
+        std::copy(state, state + 6, step.Begin);
+        std::copy(derivative + 3, derivative + 6, step.Begin + 6);
+        std::copy(step.Begin, step.Begin + 9, step.End);
+    }
+}
+
+void IO::Astrodynamics::Propagators::NumericalPropagator::Interpolate(const Step &step, double epoch, double *state)
+{
+    if (step.Duration == 0.0)
+    {
+        std::copy(step.Begin, step.Begin + 6, state);
+        return;
+    }
+
+    //Quintic Hermite interpolation of positions, velocities are its derivative
+    const double h = step.Duration;
+    const double s = (epoch - step.Epoch) / h;
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+    const double s4 = s3 * s;
+    const double s5 = s4 * s;
+    const double h0 = 1.0 - 10.0 * s3 + 15.0 * s4 - 6.0 * s5;
+    const double h1 = s - 6.0 * s3 + 8.0 * s4 - 3.0 * s5;
+    const double h2 = 0.5 * (s2 - 3.0 * s3 + 3.0 * s4 - s5);
+    const double h3 = 10.0 * s3 - 15.0 * s4 + 6.0 * s5;
+    const double h4 = -4.0 * s3 + 7.0 * s4 - 3.0 * s5;
+    const double h5 = 0.5 * (s3 - 2.0 * s4 + s5);
+    const double d0 = -30.0 * s2 + 60.0 * s3 - 30.0 * s4;
+    const double d1 = 1.0 - 18.0 * s2 + 32.0 * s3 - 15.0 * s4;
+    const double d2 = 0.5 * (2.0 * s - 9.0 * s2 + 12.0 * s3 - 5.0 * s4);
+    const double d4 = -12.0 * s2 + 28.0 * s3 - 15.0 * s4;
+    const double d5 = 0.5 * (3.0 * s2 - 8.0 * s3 + 5.0 * s4);
+    for (int i = 0; i < 3; ++i)
+    {
+        const double p0 = step.Begin[i], v0 = h * step.Begin[i + 3], a0 = h * h * step.Begin[i + 6];
+        const double p1 = step.End[i], v1 = h * step.End[i + 3], a1 = h * h * step.End[i + 6];
+        state[i] = h0 * p0 + h1 * v0 + h2 * a0 + h3 * p1 + h4 * v1 + h5 * a1;
+        state[i + 3] = (d0 * (p0 - p1) + d1 * v0 + d2 * a0 + d4 * v1 + d5 * a1) / h;
+    }
+}
+
+void IO::Astrodynamics::Propagators::NumericalPropagator::GetState(double epoch, double state[6]) const
+{
+    if (epoch >= m_epoch && !m_forwardSteps.empty())
+    {
+        const auto &last = m_forwardSteps.back();
+        if (epoch <= last.Epoch + last.Duration)
+        {
+            //Steps begin epochs are increasing
+            auto it = std::upper_bound(m_forwardSteps.begin(), m_forwardSteps.end(), epoch, [](double value, const Step &step) { return value < step.Epoch; });
+            Interpolate(*std::prev(std::max(it, std::next(m_forwardSteps.begin()))), epoch, state);
+            return;
+        }
+    }
+    if (epoch <= m_epoch && !m_backwardSteps.empty())
+    {
+        const auto &last = m_backwardSteps.back();
+        if (epoch >= last.Epoch + last.Duration)
+        {
+            //Steps begin epochs are decreasing
+            auto it = std::upper_bound(m_backwardSteps.begin(), m_backwardSteps.end(), epoch, [](double value, const Step &step) { return value > step.Epoch; });
+            Interpolate(*std::prev(std::max(it, std::next(m_backwardSteps.begin()))), epoch, state);
+            return;
+        }
+    }
+    throw IO::Astrodynamics::Exception::InvalidArgumentException("Epoch is outside the propagated window");
+}
+
+void IO::Astrodynamics::Propagators::NumericalPropagator::GetStates(std::size_t count, const double *epochs, double *states) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        GetState(epochs[i], states + 6 * i);
+    }
+}
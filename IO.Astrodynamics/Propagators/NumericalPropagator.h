@@ -0,0 +1,117 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_NUMERICALPROPAGATOR_H
+#define IO_NUMERICALPROPAGATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <ForceModel.h>
+
+namespace IO::Astrodynamics::Propagators
+{
+    enum class IntegrationScheme
+    {
+        //Adaptive Dormand-Prince 5(4)
+        DormandPrince54,
+        //Fixed step classical Runge-Kutta
+        RungeKutta4
+    };
+
+    /**
+     * @brief Numerical orbit propagator with continuous output.
+     * Every integration step is kept with position, velocity and acceleration at both ends,
+     * so states at any epoch of the propagated window are evaluated with a quintic Hermite interpolation without new force evaluation.
+     * Epochs are TDB seconds from J2000, states are relative to the central body in an inertial frame.
+     */
+    class NumericalPropagator final
+    {
+    private:
+        struct Step
+        {
+            double Epoch;
+            double Duration;
+            //Position, velocity and acceleration at step begin then at step end
+            double Begin[9];
+            double End[9];
+        };
+
+        const std::vector<std::shared_ptr<ForceModel>> m_forces;
+        const IntegrationScheme m_scheme;
+        const double m_step;
+        const double m_relativeTolerance;
+        const double m_absoluteTolerance;
+        double m_epoch{};
+        std::vector<Step> m_forwardSteps;
+        std::vector<Step> m_backwardSteps;
+        std::size_t m_evaluations{};
+
+        void Derivative(double epoch, const double *state, double *derivative);
+
+        void Integrate(double epoch, const double *state, double target, std::vector<Step> &steps);
+
+        static void Interpolate(const Step &step, double epoch, double *state);
+
+    public:
+        /**
+         * @brief Construct a new Numerical Propagator
+         *
+         * @param forces Force models, accelerations are summed
+         * @param scheme Integration scheme
+         * @param step Initial step for adaptive schemes, step for fixed step schemes (s)
+         * @param relativeTolerance Local error relative tolerance of adaptive schemes
+         * @param absoluteTolerance Local error absolute tolerance of adaptive schemes, applied to positions (m) and velocities (m/s)
+         */
+        NumericalPropagator(std::vector<std::shared_ptr<ForceModel>> forces, IntegrationScheme scheme = IntegrationScheme::DormandPrince54, double step = 60.0,
+                            double relativeTolerance = 1E-12, double absoluteTolerance = 1E-06);
+
+        /**
+         * @brief Propagate a state over a window, the window doesn't have to contain the initial epoch.
+         * Force models are prepared for the whole window, then the state is integrated forward and backward from its epoch.
+         *
+         * @param epoch Initial epoch (s)
+         * @param state Initial position and velocity (m, m/s)
+         * @param begin Window begin (s)
+         * @param end Window end (s)
+         */
+        void Propagate(double epoch, const double state[6], double begin, double end);
+
+        /**
+         * @brief Get the state at an epoch of the propagated window
+         *
+         * @param epoch (s)
+         * @param state Output position and velocity (m, m/s)
+         */
+        void GetState(double epoch, double state[6]) const;
+
+        /**
+         * @brief Get states at many epochs of the propagated window
+         *
+         * @param count Epochs count
+         * @param epochs (s)
+         * @param states Output positions and velocities, 6 values per epoch (m, m/s)
+         */
+        void GetStates(std::size_t count, const double *epochs, double *states) const;
+
+        /**
+         * @brief Get the integration steps count of the last propagation
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] inline std::size_t GetStepCount() const
+        { return m_forwardSteps.size() + m_backwardSteps.size(); }
+
+        /**
+         * @brief Get the force models evaluations count of the last propagation
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] inline std::size_t GetEvaluationCount() const
+        { return m_evaluations; }
+    };
+}
+
+#endif //IO_NUMERICALPROPAGATOR_H
@@ -0,0 +1,42 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <PointMassGravity.h>
+
+#include <cmath>
+
+#include <InvalidArgumentException.h>
+
+IO::Astrodynamics::Propagators::PointMassGravity::PointMassGravity(double mu) : m_mu{mu}
+{
+    if (!(mu > 0.0))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Gravitational parameter must be positive");
+    }
+}
+
+void IO::Astrodynamics::Propagators::PointMassGravity::AddAcceleration([[maybe_unused]] double epoch, const double state[6], double acceleration[3]) const
+{
+    const double r2 = state[0] * state[0] + state[1] * state[1] + state[2] * state[2];
+    const double factor = -m_mu / (r2 * std::sqrt(r2));
+    for (int i = 0; i < 3; ++i)
+    {
+        acceleration[i] += factor * state[i];
+    }
+}
+
+void IO::Astrodynamics::Propagators::PointMassGravity::AddAccelerations([[maybe_unused]] double epoch, std::size_t count, const double *const states[6],
+                                                                         double *const accelerations[3]) const
+{
+    const double *x = states[0], *y = states[1], *z = states[2];
+    double *ax = accelerations[0], *ay = accelerations[1], *az = accelerations[2];
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const double r2 = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+        const double factor = -m_mu / (r2 * std::sqrt(r2));
+        ax[i] += factor * x[i];
+        ay[i] += factor * y[i];
+        az[i] += factor * z[i];
+    }
+}
@@ -0,0 +1,37 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_POINTMASSGRAVITY_H
+#define IO_POINTMASSGRAVITY_H
+
+#include <ForceModel.h>
+
+namespace IO::Astrodynamics::Propagators
+{
+    /**
+     * @brief Central body point mass gravity
+     */
+    class PointMassGravity final : public ForceModel
+    {
+    private:
+        const double m_mu;
+
+    public:
+        /**
+         * @brief Construct a new Point Mass Gravity
+         *
+         * @param mu Gravitational parameter of the central body (m^3/s^2)
+         */
+        explicit PointMassGravity(double mu);
+
+        void AddAcceleration(double epoch, const double state[6], double acceleration[3]) const override;
+
+        void AddAccelerations(double epoch, std::size_t count, const double *const states[6], double *const accelerations[3]) const override;
+
+        [[nodiscard]] inline double GetMu() const
+        { return m_mu; }
+    };
+}
+
+#endif //IO_POINTMASSGRAVITY_H
@@ -0,0 +1,878 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <SGP4.h>
+
+#include <cmath>
+
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+#include <TLECatalog.h>
+
+namespace
+{
+    constexpr double X2O3 = 2.0 / 3.0;
+    constexpr double TEMP4 = 1.5e-12;
+    constexpr double J3OJ2 = IO::Astrodynamics::Propagators::SGP4::J3 / IO::Astrodynamics::Propagators::SGP4::J2;
+    constexpr double RPTIM = 4.37526908801129966e-3;
+
+    //Greenwich sidereal time from days since 1950 Jan 0.0, AFSPC formulation
+    double Gsto(double epoch)
+    {
+        const double ts70 = epoch - 7305.0;
+        const double ds70 = std::floor(ts70 + 1.0e-8);
+        const double tfrac = ts70 - ds70;
+        const double c1 = 1.72027916940703639e-2;
+        const double thgr70 = 1.7321343856509374;
+        const double fk5r = 5.07551419432269442e-15;
+        double gsto = std::fmod(thgr70 + c1 * ds70 + (c1 + IO::Astrodynamics::Constants::_2PI) * tfrac + ts70 * ts70 * fk5r, IO::Astrodynamics::Constants::_2PI);
+        if (gsto < 0.0)
+        {
+            gsto += IO::Astrodynamics::Constants::_2PI;
+        }
+        return gsto;
+    }
+}
+
+IO::Astrodynamics::Propagators::SGP4Elements IO::Astrodynamics::Propagators::SGP4Elements::Parse(const std::string &line1, const std::string &line2)
+{
+    return FromRecord(IO::Astrodynamics::OrbitalParameters::TLECatalog::ParseRecord(line1, line2));
+}
+
+IO::Astrodynamics::Propagators::SGP4Elements IO::Astrodynamics::Propagators::SGP4Elements::FromRecord(const IO::Astrodynamics::OrbitalParameters::TLERecord &record)
+{
+    SGP4Elements elements;
+    elements.SatelliteNumber = record.SatelliteNumber;
+    elements.Epoch = IO::Astrodynamics::Time::UTC(std::chrono::duration<double>(record.Epoch));
+    elements.BStar = record.BStar;
+    elements.Inclination = record.Inclination;
+    elements.RightAscendingNode = record.RightAscendingNode;
+    elements.Eccentricity = record.Eccentricity;
+    elements.PeriapsisArgument = record.PeriapsisArgument;
+    elements.MeanAnomaly = record.MeanAnomaly;
+    elements.MeanMotion = record.MeanMotion;
+    return elements;
+}
+
+IO::Astrodynamics::Propagators::SGP4::SGP4(const SGP4Elements &elements) : m_satelliteNumber{elements.SatelliteNumber}, m_epoch{elements.Epoch.ToTDB()},
+                                                                           m_bstar{elements.BStar}, m_ecco{elements.Eccentricity}, m_argpo{elements.PeriapsisArgument},
+                                                                           m_inclo{elements.Inclination}, m_mo{elements.MeanAnomaly}, m_no{elements.MeanMotion},
+                                                                           m_nodeo{elements.RightAscendingNode}
+{
+    if (m_no <= 0.0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Mean motion must be a positive number");
+    }
+
+    //Days since 1950 Jan 0.0 UTC
+    const double epoch = elements.Epoch.GetSecondsFromJ2000().count() / 86400.0 + 18263.5;
+
+    const double ss = SO / ER + 1.0;
+    const double qzms2t = std::pow((QO - SO) / ER, 4.0);
+
+    //Recover original mean motion and semi major axis from Kozai elements
+    const double eccsq = m_ecco * m_ecco;
+    const double omeosq = 1.0 - eccsq;
+    const double rteosq = std::sqrt(omeosq);
+    const double cosio = std::cos(m_inclo);
+    const double cosio2 = cosio * cosio;
+    const double ak = std::pow(KE / m_no, X2O3);
+    const double d1 = 0.75 * J2 * (3.0 * cosio2 - 1.0) / (rteosq * omeosq);
+    double del = d1 / (ak * ak);
+    const double adel = ak * (1.0 - del * del - del * (1.0 / 3.0 + 134.0 * del * del / 81.0));
+    del = d1 / (adel * adel);
+    m_no = m_no / (1.0 + del);
+
+    const double ao = std::pow(KE / m_no, X2O3);
+    const double sinio = std::sin(m_inclo);
+    const double po = ao * omeosq;
+    const double con42 = 1.0 - 5.0 * cosio2;
+    m_con41 = -con42 - cosio2 - cosio2;
+    const double posq = po * po;
+    const double rp = ao * (1.0 - m_ecco);
+    m_gsto = Gsto(epoch);
+
+    if (omeosq >= 0.0 || m_no >= 0.0)
+    {
+        m_isSimplified = rp < (220.0 / ER + 1.0);
+        double sfour = ss;
+        double qzms24 = qzms2t;
+        const double perige = (rp - 1.0) * ER;
+
+        //Atmospheric parameters for low perigee
+        if (perige < 156.0)
+        {
+            sfour = perige - 78.0;
+            if (perige < 98.0)
+            {
+                sfour = 20.0;
+            }
+            qzms24 = std::pow((120.0 - sfour) / ER, 4.0);
+            sfour = sfour / ER + 1.0;
+        }
+        const double pinvsq = 1.0 / posq;
+
+        const double tsi = 1.0 / (ao - sfour);
+        m_eta = ao * m_ecco * tsi;
+        const double etasq = m_eta * m_eta;
+        const double eeta = m_ecco * m_eta;
+        const double psisq = std::abs(1.0 - etasq);
+        const double coef = qzms24 * std::pow(tsi, 4.0);
+        const double coef1 = coef / std::pow(psisq, 3.5);
+        const double cc2 = coef1 * m_no * (ao * (1.0 + 1.5 * etasq + eeta * (4.0 + etasq)) +
+                                           0.375 * J2 * tsi / psisq * m_con41 * (8.0 + 3.0 * etasq * (8.0 + etasq)));
+        m_cc1 = m_bstar * cc2;
+        double cc3 = 0.0;
+        if (m_ecco > 1.0e-4)
+        {
+            cc3 = -2.0 * coef * tsi * J3OJ2 * m_no * sinio / m_ecco;
+        }
+        m_x1mth2 = 1.0 - cosio2;
+        m_cc4 = 2.0 * m_no * coef1 * ao * omeosq * (m_eta * (2.0 + 0.5 * etasq) + m_ecco * (0.5 + 2.0 * etasq) - J2 * tsi / (ao * psisq) *
+                                                                                                              (-3.0 * m_con41 * (1.0 - 2.0 * eeta + etasq * (1.5 - 0.5 * eeta)) +
+                                                                                                               0.75 * m_x1mth2 * (2.0 * etasq - eeta * (1.0 + etasq)) *
+                                                                                                               std::cos(2.0 * m_argpo)));
+        m_cc5 = 2.0 * coef1 * ao * omeosq * (1.0 + 2.75 * (etasq + eeta) + eeta * etasq);
+        const double cosio4 = cosio2 * cosio2;
+        const double temp1 = 1.5 * J2 * pinvsq * m_no;
+        const double temp2 = 0.5 * temp1 * J2 * pinvsq;
+        const double temp3 = -0.46875 * J4 * pinvsq * pinvsq * m_no;
+        m_mdot = m_no + 0.5 * temp1 * rteosq * m_con41 + 0.0625 * temp2 * rteosq * (13.0 - 78.0 * cosio2 + 137.0 * cosio4);
+        m_argpdot = -0.5 * temp1 * con42 + 0.0625 * temp2 * (7.0 - 114.0 * cosio2 + 395.0 * cosio4) + temp3 * (3.0 - 36.0 * cosio2 + 49.0 * cosio4);
+        const double xhdot1 = -temp1 * cosio;
+        m_nodedot = xhdot1 + (0.5 * temp2 * (4.0 - 19.0 * cosio2) + 2.0 * temp3 * (3.0 - 7.0 * cosio2)) * cosio;
+        const double xpidot = m_argpdot + m_nodedot;
+        m_omgcof = m_bstar * cc3 * std::cos(m_argpo);
+        m_xmcof = 0.0;
+        if (m_ecco > 1.0e-4)
+        {
+            m_xmcof = -X2O3 * coef * m_bstar / eeta;
+        }
+        m_nodecf = 3.5 * omeosq * xhdot1 * m_cc1;
+        m_t2cof = 1.5 * m_cc1;
+
+        //Avoid division by zero for inclination of 180 degrees
+        m_xlcof = -0.25 * J3OJ2 * sinio * (3.0 + 5.0 * cosio) / (std::abs(cosio + 1.0) > 1.5e-12 ? 1.0 + cosio : TEMP4);
+        m_aycof = -0.5 * J3OJ2 * sinio;
+        m_delmo = std::pow(1.0 + m_eta * std::cos(m_mo), 3.0);
+        m_sinmao = std::sin(m_mo);
+        m_x7thm1 = 7.0 * cosio2 - 1.0;
+
+        if (Constants::_2PI / m_no >= 225.0)
+        {
+            m_isDeepSpace = true;
+            m_isSimplified = true;
+            InitializeDeepSpace(epoch, xpidot, eccsq);
+        }
+
+        if (!m_isSimplified)
+        {
+            const double cc1sq = m_cc1 * m_cc1;
+            m_d2 = 4.0 * ao * tsi * cc1sq;
+            const double temp = m_d2 * tsi * m_cc1 / 3.0;
+            m_d3 = (17.0 * ao + sfour) * temp;
+            m_d4 = 0.5 * temp * ao * tsi * (221.0 * ao + 31.0 * sfour) * m_cc1;
+            m_t3cof = m_d2 + 2.0 * cc1sq;
+            m_t4cof = 0.25 * (3.0 * m_d3 + m_cc1 * (12.0 * m_d2 + 10.0 * cc1sq));
+            m_t5cof = 0.2 * (3.0 * m_d4 + 12.0 * m_cc1 * m_d3 + 6.0 * m_d2 * m_d2 + 15.0 * cc1sq * (2.0 * m_d2 + cc1sq));
+        }
+    }
+
+    double position[3], velocity[3];
+    m_status = Propagate(0.0, position, velocity);
+}
+
+void IO::Astrodynamics::Propagators::SGP4::InitializeDeepSpace(double epoch, double xpidot, double eccsq)
+{
+    constexpr double zes = 0.01675;
+    constexpr double zel = 0.05490;
+    constexpr double c1ss = 2.9864797e-6;
+    constexpr double c1l = 4.7968065e-7;
+    constexpr double zsinis = 0.39785416;
+    constexpr double zcosis = 0.91744867;
+    constexpr double zcosgs = 0.1945905;
+    constexpr double zsings = -0.98088458;
+    constexpr double zns = 1.19459e-5;
+    constexpr double znl = 1.5835218e-4;
+
+    //Lunar and solar terms (dscom)
+    double nm = m_no;
+    double em = m_ecco;
+    const double snodm = std::sin(m_nodeo);
+    const double cnodm = std::cos(m_nodeo);
+    const double sinomm = std::sin(m_argpo);
+    const double cosomm = std::cos(m_argpo);
+    const double sinim = std::sin(m_inclo);
+    const double cosim = std::cos(m_inclo);
+    double emsq = em * em;
+    const double betasq = 1.0 - emsq;
+    const double rtemsq = std::sqrt(betasq);
+
+    m_peo = 0.0;
+    m_pinco = 0.0;
+    m_plo = 0.0;
+    m_pgho = 0.0;
+    m_pho = 0.0;
+    const double day = epoch + 18261.5;
+    const double xnodce = std::fmod(4.5236020 - 9.2422029e-4 * day, Constants::_2PI);
+    const double stem = std::sin(xnodce);
+    const double ctem = std::cos(xnodce);
+    const double zcosil = 0.91375164 - 0.03568096 * ctem;
+    const double zsinil = std::sqrt(1.0 - zcosil * zcosil);
+    const double zsinhl = 0.089683511 * stem / zsinil;
+    const double zcoshl = std::sqrt(1.0 - zsinhl * zsinhl);
+    const double gam = 5.8351514 + 0.0019443680 * day;
+    double zx = 0.39785416 * stem / zsinil;
+    const double zy = zcoshl * ctem + 0.91744867 * zsinhl * stem;
+    zx = std::atan2(zx, zy);
+    zx = gam + zx - xnodce;
+    const double zcosgl = std::cos(zx);
+    const double zsingl = std::sin(zx);
+
+    //Solar terms first then lunar terms
+    double zcosg = zcosgs, zsing = zsings, zcosi = zcosis, zsini = zsinis, zcosh = cnodm, zsinh = snodm, cc = c1ss;
+    const double xnoi = 1.0 / nm;
+    double s1{}, s2{}, s3{}, s4{}, s5{}, s6{}, s7{}, ss1{}, ss2{}, ss3{}, ss4{}, ss5{}, ss6{}, ss7{};
+    double z1{}, z2{}, z3{}, z11{}, z12{}, z13{}, z21{}, z22{}, z23{}, z31{}, z32{}, z33{};
+    double sz1{}, sz2{}, sz3{}, sz11{}, sz12{}, sz13{}, sz21{}, sz22{}, sz23{}, sz31{}, sz32{}, sz33{};
+    for (int lsflg = 1; lsflg <= 2; ++lsflg)
+    {
+        const double a1 = zcosg * zcosh + zsing * zcosi * zsinh;
+        const double a3 = -zsing * zcosh + zcosg * zcosi * zsinh;
+        const double a7 = -zcosg * zsinh + zsing * zcosi * zcosh;
+        const double a8 = zsing * zsini;
+        const double a9 = zsing * zsinh + zcosg * zcosi * zcosh;
+        const double a10 = zcosg * zsini;
+        const double a2 = cosim * a7 + sinim * a8;
+        const double a4 = cosim * a9 + sinim * a10;
+        const double a5 = -sinim * a7 + cosim * a8;
+        const double a6 = -sinim * a9 + cosim * a10;
+
+        const double x1 = a1 * cosomm + a2 * sinomm;
+        const double x2 = a3 * cosomm + a4 * sinomm;
+        const double x3 = -a1 * sinomm + a2 * cosomm;
+        const double x4 = -a3 * sinomm + a4 * cosomm;
+        const double x5 = a5 * sinomm;
+        const double x6 = a6 * sinomm;
+        const double x7 = a5 * cosomm;
+        const double x8 = a6 * cosomm;
+
+        z31 = 12.0 * x1 * x1 - 3.0 * x3 * x3;
+        z32 = 24.0 * x1 * x2 - 6.0 * x3 * x4;
+        z33 = 12.0 * x2 * x2 - 3.0 * x4 * x4;
+        z1 = 3.0 * (a1 * a1 + a2 * a2) + z31 * emsq;
+        z2 = 6.0 * (a1 * a3 + a2 * a4) + z32 * emsq;
+        z3 = 3.0 * (a3 * a3 + a4 * a4) + z33 * emsq;
+        z11 = -6.0 * a1 * a5 + emsq * (-24.0 * x1 * x7 - 6.0 * x3 * x5);
+        z12 = -6.0 * (a1 * a6 + a3 * a5) + emsq * (-24.0 * (x2 * x7 + x1 * x8) - 6.0 * (x3 * x6 + x4 * x5));
+        z13 = -6.0 * a3 * a6 + emsq * (-24.0 * x2 * x8 - 6.0 * x4 * x6);
+        z21 = 6.0 * a2 * a5 + emsq * (24.0 * x1 * x5 - 6.0 * x3 * x7);
+        z22 = 6.0 * (a4 * a5 + a2 * a6) + emsq * (24.0 * (x2 * x5 + x1 * x6) - 6.0 * (x4 * x7 + x3 * x8));
+        z23 = 6.0 * a4 * a6 + emsq * (24.0 * x2 * x6 - 6.0 * x4 * x8);
+        z1 = z1 + z1 + betasq * z31;
+        z2 = z2 + z2 + betasq * z32;
+        z3 = z3 + z3 + betasq * z33;
+        s3 = cc * xnoi;
+        s2 = -0.5 * s3 / rtemsq;
+        s4 = s3 * rtemsq;
+        s1 = -15.0 * em * s4;
+        s5 = x1 * x3 + x2 * x4;
+        s6 = x2 * x3 + x1 * x4;
+        s7 = x2 * x4 - x1 * x3;
+
+        if (lsflg == 1)
+        {
+            ss1 = s1;
+            ss2 = s2;
+            ss3 = s3;
+            ss4 = s4;
+            ss5 = s5;
+            ss6 = s6;
+            ss7 = s7;
+            sz1 = z1;
+            sz2 = z2;
+            sz3 = z3;
+            sz11 = z11;
+            sz12 = z12;
+            sz13 = z13;
+            sz21 = z21;
+            sz22 = z22;
+            sz23 = z23;
+            sz31 = z31;
+            sz32 = z32;
+            sz33 = z33;
+            zcosg = zcosgl;
+            zsing = zsingl;
+            zcosi = zcosil;
+            zsini = zsinil;
+            zcosh = zcoshl * cnodm + zsinhl * snodm;
+            zsinh = snodm * zcoshl - cnodm * zsinhl;
+            cc = c1l;
+        }
+    }
+
+    m_zmol = std::fmod(4.7199672 + 0.22997150 * day - gam, Constants::_2PI);
+    m_zmos = std::fmod(6.2565837 + 0.017201977 * day, Constants::_2PI);
+
+    m_se2 = 2.0 * ss1 * ss6;
+    m_se3 = 2.0 * ss1 * ss7;
+    m_si2 = 2.0 * ss2 * sz12;
+    m_si3 = 2.0 * ss2 * (sz13 - sz11);
+    m_sl2 = -2.0 * ss3 * sz2;
+    m_sl3 = -2.0 * ss3 * (sz3 - sz1);
+    m_sl4 = -2.0 * ss3 * (-21.0 - 9.0 * emsq) * zes;
+    m_sgh2 = 2.0 * ss4 * sz32;
+    m_sgh3 = 2.0 * ss4 * (sz33 - sz31);
+    m_sgh4 = -18.0 * ss4 * zes;
+    m_sh2 = -2.0 * ss2 * sz22;
+    m_sh3 = -2.0 * ss2 * (sz23 - sz21);
+
+    m_ee2 = 2.0 * s1 * s6;
+    m_e3 = 2.0 * s1 * s7;
+    m_xi2 = 2.0 * s2 * z12;
+    m_xi3 = 2.0 * s2 * (z13 - z11);
+    m_xl2 = -2.0 * s3 * z2;
+    m_xl3 = -2.0 * s3 * (z3 - z1);
+    m_xl4 = -2.0 * s3 * (-21.0 - 9.0 * emsq) * zel;
+    m_xgh2 = 2.0 * s4 * z32;
+    m_xgh3 = 2.0 * s4 * (z33 - z31);
+    m_xgh4 = -18.0 * s4 * zel;
+    m_xh2 = -2.0 * s2 * z22;
+    m_xh3 = -2.0 * s2 * (z23 - z21);
+
+    //Secular rates and resonance terms (dsinit)
+    constexpr double q22 = 1.7891679e-6;
+    constexpr double q31 = 2.1460748e-6;
+    constexpr double q33 = 2.2123015e-7;
+    constexpr double root22 = 1.7891679e-6;
+    constexpr double root44 = 7.3636953e-9;
+    constexpr double root54 = 2.1765803e-9;
+    constexpr double root32 = 3.7393792e-7;
+    constexpr double root52 = 1.1428639e-7;
+
+    m_irez = 0;
+    if (nm < 0.0052359877 && nm > 0.0034906585)
+    {
+        m_irez = 1;
+    }
+    if (nm >= 8.26e-3 && nm <= 9.24e-3 && em >= 0.5)
+    {
+        m_irez = 2;
+    }
+
+    const double ses = ss1 * zns * ss5;
+    const double sis = ss2 * zns * (sz11 + sz13);
+    const double sls = -zns * ss3 * (sz1 + sz3 - 14.0 - 6.0 * emsq);
+    const double sghs = ss4 * zns * (sz31 + sz33 - 6.0);
+    double shs = -zns * ss2 * (sz21 + sz23);
+    if (m_inclo < 5.2359877e-2 || m_inclo > Constants::PI - 5.2359877e-2)
+    {
+        shs = 0.0;
+    }
+    if (sinim != 0.0)
+    {
+        shs = shs / sinim;
+    }
+    const double sgs = sghs - cosim * shs;
+
+    m_dedt = ses + s1 * znl * s5;
+    m_didt = sis + s2 * znl * (z11 + z13);
+    m_dmdt = sls - znl * s3 * (z1 + z3 - 14.0 - 6.0 * emsq);
+    const double sghl = s4 * znl * (z31 + z33 - 6.0);
+    double shll = -znl * s2 * (z21 + z23);
+    if (m_inclo < 5.2359877e-2 || m_inclo > Constants::PI - 5.2359877e-2)
+    {
+        shll = 0.0;
+    }
+    m_domdt = sgs + sghl;
+    m_dnodt = shs;
+    if (sinim != 0.0)
+    {
+        m_domdt = m_domdt - cosim / sinim * shll;
+        m_dnodt = m_dnodt + shll / sinim;
+    }
+
+    const double theta = std::fmod(m_gsto, Constants::_2PI);
+    if (m_irez == 0)
+    {
+        return;
+    }
+
+    const double aonv = std::pow(nm / KE, X2O3);
+    if (m_irez == 2)
+    {
+        //Geopotential resonance for 12 hour orbits
+        const double cosisq = cosim * cosim;
+        em = m_ecco;
+        emsq = eccsq;
+        const double eoc = em * emsq;
+        const double g201 = -0.306 - (em - 0.64) * 0.440;
+        double g211, g310, g322, g410, g422, g520, g521, g532, g533;
+        if (em <= 0.65)
+        {
+            g211 = 3.616 - 13.2470 * em + 16.2900 * emsq;
+            g310 = -19.302 + 117.3900 * em - 228.4190 * emsq + 156.5910 * eoc;
+            g322 = -18.9068 + 109.7927 * em - 214.6334 * emsq + 146.5816 * eoc;
+            g410 = -41.122 + 242.6940 * em - 471.0940 * emsq + 313.9530 * eoc;
+            g422 = -146.407 + 841.8800 * em - 1629.014 * emsq + 1083.4350 * eoc;
+            g520 = -532.114 + 3017.977 * em - 5740.032 * emsq + 3708.2760 * eoc;
+        } else
+        {
+            g211 = -72.099 + 331.819 * em - 508.738 * emsq + 266.724 * eoc;
+            g310 = -346.844 + 1582.851 * em - 2415.925 * emsq + 1246.113 * eoc;
+            g322 = -342.585 + 1554.908 * em - 2366.899 * emsq + 1215.972 * eoc;
+            g410 = -1052.797 + 4758.686 * em - 7193.992 * emsq + 3651.957 * eoc;
+            g422 = -3581.690 + 16178.110 * em - 24462.770 * emsq + 12422.520 * eoc;
+            if (em > 0.715)
+            {
+                g520 = -5149.66 + 29936.92 * em - 54087.36 * emsq + 31324.56 * eoc;
+            } else
+            {
+                g520 = 1464.74 - 4664.75 * em + 3763.64 * emsq;
+            }
+        }
+        if (em < 0.7)
+        {
+            g533 = -919.22770 + 4988.6100 * em - 9064.7700 * emsq + 5542.21 * eoc;
+            g521 = -822.71072 + 4568.6173 * em - 8491.4146 * emsq + 5337.524 * eoc;
+            g532 = -853.66600 + 4690.2500 * em - 8624.7700 * emsq + 5341.4 * eoc;
+        } else
+        {
+            g533 = -37995.780 + 161616.52 * em - 229838.20 * emsq + 109377.94 * eoc;
+            g521 = -51752.104 + 218913.95 * em - 309468.16 * emsq + 146349.42 * eoc;
+            g532 = -40023.880 + 170470.89 * em - 242699.48 * emsq + 115605.82 * eoc;
+        }
+
+        const double sini2 = sinim * sinim;
+        const double f220 = 0.75 * (1.0 + 2.0 * cosim + cosisq);
+        const double f221 = 1.5 * sini2;
+        const double f321 = 1.875 * sinim * (1.0 - 2.0 * cosim - 3.0 * cosisq);
+        const double f322 = -1.875 * sinim * (1.0 + 2.0 * cosim - 3.0 * cosisq);
+        const double f441 = 35.0 * sini2 * f220;
+        const double f442 = 39.3750 * sini2 * sini2;
+        const double f522 = 9.84375 * sinim * (sini2 * (1.0 - 2.0 * cosim - 5.0 * cosisq) + 0.33333333 * (-2.0 + 4.0 * cosim + 6.0 * cosisq));
+        const double f523 = sinim * (4.92187512 * sini2 * (-2.0 - 4.0 * cosim + 10.0 * cosisq) + 6.56250012 * (1.0 + 2.0 * cosim - 3.0 * cosisq));
+        const double f542 = 29.53125 * sinim * (2.0 - 8.0 * cosim + cosisq * (-12.0 + 8.0 * cosim + 10.0 * cosisq));
+        const double f543 = 29.53125 * sinim * (-2.0 - 8.0 * cosim + cosisq * (12.0 + 8.0 * cosim - 10.0 * cosisq));
+        const double xno2 = nm * nm;
+        const double ainv2 = aonv * aonv;
+        double temp1 = 3.0 * xno2 * ainv2;
+        double temp = temp1 * root22;
+        m_d2201 = temp * f220 * g201;
+        m_d2211 = temp * f221 * g211;
+        temp1 = temp1 * aonv;
+        temp = temp1 * root32;
+        m_d3210 = temp * f321 * g310;
+        m_d3222 = temp * f322 * g322;
+        temp1 = temp1 * aonv;
+        temp = 2.0 * temp1 * root44;
+        m_d4410 = temp * f441 * g410;
+        m_d4422 = temp * f442 * g422;
+        temp1 = temp1 * aonv;
+        temp = temp1 * root52;
+        m_d5220 = temp * f522 * g520;
+        m_d5232 = temp * f523 * g532;
+        temp = 2.0 * temp1 * root54;
+        m_d5421 = temp * f542 * g521;
+        m_d5433 = temp * f543 * g533;
+        m_xlamo = std::fmod(m_mo + m_nodeo + m_nodeo - theta - theta, Constants::_2PI);
+        m_xfact = m_mdot + m_dmdt + 2.0 * (m_nodedot + m_dnodt - RPTIM) - m_no;
+    } else
+    {
+        //Synchronous resonance for 24 hour orbits
+        const double g200 = 1.0 + emsq * (-2.5 + 0.8125 * emsq);
+        const double g310 = 1.0 + 2.0 * emsq;
+        const double g300 = 1.0 + emsq * (-6.0 + 6.60937 * emsq);
+        const double f220 = 0.75 * (1.0 + cosim) * (1.0 + cosim);
+        const double f311 = 0.9375 * sinim * sinim * (1.0 + 3.0 * cosim) - 0.75 * (1.0 + cosim);
+        double f330 = 1.0 + cosim;
+        f330 = 1.875 * f330 * f330 * f330;
+        m_del1 = 3.0 * nm * nm * aonv * aonv;
+        m_del2 = 2.0 * m_del1 * f220 * g200 * q22;
+        m_del3 = 3.0 * m_del1 * f330 * g300 * q33 * aonv;
+        m_del1 = m_del1 * f311 * g310 * q31 * aonv;
+        m_xlamo = std::fmod(m_mo + m_nodeo + m_argpo - theta, Constants::_2PI);
+        m_xfact = m_mdot + xpidot - RPTIM + m_dmdt + m_domdt + m_dnodt - m_no;
+    }
+}
+
+void IO::Astrodynamics::Propagators::SGP4::ApplyLunisolarPeriodics(double t, double &ep, double &inclp, double &nodep, double &argpp, double &mp) const
+{
+    constexpr double zns = 1.19459e-5;
+    constexpr double zes = 0.01675;
+    constexpr double znl = 1.5835218e-4;
+    constexpr double zel = 0.05490;
+
+    //Solar terms
+    double zm = m_zmos + zns * t;
+    double zf = zm + 2.0 * zes * std::sin(zm);
+    double sinzf = std::sin(zf);
+    double f2 = 0.5 * sinzf * sinzf - 0.25;
+    double f3 = -0.5 * sinzf * std::cos(zf);
+    const double ses = m_se2 * f2 + m_se3 * f3;
+    const double sis = m_si2 * f2 + m_si3 * f3;
+    const double sls = m_sl2 * f2 + m_sl3 * f3 + m_sl4 * sinzf;
+    const double sghs = m_sgh2 * f2 + m_sgh3 * f3 + m_sgh4 * sinzf;
+    const double shs = m_sh2 * f2 + m_sh3 * f3;
+
+    //Lunar terms
+    zm = m_zmol + znl * t;
+    zf = zm + 2.0 * zel * std::sin(zm);
+    sinzf = std::sin(zf);
+    f2 = 0.5 * sinzf * sinzf - 0.25;
+    f3 = -0.5 * sinzf * std::cos(zf);
+    const double sel = m_ee2 * f2 + m_e3 * f3;
+    const double sil = m_xi2 * f2 + m_xi3 * f3;
+    const double sll = m_xl2 * f2 + m_xl3 * f3 + m_xl4 * sinzf;
+    const double sghl = m_xgh2 * f2 + m_xgh3 * f3 + m_xgh4 * sinzf;
+    const double shll = m_xh2 * f2 + m_xh3 * f3;
+
+    const double pe = ses + sel - m_peo;
+    const double pinc = sis + sil - m_pinco;
+    const double pl = sls + sll - m_plo;
+    double pgh = sghs + sghl - m_pgho;
+    double ph = shs + shll - m_pho;
+
+    inclp = inclp + pinc;
+    ep = ep + pe;
+    const double sinip = std::sin(inclp);
+    const double cosip = std::cos(inclp);
+
+    if (inclp >= 0.2)
+    {
+        ph = ph / sinip;
+        pgh = pgh - cosip * ph;
+        argpp = argpp + pgh;
+        nodep = nodep + ph;
+        mp = mp + pl;
+    } else
+    {
+        //Lyddane modification for low inclinations
+        const double sinop = std::sin(nodep);
+        const double cosop = std::cos(nodep);
+        double alfdp = sinip * sinop;
+        double betdp = sinip * cosop;
+        const double dalf = ph * cosop + pinc * cosip * sinop;
+        const double dbet = -ph * sinop + pinc * cosip * cosop;
+        alfdp = alfdp + dalf;
+        betdp = betdp + dbet;
+        nodep = std::fmod(nodep, Constants::_2PI);
+        if (nodep < 0.0)
+        {
+            nodep = nodep + Constants::_2PI;
+        }
+        double xls = mp + argpp + cosip * nodep;
+        const double dls = pl + pgh - pinc * nodep * sinip;
+        xls = xls + dls;
+        const double xnoh = nodep;
+        nodep = std::atan2(alfdp, betdp);
+        if (nodep < 0.0)
+        {
+            nodep = nodep + Constants::_2PI;
+        }
+        if (std::abs(xnoh - nodep) > Constants::PI)
+        {
+            nodep = nodep < xnoh ? nodep + Constants::_2PI : nodep - Constants::_2PI;
+        }
+        mp = mp + pl;
+        argpp = xls - mp - cosip * nodep;
+    }
+}
+
+void IO::Astrodynamics::Propagators::SGP4::ApplyResonance(double t, double &em, double &argpm, double &inclm, double &mm, double &nodem, double &nm) const
+{
+    constexpr double fasx2 = 0.13130908;
+    constexpr double fasx4 = 2.8843198;
+    constexpr double fasx6 = 0.37448087;
+    constexpr double g22 = 5.7686396;
+    constexpr double g32 = 0.95240898;
+    constexpr double g44 = 1.8014998;
+    constexpr double g52 = 1.0508330;
+    constexpr double g54 = 4.4108898;
+    constexpr double stepp = 720.0;
+    constexpr double stepn = -720.0;
+    constexpr double step2 = 259200.0;
+
+    const double theta = std::fmod(m_gsto + t * RPTIM, Constants::_2PI);
+    em = em + m_dedt * t;
+    inclm = inclm + m_didt * t;
+    argpm = argpm + m_domdt * t;
+    nodem = nodem + m_dnodt * t;
+    mm = mm + m_dmdt * t;
+
+    if (m_irez == 0)
+    {
+        return;
+    }
+
+    //Numerical integration of resonance effects always restarts from epoch to keep the instance immutable
+    double atime = 0.0;
+    double xni = m_no;
+    double xli = m_xlamo;
+    const double delt = t > 0.0 ? stepp : stepn;
+    double ft = 0.0;
+    double xndt{}, xldot{}, xnddt{};
+    while (true)
+    {
+        if (m_irez != 2)
+        {
+            xndt = m_del1 * std::sin(xli - fasx2) + m_del2 * std::sin(2.0 * (xli - fasx4)) + m_del3 * std::sin(3.0 * (xli - fasx6));
+            xldot = xni + m_xfact;
+            xnddt = m_del1 * std::cos(xli - fasx2) + 2.0 * m_del2 * std::cos(2.0 * (xli - fasx4)) + 3.0 * m_del3 * std::cos(3.0 * (xli - fasx6));
+            xnddt = xnddt * xldot;
+        } else
+        {
+            const double xomi = m_argpo + m_argpdot * atime;
+            const double x2omi = xomi + xomi;
+            const double x2li = xli + xli;
+            xndt = m_d2201 * std::sin(x2omi + xli - g22) + m_d2211 * std::sin(xli - g22) + m_d3210 * std::sin(xomi + xli - g32) +
+                   m_d3222 * std::sin(-xomi + xli - g32) + m_d4410 * std::sin(x2omi + x2li - g44) + m_d4422 * std::sin(x2li - g44) +
+                   m_d5220 * std::sin(xomi + xli - g52) + m_d5232 * std::sin(-xomi + xli - g52) + m_d5421 * std::sin(xomi + x2li - g54) +
+                   m_d5433 * std::sin(-xomi + x2li - g54);
+            xldot = xni + m_xfact;
+            xnddt = m_d2201 * std::cos(x2omi + xli - g22) + m_d2211 * std::cos(xli - g22) + m_d3210 * std::cos(xomi + xli - g32) +
+                    m_d3222 * std::cos(-xomi + xli - g32) + m_d5220 * std::cos(xomi + xli - g52) + m_d5232 * std::cos(-xomi + xli - g52) +
+                    2.0 * (m_d4410 * std::cos(x2omi + x2li - g44) + m_d4422 * std::cos(x2li - g44) + m_d5421 * std::cos(xomi + x2li - g54) +
+                           m_d5433 * std::cos(-xomi + x2li - g54));
+            xnddt = xnddt * xldot;
+        }
+
+        if (std::abs(t - atime) < stepp)
+        {
+            ft = t - atime;
+            break;
+        }
+
+        xli = xli + xldot * delt + xndt * step2;
+        xni = xni + xndt * delt + xnddt * step2;
+        atime = atime + delt;
+    }
+
+    nm = xni + xndt * ft + xnddt * ft * ft * 0.5;
+    const double xl = xli + xldot * ft + xndt * ft * ft * 0.5;
+    if (m_irez != 1)
+    {
+        mm = xl - 2.0 * nodem + 2.0 * theta;
+    } else
+    {
+        mm = xl - nodem - argpm + theta;
+    }
+}
+
+IO::Astrodynamics::Propagators::SGP4::Status IO::Astrodynamics::Propagators::SGP4::Propagate(double minutes, double position[3], double velocity[3]) const
+{
+    const double t = minutes;
+    const double vkmpersec = ER * KE / 60.0;
+
+    //Secular gravity and atmospheric drag
+    const double xmdf = m_mo + m_mdot * t;
+    const double argpdf = m_argpo + m_argpdot * t;
+    const double nodedf = m_nodeo + m_nodedot * t;
+    double argpm = argpdf;
+    double mm = xmdf;
+    const double t2 = t * t;
+    double nodem = nodedf + m_nodecf * t2;
+    double tempa = 1.0 - m_cc1 * t;
+    double tempe = m_bstar * m_cc4 * t;
+    double templ = m_t2cof * t2;
+
+    if (!m_isSimplified)
+    {
+        const double delomg = m_omgcof * t;
+        const double delmtemp = 1.0 + m_eta * std::cos(xmdf);
+        const double delm = m_xmcof * (delmtemp * delmtemp * delmtemp - m_delmo);
+        const double temp = delomg + delm;
+        mm = xmdf + temp;
+        argpm = argpdf - temp;
+        const double t3 = t2 * t;
+        const double t4 = t3 * t;
+        tempa = tempa - m_d2 * t2 - m_d3 * t3 - m_d4 * t4;
+        tempe = tempe + m_bstar * m_cc5 * (std::sin(mm) - m_sinmao);
+        templ = templ + m_t3cof * t3 + t4 * (m_t4cof + t * m_t5cof);
+    }
+
+    double nm = m_no;
+    double em = m_ecco;
+    double inclm = m_inclo;
+    if (m_isDeepSpace)
+    {
+        ApplyResonance(t, em, argpm, inclm, mm, nodem, nm);
+    }
+
+    if (nm <= 0.0)
+    {
+        return Status::InvalidMeanMotion;
+    }
+
+    const double am = std::pow(KE / nm, X2O3) * tempa * tempa;
+    nm = KE / std::pow(am, 1.5);
+    em = em - tempe;
+
+    if (em >= 1.0 || em < -0.001)
+    {
+        return Status::InvalidEccentricity;
+    }
+    if (em < 1.0e-6)
+    {
+        em = 1.0e-6;
+    }
+    mm = mm + m_no * templ;
+    double xlm = mm + argpm + nodem;
+    nodem = std::fmod(nodem, Constants::_2PI);
+    argpm = std::fmod(argpm, Constants::_2PI);
+    xlm = std::fmod(xlm, Constants::_2PI);
+    mm = std::fmod(xlm - argpm - nodem, Constants::_2PI);
+
+    //Lunar and solar periodics
+    double ep = em;
+    double xincp = inclm;
+    double argpp = argpm;
+    double nodep = nodem;
+    double mp = mm;
+    double sinip = std::sin(inclm);
+    double cosip = std::cos(inclm);
+    double aycof = m_aycof;
+    double xlcof = m_xlcof;
+    double con41 = m_con41;
+    double x1mth2 = m_x1mth2;
+    double x7thm1 = m_x7thm1;
+    if (m_isDeepSpace)
+    {
+        ApplyLunisolarPeriodics(t, ep, xincp, nodep, argpp, mp);
+        if (xincp < 0.0)
+        {
+            xincp = -xincp;
+            nodep = nodep + Constants::PI;
+            argpp = argpp - Constants::PI;
+        }
+        if (ep < 0.0 || ep > 1.0)
+        {
+            return Status::InvalidPerturbedEccentricity;
+        }
+
+        sinip = std::sin(xincp);
+        cosip = std::cos(xincp);
+        aycof = -0.5 * J3OJ2 * sinip;
+        xlcof = -0.25 * J3OJ2 * sinip * (3.0 + 5.0 * cosip) / (std::abs(cosip + 1.0) > 1.5e-12 ? 1.0 + cosip : TEMP4);
+        const double cosisq = cosip * cosip;
+        con41 = 3.0 * cosisq - 1.0;
+        x1mth2 = 1.0 - cosisq;
+        x7thm1 = 7.0 * cosisq - 1.0;
+    }
+
+    //Long period periodics
+    const double axnl = ep * std::cos(argpp);
+    double temp = 1.0 / (am * (1.0 - ep * ep));
+    const double aynl = ep * std::sin(argpp) + temp * aycof;
+    const double xl = mp + argpp + nodep + temp * xlcof * axnl;
+
+    //Kepler equation
+    const double u = std::fmod(xl - nodep, Constants::_2PI);
+    double eo1 = u;
+    double tem5 = 9999.9;
+    double sineo1{}, coseo1{};
+    for (int ktr = 1; std::abs(tem5) >= 1.0e-12 && ktr <= 10; ++ktr)
+    {
+        sineo1 = std::sin(eo1);
+        coseo1 = std::cos(eo1);
+        tem5 = 1.0 - coseo1 * axnl - sineo1 * aynl;
+        tem5 = (u - aynl * coseo1 + axnl * sineo1 - eo1) / tem5;
+        if (std::abs(tem5) >= 0.95)
+        {
+            tem5 = tem5 > 0.0 ? 0.95 : -0.95;
+        }
+        eo1 = eo1 + tem5;
+    }
+
+    //Short period preliminary quantities
+    const double ecose = axnl * coseo1 + aynl * sineo1;
+    const double esine = axnl * sineo1 - aynl * coseo1;
+    const double el2 = axnl * axnl + aynl * aynl;
+    const double pl = am * (1.0 - el2);
+    if (pl < 0.0)
+    {
+        return Status::InvalidSemiLatusRectum;
+    }
+
+    const double rl = am * (1.0 - ecose);
+    const double rdotl = std::sqrt(am) * esine / rl;
+    const double rvdotl = std::sqrt(pl) / rl;
+    const double betal = std::sqrt(1.0 - el2);
+    temp = esine / (1.0 + betal);
+    const double sinu = am / rl * (sineo1 - aynl - axnl * temp);
+    const double cosu = am / rl * (coseo1 - axnl + aynl * temp);
+    double su = std::atan2(sinu, cosu);
+    const double sin2u = (cosu + cosu) * sinu;
+    const double cos2u = 1.0 - 2.0 * sinu * sinu;
+    temp = 1.0 / pl;
+    const double temp1 = 0.5 * J2 * temp;
+    const double temp2 = temp1 * temp;
+
+    //Short period periodics
+    const double mrt = rl * (1.0 - 1.5 * temp2 * betal * con41) + 0.5 * temp1 * x1mth2 * cos2u;
+    su = su - 0.25 * temp2 * x7thm1 * sin2u;
+    const double xnode = nodep + 1.5 * temp2 * cosip * sin2u;
+    const double xinc = xincp + 1.5 * temp2 * cosip * sinip * cos2u;
+    const double mvt = rdotl - nm * temp1 * x1mth2 * sin2u / KE;
+    const double rvdot = rvdotl + nm * temp1 * (x1mth2 * cos2u + 1.5 * con41) / KE;
+
+    //Orientation vectors
+    const double sinsu = std::sin(su);
+    const double cossu = std::cos(su);
+    const double snod = std::sin(xnode);
+    const double cnod = std::cos(xnode);
+    const double sini = std::sin(xinc);
+    const double cosi = std::cos(xinc);
+    const double xmx = -snod * cosi;
+    const double xmy = cnod * cosi;
+    const double ux = xmx * sinsu + cnod * cossu;
+    const double uy = xmy * sinsu + snod * cossu;
+    const double uz = sini * sinsu;
+    const double vx = xmx * cossu - cnod * sinsu;
+    const double vy = xmy * cossu - snod * sinsu;
+    const double vz = sini * cossu;
+
+    position[0] = mrt * ux * ER;
+    position[1] = mrt * uy * ER;
+    position[2] = mrt * uz * ER;
+    velocity[0] = (mvt * ux + rvdot * vx) * vkmpersec;
+    velocity[1] = (mvt * uy + rvdot * vy) * vkmpersec;
+    velocity[2] = (mvt * uz + rvdot * vz) * vkmpersec;
+
+    return mrt < 1.0 ? Status::Decayed : Status::Success;
+}
+
+IO::Astrodynamics::Propagators::SGP4::Status
+IO::Astrodynamics::Propagators::SGP4::Propagate(const IO::Astrodynamics::Time::TDB &epoch, double position[3], double velocity[3]) const
+{
+    auto status = Propagate((epoch - m_epoch).GetSeconds().count() / 60.0, position, velocity);
+    for (int i = 0; i < 3; ++i)
+    {
+        position[i] *= 1E+03;
+        velocity[i] *= 1E+03;
+    }
+    return status;
+}
+
+double IO::Astrodynamics::Propagators::SGP4::GetSemiMajorAxis() const
+{
+    return std::pow(KE / m_no, X2O3) * ER * 1000.0;
+}
+
+double IO::Astrodynamics::Propagators::SGP4::GetDragRadiusChange(double minutes) const
+{
+    //Same secular drag terms as propagation, periodic part of the eccentricity term is bounded by its amplitude
+    const double t = minutes;
+    const double t2 = t * t;
+    double tempa = 1.0 - m_cc1 * t;
+    double tempe = std::abs(m_bstar * m_cc4 * t);
+    if (!m_isSimplified)
+    {
+        tempa = tempa - m_d2 * t2 - m_d3 * t2 * t - m_d4 * t2 * t2;
+        tempe += 2.0 * std::abs(m_bstar * m_cc5);
+    }
+
+    const double a = std::pow(KE / m_no, X2O3);
+    return (a * std::abs(1.0 - tempa * tempa) * (1.0 + m_ecco) + a * tempe) * ER * 1000.0;
+}
@@ -0,0 +1,244 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_SGP4_H
+#define IO_SGP4_H
+
+#include <string>
+
+#include <TDB.h>
+#include <UTC.h>
+
+namespace IO::Astrodynamics::OrbitalParameters
+{
+    struct TLERecord;
+}
+
+namespace IO::Astrodynamics::Propagators
+{
+    class SGP4CatalogPropagator;
+
+    /**
+     * @brief SGP4 mean elements as published in two lines elements
+     */
+    struct SGP4Elements
+    {
+        int SatelliteNumber{};
+        IO::Astrodynamics::Time::UTC Epoch{std::chrono::duration<double>(0.0)};
+
+        //Drag term (1/earth radii)
+        double BStar{};
+        double Inclination{};
+        double RightAscendingNode{};
+        double Eccentricity{};
+        double PeriapsisArgument{};
+        double MeanAnomaly{};
+
+        //Kozai mean motion (rad/min)
+        double MeanMotion{};
+
+        /**
+         * @brief Read elements from two lines elements without any SPICE call, checksums are verified and alpha 5 satellite numbers are supported
+         *
+         * @param line1
+         * @param line2
+         * @return SGP4Elements
+         */
+        static SGP4Elements Parse(const std::string &line1, const std::string &line2);
+
+        /**
+         * @brief Get elements from two lines elements fields read by a catalog
+         *
+         * @param record
+         * @return SGP4Elements
+         */
+        static SGP4Elements FromRecord(const IO::Astrodynamics::OrbitalParameters::TLERecord &record);
+    };
+
+    /**
+     * @brief Reentrant SGP4/SDP4 propagator.
+     * This is a port of Vallado's revised SGP4 (AIAA 2006-6753) in AFSPC operation mode with the WGS72 constants used by evsgp4_c.
+     * All constants are computed once at construction, propagation doesn't modify the instance and doesn't use any CSPICE global state,
+     * so one instance can be shared by many threads. Member names follow the reference implementation.
+     */
+    class SGP4 final
+    {
+        friend class SGP4CatalogPropagator;
+
+    public:
+        //J2 J3 J4 KE QO SO ER AE
+        inline constexpr static double J2{1.082616e-3};
+        inline constexpr static double J3{-2.53881e-6};
+        inline constexpr static double J4{-1.65597e-6};
+        inline constexpr static double KE{7.43669161e-2};
+        inline constexpr static double QO{120.0};
+        inline constexpr static double SO{78.0};
+        inline constexpr static double ER{6378.135};
+
+        /**
+         * @brief Propagation status, same codes as the reference implementation
+         */
+        enum class Status
+        {
+            Success = 0,
+            InvalidEccentricity = 1,
+            InvalidMeanMotion = 2,
+            InvalidPerturbedEccentricity = 3,
+            InvalidSemiLatusRectum = 4,
+            Decayed = 6
+        };
+
+    private:
+        int m_satelliteNumber{};
+        IO::Astrodynamics::Time::TDB m_epoch{std::chrono::duration<double>(0.0)};
+        bool m_isDeepSpace{false};
+        bool m_isSimplified{false};
+        int m_irez{};
+
+        double m_bstar{}, m_ecco{}, m_argpo{}, m_inclo{}, m_mo{}, m_no{}, m_nodeo{};
+        double m_aycof{}, m_con41{}, m_cc1{}, m_cc4{}, m_cc5{}, m_d2{}, m_d3{}, m_d4{}, m_delmo{}, m_eta{}, m_argpdot{}, m_omgcof{}, m_sinmao{};
+        double m_t2cof{}, m_t3cof{}, m_t4cof{}, m_t5cof{}, m_x1mth2{}, m_x7thm1{}, m_mdot{}, m_nodedot{}, m_xlcof{}, m_xmcof{}, m_nodecf{};
+
+        //Deep space
+        double m_d2201{}, m_d2211{}, m_d3210{}, m_d3222{}, m_d4410{}, m_d4422{}, m_d5220{}, m_d5232{}, m_d5421{}, m_d5433{};
+        double m_dedt{}, m_del1{}, m_del2{}, m_del3{}, m_didt{}, m_dmdt{}, m_dnodt{}, m_domdt{};
+        double m_e3{}, m_ee2{}, m_peo{}, m_pgho{}, m_pho{}, m_pinco{}, m_plo{}, m_se2{}, m_se3{}, m_sgh2{}, m_sgh3{}, m_sgh4{}, m_sh2{}, m_sh3{};
+        double m_si2{}, m_si3{}, m_sl2{}, m_sl3{}, m_sl4{}, m_gsto{}, m_xfact{}, m_xgh2{}, m_xgh3{}, m_xgh4{}, m_xh2{}, m_xh3{}, m_xi2{}, m_xi3{};
+        double m_xl2{}, m_xl3{}, m_xl4{}, m_xlamo{}, m_zmol{}, m_zmos{};
+
+        Status m_status{Status::Success};
+
+        void InitializeDeepSpace(double epoch, double xpidot, double eccsq);
+
+        void ApplyLunisolarPeriodics(double t, double &ep, double &inclp, double &nodep, double &argpp, double &mp) const;
+
+        void ApplyResonance(double t, double &em, double &argpm, double &inclm, double &mm, double &nodem, double &nm) const;
+
+    public:
+        /**
+         * @brief Construct a new SGP4 propagator
+         *
+         * @param elements
+         */
+        explicit SGP4(const SGP4Elements &elements);
+
+        /**
+         * @brief Propagate in TEME frame
+         *
+         * @param minutes Minutes since elements epoch
+         * @param position Position (km)
+         * @param velocity Velocity (km/s)
+         * @return Status
+         */
+        Status Propagate(double minutes, double position[3], double velocity[3]) const;
+
+        /**
+         * @brief Propagate in TEME frame
+         *
+         * @param epoch
+         * @param position Position (m)
+         * @param velocity Velocity (m/s)
+         * @return Status
+         */
+        Status Propagate(const IO::Astrodynamics::Time::TDB &epoch, double position[3], double velocity[3]) const;
+
+        /**
+         * @brief Get the elements epoch
+         *
+         * @return const IO::Astrodynamics::Time::TDB&
+         */
+        [[nodiscard]] inline const IO::Astrodynamics::Time::TDB &GetEpoch() const
+        { return m_epoch; }
+
+        /**
+         * @brief Get the satellite number
+         *
+         * @return int
+         */
+        [[nodiscard]] inline int GetSatelliteNumber() const
+        { return m_satelliteNumber; }
+
+        /**
+         * @brief Deep space (SDP4) propagator is used when orbital period is greater than 225 minutes
+         *
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] inline bool IsDeepSpace() const
+        { return m_isDeepSpace; }
+
+        /**
+         * @brief Get the mean semi major axis recovered from Kozai mean motion
+         *
+         * @return double (m)
+         */
+        [[nodiscard]] double GetSemiMajorAxis() const;
+
+        /**
+         * @brief Get a bound of the mean periapsis and apoapsis radii change due to atmospheric drag secular terms
+         *
+         * @param minutes Minutes since elements epoch
+         * @return double (m)
+         */
+        [[nodiscard]] double GetDragRadiusChange(double minutes) const;
+
+        /**
+         * @brief Get the mean eccentricity
+         *
+         * @return double
+         */
+        [[nodiscard]] inline double GetEccentricity() const
+        { return m_ecco; }
+
+        /**
+         * @brief Get the mean inclination
+         *
+         * @return double (rad)
+         */
+        [[nodiscard]] inline double GetInclination() const
+        { return m_inclo; }
+
+        /**
+         * @brief Get the mean right ascending node at epoch
+         *
+         * @return double (rad)
+         */
+        [[nodiscard]] inline double GetRightAscendingNode() const
+        { return m_nodeo; }
+
+        /**
+         * @brief Get the mean periapsis argument at epoch
+         *
+         * @return double (rad)
+         */
+        [[nodiscard]] inline double GetPeriapsisArgument() const
+        { return m_argpo; }
+
+        /**
+         * @brief Get the secular rate of the right ascending node, lunisolar terms included
+         *
+         * @return double (rad/s)
+         */
+        [[nodiscard]] inline double GetRightAscendingNodeRate() const
+        { return (m_nodedot + m_dnodt) / 60.0; }
+
+        /**
+         * @brief Get the secular rate of the periapsis argument, lunisolar terms included
+         *
+         * @return double (rad/s)
+         */
+        [[nodiscard]] inline double GetPeriapsisArgumentRate() const
+        { return (m_argpdot + m_domdt) / 60.0; }
+
+        /**
+         * @brief Get the initialization status
+         *
+         * @return Status
+         */
+        [[nodiscard]] inline Status GetStatus() const
+        { return m_status; }
+    };
+}
+
+#endif //IO_SGP4_H
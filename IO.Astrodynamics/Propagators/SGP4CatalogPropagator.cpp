@@ -0,0 +1,349 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <SGP4CatalogPropagator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Constants.h>
+#include <Parallel.h>
+#include <StringHelpers.h>
+
+namespace
+{
+    constexpr std::size_t LANES = 8;
+    constexpr std::size_t MIN_OBJECTS_PER_THREAD = 256;
+
+    std::vector<IO::Astrodynamics::Propagators::SGP4Elements> ReadElements(const IO::Astrodynamics::OrbitalParameters::TLECatalog &catalog)
+    {
+        std::vector<IO::Astrodynamics::Propagators::SGP4Elements> elements;
+        elements.reserve(catalog.GetSize());
+        for (std::size_t i = 0; i < catalog.GetSize(); ++i)
+        {
+            elements.push_back(IO::Astrodynamics::Propagators::SGP4Elements::FromRecord(catalog.GetRecord(i)));
+        }
+        return elements;
+    }
+}
+
+void IO::Astrodynamics::Propagators::SGP4CatalogPropagator::NearEarthElements::Add(std::size_t index, const SGP4 &propagator)
+{
+    //Simplified drag terms are zeroed so every lane runs the same instructions
+    const double full = propagator.m_isSimplified ? 0.0 : 1.0;
+    Indexes.push_back(index);
+    Epoch.push_back(propagator.m_epoch.GetSecondsFromJ2000().count());
+    Mo.push_back(propagator.m_mo);
+    Mdot.push_back(propagator.m_mdot);
+    Argpo.push_back(propagator.m_argpo);
+    Argpdot.push_back(propagator.m_argpdot);
+    Nodeo.push_back(propagator.m_nodeo);
+    Nodedot.push_back(propagator.m_nodedot);
+    Nodecf.push_back(propagator.m_nodecf);
+    Cc1.push_back(propagator.m_cc1);
+    Cc4.push_back(propagator.m_cc4);
+    Cc5.push_back(full * propagator.m_cc5);
+    Bstar.push_back(propagator.m_bstar);
+    T2cof.push_back(propagator.m_t2cof);
+    T3cof.push_back(full * propagator.m_t3cof);
+    T4cof.push_back(full * propagator.m_t4cof);
+    T5cof.push_back(full * propagator.m_t5cof);
+    Omgcof.push_back(full * propagator.m_omgcof);
+    Xmcof.push_back(full * propagator.m_xmcof);
+    Eta.push_back(propagator.m_eta);
+    Delmo.push_back(propagator.m_delmo);
+    Sinmao.push_back(propagator.m_sinmao);
+    D2.push_back(full * propagator.m_d2);
+    D3.push_back(full * propagator.m_d3);
+    D4.push_back(full * propagator.m_d4);
+    No.push_back(propagator.m_no);
+    Ecco.push_back(propagator.m_ecco);
+    Inclo.push_back(propagator.m_inclo);
+    Sinio.push_back(std::sin(propagator.m_inclo));
+    Cosio.push_back(std::cos(propagator.m_inclo));
+    Aycof.push_back(propagator.m_aycof);
+    Xlcof.push_back(propagator.m_xlcof);
+    Con41.push_back(propagator.m_con41);
+    X1mth2.push_back(propagator.m_x1mth2);
+    X7thm1.push_back(propagator.m_x7thm1);
+}
+
+IO::Astrodynamics::Propagators::SGP4CatalogPropagator::SGP4CatalogPropagator(const std::vector<SGP4Elements> &elements)
+{
+    m_propagators.reserve(elements.size());
+    for (const auto &element: elements)
+    {
+        m_propagators.emplace_back(element);
+    }
+
+    for (std::size_t i = 0; i < m_propagators.size(); ++i)
+    {
+        if (m_propagators[i].IsDeepSpace())
+        {
+            m_deepSpace.push_back(i);
+        } else
+        {
+            m_nearEarth.Add(i, m_propagators[i]);
+        }
+    }
+}
+
+IO::Astrodynamics::Propagators::SGP4CatalogPropagator::SGP4CatalogPropagator(const IO::Astrodynamics::OrbitalParameters::TLECatalog &catalog)
+        : SGP4CatalogPropagator(ReadElements(catalog))
+{
+}
+
+void IO::Astrodynamics::Propagators::SGP4CatalogPropagator::PropagateNearEarth(double epoch, std::size_t begin, std::size_t end, double *positions,
+                                                                               double *velocities, SGP4::Status *statuses) const
+{
+    constexpr double x2o3 = 2.0 / 3.0;
+    const double vkmpersec = SGP4::ER * SGP4::KE / 60.0 * 1E+03;
+    const double rkm = SGP4::ER * 1E+03;
+    const auto &e = m_nearEarth;
+
+    double am[LANES], nm[LANES], em[LANES], mm[LANES], argpm[LANES], nodem[LANES], temp[LANES], axnl[LANES], aynl[LANES], u[LANES];
+    double eo1[LANES], sineo1[LANES], coseo1[LANES], tem5[LANES];
+    SGP4::Status status[LANES];
+
+    for (std::size_t block = begin; block < end; block += LANES)
+    {
+        const std::size_t n = std::min(LANES, end - block);
+
+        //Secular gravity and atmospheric drag
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            const std::size_t i = block + k;
+            const double t = (epoch - e.Epoch[i]) / 60.0;
+            const double t2 = t * t;
+            const double t3 = t2 * t;
+            const double t4 = t3 * t;
+            const double xmdf = e.Mo[i] + e.Mdot[i] * t;
+            const double delmtemp = 1.0 + e.Eta[i] * std::cos(xmdf);
+            const double delta = e.Omgcof[i] * t + e.Xmcof[i] * (delmtemp * delmtemp * delmtemp - e.Delmo[i]);
+            mm[k] = xmdf + delta;
+            argpm[k] = e.Argpo[i] + e.Argpdot[i] * t - delta;
+            nodem[k] = e.Nodeo[i] + e.Nodedot[i] * t + e.Nodecf[i] * t2;
+            const double tempa = 1.0 - e.Cc1[i] * t - e.D2[i] * t2 - e.D3[i] * t3 - e.D4[i] * t4;
+            const double tempe = e.Bstar[i] * e.Cc4[i] * t + e.Bstar[i] * e.Cc5[i] * (std::sin(mm[k]) - e.Sinmao[i]);
+            const double templ = e.T2cof[i] * t2 + e.T3cof[i] * t3 + t4 * (e.T4cof[i] + t * e.T5cof[i]);
+
+            am[k] = std::pow(SGP4::KE / e.No[i], x2o3) * tempa * tempa;
+            nm[k] = SGP4::KE / std::pow(am[k], 1.5);
+            em[k] = e.Ecco[i] - tempe;
+            status[k] = (em[k] >= 1.0 || em[k] < -0.001) ? SGP4::Status::InvalidEccentricity : SGP4::Status::Success;
+            em[k] = std::max(em[k], 1.0e-6);
+            mm[k] = mm[k] + e.No[i] * templ;
+            const double xlm = std::fmod(mm[k] + argpm[k] + nodem[k], Constants::_2PI);
+            nodem[k] = std::fmod(nodem[k], Constants::_2PI);
+            argpm[k] = std::fmod(argpm[k], Constants::_2PI);
+            mm[k] = std::fmod(xlm - argpm[k] - nodem[k], Constants::_2PI);
+
+            //Long period periodics
+            axnl[k] = em[k] * std::cos(argpm[k]);
+            temp[k] = 1.0 / (am[k] * (1.0 - em[k] * em[k]));
+            aynl[k] = em[k] * std::sin(argpm[k]) + temp[k] * e.Aycof[i];
+            const double xl = mm[k] + argpm[k] + nodem[k] + temp[k] * e.Xlcof[i] * axnl[k];
+            u[k] = std::fmod(xl - nodem[k], Constants::_2PI);
+            eo1[k] = u[k];
+            tem5[k] = 9999.9;
+        }
+
+        //Kepler equation, converged lanes are frozen until the whole block converged
+        for (int ktr = 1; ktr <= 10; ++ktr)
+        {
+            bool active = false;
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                if (std::abs(tem5[k]) < 1.0e-12)
+                {
+                    continue;
+                }
+                sineo1[k] = std::sin(eo1[k]);
+                coseo1[k] = std::cos(eo1[k]);
+                double delta = (u[k] - aynl[k] * coseo1[k] + axnl[k] * sineo1[k] - eo1[k]) / (1.0 - coseo1[k] * axnl[k] - sineo1[k] * aynl[k]);
+                delta = std::clamp(delta, -0.95, 0.95);
+                tem5[k] = delta;
+                eo1[k] = eo1[k] + delta;
+                active = active || std::abs(delta) >= 1.0e-12;
+            }
+            if (!active)
+            {
+                break;
+            }
+        }
+
+        //Short period periodics and output
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            const std::size_t i = block + k;
+            const double ecose = axnl[k] * coseo1[k] + aynl[k] * sineo1[k];
+            const double esine = axnl[k] * sineo1[k] - aynl[k] * coseo1[k];
+            const double el2 = axnl[k] * axnl[k] + aynl[k] * aynl[k];
+            const double pl = am[k] * (1.0 - el2);
+            if (status[k] == SGP4::Status::Success && pl < 0.0)
+            {
+                status[k] = SGP4::Status::InvalidSemiLatusRectum;
+            }
+
+            const double rl = am[k] * (1.0 - ecose);
+            const double rdotl = std::sqrt(am[k]) * esine / rl;
+            const double rvdotl = std::sqrt(pl) / rl;
+            const double betal = std::sqrt(1.0 - el2);
+            const double tmp = esine / (1.0 + betal);
+            const double sinu = am[k] / rl * (sineo1[k] - aynl[k] - axnl[k] * tmp);
+            const double cosu = am[k] / rl * (coseo1[k] - axnl[k] + aynl[k] * tmp);
+            double su = std::atan2(sinu, cosu);
+            const double sin2u = (cosu + cosu) * sinu;
+            const double cos2u = 1.0 - 2.0 * sinu * sinu;
+            const double invpl = 1.0 / pl;
+            const double temp1 = 0.5 * SGP4::J2 * invpl;
+            const double temp2 = temp1 * invpl;
+
+            const double mrt = rl * (1.0 - 1.5 * temp2 * betal * e.Con41[i]) + 0.5 * temp1 * e.X1mth2[i] * cos2u;
+            su = su - 0.25 * temp2 * e.X7thm1[i] * sin2u;
+            const double xnode = nodem[k] + 1.5 * temp2 * e.Cosio[i] * sin2u;
+            const double xinc = e.Inclo[i] + 1.5 * temp2 * e.Cosio[i] * e.Sinio[i] * cos2u;
+            const double mvt = rdotl - nm[k] * temp1 * e.X1mth2[i] * sin2u / SGP4::KE;
+            const double rvdot = rvdotl + nm[k] * temp1 * (e.X1mth2[i] * cos2u + 1.5 * e.Con41[i]) / SGP4::KE;
+            if (status[k] == SGP4::Status::Success && mrt < 1.0)
+            {
+                status[k] = SGP4::Status::Decayed;
+            }
+
+            const double sinsu = std::sin(su);
+            const double cossu = std::cos(su);
+            const double snod = std::sin(xnode);
+            const double cnod = std::cos(xnode);
+            const double sini = std::sin(xinc);
+            const double cosi = std::cos(xinc);
+            const double xmx = -snod * cosi;
+            const double xmy = cnod * cosi;
+            const double ux = xmx * sinsu + cnod * cossu;
+            const double uy = xmy * sinsu + snod * cossu;
+            const double uz = sini * sinsu;
+            const double vx = xmx * cossu - cnod * sinsu;
+            const double vy = xmy * cossu - snod * sinsu;
+            const double vz = sini * cossu;
+
+            const std::size_t idx = e.Indexes[i];
+            double *r = positions + idx * 3;
+            double *v = velocities + idx * 3;
+            r[0] = mrt * ux * rkm;
+            r[1] = mrt * uy * rkm;
+            r[2] = mrt * uz * rkm;
+            v[0] = (mvt * ux + rvdot * vx) * vkmpersec;
+            v[1] = (mvt * uy + rvdot * vy) * vkmpersec;
+            v[2] = (mvt * uz + rvdot * vz) * vkmpersec;
+            if (statuses)
+            {
+                statuses[idx] = status[k];
+            }
+        }
+    }
+}
+
+void IO::Astrodynamics::Propagators::SGP4CatalogPropagator::PropagateDeepSpace(double epoch, std::size_t begin, std::size_t end, double *positions,
+                                                                               double *velocities, SGP4::Status *statuses) const
+{
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        const std::size_t idx = m_deepSpace[i];
+        const auto &propagator = m_propagators[idx];
+        double *r = positions + idx * 3;
+        double *v = velocities + idx * 3;
+        auto status = propagator.Propagate((epoch - propagator.GetEpoch().GetSecondsFromJ2000().count()) / 60.0, r, v);
+        for (int k = 0; k < 3; ++k)
+        {
+            r[k] *= 1E+03;
+            v[k] *= 1E+03;
+        }
+        if (statuses)
+        {
+            statuses[idx] = status;
+        }
+    }
+}
+
+std::size_t IO::Astrodynamics::Propagators::SGP4CatalogPropagator::Propagate(const IO::Astrodynamics::Time::TDB &epoch, const IO::Astrodynamics::Frames::Frames &frame,
+                                                                             double *positions, double *velocities, unsigned int threadCount,
+                                                                             SGP4::Status *statuses) const
+{
+    const std::size_t count = m_propagators.size();
+    std::vector<SGP4::Status> localStatuses;
+    if (!statuses)
+    {
+        localStatuses.resize(count);
+        statuses = localStatuses.data();
+    }
+
+    //Frame transformation is computed once for the whole catalog
+    const bool isTEME = IO::Astrodynamics::StringHelpers::ToUpper(frame.GetName()) == "TEME";
+    double transform[6][6]{};
+    if (!isTEME)
+    {
+        auto mtx = IO::Astrodynamics::Frames::BodyFixedFrames::TEME().ToFrame6x6(frame, epoch);
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+            for (std::size_t j = 0; j < 6; ++j)
+            {
+                transform[i][j] = mtx.GetValue(i, j);
+            }
+        }
+    }
+
+    const double et = epoch.GetSecondsFromJ2000().count();
+    auto work = [&](std::size_t nearBegin, std::size_t nearEnd, std::size_t deepBegin, std::size_t deepEnd)
+    {
+        PropagateNearEarth(et, nearBegin, nearEnd, positions, velocities, statuses);
+        PropagateDeepSpace(et, deepBegin, deepEnd, positions, velocities, statuses);
+
+        auto finalize = [&](std::size_t idx)
+        {
+            double *r = positions + idx * 3;
+            double *v = velocities + idx * 3;
+            if (statuses[idx] != SGP4::Status::Success)
+            {
+                std::fill(r, r + 3, std::numeric_limits<double>::quiet_NaN());
+                std::fill(v, v + 3, std::numeric_limits<double>::quiet_NaN());
+                return;
+            }
+            if (isTEME)
+            {
+                return;
+            }
+            const double state[6]{r[0], r[1], r[2], v[0], v[1], v[2]};
+            for (int k = 0; k < 3; ++k)
+            {
+                r[k] = transform[k][0] * state[0] + transform[k][1] * state[1] + transform[k][2] * state[2];
+                v[k] = transform[k + 3][0] * state[0] + transform[k + 3][1] * state[1] + transform[k + 3][2] * state[2] + transform[k + 3][3] * state[3] +
+                       transform[k + 3][4] * state[4] + transform[k + 3][5] * state[5];
+            }
+        };
+
+        for (std::size_t i = nearBegin; i < nearEnd; ++i)
+        {
+            finalize(m_nearEarth.Indexes[i]);
+        }
+        for (std::size_t i = deepBegin; i < deepEnd; ++i)
+        {
+            finalize(m_deepSpace[i]);
+        }
+    };
+
+    threadCount = IO::Astrodynamics::Helpers::ThreadCount(threadCount, count / MIN_OBJECTS_PER_THREAD);
+
+    //Near earth chunks are aligned on lanes blocks
+    const std::size_t nearCount = m_nearEarth.GetSize();
+    const std::size_t deepCount = m_deepSpace.size();
+    const std::size_t nearChunk = (nearCount / threadCount + LANES) / LANES * LANES;
+    const std::size_t deepChunk = deepCount / threadCount + 1;
+    IO::Astrodynamics::Helpers::RunThreads(threadCount, [&](unsigned int t)
+    {
+        work(std::min(nearCount, t * nearChunk), std::min(nearCount, (t + 1) * nearChunk), std::min(deepCount, t * deepChunk), std::min(deepCount, (t + 1) * deepChunk));
+    });
+
+    return static_cast<std::size_t>(std::count_if(statuses, statuses + count, [](SGP4::Status status)
+    { return status != SGP4::Status::Success; }));
+}
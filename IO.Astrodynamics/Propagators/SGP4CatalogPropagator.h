@@ -0,0 +1,97 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_SGP4CATALOGPROPAGATOR_H
+#define IO_SGP4CATALOGPROPAGATOR_H
+
+#include <vector>
+
+#include <BodyFixedFrames.h>
+#include <SGP4.h>
+#include <TLECatalog.h>
+
+namespace IO::Astrodynamics::Propagators
+{
+    /**
+     * @brief Propagate a whole two lines elements catalog at once.
+     * Near earth objects are stored in structure of arrays and propagated by blocks with branch free lanes,
+     * deep space objects use the scalar SGP4 propagator. Work is split between threads and no CSPICE call is done while propagating,
+     * except the single frame transformation computed once per epoch.
+     */
+    class SGP4CatalogPropagator final
+    {
+    private:
+        /**
+         * @brief Near earth constants in structure of arrays layout
+         */
+        struct NearEarthElements
+        {
+            std::vector<std::size_t> Indexes;
+            std::vector<double> Epoch, Mo, Mdot, Argpo, Argpdot, Nodeo, Nodedot, Nodecf, Cc1, Cc4, Cc5, Bstar, T2cof, T3cof, T4cof, T5cof;
+            std::vector<double> Omgcof, Xmcof, Eta, Delmo, Sinmao, D2, D3, D4, No, Ecco, Inclo, Sinio, Cosio, Aycof, Xlcof, Con41, X1mth2, X7thm1;
+
+            void Add(std::size_t index, const SGP4 &propagator);
+
+            [[nodiscard]] inline std::size_t GetSize() const
+            { return Indexes.size(); }
+        };
+
+        std::vector<SGP4> m_propagators;
+        NearEarthElements m_nearEarth;
+        std::vector<std::size_t> m_deepSpace;
+
+        void PropagateNearEarth(double epoch, std::size_t begin, std::size_t end, double *positions, double *velocities, SGP4::Status *statuses) const;
+
+        void PropagateDeepSpace(double epoch, std::size_t begin, std::size_t end, double *positions, double *velocities, SGP4::Status *statuses) const;
+
+    public:
+        /**
+         * @brief Construct a new SGP4 catalog propagator
+         *
+         * @param elements
+         */
+        explicit SGP4CatalogPropagator(const std::vector<SGP4Elements> &elements);
+
+        /**
+         * @brief Construct a catalog propagator for every record of a two lines elements catalog, in catalog order
+         *
+         * @param catalog
+         */
+        explicit SGP4CatalogPropagator(const IO::Astrodynamics::OrbitalParameters::TLECatalog &catalog);
+
+        /**
+         * @brief Propagate every object of the catalog at the same epoch.
+         * Failed objects have NaN position and velocity.
+         *
+         * @param epoch
+         * @param frame Output frame, TEME frame doesn't need any transformation
+         * @param positions Output positions (m), 3 values per object in catalog order
+         * @param velocities Output velocities (m/s), 3 values per object in catalog order
+         * @param threadCount 0 to use all available hardware threads
+         * @param statuses Optional output status per object
+         * @return std::size_t Number of failed objects
+         */
+        std::size_t Propagate(const IO::Astrodynamics::Time::TDB &epoch, const IO::Astrodynamics::Frames::Frames &frame, double *positions, double *velocities,
+                              unsigned int threadCount = 0, SGP4::Status *statuses = nullptr) const;
+
+        /**
+         * @brief Get the object count
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] inline std::size_t GetSize() const
+        { return m_propagators.size(); }
+
+        /**
+         * @brief Get the scalar propagator of an object
+         *
+         * @param index Catalog index
+         * @return const SGP4&
+         */
+        [[nodiscard]] inline const SGP4 &GetPropagator(std::size_t index) const
+        { return m_propagators.at(index); }
+    };
+}
+
+#endif //IO_SGP4CATALOGPROPAGATOR_H
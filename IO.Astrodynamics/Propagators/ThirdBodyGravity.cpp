@@ -0,0 +1,96 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <ThirdBodyGravity.h>
+
+#include <cmath>
+
+#include <InertialFrames.h>
+#include <InvalidArgumentException.h>
+
+IO::Astrodynamics::Propagators::ThirdBodyGravity::ThirdBodyGravity(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> body,
+                                                                   std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> centralBody,
+                                                                   const IO::Astrodynamics::Frames::Frames &frame, double step) : m_body{std::move(body)},
+                                                                                                                                  m_centralBody{std::move(centralBody)},
+                                                                                                                                  m_frame{frame},
+                                                                                                                                  m_mu{m_body ? m_body->GetMu() : 0.0},
+                                                                                                                                  m_ephemeris{3, step}
+{
+    if (!m_body || !m_centralBody)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Bodies must be defined");
+    }
+}
+
+IO::Astrodynamics::Propagators::ThirdBodyGravity::ThirdBodyGravity(double mu, double begin, double step, std::vector<double> states) : m_frame{
+        IO::Astrodynamics::Frames::InertialFrames::ICRF()}, m_mu{mu}, m_ephemeris{3, begin, step, std::move(states)}
+{
+    if (!(mu > 0.0))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Gravitational parameter must be positive");
+    }
+}
+
+void IO::Astrodynamics::Propagators::ThirdBodyGravity::Prepare(double begin, double end)
+{
+    if (!m_body)
+    {
+        return;
+    }
+
+    m_ephemeris.Sample(begin, end, [this](double epoch, double *state)
+    {
+        auto sv = m_body->ReadEphemeris(m_frame, IO::Astrodynamics::AberrationsEnum::None, IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(epoch)),
+                                        *m_centralBody);
+        const auto &position = sv.GetPosition();
+        const auto &velocity = sv.GetVelocity();
+        state[0] = position.GetX();
+        state[1] = position.GetY();
+        state[2] = position.GetZ();
+        state[3] = velocity.GetX();
+        state[4] = velocity.GetY();
+        state[5] = velocity.GetZ();
+    });
+}
+
+void IO::Astrodynamics::Propagators::ThirdBodyGravity::GetPosition(double epoch, double position[3]) const
+{
+    m_ephemeris.Interpolate(epoch, position);
+}
+
+void IO::Astrodynamics::Propagators::ThirdBodyGravity::AddAcceleration(double epoch, const double state[6], double acceleration[3]) const
+{
+    double body[3];
+    GetPosition(epoch, body);
+    const double relative[3]{body[0] - state[0], body[1] - state[1], body[2] - state[2]};
+    const double d2 = relative[0] * relative[0] + relative[1] * relative[1] + relative[2] * relative[2];
+    const double s2 = body[0] * body[0] + body[1] * body[1] + body[2] * body[2];
+    const double direct = m_mu / (d2 * std::sqrt(d2));
+    const double indirect = m_mu / (s2 * std::sqrt(s2));
+    for (int i = 0; i < 3; ++i)
+    {
+        acceleration[i] += direct * relative[i] - indirect * body[i];
+    }
+}
+
+void IO::Astrodynamics::Propagators::ThirdBodyGravity::AddAccelerations(double epoch, std::size_t count, const double *const states[6],
+                                                                         double *const accelerations[3]) const
+{
+    //Perturbing body position and indirect term are shared by all states
+    double body[3];
+    GetPosition(epoch, body);
+    const double s2 = body[0] * body[0] + body[1] * body[1] + body[2] * body[2];
+    const double indirect = m_mu / (s2 * std::sqrt(s2));
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const double dx = body[0] - states[0][i];
+        const double dy = body[1] - states[1][i];
+        const double dz = body[2] - states[2][i];
+        const double d2 = dx * dx + dy * dy + dz * dz;
+        const double direct = m_mu / (d2 * std::sqrt(d2));
+        accelerations[0][i] += direct * dx - indirect * body[0];
+        accelerations[1][i] += direct * dy - indirect * body[1];
+        accelerations[2][i] += direct * dz - indirect * body[2];
+    }
+}
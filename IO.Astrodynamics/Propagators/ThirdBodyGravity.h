@@ -0,0 +1,76 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_THIRDBODYGRAVITY_H
+#define IO_THIRDBODYGRAVITY_H
+
+#include <memory>
+#include <vector>
+
+#include <ForceModel.h>
+#include <HermiteGrid.h>
+#include <CelestialBody.h>
+
+namespace IO::Astrodynamics::Propagators
+{
+    /**
+     * @brief Third body perturbation, direct attraction minus the central body one.
+     * Third body ephemeris is read once on a regular grid covering the propagation window,
+     * then positions are evaluated with a cubic Hermite interpolation of grid states.
+     */
+    class ThirdBodyGravity final : public ForceModel
+    {
+    private:
+        const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_body;
+        const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_centralBody;
+        const IO::Astrodynamics::Frames::Frames m_frame;
+        const double m_mu;
+        //Perturbing body positions and velocities
+        IO::Astrodynamics::Math::HermiteGrid m_ephemeris;
+
+    public:
+        /**
+         * @brief Construct a new Third Body Gravity read from ephemeris
+         *
+         * @param body Perturbing body
+         * @param centralBody Central body of the propagation
+         * @param frame Propagation frame
+         * @param step Ephemeris grid step (s)
+         */
+        ThirdBodyGravity(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> body, std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> centralBody,
+                         const IO::Astrodynamics::Frames::Frames &frame, double step = 3600.0);
+
+        /**
+         * @brief Construct a new Third Body Gravity from states already known
+         *
+         * @param mu Gravitational parameter of the perturbing body (m^3/s^2)
+         * @param begin First grid epoch (s)
+         * @param step Grid step (s)
+         * @param states Perturbing body states relative to the central body, 6 values per grid epoch (m, m/s)
+         */
+        ThirdBodyGravity(double mu, double begin, double step, std::vector<double> states);
+
+        /**
+         * @brief Read the perturbing body ephemeris over the window, nothing is read when states are given at construction
+         *
+         * @param begin
+         * @param end
+         */
+        void Prepare(double begin, double end) override;
+
+        void AddAcceleration(double epoch, const double state[6], double acceleration[3]) const override;
+
+        void AddAccelerations(double epoch, std::size_t count, const double *const states[6], double *const accelerations[3]) const override;
+
+        /**
+         * @brief Get the perturbing body position
+         *
+         * @param epoch Epoch inside the grid (s)
+         * @param position Output position relative to the central body (m)
+         */
+        void GetPosition(double epoch, double position[3]) const;
+    };
+}
+
+#endif //IO_THIRDBODYGRAVITY_H
@@ -0,0 +1,93 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <TwoBodyPropagator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+#include <KeplerSolver.h>
+
+IO::Astrodynamics::Propagators::TwoBodyPropagator::TwoBodyPropagator(double mu, const double position[3], const double velocity[3]) : m_mu{mu}
+{
+    if (!(mu > 0.0))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Gravitational parameter must be positive");
+    }
+    std::copy(position, position + 3, m_position);
+    std::copy(velocity, velocity + 3, m_velocity);
+    m_radius = std::sqrt(position[0] * position[0] + position[1] * position[1] + position[2] * position[2]);
+    if (!(m_radius > 0.0) || std::isinf(m_radius))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Position must be finite and not null");
+    }
+    m_sqrtMu = std::sqrt(mu);
+    m_sigma = (position[0] * velocity[0] + position[1] * velocity[1] + position[2] * velocity[2]) / m_sqrtMu;
+    m_alpha = 2.0 / m_radius - (velocity[0] * velocity[0] + velocity[1] * velocity[1] + velocity[2] * velocity[2]) / mu;
+    m_period = m_alpha > 0.0 ? IO::Astrodynamics::Constants::_2PI / (m_sqrtMu * m_alpha * std::sqrt(m_alpha)) : 0.0;
+}
+
+double IO::Astrodynamics::Propagators::TwoBodyPropagator::ReduceTime(double elapsedTime) const
+{
+    return m_period > 0.0 ? std::remainder(elapsedTime, m_period) : elapsedTime;
+}
+
+void IO::Astrodynamics::Propagators::TwoBodyPropagator::Evaluate(double chi, double *position, double *velocity) const
+{
+    //Lagrange coefficients, g is written without elapsed time to avoid cancellation
+    const double chi2 = chi * chi;
+    const double z = m_alpha * chi2;
+    const double c = IO::Astrodynamics::Math::KeplerSolver::GetStumpffC(z);
+    const double s = IO::Astrodynamics::Math::KeplerSolver::GetStumpffS(z);
+    const double f = 1.0 - chi2 * c / m_radius;
+    const double g = (m_sigma * chi2 * c + m_radius * chi * (1.0 - z * s)) / m_sqrtMu;
+    for (int i = 0; i < 3; ++i)
+    {
+        position[i] = f * m_position[i] + g * m_velocity[i];
+    }
+    const double radius = std::sqrt(position[0] * position[0] + position[1] * position[1] + position[2] * position[2]);
+    const double fDot = m_sqrtMu * chi * (z * s - 1.0) / (radius * m_radius);
+    const double gDot = 1.0 - chi2 * c / radius;
+    for (int i = 0; i < 3; ++i)
+    {
+        velocity[i] = fDot * m_position[i] + gDot * m_velocity[i];
+    }
+}
+
+void IO::Astrodynamics::Propagators::TwoBodyPropagator::Propagate(double elapsedTime, double position[3], double velocity[3]) const
+{
+    const double t = ReduceTime(elapsedTime);
+    Evaluate(IO::Astrodynamics::Math::KeplerSolver::SolveUniversal(t, m_mu, m_radius, m_sigma, m_alpha, std::numeric_limits<double>::quiet_NaN()), position, velocity);
+}
+
+void IO::Astrodynamics::Propagators::TwoBodyPropagator::Propagate(std::size_t count, const double *elapsedTimes, double *positions, double *velocities) const
+{
+    double previousTime{};
+    double previousChi{};
+    double previousRadius{m_radius};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        //First order guess from the previous solution since d(chi)/dt = sqrt(mu) / r
+        const double t = ReduceTime(elapsedTimes[i]);
+        const double guess = previousChi + (t - previousTime) * m_sqrtMu / previousRadius;
+        const double chi = IO::Astrodynamics::Math::KeplerSolver::SolveUniversal(t, m_mu, m_radius, m_sigma, m_alpha, guess);
+        double *position = positions + 3 * i;
+        Evaluate(chi, position, velocities + 3 * i);
+        previousTime = t;
+        previousChi = chi;
+        previousRadius = std::sqrt(position[0] * position[0] + position[1] * position[1] + position[2] * position[2]);
+    }
+}
+
+void IO::Astrodynamics::Propagators::TwoBodyPropagator::Propagate(std::size_t count, double mu, const double *states, double elapsedTime, double *propagatedStates)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const TwoBodyPropagator propagator(mu, states + 6 * i, states + 6 * i + 3);
+        propagator.Propagate(elapsedTime, propagatedStates + 6 * i, propagatedStates + 6 * i + 3);
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_TWOBODYPROPAGATOR_H
+#define IO_TWOBODYPROPAGATOR_H
+
+#include <cstddef>
+
+namespace IO::Astrodynamics::Propagators
+{
+    /**
+     * @brief Two-body propagator based on the universal variable formulation, valid for every conic.
+     * Orbit invariants are computed once at construction, then each epoch only costs a universal Kepler equation solve
+     * and Lagrange coefficients evaluation. No CSPICE call is done.
+     */
+    class TwoBodyPropagator final
+    {
+    private:
+        double m_mu;
+        double m_sqrtMu;
+        double m_position[3]{};
+        double m_velocity[3]{};
+        double m_radius;
+        //r.v / sqrt(mu)
+        double m_sigma;
+        //Inverse of semi major axis
+        double m_alpha;
+        //Orbital period of elliptic orbits, 0 otherwise
+        double m_period;
+
+        [[nodiscard]] double ReduceTime(double elapsedTime) const;
+
+        void Evaluate(double chi, double *position, double *velocity) const;
+
+    public:
+        /**
+         * @brief Construct a new two-body propagator
+         *
+         * @param mu Gravitational parameter (m^3/s^2)
+         * @param position Initial position (m)
+         * @param velocity Initial velocity (m/s)
+         */
+        TwoBodyPropagator(double mu, const double position[3], const double velocity[3]);
+
+        /**
+         * @brief Propagate the initial state
+         *
+         * @param elapsedTime Time from the initial state (s)
+         * @param position Output position (m)
+         * @param velocity Output velocity (m/s)
+         */
+        void Propagate(double elapsedTime, double position[3], double velocity[3]) const;
+
+        /**
+         * @brief Propagate the initial state to many epochs.
+         * Each solve starts from the previous solution, so sorted epochs converge in very few iterations.
+         *
+         * @param count Epochs count
+         * @param elapsedTimes Times from the initial state (s)
+         * @param positions Output positions (m), 3 values per epoch
+         * @param velocities Output velocities (m/s), 3 values per epoch
+         */
+        void Propagate(std::size_t count, const double *elapsedTimes, double *positions, double *velocities) const;
+
+        /**
+         * @brief Propagate many states orbiting the same body by the same duration
+         *
+         * @param count States count
+         * @param mu Gravitational parameter (m^3/s^2)
+         * @param states Initial states, 6 values per state (m, m/s)
+         * @param elapsedTime Propagation duration (s)
+         * @param propagatedStates Output states, 6 values per state, may be the initial states array
+         */
+        static void Propagate(std::size_t count, double mu, const double *states, double elapsedTime, double *propagatedStates);
+
+        [[nodiscard]] inline double GetMu() const
+        { return m_mu; }
+
+        [[nodiscard]] inline double GetSemiMajorAxis() const
+        { return 1.0 / m_alpha; }
+
+        /**
+         * @brief Get the orbital period
+         *
+         * @return Period (s), 0 for parabolic and hyperbolic orbits
+         */
+        [[nodiscard]] inline double GetPeriod() const
+        { return m_period; }
+    };
+}
+
+#endif //IO_TWOBODYPROPAGATOR_H
@@ -0,0 +1,94 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <ZonalHarmonicsGravity.h>
+
+#include <cmath>
+
+#include <InvalidArgumentException.h>
+
+namespace
+{
+    double DefinedOrZero(double value)
+    {
+        return std::isnan(value) ? 0.0 : value;
+    }
+}
+
+IO::Astrodynamics::Propagators::ZonalHarmonicsGravity::ZonalHarmonicsGravity(double mu, double radius, double j2, double j3, double j4, const double pole[3]) : m_mu{mu},
+                                                                                                                                                               m_radius{radius},
+                                                                                                                                                               m_j2{j2}, m_j3{j3},
+                                                                                                                                                               m_j4{j4}
+{
+    if (!(mu > 0.0) || !(radius > 0.0))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Gravitational parameter and radius must be positive");
+    }
+    const double norm = std::sqrt(pole[0] * pole[0] + pole[1] * pole[1] + pole[2] * pole[2]);
+    if (!(norm > 0.0) || std::isinf(norm))
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Pole direction must be finite and not null");
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        m_pole[i] = pole[i] / norm;
+    }
+}
+
+IO::Astrodynamics::Propagators::ZonalHarmonicsGravity::ZonalHarmonicsGravity(const IO::Astrodynamics::Body::CelestialBody &body,
+                                                                             const IO::Astrodynamics::Frames::Frames &frame,
+                                                                             const IO::Astrodynamics::Time::TDB &epoch) : m_mu{body.GetMu()},
+                                                                                                                          m_radius{body.GetRadius().GetX()},
+                                                                                                                          m_j2{DefinedOrZero(body.GetJ2())},
+                                                                                                                          m_j3{DefinedOrZero(body.GetJ3())},
+                                                                                                                          m_j4{DefinedOrZero(body.GetJ4())}
+{
+    auto pole = body.GetBodyFixedFrame().TransformVector(frame, IO::Astrodynamics::Math::Vector3D::VectorZ, epoch).Normalize();
+    m_pole[0] = pole.GetX();
+    m_pole[1] = pole.GetY();
+    m_pole[2] = pole.GetZ();
+}
+
+void IO::Astrodynamics::Propagators::ZonalHarmonicsGravity::AddAcceleration([[maybe_unused]] double epoch, const double state[6], double acceleration[3]) const
+{
+    //Vector form of zonal accelerations, radial part along position and axial part along the pole
+    const double r2 = state[0] * state[0] + state[1] * state[1] + state[2] * state[2];
+    const double r = std::sqrt(r2);
+    const double z = state[0] * m_pole[0] + state[1] * m_pole[1] + state[2] * m_pole[2];
+    const double s = z * z / r2;
+    const double ratio = m_radius / r;
+    const double factor = m_mu / (r2 * r);
+
+    const double j2 = -1.5 * m_j2 * factor * ratio * ratio;
+    double radial = j2 * (1.0 - 5.0 * s);
+    double axial = j2 * 2.0 * z;
+
+    const double j3 = -2.5 * m_j3 * factor * ratio * ratio * ratio / r;
+    radial += j3 * z * (3.0 - 7.0 * s);
+    axial += j3 * (3.0 * z * z - 0.6 * r2);
+
+    const double j4 = 1.875 * m_j4 * factor * ratio * ratio * ratio * ratio;
+    radial += j4 * (1.0 - 14.0 * s + 21.0 * s * s);
+    axial += j4 * z * (4.0 - 28.0 / 3.0 * s);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        acceleration[i] += radial * state[i] + axial * m_pole[i];
+    }
+}
+
+void IO::Astrodynamics::Propagators::ZonalHarmonicsGravity::AddAccelerations(double epoch, std::size_t count, const double *const states[6],
+                                                                              double *const accelerations[3]) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        //Non virtual call, the evaluation is inlined in the loop
+        const double state[6]{states[0][i], states[1][i], states[2][i], 0.0, 0.0, 0.0};
+        double acceleration[3]{};
+        ZonalHarmonicsGravity::AddAcceleration(epoch, state, acceleration);
+        accelerations[0][i] += acceleration[0];
+        accelerations[1][i] += acceleration[1];
+        accelerations[2][i] += acceleration[2];
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_ZONALHARMONICSGRAVITY_H
+#define IO_ZONALHARMONICSGRAVITY_H
+
+#include <ForceModel.h>
+#include <CelestialBody.h>
+
+namespace IO::Astrodynamics::Propagators
+{
+    /**
+     * @brief J2, J3 and J4 zonal harmonics of the central body, central term excluded.
+     * The body pole direction is considered fixed in the propagation frame over the propagation window.
+     */
+    class ZonalHarmonicsGravity final : public ForceModel
+    {
+    private:
+        const double m_mu;
+        const double m_radius;
+        const double m_j2;
+        const double m_j3;
+        const double m_j4;
+        double m_pole[3]{};
+
+    public:
+        /**
+         * @brief Construct a new Zonal Harmonics Gravity
+         *
+         * @param mu Gravitational parameter (m^3/s^2)
+         * @param radius Equatorial radius (m)
+         * @param j2
+         * @param j3
+         * @param j4
+         * @param pole Body pole direction in the propagation frame
+         */
+        ZonalHarmonicsGravity(double mu, double radius, double j2, double j3, double j4, const double pole[3]);
+
+        /**
+         * @brief Construct a new Zonal Harmonics Gravity from body constants, undefined coefficients are ignored
+         *
+         * @param body Central body
+         * @param frame Propagation frame
+         * @param epoch Epoch used to orient the body pole
+         */
+        ZonalHarmonicsGravity(const IO::Astrodynamics::Body::CelestialBody &body, const IO::Astrodynamics::Frames::Frames &frame, const IO::Astrodynamics::Time::TDB &epoch);
+
+        void AddAcceleration(double epoch, const double state[6], double acceleration[3]) const override;
+
+        void AddAccelerations(double epoch, std::size_t count, const double *const states[6], double *const accelerations[3]) const override;
+    };
+}
+
+#endif //IO_ZONALHARMONICSGRAVITY_H
@@ -0,0 +1,76 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <ElevationMask.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+
+IO::Astrodynamics::Sites::ElevationMask::ElevationMask(double elevation) : m_azimuths{0.0}, m_elevations{elevation}, m_minimum{elevation}, m_maximum{elevation}
+{
+}
+
+IO::Astrodynamics::Sites::ElevationMask::ElevationMask(const std::vector<double> &azimuths, const std::vector<double> &elevations)
+{
+    if (azimuths.empty() || azimuths.size() != elevations.size())
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Azimuths and elevations must have the same non zero size");
+    }
+
+    std::vector<std::size_t> order(azimuths.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&azimuths](std::size_t a, std::size_t b) { return azimuths[a] < azimuths[b]; });
+
+    m_azimuths.reserve(azimuths.size());
+    m_elevations.reserve(elevations.size());
+    for (auto i: order)
+    {
+        if (azimuths[i] < 0.0 || azimuths[i] >= IO::Astrodynamics::Constants::_2PI)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Azimuth must be in [0, 2PI[");
+        }
+        m_azimuths.push_back(azimuths[i]);
+        m_elevations.push_back(elevations[i]);
+    }
+
+    auto bounds = std::minmax_element(m_elevations.begin(), m_elevations.end());
+    m_minimum = *bounds.first;
+    m_maximum = *bounds.second;
+}
+
+double IO::Astrodynamics::Sites::ElevationMask::GetElevation(double azimuth) const
+{
+    if (IsConstant())
+    {
+        return m_minimum;
+    }
+
+    azimuth = std::fmod(azimuth, IO::Astrodynamics::Constants::_2PI);
+    if (azimuth < 0.0)
+    {
+        azimuth += IO::Astrodynamics::Constants::_2PI;
+    }
+
+    //Samples surrounding the azimuth, last and first samples are linked across north
+    auto upper = std::upper_bound(m_azimuths.begin(), m_azimuths.end(), azimuth);
+    std::size_t next = upper == m_azimuths.end() ? 0 : static_cast<std::size_t>(upper - m_azimuths.begin());
+    std::size_t previous = next == 0 ? m_azimuths.size() - 1 : next - 1;
+
+    double span = m_azimuths[next] - m_azimuths[previous];
+    double offset = azimuth - m_azimuths[previous];
+    if (span <= 0.0)
+    {
+        span += IO::Astrodynamics::Constants::_2PI;
+    }
+    if (offset < 0.0)
+    {
+        offset += IO::Astrodynamics::Constants::_2PI;
+    }
+
+    return m_elevations[previous] + (m_elevations[next] - m_elevations[previous]) * offset / span;
+}
@@ -0,0 +1,75 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_ELEVATIONMASK_H
+#define IO_ELEVATIONMASK_H
+
+#include <vector>
+
+namespace IO::Astrodynamics::Sites
+{
+    /**
+     * @brief Azimuth dependent minimum elevation (terrain profile).
+     * Elevation is linearly interpolated between azimuth samples and wraps around north.
+     */
+    class ElevationMask final
+    {
+    private:
+        std::vector<double> m_azimuths;
+        std::vector<double> m_elevations;
+        double m_minimum{};
+        double m_maximum{};
+
+    public:
+        /**
+         * @brief Construct a constant elevation mask
+         *
+         * @param elevation Minimum elevation (rad)
+         */
+        explicit ElevationMask(double elevation = 0.0);
+
+        /**
+         * @brief Construct a terrain profile
+         *
+         * @param azimuths Azimuths (rad) clockwise from north in [0, 2PI[
+         * @param elevations Minimum elevations (rad) at each azimuth
+         */
+        ElevationMask(const std::vector<double> &azimuths, const std::vector<double> &elevations);
+
+        /**
+         * @brief Get the minimum elevation at a given azimuth
+         *
+         * @param azimuth (rad)
+         * @return double
+         */
+        [[nodiscard]] double GetElevation(double azimuth) const;
+
+        /**
+         * @brief Get the lowest elevation of the mask
+         *
+         * @return double
+         */
+        [[nodiscard]] inline double GetMinimum() const
+        { return m_minimum; }
+
+        /**
+         * @brief Get the highest elevation of the mask
+         *
+         * @return double
+         */
+        [[nodiscard]] inline double GetMaximum() const
+        { return m_maximum; }
+
+        /**
+         * @brief Mask has the same elevation for every azimuth
+         *
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] inline bool IsConstant() const
+        { return m_minimum == m_maximum; }
+    };
+}
+
+#endif //IO_ELEVATIONMASK_H
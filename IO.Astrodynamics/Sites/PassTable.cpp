@@ -0,0 +1,127 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <PassTable.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include <Constants.h>
+#include <SDKException.h>
+#include <UTC.h>
+
+namespace
+{
+    constexpr char PASS_TABLE_MAGIC[8]{'I', 'O', 'P', 'A', 'S', 'S', '0', '1'};
+
+    //Binary record layout
+    struct PassRecord
+    {
+        std::uint64_t SiteIndex;
+        std::int64_t TargetId;
+        double Values[8];
+    };
+}
+
+IO::Astrodynamics::Sites::PassTable::PassTable(std::vector<Pass> passes) : m_passes{std::move(passes)}
+{
+    std::stable_sort(m_passes.begin(), m_passes.end(), [](const Pass &a, const Pass &b) { return a.AOS < b.AOS; });
+}
+
+std::vector<IO::Astrodynamics::Sites::Pass> IO::Astrodynamics::Sites::PassTable::GetPasses(int targetId) const
+{
+    std::vector<Pass> passes;
+    std::copy_if(m_passes.begin(), m_passes.end(), std::back_inserter(passes), [targetId](const Pass &x) { return x.TargetId == targetId; });
+    return passes;
+}
+
+void IO::Astrodynamics::Sites::PassTable::WriteCsv(const std::string &filePath) const
+{
+    std::ofstream outFile(filePath);
+    if (!outFile.good())
+    {
+        throw IO::Astrodynamics::Exception::SDKException("Unable to open file " + filePath);
+    }
+
+    outFile.precision(12);
+    outFile << "SiteIndex,TargetId,AOS,LOS,TCA,MaxElevationEpoch,MaxElevation,MinRange,AOSAzimuth,LOSAzimuth\n";
+    for (const auto &pass: m_passes)
+    {
+        outFile << pass.SiteIndex << ',' << pass.TargetId << ',' << pass.AOS.ToUTC().ToString() << ',' << pass.LOS.ToUTC().ToString() << ','
+                << pass.TCA.ToUTC().ToString() << ',' << pass.MaxElevationEpoch.ToUTC().ToString() << ','
+                << pass.MaxElevation * IO::Astrodynamics::Constants::RAD_DEG << ',' << pass.MinRange << ','
+                << pass.AOSAzimuth * IO::Astrodynamics::Constants::RAD_DEG << ',' << pass.LOSAzimuth * IO::Astrodynamics::Constants::RAD_DEG << '\n';
+    }
+}
+
+void IO::Astrodynamics::Sites::PassTable::WriteBinary(const std::string &filePath) const
+{
+    std::ofstream outFile(filePath, std::ios::binary);
+    if (!outFile.good())
+    {
+        throw IO::Astrodynamics::Exception::SDKException("Unable to open file " + filePath);
+    }
+
+    const std::uint64_t count = m_passes.size();
+    outFile.write(PASS_TABLE_MAGIC, sizeof(PASS_TABLE_MAGIC));
+    outFile.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    for (const auto &pass: m_passes)
+    {
+        PassRecord record{pass.SiteIndex, pass.TargetId,
+                          {pass.AOS.GetSecondsFromJ2000().count(), pass.LOS.GetSecondsFromJ2000().count(), pass.TCA.GetSecondsFromJ2000().count(),
+                           pass.MaxElevationEpoch.GetSecondsFromJ2000().count(), pass.MaxElevation, pass.MinRange, pass.AOSAzimuth, pass.LOSAzimuth}};
+        outFile.write(reinterpret_cast<const char *>(&record), sizeof(record));
+    }
+}
+
+IO::Astrodynamics::Sites::PassTable IO::Astrodynamics::Sites::PassTable::ReadBinary(const std::string &filePath)
+{
+    std::ifstream inFile(filePath, std::ios::binary);
+    char magic[sizeof(PASS_TABLE_MAGIC)];
+    std::uint64_t count{};
+    inFile.read(magic, sizeof(magic));
+    inFile.read(reinterpret_cast<char *>(&count), sizeof(count));
+    if (!inFile.good() || std::memcmp(magic, PASS_TABLE_MAGIC, sizeof(magic)) != 0)
+    {
+        throw IO::Astrodynamics::Exception::SDKException("Invalid pass table file " + filePath);
+    }
+
+    //Count is checked against the records actually stored before anything is allocated
+    const auto recordsBegin = inFile.tellg();
+    inFile.seekg(0, std::ios::end);
+    const auto remaining = static_cast<std::uint64_t>(inFile.tellg() - recordsBegin);
+    inFile.seekg(recordsBegin);
+    if (!inFile.good() || count > remaining / sizeof(PassRecord))
+    {
+        throw IO::Astrodynamics::Exception::SDKException("Invalid pass table file " + filePath);
+    }
+
+    std::vector<Pass> passes;
+    passes.reserve(count);
+    PassRecord record{};
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+        if (!inFile.read(reinterpret_cast<char *>(&record), sizeof(record)))
+        {
+            throw IO::Astrodynamics::Exception::SDKException("Truncated pass table file " + filePath);
+        }
+
+        Pass pass;
+        pass.SiteIndex = record.SiteIndex;
+        pass.TargetId = static_cast<int>(record.TargetId);
+        pass.AOS = IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(record.Values[0]));
+        pass.LOS = IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(record.Values[1]));
+        pass.TCA = IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(record.Values[2]));
+        pass.MaxElevationEpoch = IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(record.Values[3]));
+        pass.MaxElevation = record.Values[4];
+        pass.MinRange = record.Values[5];
+        pass.AOSAzimuth = record.Values[6];
+        pass.LOSAzimuth = record.Values[7];
+        passes.push_back(pass);
+    }
+
+    return PassTable(std::move(passes));
+}
@@ -0,0 +1,91 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_PASSTABLE_H
+#define IO_PASSTABLE_H
+
+#include <string>
+#include <vector>
+
+#include <TDB.h>
+
+namespace IO::Astrodynamics::Sites
+{
+    /**
+     * @brief Target pass over a site.
+     * A pass truncated by the search window starts (resp. ends) at the search window start (resp. end).
+     */
+    struct Pass
+    {
+        std::size_t SiteIndex{};
+        int TargetId{};
+        IO::Astrodynamics::Time::TDB AOS{std::chrono::duration<double>(0.0)};
+        IO::Astrodynamics::Time::TDB LOS{std::chrono::duration<double>(0.0)};
+
+        //Time of closest approach
+        IO::Astrodynamics::Time::TDB TCA{std::chrono::duration<double>(0.0)};
+        IO::Astrodynamics::Time::TDB MaxElevationEpoch{std::chrono::duration<double>(0.0)};
+        double MaxElevation{};
+        double MinRange{};
+        double AOSAzimuth{};
+        double LOSAzimuth{};
+    };
+
+    /**
+     * @brief Pass list sorted by acquisition of signal
+     */
+    class PassTable final
+    {
+    private:
+        std::vector<Pass> m_passes;
+
+    public:
+        /**
+         * @brief Construct a new Pass Table
+         *
+         * @param passes
+         */
+        explicit PassTable(std::vector<Pass> passes = {});
+
+        /**
+         * @brief Get passes
+         *
+         * @return const std::vector<Pass>&
+         */
+        [[nodiscard]] inline const std::vector<Pass> &GetPasses() const
+        { return m_passes; }
+
+        /**
+         * @brief Get passes of one target
+         *
+         * @param targetId
+         * @return std::vector<Pass>
+         */
+        [[nodiscard]] std::vector<Pass> GetPasses(int targetId) const;
+
+        /**
+         * @brief Write passes in a CSV file, epochs in UTC, angles in degrees and range in meters
+         *
+         * @param filePath
+         */
+        void WriteCsv(const std::string &filePath) const;
+
+        /**
+         * @brief Write passes in a compact binary file, epochs in TDB seconds from J2000, angles in radians and range in meters
+         *
+         * @param filePath
+         */
+        void WriteBinary(const std::string &filePath) const;
+
+        /**
+         * @brief Read passes from a binary file written by WriteBinary
+         *
+         * @param filePath
+         * @return PassTable
+         */
+        static PassTable ReadBinary(const std::string &filePath);
+    };
+}
+
+#endif //IO_PASSTABLE_H
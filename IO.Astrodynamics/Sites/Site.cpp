@@ -3,10 +3,10 @@
  */
 
 #include <Site.h>
-#include <Parameters.h>
 #include <Constants.h>
 
 #include <InertialFrames.h>
+#include <VisibilityMatrixEngine.h>
 #include <algorithm>
 
 using namespace std::chrono_literals;
@@ -22,6 +22,8 @@ IO::Astrodynamics::Sites::Site::Site(const int id, std::string name, const IO::A
                                                                                                                                                 m_filesPath + "/Ephemeris/" +
                                                                                                                                                 m_name + ".spk", this->m_id)},
                                                                                                                                 m_body{std::move(body)},
+                                                                                                                                m_topocentricFrame{coordinates, m_body->GetRadius().GetX(),
+                                                                                                                                                   m_body->GetFlattening()},
                                                                                                                                 m_frame{std::make_unique<IO::Astrodynamics::Frames::SiteFrameFile>(
                                                                                                                                         *this)}
 {
@@ -35,9 +37,7 @@ IO::Astrodynamics::Sites::Site::Site(const int id, std::string name, const IO::A
 IO::Astrodynamics::OrbitalParameters::StateVector
 IO::Astrodynamics::Sites::Site::GetStateVector(const IO::Astrodynamics::Frames::Frames &frame, const IO::Astrodynamics::Time::TDB &epoch) const
 {
-    SpiceDouble bodyFixedLocation[3];
-    georec_c(m_coordinates.GetLongitude(), m_coordinates.GetLatitude(), m_coordinates.GetAltitude(), m_body->GetRadius().GetX(),
-             m_body->GetFlattening(), bodyFixedLocation);
+    const auto &bodyFixedLocation = m_topocentricFrame.GetPosition();
     IO::Astrodynamics::OrbitalParameters::StateVector siteVectorState{m_body, IO::Astrodynamics::Math::Vector3D(bodyFixedLocation[0],
                                                                                                                 bodyFixedLocation[1],
                                                                                                                 bodyFixedLocation[2]),
@@ -69,9 +69,8 @@ IO::Astrodynamics::Illumination::Illumination
 IO::Astrodynamics::Sites::Site::GetIllumination(const IO::Astrodynamics::AberrationsEnum aberrationCorrection,
                                                 const IO::Astrodynamics::Time::TDB &epoch) const
 {
-    SpiceDouble bodyFixedLocation[3];
-    georec_c(m_coordinates.GetLongitude(), m_coordinates.GetLatitude(), m_coordinates.GetAltitude(),
-             m_body->GetRadius().GetX() * 0.001, m_body->GetFlattening(), bodyFixedLocation);
+    const auto &location = m_topocentricFrame.GetPosition();
+    SpiceDouble bodyFixedLocation[3]{location[0] * 0.001, location[1] * 0.001, location[2] * 0.001};
 
     SpiceDouble srfvec[3];
     SpiceDouble emi;
@@ -127,9 +126,8 @@ IO::Astrodynamics::Sites::Site::FindWindowsOnIlluminationConstraint(const IO::As
 {
     IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> tdbWindow(searchWindow.GetStartDate().ToTDB(), searchWindow.GetEndDate().ToTDB());
     std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::UTC>> windows;
-    SpiceDouble bodyFixedLocation[3];
-    georec_c(m_coordinates.GetLongitude(), m_coordinates.GetLatitude(), m_coordinates.GetAltitude(),
-             m_body->GetRadius().GetX() * 0.001, m_body->GetFlattening(), bodyFixedLocation);
+    const auto &location = m_topocentricFrame.GetPosition();
+    SpiceDouble bodyFixedLocation[3]{location[0] * 0.001, location[1] * 0.001, location[2] * 0.001};
 
 
     auto res = IO::Astrodynamics::Constraints::GeometryFinder::FindWindowsOnIlluminationConstraint(tdbWindow, observerBody.GetId(), "Sun", m_body->GetId(),
@@ -153,9 +151,8 @@ IO::Astrodynamics::Coordinates::HorizontalCoordinates
 IO::Astrodynamics::Sites::Site::GetHorizontalCoordinates(const IO::Astrodynamics::Body::CelestialItem &body, const IO::Astrodynamics::AberrationsEnum aberrationCorrection,
                                                          const IO::Astrodynamics::Time::TDB &epoch) const
 {
-    SpiceDouble bodyFixedLocation[3];
-    georec_c(m_coordinates.GetLongitude(), m_coordinates.GetLatitude(), m_coordinates.GetAltitude(), m_body->GetRadius().GetX() * 0.001,
-             m_body->GetFlattening(), bodyFixedLocation);
+    const auto &location = m_topocentricFrame.GetPosition();
+    SpiceDouble bodyFixedLocation[3]{location[0] * 0.001, location[1] * 0.001, location[2] * 0.001};
 
     SpiceDouble res[6];
     SpiceDouble lt;
@@ -167,6 +164,99 @@ IO::Astrodynamics::Sites::Site::GetHorizontalCoordinates(const IO::Astrodynamics
     return IO::Astrodynamics::Coordinates::HorizontalCoordinates{res[1], res[2], res[0] * 1000.0};
 }
 
+IO::Astrodynamics::Sites::HorizontalCoordinatesBatch
+IO::Astrodynamics::Sites::Site::GetHorizontalCoordinates(const std::vector<int> &targetIds, const std::vector<IO::Astrodynamics::Time::TDB> &epochs,
+                                                         const IO::Astrodynamics::AberrationsEnum aberrationCorrection, const bool refraction) const
+{
+    std::vector<double> seconds;
+    seconds.reserve(epochs.size());
+    std::for_each(epochs.begin(), epochs.end(), [&seconds](const Time::TDB &x) { seconds.push_back(x.GetSecondsFromJ2000().count()); });
+
+    HorizontalCoordinatesBatch res;
+    res.EpochCount = epochs.size();
+    res.TargetCount = targetIds.size();
+    const std::size_t size = res.EpochCount * res.TargetCount;
+    res.Azimuth.resize(size);
+    res.Elevation.resize(size);
+    res.Range.resize(size);
+    res.AzimuthRate.resize(size);
+    res.ElevationRate.resize(size);
+    res.RangeRate.resize(size);
+
+    GetHorizontalCoordinates(targetIds.data(), targetIds.size(), seconds.data(), seconds.size(), aberrationCorrection, refraction, res.Azimuth.data(),
+                             res.Elevation.data(), res.Range.data(), res.AzimuthRate.data(), res.ElevationRate.data(), res.RangeRate.data());
+    return res;
+}
+
+void IO::Astrodynamics::Sites::Site::GetHorizontalCoordinates(const int *targetIds, const std::size_t targetCount, const double *epochs, const std::size_t epochCount,
+                                                              const IO::Astrodynamics::AberrationsEnum aberrationCorrection, const bool refraction, double *azimuth,
+                                                              double *elevation, double *range, double *azimuthRate, double *elevationRate, double *rangeRate) const
+{
+    GetHorizontalCoordinates(*m_body, m_topocentricFrame, targetIds, targetCount, epochs, epochCount, aberrationCorrection, refraction, azimuth, elevation, range,
+                             azimuthRate, elevationRate, rangeRate);
+}
+
+void IO::Astrodynamics::Sites::Site::GetHorizontalCoordinates(const IO::Astrodynamics::Body::CelestialBody &body, const TopocentricFrame &topocentricFrame,
+                                                              const int *targetIds, const std::size_t targetCount, const double *epochs, const std::size_t epochCount,
+                                                              const IO::Astrodynamics::AberrationsEnum aberrationCorrection, const bool refraction, double *azimuth,
+                                                              double *elevation, double *range, double *azimuthRate, double *elevationRate, double *rangeRate)
+{
+    const auto &location = topocentricFrame.GetPosition();
+    SpiceDouble bodyFixedLocation[3]{location[0] * 0.001, location[1] * 0.001, location[2] * 0.001};
+    const std::string bodyId{std::to_string(body.GetId())};
+    const std::string frame{body.GetBodyFixedFrame().GetName()};
+    const std::string abcorr{IO::Astrodynamics::Aberrations::ToString(aberrationCorrection)};
+
+    std::vector<std::string> targets;
+    targets.reserve(targetCount);
+    for (std::size_t j = 0; j < targetCount; ++j)
+    {
+        targets.push_back(std::to_string(targetIds[j]));
+    }
+
+    SpiceDouble state[6];
+    SpiceDouble lt;
+    for (std::size_t i = 0; i < epochCount; ++i)
+    {
+        for (std::size_t j = 0; j < targetCount; ++j)
+        {
+            //Target state relative to the site in body fixed frame
+            spkcpo_c(targets[j].c_str(), epochs[i], frame.c_str(), "OBSERVER", abcorr.c_str(), bodyFixedLocation, bodyId.c_str(), frame.c_str(), state, &lt);
+            for (double &x: state)
+            {
+                x *= 1000.0;
+            }
+
+            const std::size_t idx = i * targetCount + j;
+            topocentricFrame.GetHorizontalStates(state, azimuth[idx], elevation[idx], range[idx], azimuthRate[idx], elevationRate[idx], rangeRate[idx]);
+
+            if (refraction)
+            {
+                ApplyRefraction(elevation[idx], elevationRate[idx]);
+            }
+        }
+    }
+}
+
+void IO::Astrodynamics::Sites::Site::ApplyRefraction(double &elevation, double &elevationRate)
+{
+    //Refraction is undefined far below the horizon
+    const double h = elevation * IO::Astrodynamics::Constants::RAD_DEG;
+    if (h < -1.0)
+    {
+        return;
+    }
+
+    //Saemundsson formula from true elevation at 1010 hPa and 10 deg C, shifted to be null at zenith (arc minutes)
+    const double x = (h + 10.3 / (h + 5.11)) * IO::Astrodynamics::Constants::DEG_RAD;
+    const double tanX = std::tan(x);
+    const double refraction = 1.02 / tanX + 0.0019279;
+    const double derivative = -1.02 / (60.0 * std::sin(x) * std::sin(x)) * IO::Astrodynamics::Constants::DEG_RAD * (1.0 - 10.3 / ((h + 5.11) * (h + 5.11)));
+
+    elevation += refraction / 60.0 * IO::Astrodynamics::Constants::DEG_RAD;
+    elevationRate *= 1.0 + derivative;
+}
+
 IO::Astrodynamics::OrbitalParameters::StateVector
 IO::Astrodynamics::Sites::Site::GetStateVector(const IO::Astrodynamics::Body::CelestialItem &body, const IO::Astrodynamics::Frames::Frames &frame,
                                                IO::Astrodynamics::AberrationsEnum aberrationCorrection,
@@ -200,9 +290,13 @@ IO::Astrodynamics::Sites::Site::FindBodyVisibilityWindows(const IO::Astrodynamic
     return utcWindows;
 }
 
-void IO::Astrodynamics::Sites::Site::WriteEphemeris(const std::vector<OrbitalParameters::StateVector> &states) const
+IO::Astrodynamics::Sites::PassTable
+IO::Astrodynamics::Sites::Site::PredictPasses(const std::vector<int> &targetIds, const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                              const IO::Astrodynamics::Sites::ElevationMask &mask, const IO::Astrodynamics::AberrationsEnum aberrationCorrection,
+                                              const IO::Astrodynamics::Time::TimeSpan &gridStep) const
 {
-    return this->m_ephemerisKernel->WriteData(states);
+    IO::Astrodynamics::Sites::VisibilityMatrixEngine engine(m_body, {m_coordinates}, {mask});
+    return engine.PredictPasses(searchWindow, targetIds, aberrationCorrection, gridStep);
 }
 
 IO::Astrodynamics::OrbitalParameters::StateVector IO::Astrodynamics::Sites::Site::ReadEphemeris(const IO::Astrodynamics::Frames::Frames &frame,
@@ -230,19 +324,8 @@ std::string IO::Astrodynamics::Sites::Site::ReadEphemerisKernelComment() const
 
 void IO::Astrodynamics::Sites::Site::BuildAndWriteEphemeris(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window) const
 {
-    std::vector<IO::Astrodynamics::OrbitalParameters::StateVector> svector;
-    for (auto epoch = window.GetStartDate(); epoch <= window.GetEndDate(); epoch = epoch + IO::Astrodynamics::Parameters::SitePropagationStep)
-    {
-        auto sv = GetStateVector(IO::Astrodynamics::Frames::InertialFrames::ICRF(), epoch);
-        svector.push_back(sv);
-    }
-
-    //Add latest value
-    if (svector.back().GetEpoch() < window.GetEndDate())
-    {
-        auto sv = GetStateVector(IO::Astrodynamics::Frames::InertialFrames::ICRF(), window.GetEndDate());
-        svector.push_back(sv);
-    }
-
-    WriteEphemeris(svector);
+    //Site is fixed in its body fixed frame
+    const auto &location = m_topocentricFrame.GetPosition();
+    m_ephemerisKernel->WriteConstantPosition(m_body->GetId(), m_body->GetBodyFixedFrame(), IO::Astrodynamics::Math::Vector3D(location[0], location[1], location[2]),
+                                             window);
 }
@@ -12,6 +12,9 @@
 #include <HorizontalCoordinates.h>
 #include <IlluminationAngle.h>
 #include <EphemerisKernel.h>
+#include <TopocentricFrame.h>
+#include <ElevationMask.h>
+#include <PassTable.h>
 
 namespace IO::Astrodynamics::Kernels
 {
@@ -20,6 +23,22 @@ namespace IO::Astrodynamics::Kernels
 
 namespace IO::Astrodynamics::Sites
 {
+    /**
+     * @brief Batch of horizontal coordinates and rates.
+     * Values of target j at epoch i are stored at i * TargetCount + j.
+     */
+    struct HorizontalCoordinatesBatch
+    {
+        std::size_t EpochCount{};
+        std::size_t TargetCount{};
+        std::vector<double> Azimuth{};
+        std::vector<double> Elevation{};
+        std::vector<double> Range{};
+        std::vector<double> AzimuthRate{};
+        std::vector<double> ElevationRate{};
+        std::vector<double> RangeRate{};
+    };
+
     /**
      * @brief Site class
      * 
@@ -34,12 +53,14 @@ namespace IO::Astrodynamics::Sites
         const std::unique_ptr<IO::Astrodynamics::Kernels::EphemerisKernel> m_ephemerisKernel;
 
         const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_body;
+        const IO::Astrodynamics::Sites::TopocentricFrame m_topocentricFrame;
         const std::unique_ptr<IO::Astrodynamics::Frames::SiteFrameFile> m_frame;
         /**
-         * Write stateVectors into ephemeris file
-         * @param states
+         * Apply standard atmospheric refraction on a true elevation and its rate
+         * @param elevation
+         * @param elevationRate
          */
-        void WriteEphemeris(const std::vector<OrbitalParameters::StateVector> &states) const;
+        static void ApplyRefraction(double &elevation, double &elevationRate);
 
     public:
         /**
@@ -171,6 +192,64 @@ namespace IO::Astrodynamics::Sites
         [[nodiscard]] IO::Astrodynamics::Coordinates::HorizontalCoordinates
         GetHorizontalCoordinates(const IO::Astrodynamics::Body::CelestialItem &body, IO::Astrodynamics::AberrationsEnum aberrationCorrection, const IO::Astrodynamics::Time::TDB &epoch) const;
 
+        /**
+         * @brief Get horizontal coordinates and rates of many targets at many epochs
+         *
+         * @param targetIds Naif identifiers of targets
+         * @param epochs
+         * @param aberrationCorrection
+         * @param refraction Apply standard atmospheric refraction on elevation
+         * @return HorizontalCoordinatesBatch
+         */
+        [[nodiscard]] HorizontalCoordinatesBatch
+        GetHorizontalCoordinates(const std::vector<int> &targetIds, const std::vector<IO::Astrodynamics::Time::TDB> &epochs,
+                                 IO::Astrodynamics::AberrationsEnum aberrationCorrection, bool refraction = false) const;
+
+        /**
+         * @brief Get horizontal coordinates and rates of many targets at many epochs into contiguous buffers.
+         * Values of target j at epoch i are written at i * targetCount + j, each buffer must hold epochCount * targetCount values.
+         *
+         * @param targetIds Naif identifiers of targets
+         * @param targetCount
+         * @param epochs Seconds from J2000 (TDB)
+         * @param epochCount
+         * @param aberrationCorrection
+         * @param refraction Apply standard atmospheric refraction on elevation
+         * @param azimuth (rad)
+         * @param elevation (rad)
+         * @param range (m)
+         * @param azimuthRate (rad/s)
+         * @param elevationRate (rad/s)
+         * @param rangeRate (m/s)
+         */
+        void GetHorizontalCoordinates(const int *targetIds, std::size_t targetCount, const double *epochs, std::size_t epochCount,
+                                      IO::Astrodynamics::AberrationsEnum aberrationCorrection, bool refraction, double *azimuth, double *elevation, double *range,
+                                      double *azimuthRate, double *elevationRate, double *rangeRate) const;
+
+        /**
+         * @brief Get horizontal coordinates and rates of many targets seen from a body fixed location, nothing is written in kernels so no site instance is needed.
+         * Values of target j at epoch i are written at i * targetCount + j, each buffer must hold epochCount * targetCount values.
+         *
+         * @param body Body carrying the location
+         * @param topocentricFrame Location and its local frame in body fixed frame
+         * @param targetIds Naif identifiers of targets
+         * @param targetCount
+         * @param epochs Seconds from J2000 (TDB)
+         * @param epochCount
+         * @param aberrationCorrection
+         * @param refraction Apply standard atmospheric refraction on elevation
+         * @param azimuth (rad)
+         * @param elevation (rad)
+         * @param range (m)
+         * @param azimuthRate (rad/s)
+         * @param elevationRate (rad/s)
+         * @param rangeRate (m/s)
+         */
+        static void GetHorizontalCoordinates(const IO::Astrodynamics::Body::CelestialBody &body, const TopocentricFrame &topocentricFrame, const int *targetIds,
+                                             std::size_t targetCount, const double *epochs, std::size_t epochCount,
+                                             IO::Astrodynamics::AberrationsEnum aberrationCorrection, bool refraction, double *azimuth, double *elevation,
+                                             double *range, double *azimuthRate, double *elevationRate, double *rangeRate);
+
 
         /**
          * @brief Get the State Vector to target body
@@ -185,6 +264,21 @@ namespace IO::Astrodynamics::Sites
                        const IO::Astrodynamics::Time::TDB &epoch) const;
 
 
+        /**
+         * @brief Predict passes of many targets with AOS, LOS, closest approach, maximum elevation and azimuths at AOS and LOS
+         *
+         * @param targetIds Naif identifiers of targets
+         * @param searchWindow
+         * @param mask Site elevation mask
+         * @param aberrationCorrection Aberration applied on target states seen from the body center
+         * @param gridStep Target sampling step, must be lower than the shortest pass to detect
+         * @return PassTable
+         */
+        [[nodiscard]] PassTable PredictPasses(const std::vector<int> &targetIds, const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                              const ElevationMask &mask = ElevationMask(),
+                                              IO::Astrodynamics::AberrationsEnum aberrationCorrection = IO::Astrodynamics::AberrationsEnum::None,
+                                              const IO::Astrodynamics::Time::TimeSpan &gridStep = IO::Astrodynamics::Time::TimeSpan(std::chrono::duration<double>(60.0))) const;
+
         [[nodiscard]] std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::UTC>>
         FindBodyVisibilityWindows(const IO::Astrodynamics::Body::CelestialItem &body, const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::UTC> &searchWindow,
                                   IO::Astrodynamics::AberrationsEnum aberrationCorrection) const;
@@ -196,6 +290,13 @@ namespace IO::Astrodynamics::Sites
         [[nodiscard]] inline const std::unique_ptr<IO::Astrodynamics::Frames::SiteFrameFile> &GetFrame() const
         { return m_frame; }
 
+        /**
+         * Get the local east, north, up frame of this site
+         * @return
+         */
+        [[nodiscard]] inline const IO::Astrodynamics::Sites::TopocentricFrame &GetTopocentricFrame() const
+        { return m_topocentricFrame; }
+
         /**
          * Get the file path to this site
          * @return
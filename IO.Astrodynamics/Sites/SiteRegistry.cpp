@@ -0,0 +1,284 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <SiteRegistry.h>
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+#include <SpiceUsr.h>
+#include <StringHelpers.h>
+
+namespace
+{
+    constexpr int POOL_CHUNK = 100;
+    constexpr int POOL_STRING_LENGTH = 81;
+    constexpr std::size_t POOL_NAME_LENGTH = 32;
+
+    std::vector<std::string> ReadStrings(const std::string &name)
+    {
+        std::vector<std::string> res;
+        SpiceChar values[POOL_CHUNK][POOL_STRING_LENGTH];
+        SpiceInt n{};
+        SpiceBoolean found{SPICEFALSE};
+        do
+        {
+            gcpool_c(name.c_str(), static_cast<SpiceInt>(res.size()), POOL_CHUNK, POOL_STRING_LENGTH, &n, values, &found);
+            for (SpiceInt i = 0; found && i < n; ++i)
+            {
+                res.emplace_back(values[i]);
+            }
+        } while (found && n == POOL_CHUNK);
+
+        return res;
+    }
+
+    std::vector<int> ReadIntegers(const std::string &name)
+    {
+        std::vector<int> res;
+        SpiceInt values[POOL_CHUNK];
+        SpiceInt n{};
+        SpiceBoolean found{SPICEFALSE};
+        do
+        {
+            gipool_c(name.c_str(), static_cast<SpiceInt>(res.size()), POOL_CHUNK, &n, values, &found);
+            for (SpiceInt i = 0; found && i < n; ++i)
+            {
+                res.push_back(values[i]);
+            }
+        } while (found && n == POOL_CHUNK);
+
+        return res;
+    }
+
+    void WriteStrings(const std::string &name, const std::vector<std::string> &values)
+    {
+        if (values.empty())
+        {
+            dvpool_c(name.c_str());
+            return;
+        }
+
+        std::vector<SpiceChar> buffer(values.size() * POOL_STRING_LENGTH, '\0');
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            std::strncpy(buffer.data() + i * POOL_STRING_LENGTH, values[i].c_str(), POOL_STRING_LENGTH - 1);
+        }
+        pcpool_c(name.c_str(), static_cast<SpiceInt>(values.size()), POOL_STRING_LENGTH, buffer.data());
+    }
+
+    void WriteIntegers(const std::string &name, const std::vector<int> &values)
+    {
+        if (values.empty())
+        {
+            dvpool_c(name.c_str());
+            return;
+        }
+
+        std::vector<SpiceInt> buffer(values.begin(), values.end());
+        pipool_c(name.c_str(), static_cast<SpiceInt>(buffer.size()), buffer.data());
+    }
+
+    int FrameId(int siteId)
+    {
+        return 1000000 + siteId;
+    }
+}
+
+IO::Astrodynamics::Sites::SiteRegistry::SiteRegistry(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> body) : m_body{std::move(body)},
+                                                                                                                      m_fixedFrame{m_body ? IO::Astrodynamics::StringHelpers::ToUpper(
+                                                                                                                              m_body->GetBodyFixedFrame().GetName()) : ""}
+{
+    if (!m_body)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Body must be defined");
+    }
+}
+
+IO::Astrodynamics::Sites::SiteRegistry::~SiteRegistry()
+{
+    Clear();
+}
+
+std::string IO::Astrodynamics::Sites::SiteRegistry::GetFrameName(const std::string &name)
+{
+    return name + "_TOPO";
+}
+
+void IO::Astrodynamics::Sites::SiteRegistry::Register(const std::vector<SiteDefinition> &sites)
+{
+    std::unordered_set<int> ids;
+    for (const auto &site: sites)
+    {
+        if (site.Id < 199000 || site.Id > 899999)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException(
+                    "Invalid site id. Site id must be composed by the site body id and the site number. Ex. The site 232 on earth (399) must have the id 399232.");
+        }
+        if (Contains(site.Id) || !ids.insert(site.Id).second)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Site " + std::to_string(site.Id) + " is already registered");
+        }
+        if (site.Name.empty() || std::string("FRAME_" + GetFrameName(site.Name)).size() > POOL_NAME_LENGTH)
+        {
+            throw IO::Astrodynamics::Exception::InvalidArgumentException("Site name must have between 1 and 21 characters");
+        }
+    }
+
+    //Body names are appended in one pool update
+    auto names = ReadStrings("NAIF_BODY_NAME");
+    auto codes = ReadIntegers("NAIF_BODY_CODE");
+    for (const auto &site: sites)
+    {
+        names.push_back(site.Name);
+        codes.push_back(site.Id);
+    }
+    WriteStrings("NAIF_BODY_NAME", names);
+    WriteIntegers("NAIF_BODY_CODE", codes);
+
+    auto radius = m_body->GetRadius();
+    const double flattening = (radius.GetX() - radius.GetZ()) / radius.GetX();
+    m_sites.reserve(m_sites.size() + sites.size());
+    m_frames.reserve(m_frames.size() + sites.size());
+
+    for (const auto &site: sites)
+    {
+        //Same frame definition as site frame kernels
+        const int frameId = FrameId(site.Id);
+        const std::string prefix{"FRAME_" + std::to_string(frameId)};
+        const std::string tkPrefix{"TKFRAME_" + std::to_string(frameId)};
+        const std::string frameName{GetFrameName(site.Name)};
+        const SpiceInt axes[3]{3, 2, 3};
+        const SpiceDouble angles[3]{-site.Coordinates.GetLongitude(), -(IO::Astrodynamics::Constants::PI2 - site.Coordinates.GetLatitude()),
+                                    IO::Astrodynamics::Constants::PI};
+
+        WriteIntegers("FRAME_" + frameName, {frameId});
+        WriteStrings(prefix + "_NAME", {frameName});
+        WriteIntegers(prefix + "_CLASS", {4});
+        WriteIntegers(prefix + "_CLASS_ID", {frameId});
+        WriteIntegers(prefix + "_CENTER", {site.Id});
+        WriteStrings("OBJECT_" + std::to_string(site.Id) + "_FRAME", {frameName});
+        WriteStrings(tkPrefix + "_SPEC", {"ANGLES"});
+        WriteStrings(tkPrefix + "_RELATIVE", {m_fixedFrame});
+        pdpool_c((tkPrefix + "_ANGLES").c_str(), 3, angles);
+        pipool_c((tkPrefix + "_AXES").c_str(), 3, axes);
+        WriteStrings(tkPrefix + "_UNITS", {"RADIANS"});
+
+        m_index[site.Id] = m_sites.size();
+        m_sites.push_back(site);
+        m_frames.emplace_back(site.Coordinates, radius.GetX(), flattening);
+    }
+}
+
+void IO::Astrodynamics::Sites::SiteRegistry::RemoveFromPool(const std::vector<SiteDefinition> &sites) const
+{
+    if (sites.empty())
+    {
+        return;
+    }
+
+    std::unordered_map<int, std::string> removed;
+    for (const auto &site: sites)
+    {
+        removed[site.Id] = site.Name;
+    }
+
+    auto names = ReadStrings("NAIF_BODY_NAME");
+    auto codes = ReadIntegers("NAIF_BODY_CODE");
+    std::vector<std::string> keptNames;
+    std::vector<int> keptCodes;
+    for (std::size_t i = 0; i < std::min(names.size(), codes.size()); ++i)
+    {
+        auto it = removed.find(codes[i]);
+        if (it == removed.end() || it->second != names[i])
+        {
+            keptNames.push_back(names[i]);
+            keptCodes.push_back(codes[i]);
+        }
+    }
+    WriteStrings("NAIF_BODY_NAME", keptNames);
+    WriteIntegers("NAIF_BODY_CODE", keptCodes);
+
+    for (const auto &site: sites)
+    {
+        const std::string prefix{"FRAME_" + std::to_string(FrameId(site.Id))};
+        const std::string tkPrefix{"TKFRAME_" + std::to_string(FrameId(site.Id))};
+        for (const auto &name: {"FRAME_" + GetFrameName(site.Name), prefix + "_NAME", prefix + "_CLASS", prefix + "_CLASS_ID", prefix + "_CENTER",
+                                "OBJECT_" + std::to_string(site.Id) + "_FRAME", tkPrefix + "_SPEC", tkPrefix + "_RELATIVE", tkPrefix + "_ANGLES",
+                                tkPrefix + "_AXES", tkPrefix + "_UNITS"})
+        {
+            dvpool_c(name.c_str());
+        }
+    }
+}
+
+void IO::Astrodynamics::Sites::SiteRegistry::Unregister(const std::vector<int> &ids)
+{
+    std::unordered_set<int> removedIds(ids.begin(), ids.end());
+    std::vector<SiteDefinition> removed;
+    std::vector<SiteDefinition> sites;
+    std::vector<TopocentricFrame> frames;
+    for (std::size_t i = 0; i < m_sites.size(); ++i)
+    {
+        if (removedIds.count(m_sites[i].Id))
+        {
+            removed.push_back(m_sites[i]);
+        } else
+        {
+            sites.push_back(m_sites[i]);
+            frames.push_back(m_frames[i]);
+        }
+    }
+
+    RemoveFromPool(removed);
+
+    m_sites = std::move(sites);
+    m_frames = std::move(frames);
+    m_index.clear();
+    for (std::size_t i = 0; i < m_sites.size(); ++i)
+    {
+        m_index[m_sites[i].Id] = i;
+    }
+}
+
+void IO::Astrodynamics::Sites::SiteRegistry::Clear()
+{
+    RemoveFromPool(m_sites);
+    m_sites.clear();
+    m_frames.clear();
+    m_index.clear();
+}
+
+const IO::Astrodynamics::Sites::SiteDefinition &IO::Astrodynamics::Sites::SiteRegistry::GetSite(int id) const
+{
+    auto it = m_index.find(id);
+    if (it == m_index.end())
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Site " + std::to_string(id) + " is not registered");
+    }
+    return m_sites[it->second];
+}
+
+const IO::Astrodynamics::Sites::TopocentricFrame &IO::Astrodynamics::Sites::SiteRegistry::GetTopocentricFrame(int id) const
+{
+    auto it = m_index.find(id);
+    if (it == m_index.end())
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Site " + std::to_string(id) + " is not registered");
+    }
+    return m_frames[it->second];
+}
+
+IO::Astrodynamics::OrbitalParameters::StateVector
+IO::Astrodynamics::Sites::SiteRegistry::GetStateVector(int id, const IO::Astrodynamics::Frames::Frames &frame, const IO::Astrodynamics::Time::TDB &epoch) const
+{
+    const auto &position = GetTopocentricFrame(id).GetPosition();
+    IO::Astrodynamics::OrbitalParameters::StateVector siteVectorState{m_body, IO::Astrodynamics::Math::Vector3D(position[0], position[1], position[2]),
+                                                                      IO::Astrodynamics::Math::Vector3D(), epoch, m_body->GetBodyFixedFrame()};
+
+    return siteVectorState.ToFrame(frame);
+}
@@ -0,0 +1,135 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_SITEREGISTRY_H
+#define IO_SITEREGISTRY_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <CelestialBody.h>
+#include <Planetodetic.h>
+#include <StateVector.h>
+#include <TopocentricFrame.h>
+
+namespace IO::Astrodynamics::Sites
+{
+    /**
+     * @brief Site to register
+     */
+    struct SiteDefinition
+    {
+        int Id{};
+        std::string Name{};
+        IO::Astrodynamics::Coordinates::Planetodetic Coordinates{0.0, 0.0, 0.0};
+    };
+
+    /**
+     * @brief Register many sites in one batch without writing any file.
+     * Site names and topocentric frames ({name}_TOPO, same definition as site frame kernels) are defined directly in the kernel pool,
+     * site positions are kept in an internal table. Definitions are removed from the kernel pool when sites are unregistered
+     * or when the registry is destroyed.
+     */
+    class SiteRegistry final
+    {
+    private:
+        const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_body;
+        const std::string m_fixedFrame;
+        std::vector<SiteDefinition> m_sites;
+        std::vector<TopocentricFrame> m_frames;
+        std::unordered_map<int, std::size_t> m_index;
+
+        void RemoveFromPool(const std::vector<SiteDefinition> &sites) const;
+
+    public:
+        /**
+         * @brief Construct a new Site Registry
+         *
+         * @param body Body where sites are located
+         */
+        explicit SiteRegistry(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> body);
+
+        SiteRegistry(const SiteRegistry &) = delete;
+
+        SiteRegistry &operator=(const SiteRegistry &) = delete;
+
+        ~SiteRegistry();
+
+        /**
+         * @brief Register sites
+         *
+         * @param sites
+         */
+        void Register(const std::vector<SiteDefinition> &sites);
+
+        /**
+         * @brief Unregister sites
+         *
+         * @param ids
+         */
+        void Unregister(const std::vector<int> &ids);
+
+        /**
+         * @brief Unregister every site
+         */
+        void Clear();
+
+        /**
+         * @brief Site is registered
+         *
+         * @param id
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] inline bool Contains(int id) const
+        { return m_index.find(id) != m_index.end(); }
+
+        /**
+         * @brief Get the registered site count
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] inline std::size_t GetSize() const
+        { return m_sites.size(); }
+
+        /**
+         * @brief Get a site definition
+         *
+         * @param id
+         * @return const SiteDefinition&
+         */
+        [[nodiscard]] const SiteDefinition &GetSite(int id) const;
+
+        /**
+         * @brief Get the local east, north, up frame of a site
+         *
+         * @param id
+         * @return const TopocentricFrame&
+         */
+        [[nodiscard]] const TopocentricFrame &GetTopocentricFrame(int id) const;
+
+        /**
+         * @brief Get the topocentric frame name defined in the kernel pool
+         *
+         * @param name Site name
+         * @return std::string
+         */
+        [[nodiscard]] static std::string GetFrameName(const std::string &name);
+
+        /**
+         * @brief Get the site state vector relative to its body
+         *
+         * @param id
+         * @param frame
+         * @param epoch
+         * @return IO::Astrodynamics::OrbitalParameters::StateVector
+         */
+        [[nodiscard]] IO::Astrodynamics::OrbitalParameters::StateVector
+        GetStateVector(int id, const IO::Astrodynamics::Frames::Frames &frame, const IO::Astrodynamics::Time::TDB &epoch) const;
+    };
+}
+
+#endif //IO_SITEREGISTRY_H
@@ -0,0 +1,98 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <TopocentricFrame.h>
+
+#include <cmath>
+
+#include <Constants.h>
+#include <SpiceUsr.h>
+
+IO::Astrodynamics::Sites::TopocentricFrame::TopocentricFrame(const IO::Astrodynamics::Coordinates::Planetodetic &coordinates, double equatorialRadius,
+                                                             double flattening)
+{
+    georec_c(coordinates.GetLongitude(), coordinates.GetLatitude(), coordinates.GetAltitude(), equatorialRadius, flattening, m_position.data());
+
+    const double cosLon = std::cos(coordinates.GetLongitude());
+    const double sinLon = std::sin(coordinates.GetLongitude());
+    const double cosLat = std::cos(coordinates.GetLatitude());
+    const double sinLat = std::sin(coordinates.GetLatitude());
+
+    m_east = {-sinLon, cosLon, 0.0};
+    m_north = {-sinLat * cosLon, -sinLat * sinLon, cosLat};
+    m_up = {cosLat * cosLon, cosLat * sinLon, sinLat};
+}
+
+void IO::Astrodynamics::Sites::TopocentricFrame::ToTopocentric(const double bodyFixedPosition[3], double enu[3]) const
+{
+    const double dx = bodyFixedPosition[0] - m_position[0];
+    const double dy = bodyFixedPosition[1] - m_position[1];
+    const double dz = bodyFixedPosition[2] - m_position[2];
+
+    enu[0] = m_east[0] * dx + m_east[1] * dy;
+    enu[1] = m_north[0] * dx + m_north[1] * dy + m_north[2] * dz;
+    enu[2] = m_up[0] * dx + m_up[1] * dy + m_up[2] * dz;
+}
+
+double IO::Astrodynamics::Sites::TopocentricFrame::GetSinElevation(const double bodyFixedPosition[3]) const
+{
+    const double dx = bodyFixedPosition[0] - m_position[0];
+    const double dy = bodyFixedPosition[1] - m_position[1];
+    const double dz = bodyFixedPosition[2] - m_position[2];
+
+    return (m_up[0] * dx + m_up[1] * dy + m_up[2] * dz) / std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+void IO::Astrodynamics::Sites::TopocentricFrame::GetHorizontalCoordinates(const double bodyFixedPosition[3], double &azimuth, double &elevation,
+                                                                          double &range) const
+{
+    double enu[3];
+    ToTopocentric(bodyFixedPosition, enu);
+    range = std::sqrt(enu[0] * enu[0] + enu[1] * enu[1] + enu[2] * enu[2]);
+    elevation = std::asin(enu[2] / range);
+    azimuth = std::atan2(enu[0], enu[1]);
+    if (azimuth < 0.0)
+    {
+        azimuth += IO::Astrodynamics::Constants::_2PI;
+    }
+}
+
+void IO::Astrodynamics::Sites::TopocentricFrame::Rotate(const double bodyFixedVector[3], double enu[3]) const
+{
+    enu[0] = m_east[0] * bodyFixedVector[0] + m_east[1] * bodyFixedVector[1];
+    enu[1] = m_north[0] * bodyFixedVector[0] + m_north[1] * bodyFixedVector[1] + m_north[2] * bodyFixedVector[2];
+    enu[2] = m_up[0] * bodyFixedVector[0] + m_up[1] * bodyFixedVector[1] + m_up[2] * bodyFixedVector[2];
+}
+
+void IO::Astrodynamics::Sites::TopocentricFrame::GetHorizontalStates(const double relativeState[6], double &azimuth, double &elevation, double &range,
+                                                                     double &azimuthRate, double &elevationRate, double &rangeRate) const
+{
+    double p[3], v[3];
+    Rotate(relativeState, p);
+    Rotate(relativeState + 3, v);
+
+    const double horizontal2 = p[0] * p[0] + p[1] * p[1];
+    const double horizontal = std::sqrt(horizontal2);
+    range = std::sqrt(horizontal2 + p[2] * p[2]);
+    rangeRate = (p[0] * v[0] + p[1] * v[1] + p[2] * v[2]) / range;
+
+    elevation = std::atan2(p[2], horizontal);
+    azimuth = std::atan2(p[0], p[1]);
+    if (azimuth < 0.0)
+    {
+        azimuth += IO::Astrodynamics::Constants::_2PI;
+    }
+
+    //Rates are undefined at zenith
+    if (horizontal > 0.0)
+    {
+        const double horizontalRate = (p[0] * v[0] + p[1] * v[1]) / horizontal;
+        azimuthRate = (p[1] * v[0] - p[0] * v[1]) / horizontal2;
+        elevationRate = (horizontal * v[2] - p[2] * horizontalRate) / (range * range);
+    } else
+    {
+        azimuthRate = 0.0;
+        elevationRate = 0.0;
+    }
+}
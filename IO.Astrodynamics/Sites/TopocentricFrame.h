@@ -0,0 +1,118 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_TOPOCENTRICFRAME_H
+#define IO_TOPOCENTRICFRAME_H
+
+#include <array>
+
+#include <Planetodetic.h>
+
+namespace IO::Astrodynamics::Sites
+{
+    /**
+     * @brief Local east, north, up frame of a surface location expressed in its body fixed frame.
+     * Rotation is computed once and reused for every evaluation.
+     */
+    class TopocentricFrame final
+    {
+    private:
+        std::array<double, 3> m_position{};
+        std::array<double, 3> m_east{};
+        std::array<double, 3> m_north{};
+        std::array<double, 3> m_up{};
+
+    public:
+        /**
+         * @brief Construct a new Topocentric Frame
+         *
+         * @param coordinates Planetodetic coordinates (altitude in m)
+         * @param equatorialRadius Body equatorial radius (m)
+         * @param flattening Body flattening
+         */
+        TopocentricFrame(const IO::Astrodynamics::Coordinates::Planetodetic &coordinates, double equatorialRadius, double flattening);
+
+        /**
+         * @brief Get the location in body fixed frame (m)
+         *
+         * @return const std::array<double, 3>&
+         */
+        [[nodiscard]] inline const std::array<double, 3> &GetPosition() const
+        { return m_position; }
+
+        /**
+         * @brief Get the local up unit vector in body fixed frame
+         *
+         * @return const std::array<double, 3>&
+         */
+        [[nodiscard]] inline const std::array<double, 3> &GetUp() const
+        { return m_up; }
+
+        /**
+         * @brief Get the local east unit vector in body fixed frame
+         *
+         * @return const std::array<double, 3>&
+         */
+        [[nodiscard]] inline const std::array<double, 3> &GetEast() const
+        { return m_east; }
+
+        /**
+         * @brief Get the local north unit vector in body fixed frame
+         *
+         * @return const std::array<double, 3>&
+         */
+        [[nodiscard]] inline const std::array<double, 3> &GetNorth() const
+        { return m_north; }
+
+        /**
+         * @brief Convert a body fixed position into east, north, up components relative to the location
+         *
+         * @param bodyFixedPosition Target position in body fixed frame (m)
+         * @param enu East, north, up components (m)
+         */
+        void ToTopocentric(const double bodyFixedPosition[3], double enu[3]) const;
+
+        /**
+         * @brief Get the sine of the elevation of a body fixed position
+         *
+         * @param bodyFixedPosition Target position in body fixed frame (m)
+         * @return double
+         */
+        [[nodiscard]] double GetSinElevation(const double bodyFixedPosition[3]) const;
+
+        /**
+         * @brief Get azimuth (clockwise from north), elevation and range of a body fixed position
+         *
+         * @param bodyFixedPosition Target position in body fixed frame (m)
+         * @param azimuth
+         * @param elevation
+         * @param range
+         */
+        void GetHorizontalCoordinates(const double bodyFixedPosition[3], double &azimuth, double &elevation, double &range) const;
+
+        /**
+         * @brief Rotate a body fixed vector into east, north, up components
+         *
+         * @param bodyFixedVector
+         * @param enu
+         */
+        void Rotate(const double bodyFixedVector[3], double enu[3]) const;
+
+        /**
+         * @brief Get azimuth, elevation, range and their time derivatives of a target
+         *
+         * @param relativeState Target position (m) and velocity (m/s) relative to the location in body fixed frame
+         * @param azimuth
+         * @param elevation
+         * @param range
+         * @param azimuthRate
+         * @param elevationRate
+         * @param rangeRate
+         */
+        void GetHorizontalStates(const double relativeState[6], double &azimuth, double &elevation, double &range, double &azimuthRate, double &elevationRate,
+                                 double &rangeRate) const;
+    };
+}
+
+#endif //IO_TOPOCENTRICFRAME_H
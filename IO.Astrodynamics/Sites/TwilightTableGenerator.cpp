@@ -0,0 +1,242 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <TwilightTableGenerator.h>
+
+#include <cmath>
+#include <limits>
+
+#include <InvalidArgumentException.h>
+#include <SpiceUsr.h>
+
+IO::Astrodynamics::Sites::TwilightTableGenerator::TwilightTableGenerator(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> body,
+                                                                         const std::vector<IO::Astrodynamics::Coordinates::Planetodetic> &sites) : m_body{
+        std::move(body)}
+{
+    if (!m_body)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Body must be defined");
+    }
+
+    auto radius = m_body->GetRadius();
+    const double flattening = (radius.GetX() - radius.GetZ()) / radius.GetX();
+    m_frames.reserve(sites.size());
+    for (const auto &site: sites)
+    {
+        m_frames.emplace_back(site, radius.GetX(), flattening);
+    }
+}
+
+IO::Astrodynamics::Sites::TwilightTable
+IO::Astrodynamics::Sites::TwilightTableGenerator::Generate(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                           const std::vector<double> &thresholds, IO::Astrodynamics::AberrationsEnum aberration,
+                                                           const IO::Astrodynamics::Time::TimeSpan &gridStep, const IO::Astrodynamics::Time::TimeSpan &accuracy) const
+{
+    if (thresholds.empty())
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("At least one threshold must be defined");
+    }
+
+    const double step = gridStep.GetSeconds().count();
+    if (step <= 0.0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Grid step must be a positive number");
+    }
+
+    const double start = searchWindow.GetStartDate().GetSecondsFromJ2000().count();
+    const double end = searchWindow.GetEndDate().GetSecondsFromJ2000().count();
+    const double tolerance = accuracy.GetSeconds().count();
+
+    //Shared sun states in body fixed frame
+    std::vector<double> epochs;
+    for (std::size_t i = 0;; ++i)
+    {
+        epochs.push_back(std::min(start + static_cast<double>(i) * step, end));
+        if (epochs.back() >= end)
+        {
+            break;
+        }
+    }
+
+    const std::size_t nodeCount = epochs.size();
+    std::vector<double> positions(nodeCount * 3);
+    std::vector<double> velocities(nodeCount * 3);
+    const std::string bodyId{std::to_string(m_body->GetId())};
+    const std::string frame{m_body->GetBodyFixedFrame().GetName()};
+    const std::string abcorr{IO::Astrodynamics::Aberrations::ToString(aberration)};
+    SpiceDouble state[6];
+    SpiceDouble lt;
+    for (std::size_t i = 0; i < nodeCount; ++i)
+    {
+        spkezr_c("10", epochs[i], frame.c_str(), abcorr.c_str(), bodyId.c_str(), state, &lt);
+        for (int k = 0; k < 3; ++k)
+        {
+            positions[i * 3 + k] = state[k] * 1E+03;
+            velocities[i * 3 + k] = state[k + 3] * 1E+03;
+        }
+    }
+
+    //Cubic Hermite interpolation of the sun position and velocity inside grid interval
+    auto interpolate = [&](std::size_t interval, double epoch, double *position, double *velocity)
+    {
+        const double h = epochs[interval + 1] - epochs[interval];
+        const double s = (epoch - epochs[interval]) / h;
+        const double s2 = s * s;
+        const double s3 = s2 * s;
+        const double h00 = 2.0 * s3 - 3.0 * s2 + 1.0, h10 = s3 - 2.0 * s2 + s, h01 = -2.0 * s3 + 3.0 * s2, h11 = s3 - s2;
+        const double d00 = 6.0 * s2 - 6.0 * s, d10 = 3.0 * s2 - 4.0 * s + 1.0, d01 = -6.0 * s2 + 6.0 * s, d11 = 3.0 * s2 - 2.0 * s;
+        const double *p0 = positions.data() + interval * 3, *p1 = p0 + 3;
+        const double *v0 = velocities.data() + interval * 3, *v1 = v0 + 3;
+        for (int k = 0; k < 3; ++k)
+        {
+            position[k] = h00 * p0[k] + h10 * h * v0[k] + h01 * p1[k] + h11 * h * v1[k];
+            velocity[k] = (d00 * p0[k] + d10 * h * v0[k] + d01 * p1[k] + d11 * h * v1[k]) / h;
+        }
+    };
+
+    TwilightTable table;
+    table.SiteCount = m_frames.size();
+    table.ThresholdCount = thresholds.size();
+    table.Thresholds = thresholds;
+    table.Windows.resize(table.SiteCount * table.ThresholdCount);
+
+    std::vector<double> sinElevations(nodeCount);
+    std::vector<double> rates(nodeCount);
+    for (std::size_t j = 0; j < m_frames.size(); ++j)
+    {
+        const auto &site = m_frames[j];
+        const auto &up = site.GetUp();
+        const auto &location = site.GetPosition();
+
+        //Sine of the sun elevation and its time derivative
+        auto evaluate = [&](const double *position, const double *velocity, double &sinElevation, double &rate)
+        {
+            const double d[3]{position[0] - location[0], position[1] - location[1], position[2] - location[2]};
+            const double r = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+            const double upD = up[0] * d[0] + up[1] * d[1] + up[2] * d[2];
+            const double upV = up[0] * velocity[0] + up[1] * velocity[1] + up[2] * velocity[2];
+            const double dV = d[0] * velocity[0] + d[1] * velocity[1] + d[2] * velocity[2];
+            sinElevation = upD / r;
+            rate = upV / r - upD * dV / (r * r * r);
+        };
+
+        auto evaluateAt = [&](std::size_t interval, double epoch, double &sinElevation, double &rate)
+        {
+            double position[3], velocity[3];
+            interpolate(interval, epoch, position, velocity);
+            evaluate(position, velocity, sinElevation, rate);
+        };
+
+        for (std::size_t i = 0; i < nodeCount; ++i)
+        {
+            evaluate(positions.data() + i * 3, velocities.data() + i * 3, sinElevations[i], rates[i]);
+        }
+
+        //Root of sin(elevation) - target in [a, b], initial guess from the linear interpolation then refined by Illinois method
+        auto solve = [&](std::size_t interval, double a, double b, double fa, double fb, double target)
+        {
+            int side = 0;
+            double value{}, rate{};
+            double c = b;
+            for (int iteration = 0; iteration < 100 && std::abs(b - a) > tolerance; ++iteration)
+            {
+                c = (a * fb - b * fa) / (fb - fa);
+                evaluateAt(interval, c, value, rate);
+                const double fc = value - target;
+                if (fc == 0.0)
+                {
+                    break;
+                }
+                if ((fc > 0.0) == (fb > 0.0))
+                {
+                    b = c;
+                    fb = fc;
+                    if (side == -1)
+                    {
+                        fa *= 0.5;
+                    }
+                    side = -1;
+                } else
+                {
+                    a = c;
+                    fa = fc;
+                    if (side == 1)
+                    {
+                        fb *= 0.5;
+                    }
+                    side = 1;
+                }
+            }
+            return c;
+        };
+
+        //Sun elevation extremum in [a, b] by bisection on the elevation rate
+        auto extremum = [&](std::size_t interval, double a, double b, double ra)
+        {
+            double value{}, rate{};
+            while (b - a > tolerance)
+            {
+                const double m = (a + b) * 0.5;
+                evaluateAt(interval, m, value, rate);
+                if ((rate > 0.0) == (ra > 0.0))
+                {
+                    a = m;
+                } else
+                {
+                    b = m;
+                }
+            }
+            return (a + b) * 0.5;
+        };
+
+        for (std::size_t k = 0; k < thresholds.size(); ++k)
+        {
+            const double target = std::sin(thresholds[k]);
+            auto &windows = table.Windows[j * table.ThresholdCount + k];
+            double windowStart = sinElevations[0] > target ? start : std::numeric_limits<double>::quiet_NaN();
+
+            auto toggle = [&](double epoch)
+            {
+                if (std::isnan(windowStart))
+                {
+                    windowStart = epoch;
+                } else
+                {
+                    windows.emplace_back(IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(windowStart)),
+                                         IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(epoch)));
+                    windowStart = std::numeric_limits<double>::quiet_NaN();
+                }
+            };
+
+            for (std::size_t i = 0; i + 1 < nodeCount; ++i)
+            {
+                const double fa = sinElevations[i] - target;
+                const double fb = sinElevations[i + 1] - target;
+                if ((fa > 0.0) != (fb > 0.0))
+                {
+                    toggle(solve(i, epochs[i], epochs[i + 1], fa, fb, target));
+                } else if (rates[i] * rates[i + 1] < 0.0 && ((rates[i] > 0.0) != (fa > 0.0)))
+                {
+                    //Elevation extremum inside the interval moving toward the threshold, sun may graze it near polar day or night
+                    const double tm = extremum(i, epochs[i], epochs[i + 1], rates[i]);
+                    double value{}, rate{};
+                    evaluateAt(i, tm, value, rate);
+                    const double fm = value - target;
+                    if ((fm > 0.0) != (fa > 0.0))
+                    {
+                        toggle(solve(i, epochs[i], tm, fa, fm, target));
+                        toggle(solve(i, tm, epochs[i + 1], fm, fb, target));
+                    }
+                }
+            }
+
+            if (!std::isnan(windowStart))
+            {
+                toggle(end);
+            }
+        }
+    }
+
+    return table;
+}
@@ -0,0 +1,90 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_TWILIGHTTABLEGENERATOR_H
+#define IO_TWILIGHTTABLEGENERATOR_H
+
+#include <memory>
+#include <vector>
+
+#include <Aberrations.h>
+#include <CelestialBody.h>
+#include <Planetodetic.h>
+#include <TopocentricFrame.h>
+#include <Window.h>
+
+namespace IO::Astrodynamics::Sites
+{
+    /**
+     * @brief Twilight table of many sites for many sun elevation thresholds.
+     * Windows where the sun is above the threshold k for site j are stored at j * ThresholdCount + k.
+     * A window starting at the search start (resp. ending at the search end) has no rise (resp. set) event.
+     * Polar day is a window covering the whole search window, polar night has no window.
+     */
+    struct TwilightTable
+    {
+        std::size_t SiteCount{};
+        std::size_t ThresholdCount{};
+        std::vector<double> Thresholds{};
+        std::vector<std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>> Windows{};
+
+        /**
+         * @brief Get windows where the sun is above a threshold for a site
+         *
+         * @param siteIndex
+         * @param thresholdIndex
+         * @return const std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>&
+         */
+        [[nodiscard]] inline const std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> &
+        GetWindows(std::size_t siteIndex, std::size_t thresholdIndex) const
+        { return Windows[siteIndex * ThresholdCount + thresholdIndex]; }
+    };
+
+    /**
+     * @brief Generate sunrise, sunset and twilight tables for many sites in one pass.
+     * Sun states are read once per grid epoch in the body fixed frame and shared by every site.
+     * Each crossing is bracketed on the grid then refined on a cubic Hermite interpolation of the sun position.
+     */
+    class TwilightTableGenerator final
+    {
+    private:
+        const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_body;
+        std::vector<TopocentricFrame> m_frames;
+
+    public:
+        /**
+         * @brief Construct a new Twilight Table Generator
+         *
+         * @param body Body where sites are located
+         * @param sites Sites coordinates
+         */
+        TwilightTableGenerator(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> body, const std::vector<IO::Astrodynamics::Coordinates::Planetodetic> &sites);
+
+        /**
+         * @brief Generate the twilight table
+         *
+         * @param searchWindow
+         * @param thresholds Sun elevations (rad) ex. Constants::OfficialTwilight, Constants::CivilTwilight, ...
+         * @param aberration
+         * @param gridStep Sun sampling step
+         * @param accuracy Crossing accuracy
+         * @return TwilightTable
+         */
+        [[nodiscard]] TwilightTable Generate(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow, const std::vector<double> &thresholds,
+                                             IO::Astrodynamics::AberrationsEnum aberration = IO::Astrodynamics::AberrationsEnum::CNS,
+                                             const IO::Astrodynamics::Time::TimeSpan &gridStep = IO::Astrodynamics::Time::TimeSpan(std::chrono::duration<double>(600.0)),
+                                             const IO::Astrodynamics::Time::TimeSpan &accuracy = IO::Astrodynamics::Time::TimeSpan(
+                                                     std::chrono::duration<double>(1E-03))) const;
+
+        /**
+         * @brief Get the site count
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] inline std::size_t GetSiteCount() const
+        { return m_frames.size(); }
+    };
+}
+
+#endif //IO_TWILIGHTTABLEGENERATOR_H
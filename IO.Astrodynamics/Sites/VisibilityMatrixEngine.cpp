@@ -0,0 +1,416 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <VisibilityMatrixEngine.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <InvalidArgumentException.h>
+#include <SpiceUsr.h>
+
+std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>>
+IO::Astrodynamics::Sites::VisibilityMatrix::GetWindows(std::size_t siteIndex, std::size_t targetIndex) const
+{
+    auto it = std::lower_bound(Entries.begin(), Entries.end(), std::make_pair(siteIndex, targetIndex), [](const VisibilityEntry &entry, const std::pair<std::size_t, std::size_t> &key)
+    {
+        return entry.SiteIndex < key.first || (entry.SiteIndex == key.first && entry.TargetIndex < key.second);
+    });
+
+    if (it != Entries.end() && it->SiteIndex == siteIndex && it->TargetIndex == targetIndex)
+    {
+        return it->Windows;
+    }
+
+    return {};
+}
+
+IO::Astrodynamics::Sites::VisibilityMatrixEngine::VisibilityMatrixEngine(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> body,
+                                                                         const std::vector<IO::Astrodynamics::Coordinates::Planetodetic> &sites,
+                                                                         const std::vector<ElevationMask> &masks) : m_body{std::move(body)}, m_masks{masks}
+{
+    if (!m_body)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Body must be defined");
+    }
+
+    if (m_masks.empty())
+    {
+        m_masks.resize(sites.size());
+    } else if (m_masks.size() != sites.size())
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("One elevation mask must be defined per site");
+    }
+
+    auto radius = m_body->GetRadius();
+    const double flattening = (radius.GetX() - radius.GetZ()) / radius.GetX();
+    m_frames.reserve(sites.size());
+    for (const auto &site: sites)
+    {
+        m_frames.emplace_back(site, radius.GetX(), flattening);
+    }
+}
+
+IO::Astrodynamics::Sites::VisibilityMatrix
+IO::Astrodynamics::Sites::VisibilityMatrixEngine::Compute(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                          const std::vector<int> &targetIds, IO::Astrodynamics::AberrationsEnum aberration,
+                                                          const IO::Astrodynamics::Time::TimeSpan &gridStep, const IO::Astrodynamics::Time::TimeSpan &accuracy) const
+{
+    VisibilityMatrix matrix;
+    matrix.SiteCount = m_frames.size();
+    matrix.TargetCount = targetIds.size();
+    Search(searchWindow, targetIds, aberration, gridStep, accuracy, matrix.Entries, nullptr);
+
+    std::sort(matrix.Entries.begin(), matrix.Entries.end(), [](const VisibilityEntry &a, const VisibilityEntry &b)
+    {
+        return a.SiteIndex < b.SiteIndex || (a.SiteIndex == b.SiteIndex && a.TargetIndex < b.TargetIndex);
+    });
+
+    return matrix;
+}
+
+IO::Astrodynamics::Sites::PassTable
+IO::Astrodynamics::Sites::VisibilityMatrixEngine::PredictPasses(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                                const std::vector<int> &targetIds, IO::Astrodynamics::AberrationsEnum aberration,
+                                                                const IO::Astrodynamics::Time::TimeSpan &gridStep, const IO::Astrodynamics::Time::TimeSpan &accuracy) const
+{
+    std::vector<VisibilityEntry> entries;
+    std::vector<Pass> passes;
+    Search(searchWindow, targetIds, aberration, gridStep, accuracy, entries, &passes);
+    return PassTable(std::move(passes));
+}
+
+void IO::Astrodynamics::Sites::VisibilityMatrixEngine::Search(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow,
+                                                              const std::vector<int> &targetIds, IO::Astrodynamics::AberrationsEnum aberration,
+                                                              const IO::Astrodynamics::Time::TimeSpan &gridStep, const IO::Astrodynamics::Time::TimeSpan &accuracy,
+                                                              std::vector<VisibilityEntry> &entries, std::vector<Pass> *passes) const
+{
+    const double step = gridStep.GetSeconds().count();
+    if (step <= 0.0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Grid step must be a positive number");
+    }
+
+    const double start = searchWindow.GetStartDate().GetSecondsFromJ2000().count();
+    const double end = searchWindow.GetEndDate().GetSecondsFromJ2000().count();
+    const double tolerance = accuracy.GetSeconds().count();
+
+    std::vector<double> epochs;
+    for (std::size_t i = 0;; ++i)
+    {
+        epochs.push_back(std::min(start + static_cast<double>(i) * step, end));
+        if (epochs.back() >= end)
+        {
+            break;
+        }
+    }
+
+    const std::size_t nodeCount = epochs.size();
+    const std::string bodyId{std::to_string(m_body->GetId())};
+    const std::string frame{m_body->GetBodyFixedFrame().GetName()};
+    const std::string abcorr{IO::Astrodynamics::Aberrations::ToString(aberration)};
+
+    std::vector<double> positions(nodeCount * 3);
+    std::vector<double> velocities(nodeCount * 3);
+    std::vector<double> speeds(nodeCount);
+    std::vector<double> sinElevations(nodeCount);
+    std::vector<double> rates(nodeCount);
+    std::vector<double> rangeRates(nodeCount);
+    std::vector<double> margins(nodeCount);
+    SpiceDouble state[6];
+    SpiceDouble lt;
+
+    for (std::size_t t = 0; t < targetIds.size(); ++t)
+    {
+        //Target states are read once and shared by every site
+        const std::string targetId{std::to_string(targetIds[t])};
+        for (std::size_t i = 0; i < nodeCount; ++i)
+        {
+            spkezr_c(targetId.c_str(), epochs[i], frame.c_str(), abcorr.c_str(), bodyId.c_str(), state, &lt);
+            for (int k = 0; k < 3; ++k)
+            {
+                positions[i * 3 + k] = state[k] * 1E+03;
+                velocities[i * 3 + k] = state[k + 3] * 1E+03;
+            }
+            speeds[i] = std::sqrt(velocities[i * 3] * velocities[i * 3] + velocities[i * 3 + 1] * velocities[i * 3 + 1] + velocities[i * 3 + 2] * velocities[i * 3 + 2]);
+        }
+
+        //Cubic Hermite interpolation of the target position and velocity inside grid interval
+        auto interpolate = [&](std::size_t interval, double epoch, double *position, double *velocity)
+        {
+            const double h = epochs[interval + 1] - epochs[interval];
+            const double s = (epoch - epochs[interval]) / h;
+            const double s2 = s * s;
+            const double s3 = s2 * s;
+            const double h00 = 2.0 * s3 - 3.0 * s2 + 1.0, h10 = s3 - 2.0 * s2 + s, h01 = -2.0 * s3 + 3.0 * s2, h11 = s3 - s2;
+            const double d00 = 6.0 * s2 - 6.0 * s, d10 = 3.0 * s2 - 4.0 * s + 1.0, d01 = -6.0 * s2 + 6.0 * s, d11 = 3.0 * s2 - 2.0 * s;
+            const double *p0 = positions.data() + interval * 3, *p1 = p0 + 3;
+            const double *v0 = velocities.data() + interval * 3, *v1 = v0 + 3;
+            for (int k = 0; k < 3; ++k)
+            {
+                position[k] = h00 * p0[k] + h10 * h * v0[k] + h01 * p1[k] + h11 * h * v1[k];
+                velocity[k] = (d00 * p0[k] + d10 * h * v0[k] + d01 * p1[k] + d11 * h * v1[k]) / h;
+            }
+        };
+
+        for (std::size_t j = 0; j < m_frames.size(); ++j)
+        {
+            const auto &site = m_frames[j];
+            const auto &mask = m_masks[j];
+            const auto &up = site.GetUp();
+            const auto &location = site.GetPosition();
+            const double sinMinimum = std::sin(mask.GetMinimum());
+
+            //Sine of the elevation, its time derivative and the range rate, returns the range
+            auto evaluate = [&](const double *position, const double *velocity, double &sinElevation, double &rate, double &rangeRate)
+            {
+                const double d[3]{position[0] - location[0], position[1] - location[1], position[2] - location[2]};
+                const double r = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+                const double upD = up[0] * d[0] + up[1] * d[1] + up[2] * d[2];
+                const double upV = up[0] * velocity[0] + up[1] * velocity[1] + up[2] * velocity[2];
+                const double dV = d[0] * velocity[0] + d[1] * velocity[1] + d[2] * velocity[2];
+                sinElevation = upD / r;
+                rate = upV / r - upD * dV / (r * r * r);
+                rangeRate = dV / r;
+                return r;
+            };
+
+            //Elevation above mask
+            auto function = [&](const double *position)
+            {
+                double azimuth, elevation, range;
+                site.GetHorizontalCoordinates(position, azimuth, elevation, range);
+                return elevation - mask.GetElevation(azimuth);
+            };
+
+            auto functionAt = [&](std::size_t interval, double epoch)
+            {
+                double position[3], velocity[3];
+                interpolate(interval, epoch, position, velocity);
+                return function(position);
+            };
+
+            auto rateAt = [&](std::size_t interval, double epoch)
+            {
+                double position[3], velocity[3], sinElevation, rate, rangeRate;
+                interpolate(interval, epoch, position, velocity);
+                evaluate(position, velocity, sinElevation, rate, rangeRate);
+                return rate;
+            };
+
+            auto rangeRateAt = [&](std::size_t interval, double epoch)
+            {
+                double position[3], velocity[3], sinElevation, rate, rangeRate;
+                interpolate(interval, epoch, position, velocity);
+                evaluate(position, velocity, sinElevation, rate, rangeRate);
+                return rangeRate;
+            };
+
+            for (std::size_t i = 0; i < nodeCount; ++i)
+            {
+                const double range = evaluate(positions.data() + i * 3, velocities.data() + i * 3, sinElevations[i], rates[i], rangeRates[i]);
+
+                //Upper bound of the sine of elevation in the next interval from the target displacement bound
+                const double displacement = i + 1 < nodeCount ? 1.05 * std::max(speeds[i], speeds[i + 1]) * (epochs[i + 1] - epochs[i]) : 0.0;
+                const double height = sinElevations[i] * range + displacement;
+                if (range <= displacement)
+                {
+                    margins[i] = 1.0;
+                } else
+                {
+                    margins[i] = height >= 0.0 ? height / (range - displacement) : height / (range + displacement);
+                }
+            }
+
+            //Root of the elevation above mask in [a, b] by Illinois method
+            auto solve = [&](std::size_t interval, double a, double b, double fa, double fb)
+            {
+                int side = 0;
+                double c = b;
+                for (int iteration = 0; iteration < 100 && std::abs(b - a) > tolerance; ++iteration)
+                {
+                    c = (a * fb - b * fa) / (fb - fa);
+                    const double fc = functionAt(interval, c);
+                    if (fc == 0.0)
+                    {
+                        break;
+                    }
+                    if ((fc > 0.0) == (fb > 0.0))
+                    {
+                        b = c;
+                        fb = fc;
+                        if (side == -1)
+                        {
+                            fa *= 0.5;
+                        }
+                        side = -1;
+                    } else
+                    {
+                        a = c;
+                        fa = fc;
+                        if (side == 1)
+                        {
+                            fb *= 0.5;
+                        }
+                        side = 1;
+                    }
+                }
+                return c;
+            };
+
+            //Extremum in [a, b] by bisection on a rate
+            auto extremum = [&](std::size_t interval, double a, double b, double ra, const auto &rateFunction)
+            {
+                while (b - a > tolerance)
+                {
+                    const double m = (a + b) * 0.5;
+                    if ((rateFunction(interval, m) > 0.0) == (ra > 0.0))
+                    {
+                        a = m;
+                    } else
+                    {
+                        b = m;
+                    }
+                }
+                return (a + b) * 0.5;
+            };
+
+            std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> windows;
+            double fa = function(positions.data());
+            double windowStart = fa > 0.0 ? start : std::numeric_limits<double>::quiet_NaN();
+
+            auto toggle = [&](double epoch)
+            {
+                if (std::isnan(windowStart))
+                {
+                    windowStart = epoch;
+                } else
+                {
+                    windows.emplace_back(IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(windowStart)),
+                                         IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(epoch)));
+                    windowStart = std::numeric_limits<double>::quiet_NaN();
+                }
+            };
+
+            bool isKnown = true;
+            for (std::size_t i = 0; i + 1 < nodeCount; ++i)
+            {
+                //Target can't reach the lowest mask elevation during this interval
+                if (margins[i] < sinMinimum)
+                {
+                    isKnown = false;
+                    continue;
+                }
+
+                if (!isKnown)
+                {
+                    fa = function(positions.data() + i * 3);
+                }
+                const double fb = function(positions.data() + (i + 1) * 3);
+                isKnown = true;
+
+                if ((fa > 0.0) != (fb > 0.0))
+                {
+                    toggle(solve(i, epochs[i], epochs[i + 1], fa, fb));
+                } else if (rates[i] * rates[i + 1] < 0.0 && ((rates[i] > 0.0) != (fa > 0.0)))
+                {
+                    //Elevation extremum inside the interval moving toward the mask, short pass or short masking
+                    const double tm = extremum(i, epochs[i], epochs[i + 1], rates[i], rateAt);
+                    const double fm = functionAt(i, tm);
+                    if ((fm > 0.0) != (fa > 0.0))
+                    {
+                        toggle(solve(i, epochs[i], tm, fa, fm));
+                        toggle(solve(i, tm, epochs[i + 1], fm, fb));
+                    }
+                }
+                fa = fb;
+            }
+
+            if (!std::isnan(windowStart))
+            {
+                toggle(end);
+            }
+
+            if (windows.empty())
+            {
+                continue;
+            }
+
+            //Pass characterization reuses target states of the window search
+            if (passes && nodeCount > 1)
+            {
+                auto locate = [&](double epoch)
+                {
+                    return std::min(static_cast<std::size_t>(std::max(epoch - start, 0.0) / step), nodeCount - 2);
+                };
+
+                auto horizontalAt = [&](double epoch, double &azimuth, double &elevation, double &range)
+                {
+                    double position[3], velocity[3];
+                    interpolate(locate(epoch), epoch, position, velocity);
+                    site.GetHorizontalCoordinates(position, azimuth, elevation, range);
+                };
+
+                for (const auto &window: windows)
+                {
+                    Pass pass;
+                    pass.SiteIndex = j;
+                    pass.TargetId = targetIds[t];
+                    pass.AOS = window.GetStartDate();
+                    pass.LOS = window.GetEndDate();
+
+                    const double a = window.GetStartDate().GetSecondsFromJ2000().count();
+                    const double b = window.GetEndDate().GetSecondsFromJ2000().count();
+                    double azimuth, elevation, range;
+                    horizontalAt(a, pass.AOSAzimuth, pass.MaxElevation, pass.MinRange);
+                    horizontalAt(b, pass.LOSAzimuth, elevation, range);
+                    double maxElevationEpoch = a, tca = a;
+                    if (elevation > pass.MaxElevation)
+                    {
+                        pass.MaxElevation = elevation;
+                        maxElevationEpoch = b;
+                    }
+                    if (range < pass.MinRange)
+                    {
+                        pass.MinRange = range;
+                        tca = b;
+                    }
+
+                    //Elevation maximums and range minimums inside the pass
+                    for (std::size_t i = locate(a); i <= locate(b); ++i)
+                    {
+                        if (rates[i] > 0.0 && rates[i + 1] <= 0.0)
+                        {
+                            const double tm = std::clamp(extremum(i, epochs[i], epochs[i + 1], rates[i], rateAt), a, b);
+                            horizontalAt(tm, azimuth, elevation, range);
+                            if (elevation > pass.MaxElevation)
+                            {
+                                pass.MaxElevation = elevation;
+                                maxElevationEpoch = tm;
+                            }
+                        }
+
+                        if (rangeRates[i] < 0.0 && rangeRates[i + 1] >= 0.0)
+                        {
+                            const double tm = std::clamp(extremum(i, epochs[i], epochs[i + 1], rangeRates[i], rangeRateAt), a, b);
+                            horizontalAt(tm, azimuth, elevation, range);
+                            if (range < pass.MinRange)
+                            {
+                                pass.MinRange = range;
+                                tca = tm;
+                            }
+                        }
+                    }
+
+                    pass.MaxElevationEpoch = IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(maxElevationEpoch));
+                    pass.TCA = IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(tca));
+                    passes->push_back(pass);
+                }
+            }
+
+            entries.push_back(VisibilityEntry{j, t, std::move(windows)});
+        }
+    }
+}
@@ -0,0 +1,122 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_VISIBILITYMATRIXENGINE_H
+#define IO_VISIBILITYMATRIXENGINE_H
+
+#include <memory>
+#include <vector>
+
+#include <Aberrations.h>
+#include <CelestialBody.h>
+#include <ElevationMask.h>
+#include <PassTable.h>
+#include <Planetodetic.h>
+#include <TopocentricFrame.h>
+#include <Window.h>
+
+namespace IO::Astrodynamics::Sites
+{
+    /**
+     * @brief Visibility windows of one target from one site
+     */
+    struct VisibilityEntry
+    {
+        std::size_t SiteIndex{};
+        std::size_t TargetIndex{};
+        std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> Windows{};
+    };
+
+    /**
+     * @brief Sparse site x target visibility matrix.
+     * Only pairs with at least one window are stored, sorted by site then target.
+     */
+    struct VisibilityMatrix
+    {
+        std::size_t SiteCount{};
+        std::size_t TargetCount{};
+        std::vector<VisibilityEntry> Entries{};
+
+        /**
+         * @brief Get visibility windows of a target from a site
+         *
+         * @param siteIndex
+         * @param targetIndex
+         * @return std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> Empty if target is never visible
+         */
+        [[nodiscard]] std::vector<IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB>> GetWindows(std::size_t siteIndex, std::size_t targetIndex) const;
+    };
+
+    /**
+     * @brief Compute visibility windows of many targets from many sites in one pass.
+     * Each target state is read once per grid epoch in the body fixed frame, then projected in each site topocentric frame.
+     * Grid intervals which can't reach the site mask are rejected by a bound on the target displacement, remaining crossings
+     * are refined on a cubic Hermite interpolation of the target position.
+     */
+    class VisibilityMatrixEngine final
+    {
+    private:
+        const std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> m_body;
+        std::vector<TopocentricFrame> m_frames;
+        std::vector<ElevationMask> m_masks;
+
+        void Search(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow, const std::vector<int> &targetIds,
+                    IO::Astrodynamics::AberrationsEnum aberration, const IO::Astrodynamics::Time::TimeSpan &gridStep,
+                    const IO::Astrodynamics::Time::TimeSpan &accuracy, std::vector<VisibilityEntry> &entries, std::vector<Pass> *passes) const;
+
+    public:
+        /**
+         * @brief Construct a new Visibility Matrix Engine
+         *
+         * @param body Body where sites are located
+         * @param sites Sites coordinates
+         * @param masks Elevation mask of each site, geometric horizon is used when empty
+         */
+        VisibilityMatrixEngine(std::shared_ptr<IO::Astrodynamics::Body::CelestialBody> body, const std::vector<IO::Astrodynamics::Coordinates::Planetodetic> &sites,
+                               const std::vector<ElevationMask> &masks = {});
+
+        /**
+         * @brief Compute the visibility matrix
+         *
+         * @param searchWindow
+         * @param targetIds Naif identifiers of targets
+         * @param aberration Aberration applied on target states seen from the body center
+         * @param gridStep Target sampling step, must be lower than the shortest visibility to detect
+         * @param accuracy Crossing accuracy
+         * @return VisibilityMatrix
+         */
+        [[nodiscard]] VisibilityMatrix Compute(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow, const std::vector<int> &targetIds,
+                                               IO::Astrodynamics::AberrationsEnum aberration = IO::Astrodynamics::AberrationsEnum::None,
+                                               const IO::Astrodynamics::Time::TimeSpan &gridStep = IO::Astrodynamics::Time::TimeSpan(std::chrono::duration<double>(60.0)),
+                                               const IO::Astrodynamics::Time::TimeSpan &accuracy = IO::Astrodynamics::Time::TimeSpan(
+                                                       std::chrono::duration<double>(1E-03))) const;
+
+        /**
+         * @brief Predict passes of targets over sites in the same sweep as the visibility search.
+         * Maximum elevation and closest approach are refined by extremum search on the interpolated target states.
+         *
+         * @param searchWindow
+         * @param targetIds Naif identifiers of targets
+         * @param aberration Aberration applied on target states seen from the body center
+         * @param gridStep Target sampling step, must be lower than the shortest pass to detect
+         * @param accuracy Events accuracy
+         * @return PassTable
+         */
+        [[nodiscard]] PassTable PredictPasses(const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &searchWindow, const std::vector<int> &targetIds,
+                                              IO::Astrodynamics::AberrationsEnum aberration = IO::Astrodynamics::AberrationsEnum::None,
+                                              const IO::Astrodynamics::Time::TimeSpan &gridStep = IO::Astrodynamics::Time::TimeSpan(std::chrono::duration<double>(60.0)),
+                                              const IO::Astrodynamics::Time::TimeSpan &accuracy = IO::Astrodynamics::Time::TimeSpan(
+                                                      std::chrono::duration<double>(1E-03))) const;
+
+        /**
+         * @brief Get the site count
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] inline std::size_t GetSiteCount() const
+        { return m_frames.size(); }
+    };
+}
+
+#endif //IO_VISIBILITYMATRIXENGINE_H
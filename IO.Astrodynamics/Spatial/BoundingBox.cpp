@@ -0,0 +1,82 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <BoundingBox.h>
+
+#include <algorithm>
+#include <cmath>
+
+bool IO::Astrodynamics::Spatial::BoundingBox::IsEmpty() const
+{
+    return Min[0] > Max[0] || Min[1] > Max[1] || Min[2] > Max[2];
+}
+
+void IO::Astrodynamics::Spatial::BoundingBox::Extend(const double point[3])
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        Min[i] = std::min(Min[i], point[i]);
+        Max[i] = std::max(Max[i], point[i]);
+    }
+}
+
+void IO::Astrodynamics::Spatial::BoundingBox::Extend(const BoundingBox &box)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        Min[i] = std::min(Min[i], box.Min[i]);
+        Max[i] = std::max(Max[i], box.Max[i]);
+    }
+}
+
+void IO::Astrodynamics::Spatial::BoundingBox::Inflate(double margin)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        Min[i] -= margin;
+        Max[i] += margin;
+    }
+}
+
+double IO::Astrodynamics::Spatial::BoundingBox::GetDistanceSquared(const double point[3]) const
+{
+    double distance{};
+    for (int i = 0; i < 3; ++i)
+    {
+        const double delta = std::max({Min[i] - point[i], 0.0, point[i] - Max[i]});
+        distance += delta * delta;
+    }
+    return distance;
+}
+
+double IO::Astrodynamics::Spatial::BoundingBox::GetHalfDiagonal() const
+{
+    const double x = Max[0] - Min[0];
+    const double y = Max[1] - Min[1];
+    const double z = Max[2] - Min[2];
+    return 0.5 * std::sqrt(x * x + y * y + z * z);
+}
+
+int IO::Astrodynamics::Spatial::BoundingBox::GetLongestAxis() const
+{
+    const double x = Max[0] - Min[0];
+    const double y = Max[1] - Min[1];
+    const double z = Max[2] - Min[2];
+    return x >= y ? (x >= z ? 0 : 2) : (y >= z ? 1 : 2);
+}
+
+bool IO::Astrodynamics::Spatial::BoundingBox::MayIntersectCone(const double direction[3], double halfAngle) const
+{
+    const double center[3]{GetCenter(0), GetCenter(1), GetCenter(2)};
+    const double distance = std::sqrt(center[0] * center[0] + center[1] * center[1] + center[2] * center[2]);
+    const double radius = GetHalfDiagonal();
+    if (distance <= radius)
+    {
+        return true;
+    }
+
+    //Angle between the axis and the box center minus the bounding sphere angular radius
+    const double cosAngle = std::clamp((center[0] * direction[0] + center[1] * direction[1] + center[2] * direction[2]) / distance, -1.0, 1.0);
+    return std::acos(cosAngle) - std::asin(radius / distance) <= halfAngle;
+}
@@ -0,0 +1,93 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_BOUNDINGBOX_H
+#define IO_BOUNDINGBOX_H
+
+#include <limits>
+
+namespace IO::Astrodynamics::Spatial
+{
+    /**
+     * @brief Axis aligned bounding box (m)
+     */
+    struct BoundingBox
+    {
+        double Min[3]{std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+        double Max[3]{std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+
+        /**
+         * @brief Check if the box doesn't contain any point
+         *
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool IsEmpty() const;
+
+        /**
+         * @brief Extend the box to contain a point
+         *
+         * @param point
+         */
+        void Extend(const double point[3]);
+
+        /**
+         * @brief Extend the box to contain another box
+         *
+         * @param box
+         */
+        void Extend(const BoundingBox &box);
+
+        /**
+         * @brief Grow the box in every direction
+         *
+         * @param margin (m)
+         */
+        void Inflate(double margin);
+
+        /**
+         * @brief Get the squared distance from a point to the box, 0 when the point is inside
+         *
+         * @param point
+         * @return double (m^2)
+         */
+        [[nodiscard]] double GetDistanceSquared(const double point[3]) const;
+
+        /**
+         * @brief Get the center coordinate along an axis
+         *
+         * @param axis
+         * @return double
+         */
+        [[nodiscard]] inline double GetCenter(int axis) const
+        { return 0.5 * (Min[axis] + Max[axis]); }
+
+        /**
+         * @brief Get the half length of the diagonal
+         *
+         * @return double (m)
+         */
+        [[nodiscard]] double GetHalfDiagonal() const;
+
+        /**
+         * @brief Get the axis with the largest extent
+         *
+         * @return int
+         */
+        [[nodiscard]] int GetLongestAxis() const;
+
+        /**
+         * @brief Check if the box may intersect a cone with its apex at the origin.
+         * The test is conservative, the box is replaced by its bounding sphere.
+         *
+         * @param direction Unit cone axis
+         * @param halfAngle (rad)
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool MayIntersectCone(const double direction[3], double halfAngle) const;
+    };
+}
+
+#endif //IO_BOUNDINGBOX_H
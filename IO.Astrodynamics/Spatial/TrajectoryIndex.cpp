@@ -0,0 +1,661 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#include <TrajectoryIndex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+
+#include <Constants.h>
+#include <InvalidArgumentException.h>
+#include <SpiceUsr.h>
+
+namespace
+{
+    constexpr std::size_t LEAF_SIZE = 4;
+
+    //Sampled speed may be slightly lower than the maximum speed between samples
+    constexpr double SPEED_MARGIN = 1.05;
+
+    //Refinement samples per bounding sample interval
+    constexpr std::size_t REFINEMENT_FACTOR = 4;
+
+    constexpr double ROOT_TOLERANCE = 1E-03;
+
+    //Illinois variant of regula falsi
+    template<typename Function>
+    double FindRoot(const Function &function, double a, double fa, double b, double fb)
+    {
+        int side{};
+        for (int iteration = 0; iteration < 100 && b - a > ROOT_TOLERANCE; ++iteration)
+        {
+            const double c = (a * fb - b * fa) / (fb - fa);
+            const double fc = function(c);
+            if (fc == 0.0)
+            {
+                return c;
+            }
+            if ((fc < 0.0) == (fa < 0.0))
+            {
+                a = c;
+                fa = fc;
+                if (side == -1)
+                {
+                    fb *= 0.5;
+                }
+                side = -1;
+            }
+            else
+            {
+                b = c;
+                fb = fc;
+                if (side == 1)
+                {
+                    fa *= 0.5;
+                }
+                side = 1;
+            }
+        }
+        return 0.5 * (a + b);
+    }
+
+    //Closest approach to a fixed point over an interval, local minima are range rate roots
+    std::pair<double, double> FindClosestApproach(const IO::Astrodynamics::Spatial::TrajectoryFunction &trajectory, const double point[3], double begin, double end,
+                                                  std::size_t steps)
+    {
+        double state[6];
+        auto evaluate = [&](double epoch, double &rangeRate)
+        {
+            trajectory(epoch, state);
+            const double dx = state[0] - point[0];
+            const double dy = state[1] - point[1];
+            const double dz = state[2] - point[2];
+            rangeRate = dx * state[3] + dy * state[4] + dz * state[5];
+            return dx * dx + dy * dy + dz * dz;
+        };
+        auto rangeRate = [&](double epoch)
+        {
+            double rate;
+            evaluate(epoch, rate);
+            return rate;
+        };
+
+        const double step = (end - begin) / static_cast<double>(steps);
+        double bestEpoch{begin};
+        double bestDistance{std::numeric_limits<double>::max()};
+        double previousEpoch{}, previousRate{};
+        for (std::size_t i = 0; i <= steps; ++i)
+        {
+            const double epoch = i == steps ? end : begin + static_cast<double>(i) * step;
+            double rate;
+            double distance = evaluate(epoch, rate);
+            if (distance < bestDistance)
+            {
+                bestDistance = distance;
+                bestEpoch = epoch;
+            }
+            if (i > 0 && previousRate < 0.0 && rate > 0.0)
+            {
+                const double root = FindRoot(rangeRate, previousEpoch, previousRate, epoch, rate);
+                double rootRate;
+                distance = evaluate(root, rootRate);
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    bestEpoch = root;
+                }
+            }
+            previousEpoch = epoch;
+            previousRate = rate;
+        }
+        return {bestEpoch, std::sqrt(bestDistance)};
+    }
+
+    //Intervals when the angle between the position and the region center is below the region radius
+    void FindInsideIntervals(const IO::Astrodynamics::Spatial::TrajectoryFunction &trajectory, const double direction[3], double cosHalfAngle, double begin,
+                             double end, std::size_t steps, std::vector<std::pair<double, double>> &intervals)
+    {
+        double state[6];
+        auto margin = [&](double epoch)
+        {
+            trajectory(epoch, state);
+            const double norm = std::sqrt(state[0] * state[0] + state[1] * state[1] + state[2] * state[2]);
+            if (norm <= 0.0)
+            {
+                return -1.0;
+            }
+            return (state[0] * direction[0] + state[1] * direction[1] + state[2] * direction[2]) / norm - cosHalfAngle;
+        };
+        auto crossing = [&](double low, double lowMargin, double high)
+        {
+            while (high - low > ROOT_TOLERANCE)
+            {
+                const double middle = 0.5 * (low + high);
+                const double middleMargin = margin(middle);
+                if ((middleMargin >= 0.0) == (lowMargin >= 0.0))
+                {
+                    low = middle;
+                    lowMargin = middleMargin;
+                }
+                else
+                {
+                    high = middle;
+                }
+            }
+            return 0.5 * (low + high);
+        };
+
+        const double step = (end - begin) / static_cast<double>(steps);
+        double previousEpoch{begin};
+        double previousMargin = margin(begin);
+        double start{begin};
+        bool isInside = previousMargin >= 0.0;
+        for (std::size_t i = 1; i <= steps; ++i)
+        {
+            const double epoch = i == steps ? end : begin + static_cast<double>(i) * step;
+            const double currentMargin = margin(epoch);
+            if ((currentMargin >= 0.0) != isInside)
+            {
+                const double root = crossing(previousEpoch, previousMargin, epoch);
+                if (isInside)
+                {
+                    intervals.emplace_back(start, root);
+                }
+                else
+                {
+                    start = root;
+                }
+                isInside = !isInside;
+            }
+            previousEpoch = epoch;
+            previousMargin = currentMargin;
+        }
+        if (isInside)
+        {
+            intervals.emplace_back(start, end);
+        }
+    }
+}
+
+IO::Astrodynamics::Spatial::TrajectoryIndex::TrajectoryIndex(const IO::Astrodynamics::Time::TimeSpan &slabDuration, std::size_t samplesPerSlab)
+        : m_slabDuration{slabDuration.GetSeconds().count()}, m_samplesPerSlab{samplesPerSlab}
+{
+    if (m_slabDuration <= 0.0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Slab duration must be a positive duration");
+    }
+    if (m_samplesPerSlab < 2)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Samples per slab must be greater than or equal to 2");
+    }
+}
+
+long long IO::Astrodynamics::Spatial::TrajectoryIndex::GetSlabIndex(double epoch) const
+{
+    return static_cast<long long>(std::floor(epoch / m_slabDuration));
+}
+
+std::vector<std::pair<double, double>> IO::Astrodynamics::Spatial::TrajectoryIndex::GetCoveredIntervals(std::size_t object, double begin, double end) const
+{
+    std::vector<std::pair<double, double>> intervals;
+    for (const auto &coverage: m_objects[object].Coverage)
+    {
+        const double low = std::max(coverage.first, begin);
+        const double high = std::min(coverage.second, end);
+        if (high > low)
+        {
+            intervals.emplace_back(low, high);
+        }
+    }
+    return intervals;
+}
+
+bool IO::Astrodynamics::Spatial::TrajectoryIndex::IsCovered(std::size_t object, double epoch) const
+{
+    const auto &coverage = m_objects[object].Coverage;
+    return std::any_of(coverage.begin(), coverage.end(), [epoch](const auto &interval) { return epoch >= interval.first && epoch <= interval.second; });
+}
+
+void IO::Astrodynamics::Spatial::TrajectoryIndex::UpdateSlab(long long slabIndex, std::size_t object)
+{
+    const double slabBegin = static_cast<double>(slabIndex) * m_slabDuration;
+    const auto intervals = GetCoveredIntervals(object, slabBegin, slabBegin + m_slabDuration);
+
+    auto &slab = m_slabs[slabIndex];
+    slab.Entries.erase(std::remove_if(slab.Entries.begin(), slab.Entries.end(), [object](const Entry &entry) { return entry.Object == object; }),
+                       slab.Entries.end());
+    slab.IsDirty = true;
+    if (intervals.empty())
+    {
+        if (slab.Entries.empty())
+        {
+            m_slabs.erase(slabIndex);
+        }
+        return;
+    }
+
+    //Any point between two samples is closer to one of them than half the step times the maximum speed
+    const auto &trajectory = m_objects[object].Trajectory;
+    Entry entry{object, BoundingBox{}};
+    double margin{};
+    double state[6];
+    for (const auto &interval: intervals)
+    {
+        const double step = (interval.second - interval.first) / static_cast<double>(m_samplesPerSlab - 1);
+        double maximumSpeed{};
+        for (std::size_t i = 0; i < m_samplesPerSlab; ++i)
+        {
+            trajectory(i + 1 == m_samplesPerSlab ? interval.second : interval.first + static_cast<double>(i) * step, state);
+            entry.Box.Extend(state);
+            maximumSpeed = std::max(maximumSpeed, std::sqrt(state[3] * state[3] + state[4] * state[4] + state[5] * state[5]));
+        }
+        margin = std::max(margin, 0.5 * SPEED_MARGIN * maximumSpeed * step);
+    }
+    entry.Box.Inflate(margin);
+    slab.Entries.push_back(entry);
+}
+
+void IO::Astrodynamics::Spatial::TrajectoryIndex::RemoveEntries(long long firstSlab, long long lastSlab, std::size_t object)
+{
+    for (auto it = m_slabs.lower_bound(firstSlab); it != m_slabs.end() && it->first <= lastSlab;)
+    {
+        auto &entries = it->second.Entries;
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [object](const Entry &entry) { return entry.Object == object; }), entries.end());
+        it->second.IsDirty = true;
+        it = entries.empty() ? m_slabs.erase(it) : std::next(it);
+    }
+}
+
+void IO::Astrodynamics::Spatial::TrajectoryIndex::Build(Slab &slab) const
+{
+    slab.Nodes.clear();
+    slab.Nodes.reserve(2 * slab.Entries.size() / LEAF_SIZE + 1);
+    if (!slab.Entries.empty())
+    {
+        BuildNode(slab, 0, slab.Entries.size());
+    }
+    slab.IsDirty = false;
+}
+
+int IO::Astrodynamics::Spatial::TrajectoryIndex::BuildNode(Slab &slab, std::size_t first, std::size_t count) const
+{
+    Node node;
+    BoundingBox centers;
+    for (std::size_t i = first; i < first + count; ++i)
+    {
+        const auto &box = slab.Entries[i].Box;
+        node.Box.Extend(box);
+        const double center[3]{box.GetCenter(0), box.GetCenter(1), box.GetCenter(2)};
+        centers.Extend(center);
+    }
+
+    const int index = static_cast<int>(slab.Nodes.size());
+    slab.Nodes.push_back(node);
+    if (count <= LEAF_SIZE)
+    {
+        slab.Nodes[index].First = first;
+        slab.Nodes[index].Count = count;
+        return index;
+    }
+
+    //Median split along the largest extent of box centers
+    const int axis = centers.GetLongestAxis();
+    const std::size_t half = count / 2;
+    std::nth_element(slab.Entries.begin() + static_cast<std::ptrdiff_t>(first), slab.Entries.begin() + static_cast<std::ptrdiff_t>(first + half),
+                     slab.Entries.begin() + static_cast<std::ptrdiff_t>(first + count),
+                     [axis](const Entry &a, const Entry &b) { return a.Box.GetCenter(axis) < b.Box.GetCenter(axis); });
+    const int left = BuildNode(slab, first, half);
+    const int right = BuildNode(slab, first + half, count - half);
+    slab.Nodes[index].Left = left;
+    slab.Nodes[index].Right = right;
+    return index;
+}
+
+template<typename NodePredicate, typename EntryAction>
+void IO::Astrodynamics::Spatial::TrajectoryIndex::Traverse(const Slab &slab, NodePredicate predicate, EntryAction action) const
+{
+    if (slab.Nodes.empty())
+    {
+        return;
+    }
+
+    std::vector<int> stack{0};
+    while (!stack.empty())
+    {
+        const auto &node = slab.Nodes[stack.back()];
+        stack.pop_back();
+        if (!predicate(node.Box))
+        {
+            continue;
+        }
+        if (node.Left < 0)
+        {
+            for (std::size_t i = node.First; i < node.First + node.Count; ++i)
+            {
+                if (predicate(slab.Entries[i].Box))
+                {
+                    action(slab.Entries[i]);
+                }
+            }
+            continue;
+        }
+        stack.push_back(node.Right);
+        stack.push_back(node.Left);
+    }
+}
+
+void IO::Astrodynamics::Spatial::TrajectoryIndex::Add(int objectId, const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &coverage,
+                                                       TrajectoryFunction trajectory)
+{
+    const double begin = coverage.GetStartDate().GetSecondsFromJ2000().count();
+    const double end = coverage.GetEndDate().GetSecondsFromJ2000().count();
+    if (end <= begin)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Coverage must have a positive length");
+    }
+    if (!trajectory)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Trajectory must be defined");
+    }
+
+    auto found = m_objectIndexes.find(objectId);
+    std::size_t object;
+    if (found == m_objectIndexes.end())
+    {
+        object = m_objects.size();
+        m_objects.push_back(TrackedObject{objectId, nullptr, {}});
+        m_objectIndexes[objectId] = object;
+    }
+    else
+    {
+        object = found->second;
+    }
+
+    //Parts of the new coverage not indexed yet, slabs already bounded from the previous coverage are kept
+    auto &tracked = m_objects[object];
+    std::vector<std::pair<double, double>> added;
+    double uncovered = begin;
+    for (const auto &interval: tracked.Coverage)
+    {
+        if (interval.second <= uncovered)
+        {
+            continue;
+        }
+        if (interval.first >= end)
+        {
+            break;
+        }
+        if (interval.first > uncovered)
+        {
+            added.emplace_back(uncovered, interval.first);
+        }
+        uncovered = interval.second;
+    }
+    if (uncovered < end)
+    {
+        added.emplace_back(uncovered, end);
+    }
+
+    //Merge the new coverage with the previous intervals
+    tracked.Trajectory = std::move(trajectory);
+    tracked.Coverage.emplace_back(begin, end);
+    std::sort(tracked.Coverage.begin(), tracked.Coverage.end());
+    std::vector<std::pair<double, double>> merged;
+    for (const auto &interval: tracked.Coverage)
+    {
+        if (!merged.empty() && interval.first <= merged.back().second)
+        {
+            merged.back().second = std::max(merged.back().second, interval.second);
+        }
+        else
+        {
+            merged.push_back(interval);
+        }
+    }
+    tracked.Coverage = std::move(merged);
+
+    long long lastUpdated = std::numeric_limits<long long>::min();
+    for (const auto &interval: added)
+    {
+        for (long long slabIndex = std::max(GetSlabIndex(interval.first), lastUpdated + 1); slabIndex <= GetSlabIndex(interval.second); ++slabIndex)
+        {
+            UpdateSlab(slabIndex, object);
+            lastUpdated = slabIndex;
+        }
+    }
+}
+
+void IO::Astrodynamics::Spatial::TrajectoryIndex::Add(const IO::Astrodynamics::Kernels::EphemerisKernel &kernel, int centerOfMotionId,
+                                                       const IO::Astrodynamics::Frames::Frames &frame)
+{
+    const int objectId = kernel.GetObjectId();
+    const std::string frameName{frame.ToCharArray()};
+    const TrajectoryFunction trajectory = [objectId, centerOfMotionId, frameName](double epoch, double state[6])
+    {
+        SpiceDouble lt;
+        spkgeo_c(objectId, epoch, frameName.c_str(), centerOfMotionId, state, &lt);
+        for (int i = 0; i < 6; ++i)
+        {
+            state[i] *= 1000.0;
+        }
+    };
+
+    //Each segment interval on its own so that gaps are never sampled, intervals already indexed are skipped
+    for (const auto &window: kernel.GetCoverageWindows())
+    {
+        Add(objectId, window, trajectory);
+    }
+}
+
+bool IO::Astrodynamics::Spatial::TrajectoryIndex::Remove(int objectId)
+{
+    auto found = m_objectIndexes.find(objectId);
+    if (found == m_objectIndexes.end())
+    {
+        return false;
+    }
+
+    const std::size_t object = found->second;
+    for (const auto &interval: m_objects[object].Coverage)
+    {
+        RemoveEntries(GetSlabIndex(interval.first), GetSlabIndex(interval.second), object);
+    }
+    m_objects[object].Trajectory = nullptr;
+    m_objects[object].Coverage.clear();
+    m_objectIndexes.erase(found);
+    return true;
+}
+
+std::vector<IO::Astrodynamics::Spatial::RangeResult>
+IO::Astrodynamics::Spatial::TrajectoryIndex::FindInRange(const double point[3], double radius, const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window)
+{
+    if (radius <= 0.0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Radius must be a positive number");
+    }
+
+    const double begin = window.GetStartDate().GetSecondsFromJ2000().count();
+    const double end = window.GetEndDate().GetSecondsFromJ2000().count();
+    const double squaredRadius = radius * radius;
+    const std::size_t steps = REFINEMENT_FACTOR * (m_samplesPerSlab - 1);
+
+    //Closest approach epoch and distance by object
+    std::unordered_map<std::size_t, std::pair<double, double>> closest;
+    for (auto it = m_slabs.lower_bound(GetSlabIndex(begin)); it != m_slabs.end() && it->first <= GetSlabIndex(end); ++it)
+    {
+        if (it->second.IsDirty)
+        {
+            Build(it->second);
+        }
+        const double slabBegin = static_cast<double>(it->first) * m_slabDuration;
+        Traverse(it->second, [&](const BoundingBox &box) { return box.GetDistanceSquared(point) <= squaredRadius; }, [&](const Entry &entry)
+        {
+            for (const auto &interval: GetCoveredIntervals(entry.Object, std::max(begin, slabBegin), std::min(end, slabBegin + m_slabDuration)))
+            {
+                const auto approach = FindClosestApproach(m_objects[entry.Object].Trajectory, point, interval.first, interval.second, steps);
+                if (approach.second > radius)
+                {
+                    continue;
+                }
+                auto found = closest.find(entry.Object);
+                if (found == closest.end() || approach.second < found->second.second)
+                {
+                    closest[entry.Object] = approach;
+                }
+            }
+        });
+    }
+
+    std::vector<std::pair<double, std::size_t>> sorted;
+    sorted.reserve(closest.size());
+    for (const auto &approach: closest)
+    {
+        sorted.emplace_back(approach.second.second, approach.first);
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    std::vector<RangeResult> results;
+    results.reserve(sorted.size());
+    for (const auto &item: sorted)
+    {
+        results.push_back(RangeResult{m_objects[item.second].Id, IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(closest[item.second].first)), item.first});
+    }
+    return results;
+}
+
+std::vector<IO::Astrodynamics::Spatial::NearestResult>
+IO::Astrodynamics::Spatial::TrajectoryIndex::FindNearest(const double point[3], const IO::Astrodynamics::Time::TDB &epoch, std::size_t count)
+{
+    const double t = epoch.GetSecondsFromJ2000().count();
+    auto found = m_slabs.find(GetSlabIndex(t));
+    if (count == 0 || found == m_slabs.end())
+    {
+        return {};
+    }
+    auto &slab = found->second;
+    if (slab.IsDirty)
+    {
+        Build(slab);
+    }
+
+    //Best first search, nodes are visited by increasing lower bound of the distance
+    using Item = std::pair<double, std::size_t>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<>> nodes;
+    std::priority_queue<Item> best;
+    nodes.emplace(slab.Nodes.front().Box.GetDistanceSquared(point), 0);
+    double state[6];
+    while (!nodes.empty())
+    {
+        const auto [bound, index] = nodes.top();
+        nodes.pop();
+        if (best.size() == count && bound > best.top().first)
+        {
+            break;
+        }
+
+        const auto &node = slab.Nodes[index];
+        if (node.Left >= 0)
+        {
+            nodes.emplace(slab.Nodes[node.Left].Box.GetDistanceSquared(point), node.Left);
+            nodes.emplace(slab.Nodes[node.Right].Box.GetDistanceSquared(point), node.Right);
+            continue;
+        }
+
+        for (std::size_t i = node.First; i < node.First + node.Count; ++i)
+        {
+            const auto &entry = slab.Entries[i];
+            if ((best.size() == count && entry.Box.GetDistanceSquared(point) > best.top().first) || !IsCovered(entry.Object, t))
+            {
+                continue;
+            }
+            m_objects[entry.Object].Trajectory(t, state);
+            const double distance = (state[0] - point[0]) * (state[0] - point[0]) + (state[1] - point[1]) * (state[1] - point[1]) +
+                                    (state[2] - point[2]) * (state[2] - point[2]);
+            if (best.size() < count)
+            {
+                best.emplace(distance, entry.Object);
+            }
+            else if (distance < best.top().first)
+            {
+                best.pop();
+                best.emplace(distance, entry.Object);
+            }
+        }
+    }
+
+    std::vector<NearestResult> results(best.size());
+    for (std::size_t i = results.size(); i-- > 0;)
+    {
+        results[i] = NearestResult{m_objects[best.top().second].Id, std::sqrt(best.top().first)};
+        best.pop();
+    }
+    return results;
+}
+
+std::vector<IO::Astrodynamics::Spatial::OverflightResult>
+IO::Astrodynamics::Spatial::TrajectoryIndex::FindOverflights(const double direction[3], double halfAngle,
+                                                             const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window)
+{
+    const double norm = std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+    if (norm <= 0.0)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Direction must not be a null vector");
+    }
+    if (halfAngle <= 0.0 || halfAngle > IO::Astrodynamics::Constants::PI)
+    {
+        throw IO::Astrodynamics::Exception::InvalidArgumentException("Half angle must be in ]0, PI]");
+    }
+
+    const double axis[3]{direction[0] / norm, direction[1] / norm, direction[2] / norm};
+    const double cosHalfAngle = std::cos(halfAngle);
+    const double begin = window.GetStartDate().GetSecondsFromJ2000().count();
+    const double end = window.GetEndDate().GetSecondsFromJ2000().count();
+    const std::size_t steps = REFINEMENT_FACTOR * (m_samplesPerSlab - 1);
+
+    std::map<int, std::vector<std::pair<double, double>>> intervals;
+    for (auto it = m_slabs.lower_bound(GetSlabIndex(begin)); it != m_slabs.end() && it->first <= GetSlabIndex(end); ++it)
+    {
+        if (it->second.IsDirty)
+        {
+            Build(it->second);
+        }
+        const double slabBegin = static_cast<double>(it->first) * m_slabDuration;
+        Traverse(it->second, [&](const BoundingBox &box) { return box.MayIntersectCone(axis, halfAngle); }, [&](const Entry &entry)
+        {
+            const auto &object = m_objects[entry.Object];
+            for (const auto &interval: GetCoveredIntervals(entry.Object, std::max(begin, slabBegin), std::min(end, slabBegin + m_slabDuration)))
+            {
+                FindInsideIntervals(object.Trajectory, axis, cosHalfAngle, interval.first, interval.second, steps, intervals[object.Id]);
+            }
+        });
+    }
+
+    //Intervals split by slab boundaries are merged
+    std::vector<OverflightResult> results;
+    for (auto &objectIntervals: intervals)
+    {
+        auto &items = objectIntervals.second;
+        std::sort(items.begin(), items.end());
+        std::vector<std::pair<double, double>> merged;
+        for (const auto &item: items)
+        {
+            if (!merged.empty() && item.first <= merged.back().second + ROOT_TOLERANCE)
+            {
+                merged.back().second = std::max(merged.back().second, item.second);
+            }
+            else
+            {
+                merged.push_back(item);
+            }
+        }
+        for (const auto &item: merged)
+        {
+            results.push_back(OverflightResult{objectIntervals.first, IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(item.first)),
+                                               IO::Astrodynamics::Time::TDB(std::chrono::duration<double>(item.second))});
+        }
+    }
+    return results;
+}
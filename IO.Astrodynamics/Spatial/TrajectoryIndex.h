@@ -0,0 +1,211 @@
+/*
+ Copyright (c) 2023-2024. Sylvain Guillet (sylvain.guillet@tutamail.com)
+ */
+
+#ifndef IO_TRAJECTORYINDEX_H
+#define IO_TRAJECTORYINDEX_H
+
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <BoundingBox.h>
+#include <EphemerisKernel.h>
+#include <TimeSpan.h>
+#include <Window.h>
+
+namespace IO::Astrodynamics::Spatial
+{
+    /**
+     * @brief Object state at an epoch
+     * First argument is the epoch in seconds from J2000 TDB, second one receives position (m) and velocity (m/s) in the index frame.
+     */
+    using TrajectoryFunction = std::function<void(double, double[6])>;
+
+    /**
+     * @brief Closest approach of an object to a point
+     */
+    struct RangeResult
+    {
+        int ObjectId{};
+        IO::Astrodynamics::Time::TDB Epoch{std::chrono::duration<double>(0.0)};
+
+        //(m)
+        double Distance{};
+    };
+
+    /**
+     * @brief Object distance at a given epoch
+     */
+    struct NearestResult
+    {
+        int ObjectId{};
+
+        //(m)
+        double Distance{};
+    };
+
+    /**
+     * @brief Interval when an object is inside a region
+     */
+    struct OverflightResult
+    {
+        int ObjectId{};
+        IO::Astrodynamics::Time::TDB Begin{std::chrono::duration<double>(0.0)};
+        IO::Astrodynamics::Time::TDB End{std::chrono::duration<double>(0.0)};
+    };
+
+    /**
+     * @brief Spatiotemporal index of many trajectories.
+     * Time is split in slabs of constant duration. In each slab every object is bounded by the box swept by its trajectory, and boxes are organised in a
+     * bounding volume hierarchy. Queries walk the hierarchies of the slabs they overlap and evaluate the trajectories of candidate objects only.
+     * Adding an object or a new coverage of an existing object only rebuilds hierarchies of the slabs it overlaps, the next time they are queried.
+     * Every position is expressed in the frame chosen when objects are added, a body fixed frame makes ground regions fixed.
+     */
+    class TrajectoryIndex final
+    {
+    private:
+        struct Node
+        {
+            BoundingBox Box;
+            int Left{-1};
+            int Right{-1};
+            std::size_t First{};
+            std::size_t Count{};
+        };
+
+        struct Entry
+        {
+            std::size_t Object{};
+            BoundingBox Box;
+        };
+
+        struct Slab
+        {
+            std::vector<Entry> Entries;
+            std::vector<Node> Nodes;
+            bool IsDirty{true};
+        };
+
+        struct TrackedObject
+        {
+            int Id{};
+            TrajectoryFunction Trajectory;
+
+            //Sorted disjoint intervals, seconds from J2000 TDB
+            std::vector<std::pair<double, double>> Coverage;
+        };
+
+        const double m_slabDuration;
+        const std::size_t m_samplesPerSlab;
+        std::vector<TrackedObject> m_objects;
+        std::unordered_map<int, std::size_t> m_objectIndexes;
+        std::map<long long, Slab> m_slabs;
+
+        [[nodiscard]] long long GetSlabIndex(double epoch) const;
+
+        void UpdateSlab(long long slabIndex, std::size_t object);
+
+        void RemoveEntries(long long firstSlab, long long lastSlab, std::size_t object);
+
+        void Build(Slab &slab) const;
+
+        int BuildNode(Slab &slab, std::size_t first, std::size_t count) const;
+
+        template<typename NodePredicate, typename EntryAction>
+        void Traverse(const Slab &slab, NodePredicate predicate, EntryAction action) const;
+
+        [[nodiscard]] std::vector<std::pair<double, double>> GetCoveredIntervals(std::size_t object, double begin, double end) const;
+
+        [[nodiscard]] bool IsCovered(std::size_t object, double epoch) const;
+
+    public:
+        /**
+         * @brief Construct a new Trajectory Index
+         *
+         * @param slabDuration Time slab duration, shorter slabs give tighter boxes but more entries
+         * @param samplesPerSlab Trajectory samples used to bound each object in a slab
+         */
+        explicit TrajectoryIndex(const IO::Astrodynamics::Time::TimeSpan &slabDuration = IO::Astrodynamics::Time::TimeSpan(std::chrono::duration<double>(600.0)),
+                                 std::size_t samplesPerSlab = 9);
+
+        /**
+         * @brief Add an object or extend its coverage, only slabs overlapping the part of the coverage not indexed yet are sampled
+         *
+         * @param objectId
+         * @param coverage
+         * @param trajectory Trajectory over the whole coverage of the object. When the object already exists it replaces the previous one and must agree
+         * with it over the previous coverage
+         */
+        void Add(int objectId, const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &coverage, TrajectoryFunction trajectory);
+
+        /**
+         * @brief Add the object of a loaded ephemeris kernel over its coverage window.
+         * Each interval covered by the object segments is added on its own, gaps between segments aren't indexed.
+         * Calling it again after new segments have been written extends the coverage of the object and only samples the new intervals.
+         *
+         * @param kernel
+         * @param centerOfMotionId Origin of the index positions
+         * @param frame Frame of the index positions
+         */
+        void Add(const IO::Astrodynamics::Kernels::EphemerisKernel &kernel, int centerOfMotionId, const IO::Astrodynamics::Frames::Frames &frame);
+
+        /**
+         * @brief Remove an object
+         *
+         * @param objectId
+         * @return true if the object was indexed
+         */
+        bool Remove(int objectId);
+
+        /**
+         * @brief Find objects passing within a distance of a point
+         *
+         * @param point Fixed point in the index frame (m)
+         * @param radius (m)
+         * @param window Search window
+         * @return std::vector<RangeResult> Closest approach of each object inside the radius, sorted by distance
+         */
+        [[nodiscard]] std::vector<RangeResult> FindInRange(const double point[3], double radius, const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window);
+
+        /**
+         * @brief Find nearest objects of a point
+         *
+         * @param point Point in the index frame (m)
+         * @param epoch
+         * @param count Maximum objects count
+         * @return std::vector<NearestResult> Sorted by distance
+         */
+        [[nodiscard]] std::vector<NearestResult> FindNearest(const double point[3], const IO::Astrodynamics::Time::TDB &epoch, std::size_t count);
+
+        /**
+         * @brief Find objects over a circular region, seen from the frame origin
+         *
+         * @param direction Region center direction in the index frame
+         * @param halfAngle Region angular radius (rad)
+         * @param window Search window
+         * @return std::vector<OverflightResult> Overflight intervals sorted by object and begin epoch
+         */
+        [[nodiscard]] std::vector<OverflightResult> FindOverflights(const double direction[3], double halfAngle,
+                                                                    const IO::Astrodynamics::Time::Window<IO::Astrodynamics::Time::TDB> &window);
+
+        /**
+         * @brief Get the indexed objects count
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] inline std::size_t GetObjectCount() const
+        { return m_objectIndexes.size(); }
+
+        /**
+         * @brief Get the count of time slabs holding at least one object
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] inline std::size_t GetSlabCount() const
+        { return m_slabs.size(); }
+    };
+}
+
+#endif //IO_TRAJECTORYINDEX_H